@@ -0,0 +1,648 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+
+/**
+ * @file event_pipeline_benchmark.c
+ * Host side throughput and latency of the EventFifo packet pipeline:
+ * packet parsing, TagRead field extraction and copying, and the handoff of
+ * FifoBufferNode buffers through the EventFifo queue.
+ *
+ * The input is either a recorded EventFifo byte stream, i.e. the
+ * concatenated ReadFifo data without the response codes, or a synthetic
+ * stream of inventory rounds. No Impinj Reader Chip is required.
+ *
+ * Usage: event_pipeline_benchmark.bin [-f stream.bin] [-t tag_count]
+ *        [-e epc_bytes] [-r tags_per_round] [-n samples]
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "board/fifo_buffer_pool.h"
+#include "ex10_api/crc16.h"
+#include "ex10_api/event_fifo_packet_types.h"
+#include "ex10_api/event_packet_parser.h"
+#include "ex10_api/ex10_event_fifo_queue.h"
+#include "ex10_api/ex10_print.h"
+#include "ex10_api/ex10_utils.h"
+#include "ex10_api/fifo_buffer_list.h"
+#include "utils/ex10_benchmark.h"
+
+/// The largest recorded or synthetic EventFifo stream which is benchmarked.
+#define STREAM_CAPACITY ((size_t)(1024u * 1024u))
+
+/// The number of queue handoffs timed by the latency benchmark.
+#define HANDOFF_COUNT ((size_t)10000u)
+
+/// The inter-packet time of the synthetic stream, in microseconds.
+static uint32_t const synthetic_tag_period_us = 500u;
+
+static uint8_t stream_buffer[STREAM_CAPACITY] __attribute__((aligned(4)));
+
+/**
+ * @struct EventStream
+ * The EventFifo byte stream and the packets indexed from it, which are
+ * shared by each of the benchmarks.
+ */
+struct EventStream
+{
+    struct ConstByteSpan bytes;
+    size_t               packet_count;
+
+    /// The TagRead packets within the stream.
+    struct EventFifoPacket* tag_reads;
+    struct TagReadFields*   tag_read_fields;
+    size_t                  tag_read_count;
+
+    /// The byte offset of each chunk: the stream split at packet boundaries
+    /// into chunks which fit within a single ReadFifo transfer.
+    size_t* chunk_offsets;
+    size_t  chunk_count;
+};
+
+/**
+ * Append a packet to the stream buffer.
+ *
+ * @return size_t The number of bytes appended, including padding to a 32-bit
+ *                boundary. Zero if the packet did not fit.
+ */
+static size_t append_packet(size_t               offset,
+                            enum EventPacketType packet_type,
+                            uint32_t             us_counter,
+                            void const*          static_data,
+                            size_t               static_length,
+                            void const*          dynamic_data,
+                            size_t               dynamic_length)
+{
+    size_t const length =
+        sizeof(struct PacketHeader) + static_length + dynamic_length;
+    size_t const padded_length =
+        (length + sizeof(uint32_t) - 1u) & ~(sizeof(uint32_t) - 1u);
+    if (offset + padded_length > sizeof(stream_buffer))
+    {
+        return 0u;
+    }
+
+    struct PacketHeader header =
+        get_ex10_event_parser()->make_packet_header(packet_type);
+    header.packet_length = (uint8_t)(padded_length / sizeof(uint32_t));
+    header.us_counter    = us_counter;
+
+    uint8_t* packet = &stream_buffer[offset];
+    memset(packet, 0, padded_length);
+    memcpy(packet, &header, sizeof(header));
+    memcpy(packet + sizeof(header), static_data, static_length);
+    if (dynamic_length > 0u)
+    {
+        memcpy(packet + sizeof(header) + static_length,
+               dynamic_data,
+               dynamic_length);
+    }
+    return padded_length;
+}
+
+/**
+ * Fill the stream buffer with inventory rounds; each round reports
+ * tags_per_round TagRead packets followed by an InventoryRoundSummary.
+ *
+ * @return size_t The length of the stream in bytes.
+ */
+static size_t make_synthetic_stream(size_t tag_count,
+                                    size_t epc_length,
+                                    size_t tags_per_round)
+{
+    struct TagRead const tag_read = {
+        .rssi             = 0x0A00u,
+        .rx_gain_settings = 0x0123u,
+        .type             = TagReadTypeEpc,
+    };
+
+    // The dynamic data is the PC word, EPC and StoredCRC. The PC word length
+    // field is the EPC length in 16-bit words.
+    uint8_t tag_data[sizeof(uint16_t) + EPC_BUFFER_BYTE_LENGTH];
+    memset(tag_data, 0, sizeof(tag_data));
+    tag_data[0u] = (uint8_t)((epc_length / sizeof(uint16_t)) << 3u);
+    tag_data[2u] = 0x30;
+    size_t const tag_data_length = epc_length + 2u * sizeof(uint16_t);
+
+    size_t   length     = 0u;
+    uint32_t us_counter = 0u;
+    for (size_t tag_index = 0u; tag_index < tag_count; ++tag_index)
+    {
+        uint8_t* epc_end = &tag_data[sizeof(uint16_t) + epc_length];
+        epc_end[-1]      = (uint8_t)(tag_index >> 0u);
+        epc_end[-2]      = (uint8_t)(tag_index >> 8u);
+
+        uint16_t const crc = ex10_compute_crc16(&tag_data[2u], epc_length);
+        epc_end[0u]        = (uint8_t)(crc >> 8u);
+        epc_end[1u]        = (uint8_t)(crc >> 0u);
+
+        us_counter += synthetic_tag_period_us;
+        size_t appended = append_packet(length,
+                                        TagRead,
+                                        us_counter,
+                                        &tag_read,
+                                        sizeof(tag_read),
+                                        tag_data,
+                                        tag_data_length);
+        length += appended;
+
+        bool const round_done = ((tag_index + 1u) % tags_per_round == 0u) ||
+                                (tag_index + 1u == tag_count);
+        if (round_done && appended > 0u)
+        {
+            struct InventoryRoundSummary const summary = {
+                .duration_us  = (uint32_t)(tags_per_round *
+                                          synthetic_tag_period_us),
+                .total_slots  = (uint32_t)tags_per_round,
+                .num_slots    = (uint16_t)tags_per_round,
+                .single_slots = (uint16_t)tags_per_round,
+                .reason       = InventorySummaryDone,
+            };
+            appended = append_packet(length,
+                                     InventoryRoundSummary,
+                                     us_counter,
+                                     &summary,
+                                     sizeof(summary),
+                                     NULL,
+                                     0u);
+            length += appended;
+        }
+
+        if (appended == 0u)
+        {
+            ex10_ex_eprintf("Synthetic stream truncated at %zu tags\n",
+                            tag_index);
+            break;
+        }
+    }
+
+    return length;
+}
+
+/**
+ * Parse the stream once to index its packets and split it into ReadFifo
+ * sized chunks. A recorded stream is truncated at the first invalid packet.
+ */
+static int index_stream(struct EventStream* stream, size_t stream_length)
+{
+    struct Ex10EventParser const* parser = get_ex10_event_parser();
+
+    // Count the packets, so that the per packet arrays can be allocated.
+    struct ConstByteSpan bytes = {
+        .data   = stream_buffer,
+        .length = stream_length,
+    };
+    size_t packet_count   = 0u;
+    size_t tag_read_count = 0u;
+    while (bytes.length > 0u)
+    {
+        uint8_t const* packet_start = bytes.data;
+        struct EventFifoPacket const packet =
+            parser->parse_event_packet(&bytes);
+        if (packet.is_valid == false)
+        {
+            stream_length = (size_t)(packet_start - stream_buffer);
+            ex10_ex_eprintf("Stream truncated to %zu valid bytes\n",
+                            stream_length);
+            break;
+        }
+        packet_count += 1u;
+        tag_read_count += (packet.packet_type == TagRead) ? 1u : 0u;
+    }
+
+    if (packet_count == 0u)
+    {
+        ex10_ex_eprintf("The stream contains no packets\n");
+        return -EINVAL;
+    }
+
+    stream->bytes.data     = stream_buffer;
+    stream->bytes.length   = stream_length;
+    stream->packet_count   = packet_count;
+    stream->tag_read_count = 0u;
+    stream->chunk_count    = 0u;
+    stream->tag_reads =
+        calloc(tag_read_count + 1u, sizeof(struct EventFifoPacket));
+    stream->tag_read_fields =
+        calloc(tag_read_count + 1u, sizeof(struct TagReadFields));
+    stream->chunk_offsets = calloc(packet_count, sizeof(size_t));
+    if (stream->tag_reads == NULL || stream->tag_read_fields == NULL ||
+        stream->chunk_offsets == NULL)
+    {
+        ex10_ex_eprintf("Unable to allocate the stream index\n");
+        return -ENOMEM;
+    }
+
+    bytes             = stream->bytes;
+    size_t fill_bytes = 0u;
+    while (bytes.length > 0u)
+    {
+        size_t const offset = (size_t)(bytes.data - stream_buffer);
+        struct EventFifoPacket const packet =
+            parser->parse_event_packet(&bytes);
+        size_t const packet_length =
+            (size_t)(bytes.data - stream_buffer) - offset;
+
+        // Start a new chunk when the packet would overflow a ReadFifo.
+        if (stream->chunk_count == 0u ||
+            fill_bytes + packet_length > EX10_EVENT_FIFO_SIZE)
+        {
+            stream->chunk_offsets[stream->chunk_count] = offset;
+            stream->chunk_count += 1u;
+            fill_bytes = 0u;
+        }
+        fill_bytes += packet_length;
+
+        if (packet.packet_type == TagRead)
+        {
+            struct TagRead const* tag_read = &packet.static_data->tag_read;
+            stream->tag_reads[stream->tag_read_count] = packet;
+            stream->tag_read_fields[stream->tag_read_count] =
+                parser->get_tag_read_fields(packet.dynamic_data,
+                                            packet.dynamic_data_length,
+                                            tag_read->type,
+                                            tag_read->tid_offset);
+            stream->tag_read_count += 1u;
+        }
+    }
+    return 0;
+}
+
+static size_t chunk_length(struct EventStream const* stream, size_t chunk)
+{
+    size_t const end = (chunk + 1u < stream->chunk_count)
+                           ? stream->chunk_offsets[chunk + 1u]
+                           : stream->bytes.length;
+    return end - stream->chunk_offsets[chunk];
+}
+
+static void free_stream(struct EventStream* stream)
+{
+    free(stream->tag_reads);
+    free(stream->tag_read_fields);
+    free(stream->chunk_offsets);
+}
+
+static void parse_event_packet_sample(void* context)
+{
+    struct EventStream const*     stream = context;
+    struct Ex10EventParser const* parser = get_ex10_event_parser();
+
+    struct ConstByteSpan bytes = stream->bytes;
+    while (bytes.length > 0u)
+    {
+        struct EventFifoPacket const packet =
+            parser->parse_event_packet(&bytes);
+        ex10_benchmark_consume(packet.packet_type);
+    }
+}
+
+static void scan_event_packets_sample(void* context)
+{
+    struct EventStream const*     stream = context;
+    struct Ex10EventParser const* parser = get_ex10_event_parser();
+
+    static struct EventPacketIndex packet_index;
+
+    for (size_t chunk = 0u; chunk < stream->chunk_count; ++chunk)
+    {
+        struct ConstByteSpan const bytes = {
+            .data   = stream->bytes.data + stream->chunk_offsets[chunk],
+            .length = chunk_length(stream, chunk),
+        };
+        size_t const packet_count =
+            parser->scan_event_packets(bytes, &packet_index);
+        ex10_benchmark_consume(packet_count);
+    }
+}
+
+static void get_tag_read_fields_sample(void* context)
+{
+    struct EventStream const*     stream = context;
+    struct Ex10EventParser const* parser = get_ex10_event_parser();
+
+    for (size_t iter = 0u; iter < stream->tag_read_count; ++iter)
+    {
+        struct EventFifoPacket const* packet   = &stream->tag_reads[iter];
+        struct TagRead const*         tag_read = &packet->static_data->tag_read;
+        struct TagReadFields const    fields =
+            parser->get_tag_read_fields(packet->dynamic_data,
+                                        packet->dynamic_data_length,
+                                        tag_read->type,
+                                        tag_read->tid_offset);
+        ex10_benchmark_consume(fields.epc_length);
+    }
+}
+
+static void copy_tag_read_data_sample(void* context)
+{
+    struct EventStream const* stream = context;
+
+    static struct TagReadData tag_read_data;
+    for (size_t iter = 0u; iter < stream->tag_read_count; ++iter)
+    {
+        ex10_copy_tag_read_data(&tag_read_data,
+                                &stream->tag_read_fields[iter]);
+        ex10_benchmark_consume(tag_read_data.epc_length);
+    }
+}
+
+/**
+ * Fill a FifoBufferNode from the free list with a stream chunk, as the
+ * ReadFifo command would.
+ */
+static struct FifoBufferNode* fill_fifo_buffer(
+    struct EventStream const* stream,
+    size_t                    chunk)
+{
+    struct FifoBufferNode* node = get_ex10_fifo_buffer_list()->free_list_get();
+    if (node != NULL)
+    {
+        size_t const length = chunk_length(stream, chunk);
+        memcpy(node->raw_buffer.data,
+               stream->bytes.data + stream->chunk_offsets[chunk],
+               length);
+        node->fifo_data.length = length;
+    }
+    return node;
+}
+
+/**
+ * Pass the whole stream through the EventFifo queue within one thread.
+ * At most buffer_count - 1 buffers are queued at once; if the free list
+ * were emptied, releasing a buffer would request an EventFifo interrupt
+ * from the Impinj Reader Chip.
+ */
+static void event_fifo_queue_sample(void* context)
+{
+    struct EventStream const*        stream = context;
+    struct Ex10EventFifoQueue const* queue  = get_ex10_event_fifo_queue();
+    size_t const                     queue_depth =
+        get_ex10_event_fifo_buffer_pool()->buffer_count - 1u;
+
+    for (size_t chunk = 0u; chunk < stream->chunk_count;)
+    {
+        for (size_t depth = 0u;
+             depth < queue_depth && chunk < stream->chunk_count;
+             ++depth, ++chunk)
+        {
+            queue->list_node_push_back(fill_fifo_buffer(stream, chunk));
+        }
+
+        for (struct EventFifoPacket const* packet = queue->packet_peek();
+             packet != NULL;
+             packet = queue->packet_peek())
+        {
+            ex10_benchmark_consume(packet->packet_type);
+            queue->packet_remove();
+        }
+    }
+}
+
+/**
+ * @struct HandoffContext
+ * The producer thread of the queue handoff latency benchmark pushes one
+ * FifoBufferNode at a time, waiting for the consumer to release the
+ * previous node.
+ */
+struct HandoffContext
+{
+    struct EventStream const* stream;
+    uint64_t                  push_ns[HANDOFF_COUNT];
+    size_t                    released_count;
+};
+
+static void* handoff_producer(void* arg)
+{
+    struct HandoffContext*           handoff = arg;
+    struct Ex10EventFifoQueue const* queue   = get_ex10_event_fifo_queue();
+
+    for (size_t iter = 0u; iter < HANDOFF_COUNT; ++iter)
+    {
+        size_t const           chunk = iter % handoff->stream->chunk_count;
+        struct FifoBufferNode* node  = fill_fifo_buffer(handoff->stream, chunk);
+
+        while (__atomic_load_n(&handoff->released_count, __ATOMIC_ACQUIRE) <
+               iter)
+        {
+            sched_yield();
+        }
+
+        handoff->push_ns[iter] = ex10_benchmark_time_ns();
+        queue->list_node_push_back(node);
+    }
+    return NULL;
+}
+
+/**
+ * Time from list_node_push_back() in a producer thread until a consumer
+ * blocked in packet_wait() has indexed the buffer with packet_batch_get().
+ */
+static struct Ex10BenchmarkResult event_fifo_queue_handoff(
+    struct EventStream const* stream)
+{
+    struct Ex10EventFifoQueue const* queue = get_ex10_event_fifo_queue();
+
+    static struct HandoffContext handoff;
+    static uint64_t              latency_ns[HANDOFF_COUNT];
+    handoff.stream         = stream;
+    handoff.released_count = 0u;
+
+    pthread_t producer;
+    int const result =
+        pthread_create(&producer, NULL, handoff_producer, &handoff);
+    if (result != 0)
+    {
+        ex10_ex_eprintf("pthread_create() failed: %d\n", result);
+        return ex10_benchmark_from_samples(
+            "event_fifo_queue_handoff", "handoff", NULL, 0u, 1u, 0u);
+    }
+
+    struct EventFifoPacketBatch batch;
+    uint64_t const              start_ns = ex10_benchmark_time_ns();
+    for (size_t iter = 0u; iter < HANDOFF_COUNT; ++iter)
+    {
+        queue->packet_wait();
+        queue->packet_batch_get(&batch);
+        latency_ns[iter] = ex10_benchmark_time_ns() - handoff.push_ns[iter];
+        ex10_benchmark_consume(batch.packet_count);
+        queue->packet_batch_release(&batch);
+
+        __atomic_store_n(&handoff.released_count, iter + 1u, __ATOMIC_RELEASE);
+    }
+    uint64_t const total_ns = ex10_benchmark_time_ns() - start_ns;
+
+    pthread_join(producer, NULL);
+
+    return ex10_benchmark_from_samples("event_fifo_queue_handoff",
+                                       "handoff",
+                                       latency_ns,
+                                       HANDOFF_COUNT,
+                                       1u,
+                                       total_ns);
+}
+
+static void print_usage(void)
+{
+    ex10_ex_printf(
+        "Usage: event_pipeline_benchmark.bin [-f stream.bin] [-t tag_count]\n"
+        "       [-e epc_bytes] [-r tags_per_round] [-n samples]\n"
+        "  -f  A recorded EventFifo stream: concatenated ReadFifo data\n"
+        "  -t  The number of synthetic TagRead packets (default 4096)\n"
+        "  -e  The synthetic EPC length in bytes, even (default 12)\n"
+        "  -r  The synthetic tags per inventory round (default 16)\n"
+        "  -n  The number of timed samples (default 200)\n");
+}
+
+int main(int argc, char* argv[])
+{
+    char const* stream_file    = NULL;
+    size_t      tag_count      = 4096u;
+    size_t      epc_length     = 12u;
+    size_t      tags_per_round = 16u;
+    size_t      sample_count   = 200u;
+
+    char const* opt_spec = "f:t:e:r:n:h?";
+    for (int opt_char = getopt(argc, argv, opt_spec); opt_char != -1;
+         opt_char     = getopt(argc, argv, opt_spec))
+    {
+        switch (opt_char)
+        {
+            case 'f':
+                stream_file = optarg;
+                break;
+            case 't':
+                tag_count = strtoul(optarg, NULL, 0);
+                break;
+            case 'e':
+                epc_length = strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                tags_per_round = strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                sample_count = strtoul(optarg, NULL, 0);
+                break;
+            case 'h':
+            case '?':
+                print_usage();
+                return 0;
+            default:
+                ex10_ex_eprintf("Unknown argument specified: %c\n",
+                                (char)opt_char);
+                return -EINVAL;
+        }
+    }
+
+    bool const epc_length_valid = (epc_length > 0u) &&
+                                  (epc_length % sizeof(uint16_t) == 0u) &&
+                                  (epc_length <= 62u);
+    if (!epc_length_valid || tags_per_round == 0u || sample_count == 0u)
+    {
+        print_usage();
+        return -EINVAL;
+    }
+
+    size_t const stream_length =
+        (stream_file != NULL)
+            ? ex10_benchmark_read_file(
+                  stream_file, stream_buffer, sizeof(stream_buffer))
+            : make_synthetic_stream(tag_count, epc_length, tags_per_round);
+
+    struct EventStream stream;
+    memset(&stream, 0, sizeof(stream));
+    int result = index_stream(&stream, stream_length);
+    if (result != 0)
+    {
+        free_stream(&stream);
+        return result;
+    }
+
+    ex10_ex_printf("Stream: %s, %zu bytes, %zu packets, %zu tag reads\n",
+                   (stream_file != NULL) ? stream_file : "synthetic",
+                   stream.bytes.length,
+                   stream.packet_count,
+                   stream.tag_read_count);
+
+    struct FifoBufferPool const* pool = get_ex10_event_fifo_buffer_pool();
+    struct Ex10Result const      ex10_result =
+        get_ex10_fifo_buffer_list()->init(pool->fifo_buffer_nodes,
+                                          pool->fifo_buffers,
+                                          pool->packet_indexes,
+                                          pool->buffer_count);
+    if (ex10_result.error || pool->buffer_count < 2u)
+    {
+        ex10_ex_eprintf("Event fifo buffer list init failed\n");
+        free_stream(&stream);
+        return -EINVAL;
+    }
+    get_ex10_event_fifo_queue()->init();
+
+    ex10_benchmark_print_header();
+
+    struct Ex10BenchmarkResult bench =
+        ex10_benchmark_run("parse_event_packet",
+                           "packet",
+                           sample_count,
+                           stream.packet_count,
+                           parse_event_packet_sample,
+                           &stream);
+    ex10_benchmark_print_result(&bench);
+
+    bench = ex10_benchmark_run("scan_event_packets",
+                               "packet",
+                               sample_count,
+                               stream.packet_count,
+                               scan_event_packets_sample,
+                               &stream);
+    ex10_benchmark_print_result(&bench);
+
+    if (stream.tag_read_count > 0u)
+    {
+        bench = ex10_benchmark_run("get_tag_read_fields",
+                                   "tag",
+                                   sample_count,
+                                   stream.tag_read_count,
+                                   get_tag_read_fields_sample,
+                                   &stream);
+        ex10_benchmark_print_result(&bench);
+
+        bench = ex10_benchmark_run("ex10_copy_tag_read_data",
+                                   "tag",
+                                   sample_count,
+                                   stream.tag_read_count,
+                                   copy_tag_read_data_sample,
+                                   &stream);
+        ex10_benchmark_print_result(&bench);
+    }
+
+    bench = ex10_benchmark_run("event_fifo_queue_peek_remove",
+                               "packet",
+                               sample_count,
+                               stream.packet_count,
+                               event_fifo_queue_sample,
+                               &stream);
+    ex10_benchmark_print_result(&bench);
+
+    bench = event_fifo_queue_handoff(&stream);
+    ex10_benchmark_print_result(&bench);
+
+    free_stream(&stream);
+    return 0;
+}
@@ -0,0 +1,438 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+
+/**
+ * @file gen2_calibration_benchmark.c
+ * Host side cost of the Gen2 command bit packing, encoding and decoding,
+ * and of the RSSI compensation and transmit power calibration math.
+ *
+ * The calibration is read from a calibration info page image, i.e. the
+ * contents of the CalibrationInfo register. Without an image the board is
+ * treated as uncalibrated, and only the default calibration paths are
+ * timed. No Impinj Reader Chip is required.
+ *
+ * Usage: gen2_calibration_benchmark.bin [-c calibration.bin] [-n samples]
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "calibration.h"
+#include "ex10_api/application_registers.h"
+#include "ex10_api/event_fifo_packet_types.h"
+#include "ex10_api/ex10_macros.h"
+#include "ex10_api/ex10_print.h"
+#include "ex10_api/ex10_protocol.h"
+#include "ex10_api/gen2_commands.h"
+#include "ex10_api/gen2_tx_command_manager.h"
+#include "utils/ex10_benchmark.h"
+
+/// The number of operations performed by each sample.
+#define OPS_PER_SAMPLE ((size_t)256u)
+
+/// The number of words returned by the Gen2 Read reply benchmark.
+#define READ_REPLY_WORD_COUNT ((size_t)8u)
+
+static uint8_t calibration_image[EX10_INFO_PAGE_SIZE];
+
+static enum RfModes const rf_modes[] = {
+    mode_1, mode_3, mode_5, mode_7, mode_11, mode_13, mode_103, mode_148};
+
+static struct RxGainControlFields const rx_gain_settings = {
+    .rx_atten   = RxAttenAtten_0_dB,
+    .pga1_gain  = Pga1GainGain_6_dB,
+    .pga2_gain  = Pga2GainGain_0_dB,
+    .pga3_gain  = Pga3GainGain_0_dB,
+    .mixer_gain = MixerGainGain_11p2_dB,
+};
+
+/**
+ * Serve the calibration reads of Ex10Calibration.init() from the
+ * calibration image in place of the Impinj Reader Chip.
+ */
+static struct Ex10Result read_calibration_image(uint16_t address,
+                                                uint16_t length,
+                                                void*    buffer)
+{
+    size_t const offset = (size_t)address - calibration_info_reg.address;
+    if (address < calibration_info_reg.address ||
+        offset + length > sizeof(calibration_image))
+    {
+        return make_ex10_sdk_error(Ex10ModuleUtils, Ex10SdkErrorBadParamValue);
+    }
+    memcpy(buffer, &calibration_image[offset], length);
+    return make_ex10_success();
+}
+
+static void bit_pack_sample(void* context)
+{
+    (void)context;
+    struct Ex10Gen2Commands const* gen2_commands = get_ex10_gen2_commands();
+
+    // Pack fields of 1 to 16 bits, wrapping within the encoded buffer;
+    // bit_pack() addresses at most 255 bytes.
+    static uint8_t encoded[255u];
+    memset(encoded, 0, sizeof(encoded));
+
+    size_t bit_offset = 0u;
+    for (size_t iter = 0u; iter < OPS_PER_SAMPLE; ++iter)
+    {
+        size_t const   bit_count = (iter % 16u) + 1u;
+        uint32_t const data      = (uint32_t)iter & ((1u << bit_count) - 1u);
+        bit_offset = (bit_offset > 2000u) ? 0u : bit_offset;
+        bit_offset =
+            gen2_commands->bit_pack(encoded, bit_offset, data, bit_count);
+    }
+    ex10_benchmark_consume(bit_offset);
+}
+
+/**
+ * @struct Gen2CommandContext
+ * The commands encoded and decoded by the Gen2 benchmarks.
+ */
+struct Gen2CommandContext
+{
+    struct Gen2CommandSpec select_spec;
+    struct Gen2CommandSpec read_spec;
+    struct Gen2CommandSpec write_spec;
+
+    struct BitSpan encoded_read;
+    struct BitSpan encoded_write;
+
+    struct EventFifoPacket read_reply_packet;
+};
+
+static void encode_gen2_command_sample(void* context)
+{
+    struct Gen2CommandContext const* commands      = context;
+    struct Ex10Gen2Commands const*   gen2_commands = get_ex10_gen2_commands();
+
+    struct Gen2CommandSpec const* const specs[] = {
+        &commands->select_spec,
+        &commands->read_spec,
+        &commands->write_spec,
+    };
+
+    uint8_t        buffer[TxCommandEncodeBufferSize];
+    struct BitSpan encoded = {.data = buffer, .length = 0u};
+
+    for (size_t iter = 0u; iter < OPS_PER_SAMPLE; ++iter)
+    {
+        gen2_commands->encode_gen2_command(specs[iter % ARRAY_SIZE(specs)],
+                                           &encoded);
+        ex10_benchmark_consume(encoded.length);
+    }
+}
+
+static void decode_gen2_command_sample(void* context)
+{
+    struct Gen2CommandContext const* commands      = context;
+    struct Ex10Gen2Commands const*   gen2_commands = get_ex10_gen2_commands();
+
+    // Decode into storage large enough for the arguments of any command.
+    struct WriteCommandArgs args;
+    struct Gen2CommandSpec  spec = {.args = &args};
+
+    for (size_t iter = 0u; iter < OPS_PER_SAMPLE; ++iter)
+    {
+        struct BitSpan const* encoded = (iter % 2u) ? &commands->encoded_write
+                                                    : &commands->encoded_read;
+        gen2_commands->decode_gen2_command(&spec, encoded);
+        ex10_benchmark_consume(spec.command);
+    }
+}
+
+static void decode_reply_sample(void* context)
+{
+    struct Gen2CommandContext const* commands      = context;
+    struct Ex10Gen2Commands const*   gen2_commands = get_ex10_gen2_commands();
+
+    uint16_t         reply_words[READ_REPLY_WORD_COUNT + 1u];
+    struct Gen2Reply reply = {.data = reply_words};
+
+    for (size_t iter = 0u; iter < OPS_PER_SAMPLE; ++iter)
+    {
+        gen2_commands->decode_reply(
+            Gen2Read, &commands->read_reply_packet, &reply);
+        ex10_benchmark_consume(reply_words[0u]);
+    }
+}
+
+static void get_compensated_rssi_sample(void* context)
+{
+    (void)context;
+    struct Ex10Calibration const* calibration = get_ex10_calibration();
+
+    for (size_t iter = 0u; iter < OPS_PER_SAMPLE; ++iter)
+    {
+        int16_t const rssi_cdbm = calibration->get_compensated_rssi(
+            (uint16_t)(0x0800u + iter * 8u),
+            rf_modes[iter % ARRAY_SIZE(rf_modes)],
+            &rx_gain_settings,
+            (uint8_t)(1u + iter % 2u),
+            (iter & 4u) ? UPPER_BAND : LOWER_BAND,
+            (uint16_t)(1500u + iter));
+        ex10_benchmark_consume((uintptr_t)rssi_cdbm);
+    }
+}
+
+static void compensate_rssi_batch_sample(void* context)
+{
+    (void)context;
+    struct Ex10Calibration const* calibration = get_ex10_calibration();
+
+    struct Ex10RssiCompensationPlan plan;
+    calibration->build_rssi_compensation_plan(
+        mode_103, &rx_gain_settings, 1u, UPPER_BAND, 1500u, &plan);
+
+    uint16_t rssi_raw[OPS_PER_SAMPLE];
+    int16_t  rssi_cdbm[OPS_PER_SAMPLE];
+    for (size_t iter = 0u; iter < OPS_PER_SAMPLE; ++iter)
+    {
+        rssi_raw[iter] = (uint16_t)(0x0800u + iter * 8u);
+    }
+
+    calibration->compensate_rssi_batch(
+        &plan, rssi_raw, rssi_cdbm, OPS_PER_SAMPLE);
+    ex10_benchmark_consume((uintptr_t)rssi_cdbm[OPS_PER_SAMPLE - 1u]);
+}
+
+static void get_rssi_log2_sample(void* context)
+{
+    (void)context;
+    struct Ex10Calibration const* calibration = get_ex10_calibration();
+
+    for (size_t iter = 0u; iter < OPS_PER_SAMPLE; ++iter)
+    {
+        uint16_t const rssi_log2 = calibration->get_rssi_log2(
+            (int16_t)(-7000 + (int)iter * 10),
+            rf_modes[iter % ARRAY_SIZE(rf_modes)],
+            &rx_gain_settings,
+            (uint8_t)(1u + iter % 2u),
+            (iter & 4u) ? UPPER_BAND : LOWER_BAND,
+            (uint16_t)(1500u + iter));
+        ex10_benchmark_consume(rssi_log2);
+    }
+}
+
+static void get_power_control_params_sample(void* context)
+{
+    (void)context;
+    struct Ex10Calibration const* calibration = get_ex10_calibration();
+
+    for (size_t iter = 0u; iter < OPS_PER_SAMPLE; ++iter)
+    {
+        struct PowerConfigs const power_configs =
+            calibration->get_power_control_params(
+                (int16_t)(1000u + (iter % 21u) * 100u),
+                (uint32_t)(902750u + (iter % 50u) * 500u),
+                (uint16_t)(1500u + iter),
+                true,
+                UPPER_BAND);
+        ex10_benchmark_consume(power_configs.adc_target);
+    }
+}
+
+static void power_to_adc_sample(void* context)
+{
+    (void)context;
+    struct Ex10Calibration const* calibration = get_ex10_calibration();
+
+    for (size_t iter = 0u; iter < OPS_PER_SAMPLE; ++iter)
+    {
+        enum AuxAdcControlChannelEnableBits power_detector_adc =
+            ChannelEnableBitsNone;
+        uint16_t const adc =
+            calibration->power_to_adc((int16_t)(1000u + (iter % 21u) * 100u),
+                                      (uint32_t)(902750u + (iter % 50u) * 500u),
+                                      (uint16_t)(1500u + iter),
+                                      true,
+                                      UPPER_BAND,
+                                      &power_detector_adc);
+        ex10_benchmark_consume(adc);
+    }
+}
+
+/**
+ * @struct Benchmark
+ * A benchmark of OPS_PER_SAMPLE calls, run with the Gen2CommandContext.
+ */
+struct Benchmark
+{
+    char const*              name;
+    ex10_benchmark_sample_fn sample_fn;
+};
+
+static struct Benchmark const benchmarks[] = {
+    {"bit_pack", bit_pack_sample},
+    {"encode_gen2_command", encode_gen2_command_sample},
+    {"decode_gen2_command", decode_gen2_command_sample},
+    {"decode_reply", decode_reply_sample},
+    {"get_compensated_rssi", get_compensated_rssi_sample},
+    {"compensate_rssi_batch", compensate_rssi_batch_sample},
+    {"get_rssi_log2", get_rssi_log2_sample},
+    {"get_power_control_params", get_power_control_params_sample},
+    {"power_to_adc", power_to_adc_sample},
+};
+
+static void print_usage(void)
+{
+    ex10_ex_printf(
+        "Usage: gen2_calibration_benchmark.bin [-c calibration.bin] "
+        "[-n samples]\n"
+        "  -c  A calibration info page image (default: uncalibrated)\n"
+        "  -n  The number of timed samples (default 1000)\n");
+}
+
+int main(int argc, char* argv[])
+{
+    char const* calibration_file = NULL;
+    size_t      sample_count     = 1000u;
+
+    char const* opt_spec = "c:n:h?";
+    for (int opt_char = getopt(argc, argv, opt_spec); opt_char != -1;
+         opt_char     = getopt(argc, argv, opt_spec))
+    {
+        switch (opt_char)
+        {
+            case 'c':
+                calibration_file = optarg;
+                break;
+            case 'n':
+                sample_count = strtoul(optarg, NULL, 0);
+                break;
+            case 'h':
+            case '?':
+                print_usage();
+                return 0;
+            default:
+                ex10_ex_eprintf("Unknown argument specified: %c\n",
+                                (char)opt_char);
+                return -EINVAL;
+        }
+    }
+
+    if (sample_count == 0u)
+    {
+        print_usage();
+        return -EINVAL;
+    }
+
+    // Unprogrammed FLASH reads as all ones; i.e. uncalibrated.
+    memset(calibration_image, 0xFF, sizeof(calibration_image));
+    if (calibration_file != NULL &&
+        ex10_benchmark_read_file(calibration_file,
+                                 calibration_image,
+                                 sizeof(calibration_image)) == 0u)
+    {
+        return -EINVAL;
+    }
+
+    struct Ex10Protocol calibration_protocol = *get_ex10_protocol();
+    calibration_protocol.read_partial        = read_calibration_image;
+    get_ex10_calibration()->init(&calibration_protocol);
+    ex10_ex_printf("Calibration version: %u\n",
+                   get_ex10_calibration()->get_cal_version());
+
+    uint8_t  select_mask_bytes[12u] = {0x30, 0x00, 0x12, 0x34};
+    struct BitSpan select_mask = {
+        .data   = select_mask_bytes,
+        .length = sizeof(select_mask_bytes) * 8u,
+    };
+    struct SelectCommandArgs select_args = {
+        .target      = Session1,
+        .action      = Action000,
+        .memory_bank = SelectEPC,
+        .bit_pointer = 32u,
+        .bit_count   = (uint8_t)select_mask.length,
+        .mask        = &select_mask,
+        .truncate    = false,
+    };
+    struct ReadCommandArgs read_args = {
+        .memory_bank  = TID,
+        .word_pointer = 0u,
+        .word_count   = (uint8_t)READ_REPLY_WORD_COUNT,
+    };
+    struct WriteCommandArgs write_args = {
+        .memory_bank  = User,
+        .word_pointer = 4u,
+        .data         = 0xBEEF,
+    };
+
+    // The Read reply: the header bit, the words read and the tag handle.
+    uint8_t read_reply_data[1u + (READ_REPLY_WORD_COUNT + 1u) * 2u];
+    for (size_t iter = 0u; iter < sizeof(read_reply_data); ++iter)
+    {
+        read_reply_data[iter] = (uint8_t)iter;
+    }
+    read_reply_data[0u] = 0u;
+
+    union PacketData read_reply_static_data;
+    memset(&read_reply_static_data, 0, sizeof(read_reply_static_data));
+    read_reply_static_data.gen2_transaction.status = Gen2TransactionStatusOk;
+    read_reply_static_data.gen2_transaction.num_bits =
+        (uint16_t)(1u + (READ_REPLY_WORD_COUNT + 1u) * 16u);
+
+    uint8_t encoded_read_buffer[TxCommandEncodeBufferSize];
+    uint8_t encoded_write_buffer[TxCommandEncodeBufferSize];
+
+    struct Gen2CommandContext commands = {
+        .select_spec   = {.command = Gen2Select, .args = &select_args},
+        .read_spec     = {.command = Gen2Read, .args = &read_args},
+        .write_spec    = {.command = Gen2Write, .args = &write_args},
+        .encoded_read  = {.data = encoded_read_buffer, .length = 0u},
+        .encoded_write = {.data = encoded_write_buffer, .length = 0u},
+        .read_reply_packet =
+            {
+                .packet_type         = Gen2Transaction,
+                .static_data         = &read_reply_static_data,
+                .static_data_length  = sizeof(struct Gen2Transaction),
+                .dynamic_data        = read_reply_data,
+                .dynamic_data_length = sizeof(read_reply_data),
+                .is_valid            = true,
+            },
+    };
+
+    struct Ex10Gen2Commands const* gen2_commands = get_ex10_gen2_commands();
+    struct Ex10Result ex10_result = gen2_commands->encode_gen2_command(
+        &commands.read_spec, &commands.encoded_read);
+    if (ex10_result.error == false)
+    {
+        ex10_result = gen2_commands->encode_gen2_command(
+            &commands.write_spec, &commands.encoded_write);
+    }
+    if (ex10_result.error)
+    {
+        ex10_ex_eprintf("Gen2 command encoding failed\n");
+        return -EINVAL;
+    }
+
+    ex10_benchmark_print_header();
+
+    for (size_t iter = 0u; iter < ARRAY_SIZE(benchmarks); ++iter)
+    {
+        struct Ex10BenchmarkResult const result =
+            ex10_benchmark_run(benchmarks[iter].name,
+                               "call",
+                               sample_count,
+                               OPS_PER_SAMPLE,
+                               benchmarks[iter].sample_fn,
+                               &commands);
+        ex10_benchmark_print_result(&result);
+    }
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "ex10_api/ex10_print.h"
+#include "ex10_benchmark.h"
+
+static uint64_t const ns_per_s = 1000u * 1000u * 1000u;
+
+static volatile uintptr_t benchmark_sink = 0u;
+
+uint64_t ex10_benchmark_time_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * ns_per_s + (uint64_t)now.tv_nsec;
+}
+
+static int compare_u64(void const* lhs, void const* rhs)
+{
+    uint64_t const lhs_value = *(uint64_t const*)lhs;
+    uint64_t const rhs_value = *(uint64_t const*)rhs;
+    return (lhs_value > rhs_value) - (lhs_value < rhs_value);
+}
+
+/**
+ * @return double The per operation time of the sample at the percentile
+ *                within the sorted sample array; nearest rank method.
+ */
+static double percentile_ns(uint64_t const* sorted_ns,
+                            size_t          sample_count,
+                            size_t          ops_per_sample,
+                            unsigned int    percentile)
+{
+    size_t rank = (sample_count * percentile + 99u) / 100u;
+    rank        = (rank == 0u) ? 1u : rank;
+    return (double)sorted_ns[rank - 1u] / (double)ops_per_sample;
+}
+
+struct Ex10BenchmarkResult ex10_benchmark_from_samples(
+    char const* name,
+    char const* op_name,
+    uint64_t*   sample_ns,
+    size_t      sample_count,
+    size_t      ops_per_sample,
+    uint64_t    total_ns)
+{
+    struct Ex10BenchmarkResult result = {
+        .name           = name,
+        .op_name        = op_name,
+        .sample_count   = sample_count,
+        .ops_per_sample = ops_per_sample,
+        .total_ns       = total_ns,
+    };
+
+    if (sample_count == 0u || ops_per_sample == 0u)
+    {
+        return result;
+    }
+
+    qsort(sample_ns, sample_count, sizeof(sample_ns[0u]), compare_u64);
+
+    result.p50_ns = percentile_ns(sample_ns, sample_count, ops_per_sample, 50u);
+    result.p90_ns = percentile_ns(sample_ns, sample_count, ops_per_sample, 90u);
+    result.p99_ns = percentile_ns(sample_ns, sample_count, ops_per_sample, 99u);
+    result.max_ns =
+        (double)sample_ns[sample_count - 1u] / (double)ops_per_sample;
+    return result;
+}
+
+struct Ex10BenchmarkResult ex10_benchmark_run(
+    char const*              name,
+    char const*              op_name,
+    size_t                   sample_count,
+    size_t                   ops_per_sample,
+    ex10_benchmark_sample_fn sample_fn,
+    void*                    context)
+{
+    uint64_t* sample_ns = calloc(sample_count, sizeof(uint64_t));
+    if (sample_ns == NULL)
+    {
+        ex10_ex_eprintf("%s: unable to allocate %zu samples\n",
+                        name,
+                        sample_count);
+        return ex10_benchmark_from_samples(
+            name, op_name, NULL, 0u, ops_per_sample, 0u);
+    }
+
+    size_t const warm_up_count = (sample_count < 10u) ? 1u : sample_count / 10u;
+    for (size_t iter = 0u; iter < warm_up_count; ++iter)
+    {
+        sample_fn(context);
+    }
+
+    uint64_t total_ns = 0u;
+    for (size_t iter = 0u; iter < sample_count; ++iter)
+    {
+        uint64_t const start_ns = ex10_benchmark_time_ns();
+        sample_fn(context);
+        sample_ns[iter] = ex10_benchmark_time_ns() - start_ns;
+        total_ns += sample_ns[iter];
+    }
+
+    struct Ex10BenchmarkResult const result = ex10_benchmark_from_samples(
+        name, op_name, sample_ns, sample_count, ops_per_sample, total_ns);
+    free(sample_ns);
+    return result;
+}
+
+void ex10_benchmark_print_header(void)
+{
+    ex10_ex_printf("%-32s %12s %14s %10s %10s %10s %10s\n",
+                   "benchmark",
+                   "ns/op",
+                   "ops/sec",
+                   "p50 ns",
+                   "p90 ns",
+                   "p99 ns",
+                   "max ns");
+}
+
+void ex10_benchmark_print_result(struct Ex10BenchmarkResult const* result)
+{
+    uint64_t const op_count =
+        (uint64_t)result->sample_count * result->ops_per_sample;
+    if (op_count == 0u || result->total_ns == 0u)
+    {
+        ex10_ex_printf("%-32s no samples\n", result->name);
+        return;
+    }
+
+    double const mean_ns = (double)result->total_ns / (double)op_count;
+    double const ops_per_sec =
+        (double)op_count * (double)ns_per_s / (double)result->total_ns;
+
+    ex10_ex_printf("%-32s %12.1f %14.0f %10.1f %10.1f %10.1f %10.1f  (%s)\n",
+                   result->name,
+                   mean_ns,
+                   ops_per_sec,
+                   result->p50_ns,
+                   result->p90_ns,
+                   result->p99_ns,
+                   result->max_ns,
+                   result->op_name);
+}
+
+void ex10_benchmark_consume(uintptr_t value)
+{
+    benchmark_sink = benchmark_sink + value;
+}
+
+size_t ex10_benchmark_read_file(char const* file_name,
+                                void*       buffer,
+                                size_t      capacity)
+{
+    FILE* file = fopen(file_name, "rb");
+    if (file == NULL)
+    {
+        ex10_ex_eprintf("Unable to open %s\n", file_name);
+        return 0u;
+    }
+
+    size_t const length = fread(buffer, 1u, capacity, file);
+    bool const   is_eof = (fgetc(file) == EOF);
+    fclose(file);
+
+    if (!is_eof)
+    {
+        ex10_ex_eprintf("%s is larger than %zu bytes\n", file_name, capacity);
+        return 0u;
+    }
+    return length;
+}
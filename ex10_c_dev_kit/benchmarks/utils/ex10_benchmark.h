@@ -0,0 +1,129 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct Ex10BenchmarkResult
+ * The timing of a benchmark. The benchmark is run as a number of samples,
+ * each of which performs ops_per_sample operations; the latency percentiles
+ * are of the per operation time within each sample.
+ */
+struct Ex10BenchmarkResult
+{
+    char const* name;
+    /// The name of a single operation, e.g. "packet"; used to label units.
+    char const* op_name;
+    size_t      sample_count;
+    size_t      ops_per_sample;
+    uint64_t    total_ns;
+    double      p50_ns;
+    double      p90_ns;
+    double      p99_ns;
+    double      max_ns;
+};
+
+/**
+ * A benchmark sample function.
+ *
+ * @param context The context passed to ex10_benchmark_run().
+ */
+typedef void (*ex10_benchmark_sample_fn)(void* context);
+
+/** @return uint64_t The CLOCK_MONOTONIC time in nanoseconds. */
+uint64_t ex10_benchmark_time_ns(void);
+
+/**
+ * Time a sample function. The function is first run sample_count / 10
+ * times, with a minimum of 1, to warm up the caches and branch predictors.
+ *
+ * @param name           The benchmark name.
+ * @param op_name        The name of the operation performed by the sample.
+ * @param sample_count   The number of timed samples.
+ * @param ops_per_sample The number of operations performed in each sample.
+ * @param sample_fn      The function performing one sample.
+ * @param context        Passed to each sample_fn call.
+ *
+ * @return struct Ex10BenchmarkResult The benchmark timing.
+ */
+struct Ex10BenchmarkResult ex10_benchmark_run(
+    char const*              name,
+    char const*              op_name,
+    size_t                   sample_count,
+    size_t                   ops_per_sample,
+    ex10_benchmark_sample_fn sample_fn,
+    void*                    context);
+
+/**
+ * Make a benchmark result from externally timed samples, for benchmarks
+ * such as cross thread latency which can not be timed by
+ * ex10_benchmark_run().
+ *
+ * @param name           The benchmark name.
+ * @param op_name        The name of the operation timed by each sample.
+ * @param sample_ns      The time of each sample in nanoseconds. The array
+ *                       is sorted in place.
+ * @param sample_count   The number of elements in sample_ns.
+ * @param ops_per_sample The number of operations performed in each sample.
+ * @param total_ns       The elapsed time across all samples.
+ *
+ * @return struct Ex10BenchmarkResult The benchmark timing.
+ */
+struct Ex10BenchmarkResult ex10_benchmark_from_samples(
+    char const* name,
+    char const* op_name,
+    uint64_t*   sample_ns,
+    size_t      sample_count,
+    size_t      ops_per_sample,
+    uint64_t    total_ns);
+
+/** Print the column headings for ex10_benchmark_print_result(). */
+void ex10_benchmark_print_header(void);
+
+/**
+ * Print a benchmark result as mean ns/op, ops/sec and the per operation
+ * latency percentiles.
+ */
+void ex10_benchmark_print_result(struct Ex10BenchmarkResult const* result);
+
+/**
+ * Pass a value computed by a benchmark to an external function so that the
+ * compiler can not eliminate the computation.
+ */
+void ex10_benchmark_consume(uintptr_t value);
+
+/**
+ * Read a file into a buffer.
+ *
+ * @param file_name The path of the file to read.
+ * @param buffer    The buffer to fill.
+ * @param capacity  The number of bytes available in the buffer.
+ *
+ * @return size_t The number of bytes read; zero if the file could not be
+ *                read or is larger than the buffer.
+ */
+size_t ex10_benchmark_read_file(char const* file_name,
+                                void*       buffer,
+                                size_t      capacity);
+
+#ifdef __cplusplus
+}
+#endif
@@ -22,11 +22,15 @@
 #include <string.h>
 #include <unistd.h>
 
+#include "board/ex10_cal_cache.h"
+#include "board/ex10_osal.h"
 #include "board/ex10_rx_baseband_filter.h"
 #include "board_spec_constants.h"
 #include "calibration.h"
 #include "calibration_v5.h"
 #include "ex10_api/application_registers.h"
+#include "ex10_api/crc16.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_macros.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_utils.h"
@@ -43,10 +47,81 @@ enum DrmSizes
     NON_DRM_ANALOG_LENGTH = 3,
 };
 
-static uint8_t cal_version                                  = 0;
-static uint8_t customer_cal_version                         = 0;
-static int16_t drm_analog_offset[DRM_ANALOG_LENGTH]         = {0, 0};
-static int16_t non_drm_analog_offset[NON_DRM_ANALOG_LENGTH] = {0, 0, 0};
+/// The calibration state read from one Impinj Reader Chip context.
+struct CalibrationContext
+{
+    uint8_t cal_version;
+    uint8_t customer_cal_version;
+    int16_t drm_analog_offset[DRM_ANALOG_LENGTH];
+    int16_t non_drm_analog_offset[NON_DRM_ANALOG_LENGTH];
+
+    /// Incremented by each cal_init() call; zero marks a plan as never built.
+    uint32_t rssi_plan_generation;
+};
+
+static struct CalibrationContext const calibration_defaults = {
+    .cal_version           = 0,
+    .customer_cal_version  = 0,
+    .drm_analog_offset     = {0, 0},
+    .non_drm_analog_offset = {0, 0, 0},
+    .rssi_plan_generation  = 1u,
+};
+
+static struct CalibrationContext calibration_contexts[EX10_MAX_CONTEXTS];
+static struct Ex10ContextOnce    calibration_contexts_once;
+
+static void init_calibration_contexts(void)
+{
+    for (size_t index = 0u; index < EX10_MAX_CONTEXTS; ++index)
+    {
+        calibration_contexts[index] = calibration_defaults;
+    }
+}
+
+static struct CalibrationContext* get_calibration_context(void)
+{
+    ex10_context_init_once(&calibration_contexts_once,
+                           init_calibration_contexts);
+    return &calibration_contexts[ex10_context_index()];
+}
+
+// The plan of the most recent get_compensated_rssi() receive configuration,
+// one per context. Each thread keeps its own, so RSSI can be compensated from
+// both the application and the event fifo drain thread without locking.
+static EX10_THREAD_LOCAL struct Ex10RssiCompensationPlan
+    last_rssi_plans[EX10_MAX_CONTEXTS];
+
+/// Identifies a calibration cache record: "E1C3".
+static uint32_t const cal_cache_magic = 0x33433145u;
+
+/// The maximum length of the calibration info region header which keys the
+/// cache; see get_cal_page_header_length().
+#define CAL_PAGE_HEADER_MAX_LENGTH ((size_t)32u)
+
+/**
+ * @struct CalibrationCacheKey
+ * Identifies the calibration info region of a device.
+ */
+struct CalibrationCacheKey
+{
+    uint8_t serial_number[SERIAL_NUMBER_REG_LENGTH];
+    /// The region header; the bytes beyond its length are zero.
+    uint8_t page_header[CAL_PAGE_HEADER_MAX_LENGTH];
+};
+
+/**
+ * @struct CalibrationCacheRecord
+ * The calibration cache record, as kept by the Ex10CalCacheStorage.
+ * Only the first page_length bytes of the page are stored.
+ */
+struct CalibrationCacheRecord
+{
+    uint32_t                   magic;
+    struct CalibrationCacheKey key;
+    uint16_t                   page_length;
+    uint16_t                   page_crc16;
+    uint8_t                    page[CALIBRATION_INFO_REG_LENGTH];
+};
 
 /**
  * This function calculates inter/extra-polated value (x_new, y_new) from
@@ -144,6 +219,8 @@ static int16_t get_gain_offset(struct Ex10CalibrationParamsV5 const* cal_params,
  */
 static void init_drm_analog_offsets(void)
 {
+    struct CalibrationContext* cal = get_calibration_context();
+
     struct Ex10CalibrationParamsV5 const* cal_params =
         get_ex10_cal_v5()->get_params();
 
@@ -172,42 +249,42 @@ static void init_drm_analog_offsets(void)
     // drm 250 BLF - mode 7
     static_assert((uint32_t)DRM_250_IDX < (uint32_t)DRM_ANALOG_LENGTH,
                   "DRM index out of bounds");
-    drm_analog_offset[DRM_250_IDX] =
+    cal->drm_analog_offset[DRM_250_IDX] =
         (calibration_modes_blf_analog_offset[DRM_M4_250_IDX] -
          rssi_comp->calibration_modes_blf_digital_offset[DRM_M4_250_IDX]);
     // drm 320 BLF - mode 5
     static_assert((uint32_t)DRM_320_IDX < (uint32_t)DRM_ANALOG_LENGTH,
                   "DRM index out of bounds");
-    drm_analog_offset[DRM_320_IDX] =
+    cal->drm_analog_offset[DRM_320_IDX] =
         (calibration_modes_blf_analog_offset[DRM_M4_320_IDX] -
          rssi_comp->calibration_modes_blf_digital_offset[DRM_M4_320_IDX]);
 
     // non-drm 160 BLF - mode 13
     static_assert((uint32_t)NON_DRM_160_IDX < (uint32_t)NON_DRM_ANALOG_LENGTH,
                   "Non-DRM index out of bounds");
-    non_drm_analog_offset[NON_DRM_160_IDX] =
+    cal->non_drm_analog_offset[NON_DRM_160_IDX] =
         (calibration_modes_blf_analog_offset[NON_DRM_M8_160_IDX] -
          rssi_comp->calibration_modes_blf_digital_offset[NON_DRM_M8_160_IDX]);
     // non-drm 320 BLF - modes 3, 12
     static_assert((uint32_t)NON_DRM_320_IDX < (uint32_t)NON_DRM_ANALOG_LENGTH,
                   "Non-DRM index out of bounds");
-    non_drm_analog_offset[NON_DRM_320_IDX] =
+    cal->non_drm_analog_offset[NON_DRM_320_IDX] =
         (calibration_modes_blf_analog_offset[NON_DRM_M2_320_IDX_0] -
          rssi_comp->calibration_modes_blf_digital_offset[NON_DRM_M2_320_IDX_0]);
-    non_drm_analog_offset[NON_DRM_320_IDX] +=
+    cal->non_drm_analog_offset[NON_DRM_320_IDX] +=
         (calibration_modes_blf_analog_offset[NON_DRM_M2_320_IDX_1] -
          rssi_comp->calibration_modes_blf_digital_offset[NON_DRM_M2_320_IDX_1]);
-    non_drm_analog_offset[NON_DRM_320_IDX] /= 2;
+    cal->non_drm_analog_offset[NON_DRM_320_IDX] /= 2;
     // non-drm 640 BLF - modes 1, 15
     static_assert((uint32_t)NON_DRM_640_IDX < (uint32_t)NON_DRM_ANALOG_LENGTH,
                   "Non-DRM index out of bounds");
-    non_drm_analog_offset[NON_DRM_640_IDX] =
+    cal->non_drm_analog_offset[NON_DRM_640_IDX] =
         (calibration_modes_blf_analog_offset[NON_DRM_M2_640_IDX] -
          rssi_comp->calibration_modes_blf_digital_offset[NON_DRM_M2_640_IDX]);
-    non_drm_analog_offset[NON_DRM_640_IDX] +=
+    cal->non_drm_analog_offset[NON_DRM_640_IDX] +=
         (calibration_modes_blf_analog_offset[NON_DRM_M4_640_IDX] -
          rssi_comp->calibration_modes_blf_digital_offset[NON_DRM_M4_640_IDX]);
-    non_drm_analog_offset[NON_DRM_640_IDX] /= 2;
+    cal->non_drm_analog_offset[NON_DRM_640_IDX] /= 2;
 }
 
 /**
@@ -221,6 +298,8 @@ static void init_drm_analog_offsets(void)
 static int16_t get_analog_baseband_freq_offset(int16_t baseband_freq,
                                                uint8_t drm)
 {
+    struct CalibrationContext* cal = get_calibration_context();
+
     // Using the same array lengths as the analog offset arrays to ensure we can
     // compare them
     const int16_t drm_analog_freq_khz[DRM_ANALOG_LENGTH]         = {250, 320};
@@ -229,11 +308,11 @@ static int16_t get_analog_baseband_freq_offset(int16_t baseband_freq,
 
     const int16_t analog_offset =
         (drm == 0) ? inter_extra_polate(non_drm_analog_freq_khz,
-                                        non_drm_analog_offset,
+                                        cal->non_drm_analog_offset,
                                         NON_DRM_ANALOG_LENGTH,
                                         baseband_freq)
                    : inter_extra_polate(drm_analog_freq_khz,
-                                        drm_analog_offset,
+                                        cal->drm_analog_offset,
                                         DRM_ANALOG_LENGTH,
                                         baseband_freq);
     return analog_offset;
@@ -388,67 +467,131 @@ static uint16_t cdbm_to_log2(struct Ex10CalibrationParamsV5 const* cal_params,
     return (uint16_t)log2_val;
 }
 
-/**
- * Compensates RSSI value for temperature, analog settings, and RF mode
- * based on calibration table.
- *
- * @param rssi_raw      Raw RSSI_LOG_2 value from firmware op
- * @param rf_mode       RF mode
- * @param rx_settings   Settings corresponding to RxGainControl register
- * @param antenna       Antenna port used
- * @param rf_band       Which RF band we are using
- * @param temp_adc      Temperature ADC code
- * @param baseband_freq The baseband frequency at which we expect the signal
- *
- * @return int16_t     Compensated RSSI value in cdBm
- */
-static int16_t get_compensated_rssi_baseband_freq_offset(
-    uint16_t                          rssi_raw,
+static uint16_t get_rf_mode_baseband_freq_khz(enum RfModes rf_mode)
+{
+    struct RssiCompensationLut const* rssi_comp = get_ex10_rssi_compensation();
+
+    for (uint16_t idx = 0; idx < NUM_MODES; ++idx)
+    {
+        if (rf_mode == (enum RfModes)rssi_comp->rf_modes[idx])
+        {
+            return rssi_comp
+                ->rx_modes_blf_khz[rssi_comp->rf_mode_to_rx_mode[idx]];
+        }
+    }
+
+    // Error case: Requested RF mode does not exist.
+    /// @todo Is this the right thing to do?
+    return 0;
+}
+
+static void build_rssi_compensation_plan(
     enum RfModes                      rf_mode,
     const struct RxGainControlFields* rx_settings,
     uint8_t                           antenna,
     enum RfFilter                     rf_band,
     uint16_t                          temp_adc,
-    int16_t                           baseband_freq)
+    struct Ex10RssiCompensationPlan*  plan)
 {
-    if (cal_version != 0x05)
+    struct CalibrationContext* cal = get_calibration_context();
+
+    ex10_memzero(plan, sizeof(*plan));
+    plan->rf_mode     = rf_mode;
+    plan->rx_settings = *rx_settings;
+    plan->antenna     = antenna;
+    plan->rf_band     = rf_band;
+    plan->temp_adc    = temp_adc;
+    plan->generation  = cal->rssi_plan_generation;
+    plan->calibrated  = (cal->cal_version == 0x05);
+
+    if (plan->calibrated == false)
     {
-        return (int16_t)rssi_raw;
+        return;
     }
 
     struct Ex10CalibrationParamsV5 const* cal_params =
         get_ex10_cal_v5()->get_params();
 
+    int16_t const baseband_freq =
+        (int16_t)get_rf_mode_baseband_freq_khz(rf_mode);
     int16_t const gain_offset =
         get_gain_offset(cal_params, rx_settings, antenna, rf_band);
     int16_t const mode_offset = get_mode_rssi_offset(rf_mode, baseband_freq);
     int16_t const temp_offset = get_temp_offset(cal_params, temp_adc);
 
-    int32_t const rssi_log2_compensated =
-        rssi_raw - gain_offset - mode_offset - temp_offset;
-
-    int16_t const rssi_cdbm =
-        log2_to_cdbm(cal_params, (uint16_t)rssi_log2_compensated);
+    plan->log2_offset = gain_offset + mode_offset + temp_offset;
 
-    return rssi_cdbm;
+    // The constant terms of log2_to_cdbm(), which leaves a multiply and a
+    // divide for each RSSI value.
+    int32_t const rssi_dflt_cdbm =
+        cal_params->rssi_rx_default_pwr.input_powers * 100;
+    int32_t const rssi_dflt_log2 =
+        cal_params->rssi_rx_default_log2.power_shifts;
+    plan->cdbm_bias = rssi_dflt_cdbm * 100 - rssi_dflt_log2 * 470 + 50;
 }
 
-static uint16_t get_rf_mode_baseband_freq_khz(enum RfModes rf_mode)
+/**
+ * Compensate a raw RSSI value using an RSSI compensation plan.
+ * The plan's offsets are subtracted from the raw value, which is then
+ * converted from log2 to cdBm as log2_to_cdbm() does.
+ *
+ * @param plan     The RSSI compensation plan.
+ * @param rssi_raw Raw RSSI_LOG_2 value from firmware op
+ *
+ * @return int16_t Compensated RSSI value in cdBm
+ */
+static inline int16_t apply_rssi_compensation_plan(
+    struct Ex10RssiCompensationPlan const* plan,
+    uint16_t                               rssi_raw)
 {
-    struct RssiCompensationLut const* rssi_comp = get_ex10_rssi_compensation();
+    uint16_t const rssi_log2_compensated =
+        (uint16_t)(rssi_raw - plan->log2_offset);
+    return (int16_t)(((int32_t)rssi_log2_compensated * 470 + plan->cdbm_bias) /
+                     100);
+}
 
-    for (uint16_t idx = 0; idx < NUM_MODES; ++idx)
+static void compensate_rssi_batch(struct Ex10RssiCompensationPlan const* plan,
+                                  uint16_t const* rssi_raw,
+                                  int16_t*        rssi_cdbm,
+                                  size_t          count)
+{
+    if (plan->calibrated == false)
     {
-        if (rf_mode == (enum RfModes)rssi_comp->rf_modes[idx])
+        for (size_t index = 0u; index < count; ++index)
         {
-            return rssi_comp
-                ->rx_modes_blf_khz[rssi_comp->rf_mode_to_rx_mode[idx]];
+            rssi_cdbm[index] = (int16_t)rssi_raw[index];
         }
+        return;
     }
 
-    // Error case: Requested RF mode does not exist.
-    /// @todo Is this the right thing to do?
-    return 0;
+    // Copy the plan so that the loop body has no loads which could alias
+    // the output, allowing the compiler to vectorize it.
+    struct Ex10RssiCompensationPlan const local_plan = *plan;
+    for (size_t index = 0u; index < count; ++index)
+    {
+        rssi_cdbm[index] =
+            apply_rssi_compensation_plan(&local_plan, rssi_raw[index]);
+    }
+}
+
+static bool rssi_plan_matches(
+    struct Ex10RssiCompensationPlan const* plan,
+    enum RfModes                           rf_mode,
+    const struct RxGainControlFields*      rx_settings,
+    uint8_t                                antenna,
+    enum RfFilter                          rf_band,
+    uint16_t                               temp_adc)
+{
+    struct CalibrationContext* cal = get_calibration_context();
+
+    return plan->generation == cal->rssi_plan_generation &&
+           plan->rf_mode == rf_mode && plan->antenna == antenna &&
+           plan->rf_band == rf_band && plan->temp_adc == temp_adc &&
+           plan->rx_settings.rx_atten == rx_settings->rx_atten &&
+           plan->rx_settings.pga1_gain == rx_settings->pga1_gain &&
+           plan->rx_settings.pga2_gain == rx_settings->pga2_gain &&
+           plan->rx_settings.pga3_gain == rx_settings->pga3_gain &&
+           plan->rx_settings.mixer_gain == rx_settings->mixer_gain;
 }
 
 /**
@@ -472,17 +615,29 @@ static int16_t get_compensated_rssi(
     enum RfFilter                     rf_band,
     uint16_t                          temp_adc)
 {
-    int16_t const baseband_freq =
-        (int16_t)get_rf_mode_baseband_freq_khz(rf_mode);
-    int16_t const rssi_cdbm =
-        get_compensated_rssi_baseband_freq_offset(rssi_raw,
-                                                  rf_mode,
-                                                  rx_settings,
-                                                  antenna,
-                                                  rf_band,
-                                                  temp_adc,
-                                                  baseband_freq);
-    return rssi_cdbm;
+    struct Ex10RssiCompensationPlan* last_rssi_plan =
+        &last_rssi_plans[ex10_context_index()];
+
+    if (rssi_plan_matches(last_rssi_plan,
+                          rf_mode,
+                          rx_settings,
+                          antenna,
+                          rf_band,
+                          temp_adc) == false)
+    {
+        build_rssi_compensation_plan(rf_mode,
+                                     rx_settings,
+                                     antenna,
+                                     rf_band,
+                                     temp_adc,
+                                     last_rssi_plan);
+    }
+
+    if (last_rssi_plan->calibrated == false)
+    {
+        return (int16_t)rssi_raw;
+    }
+    return apply_rssi_compensation_plan(last_rssi_plan, rssi_raw);
 }
 
 /**
@@ -508,7 +663,9 @@ static uint16_t get_rssi_log2_baseband_freq_offset(
     uint16_t                          temp_adc,
     int16_t                           baseband_freq)
 {
-    if (cal_version != 0x05)
+    struct CalibrationContext* cal = get_calibration_context();
+
+    if (cal->cal_version != 0x05)
     {
         return (uint16_t)0u;
     }
@@ -585,7 +742,9 @@ static int16_t get_compensated_lbt_rssi(
     enum RfFilter                     rf_band,
     uint16_t                          temp_adc)
 {
-    if (cal_version != 0x05)
+    struct CalibrationContext* cal = get_calibration_context();
+
+    if (cal->cal_version != 0x05)
     {
         return (int16_t)rssi_raw;
     }
@@ -1030,7 +1189,9 @@ static uint16_t power_to_adc(
     enum RfFilter                        rf_band,
     enum AuxAdcControlChannelEnableBits* power_detector_adc)
 {
-    if (cal_version != 0x05)
+    struct CalibrationContext* cal = get_calibration_context();
+
+    if (cal->cal_version != 0x05)
     {
         return CAL_FUNC_NOT_SUPPORTED;
     }
@@ -1233,7 +1394,9 @@ static uint16_t reverse_power_to_adc(
     enum RfFilter                        rf_band,
     enum AuxAdcControlChannelEnableBits* reverse_power_detector_adc)
 {
-    if (cal_version != 0x05)
+    struct CalibrationContext* cal = get_calibration_context();
+
+    if (cal->cal_version != 0x05)
     {
         return CAL_FUNC_NOT_SUPPORTED;
     }
@@ -1415,7 +1578,9 @@ static uint16_t reverse_power_to_adc(
 
 static uint16_t get_adc_error_threshold(void const* cal_params)
 {
-    if (cal_version == 0x05)
+    struct CalibrationContext* cal = get_calibration_context();
+
+    if (cal->cal_version == 0x05)
     {
         assert(cal_params);
         return ((struct Ex10CalibrationParamsV5 const*)cal_params)
@@ -1429,7 +1594,9 @@ static uint16_t get_adc_error_threshold(void const* cal_params)
 
 static uint16_t get_loop_gain(void const* cal_params)
 {
-    if (cal_version == 0x05)
+    struct CalibrationContext* cal = get_calibration_context();
+
+    if (cal->cal_version == 0x05)
     {
         assert(cal_params);
         return ((struct Ex10CalibrationParamsV5 const*)cal_params)
@@ -1443,7 +1610,9 @@ static uint16_t get_loop_gain(void const* cal_params)
 
 static uint32_t get_max_iterations(void const* cal_params)
 {
-    if (cal_version == 0x05)
+    struct CalibrationContext* cal = get_calibration_context();
+
+    if (cal->cal_version == 0x05)
     {
         assert(cal_params);
         return ((struct Ex10CalibrationParamsV5 const*)cal_params)
@@ -1472,7 +1641,9 @@ static struct PowerConfigs get_power_control_params(int16_t  tx_power_cdbm,
                                                     bool     temp_comp_enabled,
                                                     enum RfFilter rf_band)
 {
-    if (cal_version == 0xFF)
+    struct CalibrationContext* cal = get_calibration_context();
+
+    if (cal->cal_version == 0xFF)
     {
         // If the calibration data is erased, the version will be read as FFs
         // and we'll use default calibration
@@ -1528,81 +1699,231 @@ static struct PowerConfigs get_power_control_params(int16_t  tx_power_cdbm,
 
 static uint8_t get_cal_version(void)
 {
-    return cal_version;
+    struct CalibrationContext* cal = get_calibration_context();
+
+    return cal->cal_version;
 }
 
 static uint8_t get_customer_cal_version(void)
 {
-    return customer_cal_version;
+    struct CalibrationContext* cal = get_calibration_context();
+
+    return cal->customer_cal_version;
 }
 
-static int16_t cal_init(struct Ex10Protocol const* ex10_protocol)
+static bool set_cache_path(char const* path)
 {
-    // Read the cal version and customer cal version so we can parse the cal
-    // info correctly
-    uint16_t const source_address = calibration_info_reg.address;
+    return get_ex10_cal_cache_storage()->set_location(path);
+}
+
+/**
+ * @return bool true if the serial number identifies the device, false if it
+ *              was never programmed, in which case it cannot key the cache.
+ */
+static bool is_serial_number_set(uint8_t const* serial_number)
+{
+    bool all_zero = true;
+    bool all_ones = true;
+    for (size_t index = 0u; index < SERIAL_NUMBER_REG_LENGTH; ++index)
+    {
+        all_zero = all_zero && (serial_number[index] == 0x00u);
+        all_ones = all_ones && (serial_number[index] == 0xFFu);
+    }
+    return (all_zero || all_ones) == false;
+}
+
+/**
+ * Get the length of the start of the calibration info region which is read
+ * from the device on every load to validate the cache: the calibration
+ * versions, the version strings, the board id and the Tx scalar calibration.
+ * The length is taken from the device layout in the calibration offset table.
+ */
+static size_t get_cal_page_header_length(void)
+{
+    return get_ex10_cal_v5()->get_page_offset(
+        offsetof(struct Ex10CalibrationParamsV5, rf_filter_upper_band));
+}
+
+/**
+ * Read the device serial number and the header of its calibration info
+ * region, which together key the cache record.
+ *
+ * @return bool true if the key was read and identifies the device.
+ */
+static bool read_cal_cache_key(struct Ex10Protocol const*  ex10_protocol,
+                               struct CalibrationCacheKey* key)
+{
+    size_t const header_length = get_cal_page_header_length();
+    if (header_length > sizeof(key->page_header))
+    {
+        return false;
+    }
+    ex10_memzero(key, sizeof(*key));
 
-    // Read 1 byte from offset 0 for the Impinj cal version
     struct Ex10Result ex10_result =
-        ex10_protocol->read_partial(source_address, 1u, &cal_version);
-    if (ex10_result.error)
+        ex10_protocol->read_partial(serial_number_reg.address,
+                                    (uint16_t)sizeof(key->serial_number),
+                                    key->serial_number);
+    if (ex10_result.error || is_serial_number_set(key->serial_number) == false)
     {
-        return -1;
+        return false;
     }
 
-    // Read 1 byte from offset 1 for the customer assigned cal version
-    ex10_result = ex10_protocol->read_partial(
-        source_address + offsetof(struct Ex10CalibrationParamsV5,
-                                  customer_calibration_version),
-        1u,
-        &customer_cal_version);
+    ex10_result =
+        ex10_protocol->read_partial(calibration_info_reg.address,
+                                    (uint16_t)header_length,
+                                    key->page_header);
+    return ex10_result.error == false;
+}
+
+/**
+ * Read the calibration info region from the cache record, if the record
+ * holds the region of the device with the key.
+ *
+ * @return bool true if the record page was read and may be used.
+ */
+static bool read_cal_cache(struct CalibrationCacheKey const* key,
+                           struct CalibrationCacheRecord*    record,
+                           size_t                            page_length)
+{
+    size_t const record_length =
+        offsetof(struct CalibrationCacheRecord, page) + page_length;
+    bool const cache_hit =
+        get_ex10_cal_cache_storage()->read(record, record_length) &&
+        record->magic == cal_cache_magic &&
+        memcmp(&record->key, key, sizeof(record->key)) == 0 &&
+        record->page_length == page_length;
+
+    return cache_hit && ex10_compute_crc16(record->page, page_length) ==
+                            record->page_crc16;
+}
+
+static void write_cal_cache(struct CalibrationCacheKey const* key,
+                            struct CalibrationCacheRecord*    record,
+                            size_t                            page_length)
+{
+    record->magic       = cal_cache_magic;
+    record->key         = *key;
+    record->page_length = (uint16_t)page_length;
+    record->page_crc16  = ex10_compute_crc16(record->page, page_length);
+
+    get_ex10_cal_cache_storage()->write(
+        record, offsetof(struct CalibrationCacheRecord, page) + page_length);
+}
+
+/**
+ * Get the calibration info region holding the calibration parameters,
+ * from the cache record if the cache is enabled and holds the region of
+ * the device, otherwise with a single Read of the region.
+ *
+ * @note The Ex10 does not expose a CRC of the stored region; the cache is
+ *       validated on every load against the serial number and the region
+ *       header only. See Ex10Calibration.set_cache_path().
+ */
+static struct Ex10Result load_cal_page(
+    struct Ex10Protocol const*     ex10_protocol,
+    struct CalibrationCacheRecord* record,
+    size_t                         page_length)
+{
+    struct CalibrationCacheKey key;
+    bool const                 use_cache =
+        get_ex10_cal_cache_storage()->is_enabled() &&
+        read_cal_cache_key(ex10_protocol, &key);
+
+    if (use_cache && read_cal_cache(&key, record, page_length))
+    {
+        return make_ex10_success();
+    }
+
+    struct Ex10Result const ex10_result = ex10_protocol->read_partial(
+        calibration_info_reg.address, (uint16_t)page_length, record->page);
+    if (ex10_result.error == false && use_cache)
+    {
+        write_cal_cache(&key, record, page_length);
+    }
+    return ex10_result;
+}
+
+static int16_t cal_init(struct Ex10Protocol const* ex10_protocol)
+{
+    struct CalibrationContext*      cal    = get_calibration_context();
+    struct Ex10CalibrationV5 const* cal_v5 = get_ex10_cal_v5();
+
+    // Read the calibration info region once; the cal version and customer
+    // cal version at its start determine how the region is parsed.
+    static EX10_THREAD_LOCAL struct CalibrationCacheRecord record;
+
+    size_t const page_length = cal_v5->get_page_length();
+    struct Ex10Result const ex10_result =
+        load_cal_page(ex10_protocol, &record, page_length);
     if (ex10_result.error)
     {
         return -1;
     }
 
-    if (cal_version != 0xFF && cal_version != 0x05)
+    uint8_t const* const page = record.page;
+
+    size_t const version_offset = cal_v5->get_page_offset(
+        offsetof(struct Ex10CalibrationParamsV5, calibration_version));
+    size_t const customer_version_offset = cal_v5->get_page_offset(
+        offsetof(struct Ex10CalibrationParamsV5, customer_calibration_version));
+
+    cal->cal_version          = page[version_offset];
+    cal->customer_cal_version = page[customer_version_offset];
+
+    if (cal->cal_version != 0xFF && cal->cal_version != 0x05)
     {
-        ex10_eprintf("Calibration version %u is not supported\n", cal_version);
+        ex10_eprintf("Calibration version %u is not supported\n",
+                     cal->cal_version);
         ex10_eprintf(
             "Please upgrade your calibration or erase the current one "
             "and run without calibration.\n");
     }
 
-    if (cal_version == 0xFF)
+    if (cal->cal_version == 0xFF)
     {
         ex10_eprintf("CALIBRATION NOT FOUND, DEFAULT SETTINGS WILL BE USED\n");
     }
 
-    if (cal_version == 0x05 && customer_cal_version != 0x00)
+    if (cal->cal_version == 0x05 && cal->customer_cal_version != 0x00)
     {
         ex10_eprintf("Customer calibration version %u will be used\n",
-                     customer_cal_version);
+                     cal->customer_cal_version);
     }
 
     // Read configs in from device
-    if (cal_version == 0x05)
+    if (cal->cal_version == 0x05)
     {
-        get_ex10_cal_v5()->init(ex10_protocol);
+        cal_v5->init_from_page(page, page_length);
     }
     // Run initialization of arrays used in this layer
     // Note:
     // If the version is not supported, default configurations will be used.
     init_drm_analog_offsets();
-    return (cal_version != 0x05) ? (int16_t)-1 : cal_version;
+
+    // The RSSI compensation plans were built from the previous calibration.
+    cal->rssi_plan_generation += 1u;
+    if (cal->rssi_plan_generation == 0u)
+    {
+        cal->rssi_plan_generation = 1u;
+    }
+    return (cal->cal_version != 0x05) ? (int16_t)-1 : cal->cal_version;
 }
 
 static const struct Ex10Calibration ex10_calibration = {
-    .init                     = cal_init,
-    .deinit                   = NULL,
-    .power_to_adc             = power_to_adc,
-    .reverse_power_to_adc     = reverse_power_to_adc,
-    .get_power_control_params = get_power_control_params,
-    .get_compensated_rssi     = get_compensated_rssi,
-    .get_rssi_log2            = get_rssi_log2,
-    .get_compensated_lbt_rssi = get_compensated_lbt_rssi,
-    .get_cal_version          = get_cal_version,
-    .get_customer_cal_version = get_customer_cal_version};
+    .init                         = cal_init,
+    .deinit                       = NULL,
+    .power_to_adc                 = power_to_adc,
+    .reverse_power_to_adc         = reverse_power_to_adc,
+    .get_power_control_params     = get_power_control_params,
+    .get_compensated_rssi         = get_compensated_rssi,
+    .get_rssi_log2                = get_rssi_log2,
+    .get_compensated_lbt_rssi     = get_compensated_lbt_rssi,
+    .get_cal_version              = get_cal_version,
+    .get_customer_cal_version     = get_customer_cal_version,
+    .build_rssi_compensation_plan = build_rssi_compensation_plan,
+    .compensate_rssi_batch        = compensate_rssi_batch,
+    .set_cache_path               = set_cache_path};
 
 struct Ex10Calibration const* get_ex10_calibration(void)
 {
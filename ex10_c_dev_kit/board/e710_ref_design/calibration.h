@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <sys/types.h>
 
@@ -29,6 +31,37 @@ extern "C" {
  * coincide with actual ADC readings. */
 #define CAL_FUNC_NOT_SUPPORTED ((uint16_t)0xFFFF)
 
+/**
+ * @struct Ex10RssiCompensationPlan
+ * The RSSI compensation of one receive configuration, built by
+ * Ex10Calibration.build_rssi_compensation_plan(). Compensating a raw RSSI
+ * value with a plan does not search or interpolate the calibration tables.
+ */
+struct Ex10RssiCompensationPlan
+{
+    /// The receive configuration the plan was built for.
+    enum RfModes               rf_mode;
+    struct RxGainControlFields rx_settings;
+    uint8_t                    antenna;
+    enum RfFilter              rf_band;
+    uint16_t                   temp_adc;
+
+    /// The Ex10Calibration.init() call the plan was built after.
+    /// Plans built before the most recent init() call are stale.
+    uint32_t generation;
+
+    /// false if the calibration does not support RSSI compensation,
+    /// in which case raw RSSI values are returned unchanged.
+    bool calibrated;
+
+    /// The sum of the gain, RF mode and temperature offsets, in RSSI log2
+    /// units.
+    int32_t log2_offset;
+
+    /// The constant term of the RSSI log2 to cdBm conversion.
+    int32_t cdbm_bias;
+};
+
 struct Ex10Calibration
 {
     /**
@@ -184,6 +217,77 @@ struct Ex10Calibration
      * @return The current board customer calibration version
      */
     uint8_t (*get_customer_cal_version)(void);
+
+    /**
+     * Build the RSSI compensation plan of a receive configuration.
+     * The plan holds the gain, RF mode and temperature offsets which
+     * get_compensated_rssi() would compute for each RSSI value.
+     *
+     * @note get_compensated_rssi() keeps the plan of the most recent
+     *       receive configuration, so calling it repeatedly with the same
+     *       configuration only computes the offsets once.
+     *
+     * @param rf_mode     RF mode
+     * @param rx_settings Settings corresponding to RxGainControl register
+     * @param antenna     Antenna port used
+     * @param rf_band     Which RF band we are using
+     * @param temp_adc    Temperature ADC code
+     * @param [out] plan  The RSSI compensation plan.
+     */
+    void (*build_rssi_compensation_plan)(
+        enum RfModes                      rf_mode,
+        const struct RxGainControlFields* rx_settings,
+        uint8_t                           antenna,
+        enum RfFilter                     rf_band,
+        uint16_t                          temp_adc,
+        struct Ex10RssiCompensationPlan*  plan);
+
+    /**
+     * Compensate an array of raw RSSI values using a plan built by
+     * build_rssi_compensation_plan(). Each result equals the value
+     * get_compensated_rssi() returns for the plan's receive configuration.
+     *
+     * @param plan            The RSSI compensation plan.
+     * @param rssi_raw        The raw RSSI_LOG_2 values from the firmware op.
+     * @param [out] rssi_cdbm The compensated RSSI values in cdBm.
+     * @param count           The number of values in rssi_raw and rssi_cdbm.
+     *
+     * @note A plan built before the most recent init() call must be
+     *       rebuilt before it is used.
+     */
+    void (*compensate_rssi_batch)(
+        struct Ex10RssiCompensationPlan const* plan,
+        uint16_t const*                        rssi_raw,
+        int16_t*                               rssi_cdbm,
+        size_t                                 count);
+
+    /**
+     * Set the file used to cache the calibration info region across runs.
+     * When set, init() reads the device serial number and the header of the
+     * region (the calibration versions, board id and Tx scalar). If the
+     * cache holds the region of that device with that header, the
+     * calibration is parsed from the cache rather than read from the Ex10.
+     * Otherwise the region is read from the Ex10 and the cache is rewritten.
+     *
+     * @note Devices whose serial number was never programmed are not cached.
+     *       The cache is validated against the serial number and the region
+     *       header only, so a recalibration which leaves the header unchanged
+     *       is not detected on load. Ex10Protocol.write_calibration_page()
+     *       and erase_calibration_page() delete the cache, but only the cache
+     *       set in the process which writes the page. A calibration written
+     *       by another process, such as the FCT wrapper driven by pc_cal,
+     *       deletes the cache only if that process is given its path: the
+     *       FCT wrapper takes it from the EX10_CAL_CACHE_PATH environment
+     *       variable.
+     * @see struct Ex10CalCacheStorage, which stores the cache for the board.
+     *
+     * @param path The cache file path, or NULL to disable the cache.
+     *             The path is copied.
+     *
+     * @return bool false if the path is too long, in which case the
+     *              previous setting is kept.
+     */
+    bool (*set_cache_path)(char const* path);
 };
 
 struct Ex10Calibration const* get_ex10_calibration(void);
@@ -13,15 +13,16 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
+#include "board/ex10_osal.h"
 #include "calibration_v5.h"
 #include "ex10_api/application_registers.h"
+#include "ex10_api/ex10_context.h"
 
 // clang-format off
 // Impinj_calgen | gen_calibration_v5_c {
 
-static struct Ex10CalibrationParamsV5 calibration_parameters;
-
 static struct Ex10CalibrationParamsV5 const calibration_parameters_default =
 {
     .calibration_version = {
@@ -179,236 +180,296 @@ static struct CalibrationOffset const offset_table[] =
     {
         .source      =   0,
         .destination = offsetof(struct Ex10CalibrationParamsV5, calibration_version),
-        .length      = sizeof(calibration_parameters.calibration_version)
+        .length      = sizeof(calibration_parameters_default.calibration_version)
     },
     {
         .source      =   1,
         .destination = offsetof(struct Ex10CalibrationParamsV5, customer_calibration_version),
-        .length      = sizeof(calibration_parameters.customer_calibration_version)
+        .length      = sizeof(calibration_parameters_default.customer_calibration_version)
     },
     {
         .source      =   4,
         .destination = offsetof(struct Ex10CalibrationParamsV5, version_strings),
-        .length      = sizeof(calibration_parameters.version_strings)
+        .length      = sizeof(calibration_parameters_default.version_strings)
     },
     {
         .source      =  10,
         .destination = offsetof(struct Ex10CalibrationParamsV5, user_board_id),
-        .length      = sizeof(calibration_parameters.user_board_id)
+        .length      = sizeof(calibration_parameters_default.user_board_id)
     },
     {
         .source      =  12,
         .destination = offsetof(struct Ex10CalibrationParamsV5, tx_scalar_cal),
-        .length      = sizeof(calibration_parameters.tx_scalar_cal)
+        .length      = sizeof(calibration_parameters_default.tx_scalar_cal)
     },
     {
         .source      =  14,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rf_filter_upper_band),
-        .length      = sizeof(calibration_parameters.rf_filter_upper_band)
+        .length      = sizeof(calibration_parameters_default.rf_filter_upper_band)
     },
     {
         .source      =  22,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rf_filter_lower_band),
-        .length      = sizeof(calibration_parameters.rf_filter_lower_band)
+        .length      = sizeof(calibration_parameters_default.rf_filter_lower_band)
     },
     {
         .source      =  30,
         .destination = offsetof(struct Ex10CalibrationParamsV5, valid_pdet_adcs),
-        .length      = sizeof(calibration_parameters.valid_pdet_adcs)
+        .length      = sizeof(calibration_parameters_default.valid_pdet_adcs)
     },
     {
         .source      =  34,
         .destination = offsetof(struct Ex10CalibrationParamsV5, control_loop_params),
-        .length      = sizeof(calibration_parameters.control_loop_params)
+        .length      = sizeof(calibration_parameters_default.control_loop_params)
     },
     {
         .source      =  40,
         .destination = offsetof(struct Ex10CalibrationParamsV5, upper_band_pdet_adc_lut),
-        .length      = sizeof(calibration_parameters.upper_band_pdet_adc_lut)
+        .length      = sizeof(calibration_parameters_default.upper_band_pdet_adc_lut)
     },
     {
         .source      = 226,
         .destination = offsetof(struct Ex10CalibrationParamsV5, upper_band_fwd_power_coarse_pwr_cal),
-        .length      = sizeof(calibration_parameters.upper_band_fwd_power_coarse_pwr_cal)
+        .length      = sizeof(calibration_parameters_default.upper_band_fwd_power_coarse_pwr_cal)
     },
     {
         .source      = 350,
         .destination = offsetof(struct Ex10CalibrationParamsV5, upper_band_fwd_power_temp_slope),
-        .length      = sizeof(calibration_parameters.upper_band_fwd_power_temp_slope)
+        .length      = sizeof(calibration_parameters_default.upper_band_fwd_power_temp_slope)
     },
     {
         .source      = 354,
         .destination = offsetof(struct Ex10CalibrationParamsV5, upper_band_cal_temp),
-        .length      = sizeof(calibration_parameters.upper_band_cal_temp)
+        .length      = sizeof(calibration_parameters_default.upper_band_cal_temp)
     },
     {
         .source      = 356,
         .destination = offsetof(struct Ex10CalibrationParamsV5, upper_band_lo_pdet_temp_slope),
-        .length      = sizeof(calibration_parameters.upper_band_lo_pdet_temp_slope)
+        .length      = sizeof(calibration_parameters_default.upper_band_lo_pdet_temp_slope)
     },
     {
         .source      = 368,
         .destination = offsetof(struct Ex10CalibrationParamsV5, upper_band_lo_pdet_freq_lut),
-        .length      = sizeof(calibration_parameters.upper_band_lo_pdet_freq_lut)
+        .length      = sizeof(calibration_parameters_default.upper_band_lo_pdet_freq_lut)
     },
     {
         .source      = 392,
         .destination = offsetof(struct Ex10CalibrationParamsV5, upper_band_lo_pdet_freqs),
-        .length      = sizeof(calibration_parameters.upper_band_lo_pdet_freqs)
+        .length      = sizeof(calibration_parameters_default.upper_band_lo_pdet_freqs)
     },
     {
         .source      = 424,
         .destination = offsetof(struct Ex10CalibrationParamsV5, upper_band_fwd_pwr_freq_lut),
-        .length      = sizeof(calibration_parameters.upper_band_fwd_pwr_freq_lut)
+        .length      = sizeof(calibration_parameters_default.upper_band_fwd_pwr_freq_lut)
     },
     {
         .source      = 456,
         .destination = offsetof(struct Ex10CalibrationParamsV5, lower_band_pdet_adc_lut),
-        .length      = sizeof(calibration_parameters.lower_band_pdet_adc_lut)
+        .length      = sizeof(calibration_parameters_default.lower_band_pdet_adc_lut)
     },
     {
         .source      = 642,
         .destination = offsetof(struct Ex10CalibrationParamsV5, lower_band_fwd_power_coarse_pwr_cal),
-        .length      = sizeof(calibration_parameters.lower_band_fwd_power_coarse_pwr_cal)
+        .length      = sizeof(calibration_parameters_default.lower_band_fwd_power_coarse_pwr_cal)
     },
     {
         .source      = 766,
         .destination = offsetof(struct Ex10CalibrationParamsV5, lower_band_fwd_power_temp_slope),
-        .length      = sizeof(calibration_parameters.lower_band_fwd_power_temp_slope)
+        .length      = sizeof(calibration_parameters_default.lower_band_fwd_power_temp_slope)
     },
     {
         .source      = 770,
         .destination = offsetof(struct Ex10CalibrationParamsV5, lower_band_cal_temp),
-        .length      = sizeof(calibration_parameters.lower_band_cal_temp)
+        .length      = sizeof(calibration_parameters_default.lower_band_cal_temp)
     },
     {
         .source      = 772,
         .destination = offsetof(struct Ex10CalibrationParamsV5, lower_band_lo_pdet_temp_slope),
-        .length      = sizeof(calibration_parameters.lower_band_lo_pdet_temp_slope)
+        .length      = sizeof(calibration_parameters_default.lower_band_lo_pdet_temp_slope)
     },
     {
         .source      = 784,
         .destination = offsetof(struct Ex10CalibrationParamsV5, lower_band_lo_pdet_freq_lut),
-        .length      = sizeof(calibration_parameters.lower_band_lo_pdet_freq_lut)
+        .length      = sizeof(calibration_parameters_default.lower_band_lo_pdet_freq_lut)
     },
     {
         .source      = 808,
         .destination = offsetof(struct Ex10CalibrationParamsV5, lower_band_lo_pdet_freqs),
-        .length      = sizeof(calibration_parameters.lower_band_lo_pdet_freqs)
+        .length      = sizeof(calibration_parameters_default.lower_band_lo_pdet_freqs)
     },
     {
         .source      = 840,
         .destination = offsetof(struct Ex10CalibrationParamsV5, lower_band_fwd_pwr_freq_lut),
-        .length      = sizeof(calibration_parameters.lower_band_fwd_pwr_freq_lut)
+        .length      = sizeof(calibration_parameters_default.lower_band_fwd_pwr_freq_lut)
     },
     {
         .source      = 872,
         .destination = offsetof(struct Ex10CalibrationParamsV5, dc_offset_cal),
-        .length      = sizeof(calibration_parameters.dc_offset_cal)
+        .length      = sizeof(calibration_parameters_default.dc_offset_cal)
     },
     {
         .source      = 996,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rssi_rf_modes),
-        .length      = sizeof(calibration_parameters.rssi_rf_modes)
+        .length      = sizeof(calibration_parameters_default.rssi_rf_modes)
     },
     {
         .source      = 1060,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rssi_rf_mode_lut),
-        .length      = sizeof(calibration_parameters.rssi_rf_mode_lut)
+        .length      = sizeof(calibration_parameters_default.rssi_rf_mode_lut)
     },
     {
         .source      = 1124,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rssi_pga1_lut),
-        .length      = sizeof(calibration_parameters.rssi_pga1_lut)
+        .length      = sizeof(calibration_parameters_default.rssi_pga1_lut)
     },
     {
         .source      = 1132,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rssi_pga2_lut),
-        .length      = sizeof(calibration_parameters.rssi_pga2_lut)
+        .length      = sizeof(calibration_parameters_default.rssi_pga2_lut)
     },
     {
         .source      = 1140,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rssi_pga3_lut),
-        .length      = sizeof(calibration_parameters.rssi_pga3_lut)
+        .length      = sizeof(calibration_parameters_default.rssi_pga3_lut)
     },
     {
         .source      = 1148,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rssi_mixer_gain_lut),
-        .length      = sizeof(calibration_parameters.rssi_mixer_gain_lut)
+        .length      = sizeof(calibration_parameters_default.rssi_mixer_gain_lut)
     },
     {
         .source      = 1156,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rssi_rx_att_lut),
-        .length      = sizeof(calibration_parameters.rssi_rx_att_lut)
+        .length      = sizeof(calibration_parameters_default.rssi_rx_att_lut)
     },
     {
         .source      = 1164,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rssi_antennas),
-        .length      = sizeof(calibration_parameters.rssi_antennas)
+        .length      = sizeof(calibration_parameters_default.rssi_antennas)
     },
     {
         .source      = 1172,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rssi_antenna_lut),
-        .length      = sizeof(calibration_parameters.rssi_antenna_lut)
+        .length      = sizeof(calibration_parameters_default.rssi_antenna_lut)
     },
     {
         .source      = 1188,
         .destination = offsetof(struct Ex10CalibrationParamsV5, upper_band_rssi_freq_offset),
-        .length      = sizeof(calibration_parameters.upper_band_rssi_freq_offset)
+        .length      = sizeof(calibration_parameters_default.upper_band_rssi_freq_offset)
     },
     {
         .source      = 1190,
         .destination = offsetof(struct Ex10CalibrationParamsV5, lower_band_rssi_freq_offset),
-        .length      = sizeof(calibration_parameters.lower_band_rssi_freq_offset)
+        .length      = sizeof(calibration_parameters_default.lower_band_rssi_freq_offset)
     },
     {
         .source      = 1192,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rssi_rx_default_pwr),
-        .length      = sizeof(calibration_parameters.rssi_rx_default_pwr)
+        .length      = sizeof(calibration_parameters_default.rssi_rx_default_pwr)
     },
     {
         .source      = 1194,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rssi_rx_default_log2),
-        .length      = sizeof(calibration_parameters.rssi_rx_default_log2)
+        .length      = sizeof(calibration_parameters_default.rssi_rx_default_log2)
     },
     {
         .source      = 1196,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rssi_temp_slope),
-        .length      = sizeof(calibration_parameters.rssi_temp_slope)
+        .length      = sizeof(calibration_parameters_default.rssi_temp_slope)
     },
     {
         .source      = 1200,
         .destination = offsetof(struct Ex10CalibrationParamsV5, rssi_temp_intercept),
-        .length      = sizeof(calibration_parameters.rssi_temp_intercept)
+        .length      = sizeof(calibration_parameters_default.rssi_temp_intercept)
     },
 };
 // Impinj_calgen }
 // clang-format on
 
-static void init(struct Ex10Protocol const* ex10_protocol)
+/// The calibration parameters read from each Impinj Reader Chip context.
+static struct Ex10CalibrationParamsV5 calibration_contexts[EX10_MAX_CONTEXTS];
+
+static struct Ex10CalibrationParamsV5* get_calibration_context(void)
+{
+    return &calibration_contexts[ex10_context_index()];
+}
+
+static size_t get_page_length(void)
+{
+    size_t const offset_count = sizeof(offset_table) / sizeof(offset_table[0u]);
+
+    size_t page_length = 0u;
+    for (struct CalibrationOffset const* offset = &offset_table[0u];
+         offset < &offset_table[offset_count];
+         ++offset)
+    {
+        size_t const offset_end = offset->source + offset->length;
+        page_length = (offset_end > page_length) ? offset_end : page_length;
+    }
+    return page_length;
+}
+
+static size_t get_page_offset(size_t parameter_offset)
+{
+    size_t const offset_count = sizeof(offset_table) / sizeof(offset_table[0u]);
+
+    for (struct CalibrationOffset const* offset = &offset_table[0u];
+         offset < &offset_table[offset_count];
+         ++offset)
+    {
+        if (offset->destination == parameter_offset)
+        {
+            return offset->source;
+        }
+    }
+    return get_page_length();
+}
+
+static void init_from_page(uint8_t const* page, size_t page_length)
 {
-    uint16_t const source_base      = calibration_info_reg.address;
-    uint8_t* const destination_base = (uint8_t*)&calibration_parameters;
+    uint8_t* const destination_base = (uint8_t*)get_calibration_context();
     size_t const offset_count = sizeof(offset_table) / sizeof(offset_table[0u]);
 
     for (struct CalibrationOffset const* offset = &offset_table[0u];
          offset < &offset_table[offset_count];
          ++offset)
     {
-        uint16_t const source_address = source_base + offset->source;
-        uint8_t* destination_pointer  = destination_base + offset->destination;
-        ex10_protocol->read_partial(
-            source_address, (uint16_t)offset->length, destination_pointer);
+        if (offset->source + offset->length <= page_length)
+        {
+            uint8_t* destination_pointer =
+                destination_base + offset->destination;
+            memcpy(destination_pointer, &page[offset->source], offset->length);
+        }
+    }
+}
+
+static void init(struct Ex10Protocol const* ex10_protocol)
+{
+    // The parameters are read with a single Read of the used part of the
+    // calibration info region, which the protocol layer splits into as few
+    // SPI transactions as the response buffer allows, and then scattered
+    // from host memory.
+    static EX10_THREAD_LOCAL uint8_t page[CALIBRATION_INFO_REG_LENGTH];
+    size_t const                     page_length = get_page_length();
+
+    struct Ex10Result const ex10_result = ex10_protocol->read_partial(
+        calibration_info_reg.address, (uint16_t)page_length, page);
+    if (ex10_result.error == false)
+    {
+        init_from_page(page, page_length);
     }
 }
 
 static struct Ex10CalibrationParamsV5 const* get_params(void)
 {
+    struct Ex10CalibrationParamsV5 const* calibration_parameters =
+        get_calibration_context();
+
     size_t version =
-        calibration_parameters.calibration_version.cal_file_version;
+        calibration_parameters->calibration_version.cal_file_version;
     if (version == 0x05)
     {
-        return &calibration_parameters;
+        return calibration_parameters;
     }
     else
     {
@@ -417,8 +478,11 @@ static struct Ex10CalibrationParamsV5 const* get_params(void)
 }
 
 static struct Ex10CalibrationV5 const ex10_cal_v5 = {
-    .init       = init,
-    .get_params = get_params,
+    .init            = init,
+    .get_page_length = get_page_length,
+    .get_page_offset = get_page_offset,
+    .init_from_page  = init_from_page,
+    .get_params      = get_params,
 };
 
 struct Ex10CalibrationV5 const* get_ex10_cal_v5(void)
@@ -253,6 +253,35 @@ struct Ex10CalibrationV5
      */
     void (*init)(struct Ex10Protocol const* ex10_protocol);
 
+    /**
+     * @return size_t The number of bytes, from the start of the calibration
+     * info region, which hold the calibration parameters.
+     */
+    size_t (*get_page_length)(void);
+
+    /**
+     * Get the location of a calibration parameter in the calibration info
+     * region, from the calibration offset table.
+     *
+     * @param parameter_offset The offset of the parameter within struct
+     * Ex10CalibrationParamsV5.
+     *
+     * @return size_t The offset of the parameter from the start of the
+     * calibration info region, or get_page_length() if the offset table does
+     * not hold the parameter.
+     */
+    size_t (*get_page_offset)(size_t parameter_offset);
+
+    /**
+     * Parse the calibration parameters from a copy of the calibration info
+     * region held in host memory, such as one read by a previous init().
+     *
+     * @param page        The calibration info region bytes.
+     * @param page_length The number of bytes in page. Parameters which lie
+     * beyond page_length are left unchanged.
+     */
+    void (*init_from_page)(uint8_t const* page, size_t page_length);
+
     /**
      * @return struct CalibrationParameters const* The pointer to the C library
      * struct CalibrationParameters store.
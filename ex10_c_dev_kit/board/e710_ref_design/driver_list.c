@@ -45,6 +45,9 @@ struct Ex10DriverList* get_ex10_board_driver_list(void)
         driver_list.gpio_if.ready_n_pin_get   = gpio_driver->ready_n_pin_get;
         driver_list.gpio_if.reset_device      = gpio_driver->reset_device;
 
+        driver_list.gpio_if.set_ready_n_wait_mode =
+            gpio_driver->set_ready_n_wait_mode;
+
         driver_list.gpio_if.register_irq_callback =
             gpio_driver->register_irq_callback;
         driver_list.gpio_if.deregister_irq_callback =
@@ -64,6 +67,9 @@ struct Ex10DriverList* get_ex10_board_driver_list(void)
         driver_list.host_if.read  = spi_driver->spi_read;
         driver_list.host_if.write = spi_driver->spi_write;
 
+        driver_list.host_if.read_segments  = spi_driver->spi_read_segments;
+        driver_list.host_if.write_segments = spi_driver->spi_write_segments;
+
         struct Ex10UartDriver const* uart_driver = get_ex10_uart_driver();
 
         driver_list.uart_if.open  = uart_driver->uart_open;
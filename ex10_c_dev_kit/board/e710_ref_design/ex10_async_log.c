@@ -0,0 +1,1034 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board/ex10_async_log.h"
+#include "board/ex10_osal.h"
+#include "board/time_helpers.h"
+
+/// The largest record, including its header. Messages whose arguments do
+/// not fit are dropped.
+#define LOG_RECORD_MAX_SIZE ((size_t)1024u)
+
+/// The longest formatted message; longer messages are truncated.
+#define LOG_LINE_MAX_LENGTH ((size_t)2048u)
+
+/// The longest conversion specification, such as "%-+#08.*llx".
+#define LOG_SPEC_MAX_LENGTH ((size_t)32u)
+
+/// Records and argument slots are aligned to this number of bytes.
+#define LOG_SLOT_SIZE ((size_t)8u)
+
+static_assert(EX10_ASYNC_LOG_RING_SIZE % LOG_SLOT_SIZE == 0u,
+              "The ring size must be a multiple of the record alignment");
+
+/// The stream value of the record which pads the end of a ring when the
+/// next record does not fit before the ring wraps.
+static uint32_t const log_record_padding = UINT32_MAX;
+
+/**
+ * @struct LogRecord
+ * The header of a log record. The header is followed by the arguments of
+ * the format string conversions, each in one or more 8 byte slots:
+ * integers, doubles and pointers are stored in one slot, long doubles in as
+ * many slots as they need, and strings as a length slot followed by the
+ * string bytes padded to a slot boundary.
+ */
+struct LogRecord
+{
+    /// The record length, including the header; a multiple of 8 bytes.
+    uint32_t length;
+    /// The enum Ex10LogStream, or log_record_padding.
+    uint32_t stream;
+
+    uint64_t    time_ns;
+    char const* fmt;
+    char const* func;
+
+    /// The number of messages from the call site suppressed by the rate
+    /// limit since the previous message of the call site was recorded.
+    uint32_t suppressed;
+};
+
+/**
+ * @struct LogRing
+ * A single producer, single consumer ring of log records. The producer is
+ * the thread which owns the ring; the consumer is the formatting thread.
+ * The head and tail are byte positions which increase without wrapping.
+ */
+struct LogRing
+{
+    uint8_t bytes[EX10_ASYNC_LOG_RING_SIZE] __attribute__((aligned(8)));
+    size_t  head;
+    size_t  tail;
+    bool    owned;
+};
+
+/**
+ * @struct LogSite
+ * The rate limit state of a call site, identified by its format string.
+ */
+struct LogSite
+{
+    char const* fmt;
+    uint32_t    window_start_ms;
+    uint32_t    window_count;
+    uint32_t    suppressed;
+};
+
+enum LogArgType
+{
+    LogArgNone,
+    LogArgInt,
+    LogArgLong,
+    LogArgLongLong,
+    LogArgSize,
+    LogArgIntMax,
+    LogArgPtrDiff,
+    LogArgDouble,
+    LogArgLongDouble,
+    LogArgString,
+    LogArgPointer,
+    LogArgUnsupported,
+};
+
+/**
+ * @struct LogConversion
+ * A conversion specification within a format string.
+ */
+struct LogConversion
+{
+    char const*     spec;
+    size_t          spec_length;
+    size_t          star_count;
+    enum LogArgType type;
+};
+
+struct AsyncLog
+{
+    struct Ex10AsyncLogConfig config;
+    bool                      started;
+
+    struct LogRing rings[EX10_ASYNC_LOG_MAX_THREADS];
+    struct LogSite sites[EX10_ASYNC_LOG_MAX_SITES];
+
+    struct Ex10AsyncLogStats stats;
+
+    ex10_thread_t thread;
+    ex10_mutex_t  lock;
+    ex10_cond_t   wake_cond;
+    ex10_cond_t   flushed_cond;
+    bool          running;
+    uint32_t      flush_requests;
+    uint32_t      flushes_completed;
+};
+
+static struct AsyncLog async_log = {
+    .started      = false,
+    .lock         = EX10_MUTEX_INITIALIZER,
+    .wake_cond    = EX10_COND_INITIALIZER,
+    .flushed_cond = EX10_COND_INITIALIZER,
+    .running      = false,
+};
+
+static struct Ex10AsyncLogConfig const default_config = {
+    .rate_limit_count       = 0u,
+    .rate_limit_interval_ms = 0u,
+    .poll_interval_ms       = 10u,
+    .print_timestamps       = false,
+};
+
+/// The ring owned by the calling thread, or NULL if it has not logged.
+static EX10_THREAD_LOCAL struct LogRing* thread_ring = NULL;
+
+/// Releases the ring of a thread when the thread exits.
+static pthread_key_t  ring_key;
+static pthread_once_t ring_key_once = PTHREAD_ONCE_INIT;
+
+static size_t round_up_to_slot(size_t length)
+{
+    return (length + LOG_SLOT_SIZE - 1u) & ~(LOG_SLOT_SIZE - 1u);
+}
+
+static size_t const log_record_header_size =
+    (sizeof(struct LogRecord) + LOG_SLOT_SIZE - 1u) & ~(LOG_SLOT_SIZE - 1u);
+
+/**
+ * Find the next conversion specification in a format string.
+ *
+ * @param fmt             The format string, from the previous conversion.
+ * @param [out] conversion The conversion found.
+ *
+ * @return char const* The character following the conversion, or NULL if
+ *                     the format string contains no further conversions.
+ */
+static char const* next_conversion(char const*           fmt,
+                                   struct LogConversion* conversion)
+{
+    char const* spec = strchr(fmt, '%');
+    if (spec == NULL)
+    {
+        return NULL;
+    }
+
+    char const* next       = spec + 1;
+    conversion->spec       = spec;
+    conversion->star_count = 0u;
+    conversion->type       = LogArgNone;
+
+    next += strspn(next, "-+ #0");
+    if (*next == '*')
+    {
+        conversion->star_count += 1u;
+        next += 1;
+    }
+    next += strspn(next, "0123456789");
+    if (*next == '.')
+    {
+        next += 1;
+        if (*next == '*')
+        {
+            conversion->star_count += 1u;
+            next += 1;
+        }
+        next += strspn(next, "0123456789");
+    }
+
+    enum LogArgType int_type = LogArgInt;
+    bool            is_long  = false;
+    switch (*next)
+    {
+        case 'h':
+            next += (next[1] == 'h') ? 2 : 1;
+            break;
+        case 'l':
+            int_type = (next[1] == 'l') ? LogArgLongLong : LogArgLong;
+            is_long  = true;
+            next += (next[1] == 'l') ? 2 : 1;
+            break;
+        case 'z':
+            int_type = LogArgSize;
+            next += 1;
+            break;
+        case 'j':
+            int_type = LogArgIntMax;
+            next += 1;
+            break;
+        case 't':
+            int_type = LogArgPtrDiff;
+            next += 1;
+            break;
+        case 'L':
+            int_type = LogArgLongDouble;
+            next += 1;
+            break;
+        default:
+            break;
+    }
+
+    switch (*next)
+    {
+        case 'd':
+        case 'i':
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            conversion->type = int_type;
+            break;
+        case 'c':
+            conversion->type = LogArgInt;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            conversion->type = (int_type == LogArgLongDouble)
+                                   ? LogArgLongDouble
+                                   : LogArgDouble;
+            break;
+        case 's':
+            conversion->type = is_long ? LogArgUnsupported : LogArgString;
+            break;
+        case 'p':
+            conversion->type = LogArgPointer;
+            break;
+        case 'n':
+            conversion->type = LogArgUnsupported;
+            break;
+        case '%':
+            conversion->type = LogArgNone;
+            break;
+        case '\0':
+            // A trailing '%' is printed as is.
+            conversion->spec_length = (size_t)(next - spec);
+            return next;
+        default:
+            conversion->type = LogArgNone;
+            break;
+    }
+
+    next += 1;
+    conversion->spec_length = (size_t)(next - spec);
+    return next;
+}
+
+static bool append_slot(uint8_t*    record,
+                        size_t*     length,
+                        void const* value,
+                        size_t      value_length)
+{
+    size_t const slot_length = round_up_to_slot(value_length);
+    if (*length + slot_length > LOG_RECORD_MAX_SIZE)
+    {
+        return false;
+    }
+    memset(&record[*length], 0, slot_length);
+    memcpy(&record[*length], value, value_length);
+    *length += slot_length;
+    return true;
+}
+
+static bool append_string(uint8_t* record, size_t* length, char const* string)
+{
+    if (string == NULL)
+    {
+        string = "(null)";
+    }
+    uint64_t const string_length =
+        strnlen(string, EX10_ASYNC_LOG_MAX_STRING_LENGTH);
+    return append_slot(record, length, &string_length, sizeof(string_length)) &&
+           append_slot(record, length, string, (size_t)string_length);
+}
+
+/**
+ * Copy the arguments of the format string conversions into a record.
+ *
+ * @return bool false if the arguments do not fit in a record.
+ */
+static bool append_args(uint8_t*    record,
+                        size_t*     length,
+                        char const* fmt,
+                        va_list     args)
+{
+    struct LogConversion conversion;
+    bool                 appended = true;
+    while (appended && (fmt = next_conversion(fmt, &conversion)) != NULL)
+    {
+        for (size_t star = 0u; star < conversion.star_count; ++star)
+        {
+            int64_t const width = va_arg(args, int);
+            appended = appended &&
+                       append_slot(record, length, &width, sizeof(width));
+        }
+
+        union
+        {
+            int64_t     int_value;
+            double      double_value;
+            long double ldouble_value;
+            void const* pointer_value;
+        } value;
+        size_t value_length = sizeof(value.int_value);
+
+        switch (conversion.type)
+        {
+            case LogArgInt:
+                value.int_value = va_arg(args, int);
+                break;
+            case LogArgLong:
+                value.int_value = va_arg(args, long);
+                break;
+            case LogArgLongLong:
+                value.int_value = va_arg(args, long long);
+                break;
+            case LogArgSize:
+                value.int_value = (int64_t)va_arg(args, size_t);
+                break;
+            case LogArgIntMax:
+                value.int_value = va_arg(args, intmax_t);
+                break;
+            case LogArgPtrDiff:
+                value.int_value = va_arg(args, ptrdiff_t);
+                break;
+            case LogArgDouble:
+                value.double_value = va_arg(args, double);
+                value_length       = sizeof(value.double_value);
+                break;
+            case LogArgLongDouble:
+                value.ldouble_value = va_arg(args, long double);
+                value_length        = sizeof(value.ldouble_value);
+                break;
+            case LogArgPointer:
+            case LogArgUnsupported:
+                value.pointer_value = va_arg(args, void*);
+                value_length        = sizeof(value.pointer_value);
+                break;
+            case LogArgString:
+                appended = appended &&
+                           append_string(record, length, va_arg(args, char*));
+                value_length = 0u;
+                break;
+            case LogArgNone:
+            default:
+                value_length = 0u;
+                break;
+        }
+
+        if (value_length > 0u)
+        {
+            appended = appended &&
+                       append_slot(record, length, &value, value_length);
+        }
+    }
+    return appended;
+}
+
+static void add_stat(size_t* counter)
+{
+    __atomic_add_fetch(counter, 1u, __ATOMIC_RELAXED);
+}
+
+/**
+ * Find the rate limit state of a call site, claiming an unused entry for a
+ * call site not seen before.
+ *
+ * @return struct LogSite* The call site state, or NULL if the table is full.
+ */
+static struct LogSite* find_site(char const* fmt)
+{
+    size_t index = ((uintptr_t)fmt >> 3u) % EX10_ASYNC_LOG_MAX_SITES;
+    for (size_t count = 0u; count < EX10_ASYNC_LOG_MAX_SITES; ++count)
+    {
+        struct LogSite* site = &async_log.sites[index];
+        char const* site_fmt = __atomic_load_n(&site->fmt, __ATOMIC_ACQUIRE);
+        if (site_fmt == fmt)
+        {
+            return site;
+        }
+        if (site_fmt == NULL &&
+            __atomic_compare_exchange_n(&site->fmt,
+                                        &site_fmt,
+                                        fmt,
+                                        false,
+                                        __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE))
+        {
+            return site;
+        }
+        if (site_fmt == fmt)
+        {
+            // Another thread claimed the entry for the same call site.
+            return site;
+        }
+        index = (index + 1u) % EX10_ASYNC_LOG_MAX_SITES;
+    }
+    return NULL;
+}
+
+/**
+ * Count a message against the rate limit of its call site.
+ *
+ * @param site            The call site state.
+ * @param now_ms          The current host time.
+ * @param [out] suppressed The number of messages suppressed since the
+ *                        previous window, when a new window starts.
+ *
+ * @return bool true if the message may be recorded.
+ */
+static bool site_allows(struct LogSite* site,
+                        uint32_t        now_ms,
+                        uint32_t*       suppressed)
+{
+    uint32_t start_ms =
+        __atomic_load_n(&site->window_start_ms, __ATOMIC_RELAXED);
+    if (now_ms - start_ms >= async_log.config.rate_limit_interval_ms &&
+        __atomic_compare_exchange_n(&site->window_start_ms,
+                                    &start_ms,
+                                    now_ms,
+                                    false,
+                                    __ATOMIC_RELAXED,
+                                    __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&site->window_count, 0u, __ATOMIC_RELAXED);
+        *suppressed =
+            __atomic_exchange_n(&site->suppressed, 0u, __ATOMIC_RELAXED);
+    }
+
+    uint32_t const count =
+        __atomic_add_fetch(&site->window_count, 1u, __ATOMIC_RELAXED);
+    if (count > async_log.config.rate_limit_count)
+    {
+        __atomic_add_fetch(&site->suppressed, 1u, __ATOMIC_RELAXED);
+        return false;
+    }
+    return true;
+}
+
+static void release_ring(void* ring)
+{
+    __atomic_store_n(&((struct LogRing*)ring)->owned, false, __ATOMIC_RELEASE);
+}
+
+static void create_ring_key(void)
+{
+    pthread_key_create(&ring_key, release_ring);
+}
+
+/**
+ * @return struct LogRing* The ring of the calling thread, claiming an
+ *                         unowned ring on the first call from the thread,
+ *                         or NULL if all rings are owned.
+ */
+static struct LogRing* get_thread_ring(void)
+{
+    if (thread_ring != NULL)
+    {
+        return thread_ring;
+    }
+
+    pthread_once(&ring_key_once, create_ring_key);
+    for (size_t index = 0u; index < EX10_ASYNC_LOG_MAX_THREADS; ++index)
+    {
+        struct LogRing* ring  = &async_log.rings[index];
+        bool            owned = false;
+        if (__atomic_compare_exchange_n(&ring->owned,
+                                        &owned,
+                                        true,
+                                        false,
+                                        __ATOMIC_ACQUIRE,
+                                        __ATOMIC_RELAXED))
+        {
+            pthread_setspecific(ring_key, ring);
+            thread_ring = ring;
+            return ring;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Copy a record into the ring. A record is never split across the end of
+ * the ring; the space before the end is filled with a padding record.
+ *
+ * @return bool false if the ring does not have space for the record.
+ */
+static bool ring_write(struct LogRing* ring,
+                       uint8_t const*  record,
+                       size_t          length)
+{
+    size_t const head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    size_t       tail = ring->tail;
+
+    size_t const offset     = tail % EX10_ASYNC_LOG_RING_SIZE;
+    size_t const contiguous = EX10_ASYNC_LOG_RING_SIZE - offset;
+    size_t const padding    = (contiguous < length) ? contiguous : 0u;
+    if (tail + padding + length - head > EX10_ASYNC_LOG_RING_SIZE)
+    {
+        return false;
+    }
+
+    if (padding > 0u)
+    {
+        uint32_t const padding_prefix[2u] = {(uint32_t)padding,
+                                             log_record_padding};
+        memcpy(&ring->bytes[offset], padding_prefix, sizeof(padding_prefix));
+        tail += padding;
+    }
+    memcpy(&ring->bytes[tail % EX10_ASYNC_LOG_RING_SIZE], record, length);
+    __atomic_store_n(&ring->tail, tail + length, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool ex10_async_log_record(enum Ex10LogStream stream,
+                           char const*        func,
+                           char const*        fmt,
+                           va_list            args)
+{
+    if (__atomic_load_n(&async_log.started, __ATOMIC_ACQUIRE) == false)
+    {
+        return false;
+    }
+
+    struct LogRing* ring = get_thread_ring();
+    if (ring == NULL)
+    {
+        add_stat(&async_log.stats.records_synchronous);
+        return false;
+    }
+
+    uint64_t const time_ns    = get_ex10_time_helpers()->time_now_ns();
+    uint32_t       suppressed = 0u;
+    if (async_log.config.rate_limit_count > 0u)
+    {
+        struct LogSite* site = find_site(fmt);
+        if (site != NULL &&
+            site_allows(site, (uint32_t)(time_ns / 1000000u), &suppressed) ==
+                false)
+        {
+            add_stat(&async_log.stats.records_suppressed);
+            return true;
+        }
+    }
+
+    uint8_t record[LOG_RECORD_MAX_SIZE] __attribute__((aligned(8)));
+    size_t  length = log_record_header_size;
+
+    va_list args_copy;
+    va_copy(args_copy, args);
+    bool const appended = append_args(record, &length, fmt, args_copy);
+    va_end(args_copy);
+
+    struct LogRecord const header = {
+        .length     = (uint32_t)length,
+        .stream     = (uint32_t)stream,
+        .time_ns    = time_ns,
+        .fmt        = fmt,
+        .func       = func,
+        .suppressed = suppressed,
+    };
+    memcpy(record, &header, sizeof(header));
+
+    if (appended == false || ring_write(ring, record, length) == false)
+    {
+        add_stat(&async_log.stats.records_dropped);
+    }
+    return true;
+}
+
+/// Format a single conversion; the specification is not a string literal,
+/// so the arguments are passed as a va_list.
+static int format_spec(char* line, size_t size, char const* spec, ...)
+{
+    va_list args;
+    va_start(args, spec);
+    int const written = vsnprintf(line, size, spec, args);
+    va_end(args);
+    return written;
+}
+
+/// Format a value with the width and precision arguments of the conversion.
+#define FORMAT_VALUE(value)                                              \
+    ((conversion.star_count == 0u)                                       \
+         ? format_spec(line, size, spec, (value))                        \
+         : (conversion.star_count == 1u)                                 \
+               ? format_spec(line, size, spec, stars[0u], (value))       \
+               : format_spec(line, size, spec, stars[0u], stars[1u], (value)))
+
+/**
+ * Advance past the characters written to a line by snprintf(); if the
+ * output was truncated, to the end of the line.
+ */
+static void advance_line(char** line, size_t* size, int written)
+{
+    if (written < 0)
+    {
+        return;
+    }
+    size_t const length =
+        ((size_t)written < *size) ? (size_t)written : *size - 1u;
+    *line += length;
+    *size -= length;
+}
+
+static uint8_t const* read_slot(uint8_t const* args,
+                                void*          value,
+                                size_t         value_length)
+{
+    memcpy(value, args, value_length);
+    return args + round_up_to_slot(value_length);
+}
+
+/**
+ * Format the message of a record.
+ *
+ * @return size_t The length of the formatted message.
+ */
+static size_t format_record(struct LogRecord const* header,
+                            uint8_t const*          args,
+                            char*                   line,
+                            size_t                  size)
+{
+    char const* const line_begin = line;
+    char const*       fmt        = header->fmt;
+
+    struct LogConversion conversion;
+    char const*          literal = fmt;
+    while ((fmt = next_conversion(literal, &conversion)) != NULL)
+    {
+        size_t const literal_length = (size_t)(conversion.spec - literal);
+        int written =
+            snprintf(line, size, "%.*s", (int)literal_length, literal);
+        literal = fmt;
+
+        int stars[2u] = {0, 0};
+        for (size_t star = 0u; star < conversion.star_count; ++star)
+        {
+            int64_t value = 0;
+            args          = read_slot(args, &value, sizeof(value));
+            stars[star]   = (int)value;
+        }
+
+        advance_line(&line, &size, written);
+
+        char spec[LOG_SPEC_MAX_LENGTH];
+        if (conversion.spec_length < sizeof(spec))
+        {
+            memcpy(spec, conversion.spec, conversion.spec_length);
+            spec[conversion.spec_length] = '\0';
+        }
+        else
+        {
+            // Drop the flags, width and precision of an overlong
+            // specification, keeping the length modifier and conversion.
+            size_t tail_length = 1u;
+            while (strchr("hlzjtL",
+                          conversion.spec[conversion.spec_length -
+                                          tail_length - 1u]) != NULL)
+            {
+                tail_length += 1u;
+            }
+            spec[0u] = '%';
+            memcpy(&spec[1u],
+                   &conversion.spec[conversion.spec_length - tail_length],
+                   tail_length);
+            spec[tail_length + 1u] = '\0';
+            conversion.star_count  = 0u;
+        }
+
+        int64_t     int_value     = 0;
+        double      double_value  = 0.0;
+        long double ldouble_value = 0.0L;
+        void*       pointer_value = NULL;
+        uint64_t    string_length = 0u;
+        switch (conversion.type)
+        {
+            case LogArgNone:
+                written = (conversion.spec[conversion.spec_length - 1u] == '%')
+                              ? snprintf(line, size, "%%")
+                              : snprintf(line, size, "%s", spec);
+                break;
+            case LogArgInt:
+                args    = read_slot(args, &int_value, sizeof(int_value));
+                written = FORMAT_VALUE((int)int_value);
+                break;
+            case LogArgLong:
+                args    = read_slot(args, &int_value, sizeof(int_value));
+                written = FORMAT_VALUE((long)int_value);
+                break;
+            case LogArgLongLong:
+                args    = read_slot(args, &int_value, sizeof(int_value));
+                written = FORMAT_VALUE((long long)int_value);
+                break;
+            case LogArgSize:
+                args    = read_slot(args, &int_value, sizeof(int_value));
+                written = FORMAT_VALUE((size_t)int_value);
+                break;
+            case LogArgIntMax:
+                args    = read_slot(args, &int_value, sizeof(int_value));
+                written = FORMAT_VALUE((intmax_t)int_value);
+                break;
+            case LogArgPtrDiff:
+                args    = read_slot(args, &int_value, sizeof(int_value));
+                written = FORMAT_VALUE((ptrdiff_t)int_value);
+                break;
+            case LogArgDouble:
+                args    = read_slot(args, &double_value, sizeof(double_value));
+                written = FORMAT_VALUE(double_value);
+                break;
+            case LogArgLongDouble:
+                args =
+                    read_slot(args, &ldouble_value, sizeof(ldouble_value));
+                written = FORMAT_VALUE(ldouble_value);
+                break;
+            case LogArgString:
+            {
+                args = read_slot(args, &string_length, sizeof(string_length));
+                char string[EX10_ASYNC_LOG_MAX_STRING_LENGTH + 1u];
+                args = read_slot(args, string, (size_t)string_length);
+                string[string_length] = '\0';
+                written               = FORMAT_VALUE(string);
+                break;
+            }
+            case LogArgPointer:
+                args = read_slot(args, &pointer_value, sizeof(pointer_value));
+                written = FORMAT_VALUE(pointer_value);
+                break;
+            case LogArgUnsupported:
+            default:
+                args = read_slot(args, &pointer_value, sizeof(pointer_value));
+                written = snprintf(line, size, "%s", "<?>");
+                break;
+        }
+
+        advance_line(&line, &size, written);
+    }
+
+    advance_line(&line, &size, snprintf(line, size, "%s", literal));
+    return (size_t)(line - line_begin);
+}
+
+static void print_record(struct LogRecord const* header, uint8_t const* args)
+{
+    char   line[LOG_LINE_MAX_LENGTH];
+    size_t length = 0u;
+
+    if (async_log.config.print_timestamps)
+    {
+        length += (size_t)snprintf(&line[length],
+                                   sizeof(line) - length,
+                                   "[%" PRIu64 " us] ",
+                                   header->time_ns / 1000u);
+    }
+    if (header->stream == Ex10LogStreamError)
+    {
+        length += (size_t)snprintf(&line[length],
+                                   sizeof(line) - length,
+                                   "Error: %s(): ",
+                                   header->func);
+    }
+    length += format_record(header, args, &line[length], sizeof(line) - length);
+
+    FILE* stream = (header->stream == Ex10LogStreamPrint) ? stdout : stderr;
+    if (stream == stderr)
+    {
+        fflush(stdout);
+    }
+    fwrite(line, 1u, length, stream);
+    if (header->suppressed > 0u)
+    {
+        fprintf(stream,
+                "(%" PRIu32 " messages like this were suppressed)\n",
+                header->suppressed);
+    }
+    add_stat(&async_log.stats.records_logged);
+}
+
+/**
+ * Get the oldest record of a ring, skipping padding records.
+ *
+ * @return struct LogRecord const* The record at the head of the ring, or
+ *                                 NULL if the ring is empty.
+ */
+static uint8_t const* ring_front_record(struct LogRing* ring)
+{
+    size_t const tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    while (ring->head != tail)
+    {
+        uint8_t const* record =
+            &ring->bytes[ring->head % EX10_ASYNC_LOG_RING_SIZE];
+        uint32_t prefix[2u];
+        memcpy(prefix, record, sizeof(prefix));
+        if (prefix[1u] != log_record_padding)
+        {
+            return record;
+        }
+        __atomic_store_n(
+            &ring->head, ring->head + prefix[0u], __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+/**
+ * Print the records of all rings, merged in timestamp order, until the rings
+ * are empty.
+ */
+static void drain_rings(void)
+{
+    while (true)
+    {
+        struct LogRing*  oldest_ring = NULL;
+        struct LogRecord oldest;
+        for (size_t index = 0u; index < EX10_ASYNC_LOG_MAX_THREADS; ++index)
+        {
+            struct LogRing* ring   = &async_log.rings[index];
+            uint8_t const*  record = ring_front_record(ring);
+            if (record == NULL)
+            {
+                continue;
+            }
+            struct LogRecord header;
+            memcpy(&header, record, sizeof(header));
+            if (oldest_ring == NULL || header.time_ns < oldest.time_ns)
+            {
+                oldest_ring = ring;
+                oldest      = header;
+            }
+        }
+        if (oldest_ring == NULL)
+        {
+            return;
+        }
+
+        uint8_t const* record =
+            &oldest_ring->bytes[oldest_ring->head % EX10_ASYNC_LOG_RING_SIZE];
+        print_record(&oldest, record + log_record_header_size);
+        __atomic_store_n(&oldest_ring->head,
+                         oldest_ring->head + oldest.length,
+                         __ATOMIC_RELEASE);
+    }
+}
+
+static void* format_thread(void* arg)
+{
+    (void)arg;
+    uint32_t const poll_interval_us = async_log.config.poll_interval_ms * 1000u;
+
+    ex10_mutex_lock(&async_log.lock);
+    while (true)
+    {
+        bool const     running        = async_log.running;
+        uint32_t const flush_requests = async_log.flush_requests;
+        ex10_mutex_unlock(&async_log.lock);
+
+        drain_rings();
+        fflush(stdout);
+
+        ex10_mutex_lock(&async_log.lock);
+        async_log.flushes_completed = flush_requests;
+        ex10_cond_signal(&async_log.flushed_cond);
+        if (running == false)
+        {
+            break;
+        }
+        if (async_log.running && flush_requests == async_log.flush_requests)
+        {
+            ex10_cond_timed_wait_us(
+                &async_log.wake_cond, &async_log.lock, poll_interval_us);
+        }
+    }
+    ex10_mutex_unlock(&async_log.lock);
+    return NULL;
+}
+
+static struct Ex10Result start(struct Ex10AsyncLogConfig const* config)
+{
+    if (config == NULL)
+    {
+        config = &default_config;
+    }
+    if (config->poll_interval_ms == 0u ||
+        (config->rate_limit_count > 0u && config->rate_limit_interval_ms == 0u))
+    {
+        return make_ex10_sdk_error(Ex10ModuleUtils, Ex10SdkErrorBadParamValue);
+    }
+
+    ex10_mutex_lock(&async_log.lock);
+    bool const running = async_log.running;
+    if (running == false)
+    {
+        async_log.config            = *config;
+        async_log.running           = true;
+        async_log.flush_requests    = 0u;
+        async_log.flushes_completed = 0u;
+        ex10_memzero(&async_log.stats, sizeof(async_log.stats));
+        ex10_memzero(async_log.sites, sizeof(async_log.sites));
+    }
+    ex10_mutex_unlock(&async_log.lock);
+    if (running)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUtils, Ex10SdkErrorInvalidState);
+    }
+
+    int const result =
+        ex10_thread_create(&async_log.thread, format_thread, NULL);
+    if (result != 0)
+    {
+        ex10_mutex_lock(&async_log.lock);
+        async_log.running = false;
+        ex10_mutex_unlock(&async_log.lock);
+        return make_ex10_sdk_error_with_status(
+            Ex10ModuleUtils, Ex10SdkErrorInvalidState, (uint32_t)result);
+    }
+
+    __atomic_store_n(&async_log.started, true, __ATOMIC_RELEASE);
+    return make_ex10_success();
+}
+
+static void stop(void)
+{
+    if (__atomic_exchange_n(&async_log.started, false, __ATOMIC_ACQ_REL) ==
+        false)
+    {
+        return;
+    }
+
+    // The print functions now print synchronously; the formatting thread
+    // prints the records made before it exits.
+    ex10_mutex_lock(&async_log.lock);
+    async_log.running = false;
+    ex10_cond_signal(&async_log.wake_cond);
+    ex10_mutex_unlock(&async_log.lock);
+
+    ex10_thread_join(async_log.thread);
+}
+
+static void flush(void)
+{
+    if (__atomic_load_n(&async_log.started, __ATOMIC_ACQUIRE) == false)
+    {
+        return;
+    }
+
+    ex10_mutex_lock(&async_log.lock);
+    async_log.flush_requests += 1u;
+    uint32_t const flush_request = async_log.flush_requests;
+    ex10_cond_signal(&async_log.wake_cond);
+    while (async_log.running &&
+           (int32_t)(async_log.flushes_completed - flush_request) < 0)
+    {
+        ex10_cond_timed_wait_us(&async_log.flushed_cond,
+                                &async_log.lock,
+                                async_log.config.poll_interval_ms * 1000u);
+    }
+    ex10_mutex_unlock(&async_log.lock);
+}
+
+static bool is_started(void)
+{
+    return __atomic_load_n(&async_log.started, __ATOMIC_ACQUIRE);
+}
+
+static void get_stats(struct Ex10AsyncLogStats* stats)
+{
+    stats->records_logged =
+        __atomic_load_n(&async_log.stats.records_logged, __ATOMIC_RELAXED);
+    stats->records_dropped =
+        __atomic_load_n(&async_log.stats.records_dropped, __ATOMIC_RELAXED);
+    stats->records_suppressed =
+        __atomic_load_n(&async_log.stats.records_suppressed, __ATOMIC_RELAXED);
+    stats->records_synchronous = __atomic_load_n(
+        &async_log.stats.records_synchronous, __ATOMIC_RELAXED);
+}
+
+static struct Ex10AsyncLog const ex10_async_log = {
+    .start      = start,
+    .stop       = stop,
+    .flush      = flush,
+    .is_started = is_started,
+    .get_stats  = get_stats,
+};
+
+struct Ex10AsyncLog const* get_ex10_async_log(void)
+{
+    return &ex10_async_log;
+}
@@ -0,0 +1,114 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "board/ex10_cal_cache.h"
+#include "ex10_api/ex10_context.h"
+#include "ex10_api/ex10_print.h"
+
+/// The calibration cache file path of each context; empty if the cache is
+/// not used.
+static char cal_cache_paths[EX10_MAX_CONTEXTS][256u];
+
+static bool set_location(char const* location)
+{
+    char* cal_cache_path = cal_cache_paths[ex10_context_index()];
+
+    if (location == NULL)
+    {
+        cal_cache_path[0u] = '\0';
+        return true;
+    }
+    size_t const path_length = strlen(location);
+    if (path_length >= sizeof(cal_cache_paths[0u]))
+    {
+        return false;
+    }
+    memcpy(cal_cache_path, location, path_length + 1u);
+    return true;
+}
+
+static bool is_enabled(void)
+{
+    char const* cal_cache_path = cal_cache_paths[ex10_context_index()];
+
+    return cal_cache_path[0u] != '\0';
+}
+
+static bool read_record(void* buffer, size_t length)
+{
+    char const* cal_cache_path = cal_cache_paths[ex10_context_index()];
+
+    FILE* file = fopen(cal_cache_path, "rb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    bool const record_read = fread(buffer, length, 1u, file) == 1u;
+    fclose(file);
+    return record_read;
+}
+
+/**
+ * The file is written under a temporary name and then renamed, so that a
+ * reader never sees a partially written file.
+ */
+static bool write_record(void const* buffer, size_t length)
+{
+    char const* cal_cache_path = cal_cache_paths[ex10_context_index()];
+
+    char temp_path[sizeof(cal_cache_paths[0u]) + 4u];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", cal_cache_path);
+
+    FILE* file = fopen(temp_path, "wb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    bool const written = fwrite(buffer, length, 1u, file) == 1u;
+    if (fclose(file) != 0 || written == false ||
+        rename(temp_path, cal_cache_path) != 0)
+    {
+        ex10_eprintf("Calibration cache %s not written\n", cal_cache_path);
+        remove(temp_path);
+        return false;
+    }
+    return true;
+}
+
+static void erase_record(void)
+{
+    char const* cal_cache_path = cal_cache_paths[ex10_context_index()];
+
+    if (is_enabled())
+    {
+        remove(cal_cache_path);
+    }
+}
+
+static struct Ex10CalCacheStorage const ex10_cal_cache_storage = {
+    .set_location = set_location,
+    .is_enabled   = is_enabled,
+    .read         = read_record,
+    .write        = write_record,
+    .erase        = erase_record,
+};
+
+struct Ex10CalCacheStorage const* get_ex10_cal_cache_storage(void)
+{
+    return &ex10_cal_cache_storage;
+}
@@ -11,20 +11,77 @@
  *                                                                           *
  *****************************************************************************/
 
+#define _GNU_SOURCE
+
+#include <sched.h>
+#include <time.h>
+
 #include "board/ex10_osal.h"
 
 int ex10_cond_timed_wait_us(ex10_cond_t*  cond,
                             ex10_mutex_t* mutex,
                             uint32_t      timeout_us)
 {
-    uint32_t const  ns_per_us = 1000u;
-    uint32_t const  us_per_s  = 1000u * 1000u;
-    struct timespec tv        = {
-        .tv_sec  = (time_t)(timeout_us / us_per_s),
-        .tv_nsec = (timeout_us % us_per_s) * ns_per_us,
-    };
+    uint32_t const ns_per_us = 1000u;
+    uint32_t const us_per_s  = 1000u * 1000u;
+    long const     ns_per_s  = 1000L * 1000L * 1000L;
+
+    // pthread_cond_timedwait() takes an absolute CLOCK_REALTIME deadline.
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += (time_t)(timeout_us / us_per_s);
+    deadline.tv_nsec += (long)((timeout_us % us_per_s) * ns_per_us);
+    if (deadline.tv_nsec >= ns_per_s)
+    {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= ns_per_s;
+    }
+
+    return pthread_cond_timedwait(cond, mutex, &deadline);
+}
+
+int ex10_thread_set_attributes(ex10_thread_t                      thread,
+                               struct Ex10ThreadAttributes const* attributes)
+{
+    if (attributes == NULL)
+    {
+        return EINVAL;
+    }
+
+    if (attributes->cpu_mask != 0u)
+    {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (size_t cpu = 0u; cpu < 64u; ++cpu)
+        {
+            if (attributes->cpu_mask & (UINT64_C(1) << cpu))
+            {
+                CPU_SET(cpu, &cpu_set);
+            }
+        }
+
+        int const result =
+            pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if (attributes->fifo_priority != 0)
+    {
+        struct sched_param const param = {
+            .sched_priority = attributes->fifo_priority,
+        };
+
+        int const result = pthread_setschedparam(thread, SCHED_FIFO, &param);
+        if (result != 0)
+        {
+            return result;
+        }
+    }
 
-    return pthread_cond_timedwait(cond, mutex, &tv);
+    return 0;
 }
 
 int ex10_memcpy(void*       dst_ptr,
@@ -14,6 +14,7 @@
 #include <stdarg.h>
 #include <stdio.h>
 
+#include "board/ex10_async_log.h"
 #include "ex10_api/ex10_print.h"
 
 #ifdef EX10_PRINT_IMPL
@@ -21,7 +22,11 @@ int ex10_printf_impl(const char* fmt, ...)
 {
     va_list ap;
     va_start(ap, fmt);
-    int n = vprintf(fmt, ap);
+    int n = 0;
+    if (ex10_async_log_record(Ex10LogStreamPrint, NULL, fmt, ap) == false)
+    {
+        n = vprintf(fmt, ap);
+    }
     va_end(ap);
 
     return n;
@@ -37,23 +42,33 @@ int ex10_printf_impl(const char* fmt, ...)
  */
 int ex10_eputs_impl(const char* fmt, ...)
 {
-    // Flush stdout before writing to stderr since stderr prints immediately.
-    fflush(stdout);
     va_list ap;
     va_start(ap, fmt);
-    int n = vfprintf(stderr, fmt, ap);
+    int n = 0;
+    if (ex10_async_log_record(Ex10LogStreamErrorPuts, NULL, fmt, ap) == false)
+    {
+        // Flush stdout before writing to stderr since stderr prints
+        // immediately.
+        fflush(stdout);
+        n = vfprintf(stderr, fmt, ap);
+    }
     va_end(ap);
 
     return n;
 }
 int ex10_eprintf_impl(const char* func, const char* fmt, ...)
 {
-    // Flush stdout before writing to stderr since stderr prints immediately.
-    fflush(stdout);
-    int     n = fprintf(stderr, "Error: %s(): ", func);
     va_list ap;
     va_start(ap, fmt);
-    n += vfprintf(stderr, fmt, ap);
+    int n = 0;
+    if (ex10_async_log_record(Ex10LogStreamError, func, fmt, ap) == false)
+    {
+        // Flush stdout before writing to stderr since stderr prints
+        // immediately.
+        fflush(stdout);
+        n = fprintf(stderr, "Error: %s(): ", func);
+        n += vfprintf(stderr, fmt, ap);
+    }
     va_end(ap);
 
     return n;
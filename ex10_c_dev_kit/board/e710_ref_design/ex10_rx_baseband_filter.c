@@ -12,21 +12,25 @@
  *****************************************************************************/
 
 #include "board/ex10_rx_baseband_filter.h"
+#include "ex10_api/ex10_context.h"
 
-static enum DrmStatus drm_status = DrmStatusAuto;
+// The DRM status per context, zero initialized to DrmStatusAuto.
+static enum DrmStatus drm_statuses[EX10_MAX_CONTEXTS];
 
 static void set_drm_status(enum DrmStatus drm_enable)
 {
-    drm_status = drm_enable;
+    drm_statuses[ex10_context_index()] = drm_enable;
 }
 
 static enum DrmStatus get_drm_status(void)
 {
-    return drm_status;
+    return drm_statuses[ex10_context_index()];
 }
 
 static bool rf_mode_is_drm(enum RfModes rf_mode)
 {
+    enum DrmStatus const drm_status = get_drm_status();
+
     if (drm_status == DrmStatusAuto)
     {
         // Define baseband filter to use depending on rf_mode
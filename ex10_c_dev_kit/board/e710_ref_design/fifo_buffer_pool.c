@@ -11,16 +11,26 @@
  *                                                                           *
  *****************************************************************************/
 
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
 #include "board/fifo_buffer_pool.h"
 #include "ex10_api/event_fifo_packet_types.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_macros.h"
+#include "ex10_api/ex10_print.h"
 
-/**
- * Each buffer needs to be large enough to contain the full contents of
- * the ReadFifo command (4096 bytes), plus the 1-byte result code,
- * and maintain Fifo packet 4-byte alignment.
- */
-#define EVENT_FIFO_BUFFER_SIZE (EX10_EVENT_FIFO_SIZE + FIFO_HEADER_SPACE)
+/// The huge page size used to align and size a huge page arena.
+#define HUGE_PAGE_SIZE ((size_t)(2u * 1024u * 1024u))
+
+/// The arena alignment used when huge pages are not requested.
+#define ARENA_ALIGNMENT ((size_t)64u)
+
+/// The number of result buffers of each Ex10 context.
+#define RESULT_BUFFER_COUNT ((size_t)4u)
 
 /**
  * @note that the number of buffers should be changed based on the expected
@@ -28,38 +38,224 @@
  * if you have too few buffers and a large number of tags in a short window of
  * time, you may not have enough space to pull them from the device, and thus
  * the device-side event FIFO buffer could overfill.
+ * Use ex10_event_fifo_buffer_pool_configure() to size the pool at run time,
+ * and the FifoBufferList get_stats() high_water_mark and exhaustion_count to
+ * determine the required size.
  */
-static uint8_t buffer_0[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_1[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_2[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_3[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_4[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_5[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_6[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_7[EVENT_FIFO_BUFFER_SIZE];
-
-static struct ByteSpan const event_fifo_buffers[] = {
-    {.data = buffer_0, .length = sizeof(buffer_0)},
-    {.data = buffer_1, .length = sizeof(buffer_1)},
-    {.data = buffer_2, .length = sizeof(buffer_2)},
-    {.data = buffer_3, .length = sizeof(buffer_3)},
-    {.data = buffer_4, .length = sizeof(buffer_4)},
-    {.data = buffer_5, .length = sizeof(buffer_5)},
-    {.data = buffer_6, .length = sizeof(buffer_6)},
-    {.data = buffer_7, .length = sizeof(buffer_7)},
+static uint32_t default_event_fifo_arenas[EX10_MAX_CONTEXTS]
+                                         [DEFAULT_EVENT_FIFO_BUFFER_COUNT]
+                                         [EVENT_FIFO_BUFFER_SIZE /
+                                          sizeof(uint32_t)];
+
+static struct EventPacketIndex
+    default_packet_indexes[EX10_MAX_CONTEXTS][DEFAULT_EVENT_FIFO_BUFFER_COUNT];
+
+enum ArenaAllocation
+{
+    ArenaStatic,  ///< The context's default_event_fifo_arenas entry.
+    ArenaHeap,    ///< Allocated with posix_memalign().
+    ArenaMapped,  ///< Mapped with mmap(MAP_HUGETLB).
 };
 
-static struct FifoBufferNode
-    event_fifo_buffer_nodes[ARRAY_SIZE(event_fifo_buffers)];
+/**
+ * @struct EventFifoArena
+ * The event fifo buffer pool of an Ex10 context and the arena backing it.
+ * The packet indexes are allocated along with the arena: from
+ * default_packet_indexes for an ArenaStatic arena, otherwise from the heap.
+ */
+struct EventFifoArena
+{
+    uint8_t*                 arena;
+    size_t                   arena_size;
+    enum ArenaAllocation     arena_type;
+    struct EventPacketIndex* packet_indexes;
+    struct ByteSpan          buffers[FIFO_BUFFER_LIST_CAPACITY];
+    struct FifoBufferNode    buffer_nodes[FIFO_BUFFER_LIST_CAPACITY];
+    struct FifoBufferPool    pool;
+};
 
-static struct FifoBufferPool const event_fifo_buffer_pool = {
-    .fifo_buffer_nodes = event_fifo_buffer_nodes,
-    .fifo_buffers      = event_fifo_buffers,
-    .buffer_count      = ARRAY_SIZE(event_fifo_buffers)};
+static struct EventFifoArena event_fifo_arenas[EX10_MAX_CONTEXTS];
+
+static struct EventFifoArena* get_event_fifo_arena(void)
+{
+    return &event_fifo_arenas[ex10_context_index()];
+}
+
+static void assign_event_fifo_buffers(struct EventFifoArena* fifo_arena,
+                                      size_t                 buffer_count,
+                                      size_t                 buffer_size)
+{
+    for (size_t index = 0u; index < buffer_count; ++index)
+    {
+        fifo_arena->buffers[index].data =
+            &fifo_arena->arena[index * buffer_size];
+        fifo_arena->buffers[index].length = buffer_size;
+    }
+    fifo_arena->pool.fifo_buffer_nodes = fifo_arena->buffer_nodes;
+    fifo_arena->pool.fifo_buffers      = fifo_arena->buffers;
+    fifo_arena->pool.packet_indexes    = fifo_arena->packet_indexes;
+    fifo_arena->pool.buffer_count      = buffer_count;
+    fifo_arena->pool.buffer_size       = buffer_size;
+}
+
+static void use_default_event_fifo_arena(struct EventFifoArena* fifo_arena)
+{
+    size_t const context_index = (size_t)(fifo_arena - event_fifo_arenas);
+    uint32_t(*default_arena)[EVENT_FIFO_BUFFER_SIZE / sizeof(uint32_t)] =
+        default_event_fifo_arenas[context_index];
+
+    fifo_arena->arena          = (uint8_t*)default_arena;
+    fifo_arena->arena_size     = sizeof(default_event_fifo_arenas[0]);
+    fifo_arena->arena_type     = ArenaStatic;
+    fifo_arena->packet_indexes = default_packet_indexes[context_index];
+    fifo_arena->pool.huge_page_backed = false;
+    assign_event_fifo_buffers(
+        fifo_arena, DEFAULT_EVENT_FIFO_BUFFER_COUNT, sizeof(default_arena[0]));
+}
+
+/**
+ * Allocate a huge page aligned arena. A MAP_HUGETLB mapping is attempted
+ * first; if no huge pages are reserved the arena is allocated from the heap
+ * at huge page alignment and transparent huge pages are requested.
+ *
+ * @return int Zero on success, otherwise an errno value.
+ */
+static int allocate_huge_page_arena(struct EventFifoArena* fifo_arena,
+                                    size_t                 arena_size)
+{
+    void* arena = mmap(NULL,
+                       arena_size,
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                       -1,
+                       0);
+    if (arena != MAP_FAILED)
+    {
+        fifo_arena->arena                 = (uint8_t*)arena;
+        fifo_arena->arena_type            = ArenaMapped;
+        fifo_arena->pool.huge_page_backed = true;
+        return 0;
+    }
+
+    int const result = posix_memalign(&arena, HUGE_PAGE_SIZE, arena_size);
+    if (result != 0)
+    {
+        return result;
+    }
+    // Best effort; the arena is usable whether or not this succeeds.
+    fifo_arena->pool.huge_page_backed =
+        (madvise(arena, arena_size, MADV_HUGEPAGE) == 0);
+    fifo_arena->arena      = (uint8_t*)arena;
+    fifo_arena->arena_type = ArenaHeap;
+    return 0;
+}
 
 struct FifoBufferPool const* get_ex10_event_fifo_buffer_pool(void)
 {
-    return &event_fifo_buffer_pool;
+    struct EventFifoArena* fifo_arena = get_event_fifo_arena();
+
+    if (fifo_arena->arena == NULL)
+    {
+        use_default_event_fifo_arena(fifo_arena);
+    }
+    return &fifo_arena->pool;
+}
+
+struct Ex10Result ex10_event_fifo_buffer_pool_configure(
+    struct FifoBufferPoolConfig const* config)
+{
+    if (config == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                   Ex10SdkErrorNullPointer);
+    }
+
+    if ((config->buffer_count == 0u) ||
+        (config->buffer_count > FIFO_BUFFER_LIST_CAPACITY))
+    {
+        return make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                   Ex10SdkErrorBadParamValue);
+    }
+
+    if (config->buffer_size < EVENT_FIFO_BUFFER_SIZE)
+    {
+        return make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                   Ex10SdkFreeEventFifoBuffersLengthMismatch);
+    }
+
+    // Keep each buffer, and therefore each fifo packet, 32-bit aligned.
+    size_t const align = sizeof(uint32_t);
+    size_t const buffer_size =
+        ((config->buffer_size + align - 1u) / align) * align;
+    size_t arena_size = buffer_size * config->buffer_count;
+
+    ex10_event_fifo_buffer_pool_release();
+
+    struct EventFifoArena* fifo_arena = get_event_fifo_arena();
+
+    int result = 0;
+    if (config->use_huge_pages)
+    {
+        arena_size = ((arena_size + HUGE_PAGE_SIZE - 1u) / HUGE_PAGE_SIZE) *
+                     HUGE_PAGE_SIZE;
+        result = allocate_huge_page_arena(fifo_arena, arena_size);
+    }
+    else
+    {
+        void* arena = NULL;
+        result      = posix_memalign(&arena, ARENA_ALIGNMENT, arena_size);
+        if (result == 0)
+        {
+            fifo_arena->arena      = (uint8_t*)arena;
+            fifo_arena->arena_type = ArenaHeap;
+        }
+    }
+
+    if (result != 0)
+    {
+        ex10_eprintf("Event fifo arena allocation of %zu bytes failed: %d\n",
+                     arena_size,
+                     result);
+        use_default_event_fifo_arena(fifo_arena);
+        return make_ex10_sdk_error_with_status(Ex10ModuleBoardInit,
+                                               Ex10SdkNoFreeEventFifoBuffers,
+                                               (uint32_t)result);
+    }
+
+    fifo_arena->arena_size = arena_size;
+    fifo_arena->packet_indexes =
+        calloc(config->buffer_count, sizeof(struct EventPacketIndex));
+    if (fifo_arena->packet_indexes == NULL)
+    {
+        ex10_eprintf("Event fifo packet index allocation failed\n");
+        ex10_event_fifo_buffer_pool_release();
+        return make_ex10_sdk_error_with_status(Ex10ModuleBoardInit,
+                                               Ex10SdkNoFreeEventFifoBuffers,
+                                               (uint32_t)ENOMEM);
+    }
+    assign_event_fifo_buffers(fifo_arena, config->buffer_count, buffer_size);
+
+    return make_ex10_success();
+}
+
+void ex10_event_fifo_buffer_pool_release(void)
+{
+    struct EventFifoArena* fifo_arena = get_event_fifo_arena();
+
+    if (fifo_arena->arena_type == ArenaMapped)
+    {
+        munmap(fifo_arena->arena, fifo_arena->arena_size);
+    }
+    else if (fifo_arena->arena_type == ArenaHeap)
+    {
+        free(fifo_arena->arena);
+    }
+
+    if (fifo_arena->arena_type != ArenaStatic)
+    {
+        free(fifo_arena->packet_indexes);
+    }
+    use_default_event_fifo_arena(fifo_arena);
 }
 
 /**
@@ -68,30 +264,43 @@ struct FifoBufferPool const* get_ex10_event_fifo_buffer_pool(void)
  * requires a free "result" buffer for reporting, the error will be silently
  * discarded.
  */
-static uint32_t
-    result_buffer_0[RESULT_FIFO_BUFFER_SIZE_BYTES / sizeof(uint32_t)];
-static uint32_t
-    result_buffer_1[RESULT_FIFO_BUFFER_SIZE_BYTES / sizeof(uint32_t)];
-static uint32_t
-    result_buffer_2[RESULT_FIFO_BUFFER_SIZE_BYTES / sizeof(uint32_t)];
-static uint32_t
-    result_buffer_3[RESULT_FIFO_BUFFER_SIZE_BYTES / sizeof(uint32_t)];
-
-static struct ByteSpan const result_buffers[] = {
-    {.data = (uint8_t*)result_buffer_0, .length = sizeof(result_buffer_0)},
-    {.data = (uint8_t*)result_buffer_1, .length = sizeof(result_buffer_1)},
-    {.data = (uint8_t*)result_buffer_2, .length = sizeof(result_buffer_2)},
-    {.data = (uint8_t*)result_buffer_3, .length = sizeof(result_buffer_3)},
-};
+static uint32_t result_buffer_data[EX10_MAX_CONTEXTS][RESULT_BUFFER_COUNT]
+                                  [RESULT_FIFO_BUFFER_SIZE_BYTES /
+                                   sizeof(uint32_t)];
 
-static struct FifoBufferNode result_buffer_nodes[ARRAY_SIZE(result_buffers)];
+static struct ByteSpan       result_buffers[EX10_MAX_CONTEXTS]
+                                     [RESULT_BUFFER_COUNT];
+static struct FifoBufferNode result_buffer_nodes[EX10_MAX_CONTEXTS]
+                                                [RESULT_BUFFER_COUNT];
+static struct FifoBufferPool result_buffer_pools[EX10_MAX_CONTEXTS];
 
-static struct FifoBufferPool const result_buffer_pool = {
-    .fifo_buffer_nodes = result_buffer_nodes,
-    .fifo_buffers      = result_buffers,
-    .buffer_count      = ARRAY_SIZE(result_buffers)};
+static struct EventPacketIndex
+    result_packet_indexes[EX10_MAX_CONTEXTS][RESULT_BUFFER_COUNT];
 
 struct FifoBufferPool const* get_ex10_result_buffer_pool(void)
 {
-    return &result_buffer_pool;
+    size_t const context_index = ex10_context_index();
+
+    struct FifoBufferPool* result_buffer_pool =
+        &result_buffer_pools[context_index];
+    if (result_buffer_pool->buffer_count == 0u)
+    {
+        for (size_t index = 0u; index < RESULT_BUFFER_COUNT; ++index)
+        {
+            struct ByteSpan* result_buffer =
+                &result_buffers[context_index][index];
+            result_buffer->data =
+                (uint8_t*)result_buffer_data[context_index][index];
+            result_buffer->length =
+                sizeof(result_buffer_data[context_index][index]);
+        }
+        result_buffer_pool->fifo_buffer_nodes =
+            result_buffer_nodes[context_index];
+        result_buffer_pool->fifo_buffers = result_buffers[context_index];
+        result_buffer_pool->packet_indexes =
+            result_packet_indexes[context_index];
+        result_buffer_pool->buffer_size  = RESULT_FIFO_BUFFER_SIZE_BYTES;
+        result_buffer_pool->buffer_count = RESULT_BUFFER_COUNT;
+    }
+    return result_buffer_pool;
 }
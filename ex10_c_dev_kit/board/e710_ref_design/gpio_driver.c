@@ -17,11 +17,13 @@
 #include "board/board_spec.h"
 #include "board/ex10_osal.h"
 #include "board/time_helpers.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_macros.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/trace.h"
 
 #include <errno.h>
+#include <assert.h>
 #include <fcntl.h>
 #include <gpiod.h>
 #include <pthread.h>
@@ -30,6 +32,7 @@
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 
 enum R807_PIN_NUMBERS
@@ -78,77 +81,134 @@ static uint8_t const ex10_gpio_test_pins[][2] = {
 static uint8_t const r807_led_pins[] = {16, 26, 20, 6};
 
 /* libgpiod handles */
-static const char*        consumer         = "Ex10 SDK";
-static const char*        gpiochip_label   = "pinctrl-bcm2835";
-static const char*        gpiochip_label2  = "pinctrl-bcm2711";
-static struct gpiod_chip* chip             = NULL;
-static struct gpiod_line* power_line       = NULL;
-static struct gpiod_line* reset_line       = NULL;
-static struct gpiod_line* ex10_enable_line = NULL;
-static struct gpiod_line* ready_n_line     = NULL;
-static struct gpiod_line* ex10_test_line   = NULL;
-static struct gpiod_line* irq_n_line       = NULL;
+static const char* consumer        = "Ex10 SDK";
+static const char* gpiochip_label  = "pinctrl-bcm2835";
+static const char* gpiochip_label2 = "pinctrl-bcm2711";
 
+/*
+ * The debug, test and LED lines are board level resources. They are
+ * requested by the first Ex10 context to initialize its GPIO driver and are
+ * released by the cleanup of that context.
+ */
 static struct gpiod_line* debug_lines[ARRAY_SIZE(r807_debug_pins)] = {NULL};
 static struct gpiod_line*
                           ex10_gpio_test_lines[ARRAY_SIZE(ex10_gpio_test_pins)] = {NULL};
 static struct gpiod_line* led_lines[ARRAY_SIZE(r807_led_pins)] = {NULL};
+static size_t             board_lines_owner = EX10_MAX_CONTEXTS;
 
-static pthread_t irq_n_monitor_pthread;
-
-static void (*irq_n_cb)(void) = NULL;
+/**
+ * @struct GpioContext
+ * The GPIO lines and IRQ_N monitor thread connecting an Ex10 context to its
+ * Impinj Reader Chip.
+ */
+struct GpioContext
+{
+    struct Ex10GpioPinMap pins;
+    struct gpiod_chip*    chip;
+    struct gpiod_line*    power_line;
+    struct gpiod_line*    reset_line;
+    struct gpiod_line*    ex10_enable_line;
+    struct gpiod_line*    ready_n_line;
+    struct gpiod_line*    ex10_test_line;
+    struct gpiod_line*    irq_n_line;
+
+    pthread_t irq_n_monitor_pthread;
+
+    void (*irq_n_cb)(void);
+
+    // When set to false, inhibit the IRQ_N monitor thread from calling the
+    // registered callback function pointer irq_n_cb.
+    // This value is set to true when the register_irq_callback() function
+    // successfully starts the IRQ_N monitor thread.
+    // This value is set to false when deregister_irq_callback() is called.
+    // The interface functions irq_monitor_callback_enable() and
+    // irq_monitor_callback_is_enabled() provides external access to this
+    // value.
+    bool irq_monitor_callback_enable_flag;
+
+    // The method used by busy_wait_ready_n() to wait for READY_N to assert
+    // low. When not ReadyNWaitModeSpin, the READY_N line is requested from
+    // libgpiod with falling edge events enabled; its level remains readable.
+    enum ReadyNWaitMode ready_n_wait_mode;
+    uint32_t            ready_n_spin_us;
+
+    /*
+     * This lock guards the Host Interface (i.e. SPI interface) from being
+     * accessed by both the client thread and the IRQ_N monitor thread at the
+     * same time.
+     *
+     * A lock is used in the Impinj Reference Design because on the RPi the
+     * interrupt handler for IRQ_N is dispatched by a normal POSIX thread.
+     * This thread is comments and documentation is called the IRQ_N monitor
+     * thread.
+     *
+     * A lock can be acquired because it is done in a thread and NOT in an
+     * actual interrupt context.
+     *
+     * On a port to a microcontroller, a lock should NOT be used because
+     * acquiring a lock in an interrupt handler can cause a deadlock. In this
+     * case, the IRQ_N interrupt should be temporarily disabled.
+     */
+    pthread_mutex_t irq_lock;
+
+    /*
+     * Guards the callback function pointer irq_n_cb, during registration,
+     * deregistration and callback dispatch/execution.
+     *
+     * On a port to a microcontroller, use of this flag would be similar to
+     * masking the IRQ_N interrupt vector.
+     */
+    pthread_mutex_t irq_n_callback_lock;
+};
 
-// When set to false, inhibit the IRQ_N monitor thread from calling the
-// registered callback function pointer irq_n_cb.
-// This value is set to true when the register_irq_callback() function
-// successfully starts the IRQ_N monitor thread.
-// This value is set to false when deregister_irq_callback() is called.
-// The interface functions irq_monitor_callback_enable() and
-// irq_monitor_callback_is_enabled() provides external access to this value.
-static bool irq_monitor_callback_enable_flag = false;
+static struct GpioContext     gpio_contexts[EX10_MAX_CONTEXTS];
+static struct Ex10ContextOnce gpio_contexts_once;
 
-/*
- * This lock guards the Host Interface (i.e. SPI interface) from being
- * accessed by both the client thread and the IRQ_N monitor thread at the
- * same time.
- *
- * A lock is used in the Impinj Reference Design because on the RPi the
- * interrupt handler for IRQ_N is dispatched by a normal POSIX thread.
- * This thread is comments and documentation is called the IRQ_N monitor
- * thread.
- *
- * A lock can be acquired because it is done in a thread and NOT in an
- * actual interrupt context.
- *
- * On a port to a microcontroller, a lock should NOT be used because
- * acquiring a lock in an interrupt handler can cause a deadlock. In this
- * case, the IRQ_N interrupt should be temporarily disabled.
+/**
+ * Each context defaults to the R807 pin connections; contexts driving
+ * additional Impinj Reader Chips must be assigned their pins using
+ * Ex10GpioDriver.set_pin_map().
  */
-static pthread_mutex_t irq_lock = PTHREAD_MUTEX_INITIALIZER;
+static void init_gpio_contexts(void)
+{
+    for (size_t index = 0u; index < EX10_MAX_CONTEXTS; ++index)
+    {
+        struct GpioContext* gpio = &gpio_contexts[index];
 
-/*
- * Guards the callback function pointer irq_n_cb, during registration,
- * deregistration and callback dispatch/execution.
- *
- * On a port to a microcontroller, use of this flag would be similar to masking
- * the IRQ_N interrupt vector.
- */
-static pthread_mutex_t irq_n_callback_lock = PTHREAD_MUTEX_INITIALIZER;
+        gpio->pins.board_power  = BOARD_POWER_PIN;
+        gpio->pins.ready_n      = READY_N_PIN;
+        gpio->pins.ex10_enable  = EX10_ENABLE_PIN;
+        gpio->pins.reset_n      = RESET_N_PIN;
+        gpio->pins.test         = TEST;
+        gpio->pins.irq_n        = IRQ_N_PIN;
+        gpio->ready_n_wait_mode = ReadyNWaitModeSpin;
+        pthread_mutex_init(&gpio->irq_lock, NULL);
+        pthread_mutex_init(&gpio->irq_n_callback_lock, NULL);
+    }
+}
+
+static struct GpioContext* get_gpio_context(void)
+{
+    ex10_context_init_once(&gpio_contexts_once, init_gpio_contexts);
+    return &gpio_contexts[ex10_context_index()];
+}
 
 static void irq_n_pthread_cleanup(void* arg)
 {
+    struct GpioContext* gpio = get_gpio_context();
+
     struct gpiod_line* irq_n_line_arg = arg;
-    if (irq_n_line_arg != irq_n_line)
+    if (irq_n_line_arg != gpio->irq_n_line)
     {
         ex10_eprintf("irq_n_line_arg != irq_n_line: %p, %p\n",
                      (void const*)irq_n_line_arg,
-                     (void const*)irq_n_line);
+                     (void const*)gpio->irq_n_line);
     }
 
-    if (irq_n_line)  // Valid line detected
+    if (gpio->irq_n_line)  // Valid line detected
     {
-        gpiod_line_release(irq_n_line);
-        irq_n_line = NULL;
+        gpiod_line_release(gpio->irq_n_line);
+        gpio->irq_n_line = NULL;
     }
     else
     {
@@ -167,8 +227,8 @@ static void irq_n_pthread_cleanup(void* arg)
     // is cancelled during the read() or write() operation; the call to
     // irq_enable(true) will not be made, and this cancellation cleanup handler
     // will be invoked.
-    pthread_mutex_trylock(&irq_lock);
-    int const unlock_result = pthread_mutex_unlock(&irq_lock);
+    pthread_mutex_trylock(&gpio->irq_lock);
+    int const unlock_result = pthread_mutex_unlock(&gpio->irq_lock);
     if (unlock_result != 0)
     {
         ex10_eprintf("pthread_mutex_unlock(irq_lock) failed: %d %s\n",
@@ -176,8 +236,9 @@ static void irq_n_pthread_cleanup(void* arg)
                      strerror(unlock_result));
     }
 
-    pthread_mutex_trylock(&irq_n_callback_lock);
-    int const unlock_result_2 = pthread_mutex_unlock(&irq_n_callback_lock);
+    pthread_mutex_trylock(&gpio->irq_n_callback_lock);
+    int const unlock_result_2 =
+        pthread_mutex_unlock(&gpio->irq_n_callback_lock);
     if (unlock_result_2 != 0)
     {
         ex10_eprintf("pthread_mutex_unlock(cb_lock) failed: %d %s\n",
@@ -189,21 +250,24 @@ static void irq_n_pthread_cleanup(void* arg)
 /**
  * pthread for monitoring IRQ_N for interrupts.
  *
- * @param thread_arg Unused at present. This argument could be used
- *                   to indicate whether errors occurred within the thread
- *                   execution lifetime.
+ * @param thread_arg The index of the Ex10 context which registered the
+ *                   IRQ_N callback; the thread selects this context so that
+ *                   the callback operates on its Ex10 device.
  *
  * @return void*     The return pointer will be the same as the pointer
  *                   passed in.
  */
 static void* irq_n_monitor(void* thread_arg)
 {
+    ex10_context_select((size_t)(uintptr_t)thread_arg);
+    struct GpioContext* gpio = get_gpio_context();
+
     // Cancellation is deferred until the thread next calls a function
     // that is a cancellation point
     int old_type = -1;
     pthread_setcanceltype(PTHREAD_CANCEL_DEFERRED, &old_type);
 
-    if (irq_n_line != NULL)
+    if (gpio->irq_n_line != NULL)
     {
         ex10_eprintf("tid: %u, irq_n_line already allocated\n",
                      ex10_get_thread_id());
@@ -211,14 +275,14 @@ static void* irq_n_monitor(void* thread_arg)
     }
 
     // Reserve IRQ_N pin
-    if (chip == NULL)
+    if (gpio->chip == NULL)
     {
         ex10_eprintf("chip == NULL\n");
         return thread_arg;
     }
 
-    irq_n_line = gpiod_chip_get_line(chip, IRQ_N_PIN);
-    if (irq_n_line == NULL)
+    gpio->irq_n_line = gpiod_chip_get_line(gpio->chip, gpio->pins.irq_n);
+    if (gpio->irq_n_line == NULL)
     {
         ex10_eprintf(
             "tid: %u, "
@@ -233,11 +297,11 @@ static void* irq_n_monitor(void* thread_arg)
     // within the macro itself. Therefore the trailing semicolon ';' is omitted
     // here to silences the static analysis "empty expression" warning.
     // clang-format off
-    pthread_cleanup_push(irq_n_pthread_cleanup, (void*)irq_n_line)  // ;
+    pthread_cleanup_push(irq_n_pthread_cleanup, (void*)gpio->irq_n_line)  // ;
 
     // Add edge monitoring
     int const result_code =
-        gpiod_line_request_falling_edge_events(irq_n_line, consumer);
+        gpiod_line_request_falling_edge_events(gpio->irq_n_line, consumer);
     // clang-format on
     if (result_code != 0)
     {
@@ -257,13 +321,13 @@ static void* irq_n_monitor(void* thread_arg)
         // Block waiting, with no timeout, for a falling edge.
         // This function calls ppoll(), which is a pthread cancellation point,
         // on an array (gpiod calls it a 'bulk') of file descriptors.
-        int const event_status = gpiod_line_event_wait(irq_n_line, NULL);
+        int const event_status = gpiod_line_event_wait(gpio->irq_n_line, NULL);
         tracepoint(pi_ex10sdk, GPIO_irq_n_low);
 
         // Clear the falling edge event.
         // The underlying system call is read(), which is a cancellation point.
         struct gpiod_line_event event;
-        gpiod_line_event_read(irq_n_line, &event);
+        gpiod_line_event_read(gpio->irq_n_line, &event);
         if (event.event_type != GPIOD_LINE_EVENT_FALLING_EDGE)
         {
             ex10_eprintf("unexpected: event_type: %d, irq_n_monitor() exit\n",
@@ -273,12 +337,12 @@ static void* irq_n_monitor(void* thread_arg)
 
         if (event_status == 1)
         {
-            pthread_mutex_lock(&irq_n_callback_lock);
-            if (irq_n_cb && irq_monitor_callback_enable_flag)
+            pthread_mutex_lock(&gpio->irq_n_callback_lock);
+            if (gpio->irq_n_cb && gpio->irq_monitor_callback_enable_flag)
             {
-                (*irq_n_cb)();
+                (*gpio->irq_n_cb)();
             }
-            pthread_mutex_unlock(&irq_n_callback_lock);
+            pthread_mutex_unlock(&gpio->irq_n_callback_lock);
         }
         else
         {
@@ -286,24 +350,26 @@ static void* irq_n_monitor(void* thread_arg)
             break;
         }
     }
-    pthread_cleanup_pop(irq_n_line);
+    pthread_cleanup_pop(gpio->irq_n_line);
 
     return thread_arg;
 }
 
 static void irq_enable(bool enable)
 {
+    struct GpioContext* gpio = get_gpio_context();
+
     if (enable)
     {
         // Unlock to allow IRQ_N handler to run
         tracepoint(pi_ex10sdk, GPIO_mutex_unlock, ex10_get_thread_id());
-        pthread_mutex_unlock(&irq_lock);
+        pthread_mutex_unlock(&gpio->irq_lock);
     }
     else
     {
         // Lock to prevent IRQ_N handler from running
         tracepoint(pi_ex10sdk, GPIO_mutex_lock_request, ex10_get_thread_id());
-        pthread_mutex_lock(&irq_lock);
+        pthread_mutex_lock(&gpio->irq_lock);
         tracepoint(pi_ex10sdk, GPIO_mutex_lock_acquired, ex10_get_thread_id());
     }
 }
@@ -432,6 +498,24 @@ static int32_t configure_gpio_pudn(uint8_t pin, enum PudnConfig config)
     return result_code;
 }
 
+/**
+ * Request the READY_N line as an input. If READY_N is waited on using edge
+ * events, then falling edge events are requested along with the input.
+ *
+ * @return int Zero for success, non-zero for failure.
+ */
+static int request_ready_n_input(void)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (gpio->ready_n_wait_mode == ReadyNWaitModeSpin)
+    {
+        return gpiod_line_request_input(gpio->ready_n_line, consumer);
+    }
+    return gpiod_line_request_falling_edge_events(gpio->ready_n_line,
+                                                  consumer);
+}
+
 static int32_t make_result_code(int result_code, int error_value)
 {
     if (result_code == 0)
@@ -444,9 +528,12 @@ static int32_t make_result_code(int result_code, int error_value)
 
 static int32_t set_board_power(bool power_on)
 {
-    if (power_line != NULL)
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (gpio->power_line != NULL)
     {
-        int const result_code = gpiod_line_set_value(power_line, power_on);
+        int const result_code =
+            gpiod_line_set_value(gpio->power_line, power_on);
         return make_result_code(result_code, ENODEV);
     }
     else
@@ -457,17 +544,23 @@ static int32_t set_board_power(bool power_on)
 
 static bool get_board_power(void)
 {
+    struct GpioContext* gpio = get_gpio_context();
+
     // Note: The assumption here is that if the pin was not allocated then
     // the pin level is false.
     // Board specific implementations will need to set this value appropriately.
-    return (power_line == NULL) ? false : gpiod_line_get_value(power_line);
+    return (gpio->power_line == NULL) ? false
+                                      : gpiod_line_get_value(gpio->power_line);
 }
 
 static int32_t set_ex10_enable(bool enable)
 {
-    if (ex10_enable_line != NULL)
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (gpio->ex10_enable_line != NULL)
     {
-        int const result_code = gpiod_line_set_value(ex10_enable_line, enable);
+        int const result_code =
+            gpiod_line_set_value(gpio->ex10_enable_line, enable);
         return make_result_code(result_code, ENODEV);
     }
     else
@@ -478,27 +571,36 @@ static int32_t set_ex10_enable(bool enable)
 
 static bool get_ex10_enable(void)
 {
-    return (ex10_enable_line == NULL) ? false
-                                      : gpiod_line_get_value(ex10_enable_line);
+    struct GpioContext* gpio = get_gpio_context();
+
+    return (gpio->ex10_enable_line == NULL)
+               ? false
+               : gpiod_line_get_value(gpio->ex10_enable_line);
 }
 
 static int32_t register_irq_callback(void (*cb_func)(void))
 {
+    struct GpioContext* gpio = get_gpio_context();
+
     int32_t result_code = 0;
-    pthread_mutex_lock(&irq_n_callback_lock);
-    if (irq_n_cb == NULL)
+    pthread_mutex_lock(&gpio->irq_n_callback_lock);
+    if (gpio->irq_n_cb == NULL)
     {
-        irq_n_cb = cb_func;
+        gpio->irq_n_cb = cb_func;
 
-        result_code =
-            pthread_create(&irq_n_monitor_pthread, NULL, irq_n_monitor, NULL);
+        // The IRQ_N monitor thread selects the context of the registering
+        // thread, which is passed as the thread argument.
+        result_code = pthread_create(&gpio->irq_n_monitor_pthread,
+                                     NULL,
+                                     irq_n_monitor,
+                                     (void*)(uintptr_t)ex10_context_index());
         if (result_code == 0)
         {
-            irq_monitor_callback_enable_flag = true;
+            gpio->irq_monitor_callback_enable_flag = true;
         }
         else
         {
-            irq_monitor_callback_enable_flag = false;
+            gpio->irq_monitor_callback_enable_flag = false;
             ex10_eprintf("pthread_create() failed: %d, %s\n",
                          result_code,
                          strerror(result_code));
@@ -510,80 +612,195 @@ static int32_t register_irq_callback(void (*cb_func)(void))
         result_code = EBUSY;
     }
 
-    pthread_mutex_unlock(&irq_n_callback_lock);
+    pthread_mutex_unlock(&gpio->irq_n_callback_lock);
     return result_code;
 }
 
 static int32_t deregister_irq_callback(void)
 {
+    struct GpioContext* gpio = get_gpio_context();
+
     // Note: This function may be called multiple times during board teardown;
     // i.e. double deregistration. gpio_cleanup() will call this function
     // regardless of state to insure gpio driver resource release.
     // Therefore, an error will be returned from this function if the IRQ_N
     // monitor thread has already been joined. Ignore the error returned.
-    pthread_mutex_lock(&irq_n_callback_lock);
-    irq_monitor_callback_enable_flag = false;
-    irq_n_cb                         = NULL;
-    pthread_mutex_unlock(&irq_n_callback_lock);
+    pthread_mutex_lock(&gpio->irq_n_callback_lock);
+    gpio->irq_monitor_callback_enable_flag = false;
+    gpio->irq_n_cb                         = NULL;
+    pthread_mutex_unlock(&gpio->irq_n_callback_lock);
 
     // Reason(s) for pthread_join() or pthread_cancel() to fail in the
     // gpio_driver.c context:
     // ESRCH (3) No thread with the ID thread could be found.
     //       i.e. the thread was not successfully created when
     //       register_irq_monitor_callback() was called.
-    int const error_cancel = pthread_cancel(irq_n_monitor_pthread);
-    int const error_join   = pthread_join(irq_n_monitor_pthread, NULL);
+    int const error_cancel = pthread_cancel(gpio->irq_n_monitor_pthread);
+    int const error_join   = pthread_join(gpio->irq_n_monitor_pthread, NULL);
 
     return (error_cancel == 0) ? error_join : error_cancel;
 }
 
 static void irq_monitor_callback_enable(bool enable)
 {
-    pthread_mutex_lock(&irq_n_callback_lock);
-    irq_monitor_callback_enable_flag = enable;
-    pthread_mutex_unlock(&irq_n_callback_lock);
+    struct GpioContext* gpio = get_gpio_context();
+
+    pthread_mutex_lock(&gpio->irq_n_callback_lock);
+    gpio->irq_monitor_callback_enable_flag = enable;
+    pthread_mutex_unlock(&gpio->irq_n_callback_lock);
 }
 
 static bool irq_monitor_callback_is_enabled(void)
 {
-    pthread_mutex_lock(&irq_n_callback_lock);
-    bool const enable = irq_monitor_callback_enable_flag;
-    pthread_mutex_unlock(&irq_n_callback_lock);
+    struct GpioContext* gpio = get_gpio_context();
+
+    pthread_mutex_lock(&gpio->irq_n_callback_lock);
+    bool const enable = gpio->irq_monitor_callback_enable_flag;
+    pthread_mutex_unlock(&gpio->irq_n_callback_lock);
     return enable;
 }
 
 static bool thread_is_irq_monitor(void)
 {
+    struct GpioContext* gpio = get_gpio_context();
+
     pthread_t const tid_self = pthread_self();
-    return pthread_equal(tid_self, irq_n_monitor_pthread) ? true : false;
+    return pthread_equal(tid_self, gpio->irq_n_monitor_pthread) ? true : false;
 }
 
 static void gpio_release_all_lines(void)
 {
-    if (power_line)
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (gpio->power_line)
     {
-        gpiod_line_release(power_line);
-        power_line = NULL;
+        gpiod_line_release(gpio->power_line);
+        gpio->power_line = NULL;
     }
-    if (reset_line)
+    if (gpio->reset_line)
     {
-        gpiod_line_release(reset_line);
-        reset_line = NULL;
+        gpiod_line_release(gpio->reset_line);
+        gpio->reset_line = NULL;
     }
-    if (ex10_enable_line)
+    if (gpio->ex10_enable_line)
     {
-        gpiod_line_release(ex10_enable_line);
-        ex10_enable_line = NULL;
+        gpiod_line_release(gpio->ex10_enable_line);
+        gpio->ex10_enable_line = NULL;
     }
-    if (ready_n_line)
+    if (gpio->ready_n_line)
     {
-        gpiod_line_release(ready_n_line);
-        ready_n_line = NULL;
+        gpiod_line_release(gpio->ready_n_line);
+        gpio->ready_n_line = NULL;
     }
-    if (ex10_test_line)
+    if (gpio->ex10_test_line)
     {
-        gpiod_line_release(ex10_test_line);
-        ex10_test_line = NULL;
+        gpiod_line_release(gpio->ex10_test_line);
+        gpio->ex10_test_line = NULL;
+    }
+}
+
+/**
+ * Request the board level debug, test and LED lines.
+ *
+ * @param board_chip The GPIO chip of the context requesting the lines.
+ *
+ * @return int32_t Zero for success, non-zero for failure.
+ */
+static int32_t request_board_lines(struct gpiod_chip* board_chip)
+{
+    int32_t pull_result = 0;
+    int     result_code = 0;
+
+    // Enable debug pins as outputs with their initial level at '1'.
+    for (size_t idx = 0u; idx < ARRAY_SIZE(r807_debug_pins); ++idx)
+    {
+        pull_result = configure_gpio_pudn(r807_debug_pins[idx], PudnNone);
+        if (pull_result != 0)
+        {
+            return pull_result;
+        }
+
+        debug_lines[idx] =
+            gpiod_chip_get_line(board_chip, r807_debug_pins[idx]);
+        if (debug_lines[idx] == NULL)
+        {
+            return (errno != 0) ? errno : ENOENT;
+        }
+
+        result_code = gpiod_line_request_output(debug_lines[idx], consumer, 1u);
+        if (result_code != 0)
+        {
+            return (errno != 0) ? errno : ENOENT;
+        }
+    }
+
+    for (size_t idx = 0u; idx < ARRAY_SIZE(ex10_gpio_test_pins); ++idx)
+    {
+        pull_result =
+            configure_gpio_pudn(ex10_gpio_test_pins[idx][1], PudnNone);
+        if (pull_result != 0)
+        {
+            return pull_result;
+        }
+
+        ex10_gpio_test_lines[idx] =
+            gpiod_chip_get_line(board_chip, ex10_gpio_test_pins[idx][1]);
+        if (ex10_gpio_test_lines[idx] == NULL)
+        {
+            return (errno != 0) ? errno : ENOENT;
+        }
+
+        result_code =
+            gpiod_line_request_input(ex10_gpio_test_lines[idx], consumer);
+        if (result_code != 0)
+        {
+            return (errno != 0) ? errno : ENOENT;
+        }
+    }
+
+    // Enable LED pins as outputs with their initial level at '0' (LEDs off)
+    for (size_t idx = 0u; idx < ARRAY_SIZE(r807_led_pins); ++idx)
+    {
+        pull_result = configure_gpio_pudn(r807_led_pins[idx], PudnNone);
+        if (pull_result != 0)
+        {
+            return pull_result;
+        }
+
+        led_lines[idx] = gpiod_chip_get_line(board_chip, r807_led_pins[idx]);
+        if (led_lines[idx] == NULL)
+        {
+            return (errno != 0) ? errno : ENOENT;
+        }
+
+        result_code = gpiod_line_request_output(led_lines[idx], consumer, 0u);
+        if (result_code != 0)
+        {
+            return (errno != 0) ? errno : ENOENT;
+        }
+    }
+
+    return 0;
+}
+
+static void release_board_lines(void)
+{
+    for (size_t idx = 0u; idx < ARRAY_SIZE(debug_lines); ++idx)
+    {
+        if (debug_lines[idx] != NULL)
+        {
+            gpiod_line_release(debug_lines[idx]);
+            debug_lines[idx] = NULL;
+        }
+    }
+
+    for (size_t idx = 0u; idx < ARRAY_SIZE(led_lines); ++idx)
+    {
+        if (led_lines[idx] != NULL)
+        {
+            gpiod_line_release(led_lines[idx]);
+            led_lines[idx] = NULL;
+        }
     }
 }
 
@@ -591,15 +808,17 @@ static int32_t gpio_initialize(bool board_power_on,
                                bool ex10_enable,
                                bool reset)
 {
+    struct GpioContext* gpio = get_gpio_context();
+
     // NOTE: Inputs default to Pull-Up enable. Pull-up/pull-down values are not
     //       modifiable from userspace until Linux v5.5.
-    chip = gpiod_chip_open_by_label(gpiochip_label);
+    gpio->chip = gpiod_chip_open_by_label(gpiochip_label);
     /* Kernel 5.x-based RPi OS uses a different chip label */
-    if (!chip)
+    if (!gpio->chip)
     {
-        chip = gpiod_chip_open_by_label(gpiochip_label2);
+        gpio->chip = gpiod_chip_open_by_label(gpiochip_label2);
     }
-    if (!chip)
+    if (!gpio->chip)
     {
         return (errno != 0) ? errno : ENODEV;
     }
@@ -607,157 +826,101 @@ static int32_t gpio_initialize(bool board_power_on,
     gpio_release_all_lines();
 
     // The EX10 TEST line should always be driven low.
-    ex10_test_line = gpiod_chip_get_line(chip, TEST);
-    if (ex10_test_line == NULL)
+    gpio->ex10_test_line = gpiod_chip_get_line(gpio->chip, gpio->pins.test);
+    if (gpio->ex10_test_line == NULL)
     {
         return (errno != 0) ? errno : ENOENT;
     }
 
-    int result_code = gpiod_line_request_output(ex10_test_line, consumer, 0u);
+    int result_code =
+        gpiod_line_request_output(gpio->ex10_test_line, consumer, 0u);
     if (result_code != 0)
     {
         return (errno != 0) ? errno : ENOENT;
     }
 
-    int32_t pull_result = configure_gpio_pudn(BOARD_POWER_PIN, PudnNone);
+    int32_t pull_result = configure_gpio_pudn(gpio->pins.board_power, PudnNone);
     if (pull_result != 0)
     {
         return pull_result;
     }
 
-    power_line = gpiod_chip_get_line(chip, BOARD_POWER_PIN);
-    if (power_line == NULL)
+    gpio->power_line = gpiod_chip_get_line(gpio->chip, gpio->pins.board_power);
+    if (gpio->power_line == NULL)
     {
         return (errno != 0) ? errno : ENOENT;
     }
 
     result_code =
-        gpiod_line_request_output(power_line, consumer, board_power_on);
+        gpiod_line_request_output(gpio->power_line, consumer, board_power_on);
     if (result_code != 0)
     {
         return (errno != 0) ? errno : ENOENT;
     }
 
-    pull_result = configure_gpio_pudn(EX10_ENABLE_PIN, PudnNone);
+    pull_result = configure_gpio_pudn(gpio->pins.ex10_enable, PudnNone);
     if (pull_result != 0)
     {
         return pull_result;
     }
 
-    ex10_enable_line = gpiod_chip_get_line(chip, EX10_ENABLE_PIN);
-    if (ex10_enable_line == NULL)
+    gpio->ex10_enable_line =
+        gpiod_chip_get_line(gpio->chip, gpio->pins.ex10_enable);
+    if (gpio->ex10_enable_line == NULL)
     {
         return (errno != 0) ? errno : ENOENT;
     }
 
-    result_code =
-        gpiod_line_request_output(ex10_enable_line, consumer, ex10_enable);
+    result_code = gpiod_line_request_output(
+        gpio->ex10_enable_line, consumer, ex10_enable);
     if (result_code != 0)
     {
         return (errno != 0) ? errno : ENOENT;
     }
 
-    pull_result = configure_gpio_pudn(RESET_N_PIN, PudnNone);
+    pull_result = configure_gpio_pudn(gpio->pins.reset_n, PudnNone);
     if (pull_result != 0)
     {
         return pull_result;
     }
 
-    reset_line = gpiod_chip_get_line(chip, RESET_N_PIN);
-    if (reset_line == NULL)
+    gpio->reset_line = gpiod_chip_get_line(gpio->chip, gpio->pins.reset_n);
+    if (gpio->reset_line == NULL)
     {
         return (errno != 0) ? errno : ENOENT;
     }
 
-    result_code = gpiod_line_request_output(reset_line, consumer, !reset);
+    result_code = gpiod_line_request_output(gpio->reset_line, consumer, !reset);
     if (result_code != 0)
     {
         return (errno != 0) ? errno : ENOENT;
     }
 
-    pull_result = configure_gpio_pudn(READY_N_PIN, PudnNone);
+    pull_result = configure_gpio_pudn(gpio->pins.ready_n, PudnNone);
     if (pull_result != 0)
     {
         return pull_result;
     }
 
-    ready_n_line = gpiod_chip_get_line(chip, READY_N_PIN);
-    if (ready_n_line == NULL)
+    gpio->ready_n_line = gpiod_chip_get_line(gpio->chip, gpio->pins.ready_n);
+    if (gpio->ready_n_line == NULL)
     {
         return (errno != 0) ? errno : ENOENT;
     }
 
-    result_code = gpiod_line_request_input(ready_n_line, consumer);
+    result_code = request_ready_n_input();
     if (result_code != 0)
     {
         return (errno != 0) ? errno : ENOENT;
     }
 
-    // Enable debug pins as outputs with their initial level at '1'.
-    for (size_t idx = 0u; idx < ARRAY_SIZE(r807_debug_pins); ++idx)
-    {
-        pull_result = configure_gpio_pudn(r807_debug_pins[idx], PudnNone);
-        if (pull_result != 0)
-        {
-            return pull_result;
-        }
-
-        debug_lines[idx] = gpiod_chip_get_line(chip, r807_debug_pins[idx]);
-        if (debug_lines[idx] == NULL)
-        {
-            return (errno != 0) ? errno : ENOENT;
-        }
-
-        result_code = gpiod_line_request_output(debug_lines[idx], consumer, 1u);
-        if (result_code != 0)
-        {
-            return (errno != 0) ? errno : ENOENT;
-        }
-    }
-
-    for (size_t idx = 0u; idx < ARRAY_SIZE(ex10_gpio_test_pins); ++idx)
+    if (board_lines_owner == EX10_MAX_CONTEXTS)
     {
-        pull_result =
-            configure_gpio_pudn(ex10_gpio_test_pins[idx][1], PudnNone);
-        if (pull_result != 0)
-        {
-            return pull_result;
-        }
-
-        ex10_gpio_test_lines[idx] =
-            gpiod_chip_get_line(chip, ex10_gpio_test_pins[idx][1]);
-        if (ex10_gpio_test_lines[idx] == NULL)
-        {
-            return (errno != 0) ? errno : ENOENT;
-        }
-
-        result_code =
-            gpiod_line_request_input(ex10_gpio_test_lines[idx], consumer);
-        if (result_code != 0)
+        board_lines_owner = ex10_context_index();
+        int32_t const board_result = request_board_lines(gpio->chip);
+        if (board_result != 0)
         {
-            return (errno != 0) ? errno : ENOENT;
-        }
-    }
-
-    // Enable LED pins as outputs with their initial level at '0' (LEDs off)
-    for (size_t idx = 0u; idx < ARRAY_SIZE(r807_led_pins); ++idx)
-    {
-        pull_result = configure_gpio_pudn(r807_led_pins[idx], PudnNone);
-        if (pull_result != 0)
-        {
-            return pull_result;
-        }
-
-        led_lines[idx] = gpiod_chip_get_line(chip, r807_led_pins[idx]);
-        if (led_lines[idx] == NULL)
-        {
-            return (errno != 0) ? errno : ENOENT;
-        }
-
-        result_code = gpiod_line_request_output(led_lines[idx], consumer, 0u);
-        if (result_code != 0)
-        {
-            return (errno != 0) ? errno : ENOENT;
+            return board_result;
         }
     }
 
@@ -785,42 +948,34 @@ static int32_t gpio_initialize(bool board_power_on,
 
 static void gpio_cleanup(void)
 {
+    struct GpioContext* gpio = get_gpio_context();
+
     deregister_irq_callback();
 
     gpio_release_all_lines();
 
-    for (size_t idx = 0u; idx < ARRAY_SIZE(debug_lines); ++idx)
+    if (board_lines_owner == ex10_context_index())
     {
-        if (debug_lines[idx] != NULL)
-        {
-            gpiod_line_release(debug_lines[idx]);
-            debug_lines[idx] = NULL;
-        }
+        release_board_lines();
+        board_lines_owner = EX10_MAX_CONTEXTS;
     }
 
-    for (size_t idx = 0u; idx < ARRAY_SIZE(led_lines); ++idx)
+    if (gpio->chip)
     {
-        if (led_lines[idx] != NULL)
-        {
-            gpiod_line_release(led_lines[idx]);
-            led_lines[idx] = NULL;
-        }
-    }
-
-    if (chip)
-    {
-        gpiod_chip_close(chip);
-        chip = NULL;
+        gpiod_chip_close(gpio->chip);
+        gpio->chip = NULL;
     }
 }
 
 static int32_t assert_ready_n(void)
 {
-    if (ready_n_line != NULL)
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (gpio->ready_n_line != NULL)
     {
-        gpiod_line_release(ready_n_line);
+        gpiod_line_release(gpio->ready_n_line);
         int const result_code =
-            gpiod_line_request_output(ready_n_line, consumer, 0);
+            gpiod_line_request_output(gpio->ready_n_line, consumer, 0);
         if (result_code == 0)
         {
             return 0;
@@ -832,11 +987,12 @@ static int32_t assert_ready_n(void)
 
 static int32_t release_ready_n(void)
 {
-    if (ready_n_line != NULL)
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (gpio->ready_n_line != NULL)
     {
-        gpiod_line_release(ready_n_line);
-        int const result_code =
-            gpiod_line_request_input(ready_n_line, consumer);
+        gpiod_line_release(gpio->ready_n_line);
+        int const result_code = request_ready_n_input();
         if (result_code == 0)
         {
             return 0;
@@ -848,9 +1004,11 @@ static int32_t release_ready_n(void)
 
 static int32_t assert_reset_n(void)
 {
-    if (reset_line != NULL)
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (gpio->reset_line != NULL)
     {
-        int const result_code = gpiod_line_set_value(reset_line, 0);
+        int const result_code = gpiod_line_set_value(gpio->reset_line, 0);
         if (result_code == 0)
         {
             return 0;
@@ -862,9 +1020,11 @@ static int32_t assert_reset_n(void)
 
 static int32_t deassert_reset_n(void)
 {
-    if (reset_line != NULL)
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (gpio->reset_line != NULL)
     {
-        int const result_code = gpiod_line_set_value(reset_line, 1);
+        int const result_code = gpiod_line_set_value(gpio->reset_line, 1);
         if (result_code == 0)
         {
             return 0;
@@ -884,41 +1044,194 @@ static int32_t reset_device(void)
 
 static int ready_n_pin_get(void)
 {
-    int gpio_level = gpiod_line_get_value(ready_n_line);
+    struct GpioContext* gpio = get_gpio_context();
+
+    int gpio_level = gpiod_line_get_value(gpio->ready_n_line);
     return gpio_level;
 }
 
-static int32_t busy_wait_ready_n(uint32_t timeout_ms)
+static uint64_t monotonic_time_us(void)
 {
-    struct Ex10TimeHelpers const* time_helpers = get_ex10_time_helpers();
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+}
 
-    uint32_t const start_time = time_helpers->time_now();
+/**
+ * Poll the READY_N line level until it asserts low.
+ *
+ * @param end_time_us The monotonic time, in microseconds, at which to stop.
+ *
+ * @return int32_t Zero if READY_N asserted, ETIMEDOUT if the end time was
+ *                 reached, or the errno value of a libgpiod failure.
+ */
+static int32_t spin_wait_ready_n(uint64_t end_time_us)
+{
+    struct GpioContext* gpio = get_gpio_context();
 
-    // Check for ready n low or get a timeout
-    int result_code = 0;
-    int gpio_level  = 1;
     do
     {
-        gpio_level = gpiod_line_get_value(ready_n_line);
+        int const gpio_level = gpiod_line_get_value(gpio->ready_n_line);
         if (gpio_level == -1)
         {
             ex10_eprintf("gpiod_line_get_value() failed: %d, %s\n",
                          errno,
                          strerror(errno));
-            result_code = -1;
+            return (errno != 0) ? errno : EIO;
         }
+        if (gpio_level == 0)
+        {
+            return 0;
+        }
+    } while (monotonic_time_us() < end_time_us);
 
-        if (time_helpers->time_elapsed(start_time) > timeout_ms)
+    return ETIMEDOUT;
+}
+
+/**
+ * Block on READY_N falling edge events until the READY_N line asserts low.
+ *
+ * The line level is checked prior to each wait. A falling edge which occurs
+ * after the level check is queued by the kernel and wakes the wait.
+ * Edges queued during earlier command cycles wake the wait as well; these
+ * are consumed and the line level is checked again.
+ *
+ * @param end_time_us The monotonic time, in microseconds, at which to stop.
+ *
+ * @return int32_t Zero if READY_N asserted, ETIMEDOUT if the end time was
+ *                 reached, or the errno value of a libgpiod failure.
+ */
+static int32_t event_wait_ready_n(uint64_t end_time_us)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    while (true)
+    {
+        int const gpio_level = gpiod_line_get_value(gpio->ready_n_line);
+        if (gpio_level == -1)
+        {
+            ex10_eprintf("gpiod_line_get_value() failed: %d, %s\n",
+                         errno,
+                         strerror(errno));
+            return (errno != 0) ? errno : EIO;
+        }
+        if (gpio_level == 0)
+        {
+            return 0;
+        }
+
+        uint64_t const now_us = monotonic_time_us();
+        if (now_us >= end_time_us)
+        {
+            return ETIMEDOUT;
+        }
+
+        uint64_t const        remain_us = end_time_us - now_us;
+        struct timespec const timeout   = {
+            .tv_sec  = (time_t)(remain_us / 1000000u),
+            .tv_nsec = (long)((remain_us % 1000000u) * 1000u),
+        };
+
+        // This function calls ppoll() on the line event file descriptor.
+        int const event_status =
+            gpiod_line_event_wait(gpio->ready_n_line, &timeout);
+        if (event_status == -1)
+        {
+            ex10_eprintf("gpiod_line_event_wait() failed: %d, %s\n",
+                         errno,
+                         strerror(errno));
+            return (errno != 0) ? errno : EIO;
+        }
+        if (event_status == 1)
+        {
+            struct gpiod_line_event event;
+            if (gpiod_line_event_read(gpio->ready_n_line, &event) != 0)
+            {
+                ex10_eprintf("gpiod_line_event_read() failed: %d, %s\n",
+                             errno,
+                             strerror(errno));
+                return (errno != 0) ? errno : EIO;
+            }
+        }
+    }
+}
+
+static int32_t busy_wait_ready_n(uint32_t timeout_ms)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    uint64_t const start_time_us = monotonic_time_us();
+    uint64_t const end_time_us =
+        start_time_us + (uint64_t)timeout_ms * 1000u;
+
+    int32_t result_code = 0;
+    switch (gpio->ready_n_wait_mode)
+    {
+        case ReadyNWaitModeEvent:
+            result_code = event_wait_ready_n(end_time_us);
+            break;
+        case ReadyNWaitModeHybrid:
         {
-            ex10_eprintf("timeout: %u ms expired\n", timeout_ms);
-            errno       = ETIMEDOUT;
-            result_code = -1;
+            uint64_t const spin_end_time_us =
+                start_time_us + gpio->ready_n_spin_us;
+            result_code = spin_wait_ready_n(
+                (spin_end_time_us < end_time_us) ? spin_end_time_us
+                                                 : end_time_us);
+            if (result_code == ETIMEDOUT)
+            {
+                result_code = event_wait_ready_n(end_time_us);
+            }
+            break;
         }
+        case ReadyNWaitModeSpin:
+        default:
+            result_code = spin_wait_ready_n(end_time_us);
+            break;
+    }
 
-    } while ((gpio_level != 0) && (result_code == 0));
+    if (result_code == ETIMEDOUT)
+    {
+        ex10_eprintf("timeout: %u ms expired\n", timeout_ms);
+    }
 
     tracepoint(pi_ex10sdk, GPIO_ready_n_low);
-    return (result_code == 0) ? 0 : errno;
+    if (result_code != 0)
+    {
+        errno = result_code;
+    }
+    return result_code;
+}
+
+static int32_t set_ready_n_wait_mode(enum ReadyNWaitMode mode,
+                                     uint32_t            spin_us)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    switch (mode)
+    {
+        case ReadyNWaitModeSpin:
+        case ReadyNWaitModeEvent:
+        case ReadyNWaitModeHybrid:
+            break;
+        default:
+            return EINVAL;
+    }
+
+    // Lock out host interface transactions while the READY_N line request
+    // is changed between the input only and edge event configurations.
+    irq_enable(false);
+
+    bool const reconfigure = (gpio->ready_n_line != NULL) &&
+        ((mode == ReadyNWaitModeSpin) !=
+         (gpio->ready_n_wait_mode == ReadyNWaitModeSpin));
+
+    gpio->ready_n_wait_mode = mode;
+    gpio->ready_n_spin_us   = spin_us;
+
+    int32_t const result_code = reconfigure ? release_ready_n() : 0;
+
+    irq_enable(true);
+    return result_code;
 }
 
 static bool get_test_pin_level(uint8_t pin_no)
@@ -997,6 +1310,24 @@ static void led_pin_toggle(uint8_t pin_idx)
     }
 }
 
+static int32_t set_pin_map(struct Ex10GpioPinMap const* pin_map)
+{
+    if (pin_map == NULL)
+    {
+        return EINVAL;
+    }
+
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (gpio->chip != NULL)
+    {
+        return EBUSY;
+    }
+
+    gpio->pins = *pin_map;
+    return 0;
+}
+
 static struct Ex10GpioDriver const ex10_gpio_driver = {
     .gpio_initialize                 = gpio_initialize,
     .gpio_cleanup                    = gpio_cleanup,
@@ -1017,6 +1348,7 @@ static struct Ex10GpioDriver const ex10_gpio_driver = {
     .reset_device                    = reset_device,
     .busy_wait_ready_n               = busy_wait_ready_n,
     .ready_n_pin_get                 = ready_n_pin_get,
+    .set_ready_n_wait_mode           = set_ready_n_wait_mode,
     .get_test_pin_level              = get_test_pin_level,
     .debug_pin_get_count             = debug_pin_get_count,
     .debug_pin_get                   = debug_pin_get,
@@ -1026,6 +1358,7 @@ static struct Ex10GpioDriver const ex10_gpio_driver = {
     .led_pin_get                     = led_pin_get,
     .led_pin_set                     = led_pin_set,
     .led_pin_toggle                  = led_pin_toggle,
+    .set_pin_map                     = set_pin_map,
 };
 
 struct Ex10GpioDriver const* get_ex10_gpio_driver(void)
@@ -20,6 +20,7 @@
 #include <unistd.h>
 
 #include "board/spi_driver.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_print.h"
 
 static uint32_t const default_clock_freq_hz = 4000000u;
@@ -29,23 +30,54 @@ struct SpiParameters
     int           fd;
     unsigned char bits_per_word;
     unsigned int  clock_freq_hz;
+    char const*   device_path;
 };
 
-static struct SpiParameters spi_0 = {-1, 0, 0};
+/// The SPI device of each Ex10 context; on the Raspberry Pi these are the
+/// chip selects of the SPI0 and SPI1 controllers.
+static struct SpiParameters spi_contexts[EX10_MAX_CONTEXTS] = {
+    {-1, 0, 0, "/dev/spidev0.0"},
+    {-1, 0, 0, "/dev/spidev0.1"},
+    {-1, 0, 0, "/dev/spidev1.0"},
+    {-1, 0, 0, "/dev/spidev1.1"},
+};
+
+static struct SpiParameters* get_spi_parameters(void)
+{
+    return &spi_contexts[ex10_context_index()];
+}
+
+static int32_t spi_set_device(char const* device_path)
+{
+    struct SpiParameters* spi = get_spi_parameters();
+
+    if (device_path == NULL)
+    {
+        return -EINVAL;
+    }
+    if (spi->fd != -1)
+    {
+        return -EBUSY;
+    }
+    spi->device_path = device_path;
+    return 0;
+}
 
 static int32_t spi_open(uint32_t clock_freq_hz)
 {
+    struct SpiParameters* spi = get_spi_parameters();
+
     // SPI_MODE_1 uses CPOL = 0, CPHA = 1
     const uint8_t spi_mode = SPI_MODE_1;
 
-    spi_0.bits_per_word = 8u;
-    spi_0.clock_freq_hz =
+    spi->bits_per_word = 8u;
+    spi->clock_freq_hz =
         (clock_freq_hz == 0) ? default_clock_freq_hz : clock_freq_hz;
 
-    char const* spi_dev_name = "/dev/spidev0.0";
-    spi_0.fd                 = open(spi_dev_name, O_RDWR);
+    char const* spi_dev_name = spi->device_path;
+    spi->fd                  = open(spi_dev_name, O_RDWR);
 
-    if (spi_0.fd < 0)
+    if (spi->fd < 0)
     {
         ex10_eprintf(
             "open(%s) failed: %s: %d\n", spi_dev_name, strerror(errno), errno);
@@ -53,7 +85,7 @@ static int32_t spi_open(uint32_t clock_freq_hz)
     }
 
     int retval = 0;
-    retval     = ioctl(spi_0.fd, SPI_IOC_WR_MODE, &spi_mode);
+    retval     = ioctl(spi->fd, SPI_IOC_WR_MODE, &spi_mode);
     if (retval < 0)
     {
         ex10_eprintf(
@@ -61,7 +93,7 @@ static int32_t spi_open(uint32_t clock_freq_hz)
         return -errno;
     }
 
-    retval = ioctl(spi_0.fd, SPI_IOC_WR_BITS_PER_WORD, &spi_0.bits_per_word);
+    retval = ioctl(spi->fd, SPI_IOC_WR_BITS_PER_WORD, &spi->bits_per_word);
     if (retval < 0)
     {
         ex10_eprintf("ioctl(SPI_IOC_WR_BITS_PER_WORD) failed: %s: %d\n",
@@ -70,7 +102,7 @@ static int32_t spi_open(uint32_t clock_freq_hz)
         return -errno;
     }
 
-    retval = ioctl(spi_0.fd, SPI_IOC_RD_MODE, &spi_mode);
+    retval = ioctl(spi->fd, SPI_IOC_RD_MODE, &spi_mode);
     if (retval < 0)
     {
         ex10_eprintf(
@@ -78,7 +110,7 @@ static int32_t spi_open(uint32_t clock_freq_hz)
         return -errno;
     }
 
-    retval = ioctl(spi_0.fd, SPI_IOC_RD_BITS_PER_WORD, &spi_0.bits_per_word);
+    retval = ioctl(spi->fd, SPI_IOC_RD_BITS_PER_WORD, &spi->bits_per_word);
     if (retval < 0)
     {
         ex10_eprintf("ioctl(SPI_IOC_RD_BITS_PER_WORD) failed: %s: %d\n",
@@ -87,7 +119,7 @@ static int32_t spi_open(uint32_t clock_freq_hz)
         return -errno;
     }
 
-    retval = ioctl(spi_0.fd, SPI_IOC_WR_MAX_SPEED_HZ, &spi_0.clock_freq_hz);
+    retval = ioctl(spi->fd, SPI_IOC_WR_MAX_SPEED_HZ, &spi->clock_freq_hz);
     if (retval < 0)
     {
         ex10_eprintf("ioctl(SPI_IOC_WR_MAX_SPEED_HZ) failed: %s: %d\n",
@@ -96,7 +128,7 @@ static int32_t spi_open(uint32_t clock_freq_hz)
         return -errno;
     }
 
-    retval = ioctl(spi_0.fd, SPI_IOC_RD_MAX_SPEED_HZ, &spi_0.clock_freq_hz);
+    retval = ioctl(spi->fd, SPI_IOC_RD_MAX_SPEED_HZ, &spi->clock_freq_hz);
     if (retval < 0)
     {
         ex10_eprintf("ioctl(SPI_IOC_RD_MAX_SPEED_HZ) failed: %s: %d\n",
@@ -110,13 +142,15 @@ static int32_t spi_open(uint32_t clock_freq_hz)
 
 static void spi_close(void)
 {
-    if (spi_0.fd == -1)
+    struct SpiParameters* spi = get_spi_parameters();
+
+    if (spi->fd == -1)
     {
         return;
     }
-    int spi_0_fd_to_close = spi_0.fd;
-    spi_0.fd              = -1;
-    if (close(spi_0_fd_to_close) < 0)
+    int const fd_to_close = spi->fd;
+    spi->fd               = -1;
+    if (close(fd_to_close) < 0)
     {
         ex10_eprintf("spi_close() failed: %s: %d\n", strerror(errno), errno);
     }
@@ -124,11 +158,13 @@ static void spi_close(void)
 
 static int32_t spi_write(const void* tx_buff, size_t length)
 {
-    if (spi_0.fd == -1)
+    struct SpiParameters* spi = get_spi_parameters();
+
+    if (spi->fd == -1)
     {
         return -1;
     }
-    ssize_t const retval = write(spi_0.fd, tx_buff, length);
+    ssize_t const retval = write(spi->fd, tx_buff, length);
     if (retval < 0)
     {
         ex10_eprintf(
@@ -147,11 +183,13 @@ static int32_t spi_write(const void* tx_buff, size_t length)
 
 static int32_t spi_read(void* rx_buff, size_t length)
 {
-    if (spi_0.fd == -1)
+    struct SpiParameters* spi = get_spi_parameters();
+
+    if (spi->fd == -1)
     {
         return -1;
     }
-    ssize_t const retval = read(spi_0.fd, rx_buff, length);
+    ssize_t const retval = read(spi->fd, rx_buff, length);
 
     if (retval < 0)
     {
@@ -167,11 +205,115 @@ static int32_t spi_read(void* rx_buff, size_t length)
     return retval;
 }
 
+/**
+ * Submit a chain of spi_ioc_transfer segments using one SPI_IOC_MESSAGE()
+ * ioctl. The chip select remains asserted between segments since none of the
+ * segments set the cs_change field.
+ *
+ * @param transfers      The list of transfer segments.
+ * @param transfer_count The number of transfer segments.
+ * @param length         The total number of bytes in all transfer segments.
+ *
+ * @return int32_t The number of bytes transferred, or -1 on failure.
+ */
+static int32_t spi_transfer(struct spi_ioc_transfer const* transfers,
+                            size_t                         transfer_count,
+                            size_t                         length)
+{
+    struct SpiParameters* spi = get_spi_parameters();
+
+    int const retval =
+        ioctl(spi->fd, SPI_IOC_MESSAGE(transfer_count), transfers);
+    if (retval < 0)
+    {
+        ex10_eprintf("ioctl(SPI_IOC_MESSAGE(%zu)) failed: %s: %d\n",
+                     transfer_count,
+                     strerror(errno),
+                     errno);
+        return -1;
+    }
+    else if ((size_t)retval != length)
+    {
+        ex10_eprintf("ioctl(SPI_IOC_MESSAGE(%zu)): %d != %zu, "
+                     "unexpected bytes transferred\n",
+                     transfer_count,
+                     retval,
+                     length);
+        return -1;
+    }
+    return retval;
+}
+
+static int32_t spi_write_segments(struct ConstByteSpan const* segments,
+                                  size_t                      segment_count)
+{
+    struct SpiParameters* spi = get_spi_parameters();
+
+    if ((spi->fd == -1) || (segments == NULL) || (segment_count == 0u) ||
+        (segment_count > EX10_SPI_MAX_SEGMENTS))
+    {
+        return -1;
+    }
+
+    struct spi_ioc_transfer transfers[EX10_SPI_MAX_SEGMENTS];
+    memset(transfers, 0, sizeof(transfers));
+
+    size_t length = 0u;
+    for (size_t iter = 0u; iter < segment_count; ++iter)
+    {
+        if ((segments[iter].data == NULL) && (segments[iter].length > 0u))
+        {
+            return -1;
+        }
+        transfers[iter].tx_buf        = (uintptr_t)segments[iter].data;
+        transfers[iter].len           = (uint32_t)segments[iter].length;
+        transfers[iter].speed_hz      = spi->clock_freq_hz;
+        transfers[iter].bits_per_word = spi->bits_per_word;
+        length += segments[iter].length;
+    }
+
+    return spi_transfer(transfers, segment_count, length);
+}
+
+static int32_t spi_read_segments(struct ByteSpan const* segments,
+                                 size_t                 segment_count)
+{
+    struct SpiParameters* spi = get_spi_parameters();
+
+    if ((spi->fd == -1) || (segments == NULL) || (segment_count == 0u) ||
+        (segment_count > EX10_SPI_MAX_SEGMENTS))
+    {
+        return -1;
+    }
+
+    struct spi_ioc_transfer transfers[EX10_SPI_MAX_SEGMENTS];
+    memset(transfers, 0, sizeof(transfers));
+
+    size_t length = 0u;
+    for (size_t iter = 0u; iter < segment_count; ++iter)
+    {
+        if ((segments[iter].data == NULL) && (segments[iter].length > 0u))
+        {
+            return -1;
+        }
+        transfers[iter].rx_buf        = (uintptr_t)segments[iter].data;
+        transfers[iter].len           = (uint32_t)segments[iter].length;
+        transfers[iter].speed_hz      = spi->clock_freq_hz;
+        transfers[iter].bits_per_word = spi->bits_per_word;
+        length += segments[iter].length;
+    }
+
+    return spi_transfer(transfers, segment_count, length);
+}
+
 static struct Ex10SpiDriver const ex10_spi_driver = {
-    .spi_open  = spi_open,
-    .spi_close = spi_close,
-    .spi_write = spi_write,
-    .spi_read  = spi_read,
+    .spi_open           = spi_open,
+    .spi_close          = spi_close,
+    .spi_write          = spi_write,
+    .spi_read           = spi_read,
+    .spi_write_segments = spi_write_segments,
+    .spi_read_segments  = spi_read_segments,
+    .spi_set_device     = spi_set_device,
 };
 
 struct Ex10SpiDriver const* get_ex10_spi_driver(void)
@@ -67,11 +67,28 @@ static void ex10_wait_ms(uint32_t msec_to_wait)
     usleep(msec_to_wait * 1000);
 }
 
+static uint64_t ex10_time_now_ns(void)
+{
+    struct timespec now;
+    // The same clock as ex10_time_now(), without truncating the seconds.
+    clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+
+    uint64_t const ns_per_s = 1000u * 1000u * 1000u;
+    return (uint64_t)now.tv_sec * ns_per_s + (uint64_t)now.tv_nsec;
+}
+
+static uint64_t ex10_time_now_us(void)
+{
+    return ex10_time_now_ns() / 1000u;
+}
+
 static struct Ex10TimeHelpers ex10_time_helpers = {
     .time_now     = ex10_time_now,
     .time_elapsed = ex10_time_elapsed,
     .busy_wait_ms = ex10_busy_wait_ms,
     .wait_ms      = ex10_wait_ms,
+    .time_now_us  = ex10_time_now_us,
+    .time_now_ns  = ex10_time_now_ns,
 };
 
 struct Ex10TimeHelpers* get_ex10_time_helpers(void)
@@ -80,6 +80,10 @@ static int32_t uart_open(enum AllowedBpsRates bitrate)
     uart_opts.c_cflag |= (CLOCAL | CREAD | default_width);
     uart_opts.c_lflag &= (tcflag_t) ~(ICANON | ECHO | ECHOE | ISIG);
     uart_opts.c_oflag |= OPOST;
+    // Block reads until at least one byte is received, with no inter-byte
+    // timer, so that the receiver does not need to poll.
+    uart_opts.c_cc[VMIN]  = 1u;
+    uart_opts.c_cc[VTIME] = 0u;
     tcsetattr(uart_0.fd, TCSANOW, &uart_opts);
 
     uart_0.speed         = speed;
@@ -0,0 +1,173 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ex10_api/ex10_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The number of threads which may log asynchronously at the same time.
+/// Threads beyond this number print synchronously.
+#define EX10_ASYNC_LOG_MAX_THREADS ((size_t)8u)
+
+/// The size of the record ring of each logging thread, in bytes.
+#define EX10_ASYNC_LOG_RING_SIZE ((size_t)(16u * 1024u))
+
+/// The number of call sites whose rate is limited. Messages from call sites
+/// beyond this number are not rate limited.
+#define EX10_ASYNC_LOG_MAX_SITES ((size_t)128u)
+
+/// The longest string argument copied into a record; longer strings are
+/// truncated.
+#define EX10_ASYNC_LOG_MAX_STRING_LENGTH ((size_t)128u)
+
+/**
+ * @enum Ex10LogStream
+ * The print function which created a log record, which determines the
+ * stream and the prefix the record is printed with.
+ */
+enum Ex10LogStream
+{
+    /// ex10_printf(): printed to stdout.
+    Ex10LogStreamPrint,
+    /// ex10_eprintf(): printed to stderr, prefixed with the function name.
+    Ex10LogStreamError,
+    /// ex10_eputs(): printed to stderr without a prefix.
+    Ex10LogStreamErrorPuts,
+};
+
+/**
+ * @struct Ex10AsyncLogConfig
+ * The asynchronous logging configuration, passed to Ex10AsyncLog.start().
+ */
+struct Ex10AsyncLogConfig
+{
+    /// The maximum number of messages printed from each call site within
+    /// rate_limit_interval_ms; further messages are counted and reported as
+    /// suppressed. Zero disables rate limiting.
+    uint32_t rate_limit_count;
+    uint32_t rate_limit_interval_ms;
+
+    /// The interval at which the formatting thread checks for records.
+    uint32_t poll_interval_ms;
+
+    /// If true, each message is prefixed with the host time, in
+    /// microseconds, at which it was logged.
+    bool print_timestamps;
+};
+
+/**
+ * @struct Ex10AsyncLogStats
+ * The asynchronous logging counters, accumulated since start().
+ */
+struct Ex10AsyncLogStats
+{
+    /// The number of messages recorded and printed by the formatting thread.
+    size_t records_logged;
+    /// The number of messages dropped because the thread's ring was full.
+    size_t records_dropped;
+    /// The number of messages suppressed by the call site rate limit.
+    size_t records_suppressed;
+    /// The number of messages printed synchronously because no ring was
+    /// available to the calling thread.
+    size_t records_synchronous;
+};
+
+/**
+ * @struct Ex10AsyncLog
+ * An asynchronous backend for ex10_printf(), ex10_eprintf() and
+ * ex10_eputs(), and so for the EventFifo packet printer.
+ *
+ * When started, a print call does not format its message: it copies the
+ * format string pointer, the arguments and a timestamp as a compact binary
+ * record into a lock-free ring owned by the calling thread. A formatting
+ * thread merges the records of all rings in timestamp order and prints them.
+ * This keeps stdio formatting and blocking writes off the IRQ_N monitor
+ * thread, so that diagnostics can be enabled without the EventFifo
+ * overflowing.
+ *
+ * The format string must be a string literal, or otherwise remain valid
+ * until the record is printed; string arguments are copied. The %n
+ * conversion is not supported.
+ *
+ * Each format string is treated as a call site for rate limiting.
+ *
+ * While started, the print functions return 0 rather than the number of
+ * characters written, since the message has not been formatted yet.
+ */
+struct Ex10AsyncLog
+{
+    /**
+     * Start the formatting thread and route the print functions to it.
+     *
+     * @param config The logging configuration, or NULL to use the defaults:
+     *               no rate limit, a 10 ms poll interval and no timestamps.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     */
+    struct Ex10Result (*start)(struct Ex10AsyncLogConfig const* config);
+
+    /**
+     * Print the recorded messages, stop the formatting thread and route the
+     * print functions back to synchronous printing.
+     */
+    void (*stop)(void);
+
+    /**
+     * Wait until the messages recorded before the call have been printed.
+     */
+    void (*flush)(void);
+
+    /** @return bool true if the formatting thread is running. */
+    bool (*is_started)(void);
+
+    /**
+     * Get the logging counters.
+     *
+     * @param [out] stats The logging counters.
+     */
+    void (*get_stats)(struct Ex10AsyncLogStats* stats);
+};
+
+struct Ex10AsyncLog const* get_ex10_async_log(void);
+
+/**
+ * Record a message for the formatting thread. Called by the print functions.
+ *
+ * @param stream The print function which was called.
+ * @param func   The name of the calling function for Ex10LogStreamError,
+ *               otherwise NULL.
+ * @param fmt    The printf format string.
+ * @param args   The printf arguments.
+ *
+ * @return bool true if the message was handled: recorded, dropped or
+ *              suppressed. false if the message must be printed
+ *              synchronously.
+ */
+bool ex10_async_log_record(enum Ex10LogStream stream,
+                           char const*        func,
+                           char const*        fmt,
+                           va_list            args);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,77 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct Ex10CalCacheStorage
+ * The board storage of the calibration cache: a single record which holds
+ * a copy of the calibration info region across runs. The record format is
+ * defined by the calibration layer; the storage only keeps its bytes.
+ */
+struct Ex10CalCacheStorage
+{
+    /**
+     * Set where the record is stored.
+     *
+     * @param location The storage location, e.g. a file path, or NULL to
+     *                 disable the cache. The location is copied.
+     *
+     * @return bool false if the location cannot be stored, in which case
+     *              the previous setting is kept.
+     */
+    bool (*set_location)(char const* location);
+
+    /**
+     * @return bool true if a storage location is set.
+     */
+    bool (*is_enabled)(void);
+
+    /**
+     * Read the start of the record.
+     *
+     * @param [out] buffer The record bytes.
+     * @param length       The number of bytes to read.
+     *
+     * @return bool true if length bytes were read.
+     */
+    bool (*read)(void* buffer, size_t length);
+
+    /**
+     * Replace the record. A reader never sees a partially written record.
+     *
+     * @param buffer The record bytes.
+     * @param length The number of bytes to write.
+     *
+     * @return bool true if the record was written.
+     */
+    bool (*write)(void const* buffer, size_t length);
+
+    /**
+     * Delete the record, if any.
+     */
+    void (*erase)(void);
+};
+
+struct Ex10CalCacheStorage const* get_ex10_cal_cache_storage(void);
+
+#ifdef __cplusplus
+}
+#endif
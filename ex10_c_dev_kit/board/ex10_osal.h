@@ -28,6 +28,21 @@ extern "C" {
 #define EX10_OS_TYPE_BARE_METAL 2
 #define EX10_OS_TYPE_SIM 3
 
+/**
+ * @struct Ex10ThreadAttributes
+ * The scheduling attributes applied to a thread run by the SDK.
+ */
+struct Ex10ThreadAttributes
+{
+    /// The CPUs on which the thread may run; bit N selects CPU N.
+    /// Zero leaves the thread CPU affinity unchanged.
+    uint64_t cpu_mask;
+
+    /// The SCHED_FIFO real-time priority of the thread.
+    /// Zero leaves the thread scheduling policy unchanged.
+    int32_t fifo_priority;
+};
+
 #if !defined(EX10_OSAL_TYPE)
 #error "EX10_OSAL_TYPE symbol not defined"
 #endif  // EX10_OSAL_TYPE
@@ -43,6 +58,11 @@ typedef int32_t ex10_mutex_t;
 typedef int32_t ex10_cond_t;
 #define EX10_COND_INITIALIZER (0)
 
+typedef int32_t ex10_thread_t;
+
+/// A single thread of execution; thread local storage is not required.
+#define EX10_THREAD_LOCAL
+
 #elif (EX10_OSAL_TYPE == EX10_OS_TYPE_SIM)
 
 typedef int32_t ex10_mutex_t;
@@ -51,20 +71,36 @@ typedef int32_t ex10_mutex_t;
 typedef int32_t ex10_cond_t;
 #define EX10_COND_INITIALIZER (0)
 
+typedef int32_t ex10_thread_t;
+
+#define EX10_THREAD_LOCAL
+
 #else
 #error "EX10_OSAL_TYPE symbol not recognized"
 #endif  // EX10_OSAL_TYPE
 
 #if !defined(EX10_OSAL_DECLARED)
 
+int ex10_mutex_init(ex10_mutex_t* mutex);
+int ex10_cond_init(ex10_cond_t* cond);
 int ex10_mutex_lock(ex10_mutex_t* mutex);
 int ex10_mutex_unlock(ex10_mutex_t* mutex);
 int ex10_cond_signal(ex10_cond_t* mutex);
+int ex10_cond_broadcast(ex10_cond_t* cond);
 int ex10_cond_wait(ex10_cond_t* cond, ex10_mutex_t* mutex);
 int ex10_cond_timed_wait_us(ex10_cond_t*  cond,
                             ex10_mutex_t* mutex,
                             uint32_t      timeout_us);
 
+int ex10_thread_create(ex10_thread_t* thread,
+                       void* (*start_routine)(void*),
+                       void* arg);
+int ex10_thread_join(ex10_thread_t thread);
+int ex10_thread_set_attributes(ex10_thread_t                      thread,
+                               struct Ex10ThreadAttributes const* attributes);
+
+ex10_thread_t ex10_thread_self(void);
+
 int ex10_memcpy(void*       dst_ptr,
                 size_t      dst_size,
                 const void* src_ptr,
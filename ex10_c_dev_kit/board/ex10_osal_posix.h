@@ -32,6 +32,23 @@ static_assert(EX10_OSAL_TYPE == EX10_OS_TYPE_POSIX,
 
 typedef pthread_mutex_t ex10_mutex_t;
 typedef pthread_cond_t  ex10_cond_t;
+typedef pthread_t       ex10_thread_t;
+
+#ifdef __cplusplus
+#define EX10_THREAD_LOCAL thread_local
+#else
+#define EX10_THREAD_LOCAL _Thread_local
+#endif
+
+static inline int ex10_mutex_init(ex10_mutex_t* mutex)
+{
+    return pthread_mutex_init(mutex, NULL);
+}
+
+static inline int ex10_cond_init(ex10_cond_t* cond)
+{
+    return pthread_cond_init(cond, NULL);
+}
 
 static inline int ex10_mutex_lock(ex10_mutex_t* mutex)
 {
@@ -48,6 +65,11 @@ static inline int ex10_cond_signal(ex10_cond_t* cond)
     return pthread_cond_signal(cond);
 }
 
+static inline int ex10_cond_broadcast(ex10_cond_t* cond)
+{
+    return pthread_cond_broadcast(cond);
+}
+
 static inline int ex10_cond_wait(ex10_cond_t* cond, ex10_mutex_t* mutex)
 {
     return pthread_cond_wait(cond, mutex);
@@ -57,6 +79,35 @@ int ex10_cond_timed_wait_us(ex10_cond_t*  cond,
                             ex10_mutex_t* mutex,
                             uint32_t      timeout_us);
 
+static inline int ex10_thread_create(ex10_thread_t* thread,
+                                     void* (*start_routine)(void*),
+                                     void* arg)
+{
+    return pthread_create(thread, NULL, start_routine, arg);
+}
+
+static inline int ex10_thread_join(ex10_thread_t thread)
+{
+    return pthread_join(thread, NULL);
+}
+
+static inline ex10_thread_t ex10_thread_self(void)
+{
+    return pthread_self();
+}
+
+/**
+ * Apply scheduling attributes to a thread.
+ *
+ * @param thread     The thread to apply the attributes to.
+ * @param attributes The CPU affinity and SCHED_FIFO priority to apply.
+ *
+ * @return int Zero for success, or the POSIX error code of the first
+ *             attribute which could not be applied.
+ */
+int ex10_thread_set_attributes(ex10_thread_t                      thread,
+                               struct Ex10ThreadAttributes const* attributes);
+
 int ex10_memcpy(void*       dst_ptr,
                 size_t      dst_size,
                 const void* src_ptr,
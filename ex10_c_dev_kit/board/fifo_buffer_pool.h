@@ -13,9 +13,11 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stddef.h>
 
 #include "ex10_api/byte_span.h"
+#include "ex10_api/event_fifo_packet_types.h"
 #include "ex10_api/fifo_buffer_list.h"
 
 #ifdef __cplusplus
@@ -24,6 +26,16 @@ extern "C" {
 
 #define FIFO_HEADER_SPACE 4u
 
+/**
+ * Each buffer needs to be large enough to contain the full contents of
+ * the ReadFifo command (4096 bytes), plus the 1-byte result code,
+ * and maintain Fifo packet 4-byte alignment.
+ */
+#define EVENT_FIFO_BUFFER_SIZE (EX10_EVENT_FIFO_SIZE + FIFO_HEADER_SPACE)
+
+/// The number of event fifo buffers used when the pool is not configured.
+#define DEFAULT_EVENT_FIFO_BUFFER_COUNT ((size_t)8u)
+
 /**
  * Each buffer needs to be large enough to contain a single Ex10Result
  * FIFO packet, consisting of a FIFO packet header and `struct Ex10Result`
@@ -35,11 +47,59 @@ struct FifoBufferPool
 {
     struct FifoBufferNode* fifo_buffer_nodes;
     struct ByteSpan const* fifo_buffers;
-    size_t const           buffer_count;
+    /// The packet index storage, one EventPacketIndex per buffer.
+    struct EventPacketIndex* packet_indexes;
+    size_t                   buffer_count;
+    /// The number of bytes allocated for each buffer.
+    size_t buffer_size;
+    /// true if the buffers are backed by a huge page mapping.
+    bool huge_page_backed;
+};
+
+/**
+ * @struct FifoBufferPoolConfig
+ * The event fifo buffer pool allocation, passed to
+ * ex10_event_fifo_buffer_pool_configure().
+ */
+struct FifoBufferPoolConfig
+{
+    /// The number of event fifo buffers: [1 ... FIFO_BUFFER_LIST_CAPACITY].
+    size_t buffer_count;
+    /// The size of each buffer in bytes; must be >= EVENT_FIFO_BUFFER_SIZE.
+    /// The value is rounded up to a multiple of 4 bytes.
+    size_t buffer_size;
+    /// If true, all buffers are allocated from a single huge page aligned
+    /// arena. If huge pages are not reserved by the kernel, the arena is
+    /// still huge page aligned and transparent huge pages are requested.
+    bool use_huge_pages;
 };
 
 struct FifoBufferPool const* get_ex10_event_fifo_buffer_pool(void);
 
+/**
+ * Allocate the event fifo buffer pool from a single arena.
+ * This must be called prior to ex10_core_board_setup(), or after
+ * ex10_core_board_teardown(), since the buffers in the current pool are
+ * released.
+ *
+ * Without calling this function DEFAULT_EVENT_FIFO_BUFFER_COUNT buffers of
+ * EVENT_FIFO_BUFFER_SIZE bytes are used from static storage.
+ *
+ * @param config The pool allocation parameters.
+ *
+ * @return struct Ex10Result
+ *         Indicates whether the function call passed or failed.
+ */
+struct Ex10Result ex10_event_fifo_buffer_pool_configure(
+    struct FifoBufferPoolConfig const* config);
+
+/**
+ * Release the arena allocated by ex10_event_fifo_buffer_pool_configure()
+ * and revert to the default static event fifo buffer pool.
+ * This must not be called while the SDK is using the pool.
+ */
+void ex10_event_fifo_buffer_pool_release(void);
+
 struct FifoBufferPool const* get_ex10_result_buffer_pool(void);
 
 #ifdef __cplusplus
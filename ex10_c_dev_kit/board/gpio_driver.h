@@ -17,10 +17,26 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "ex10_api/gpio_interface.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @struct Ex10GpioPinMap
+ * The host GPIO pin numbers connected to an Impinj Reader Chip.
+ */
+struct Ex10GpioPinMap
+{
+    uint8_t board_power;  ///< PWR_EN, output.
+    uint8_t ready_n;      ///< READY_N, input or output.
+    uint8_t ex10_enable;  ///< ENABLE, output.
+    uint8_t reset_n;      ///< RESET_N, output.
+    uint8_t test;         ///< TEST, output driven low.
+    uint8_t irq_n;        ///< IRQ_N, input.
+};
+
 /**
  * @struct Ex10GpioDriver
  * The Ex10 GPIO driver interface.
@@ -229,6 +245,25 @@ struct Ex10GpioDriver
      */
     int32_t (*busy_wait_ready_n)(uint32_t timeout_ms);
 
+    /**
+     * Select the method used by busy_wait_ready_n() to wait for the READY_N
+     * line to assert low.
+     *
+     * @param mode    The READY_N wait method. @see enum ReadyNWaitMode.
+     * @param spin_us When mode is ReadyNWaitModeHybrid, the number of
+     *                microseconds to poll the READY_N line level before
+     *                blocking on the falling edge event.
+     *                Ignored for the other modes.
+     *
+     * @return int32_t Indicates success or failure.
+     *                 Zero for success, non-zero for failure.
+     *
+     * @note The host interface must not be locked by the caller,
+     *       i.e. irq_enable(false), when calling this function.
+     */
+    int32_t (*set_ready_n_wait_mode)(enum ReadyNWaitMode mode,
+                                     uint32_t            spin_us);
+
     /**
      * Get the state of the READY_N GPI line.
      *
@@ -318,6 +353,23 @@ struct Ex10GpioDriver
      *                LEDs reported by the led_pin_get_count() function.
      */
     void (*led_pin_toggle)(uint8_t pin_idx);
+
+    /**
+     * Set the GPIO pins connecting the selected Ex10 context to its Impinj
+     * Reader Chip. @see ex10_context_select().
+     * By default each context uses the reference design pins; when driving
+     * multiple Reader Chips, each context must be assigned its own pins.
+     *
+     * @param pin_map The pin numbers to use.
+     *
+     * @return int32_t Indicates success or failure.
+     *                 Zero for success, EINVAL if pin_map is NULL, or
+     *                 EBUSY if the context's GPIO driver is initialized.
+     *
+     * @note This must be called prior to gpio_initialize(), or after
+     *       gpio_cleanup().
+     */
+    int32_t (*set_pin_map)(struct Ex10GpioPinMap const* pin_map);
 };
 
 struct Ex10GpioDriver const* get_ex10_gpio_driver(void);
@@ -0,0 +1,1127 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#include "board/sim/ex10_sim_device.h"
+#include "ex10_api/application_registers.h"
+#include "ex10_api/bootloader_registers.h"
+#include "ex10_api/commands.h"
+#include "ex10_api/crc16.h"
+#include "ex10_api/event_fifo_packet_types.h"
+#include "ex10_api/event_packet_parser.h"
+#include "ex10_api/ex10_context.h"
+#include "ex10_api/ex10_macros.h"
+#include "ex10_api/ex10_print.h"
+#include "ex10_api/ex10_protocol.h"
+
+/// The Ex10 register address space is 16 bits wide.
+#define SIM_REGISTER_SPACE_SIZE ((size_t)0x10000u)
+
+/// The simulated command and response buffers hold the largest bootloader
+/// command; i.e. WriteInfoPage with a full info page.
+#define SIM_COMMAND_BUFFER_SIZE EX10_BOOTLOADER_MAX_COMMAND_SIZE
+
+#define SIM_MAX_EPC_LENGTH ((size_t)62u)
+
+/// The TagRead dynamic data: the PC word, EPC, StoredCRC, padding.
+#define SIM_MAX_TAG_DATA_LENGTH (SIM_MAX_EPC_LENGTH + 2u * sizeof(uint16_t))
+
+static uint32_t const ns_per_us = 1000u;
+static uint32_t const us_per_s  = 1000u * 1000u;
+
+/// The FLASH address of each info page, indexed by enum PageIds.
+static uint32_t const info_page_addresses[] = {
+    0x10010000,  // MainBlock
+    0x1ffd0000,  // FeatureControls
+    0x1ffd4000,  // Manufacturing
+    0x1ffd8000,  // Calibration
+    0x1ffdc000,  // StoredSettings
+};
+
+static char const sim_version_string[] = "Ex10 Simulator";
+
+static struct Ex10SimDeviceConfig const default_config = {
+    .tag_population       = 64u,
+    .tags_per_round       = 16u,
+    .tag_reads_per_second = 2000u,
+    .epc_length           = 12u,
+    .rssi                 = 0x0A00u,
+};
+
+struct SimDevice
+{
+    pthread_mutex_t lock;
+    pthread_cond_t  irq_n_cond;   ///< Signalled when IRQ_N asserts.
+    pthread_cond_t  worker_cond;  ///< Signalled on op start and fifo reads.
+    pthread_t       worker_pthread;
+    bool            worker_started;
+
+    bool powered;
+    bool reset_n_asserted;
+    bool ready_n_asserted;
+
+    /// Incremented each time the device boots; an inventory round in
+    /// progress is abandoned when the device is reset.
+    uint32_t    boot_count;
+    bool        running;
+    enum Status location;
+    uint64_t    boot_time_us;
+    bool        upload_active;
+
+    bool     irq_n_asserted;
+    uint32_t irq_n_edges;
+    uint32_t irq_n_edges_seen;
+
+    bool   inventory_pending;
+    bool   inventory_abort;
+    size_t next_tag_index;
+
+    struct Ex10SimDeviceConfig config;
+    struct Ex10SimDeviceStats  stats;
+
+    size_t  event_fifo_length;
+    uint8_t event_fifo[EX10_EVENT_FIFO_SIZE];
+
+    size_t  response_length;
+    uint8_t response[SIM_COMMAND_BUFFER_SIZE];
+    uint8_t command[SIM_COMMAND_BUFFER_SIZE];
+
+    uint8_t registers[SIM_REGISTER_SPACE_SIZE];
+    uint8_t info_pages[ARRAY_SIZE(info_page_addresses)][EX10_INFO_PAGE_SIZE];
+};
+
+static struct SimDevice sim_devices[EX10_MAX_CONTEXTS];
+static pthread_once_t   sim_devices_once = PTHREAD_ONCE_INIT;
+
+static void init_sim_devices(void)
+{
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+
+    for (size_t index = 0u; index < ARRAY_SIZE(sim_devices); ++index)
+    {
+        struct SimDevice* dev = &sim_devices[index];
+        pthread_mutex_init(&dev->lock, NULL);
+        pthread_cond_init(&dev->irq_n_cond, &cond_attr);
+        pthread_cond_init(&dev->worker_cond, &cond_attr);
+        dev->config = default_config;
+
+        // Unprogrammed FLASH reads as all ones.
+        memset(dev->info_pages, 0xFF, sizeof(dev->info_pages));
+    }
+
+    pthread_condattr_destroy(&cond_attr);
+}
+
+static struct SimDevice* get_sim_device(void)
+{
+    pthread_once(&sim_devices_once, init_sim_devices);
+    return &sim_devices[ex10_context_index()];
+}
+
+static uint64_t monotonic_time_us(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * us_per_s + (uint64_t)now.tv_nsec / ns_per_us;
+}
+
+static uint32_t device_time_us(struct SimDevice const* dev)
+{
+    return (uint32_t)(monotonic_time_us() - dev->boot_time_us);
+}
+
+static void set_register(struct SimDevice*          dev,
+                         struct RegisterInfo const* reg_info,
+                         void const*                data,
+                         size_t                     length)
+{
+    memcpy(&dev->registers[reg_info->address], data, length);
+}
+
+static void get_register(struct SimDevice const*    dev,
+                         struct RegisterInfo const* reg_info,
+                         void*                      data,
+                         size_t                     length)
+{
+    memcpy(data, &dev->registers[reg_info->address], length);
+}
+
+static uint32_t get_register_u32(struct SimDevice const*    dev,
+                                 struct RegisterInfo const* reg_info)
+{
+    uint32_t value = 0u;
+    get_register(dev, reg_info, &value, sizeof(value));
+    return value;
+}
+
+static void set_register_u32(struct SimDevice*          dev,
+                             struct RegisterInfo const* reg_info,
+                             uint32_t                   value)
+{
+    set_register(dev, reg_info, &value, sizeof(value));
+}
+
+/// @return uint16_t The little-endian value of a host interface command field.
+static uint16_t get_u16(uint8_t const* bytes)
+{
+    return (uint16_t)(bytes[0u] | bytes[1u] << 8u);
+}
+
+static bool range_overlaps(size_t                     address,
+                           size_t                     length,
+                           struct RegisterInfo const* reg_info)
+{
+    return (address < (size_t)reg_info->address + reg_info->length) &&
+           (reg_info->address < address + length);
+}
+
+/**
+ * Re-evaluate the IRQ_N line level; IRQ_N is asserted while any unmasked
+ * interrupt status bit is set. Waiters are woken on each falling edge.
+ */
+static void update_irq_n(struct SimDevice* dev)
+{
+    uint32_t const status = get_register_u32(dev, &interrupt_status_reg);
+    uint32_t const mask   = get_register_u32(dev, &interrupt_mask_reg);
+
+    bool const asserted = dev->running && ((status & mask) != 0u);
+    if (asserted && !dev->irq_n_asserted)
+    {
+        dev->irq_n_edges += 1u;
+        pthread_cond_broadcast(&dev->irq_n_cond);
+    }
+    dev->irq_n_asserted = asserted;
+}
+
+static struct InterruptStatusFields get_interrupt_status(
+    struct SimDevice const* dev)
+{
+    struct InterruptStatusFields irq_status;
+    get_register(dev, &interrupt_status_reg, &irq_status, sizeof(irq_status));
+    return irq_status;
+}
+
+static void set_interrupt_status(struct SimDevice*                   dev,
+                                 struct InterruptStatusFields const* irq_status)
+{
+    set_register(dev, &interrupt_status_reg, irq_status, sizeof(*irq_status));
+    update_irq_n(dev);
+}
+
+static void set_command_error(struct SimDevice* dev,
+                              enum CommandCode  command_code,
+                              enum ResponseCode response_code)
+{
+    struct CommandResultFields command_result;
+    get_register(
+        dev, &command_result_reg, &command_result, sizeof(command_result));
+    if (command_result.failed_result_code == Success)
+    {
+        command_result.failed_result_code         = response_code;
+        command_result.failed_command_code        = command_code;
+        command_result.commands_since_first_error = 0u;
+    }
+    else
+    {
+        command_result.commands_since_first_error += 1u;
+    }
+    set_register(
+        dev, &command_result_reg, &command_result, sizeof(command_result));
+
+    struct InterruptStatusFields irq_status = get_interrupt_status(dev);
+    irq_status.command_error                = true;
+    set_interrupt_status(dev, &irq_status);
+}
+
+/**
+ * Update the EventFifoNumBytes register and the EventFifo interrupts after
+ * the EventFifo contents change.
+ *
+ * @param flush If true, report any EventFifo contents regardless of the
+ *              EventFifoIntLevel threshold; used at the end of an op.
+ */
+static void update_event_fifo(struct SimDevice* dev, bool flush)
+{
+    struct EventFifoNumBytesFields const num_bytes = {
+        .num_bytes = (uint16_t)dev->event_fifo_length,
+        .rfu       = 0,
+    };
+    set_register(dev, &event_fifo_num_bytes_reg, &num_bytes, sizeof(num_bytes));
+
+    struct EventFifoIntLevelFields level;
+    get_register(dev, &event_fifo_int_level_reg, &level, sizeof(level));
+
+    if ((dev->event_fifo_length > 0u) &&
+        (flush || (dev->event_fifo_length >= level.threshold)))
+    {
+        struct InterruptStatusFields irq_status = get_interrupt_status(dev);
+        irq_status.event_fifo_above_thresh      = true;
+        set_interrupt_status(dev, &irq_status);
+    }
+}
+
+static bool push_event_fifo(struct SimDevice* dev,
+                            void const*       data,
+                            size_t            length)
+{
+    if (length > EX10_EVENT_FIFO_SIZE - dev->event_fifo_length)
+    {
+        return false;
+    }
+    if (length > 0u)
+    {
+        memcpy(&dev->event_fifo[dev->event_fifo_length], data, length);
+        dev->event_fifo_length += length;
+    }
+    return true;
+}
+
+static size_t packet_length_bytes(size_t static_length, size_t dynamic_length)
+{
+    size_t const length =
+        sizeof(struct PacketHeader) + static_length + dynamic_length;
+    return (length + sizeof(uint32_t) - 1u) & ~(sizeof(uint32_t) - 1u);
+}
+
+/**
+ * Place an EventFifo packet into the EventFifo. The packet is padded to a
+ * multiple of 32-bits; the caller must have ensured there is room for it.
+ */
+static void push_event_packet(struct SimDevice*    dev,
+                              enum EventPacketType packet_type,
+                              void const*          static_data,
+                              size_t               static_length,
+                              void const*          dynamic_data,
+                              size_t               dynamic_length)
+{
+    size_t const packet_bytes =
+        packet_length_bytes(static_length, dynamic_length);
+
+    struct PacketHeader header =
+        get_ex10_event_parser()->make_packet_header(packet_type);
+    header.packet_length = (uint8_t)(packet_bytes / sizeof(uint32_t));
+    header.us_counter    = device_time_us(dev);
+
+    uint8_t const padding[sizeof(uint32_t)] = {0u};
+    size_t const  padding_length =
+        packet_bytes - sizeof(header) - static_length - dynamic_length;
+
+    push_event_fifo(dev, &header, sizeof(header));
+    push_event_fifo(dev, static_data, static_length);
+    push_event_fifo(dev, dynamic_data, dynamic_length);
+    push_event_fifo(dev, padding, padding_length);
+    update_event_fifo(dev, false);
+}
+
+static void complete_op(struct SimDevice* dev, enum OpsStatus error)
+{
+    struct OpsStatusFields ops_status;
+    get_register(dev, &ops_status_reg, &ops_status, sizeof(ops_status));
+    enum OpId const op_id = ops_status.op_id;
+
+    ops_status.busy  = false;
+    ops_status.error = error;
+    set_register(dev, &ops_status_reg, &ops_status, sizeof(ops_status));
+
+    struct OpsControlFields const ops_control = {.op_id = Idle};
+    set_register(dev, &ops_control_reg, &ops_control, sizeof(ops_control));
+
+    struct InterruptStatusFields irq_status = get_interrupt_status(dev);
+    irq_status.op_done                      = true;
+    irq_status.inventory_round_done |= (op_id == StartInventoryRoundOp);
+    irq_status.aggregate_op_done |= (op_id == AggregateOp);
+    set_interrupt_status(dev, &irq_status);
+
+    // The device reports the EventFifo contents at the end of each op.
+    update_event_fifo(dev, true);
+}
+
+static void start_op(struct SimDevice* dev, enum OpId op_id)
+{
+    struct OpsStatusFields ops_status;
+    get_register(dev, &ops_status_reg, &ops_status, sizeof(ops_status));
+
+    if (op_id == Idle)
+    {
+        // Writing Idle to the OpsControl register stops the running op.
+        if (ops_status.busy && ops_status.op_id == StartInventoryRoundOp)
+        {
+            dev->inventory_abort = true;
+            pthread_cond_broadcast(&dev->worker_cond);
+        }
+        return;
+    }
+
+    if (ops_status.busy)
+    {
+        // The Ex10 ignores an op started while another op is running.
+        return;
+    }
+
+    ops_status.op_id = op_id;
+    ops_status.busy  = true;
+    ops_status.error = ErrorNone;
+    set_register(dev, &ops_status_reg, &ops_status, sizeof(ops_status));
+
+    uint8_t cw_is_on = 0u;
+    get_register(dev, &cw_is_on_reg, &cw_is_on, sizeof(cw_is_on));
+
+    switch (op_id)
+    {
+        case StartInventoryRoundOp:
+            // The inventory round completes on the device worker thread.
+            dev->inventory_pending = true;
+            dev->inventory_abort   = false;
+            pthread_cond_broadcast(&dev->worker_cond);
+            return;
+        case TxRampUpOp:
+            cw_is_on = 1u;
+            break;
+        case TxRampDownOp:
+            cw_is_on = 0u;
+            break;
+        default:
+            break;
+    }
+
+    set_register(dev, &cw_is_on_reg, &cw_is_on, sizeof(cw_is_on));
+    complete_op(dev, ErrorNone);
+}
+
+/**
+ * Wait for room in the EventFifo.
+ *
+ * @return bool true if the packet can be placed in the EventFifo,
+ *              false if the device was reset or the round was stopped.
+ */
+static bool wait_event_fifo_space(struct SimDevice* dev,
+                                  size_t            packet_bytes,
+                                  uint32_t          boot_count)
+{
+    bool stalled = false;
+    while ((dev->boot_count == boot_count) && !dev->inventory_abort &&
+           (packet_bytes > EX10_EVENT_FIFO_SIZE - dev->event_fifo_length))
+    {
+        if (!stalled)
+        {
+            stalled = true;
+            dev->stats.event_fifo_stalls += 1u;
+
+            struct InterruptStatusFields irq_status = get_interrupt_status(dev);
+            irq_status.event_fifo_full              = true;
+            set_interrupt_status(dev, &irq_status);
+        }
+        pthread_cond_wait(&dev->worker_cond, &dev->lock);
+    }
+    return (dev->boot_count == boot_count) && !dev->inventory_abort;
+}
+
+static size_t make_tag_data(struct SimDevice*                 dev,
+                            struct Ex10SimDeviceConfig const* config,
+                            uint8_t*                          tag_data)
+{
+    size_t const tag_index = dev->next_tag_index;
+    dev->next_tag_index    = (tag_index + 1u) % config->tag_population;
+
+    // The PC word, as backscattered; the upper 5 bits hold the EPC length
+    // in 16-bit words.
+    size_t const epc_words = config->epc_length / sizeof(uint16_t);
+    tag_data[0u]           = (uint8_t)(epc_words << 3u);
+    tag_data[1u]           = 0u;
+
+    // Each tag in the population has a unique EPC; the tag index is placed
+    // big-endian in the last bytes of the EPC.
+    uint8_t* epc = &tag_data[sizeof(uint16_t)];
+    memset(epc, 0, config->epc_length);
+    if (config->epc_length > 0u)
+    {
+        epc[0u] = 0x30;
+    }
+    for (size_t iter = 0u; (iter < sizeof(uint32_t)) &&
+                           (iter + 1u < config->epc_length);
+         ++iter)
+    {
+        epc[config->epc_length - 1u - iter] =
+            (uint8_t)(tag_index >> (8u * iter));
+    }
+
+    size_t const     pc_epc_length = sizeof(uint16_t) + config->epc_length;
+    uint16_t const   crc16 = ex10_compute_crc16(tag_data, pc_epc_length);
+    tag_data[pc_epc_length + 0u] = (uint8_t)(crc16 >> 8u);
+    tag_data[pc_epc_length + 1u] = (uint8_t)(crc16 >> 0u);
+
+    return pc_epc_length + sizeof(crc16);
+}
+
+/**
+ * Run a StartInventoryRoundOp: report the configured number of tags from
+ * the population, followed by the InventoryRoundSummary packet.
+ * Called with the device lock held; the lock is released while waiting.
+ */
+static void run_inventory_round(struct SimDevice* dev)
+{
+    uint32_t const                   boot_count = dev->boot_count;
+    struct Ex10SimDeviceConfig const config     = dev->config;
+    uint32_t const                   start_us   = device_time_us(dev);
+
+    uint64_t const period_ns =
+        (config.tag_reads_per_second == 0u)
+            ? 0u
+            : (uint64_t)us_per_s * ns_per_us / config.tag_reads_per_second;
+
+    struct timespec next_read;
+    clock_gettime(CLOCK_MONOTONIC, &next_read);
+
+    struct TagRead const tag_read = {
+        .rssi = config.rssi,
+        .type = TagReadTypeEpc,
+    };
+
+    uint8_t tag_data[SIM_MAX_TAG_DATA_LENGTH];
+    size_t  tag_count = 0u;
+    for (; tag_count < config.tags_per_round; ++tag_count)
+    {
+        if (period_ns != 0u)
+        {
+            uint64_t const nsec = (uint64_t)next_read.tv_nsec + period_ns;
+            next_read.tv_sec += (time_t)(nsec / (us_per_s * ns_per_us));
+            next_read.tv_nsec = (long)(nsec % (us_per_s * ns_per_us));
+
+            pthread_mutex_unlock(&dev->lock);
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_read, NULL);
+            pthread_mutex_lock(&dev->lock);
+        }
+
+        size_t const tag_data_length = make_tag_data(dev, &config, tag_data);
+        size_t const packet_bytes =
+            packet_length_bytes(sizeof(tag_read), tag_data_length);
+        if (!wait_event_fifo_space(dev, packet_bytes, boot_count))
+        {
+            break;
+        }
+
+        push_event_packet(dev,
+                          TagRead,
+                          &tag_read,
+                          sizeof(tag_read),
+                          tag_data,
+                          tag_data_length);
+        dev->stats.tag_reads += 1u;
+    }
+
+    if (dev->boot_count != boot_count)
+    {
+        // The device was reset while the round was running.
+        return;
+    }
+
+    struct InventoryRoundSummary const summary = {
+        .duration_us  = device_time_us(dev) - start_us,
+        .total_slots  = (uint32_t)tag_count,
+        .num_slots    = (uint16_t)tag_count,
+        .single_slots = (uint16_t)tag_count,
+        .reason       = (uint8_t)(dev->inventory_abort ? InventorySummaryHost
+                                                 : InventorySummaryDone),
+    };
+
+    dev->inventory_abort = false;
+    if (wait_event_fifo_space(
+            dev, packet_length_bytes(sizeof(summary), 0u), boot_count))
+    {
+        push_event_packet(
+            dev, InventoryRoundSummary, &summary, sizeof(summary), NULL, 0u);
+    }
+
+    if (dev->boot_count == boot_count)
+    {
+        dev->stats.inventory_rounds += 1u;
+        complete_op(dev, ErrorNone);
+    }
+}
+
+/**
+ * The device worker thread runs inventory rounds in the background so that
+ * the host observes the op as busy, and receives IRQ_N interrupts, as it
+ * would from the Impinj Reader Chip. The thread runs for the lifetime of the
+ * process.
+ */
+static void* device_worker(void* thread_arg)
+{
+    struct SimDevice* dev = thread_arg;
+
+    pthread_mutex_lock(&dev->lock);
+    while (true)
+    {
+        while (!dev->inventory_pending)
+        {
+            pthread_cond_wait(&dev->worker_cond, &dev->lock);
+        }
+        dev->inventory_pending = false;
+        run_inventory_round(dev);
+    }
+
+    return thread_arg;
+}
+
+static void device_boot(struct SimDevice* dev, enum Status location)
+{
+    dev->boot_count += 1u;
+    dev->running           = true;
+    dev->location          = location;
+    dev->boot_time_us      = monotonic_time_us();
+    dev->upload_active     = false;
+    dev->irq_n_asserted    = false;
+    dev->inventory_pending = false;
+    dev->inventory_abort   = false;
+    dev->event_fifo_length = 0u;
+    dev->response_length   = 0u;
+    memset(dev->registers, 0, sizeof(dev->registers));
+
+    // Wake the worker so that an inventory round in progress is abandoned.
+    pthread_cond_broadcast(&dev->worker_cond);
+
+    struct CommandResultFields const command_result = {
+        .failed_result_code = Success,
+    };
+    set_register(
+        dev, &command_result_reg, &command_result, sizeof(command_result));
+
+    struct StatusFields const status = {.status = location};
+    set_register(dev, &status_reg, &status, sizeof(status));
+
+    if (location == Bootloader)
+    {
+        struct RemainReasonFields const remain_reason = {
+            .remain_reason = dev->ready_n_asserted ? RemainReasonReadyNAsserted
+                                                   : RemainReasonNoReason,
+        };
+        set_register(
+            dev, &remain_reason_reg, &remain_reason, sizeof(remain_reason));
+
+        struct ImageValidityFields const image_validity = {
+            .image_valid_marker = true,
+        };
+        set_register(
+            dev, &image_validity_reg, &image_validity, sizeof(image_validity));
+        set_register(dev,
+                     &bootloader_version_string_reg,
+                     sim_version_string,
+                     sizeof(sim_version_string));
+        set_register_u32(dev, &bootloader_build_number_reg, 1u);
+        return;
+    }
+
+    set_register(dev,
+                 &version_string_reg,
+                 sim_version_string,
+                 sizeof(sim_version_string));
+    set_register_u32(dev, &build_number_reg, 1u);
+
+    uint8_t const product_sku[PRODUCT_SKU_REG_LENGTH] = {
+        (uint8_t)(SkuE710 >> 0u), (uint8_t)(SkuE710 >> 8u)};
+    set_register(dev, &product_sku_reg, product_sku, sizeof(product_sku));
+
+    struct OpsControlFields const ops_control = {.op_id = Idle};
+    set_register(dev, &ops_control_reg, &ops_control, sizeof(ops_control));
+
+    struct OpsStatusFields const ops_status = {.op_id = Idle};
+    set_register(dev, &ops_status_reg, &ops_status, sizeof(ops_status));
+
+    // As on the device, the first packet after a reset is HelloWorld.
+    struct HelloWorld const hello_world = {.sku = SkuE710};
+    push_event_packet(
+        dev, HelloWorld, &hello_world, sizeof(hello_world), NULL, 0u);
+
+    // The CalibrationInfo register mirrors the calibration info page.
+    set_register(dev,
+                 &calibration_info_reg,
+                 dev->info_pages[CalPageId],
+                 calibration_info_reg.length);
+
+    if (!dev->worker_started)
+    {
+        int const result = pthread_create(
+            &dev->worker_pthread, NULL, device_worker, (void*)dev);
+        if (result == 0)
+        {
+            pthread_detach(dev->worker_pthread);
+            dev->worker_started = true;
+        }
+        else
+        {
+            ex10_eprintf("pthread_create() failed: %d, %s\n",
+                         result,
+                         strerror(result));
+        }
+    }
+}
+
+static void command_read(struct SimDevice* dev, size_t command_length)
+{
+    size_t const descriptor_length = 2u * sizeof(uint16_t);
+    if ((command_length - 1u) % descriptor_length != 0u)
+    {
+        dev->response[0u] = (uint8_t)CommandMalformed;
+        return;
+    }
+
+    for (size_t offset = 1u; offset < command_length;
+         offset += descriptor_length)
+    {
+        size_t const address = get_u16(&dev->command[offset]);
+        size_t const length  = get_u16(&dev->command[offset + 2u]);
+
+        if ((address + length > SIM_REGISTER_SPACE_SIZE) ||
+            (dev->response_length + length > sizeof(dev->response)))
+        {
+            dev->response[0u] = (uint8_t)ArgumentInvalid;
+            return;
+        }
+
+        if ((dev->location == Application) &&
+            range_overlaps(address, length, &timestamp_reg))
+        {
+            set_register_u32(dev, &timestamp_reg, device_time_us(dev));
+        }
+
+        memcpy(&dev->response[dev->response_length],
+               &dev->registers[address],
+               length);
+        dev->response_length += length;
+
+        // The InterruptStatus register is cleared when read.
+        if (range_overlaps(address, length, &interrupt_status_reg))
+        {
+            set_register_u32(dev, &interrupt_status_reg, 0u);
+            update_irq_n(dev);
+        }
+    }
+}
+
+static void write_register(struct SimDevice* dev,
+                           size_t            address,
+                           uint8_t const*    data,
+                           size_t            length)
+{
+    memcpy(&dev->registers[address], data, length);
+
+    if (range_overlaps(address, length, &interrupt_mask_set_reg))
+    {
+        uint32_t const mask = get_register_u32(dev, &interrupt_mask_reg) |
+                              get_register_u32(dev, &interrupt_mask_set_reg);
+        set_register_u32(dev, &interrupt_mask_reg, mask);
+    }
+    if (range_overlaps(address, length, &interrupt_mask_clear_reg))
+    {
+        uint32_t const mask = get_register_u32(dev, &interrupt_mask_reg) &
+                              ~get_register_u32(dev, &interrupt_mask_clear_reg);
+        set_register_u32(dev, &interrupt_mask_reg, mask);
+    }
+    if (range_overlaps(address, length, &event_fifo_int_level_reg))
+    {
+        update_event_fifo(dev, false);
+    }
+    if (range_overlaps(address, length, &ops_control_reg))
+    {
+        struct OpsControlFields ops_control;
+        get_register(dev, &ops_control_reg, &ops_control, sizeof(ops_control));
+        start_op(dev, ops_control.op_id);
+    }
+    update_irq_n(dev);
+}
+
+static void command_write(struct SimDevice* dev, size_t command_length)
+{
+    size_t const descriptor_length = 2u * sizeof(uint16_t);
+    size_t       offset            = 1u;
+    while (offset < command_length)
+    {
+        if (offset + descriptor_length > command_length)
+        {
+            set_command_error(dev, CommandWrite, CommandMalformed);
+            return;
+        }
+
+        size_t const address = get_u16(&dev->command[offset]);
+        size_t const length  = get_u16(&dev->command[offset + 2u]);
+        offset += descriptor_length;
+
+        if ((offset + length > command_length) ||
+            (address + length > SIM_REGISTER_SPACE_SIZE))
+        {
+            set_command_error(dev, CommandWrite, ArgumentInvalid);
+            return;
+        }
+
+        write_register(dev, address, &dev->command[offset], length);
+        offset += length;
+    }
+}
+
+static void command_read_fifo(struct SimDevice* dev, size_t command_length)
+{
+    if ((command_length < 4u) || (dev->command[1u] != (uint8_t)EventFifo))
+    {
+        dev->response[0u] = (uint8_t)ArgumentInvalid;
+        return;
+    }
+
+    size_t const requested = get_u16(&dev->command[2u]);
+    size_t const length = (requested < dev->event_fifo_length)
+                              ? requested
+                              : dev->event_fifo_length;
+
+    memcpy(&dev->response[1u], dev->event_fifo, length);
+    dev->response_length += length;
+
+    dev->event_fifo_length -= length;
+    memmove(dev->event_fifo,
+            &dev->event_fifo[length],
+            dev->event_fifo_length);
+    dev->stats.event_fifo_bytes += length;
+
+    update_event_fifo(dev, false);
+    pthread_cond_broadcast(&dev->worker_cond);
+}
+
+static void command_test_read(struct SimDevice* dev, size_t command_length)
+{
+    if (command_length < 7u)
+    {
+        dev->response[0u] = (uint8_t)CommandMalformed;
+        return;
+    }
+
+    uint8_t const* args    = &dev->command[1u];
+    uint32_t const address = (uint32_t)args[0u] | (uint32_t)args[1u] << 8u |
+                             (uint32_t)args[2u] << 16u |
+                             (uint32_t)args[3u] << 24u;
+    size_t const   length  = get_u16(&args[4u]) * sizeof(uint32_t);
+
+    if (dev->response_length + length > sizeof(dev->response))
+    {
+        dev->response[0u] = (uint8_t)ArgumentInvalid;
+        return;
+    }
+
+    // Addresses outside of the info pages read as zero.
+    uint8_t* data = &dev->response[dev->response_length];
+    memset(data, 0, length);
+    for (size_t page = 0u; page < ARRAY_SIZE(info_page_addresses); ++page)
+    {
+        uint32_t const base = info_page_addresses[page];
+        if ((address >= base) && (address < base + EX10_INFO_PAGE_SIZE))
+        {
+            size_t const offset    = address - base;
+            size_t const available = EX10_INFO_PAGE_SIZE - offset;
+            memcpy(data,
+                   &dev->info_pages[page][offset],
+                   (length < available) ? length : available);
+        }
+    }
+    dev->response_length += length;
+}
+
+static void command_write_info_page(struct SimDevice* dev,
+                                    size_t            command_length)
+{
+    // Command code, page id, data, CRC-16.
+    size_t const overhead = 2u + sizeof(uint16_t);
+    if ((command_length < overhead) ||
+        (command_length - overhead > EX10_INFO_PAGE_SIZE))
+    {
+        dev->response[0u] = (uint8_t)LengthInvalid;
+        return;
+    }
+
+    uint8_t const  page_id = dev->command[1u];
+    uint8_t const* data    = &dev->command[2u];
+    size_t const   length  = command_length - overhead;
+    uint16_t const crc16   = get_u16(&data[length]);
+
+    if ((dev->location != Bootloader) ||
+        (page_id >= ARRAY_SIZE(info_page_addresses)))
+    {
+        dev->response[0u] = (uint8_t)FlashInvalidPage;
+        return;
+    }
+    if ((length > 0u) && (crc16 != ex10_compute_crc16(data, length)))
+    {
+        dev->response[0u] = (uint8_t)BadCrc;
+        return;
+    }
+
+    // A zero length write erases the page.
+    memset(dev->info_pages[page_id], 0xFF, EX10_INFO_PAGE_SIZE);
+    memcpy(dev->info_pages[page_id], data, length);
+}
+
+static void command_insert_fifo_event(struct SimDevice* dev,
+                                      size_t            command_length)
+{
+    if (command_length < 2u)
+    {
+        set_command_error(dev, CommandInsertFifoEvent, CommandMalformed);
+        return;
+    }
+
+    bool const   trigger_irq = (dev->command[1u] != 0u);
+    size_t const length      = command_length - 2u;
+    if (!push_event_fifo(dev, &dev->command[2u], length))
+    {
+        set_command_error(dev, CommandInsertFifoEvent, ResponseOverflow);
+        return;
+    }
+    update_event_fifo(dev, trigger_irq);
+}
+
+/**
+ * Decode and execute the host interface command in dev->command.
+ * The response code is placed in the first byte of the response.
+ */
+static void process_command(struct SimDevice* dev, size_t command_length)
+{
+    dev->stats.commands += 1u;
+    dev->response[0u]    = (uint8_t)Success;
+    dev->response_length = 1u;
+
+    enum CommandCode const command_code = (enum CommandCode)dev->command[0u];
+    switch (command_code)
+    {
+        case CommandRead:
+            command_read(dev, command_length);
+            break;
+        case CommandWrite:
+            command_write(dev, command_length);
+            break;
+        case CommandReadFifo:
+            command_read_fifo(dev, command_length);
+            break;
+        case CommandStartUpload:
+            dev->upload_active = (dev->location == Bootloader);
+            if (!dev->upload_active)
+            {
+                set_command_error(dev, command_code, UploadStateInvalid);
+            }
+            break;
+        case CommandContinueUpload:
+        case CommandCompleteUpload:
+            // The image contents are accepted and discarded.
+            if (!dev->upload_active)
+            {
+                set_command_error(dev, command_code, UploadStateInvalid);
+            }
+            dev->upload_active = (command_code == CommandContinueUpload) &&
+                                 dev->upload_active;
+            break;
+        case CommandReValidateMainImage:
+            break;
+        case CommandReset:
+        {
+            bool const to_bootloader = (command_length > 1u) &&
+                                       (dev->command[1u] == Bootloader);
+            device_boot(dev, to_bootloader ? Bootloader : Application);
+            break;
+        }
+        case CommandTestTransfer:
+            for (size_t iter = 1u; iter < command_length; ++iter)
+            {
+                dev->response[iter] = (uint8_t)(dev->command[iter] + iter - 1u);
+            }
+            dev->response_length = command_length;
+            break;
+        case CommandWriteInfoPage:
+            command_write_info_page(dev, command_length);
+            break;
+        case CommandTestRead:
+            command_test_read(dev, command_length);
+            break;
+        case CommandInsertFifoEvent:
+            command_insert_fifo_event(dev, command_length);
+            break;
+        default:
+            dev->response[0u] = (uint8_t)CommandInvalid;
+            set_command_error(dev, command_code, CommandInvalid);
+            break;
+    }
+}
+
+static int32_t set_config(struct Ex10SimDeviceConfig const* config)
+{
+    if ((config == NULL) || (config->epc_length > SIM_MAX_EPC_LENGTH) ||
+        (config->epc_length % sizeof(uint16_t) != 0u) ||
+        (config->tag_population == 0u))
+    {
+        return EINVAL;
+    }
+
+    struct SimDevice* dev = get_sim_device();
+    pthread_mutex_lock(&dev->lock);
+    dev->config         = *config;
+    dev->next_tag_index = 0u;
+    pthread_mutex_unlock(&dev->lock);
+    return 0;
+}
+
+static struct Ex10SimDeviceConfig get_config(void)
+{
+    struct SimDevice* dev = get_sim_device();
+    pthread_mutex_lock(&dev->lock);
+    struct Ex10SimDeviceConfig const config = dev->config;
+    pthread_mutex_unlock(&dev->lock);
+    return config;
+}
+
+static struct Ex10SimDeviceStats get_stats(void)
+{
+    struct SimDevice* dev = get_sim_device();
+    pthread_mutex_lock(&dev->lock);
+    struct Ex10SimDeviceStats const stats = dev->stats;
+    pthread_mutex_unlock(&dev->lock);
+    return stats;
+}
+
+static void set_pins(bool powered, bool reset_n_asserted, bool ready_n_asserted)
+{
+    struct SimDevice* dev = get_sim_device();
+    pthread_mutex_lock(&dev->lock);
+
+    bool const was_active = dev->powered && !dev->reset_n_asserted;
+    bool const is_active  = powered && !reset_n_asserted;
+
+    dev->powered          = powered;
+    dev->reset_n_asserted = reset_n_asserted;
+    dev->ready_n_asserted = ready_n_asserted;
+
+    if (is_active && !was_active)
+    {
+        memset(&dev->stats, 0, sizeof(dev->stats));
+        device_boot(dev, ready_n_asserted ? Bootloader : Application);
+    }
+    else if (!is_active && was_active)
+    {
+        dev->running = false;
+        dev->boot_count += 1u;
+        pthread_cond_broadcast(&dev->worker_cond);
+        update_irq_n(dev);
+    }
+
+    pthread_mutex_unlock(&dev->lock);
+}
+
+static int32_t host_write(struct ConstByteSpan const* segments,
+                          size_t                      segment_count)
+{
+    struct SimDevice* dev = get_sim_device();
+    pthread_mutex_lock(&dev->lock);
+
+    size_t command_length = 0u;
+    for (size_t iter = 0u; iter < segment_count; ++iter)
+    {
+        if (segments[iter].length > sizeof(dev->command) - command_length)
+        {
+            pthread_mutex_unlock(&dev->lock);
+            return -1;
+        }
+        memcpy(&dev->command[command_length],
+               segments[iter].data,
+               segments[iter].length);
+        command_length += segments[iter].length;
+    }
+
+    if (!dev->running || command_length == 0u)
+    {
+        pthread_mutex_unlock(&dev->lock);
+        return -1;
+    }
+
+    process_command(dev, command_length);
+
+    pthread_mutex_unlock(&dev->lock);
+    return (int32_t)command_length;
+}
+
+static int32_t host_read(struct ByteSpan const* segments, size_t segment_count)
+{
+    struct SimDevice* dev = get_sim_device();
+    pthread_mutex_lock(&dev->lock);
+
+    if (!dev->running)
+    {
+        pthread_mutex_unlock(&dev->lock);
+        return -1;
+    }
+
+    size_t offset = 0u;
+    for (size_t iter = 0u; iter < segment_count; ++iter)
+    {
+        uint8_t* data = segments[iter].data;
+        for (size_t index = 0u; index < segments[iter].length; ++index)
+        {
+            data[index] = (offset < dev->response_length)
+                              ? dev->response[offset]
+                              : 0u;
+            offset += 1u;
+        }
+    }
+    dev->response_length = 0u;
+
+    pthread_mutex_unlock(&dev->lock);
+    return (int32_t)offset;
+}
+
+static bool wait_irq_n(uint32_t timeout_ms)
+{
+    struct SimDevice* dev = get_sim_device();
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    uint64_t const nsec =
+        (uint64_t)deadline.tv_nsec + (uint64_t)timeout_ms * us_per_s;
+    deadline.tv_sec += (time_t)(nsec / (us_per_s * ns_per_us));
+    deadline.tv_nsec = (long)(nsec % (us_per_s * ns_per_us));
+
+    pthread_mutex_lock(&dev->lock);
+    int result = 0;
+    while ((dev->irq_n_edges == dev->irq_n_edges_seen) && (result == 0))
+    {
+        result =
+            pthread_cond_timedwait(&dev->irq_n_cond, &dev->lock, &deadline);
+    }
+    bool const asserted    = (dev->irq_n_edges != dev->irq_n_edges_seen);
+    dev->irq_n_edges_seen = dev->irq_n_edges;
+    pthread_mutex_unlock(&dev->lock);
+
+    return asserted;
+}
+
+static struct Ex10SimDevice const ex10_sim_device = {
+    .set_config = set_config,
+    .get_config = get_config,
+    .get_stats  = get_stats,
+    .set_pins   = set_pins,
+    .write      = host_write,
+    .read       = host_read,
+    .wait_irq_n = wait_irq_n,
+};
+
+struct Ex10SimDevice const* get_ex10_sim_device(void)
+{
+    return &ex10_sim_device;
+}
@@ -0,0 +1,150 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ex10_api/byte_span.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct Ex10SimDeviceConfig
+ * The tag population presented to the simulated Impinj Reader Chip and the
+ * rate at which its inventory rounds report tags.
+ */
+struct Ex10SimDeviceConfig
+{
+    /// The number of distinct tags in the field. TagRead packets cycle
+    /// through the population, each tag having a unique EPC.
+    size_t tag_population;
+
+    /// The number of TagRead packets reported by each inventory round.
+    size_t tags_per_round;
+
+    /// The rate at which TagRead packets are placed into the EventFifo.
+    /// When zero, tags are reported as fast as the host drains the EventFifo.
+    uint32_t tag_reads_per_second;
+
+    /// The EPC length in bytes; must be an even number, at most 62.
+    size_t epc_length;
+
+    /// The raw RSSI value reported in each TagRead packet.
+    uint16_t rssi;
+};
+
+/**
+ * @struct Ex10SimDeviceStats
+ * Counters accumulated by the simulated device since it was last powered up.
+ */
+struct Ex10SimDeviceStats
+{
+    uint64_t commands;           ///< Host interface commands processed.
+    uint64_t tag_reads;          ///< TagRead packets placed in the EventFifo.
+    uint64_t inventory_rounds;   ///< Completed inventory rounds.
+    uint64_t event_fifo_bytes;   ///< EventFifo bytes read by the host.
+    uint64_t event_fifo_stalls;  ///< Times a round waited on a full EventFifo.
+};
+
+/**
+ * @struct Ex10SimDevice
+ * A software model of the Impinj Reader Chip used by the sim board target.
+ *
+ * The model decodes the host interface command protocol (Read, Write,
+ * ReadFifo, InsertFifoEvent, image upload and info page commands) against an
+ * emulated register map, and generates TagRead and InventoryRoundSummary
+ * EventFifo packets when the StartInventoryRoundOp is run. All other ops
+ * complete immediately; the contents of an AggregateOp are not executed.
+ *
+ * Each Ex10 context drives its own simulated device. @see
+ * ex10_context_select().
+ */
+struct Ex10SimDevice
+{
+    /**
+     * Set the tag population and tag reporting rate of the selected
+     * context's device. The configuration takes effect at the start of the
+     * next inventory round.
+     *
+     * @param config The device configuration.
+     *
+     * @return int32_t Zero for success, EINVAL if config is NULL or
+     *                 contains an invalid EPC length.
+     */
+    int32_t (*set_config)(struct Ex10SimDeviceConfig const* config);
+
+    /** @return The configuration of the selected context's device. */
+    struct Ex10SimDeviceConfig (*get_config)(void);
+
+    /** @return The counters of the selected context's device. */
+    struct Ex10SimDeviceStats (*get_stats)(void);
+
+    /**
+     * Update the Reader Chip input pin levels driven by the GPIO driver.
+     * The device boots when it becomes powered, enabled and out of reset;
+     * into the bootloader if READY_N is held low, else into the application.
+     *
+     * @param powered          The PWR_EN and ENABLE lines are both high.
+     * @param reset_n_asserted The RESET_N line is driven low.
+     * @param ready_n_asserted The READY_N line is driven low by the host.
+     */
+    void (*set_pins)(bool powered,
+                     bool reset_n_asserted,
+                     bool ready_n_asserted);
+
+    /**
+     * Write a host interface command to the device.
+     *
+     * @param segments      The command bytes, concatenated in order.
+     * @param segment_count The number of segments.
+     *
+     * @return int32_t The number of bytes written, or -1 if the device is
+     *                 not running or the command is too long.
+     */
+    int32_t (*write)(struct ConstByteSpan const* segments,
+                     size_t                      segment_count);
+
+    /**
+     * Read the response to the last command written to the device.
+     * Bytes requested beyond the end of the response read as zero.
+     *
+     * @param segments      The buffers to fill, in order.
+     * @param segment_count The number of segments.
+     *
+     * @return int32_t The number of bytes read, or -1 if the device is
+     *                 not running.
+     */
+    int32_t (*read)(struct ByteSpan const* segments, size_t segment_count);
+
+    /**
+     * Wait for the device to assert its IRQ_N line.
+     *
+     * @param timeout_ms The maximum time to wait.
+     *
+     * @return bool true if IRQ_N asserted (a falling edge) since the previous
+     *              call, false if the wait timed out.
+     */
+    bool (*wait_irq_n)(uint32_t timeout_ms);
+};
+
+struct Ex10SimDevice const* get_ex10_sim_device(void);
+
+#ifdef __cplusplus
+}
+#endif
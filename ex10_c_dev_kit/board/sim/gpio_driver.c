@@ -0,0 +1,494 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <errno.h>
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "board/gpio_driver.h"
+#include "board/sim/ex10_sim_device.h"
+#include "ex10_api/ex10_context.h"
+#include "ex10_api/ex10_macros.h"
+#include "ex10_api/ex10_print.h"
+
+/// The IRQ_N monitor thread checks for deregistration at this interval.
+static uint32_t const irq_n_poll_interval_ms = 100u;
+
+/// The simulated board has the same number of debug pins and LEDs as the
+/// reference design; their levels are only stored.
+static bool debug_pin_levels[3u];
+static bool led_pin_levels[4u];
+
+/**
+ * @struct GpioContext
+ * The simulated GPIO lines and IRQ_N monitor thread connecting an Ex10
+ * context to its simulated Impinj Reader Chip.
+ */
+struct GpioContext
+{
+    struct Ex10GpioPinMap pins;
+    bool                  initialized;
+
+    bool board_power;
+    bool ex10_enable;
+    bool reset_n_asserted;
+    bool ready_n_asserted;
+
+    pthread_t irq_n_monitor_pthread;
+    bool      irq_n_monitor_running;
+
+    void (*irq_n_cb)(void);
+
+    // When set to false, inhibit the IRQ_N monitor thread from calling the
+    // registered callback function pointer irq_n_cb.
+    bool irq_monitor_callback_enable_flag;
+
+    // Guards the simulated host interface from being accessed by both the
+    // client thread and the IRQ_N monitor thread at the same time.
+    pthread_mutex_t irq_lock;
+
+    // Guards the callback function pointer irq_n_cb, during registration,
+    // deregistration and callback dispatch/execution.
+    pthread_mutex_t irq_n_callback_lock;
+};
+
+static struct GpioContext     gpio_contexts[EX10_MAX_CONTEXTS];
+static struct Ex10ContextOnce gpio_contexts_once;
+
+static void init_gpio_contexts(void)
+{
+    for (size_t index = 0u; index < EX10_MAX_CONTEXTS; ++index)
+    {
+        pthread_mutex_init(&gpio_contexts[index].irq_lock, NULL);
+        pthread_mutex_init(&gpio_contexts[index].irq_n_callback_lock, NULL);
+    }
+}
+
+static struct GpioContext* get_gpio_context(void)
+{
+    ex10_context_init_once(&gpio_contexts_once, init_gpio_contexts);
+    return &gpio_contexts[ex10_context_index()];
+}
+
+/// Drive the simulated device input pins from the context line levels.
+static void update_device_pins(struct GpioContext const* gpio)
+{
+    get_ex10_sim_device()->set_pins(gpio->board_power && gpio->ex10_enable,
+                                    gpio->reset_n_asserted,
+                                    gpio->ready_n_asserted);
+}
+
+/**
+ * pthread for monitoring the simulated IRQ_N line for interrupts.
+ *
+ * @param thread_arg The index of the Ex10 context which registered the
+ *                   IRQ_N callback.
+ *
+ * @return void*     The return pointer will be the same as the pointer
+ *                   passed in.
+ */
+static void* irq_n_monitor(void* thread_arg)
+{
+    ex10_context_select((size_t)(uintptr_t)thread_arg);
+    struct GpioContext*         gpio   = get_gpio_context();
+    struct Ex10SimDevice const* device = get_ex10_sim_device();
+
+    while (__atomic_load_n(&gpio->irq_n_monitor_running, __ATOMIC_ACQUIRE))
+    {
+        if (device->wait_irq_n(irq_n_poll_interval_ms))
+        {
+            pthread_mutex_lock(&gpio->irq_n_callback_lock);
+            if (gpio->irq_n_cb && gpio->irq_monitor_callback_enable_flag)
+            {
+                (*gpio->irq_n_cb)();
+            }
+            pthread_mutex_unlock(&gpio->irq_n_callback_lock);
+        }
+    }
+
+    return thread_arg;
+}
+
+static void irq_enable(bool enable)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (enable)
+    {
+        pthread_mutex_unlock(&gpio->irq_lock);
+    }
+    else
+    {
+        pthread_mutex_lock(&gpio->irq_lock);
+    }
+}
+
+static int32_t set_board_power(bool power_on)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (!gpio->initialized)
+    {
+        return ENODEV;
+    }
+    gpio->board_power = power_on;
+    update_device_pins(gpio);
+    return 0;
+}
+
+static bool get_board_power(void)
+{
+    return get_gpio_context()->board_power;
+}
+
+static int32_t set_ex10_enable(bool enable)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (!gpio->initialized)
+    {
+        return ENODEV;
+    }
+    gpio->ex10_enable = enable;
+    update_device_pins(gpio);
+    return 0;
+}
+
+static bool get_ex10_enable(void)
+{
+    return get_gpio_context()->ex10_enable;
+}
+
+static int32_t register_irq_callback(void (*cb_func)(void))
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    int32_t result_code = 0;
+    pthread_mutex_lock(&gpio->irq_n_callback_lock);
+    if (gpio->irq_n_cb == NULL)
+    {
+        gpio->irq_n_cb = cb_func;
+
+        __atomic_store_n(&gpio->irq_n_monitor_running, true, __ATOMIC_RELEASE);
+        result_code = pthread_create(&gpio->irq_n_monitor_pthread,
+                                     NULL,
+                                     irq_n_monitor,
+                                     (void*)(uintptr_t)ex10_context_index());
+        if (result_code == 0)
+        {
+            gpio->irq_monitor_callback_enable_flag = true;
+        }
+        else
+        {
+            __atomic_store_n(
+                &gpio->irq_n_monitor_running, false, __ATOMIC_RELEASE);
+            gpio->irq_monitor_callback_enable_flag = false;
+            ex10_eprintf("pthread_create() failed: %d, %s\n",
+                         result_code,
+                         strerror(result_code));
+        }
+    }
+    else
+    {
+        ex10_eprintf("already registered\n");
+        result_code = EBUSY;
+    }
+
+    pthread_mutex_unlock(&gpio->irq_n_callback_lock);
+    return result_code;
+}
+
+static int32_t deregister_irq_callback(void)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    pthread_mutex_lock(&gpio->irq_n_callback_lock);
+    gpio->irq_monitor_callback_enable_flag = false;
+    gpio->irq_n_cb                         = NULL;
+    bool const running                     = __atomic_exchange_n(
+        &gpio->irq_n_monitor_running, false, __ATOMIC_ACQ_REL);
+    pthread_mutex_unlock(&gpio->irq_n_callback_lock);
+
+    // As with the reference design, deregistering twice is not an error
+    // worth reporting to the caller; ESRCH indicates there was no thread.
+    return running ? pthread_join(gpio->irq_n_monitor_pthread, NULL) : ESRCH;
+}
+
+static void irq_monitor_callback_enable(bool enable)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    pthread_mutex_lock(&gpio->irq_n_callback_lock);
+    gpio->irq_monitor_callback_enable_flag = enable;
+    pthread_mutex_unlock(&gpio->irq_n_callback_lock);
+}
+
+static bool irq_monitor_callback_is_enabled(void)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    pthread_mutex_lock(&gpio->irq_n_callback_lock);
+    bool const enable = gpio->irq_monitor_callback_enable_flag;
+    pthread_mutex_unlock(&gpio->irq_n_callback_lock);
+    return enable;
+}
+
+static bool thread_is_irq_monitor(void)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    pthread_t const tid_self = pthread_self();
+    return pthread_equal(tid_self, gpio->irq_n_monitor_pthread) ? true : false;
+}
+
+static int32_t gpio_initialize(bool board_power_on,
+                               bool ex10_enable,
+                               bool reset)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (ex10_enable && !board_power_on)
+    {
+        ex10_eprintf("Ex10 Line Conflict: enable on without board power");
+        return ENXIO;
+    }
+
+    gpio->initialized      = true;
+    gpio->board_power      = board_power_on;
+    gpio->ex10_enable      = ex10_enable;
+    gpio->reset_n_asserted = reset;
+    gpio->ready_n_asserted = false;
+    update_device_pins(gpio);
+    return 0;
+}
+
+static void gpio_cleanup(void)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    deregister_irq_callback();
+
+    gpio->board_power      = false;
+    gpio->ex10_enable      = false;
+    gpio->reset_n_asserted = false;
+    gpio->ready_n_asserted = false;
+    update_device_pins(gpio);
+    gpio->initialized = false;
+}
+
+static int32_t assert_ready_n(void)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    gpio->ready_n_asserted = true;
+    update_device_pins(gpio);
+    return 0;
+}
+
+static int32_t release_ready_n(void)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    gpio->ready_n_asserted = false;
+    update_device_pins(gpio);
+    return 0;
+}
+
+static int32_t assert_reset_n(void)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    gpio->reset_n_asserted = true;
+    update_device_pins(gpio);
+    return 0;
+}
+
+static int32_t deassert_reset_n(void)
+{
+    struct GpioContext* gpio = get_gpio_context();
+
+    gpio->reset_n_asserted = false;
+    update_device_pins(gpio);
+    return 0;
+}
+
+static int32_t reset_device(void)
+{
+    int32_t const result_code_1 = assert_reset_n();
+    int32_t const result_code_2 = deassert_reset_n();
+    return (result_code_1 != 0) ? result_code_1 : result_code_2;
+}
+
+/// The simulated device is always ready for the next command once it is
+/// powered, enabled and out of reset.
+static bool device_is_ready(struct GpioContext const* gpio)
+{
+    return gpio->board_power && gpio->ex10_enable && !gpio->reset_n_asserted;
+}
+
+static int32_t ready_n_pin_get(void)
+{
+    return device_is_ready(get_gpio_context()) ? 0 : 1;
+}
+
+static int32_t busy_wait_ready_n(uint32_t timeout_ms)
+{
+    if (device_is_ready(get_gpio_context()))
+    {
+        return 0;
+    }
+
+    struct timespec const timeout = {
+        .tv_sec  = (time_t)(timeout_ms / 1000u),
+        .tv_nsec = (long)(timeout_ms % 1000u) * 1000000L,
+    };
+    nanosleep(&timeout, NULL);
+
+    ex10_eprintf("timeout: %u ms expired\n", timeout_ms);
+    errno = ETIMEDOUT;
+    return ETIMEDOUT;
+}
+
+static int32_t set_ready_n_wait_mode(enum ReadyNWaitMode mode,
+                                     uint32_t            spin_us)
+{
+    (void)spin_us;
+    switch (mode)
+    {
+        case ReadyNWaitModeSpin:
+        case ReadyNWaitModeEvent:
+        case ReadyNWaitModeHybrid:
+            return 0;
+        default:
+            return EINVAL;
+    }
+}
+
+static bool get_test_pin_level(uint8_t pin_no)
+{
+    (void)pin_no;
+    return false;
+}
+
+static size_t debug_pin_get_count(void)
+{
+    return ARRAY_SIZE(debug_pin_levels);
+}
+
+static bool debug_pin_get(uint8_t pin_idx)
+{
+    return (pin_idx < ARRAY_SIZE(debug_pin_levels)) ? debug_pin_levels[pin_idx]
+                                                    : false;
+}
+
+static void debug_pin_set(uint8_t pin_idx, bool value)
+{
+    if (pin_idx < ARRAY_SIZE(debug_pin_levels))
+    {
+        debug_pin_levels[pin_idx] = value;
+    }
+}
+
+static void debug_pin_toggle(uint8_t pin_idx)
+{
+    if (pin_idx < ARRAY_SIZE(debug_pin_levels))
+    {
+        debug_pin_levels[pin_idx] = !debug_pin_levels[pin_idx];
+    }
+}
+
+static size_t led_pin_get_count(void)
+{
+    return ARRAY_SIZE(led_pin_levels);
+}
+
+static bool led_pin_get(uint8_t pin_idx)
+{
+    return (pin_idx < ARRAY_SIZE(led_pin_levels)) ? led_pin_levels[pin_idx]
+                                                  : false;
+}
+
+static void led_pin_set(uint8_t pin_idx, bool value)
+{
+    if (pin_idx < ARRAY_SIZE(led_pin_levels))
+    {
+        led_pin_levels[pin_idx] = value;
+    }
+}
+
+static void led_pin_toggle(uint8_t pin_idx)
+{
+    if (pin_idx < ARRAY_SIZE(led_pin_levels))
+    {
+        led_pin_levels[pin_idx] = !led_pin_levels[pin_idx];
+    }
+}
+
+static int32_t set_pin_map(struct Ex10GpioPinMap const* pin_map)
+{
+    if (pin_map == NULL)
+    {
+        return EINVAL;
+    }
+
+    struct GpioContext* gpio = get_gpio_context();
+
+    if (gpio->initialized)
+    {
+        return EBUSY;
+    }
+
+    gpio->pins = *pin_map;
+    return 0;
+}
+
+static struct Ex10GpioDriver const ex10_gpio_driver = {
+    .gpio_initialize                 = gpio_initialize,
+    .gpio_cleanup                    = gpio_cleanup,
+    .set_board_power                 = set_board_power,
+    .get_board_power                 = get_board_power,
+    .set_ex10_enable                 = set_ex10_enable,
+    .get_ex10_enable                 = get_ex10_enable,
+    .register_irq_callback           = register_irq_callback,
+    .deregister_irq_callback         = deregister_irq_callback,
+    .irq_monitor_callback_enable     = irq_monitor_callback_enable,
+    .irq_monitor_callback_is_enabled = irq_monitor_callback_is_enabled,
+    .irq_enable                      = irq_enable,
+    .thread_is_irq_monitor           = thread_is_irq_monitor,
+    .assert_reset_n                  = assert_reset_n,
+    .deassert_reset_n                = deassert_reset_n,
+    .release_ready_n                 = release_ready_n,
+    .assert_ready_n                  = assert_ready_n,
+    .reset_device                    = reset_device,
+    .busy_wait_ready_n               = busy_wait_ready_n,
+    .ready_n_pin_get                 = ready_n_pin_get,
+    .set_ready_n_wait_mode           = set_ready_n_wait_mode,
+    .get_test_pin_level              = get_test_pin_level,
+    .debug_pin_get_count             = debug_pin_get_count,
+    .debug_pin_get                   = debug_pin_get,
+    .debug_pin_set                   = debug_pin_set,
+    .debug_pin_toggle                = debug_pin_toggle,
+    .led_pin_get_count               = led_pin_get_count,
+    .led_pin_get                     = led_pin_get,
+    .led_pin_set                     = led_pin_set,
+    .led_pin_toggle                  = led_pin_toggle,
+    .set_pin_map                     = set_pin_map,
+};
+
+struct Ex10GpioDriver const* get_ex10_gpio_driver(void)
+{
+    return &ex10_gpio_driver;
+}
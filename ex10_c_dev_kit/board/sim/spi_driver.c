@@ -0,0 +1,146 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "board/sim/ex10_sim_device.h"
+#include "board/spi_driver.h"
+#include "ex10_api/ex10_context.h"
+
+/**
+ * @struct SpiParameters
+ * The simulated SPI connection of an Ex10 context. The device path is only
+ * recorded so that spi_set_device() behaves as it does on the reference
+ * design; every context is connected to its own simulated device.
+ */
+struct SpiParameters
+{
+    bool        is_open;
+    char const* device_path;
+};
+
+static struct SpiParameters spi_contexts[EX10_MAX_CONTEXTS] = {
+    {false, "sim0"},
+    {false, "sim1"},
+    {false, "sim2"},
+    {false, "sim3"},
+};
+
+static struct SpiParameters* get_spi_parameters(void)
+{
+    return &spi_contexts[ex10_context_index()];
+}
+
+static int32_t spi_set_device(char const* device_path)
+{
+    struct SpiParameters* spi = get_spi_parameters();
+
+    if (device_path == NULL)
+    {
+        return -EINVAL;
+    }
+    if (spi->is_open)
+    {
+        return -EBUSY;
+    }
+    spi->device_path = device_path;
+    return 0;
+}
+
+static int32_t spi_open(uint32_t clock_freq_hz)
+{
+    (void)clock_freq_hz;
+    get_spi_parameters()->is_open = true;
+    return 0;
+}
+
+static void spi_close(void)
+{
+    get_spi_parameters()->is_open = false;
+}
+
+static int32_t spi_write_segments(struct ConstByteSpan const* segments,
+                                  size_t                      segment_count)
+{
+    if ((get_spi_parameters()->is_open == false) || (segments == NULL) ||
+        (segment_count == 0u) || (segment_count > EX10_SPI_MAX_SEGMENTS))
+    {
+        return -1;
+    }
+
+    for (size_t iter = 0u; iter < segment_count; ++iter)
+    {
+        if ((segments[iter].data == NULL) && (segments[iter].length > 0u))
+        {
+            return -1;
+        }
+    }
+
+    return get_ex10_sim_device()->write(segments, segment_count);
+}
+
+static int32_t spi_read_segments(struct ByteSpan const* segments,
+                                 size_t                 segment_count)
+{
+    if ((get_spi_parameters()->is_open == false) || (segments == NULL) ||
+        (segment_count == 0u) || (segment_count > EX10_SPI_MAX_SEGMENTS))
+    {
+        return -1;
+    }
+
+    for (size_t iter = 0u; iter < segment_count; ++iter)
+    {
+        if ((segments[iter].data == NULL) && (segments[iter].length > 0u))
+        {
+            return -1;
+        }
+    }
+
+    return get_ex10_sim_device()->read(segments, segment_count);
+}
+
+static int32_t spi_write(const void* tx_buff, size_t length)
+{
+    struct ConstByteSpan const segment = {
+        .data   = tx_buff,
+        .length = length,
+    };
+    return spi_write_segments(&segment, 1u);
+}
+
+static int32_t spi_read(void* rx_buff, size_t length)
+{
+    struct ByteSpan const segment = {
+        .data   = rx_buff,
+        .length = length,
+    };
+    return spi_read_segments(&segment, 1u);
+}
+
+static struct Ex10SpiDriver const ex10_spi_driver = {
+    .spi_open           = spi_open,
+    .spi_close          = spi_close,
+    .spi_write          = spi_write,
+    .spi_read           = spi_read,
+    .spi_write_segments = spi_write_segments,
+    .spi_read_segments  = spi_read_segments,
+    .spi_set_device     = spi_set_device,
+};
+
+struct Ex10SpiDriver const* get_ex10_spi_driver(void)
+{
+    return &ex10_spi_driver;
+}
@@ -16,10 +16,18 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "ex10_api/byte_span.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * The maximum number of segments which can be transferred within a single
+ * call to Ex10SpiDriver.spi_write_segments() or spi_read_segments().
+ */
+#define EX10_SPI_MAX_SEGMENTS ((size_t)8u)
+
 struct Ex10SpiDriver
 {
     int32_t (*spi_open)(uint32_t spi_speed_hz);
@@ -47,6 +55,51 @@ struct Ex10SpiDriver
      * If not all bytes are received properly, a -1 is returned.
      */
     int32_t (*spi_read)(void* rx_buff, size_t length);
+
+    /**
+     * Write a list of buffers as a single SPI transaction. The segments are
+     * clocked out back to back with the chip select held asserted, and the
+     * whole chain is submitted to the kernel in one system call.
+     *
+     * @param segments      The list of buffers to write, in order.
+     * @param segment_count The number of segments; at most
+     *                      EX10_SPI_MAX_SEGMENTS.
+     *
+     * @return The total number of bytes written across all segments.
+     *         If not all bytes are written properly, a -1 is returned.
+     */
+    int32_t (*spi_write_segments)(struct ConstByteSpan const* segments,
+                                  size_t                      segment_count);
+
+    /**
+     * Read into a list of buffers as a single SPI transaction, using dummy
+     * bytes out MOSI. The segments are filled back to back with the chip
+     * select held asserted, and the whole chain is submitted to the kernel
+     * in one system call.
+     *
+     * @param segments      The list of buffers to fill, in order.
+     * @param segment_count The number of segments; at most
+     *                      EX10_SPI_MAX_SEGMENTS.
+     *
+     * @return The total number of bytes read across all segments.
+     *         If not all bytes are received properly, a -1 is returned.
+     */
+    int32_t (*spi_read_segments)(struct ByteSpan const* segments,
+                                 size_t                 segment_count);
+
+    /**
+     * Set the SPI device used by the Ex10 context selected by the calling
+     * thread. This must be called before spi_open().
+     * The reference design defaults contexts 0 to 3 to /dev/spidev0.0,
+     * /dev/spidev0.1, /dev/spidev1.0 and /dev/spidev1.1.
+     *
+     * @param device_path The SPI device path; the string must remain valid
+     *                    while the device is in use.
+     *
+     * @return int32_t Zero for success, a negative errno value for failure.
+     * @retval -EBUSY  The SPI device of the context is already open.
+     */
+    int32_t (*spi_set_device)(char const* device_path);
 };
 
 struct Ex10SpiDriver const* get_ex10_spi_driver(void);
@@ -56,6 +56,24 @@ struct Ex10TimeHelpers
      *                     if > 1000ms.
      */
     void (*wait_ms)(uint32_t msec_to_wait);
+
+    /**
+     * Grabs the current time with microsecond resolution. Unlike time_now(),
+     * the value does not roll over.
+     *
+     * @return uint64_t The number of microseconds elapsed since an arbitrary
+     *                  fixed point, such as the host power up.
+     */
+    uint64_t (*time_now_us)(void);
+
+    /**
+     * Grabs the current time with nanosecond resolution, from the same clock
+     * as time_now_us().
+     *
+     * @return uint64_t The number of nanoseconds elapsed since an arbitrary
+     *                  fixed point, such as the host power up.
+     */
+    uint64_t (*time_now_ns)(void);
 };
 
 struct Ex10TimeHelpers* get_ex10_time_helpers(void);
@@ -78,6 +78,11 @@ static struct ConstByteSpan read_in_image(char const* image_file_name)
     return image;
 }
 
+static void print_upload_progress(size_t uploaded_length, size_t image_length)
+{
+    ex10_ex_printf("Uploaded %zu of %zu bytes\n", uploaded_length, image_length);
+}
+
 static int app_upload_example(struct Ex10Protocol const* protocol,
                               char const*                image_file_name)
 {
@@ -92,9 +97,18 @@ static int app_upload_example(struct Ex10Protocol const* protocol,
     // to the bootloader is needed.
     protocol->reset(Bootloader);
 
+    // The upload status is checked every 32 chunks (64 KiB) rather than after
+    // every chunk, and the progress is reported at each check.
+    struct Ex10UploadOptions const upload_options = {
+        .status_check_interval = 32u,
+        .check_image_crc16     = false,
+        .image_crc16           = 0u,
+        .progress_callback     = print_upload_progress,
+    };
+
     ex10_ex_printf("Uploading Application image...\n");
-    const struct Ex10Result ex10_result =
-        protocol->upload_image(UploadFlash, image_info);
+    const struct Ex10Result ex10_result = protocol->upload_image_pipelined(
+        UploadFlash, image_info, &upload_options);
 
     if (ex10_result.error)
     {
@@ -38,6 +38,7 @@
 
 #include "ex10_api/application_registers.h"
 #include "ex10_api/board_init.h"
+#include "ex10_api/crc16.h"
 #include "ex10_api/event_fifo_printer.h"
 #include "ex10_api/event_packet_parser.h"
 #include "ex10_api/ex10_active_region.h"
@@ -58,6 +59,8 @@ enum CalibrationCommands
 {
     FirmwareUpgrade   = '^',
     VersionNumber     = '#',
+    PowerSweep        = '@',
+    RssiSweep         = '%',
     SetAnalogRxConfig = 'a',
     StartPrbs         = 'b',
     SetTxCoarseGain   = 'c',
@@ -95,6 +98,12 @@ enum FirmwareUpgradeParam
     UpgradeComplete = 'e',
 };
 
+enum SweepSyncReply
+{
+    SweepContinue = 'c',
+    SweepStop     = 'x',
+};
+
 enum InterfaceMode
 {
     ModeNormal = 0,
@@ -429,6 +438,13 @@ static int send_help(const struct Ex10UartHelper* uart)
     uart->send("^ c <ascii_hex_chunk>             Upload firmware: continue\n");
     uart->send("^ e <checksum>                    Upload firmware: end\n");
     uart->send("#                                 Get firmware version\n");
+    uart->send(
+        "@ <settle_ms> <sync [0|1]> <freq_khz,...> <coarse atten,...>\n"
+        "                                  Sweep coarse gain, measure LO "
+        "power detectors and temperature\n");
+    uart->send(
+        "% <settle_ms> <RxGainControl,...> "
+        "Sweep Rx gains, measure RSSI\n");
     uart->send("a <RxGainControl>                 Op: SetAnalogRxConfig\n");
     uart->send("b                                 Op: StartPrbs\n");
     uart->send("c <coarse atten [0..30]>          Op: SetCoarseGain\n");
@@ -1055,6 +1071,42 @@ static int read_device_sku(const struct Ex10UartHelper* uart)
     return ReturnSuccess;
 }
 
+/**
+ * Check that the frequency is within the band of the current region, and
+ * lock the synthesizer to it.
+ */
+static int lock_synthesizer_khz(const struct Ex10UartHelper* uart,
+                                uint32_t                     req_frequency_khz)
+{
+    if ((strcmp(region, "FCC") == 0 &&
+         (req_frequency_khz < 902000 || req_frequency_khz > 928000)) ||
+        (strcmp(region, "ETSI_LOWER") == 0 &&
+         (req_frequency_khz < 865000 || req_frequency_khz > 868000)))
+    {
+        uartsend(uart, "Frequency out of band");
+        return ReturnError;
+    }
+
+    // Get synth params
+    struct SynthesizerParams synth_params = {0};
+    get_ex10_active_region()->get_synthesizer_params(req_frequency_khz,
+                                                     &synth_params);
+
+    struct Ex10Result ex10_result = get_ex10_ops()->lock_synthesizer(
+        synth_params.r_divider_index, synth_params.n_divider);
+    if (ex10_result.error)
+    {
+        parse_ex10_result(ex10_result, uart);
+        return ReturnError;
+    }
+    if (op_result(uart))
+    {
+        return ReturnError;
+    }
+
+    return ReturnSuccess;
+}
+
 /**
  * User entered 'l':
  * Parse frequency (in kHz) and lock synthesizer
@@ -1066,8 +1118,7 @@ static int lock_synthesizer(const struct Ex10UartHelper* uart, char* command)
         return ReturnError;
     }
 
-    uint32_t req_frequency_khz = 0u;
-    char*    param             = strtok(command, " ");
+    char* param = strtok(command, " ");
 
     if (param)
     {
@@ -1076,16 +1127,6 @@ static int lock_synthesizer(const struct Ex10UartHelper* uart, char* command)
             uartsend(uart, "Enter frequency in kHz");
             return ReturnError;
         }
-
-        req_frequency_khz = (uint32_t)atoi(param);
-        if ((strcmp(region, "FCC") == 0 &&
-             (req_frequency_khz < 902000 || req_frequency_khz > 928000)) ||
-            (strcmp(region, "ETSI_LOWER") == 0 &&
-             (req_frequency_khz < 865000 || req_frequency_khz > 868000)))
-        {
-            uartsend(uart, "Frequency out of band");
-            return ReturnError;
-        }
     }
     else
     {
@@ -1093,19 +1134,7 @@ static int lock_synthesizer(const struct Ex10UartHelper* uart, char* command)
         return ReturnError;
     }
 
-    // Get synth params
-    struct SynthesizerParams synth_params = {0};
-    get_ex10_active_region()->get_synthesizer_params(req_frequency_khz,
-                                                     &synth_params);
-
-    struct Ex10Result ex10_result = get_ex10_ops()->lock_synthesizer(
-        synth_params.r_divider_index, synth_params.n_divider);
-    if (ex10_result.error)
-    {
-        parse_ex10_result(ex10_result, uart);
-        return ReturnError;
-    }
-    if (op_result(uart))
+    if (lock_synthesizer_khz(uart, (uint32_t)atoi(param)) != ReturnSuccess)
     {
         return ReturnError;
     }
@@ -2517,6 +2546,393 @@ static int inventory(const struct Ex10UartHelper* uart, char* command)
     return ReturnSuccess;
 }
 
+/* Power sweep state */
+#define SWEEP_MAX_FREQUENCIES 16u
+#define SWEEP_MAX_COARSE_ATTENS 31u
+#define SWEEP_MAX_SETTLE_MS 10000u
+#define SWEEP_BLOCK_VERSION 1u
+#define SWEEP_HEADER_SIZE 4u
+#define SWEEP_RECORD_SIZE 12u
+#define SWEEP_CRC_SIZE 2u
+#define SWEEP_FLAG_STOPPED 0x01u
+#define RSSI_SWEEP_MAX_STEPS 64u
+#define RSSI_SWEEP_RECORD_SIZE 2u
+
+static uint8_t sweep_block[SWEEP_HEADER_SIZE +
+                          SWEEP_MAX_FREQUENCIES * SWEEP_MAX_COARSE_ATTENS *
+                              SWEEP_RECORD_SIZE +
+                          SWEEP_CRC_SIZE];
+
+/**
+ * Parse a comma separated list of decimal values.
+ *
+ * Return the number of values parsed, or 0 if the list is malformed, has more
+ * than max_count values, or has a value larger than max_value.
+ */
+static size_t parse_value_list(const char* param,
+                               uint32_t*   values,
+                               size_t      max_count,
+                               uint32_t    max_value)
+{
+    size_t count = 0u;
+    while (param && *param != '\0')
+    {
+        if (count == max_count || isdigit((unsigned char)*param) == false)
+        {
+            return 0u;
+        }
+
+        char* nextchar            = NULL;
+        errno                     = 0;
+        unsigned long const value = strtoul(param, &nextchar, 10);
+        if (errno != 0 || value > max_value)
+        {
+            return 0u;
+        }
+        values[count] = (uint32_t)value;
+        count++;
+
+        if (*nextchar == ',')
+        {
+            nextchar++;
+        }
+        else if (*nextchar != '\0')
+        {
+            return 0u;
+        }
+        param = nextchar;
+    }
+    return count;
+}
+
+static void put_uint16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0u] = (uint8_t)(value & 0xFFu);
+    buffer[1u] = (uint8_t)(value >> 8u);
+}
+
+/**
+ * Wait for the host to reply to a sweep sync point with a line starting with
+ * 'c' to continue the sweep. Any other reply, including ^C, stops it.
+ *
+ * Return true if the sweep should continue.
+ */
+static bool wait_for_sweep_sync(const struct Ex10UartHelper* uart)
+{
+    char reply   = '\0';
+    bool waiting = true;
+
+    while (waiting)
+    {
+        char         rx_raw_buffer[16u] = {0};
+        size_t const count =
+            uart->receive(rx_raw_buffer, sizeof(rx_raw_buffer));
+
+        for (size_t iter = 0; iter < count && waiting; iter++)
+        {
+            char const ch = rx_raw_buffer[iter];
+            if (ch == QuitWrapperAlt)
+            {
+                reply   = ch;
+                waiting = false;
+            }
+            else if (reply == '\0' && !isspace(ch))
+            {
+                reply = (char)tolower(ch);
+            }
+            else if (reply != '\0' && (ch == 0x0A || ch == 0x0D))
+            {
+                waiting = false;
+            }
+        }
+    }
+
+    return reply == SweepContinue;
+}
+
+/**
+ * Send a binary block as a single 'Result: ' line of ascii hex.
+ */
+static void send_hex_result(const struct Ex10UartHelper* uart,
+                            const uint8_t*               data,
+                            size_t                       length)
+{
+    uart->send("Result: ");
+    for (size_t offset = 0; offset < length; offset += 32u)
+    {
+        char         hex[32u * 2u + 1u] = {0};
+        size_t const chunk_length =
+            (length - offset < 32u) ? length - offset : 32u;
+        for (size_t idx = 0; idx < chunk_length; idx++)
+        {
+            sprintf(&hex[idx * 2u], "%02X", data[offset + idx]);
+        }
+        uart->send(hex);
+    }
+    uart->send("\n");
+}
+
+/**
+ * User entered '@':
+ * Parse settle time (ms), sync flag, and comma separated lists of frequencies
+ * (kHz) and coarse attenuations. For each frequency, lock the synthesizer,
+ * then for each coarse attenuation: set the coarse gain, wait for the settle
+ * time, and measure the LO power detector and temperature ADCs. This replaces
+ * three commands per calibration step with one command per sweep.
+ *
+ * If sync is 1, a 'Sync: <step> <freq_khz> <coarse atten>' line is sent after
+ * each step's measurements and the sweep waits for the host to reply, so that
+ * external instruments can be read while the step's settings are applied.
+ * The host replies 'c' to continue or 'x' to stop the sweep early, for
+ * instance when the forward power limit is exceeded.
+ *
+ * The measurements are sent as one ascii hex 'Result: ' line holding a little
+ * endian block:
+ *   uint8_t  version
+ *   uint8_t  flags (bit 0: the sweep was stopped by the host)
+ *   uint16_t step count
+ *   per step:
+ *     uint8_t  frequency index into the frequency list
+ *     uint8_t  coarse atten
+ *     uint16_t PowerLo0, PowerLo1, PowerLo2, PowerLo3 ADC codes
+ *     uint16_t Temperature ADC code
+ *   uint16_t CRC16-CCITT (initial value 0xFFFF) of the preceding bytes
+ */
+static int power_sweep(const struct Ex10UartHelper* uart, char* command)
+{
+    if (!uart || !command)
+    {
+        return ReturnError;
+    }
+
+    const char usage[] =
+        "Usage: @ <settle_ms> <sync [0|1]> <freq_khz,...> "
+        "<coarse atten [0..30],...>";
+
+    char* settle_param = strtok(command, " ");
+    char* sync_param   = strtok(NULL, " ");
+    char* freqs_param  = strtok(NULL, " ");
+    char* attens_param = strtok(NULL, " ");
+    char* extra_param  = strtok(NULL, " ");
+
+    if (!settle_param || !sync_param || !freqs_param || !attens_param ||
+        extra_param)
+    {
+        uartsend(uart, usage);
+        return ReturnError;
+    }
+
+    uint32_t settle_ms = 0u;
+    uint32_t sync      = 0u;
+    if (parse_value_list(settle_param, &settle_ms, 1u, SWEEP_MAX_SETTLE_MS) !=
+            1u ||
+        parse_value_list(sync_param, &sync, 1u, 1u) != 1u)
+    {
+        uartsend(uart, usage);
+        return ReturnError;
+    }
+
+    uint32_t freqs_khz[SWEEP_MAX_FREQUENCIES]       = {0u};
+    uint32_t coarse_attens[SWEEP_MAX_COARSE_ATTENS] = {0u};
+
+    size_t const freq_count = parse_value_list(
+        freqs_param, freqs_khz, SWEEP_MAX_FREQUENCIES, UINT32_MAX);
+    size_t const atten_count = parse_value_list(
+        attens_param, coarse_attens, SWEEP_MAX_COARSE_ATTENS, 30u);
+    if (freq_count == 0u || atten_count == 0u)
+    {
+        uartsend(uart, usage);
+        return ReturnError;
+    }
+
+    struct Ex10Ops const*     ops      = get_ex10_ops();
+    struct Ex10RfPower const* rf_power = get_ex10_rf_power();
+
+    uint8_t* record     = &sweep_block[SWEEP_HEADER_SIZE];
+    uint16_t step_count = 0u;
+    uint8_t  flags      = 0u;
+
+    for (size_t freq_idx = 0; freq_idx < freq_count; freq_idx++)
+    {
+        if (flags & SWEEP_FLAG_STOPPED)
+        {
+            break;
+        }
+        if (lock_synthesizer_khz(uart, freqs_khz[freq_idx]) != ReturnSuccess)
+        {
+            return ReturnError;
+        }
+
+        for (size_t atten_idx = 0; atten_idx < atten_count; atten_idx++)
+        {
+            uint8_t const coarse_atten = (uint8_t)coarse_attens[atten_idx];
+
+            struct Ex10Result ex10_result =
+                ops->set_tx_coarse_gain(coarse_atten);
+            if (ex10_result.error)
+            {
+                parse_ex10_result(ex10_result, uart);
+                return ReturnError;
+            }
+            if (op_result(uart))
+            {
+                return ReturnError;
+            }
+
+            get_ex10_time_helpers()->wait_ms(settle_ms);
+
+            uint16_t lo_pdet_adc[4u] = {0u};
+            uint16_t temp_adc        = 0u;
+            ex10_result              = rf_power->measure_and_read_aux_adc(
+                AdcResultPowerLo0, 4u, lo_pdet_adc);
+            if (ex10_result.error == false)
+            {
+                ex10_result =
+                    rf_power->measure_and_read_adc_temperature(&temp_adc);
+            }
+            if (ex10_result.error)
+            {
+                parse_ex10_result(ex10_result, uart);
+                return ReturnError;
+            }
+
+            record[0u] = (uint8_t)freq_idx;
+            record[1u] = coarse_atten;
+            for (size_t pdet = 0; pdet < 4u; pdet++)
+            {
+                put_uint16(&record[2u + pdet * 2u], lo_pdet_adc[pdet]);
+            }
+            put_uint16(&record[10u], temp_adc);
+            record += SWEEP_RECORD_SIZE;
+            step_count++;
+
+            if (sync)
+            {
+                char sync_str[40u] = {0};
+                snprintf(sync_str,
+                         sizeof(sync_str),
+                         "Sync: %u %u %u\n",
+                         step_count - 1u,
+                         freqs_khz[freq_idx],
+                         coarse_atten);
+                uart->send(sync_str);
+                if (wait_for_sweep_sync(uart) == false)
+                {
+                    flags |= SWEEP_FLAG_STOPPED;
+                    break;
+                }
+            }
+        }
+    }
+
+    sweep_block[0u] = SWEEP_BLOCK_VERSION;
+    sweep_block[1u] = flags;
+    put_uint16(&sweep_block[2u], step_count);
+
+    size_t const block_length = (size_t)(record - sweep_block);
+    put_uint16(record, ex10_compute_crc16(sweep_block, block_length));
+    send_hex_result(uart, sweep_block, block_length + SWEEP_CRC_SIZE);
+
+    uartsend(uart, "Done");
+    return ReturnSuccess;
+}
+
+/**
+ * User entered '%':
+ * Parse settle time (ms) and a comma separated list of decimal
+ * RxGainControl register values. For each value, run SetAnalogRxConfig, wait
+ * for the settle time, and measure the RSSI with MeasureRssiOp. This replaces
+ * two commands per RSSI calibration step with one command per sweep.
+ *
+ * The measurements are sent as one ascii hex 'Result: ' line holding a little
+ * endian block:
+ *   uint8_t  version
+ *   uint8_t  flags (always 0)
+ *   uint16_t step count
+ *   per step:
+ *     uint16_t raw RSSI, in RxGainControl list order
+ *   uint16_t CRC16-CCITT (initial value 0xFFFF) of the preceding bytes
+ */
+static int rssi_sweep(const struct Ex10UartHelper* uart, char* command)
+{
+    if (!uart || !command)
+    {
+        return ReturnError;
+    }
+
+    const char usage[] = "Usage: % <settle_ms> <RxGainControl,...>";
+
+    char* settle_param  = strtok(command, " ");
+    char* configs_param = strtok(NULL, " ");
+    char* extra_param   = strtok(NULL, " ");
+
+    if (!settle_param || !configs_param || extra_param)
+    {
+        uartsend(uart, usage);
+        return ReturnError;
+    }
+
+    uint32_t settle_ms                        = 0u;
+    uint32_t rx_configs[RSSI_SWEEP_MAX_STEPS] = {0u};
+
+    size_t const config_count = parse_value_list(
+        configs_param, rx_configs, RSSI_SWEEP_MAX_STEPS, UINT16_MAX);
+    if (parse_value_list(settle_param, &settle_ms, 1u, SWEEP_MAX_SETTLE_MS) !=
+            1u ||
+        config_count == 0u)
+    {
+        uartsend(uart, usage);
+        return ReturnError;
+    }
+
+    struct Ex10Helpers const* helpers  = get_ex10_helpers();
+    struct Ex10RfPower const* rf_power = get_ex10_rf_power();
+
+    uint8_t* record = &sweep_block[SWEEP_HEADER_SIZE];
+    for (size_t step = 0; step < config_count; step++)
+    {
+        uint16_t const             val = (uint16_t)rx_configs[step];
+        struct RxGainControlFields rx_config;
+        ex10_memcpy(&rx_config, sizeof(rx_config), &val, sizeof(val));
+
+        struct Ex10Result const ex10_result =
+            rf_power->set_analog_rx_config(&rx_config);
+        if (ex10_result.error)
+        {
+            parse_ex10_result(ex10_result, uart);
+            return ReturnError;
+        }
+        if (op_result(uart))
+        {
+            return ReturnError;
+        }
+
+        get_ex10_time_helpers()->wait_ms(settle_ms);
+
+        helpers->discard_packets(false, true, false);
+        uint16_t const rssi_result = helpers->read_rssi_value_from_op(0x0Fu);
+        if (rssi_result == 0)
+        {  /// Measure RSSI Op returned error
+            uartsend(uart, "MeasureRssiOp error");
+            return ReturnError;
+        }
+
+        put_uint16(record, rssi_result);
+        record += RSSI_SWEEP_RECORD_SIZE;
+    }
+
+    sweep_block[0u] = SWEEP_BLOCK_VERSION;
+    sweep_block[1u] = 0u;
+    put_uint16(&sweep_block[2u], (uint16_t)config_count);
+
+    size_t const block_length = (size_t)(record - sweep_block);
+    put_uint16(record, ex10_compute_crc16(sweep_block, block_length));
+    send_hex_result(uart, sweep_block, block_length + SWEEP_CRC_SIZE);
+
+    uartsend(uart, "Done");
+    return ReturnSuccess;
+}
+
 /**
  * This is the main user input capture function. It collects input characters
  * until the user hits Enter (chr(10)). Escape sequences (function keys, page
@@ -2524,6 +2940,8 @@ static int inventory(const struct Ex10UartHelper* uart, char* command)
  * Some effort has been made to handle odd terminal handling of rapid backspace
  * entry (white space is skipped when backspace is entered with typematic
  * repeat). Entering ^C or q<Enter> causes terminal to exit.
+ * The UART receive blocks until at least one character is available, so no
+ * delay is needed between reads.
  */
 static int wait_for_command(const struct Ex10UartHelper* uart,
                             char*                        rx_raw_buffer,
@@ -2607,7 +3025,6 @@ static int wait_for_command(const struct Ex10UartHelper* uart,
                 }
             }
         }
-        get_ex10_time_helpers()->wait_ms(1u);
     }
 
     return ReturnSuccess;
@@ -2641,6 +3058,14 @@ static int do_command(const struct Ex10UartHelper* uart, char* command)
                 uartsend(uart, "Firmware version");
                 result = get_firmware_version(uart, &command[1]);
                 break;
+            case PowerSweep:
+                uartsend(uart, "Power sweep");
+                result = power_sweep(uart, &command[1]);
+                break;
+            case RssiSweep:
+                uartsend(uart, "RSSI sweep");
+                result = rssi_sweep(uart, &command[1]);
+                break;
             case SetAnalogRxConfig:
                 uartsend(uart, "Set Analog RX config");
                 result = set_analog_rx_config(uart, &command[1]);
@@ -2960,6 +3385,19 @@ int main(void)
         return ReturnError;
     }
 
+    // A reader application's calibration cache is validated against the
+    // device serial number and the calibration region header only. Given
+    // its path, write_calibration_page() deletes it when the calibration
+    // page is written. The path is set after the board setup, so that the
+    // calibration used here is always read from the device.
+    char const* cal_cache_path = getenv("EX10_CAL_CACHE_PATH");
+    if (cal_cache_path != NULL &&
+        get_ex10_calibration()->set_cache_path(cal_cache_path) == false)
+    {
+        ex10_ex_eprintf("EX10_CAL_CACHE_PATH is too long\n");
+        return ReturnError;
+    }
+
     get_ex10_ramp_module_manager()->unregister_ramp_callbacks();
 
     get_ex10_protocol()->set_event_fifo_threshold(0u);
@@ -456,6 +456,16 @@ struct Ex10AggregateOpBuilder
     bool (*append_droop_compensation)(
         struct PowerDroopCompensationFields const* compensation,
         struct ByteSpan*                           agg_op_span);
+
+    /**
+     * Get the number of times the device side aggregate op buffer has been
+     * written by clear_buffer() or set_buffer(). A caller which wrote the
+     * buffer can compare this value to determine whether the buffer has
+     * been overwritten since.
+     *
+     * @return uint32_t The aggregate op buffer write count.
+     */
+    uint32_t (*get_buffer_generation)(void);
 };
 
 struct Ex10AggregateOpBuilder const* get_ex10_aggregate_op_builder(void);
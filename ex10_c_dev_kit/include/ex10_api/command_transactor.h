@@ -17,6 +17,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include "byte_span.h"
 #include "gpio_interface.h"
 #include "host_interface.h"
 
@@ -98,6 +99,53 @@ struct Ex10CommandTransactor
                                              void*       response_buffer,
                                              size_t      response_buffer_length,
                                              uint32_t    ready_n_timeout_ms);
+
+    /**
+     * Sends a command from the host to the Ex10, gathered from a list of
+     * buffers, as a single host interface transaction.
+     * Blocks until READY_N is asserted by Ex10.
+     *
+     * This behaves as send_command() does with the concatenation of the
+     * segments, but allows a command header and a payload held in separate
+     * buffers to be sent without copying them into one command buffer.
+     *
+     * @param segments           The list of command buffers, in order.
+     *                           segments[0] must begin with the command code.
+     * @param segment_count      The number of segments in the list.
+     * @param ready_n_timeout_ms The number of milliseconds to wait for the
+     *                           Ex10 READY_N line to assert low.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     *         @see send_command() for the errors reported.
+     */
+    struct Ex10Result (*send_command_segments)(
+        struct ConstByteSpan const* segments,
+        size_t                      segment_count,
+        uint32_t                    ready_n_timeout_ms);
+
+    /**
+     * Receives a response from the Ex10, scattered across a list of buffers,
+     * as a single host interface transaction.
+     * Blocks waiting for READY_N to be asserted by the Ex10.
+     *
+     * This behaves as receive_response() does with the total length of the
+     * segments, but allows the response code and the response payload to be
+     * placed in separate buffers without an intermediate copy.
+     *
+     * @param segments           The list of response buffers, in order.
+     * @param segment_count      The number of segments in the list.
+     * @param ready_n_timeout_ms The number of milliseconds to wait for the
+     *                           Ex10 READY_N line to assert low.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     *         @see receive_response() for the errors reported.
+     */
+    struct Ex10Result (*receive_response_segments)(
+        struct ByteSpan const* segments,
+        size_t                 segment_count,
+        uint32_t               ready_n_timeout_ms);
 };
 
 struct Ex10CommandTransactor const* get_ex10_command_transactor(void);
@@ -196,9 +196,9 @@ struct Ex10Commands
      *         from the device is not a Success code.
      *         Can return a host_result error if the length read back is not
      *         what was expected from the response.
-     * @note If 32-bit alignment of the event fifo messages is required then
-     *       byte_span->data[1] must be u32 aligned since data[0] will contain
-     *       the response code.
+     * @note The byte_span->data must be u32 aligned. The response code is
+     *       received separately from the event fifo data, which is placed
+     *       starting at byte_span->data[0].
      *
      * The byte_span->length should be the number of bytes obtained by reading
      * the EventFifoNumBytes register. It does not include the response code
@@ -13,7 +13,9 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "ex10_api/byte_span.h"
 #include "ex10_api/event_fifo_packet_types.h"
@@ -22,6 +24,45 @@
 extern "C" {
 #endif
 
+/**
+ * The largest number of packets an EventFifo buffer can contain; each packet
+ * contains at least a PacketHeader.
+ */
+#define EVENT_PACKET_INDEX_CAPACITY \
+    (EX10_EVENT_FIFO_SIZE / sizeof(struct PacketHeader))
+
+/// The number of distinct values of the PacketHeader packet_type field.
+#define EVENT_PACKET_TYPE_COUNT ((size_t)256u)
+
+/**
+ * @struct EventPacketIndex
+ * The packets of an EventFifo buffer, validated and indexed in one pass by
+ * Ex10EventParser.scan_event_packets().
+ */
+struct EventPacketIndex
+{
+    /// The number of packets indexed.
+    uint16_t packet_count;
+
+    /// The number of bytes indexed, not including an invalid packet.
+    /// If less than the buffer length and invalid_packet is false, the index
+    /// capacity was reached and the remaining bytes must be parsed.
+    size_t indexed_length;
+
+    /// true if indexing was stopped by an invalid packet. The invalid packet
+    /// is the last packet in the index, with the packet type InvalidPacket.
+    bool invalid_packet;
+
+    /// The byte offset of each packet header from the start of the buffer.
+    uint16_t packet_offsets[EVENT_PACKET_INDEX_CAPACITY];
+
+    /// The enum EventPacketType of each packet.
+    uint8_t packet_types[EVENT_PACKET_INDEX_CAPACITY];
+
+    /// The number of valid packets of each enum EventPacketType.
+    uint16_t type_counts[EVENT_PACKET_TYPE_COUNT];
+};
+
 struct Ex10EventParser
 {
     /**
@@ -80,6 +121,41 @@ struct Ex10EventParser
      */
     struct PacketHeader (*make_packet_header)(
         enum EventPacketType event_packet_type);
+
+    /**
+     * Validate and index all Event Fifo packets within a buffer in a single
+     * pass, counting the packets of each type. The packet headers are
+     * validated using a table indexed by packet type, equivalent to
+     * get_packet_type_valid() and get_static_payload_length().
+     *
+     * If an invalid packet is encountered, it is reported using the same
+     * diagnostics as parse_event_packet(), it is recorded as the last packet
+     * in the index with the packet type InvalidPacket and
+     * index->invalid_packet is set.
+     *
+     * @param bytes       The buffer of packets to index.
+     * @param index [out] The packet index of the buffer.
+     *
+     * @return size_t The number of packets indexed.
+     */
+    size_t (*scan_event_packets)(struct ConstByteSpan     bytes,
+                                 struct EventPacketIndex* index);
+
+    /**
+     * Get a packet of a buffer indexed by scan_event_packets(). The packet
+     * header is not validated again.
+     *
+     * @param data     The buffer which was passed to scan_event_packets().
+     * @param index    The packet index of the buffer.
+     * @param position The index of the packet: [0 ... index->packet_count).
+     *
+     * @return struct EventFifoPacket The packet. If the packet is the invalid
+     *         packet which stopped indexing, then is_valid is false.
+     */
+    struct EventFifoPacket (*get_indexed_packet)(
+        uint8_t const*                 data,
+        struct EventPacketIndex const* index,
+        size_t                         position);
 };
 
 struct Ex10EventParser const* get_ex10_event_parser(void);
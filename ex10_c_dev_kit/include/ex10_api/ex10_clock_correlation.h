@@ -0,0 +1,133 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ex10_api/event_fifo_packet_types.h"
+#include "ex10_api/ex10_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The number of most recent samples used to estimate the clock relation.
+#define EX10_CLOCK_CORRELATION_SAMPLES ((size_t)16u)
+
+/**
+ * @struct Ex10ClockCorrelationEstimate
+ * The estimated relation between the Ex10 device clock and the host clock.
+ */
+struct Ex10ClockCorrelationEstimate
+{
+    /// The number of samples used by the estimate; zero if there are none.
+    size_t sample_count;
+
+    /// The device time of the most recent sample and the host time, from
+    /// Ex10TimeHelpers.time_now_ns(), estimated for that device time.
+    uint32_t device_time_us;
+    uint64_t host_time_ns;
+
+    /// The rate of the host clock relative to the device clock, in parts per
+    /// billion. Positive if the host clock runs faster than the device clock.
+    int32_t drift_ppb;
+
+    /// The shortest duration of the timestamp register read of the samples,
+    /// as measured by the host. Half of this bounds the offset error of an
+    /// individual sample.
+    uint32_t min_round_trip_ns;
+};
+
+/**
+ * @struct Ex10ClockCorrelation
+ * Maps Ex10 device times, such as the EventFifo packet us_counter, to host
+ * time so that the packets of several readers can be placed on one time line.
+ *
+ * The device timestamp register is periodically sampled between two host
+ * clock readings. The offset and drift between the clocks are estimated by
+ * a least squares fit over the most recent samples; samples with a long
+ * register read, for example due to thread preemption, are excluded.
+ *
+ * The estimate is kept for each Ex10 context. The sampling functions access
+ * the device and must be called from the thread which controls the device;
+ * the conversion functions may be called from any thread.
+ */
+struct Ex10ClockCorrelation
+{
+    /**
+     * Discard the samples of the current Ex10 context and set the sampling
+     * interval used by sample_if_due().
+     *
+     * @param sample_interval_ms The interval between samples. A few seconds
+     *                           is sufficient to track the clock drift.
+     */
+    void (*init)(uint32_t sample_interval_ms);
+
+    /**
+     * Sample the device time against the host time and update the estimate.
+     * If the sample does not fit the estimate by more than a second, the
+     * device is assumed to have been reset and the previous samples are
+     * discarded.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     */
+    struct Ex10Result (*sample)(void);
+
+    /**
+     * Call sample() if the sampling interval has elapsed since the last
+     * sample. Intended to be called from the application packet processing
+     * loop; when no sample is due only the host clock is read.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     */
+    struct Ex10Result (*sample_if_due)(void);
+
+    /**
+     * Convert a device time to host time.
+     *
+     * @param device_time_us A device time within 35 minutes of the most
+     *                       recent sample, such as a packet us_counter.
+     *
+     * @return uint64_t The host time in ns, in the time base of
+     *                  Ex10TimeHelpers.time_now_ns(), or zero if no samples
+     *                  have been taken.
+     */
+    uint64_t (*device_to_host_ns)(uint32_t device_time_us);
+
+    /**
+     * Get the host time of an EventFifo packet.
+     *
+     * @param packet The EventFifo packet.
+     *
+     * @return uint64_t The host time in ns at which the packet us_counter was
+     *                  recorded, or zero if no samples have been taken.
+     */
+    uint64_t (*packet_host_time_ns)(struct EventFifoPacket const* packet);
+
+    /**
+     * Get the current clock estimate of the Ex10 context.
+     *
+     * @param [out] estimate The clock estimate.
+     */
+    void (*get_estimate)(struct Ex10ClockCorrelationEstimate* estimate);
+};
+
+struct Ex10ClockCorrelation const* get_ex10_clock_correlation(void);
+
+#ifdef __cplusplus
+}
+#endif
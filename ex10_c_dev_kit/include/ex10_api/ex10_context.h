@@ -0,0 +1,99 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ex10_api/ex10_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The number of Impinj Reader Chips which can be driven by one process.
+ * Each context has its own host interface, IRQ_N monitor thread,
+ * EventFifo queue and FifoBuffer pools.
+ */
+#define EX10_MAX_CONTEXTS ((size_t)4u)
+
+/**
+ * Select the Impinj Reader Chip context used by SDK calls made from the
+ * calling thread. Each thread starts with context 0 selected; the IRQ_N
+ * monitor thread of a context runs with that context selected.
+ *
+ * A typical multi-chip application dedicates a thread to each chip, which
+ * selects its context and then performs board setup and operations as for
+ * a single chip:
+ *
+ *   ex10_context_select(1u);
+ *   get_ex10_spi_driver()->spi_set_device("/dev/spidev0.1");
+ *   get_ex10_gpio_driver()->set_pin_map(&chip_1_pins);
+ *   ex10_typical_board_setup(DEFAULT_SPI_CLOCK_HZ, region);
+ *
+ * @note Each context keeps its own state in the SPI and GPIO drivers, the
+ *       host interface, commands, protocol, EventFifo queue and FifoBuffer
+ *       list and pool modules; the reader, RF power, power modes, active
+ *       region, tag table, Gen2 TX command manager, command transactor,
+ *       aggregate op buffer and error list; the ramp module manager,
+ *       antenna disconnect and listen before talk modules; the calibration,
+ *       calibration cache path and DRM status; and the continuous
+ *       inventory, inventory sequence and tag access use cases. Use cases
+ *       may run concurrently on different contexts.
+ *
+ *       Shared by all contexts are the regulatory region tables, including
+ *       custom regions passed to set_region(), the board debug lines, which
+ *       are owned by the first context to use them, and read-only defaults
+ *       and interface tables.
+ *
+ * @param context_index The context to select: [0 ... EX10_MAX_CONTEXTS).
+ *
+ * @return struct Ex10Result
+ *         Indicates whether the function call passed or failed.
+ */
+struct Ex10Result ex10_context_select(size_t context_index);
+
+/**
+ * @return size_t The context selected by the calling thread.
+ */
+size_t ex10_context_index(void);
+
+/**
+ * @struct Ex10ContextOnce
+ * Tracks the one time initialization of the per-context state of a module.
+ * Must be zero initialized, such as by static storage.
+ */
+struct Ex10ContextOnce
+{
+    uint32_t state;
+};
+
+/**
+ * Run init_contexts the first time this is called for the given once
+ * object. A module uses it to initialize the state of all of its
+ * EX10_MAX_CONTEXTS contexts at runtime, before the first use of any of
+ * them. Threads which call this while the initialization is running block
+ * until it completes.
+ *
+ * @param once          The module's initialization tracking object.
+ * @param init_contexts Initializes the state of every context.
+ */
+void ex10_context_init_once(struct Ex10ContextOnce* once,
+                            void (*init_contexts)(void));
+
+#ifdef __cplusplus
+}
+#endif
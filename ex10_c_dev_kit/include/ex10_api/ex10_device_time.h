@@ -51,6 +51,15 @@ struct Ex10DeviceTime
      * @param msec_to_wait The number of milliseconds to wait.
      */
     struct Ex10Result (*wait_ms)(uint32_t msec_to_wait);
+
+    /**
+     * Grabs the current time in us from the Ex10 Device. This is the time
+     * base of the EventFifo packet us_counter.
+     *
+     * @return uint32_t The number of microseconds elapsed since the device
+     *                  powered up. The value rolls over every 2^32 us.
+     */
+    uint32_t (*time_now_us)(void);
 };
 
 struct Ex10DeviceTime* get_ex10_device_time(void);
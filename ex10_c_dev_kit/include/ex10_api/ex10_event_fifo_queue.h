@@ -16,12 +16,73 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "ex10_api/event_fifo_packet_types.h"
 #include "ex10_api/fifo_buffer_list.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @struct EventFifoPacketBatch
+ * A range of packets of a single FifoBufferNode, referring to the packet
+ * index of the node; see Ex10EventFifoQueue.get_packet_index().
+ * The packet data is not copied; it remains in the FifoBufferNode until the
+ * batch is released with packet_batch_release().
+ */
+struct EventFifoPacketBatch
+{
+    /// The FifoBufferNode containing the packets.
+    struct FifoBufferNode const* fifo_buffer_node;
+    /// The packet index of the FifoBufferNode.
+    struct EventPacketIndex const* packet_index;
+    /// The position within packet_index of the first packet of the batch.
+    size_t first_position;
+    /// The number of packets in the batch.
+    size_t packet_count;
+};
+
+/**
+ * @return enum EventPacketType The type of the packet at the index within
+ *         the batch. An invalid packet is reported as InvalidPacket and is
+ *         always the last packet in the batch.
+ */
+static inline enum EventPacketType event_fifo_batch_packet_type(
+    struct EventFifoPacketBatch const* batch,
+    size_t                             index)
+{
+    return (enum EventPacketType)
+        batch->packet_index->packet_types[batch->first_position + index];
+}
+
+/**
+ * @return struct PacketHeader const* The header of the packet at the index
+ *         within the batch.
+ */
+static inline struct PacketHeader const* event_fifo_batch_packet_header(
+    struct EventFifoPacketBatch const* batch,
+    size_t                             index)
+{
+    size_t const   position = batch->first_position + index;
+    size_t const   offset   = batch->packet_index->packet_offsets[position];
+    uint8_t const* data     = batch->fifo_buffer_node->fifo_data.data;
+    return (struct PacketHeader const*)(data + offset);
+}
+
+/**
+ * @return union PacketData const* The static data of the packet at the index
+ *         within the batch. Only valid when the packet type is not
+ *         InvalidPacket.
+ */
+static inline union PacketData const* event_fifo_batch_static_data(
+    struct EventFifoPacketBatch const* batch,
+    size_t                             index)
+{
+    uint8_t const* header =
+        (uint8_t const*)event_fifo_batch_packet_header(batch, index);
+    return (union PacketData const*)(header + sizeof(struct PacketHeader));
+}
+
 
 struct Ex10EventFifoQueue
 {
@@ -32,8 +93,8 @@ struct Ex10EventFifoQueue
 
     /**
      * Push a FifoBufferNode onto the back of the reader.event_fifo_list.
-     * The reader list mutex is used to maintain exclusive access to the
-     * reader list.
+     * The list is a lock-free ring; the consumer is only signaled when it is
+     * blocked within packet_wait() or packet_wait_with_timeout().
      *
      * @param fifo_buffer_node A pointer to the FifoBufferNode.
      */
@@ -87,6 +148,51 @@ struct Ex10EventFifoQueue
      *       that is waiting for packets.
      */
     void (*packet_unwait)(void);
+
+    /**
+     * Get the packets at the front of the packet queue as a batch, without
+     * copying or parsing them again. The batch contains the remaining
+     * packets of the front FifoBufferNode, as indexed by
+     * list_node_push_back(); if a packet was obtained with packet_peek() and
+     * not removed, the batch starts with that packet.
+     *
+     * @param batch [out] The batch to fill. The batch is small and may be
+     *                    kept on the caller's stack.
+     *
+     * @return size_t The number of packets in the batch, zero if the packet
+     *                queue is empty.
+     *
+     * @note The batch must be released with packet_batch_release() before
+     *       the next call to packet_batch_get(), packet_peek() or
+     *       packet_remove().
+     */
+    size_t (*packet_batch_get)(struct EventFifoPacketBatch* batch);
+
+    /**
+     * Release the packets of a batch obtained from packet_batch_get().
+     * If all packets of the FifoBufferNode were contained in the batch, the
+     * node is returned to its free list. Once released, the batch packet
+     * data is invalid.
+     *
+     * @param batch The batch to release.
+     */
+    void (*packet_batch_release)(struct EventFifoPacketBatch* batch);
+
+    /**
+     * Get the packet index of a FifoBufferNode, indexing its packets with
+     * Ex10EventParser.scan_event_packets() if this has not yet been done.
+     * The index is kept in the node's packet_index storage, so that the
+     * fifo data handler and the packet queue consumer do not each parse the
+     * packets.
+     *
+     * @note list_node_push_back() indexes each node before it is queued.
+     *
+     * @param fifo_buffer_node The FifoBufferNode containing EventFifo data.
+     *
+     * @return struct EventPacketIndex const* The packet index of the node.
+     */
+    struct EventPacketIndex const* (*get_packet_index)(
+        struct FifoBufferNode* fifo_buffer_node);
 };
 
 const struct Ex10EventFifoQueue* get_ex10_event_fifo_queue(void);
@@ -0,0 +1,204 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ex10_api/fifo_buffer_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The number of buckets of an Ex10PerfHistogram.
+#define EX10_PERF_HISTOGRAM_BUCKETS ((size_t)20u)
+
+/**
+ * @struct Ex10PerfHistogram
+ * A histogram of durations with power of two microsecond buckets.
+ */
+struct Ex10PerfHistogram
+{
+    /// buckets[0] counts durations below 1 us, and buckets[n] counts
+    /// durations in [2^(n-1), 2^n) us. The last bucket also counts all
+    /// longer durations.
+    uint64_t buckets[EX10_PERF_HISTOGRAM_BUCKETS];
+
+    /// The number of durations recorded, their sum and the longest one.
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+};
+
+/**
+ * @struct Ex10PerfSnapshot
+ * The performance counters of an Ex10 context, accumulated since the last
+ * reset.
+ */
+struct Ex10PerfSnapshot
+{
+    /// The host time, from Ex10TimeHelpers.time_now_ns(), of the snapshot
+    /// and of the last reset; reset_time_ns is zero if the counters were
+    /// never reset.
+    uint64_t snapshot_time_ns;
+    uint64_t reset_time_ns;
+
+    /// The command transactor SPI transfers, and the number of bytes they
+    /// carried.
+    uint64_t spi_commands;
+    uint64_t spi_responses;
+    uint64_t spi_bytes_sent;
+    uint64_t spi_bytes_received;
+
+    /// The time spent waiting for READY_N before each SPI transfer, and the
+    /// number of waits which timed out.
+    struct Ex10PerfHistogram ready_n_wait;
+    uint64_t                 ready_n_timeouts;
+
+    /// The number of IRQ_N interrupts serviced, and the ReadFifo commands
+    /// and bytes used to drain the EventFifo.
+    uint64_t interrupts;
+    uint64_t read_fifo_count;
+    uint64_t read_fifo_bytes;
+
+    /// The occupancy of the EventFifo buffer pool.
+    struct FifoBufferListStats event_fifo_buffers;
+
+    /// The number of FifoBufferNodes in the EventFifo queue when a node was
+    /// last pushed or taken by the consumer, and the largest number pushed.
+    uint64_t queue_depth;
+    uint64_t queue_max_depth;
+
+    /// The time from a FifoBufferNode being pushed onto the EventFifo queue
+    /// to the consumer starting to parse it.
+    struct Ex10PerfHistogram queue_lag;
+
+    /// The number of Ex10RfPower.cw_on() ramps, the number of those which
+    /// used an aggregate op staged during the previous dwell, and the host
+    /// time from the start of cw_on() to CW being on.
+    uint64_t                 cw_on_count;
+    uint64_t                 cw_on_staged_count;
+    struct Ex10PerfHistogram cw_on_time;
+
+    /// The number of TxRampUp and TxRampDown packets, and the device time
+    /// from each TxRampDown to the next TxRampUp: the dead time in which
+    /// no tags can be read.
+    uint64_t                 ramp_up_count;
+    uint64_t                 ramp_down_count;
+    struct Ex10PerfHistogram dead_time;
+
+    /// The number of InventoryRoundSummary and TagRead packets.
+    uint64_t inventory_rounds;
+    uint64_t tag_reads;
+
+    /// The TagRead packets and the duration of the last inventory round,
+    /// the tag rate of that round, and the highest tag rate of any round.
+    uint64_t last_round_tag_reads;
+    uint64_t last_round_duration_us;
+    uint64_t last_round_tags_per_second;
+    uint64_t max_round_tags_per_second;
+};
+
+/**
+ * @struct Ex10PerfCounters
+ * Always-on performance counters of the SDK layers, which can be read in the
+ * field to diagnose read rate regressions without attaching a tracer.
+ *
+ * The counters are kept for each Ex10 context and updated with relaxed
+ * atomic operations, so that they may be updated by the IRQ_N monitor
+ * thread and read by any thread. Each counter is read individually:
+ * a snapshot taken during traffic is not consistent across counters.
+ *
+ * The record functions are called by the SDK layers and are not intended to
+ * be called by the application.
+ */
+struct Ex10PerfCounters
+{
+    /**
+     * Read the performance counters of the current Ex10 context.
+     *
+     * @param [out] snapshot The counters.
+     */
+    void (*get_snapshot)(struct Ex10PerfSnapshot* snapshot);
+
+    /**
+     * Reset the performance counters of the current Ex10 context, and the
+     * usage counters of its EventFifo buffer list, to zero.
+     */
+    void (*reset)(void);
+
+    /**
+     * Record an SPI command transfer.
+     *
+     * @param byte_count      The number of bytes sent.
+     * @param ready_n_wait_ns The time spent waiting for READY_N.
+     */
+    void (*record_spi_command)(size_t byte_count, uint64_t ready_n_wait_ns);
+
+    /**
+     * Record an SPI response transfer.
+     *
+     * @param byte_count      The number of bytes received.
+     * @param ready_n_wait_ns The time spent waiting for READY_N.
+     */
+    void (*record_spi_response)(size_t byte_count, uint64_t ready_n_wait_ns);
+
+    /** Record a wait for READY_N which timed out. */
+    void (*record_ready_n_timeout)(void);
+
+    /** Record a serviced IRQ_N interrupt. */
+    void (*record_interrupt)(void);
+
+    /**
+     * Record a ReadFifo command.
+     *
+     * @param byte_count The number of EventFifo bytes read.
+     */
+    void (*record_read_fifo)(size_t byte_count);
+
+    /**
+     * Record a FifoBufferNode pushed onto the EventFifo queue, and scan its
+     * indexed packets for ramps, tag reads and inventory round summaries.
+     *
+     * @param fifo_buffer The node, with its packet_index set.
+     * @param depth       The queue depth after the push.
+     */
+    void (*record_queue_push)(struct FifoBufferNode const* fifo_buffer,
+                              size_t                       depth);
+
+    /**
+     * Record the EventFifo queue consumer taking a FifoBufferNode.
+     *
+     * @param fifo_buffer The node, with its queued_time_ns set.
+     * @param depth       The queue depth, including the node.
+     */
+    void (*record_queue_pop)(struct FifoBufferNode const* fifo_buffer,
+                             size_t                       depth);
+
+    /**
+     * Record a completed Ex10RfPower.cw_on() ramp.
+     *
+     * @param duration_ns The time from the start of cw_on() to CW being on.
+     * @param staged      true if the ramp used a staged aggregate op.
+     */
+    void (*record_cw_on)(uint64_t duration_ns, bool staged);
+};
+
+struct Ex10PerfCounters const* get_ex10_perf_counters(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -17,6 +17,9 @@
 extern "C" {
 #endif
 
+// The print functions return the number of characters written, as printf()
+// does. While the asynchronous logging backend is started, the message is
+// formatted later by its formatting thread and they return 0.
 int ex10_printf_impl(const char* fmt, ...);
 int ex10_eprintf_impl(const char* func, const char* fmt, ...);
 int ex10_eputs_impl(const char* fmt, ...);
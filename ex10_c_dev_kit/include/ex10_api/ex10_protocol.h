@@ -14,6 +14,7 @@
 #pragma once
 
 #include "board/driver_list.h"
+#include "board/ex10_osal.h"
 #include "ex10_api/application_registers.h"
 #include "ex10_api/bootloader_registers.h"
 #include "ex10_api/commands.h"
@@ -68,6 +69,142 @@ struct Ex10FirmwareVersion
     uint32_t build_number;
 };
 
+/**
+ * @struct Ex10FifoPipelineConfig
+ * The scheduling attributes of each stage of the EventFifo pipeline.
+ * @see Ex10Protocol.start_fifo_pipeline()
+ */
+struct Ex10FifoPipelineConfig
+{
+    /// The IRQ_N monitor thread, which posts a wakeup to the drain thread.
+    struct Ex10ThreadAttributes irq_thread;
+
+    /// The drain thread, which reads the interrupt status and EventFifo.
+    struct Ex10ThreadAttributes drain_thread;
+
+    /// The parse thread, which runs the fifo_data_callback.
+    struct Ex10ThreadAttributes parse_thread;
+};
+
+/**
+ * @struct Ex10EventFifoThresholdConfig
+ * The bounds and targets of the adaptive EventFifo threshold controller.
+ * @see Ex10Protocol.enable_fifo_threshold_control()
+ *
+ * At the end of each window the controller doubles the threshold when the
+ * interrupt rate is above target_interrupt_rate_hz, or when more than half
+ * of the EventFifo buffers are waiting for the consumer; fewer, larger
+ * ReadFifo transfers then carry the same data. It halves the threshold when
+ * the interrupt rate is below half of the target, so that sparse tag reads
+ * are reported with low latency.
+ */
+struct Ex10EventFifoThresholdConfig
+{
+    /// The lowest threshold the controller will set, in bytes.
+    size_t min_threshold;
+
+    /// The highest threshold the controller will set, in bytes.
+    /// This must not exceed EX10_EVENT_FIFO_SIZE; leave headroom for the
+    /// EventFifo to keep filling while the host responds to the interrupt.
+    size_t max_threshold;
+
+    /// The interrupt rate above which the threshold is raised.
+    uint32_t target_interrupt_rate_hz;
+
+    /// The interval over which the interrupt rate is measured.
+    uint32_t window_ms;
+};
+
+/**
+ * @struct Ex10EventFifoThresholdStats
+ * The EventFifo threshold and the interrupt traffic observed by the
+ * Ex10Protocol. The counters are kept whether or not the adaptive threshold
+ * controller is enabled.
+ */
+struct Ex10EventFifoThresholdStats
+{
+    /// Whether the adaptive threshold controller is enabled.
+    bool enabled;
+
+    /// The current EventFifo threshold, in bytes.
+    size_t threshold;
+
+    /// The controller bounds, in bytes.
+    size_t min_threshold;
+    size_t max_threshold;
+
+    /// The interrupt rate measured over the last complete window.
+    uint32_t interrupt_rate_hz;
+
+    /// The mean ReadFifo length over the last complete window, in bytes.
+    size_t bytes_per_read;
+
+    /// The number of EventFifo buffers waiting for the consumer at the end
+    /// of the last complete window.
+    size_t queue_depth;
+
+    /// The number of interrupts serviced and ReadFifo transfers made.
+    size_t   interrupt_count;
+    size_t   read_fifo_count;
+    uint64_t read_fifo_bytes;
+
+    /// The number of times the controller raised and lowered the threshold.
+    size_t increase_count;
+    size_t decrease_count;
+
+    /// The number of decreases to min_threshold made after a window without
+    /// interrupts; these are included in decrease_count.
+    size_t idle_decrease_count;
+};
+
+/**
+ * @struct Ex10RegisterShadowStats
+ * The register shadow state and the register accesses it has served.
+ * @see Ex10Protocol.enable_register_shadow()
+ */
+struct Ex10RegisterShadowStats
+{
+    /// Whether the register shadow is enabled.
+    bool enabled;
+
+    /// The number of shadowed register reads served from the shadow, and
+    /// the number which were read from the device.
+    size_t read_hits;
+    size_t read_misses;
+
+    /// The number of shadowed register writes which were elided because the
+    /// device already held the value, and the number written to the device.
+    size_t write_hits;
+    size_t write_misses;
+
+    /// The number of times the whole shadow was invalidated.
+    size_t invalidations;
+};
+
+/**
+ * @struct Ex10UploadOptions
+ * The settings of a pipelined image upload.
+ * @see Ex10Protocol.upload_image_pipelined()
+ */
+struct Ex10UploadOptions
+{
+    /// The number of image chunks sent between reads of the CommandResult
+    /// register. Zero checks the upload status only on completion. The
+    /// CommandResult register holds the first failure until it is read, so
+    /// a failed chunk is always reported; a larger interval only delays the
+    /// report.
+    size_t status_check_interval;
+
+    /// If true, the CRC-16-CCITT of the image is computed before the upload
+    /// and must equal image_crc16; otherwise nothing is sent.
+    bool     check_image_crc16;
+    uint16_t image_crc16;
+
+    /// If not NULL, called after each status check and on completion with
+    /// the number of image bytes sent.
+    void (*progress_callback)(size_t uploaded_length, size_t image_length);
+};
+
 /**
  * @struct Ex10Protocol
  * Ex10 Protocol interface.
@@ -153,7 +290,8 @@ struct Ex10Protocol
      * Enable or disable Impinj Reader Chip interrupt processing.
      *
      * @attention Do not call this function from the IRQ_N monitor thread
-     *            context. A deadlock will occur.
+     *            context, or from the interrupt_callback when the EventFifo
+     *            pipeline is started. A deadlock will occur.
      *
      * @param enable If true, the interrupt and fifo data handlers
      *               will be called when the Impinj Reader Chip triggers the
@@ -378,6 +516,14 @@ struct Ex10Protocol
     /**
      * Block until ongoing op has completed.
      *
+     * When the IRQ_N monitor callback is enabled, the calling thread blocks
+     * until an op_done or aggregate_op_done interrupt is serviced, arming
+     * the op_done interrupt if the registered interrupt mask does not
+     * include it. The OpsStatus register is polled at an interval in case
+     * the interrupt was missed. Otherwise, and when called from the IRQ_N
+     * monitor or EventFifo pipeline drain threads, the OpsStatus register
+     * is polled continuously.
+     *
      * @param timeout_ms Function returns false if the op takes more
      *                   time than this number of milliseconds.
      *
@@ -431,6 +577,9 @@ struct Ex10Protocol
      * accumulated by the Ex10 is this threshold or higher then an interrupt
      * wil be generated.
      *
+     * @note When the adaptive threshold controller is enabled, it will
+     *       adjust this threshold at the end of its next window.
+     *
      * @param threshold The EventFifo threshold in bytes.
      *
      * @return struct Ex10Result
@@ -708,6 +857,166 @@ struct Ex10Protocol
      * @return enum ProductSku The Ex10 device product SKU.
      */
     enum ProductSku (*get_sku)(void);
+
+    /**
+     * Split Impinj Reader Chip interrupt processing across three threads.
+     *
+     * By default the IRQ_N monitor thread reads the interrupt status, reads
+     * the EventFifo and runs the fifo_data_callback before it can respond to
+     * the next interrupt; a slow fifo_data_callback delays the EventFifo
+     * reads and can result in an InventorySummaryEventFifoFull.
+     * With the pipeline started:
+     * - The IRQ_N monitor thread only posts a wakeup to the drain thread.
+     * - The drain thread reads the interrupt status, runs the
+     *   interrupt_callback and reads the EventFifo into FifoBufferNodes
+     *   taken from the free list.
+     * - The parse thread passes each FifoBufferNode, in order, to the
+     *   fifo_data_callback.
+     *
+     * @attention Do not call this function from the IRQ_N monitor thread,
+     *            or from the interrupt or fifo data callbacks.
+     *
+     * @param config The scheduling attributes of each pipeline thread.
+     *               The IRQ_N monitor thread attributes are applied when it
+     *               next handles an interrupt, and remain in effect after
+     *               the pipeline is stopped.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     *         If a thread could not be created, or its attributes could not
+     *         be applied, the 'sdk_result_code' will be set to
+     *         'Ex10SdkErrorGpioInterface' and the POSIX error code will be
+     *         passed in the 'device_status' field of the result.
+     */
+    struct Ex10Result (*start_fifo_pipeline)(
+        struct Ex10FifoPipelineConfig const* config);
+
+    /**
+     * Stop the EventFifo pipeline and return to processing interrupts
+     * within the IRQ_N monitor thread. FifoBufferNodes which were read by
+     * the drain thread are passed to the fifo_data_callback before this
+     * function returns.
+     *
+     * @attention Do not call this function from the IRQ_N monitor thread,
+     *            or from the interrupt or fifo data callbacks.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     */
+    struct Ex10Result (*stop_fifo_pipeline)(void);
+
+    /**
+     * Enable the adaptive EventFifo threshold controller. The threshold is
+     * clamped to the controller bounds and then adjusted from the interrupt
+     * traffic serviced by the IRQ_N monitor (or pipeline drain) thread.
+     *
+     * @note The controller is evaluated as interrupts are serviced. When the
+     *       EventFifo traffic stops, no interrupt arrives to lower a raised
+     *       threshold; a relax thread, started by the first call and stopped
+     *       by deinit(), lowers it to min_threshold after an idle window.
+     *       The Impinj Reader Chip then interrupts for the EventFifo bytes
+     *       held below the raised threshold.
+     *
+     * @param config The controller bounds and targets, or NULL to use the
+     *               defaults: a threshold of 0 to 3072 bytes, a target of
+     *               250 interrupts per second and a 100 ms window.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     * @retval Ex10SdkErrorBadParamValue if min_threshold > max_threshold,
+     *         max_threshold > EX10_EVENT_FIFO_SIZE, or the target rate or
+     *         window are zero.
+     */
+    struct Ex10Result (*enable_fifo_threshold_control)(
+        struct Ex10EventFifoThresholdConfig const* config);
+
+    /**
+     * Disable the adaptive EventFifo threshold controller.
+     * The threshold remains at its last value.
+     */
+    void (*disable_fifo_threshold_control)(void);
+
+    /**
+     * Get the EventFifo threshold and interrupt traffic statistics.
+     *
+     * @param [out] stats The threshold, controller bounds and counters.
+     */
+    void (*get_fifo_threshold_stats)(struct Ex10EventFifoThresholdStats* stats);
+
+    /**
+     * Enable or disable the write-through register shadow.
+     *
+     * The shadow holds the last value read from or written to each of the
+     * ReadWrite configuration registers which the host owns; for example
+     * the RfMode, RxGainControl, GPIO and Gen2 transaction registers.
+     * Reads of a shadowed register are served from the shadow, and writes
+     * which would not change a shadowed register are not sent to the device.
+     * ReadOnly registers, and the registers which the device updates while
+     * running ops, are never shadowed.
+     *
+     * The shadow is invalidated when the device is reset, when the power
+     * mode changes, when an AggregateOp is started, and when a shadowed
+     * register is modified through a partial write or a WriteOnly set or
+     * clear register.
+     *
+     * @note Register writes made by the device outside of these events are
+     *       not observed by the shadow; call invalidate_register_shadow()
+     *       after such an event.
+     *
+     * @param enable true to enable the shadow, false to disable it.
+     *               Either way, the shadow starts out empty.
+     */
+    void (*enable_register_shadow)(bool enable);
+
+    /**
+     * Discard all values held in the register shadow. The next access to
+     * each shadowed register is sent to the device.
+     */
+    void (*invalidate_register_shadow)(void);
+
+    /**
+     * Get the register shadow state and hit and miss counts.
+     *
+     * @param [out] stats The register shadow statistics.
+     */
+    void (*get_register_shadow_stats)(struct Ex10RegisterShadowStats* stats);
+
+    /**
+     * Upload an application image with the image chunks sent back to back.
+     *
+     * upload_image() reads the CommandResult register after each chunk and
+     * toggles the interrupt enable around each command. This function reads
+     * the CommandResult register only every options->status_check_interval
+     * chunks and before and after the image is flashed, and keeps the
+     * interrupt disabled between the status checks. The chunks are sent
+     * directly from the image buffer, in chunks of up to the bootloader
+     * command size rather than the SPI burst size. Each chunk is one host
+     * interface transaction, which waits for READY_N.
+     *
+     * The CommandResult register is read before the first chunk, so that a
+     * failure left by an earlier command is not reported. After an upload to
+     * UploadFlash the bootloader revalidates the flashed image, and the
+     * upload fails unless the image is then marked valid.
+     *
+     * @param destination Where in memory to upload the image.
+     * @param image       The image to upload.
+     * @param options     The upload options. NULL checks the upload status
+     *                    every 16 chunks, without a CRC check or a progress
+     *                    callback.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     * @retval Ex10SdkErrorRunLocation    if not running in the Bootloader.
+     * @retval Ex10SdkErrorNullPointer    if the image data is NULL.
+     * @retval Ex10SdkErrorBadParamLength if the image is empty or larger
+     *                                    than EX10_MAX_IMAGE_BYTES.
+     * @retval Ex10SdkErrorBadParamValue  if the image CRC does not match.
+     * @retval Ex10SdkErrorInvalidState   if the flashed image is not valid.
+     */
+    struct Ex10Result (*upload_image_pipelined)(
+        uint8_t                         destination,
+        struct ConstByteSpan            image,
+        struct Ex10UploadOptions const* options);
 };
 
 struct Ex10Protocol const* get_ex10_protocol(void);
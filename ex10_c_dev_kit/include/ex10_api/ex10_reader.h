@@ -17,6 +17,7 @@
 #include "ex10_api/event_fifo_packet_types.h"
 #include "ex10_api/ex10_continuous_inventory_common.h"
 #include "ex10_api/ex10_ops.h"
+#include "ex10_api/ex10_protocol.h"
 #include "ex10_api/ex10_rf_power.h"
 #include "ex10_api/rf_mode_definitions.h"
 
@@ -438,6 +439,35 @@ struct Ex10Reader
      */
     struct ContinuousInventoryState volatile const* (
         *get_continuous_inventory_state)(void);
+
+    /**
+     * Enable the adaptive EventFifo threshold controller, which batches more
+     * packets per ReadFifo under high tag density and lowers the threshold
+     * for low latency when tags are sparse.
+     * @see Ex10Protocol.enable_fifo_threshold_control()
+     *
+     * @param config The controller bounds and targets, or NULL to use the
+     *               defaults.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     */
+    struct Ex10Result (*enable_fifo_threshold_control)(
+        struct Ex10EventFifoThresholdConfig const* config);
+
+    /**
+     * Disable the adaptive EventFifo threshold controller.
+     * The threshold remains at its last value.
+     */
+    void (*disable_fifo_threshold_control)(void);
+
+    /**
+     * Get the EventFifo threshold, controller bounds and interrupt traffic
+     * statistics.
+     *
+     * @param [out] stats The threshold statistics.
+     */
+    void (*get_fifo_threshold_stats)(struct Ex10EventFifoThresholdStats* stats);
 };
 
 struct Ex10Reader const* get_ex10_reader(void);
@@ -38,6 +38,52 @@ struct CwConfig
     struct Ex10RegulatoryTimers       timer;
 };
 
+/**
+ * @struct Ex10RampPlanCacheStats
+ * The ramp plan cache state and the CW ramps it has served.
+ * @see Ex10RfPower.enable_ramp_plan_cache()
+ */
+struct Ex10RampPlanCacheStats
+{
+    /// Whether the ramp plan cache is enabled.
+    bool enabled;
+
+    /// The width of the temperature buckets, in temperature ADC counts.
+    uint16_t temperature_bucket_adc;
+
+    /// The number of build_cw_configs() calls served from the cache, and
+    /// the number which computed a new plan.
+    size_t plan_hits;
+    size_t plan_misses;
+
+    /// The number of cw_on() calls which reused the aggregate op buffer of a
+    /// cached plan, and the number which built it.
+    size_t agg_op_hits;
+    size_t agg_op_misses;
+
+    /// The number of cached plans replaced by a new plan.
+    size_t evictions;
+};
+
+/**
+ * @struct Ex10PipelinedRampStats
+ * The pipelined ramp state and the CwOn aggregate ops it has staged.
+ * @see Ex10RfPower.enable_pipelined_ramp()
+ */
+struct Ex10PipelinedRampStats
+{
+    /// Whether pipelined ramps are enabled.
+    bool enabled;
+
+    /// The number of CwOn aggregate ops staged by stage_next_cw_on().
+    size_t staged_count;
+
+    /// The number of cw_on() calls which ran the staged aggregate op, and
+    /// the number which found it did not match and rebuilt the buffer.
+    size_t staged_hits;
+    size_t staged_misses;
+};
+
 struct Ex10RfPower
 {
     /// Initialize the Impinj Reader Chip RF power.
@@ -198,6 +244,101 @@ struct Ex10RfPower
      * the user a simple way to disable the droop compensation.
      */
     void (*disable_droop_compensation)(void);
+
+    /**
+     * Enable the CW ramp plan cache. The cache starts out empty.
+     *
+     * build_cw_configs() caches the configuration it computes for each
+     * antenna, channel, transmit power, RF mode, RF filter and temperature
+     * bucket, and cw_on() caches the aggregate op buffer built from it.
+     * Later ramps which match a cached plan skip the calibration math and
+     * the aggregate op buffer construction.
+     *
+     * While the cache is enabled, the transmit power of each plan is
+     * calibrated at the center of its temperature bucket.
+     *
+     * @note Call invalidate_ramp_plan_cache() after changing the calibration
+     *       or board configuration which the plans were built from.
+     *
+     * @param temperature_bucket_adc The width of each temperature bucket, in
+     *                               temperature ADC counts; 1 calibrates
+     *                               each plan at the measured temperature.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     * @retval Ex10SdkErrorBadParamValue if temperature_bucket_adc is zero.
+     */
+    struct Ex10Result (*enable_ramp_plan_cache)(
+        uint16_t temperature_bucket_adc);
+
+    /**
+     * Disable the CW ramp plan cache and discard the cached plans.
+     */
+    void (*disable_ramp_plan_cache)(void);
+
+    /**
+     * Discard the cached ramp plans.
+     */
+    void (*invalidate_ramp_plan_cache)(void);
+
+    /**
+     * Get the ramp plan cache state and hit and miss counts.
+     *
+     * @param [out] stats The ramp plan cache statistics.
+     */
+    void (*get_ramp_plan_cache_stats)(struct Ex10RampPlanCacheStats* stats);
+
+    /**
+     * Enable or disable pipelined ramps. When enabled, the CwOn aggregate
+     * op of the next channel is built and written to the device while the
+     * current channel is transmitting (@see stage_next_cw_on()); the next
+     * cw_on() call then only has to start the AggregateOp.
+     *
+     * @note The staged transmit power is calibrated at the temperature
+     *       measured before the current ramp. Enable the ramp plan cache
+     *       (@see enable_ramp_plan_cache()) so that small temperature
+     *       changes between ramps do not invalidate the staged aggregate op.
+     *
+     * @param enable true to enable pipelined ramps, false to disable them.
+     */
+    void (*enable_pipelined_ramp)(bool enable);
+
+    /**
+     * Build the CwOn aggregate op for the next channel in the hop sequence
+     * and write it to the device aggregate op buffer. This is called by
+     * Ex10Inventory.start_inventory() and Ex10Reader.start_inventory() once
+     * the inventory round is running on the current channel, and does
+     * nothing unless pipelined ramps are enabled.
+     *
+     * The staged aggregate op is used by the next cw_on() call if it is
+     * called with the same configuration, including the regulatory timers,
+     * and the aggregate op buffer has not been written in the meantime.
+     * Otherwise cw_on() builds and writes the buffer as usual.
+     *
+     * @param antenna           The antenna of the next ramp.
+     * @param rf_mode           The RF mode of the next ramp.
+     * @param tx_power_cdbm     The transmit power of the next ramp.
+     * @param temperature_adc   The most recent temperature ADC reading.
+     * @param temp_comp_enabled Whether temperature compensation is enabled.
+     * @param droop_comp        The droop compensation of the next ramp.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     */
+    struct Ex10Result (*stage_next_cw_on)(
+        uint8_t                                    antenna,
+        enum RfModes                               rf_mode,
+        int16_t                                    tx_power_cdbm,
+        uint16_t                                   temperature_adc,
+        bool                                       temp_comp_enabled,
+        struct PowerDroopCompensationFields const* droop_comp);
+
+    /**
+     * Get the pipelined ramp state and staging counts.
+     *
+     * @param [out] stats The pipelined ramp statistics.
+     */
+    void (*get_pipelined_ramp_stats)(struct Ex10PipelinedRampStats* stats);
 };
 
 struct Ex10RfPower const* get_ex10_rf_power(void);
@@ -0,0 +1,153 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ex10_api/ex10_regulatory.h"
+#include "ex10_api/ex10_result.h"
+#include "ex10_api/rf_mode_definitions.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct Ex10TagReadExportConfig
+ * The receive configuration of the exported tag reads, used to compensate
+ * their RSSI, and the export options.
+ */
+struct Ex10TagReadExportConfig
+{
+    /// The RF mode and antenna of the inventory.
+    enum RfModes rf_mode;
+    uint8_t      antenna;
+
+    /// The RF filter of the active region.
+    /// @see Ex10ActiveRegion.get_rf_filter()
+    enum RfFilter rf_filter;
+
+    /// The temperature ADC code, such as the one returned by
+    /// Ex10RampModuleManager.retrieve_adc_temperature(). Zero disables
+    /// temperature compensation.
+    uint16_t temp_adc;
+
+    /// If the EventFifo queue is empty, the time to wait for a packet.
+    /// Zero does not wait.
+    uint32_t wait_timeout_us;
+
+    /// If true, the export stops at the first packet which is not a TagRead.
+    /// Otherwise, other packets are removed from the queue and counted.
+    /// The export always stops at a ContinuousInventorySummary, Halted or
+    /// Ex10ResultPacket packet, and at an invalid packet.
+    bool stop_at_other_packets;
+};
+
+/**
+ * @struct Ex10TagReadArrays
+ * Struct-of-arrays buffers, provided by the caller, into which tag reads are
+ * exported. Row n of each array holds the n-th exported tag read.
+ *
+ * Each array pointer may be NULL, in which case that field is not exported.
+ * Non-NULL arrays must hold capacity elements; the epc and tid arrays must
+ * hold capacity rows of epc_stride and tid_stride bytes.
+ */
+struct Ex10TagReadArrays
+{
+    /// The number of rows of each array.
+    size_t capacity;
+
+    /// The number of bytes in each row of the epc and tid arrays. Longer
+    /// EPCs and TIDs are truncated; shorter ones are zero padded.
+    size_t epc_stride;
+    size_t tid_stride;
+
+    /// The PC word, the EPC not including the PC word, and the number of
+    /// EPC bytes stored in the row. epc_length requires epc.
+    uint16_t* pc;
+    uint8_t*  epc;
+    uint8_t*  epc_length;
+
+    /// The TID, if the TagRead contained one, and the number of TID bytes
+    /// stored in the row; zero if there was no TID. tid_length requires tid.
+    uint8_t* tid;
+    uint8_t* tid_length;
+
+    /// The raw RSSI_LOG_2 value and the compensated RSSI in cdBm. The
+    /// compensated RSSI is computed from the rssi_raw array, and requires it.
+    uint16_t* rssi_raw;
+    int16_t*  rssi_cdbm;
+
+    /// The RF phase at the beginning and the end of the reply.
+    uint16_t* phase_begin;
+    uint16_t* phase_end;
+
+    /// The antenna of the export configuration.
+    uint8_t* antenna;
+
+    /// The TagRead packet us_counter, and the host time of the packet
+    /// estimated by Ex10ClockCorrelation; zero if there is no estimate.
+    uint32_t* timestamp_us;
+    uint64_t* host_time_ns;
+};
+
+/**
+ * @struct Ex10TagReadExportCounts
+ * The packets handled by a call to Ex10TagReadExport.export_tag_reads().
+ */
+struct Ex10TagReadExportCounts
+{
+    /// The number of tag reads exported into the arrays.
+    size_t tag_read_count;
+
+    /// The number of other packets removed from the queue, including
+    /// TagRead packets whose variable length fields could not be parsed.
+    size_t skipped_packet_count;
+};
+
+/**
+ * @struct Ex10TagReadExport
+ * Moves parsed tag reads from the EventFifo queue into struct-of-arrays
+ * buffers in one call, so that an application in another language, such as
+ * Python through ctypes, does not cross the language boundary for each
+ * packet and each field.
+ */
+struct Ex10TagReadExport
+{
+    /**
+     * Remove TagRead packets from the front of the EventFifo queue and
+     * export them into the arrays, until the arrays are full, the queue is
+     * empty or a packet stops the export. The packet which stopped the export
+     * remains at the front of the queue, to be read with packet_peek().
+     *
+     * @param config       The receive configuration and export options.
+     * @param arrays       The arrays into which the tag reads are exported.
+     * @param [out] counts The numbers of packets exported and skipped.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     */
+    struct Ex10Result (*export_tag_reads)(
+        struct Ex10TagReadExportConfig const* config,
+        struct Ex10TagReadArrays const*       arrays,
+        struct Ex10TagReadExportCounts*       counts);
+};
+
+struct Ex10TagReadExport const* get_ex10_tag_read_export(void);
+
+#ifdef __cplusplus
+}
+#endif
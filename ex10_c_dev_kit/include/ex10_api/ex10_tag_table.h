@@ -0,0 +1,233 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ex10_api/event_fifo_packet_types.h"
+#include "ex10_api/ex10_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct Ex10TagTableEntry
+ * A tag seen during inventory, keyed on its EPC and, when read, its TID.
+ * The entries are stored in memory provided by the application to
+ * Ex10TagTable.init(); unused entries have in_use set to false.
+ */
+struct Ex10TagTableEntry
+{
+    /// true if the entry holds a tag, false if the entry is unused.
+    bool in_use;
+
+    /// The hash of the EPC and TID, used to place the entry in the table.
+    uint32_t hash;
+
+    /// The EPC backscattered by the tag, not including the PC word.
+    uint8_t epc[EPC_BUFFER_BYTE_LENGTH];
+    size_t  epc_length;
+
+    /// The TID backscattered by the tag, if the TagRead contained one.
+    uint8_t tid[TID_LENGTH_BYTES];
+    size_t  tid_length;
+
+    /// The TagRead packet us_counter of the first and most recent reads.
+    uint32_t first_seen_us;
+    uint32_t last_seen_us;
+
+    /// The number of times the tag was read.
+    uint32_t read_count;
+
+    /// The highest compensated RSSI, and the sum of the compensated RSSI of
+    /// all reads. @see ex10_tag_table_average_rssi_cdbm().
+    int16_t peak_rssi_cdbm;
+    int64_t rssi_cdbm_sum;
+
+    /// The antenna and the RF phase of the most recent read.
+    uint8_t  antenna;
+    uint16_t rf_phase_begin;
+    uint16_t rf_phase_end;
+};
+
+/**
+ * @return int16_t The average compensated RSSI of the reads of the tag.
+ */
+static inline int16_t ex10_tag_table_average_rssi_cdbm(
+    struct Ex10TagTableEntry const* entry)
+{
+    if (entry->read_count == 0u)
+    {
+        return 0;
+    }
+    return (int16_t)(entry->rssi_cdbm_sum / (int64_t)entry->read_count);
+}
+
+/**
+ * @enum Ex10TagTableEvent
+ * The tag table events reported to the registered event callback.
+ */
+enum Ex10TagTableEvent
+{
+    /// A TagRead was received for a tag not in the table.
+    TagTableEventNewTag,
+    /// A tag was not read within the aging timeout and was removed.
+    TagTableEventTagLost,
+};
+
+/**
+ * @enum Ex10TagTableUpdate
+ * The result of adding a TagRead to the tag table.
+ */
+enum Ex10TagTableUpdate
+{
+    /// The tag was added to the table.
+    TagTableUpdateNewTag,
+    /// The tag was already in the table; its entry was updated.
+    TagTableUpdateDuplicate,
+    /// The tag was not in the table and the table is full.
+    TagTableUpdateDropped,
+    /// The packet is not a TagRead, or its EPC could not be parsed.
+    TagTableUpdateInvalid,
+};
+
+/**
+ * @struct Ex10TagTableStats
+ * The tag table occupancy and the reads it has processed.
+ */
+struct Ex10TagTableStats
+{
+    /// The number of entries provided to init(), and the number in use.
+    size_t capacity;
+    size_t tag_count;
+
+    /// The number of TagRead packets for new, already seen and dropped tags.
+    size_t new_tags;
+    size_t duplicate_reads;
+    size_t dropped_reads;
+
+    /// The number of tags removed by age().
+    size_t lost_tags;
+};
+
+/**
+ * @struct Ex10TagTable
+ * A fixed size table of the tags seen during inventory.
+ *
+ * Each TagRead packet updates the entry of its tag, so that the application
+ * can be notified once per tag rather than once per read. Tags not read for
+ * the aging timeout are removed from the table. No memory is allocated;
+ * the table is an open addressing hash table stored in the entries provided
+ * to init().
+ */
+struct Ex10TagTable
+{
+    /**
+     * Initialize the tag table, discarding any tags it contains.
+     *
+     * @param entries          The memory used to store the table.
+     * @param capacity         The number of entries. One entry is always
+     *                         left unused; for efficient lookups, this
+     *                         should be at least 25% larger than the
+     *                         number of tags expected in the field.
+     * @param aging_timeout_us A tag not read for this number of microseconds
+     *                         is removed by age(). Zero disables aging.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     * @retval Ex10SdkErrorNullPointer   if entries is NULL.
+     * @retval Ex10SdkErrorBadParamValue if capacity is less than 2.
+     */
+    struct Ex10Result (*init)(struct Ex10TagTableEntry* entries,
+                              size_t                    capacity,
+                              uint32_t                  aging_timeout_us);
+
+    /**
+     * Register a callback to be notified when a tag is added to or removed
+     * from the table. The callback is called from update() and age(), in
+     * the context of their caller.
+     *
+     * @param callback The function to call, or NULL to remove the callback.
+     */
+    void (*register_event_callback)(
+        void (*callback)(enum Ex10TagTableEvent          event,
+                         struct Ex10TagTableEntry const* entry));
+
+    /**
+     * Add a TagRead packet to the table.
+     *
+     * @param packet      A TagRead EventFifo packet.
+     * @param antenna     The antenna the tag was read on.
+     * @param rssi_cdbm   The compensated RSSI of the read.
+     * @param [out] entry If not NULL, set to the entry of the tag, or to
+     *                    NULL if the read was dropped or invalid.
+     *
+     * @return enum Ex10TagTableUpdate Whether the tag was new to the table.
+     */
+    enum Ex10TagTableUpdate (*update)(
+        struct EventFifoPacket const*    packet,
+        uint8_t                          antenna,
+        int16_t                          rssi_cdbm,
+        struct Ex10TagTableEntry const** entry);
+
+    /**
+     * Remove the tags not read within the aging timeout. The
+     * TagTableEventTagLost event is reported for each tag removed.
+     *
+     * @param now_us The current device time, in the same time base as the
+     *               EventFifo packet us_counter.
+     *
+     * @return size_t The number of tags removed.
+     */
+    size_t (*age)(uint32_t now_us);
+
+    /**
+     * Find the entry of a tag.
+     *
+     * @param epc        The EPC of the tag, not including the PC word.
+     * @param epc_length The number of bytes in the EPC.
+     * @param tid        The TID of the tag, or NULL if the tag was read
+     *                   without its TID.
+     * @param tid_length The number of bytes in the TID.
+     *
+     * @return struct Ex10TagTableEntry const* The entry of the tag, or NULL
+     *         if the tag is not in the table.
+     */
+    struct Ex10TagTableEntry const* (*find)(uint8_t const* epc,
+                                            size_t         epc_length,
+                                            uint8_t const* tid,
+                                            size_t         tid_length);
+
+    /**
+     * Remove all tags from the table without reporting events.
+     * The statistics are not reset.
+     */
+    void (*clear)(void);
+
+    /**
+     * Get the tag table statistics.
+     *
+     * @param [out] stats The tag table statistics.
+     */
+    void (*get_stats)(struct Ex10TagTableStats* stats);
+};
+
+struct Ex10TagTable const* get_ex10_tag_table(void);
+
+#ifdef __cplusplus
+}
+#endif
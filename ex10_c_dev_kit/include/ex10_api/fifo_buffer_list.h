@@ -14,14 +14,22 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "ex10_api/byte_span.h"
+#include "ex10_api/event_packet_parser.h"
 #include "ex10_api/list_node.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * The maximum number of FifoBufferNode elements which can be managed by each
+ * FifoBufferList. This must be a power of 2.
+ */
+#define FIFO_BUFFER_LIST_CAPACITY ((size_t)64u)
+
 /**
  * @struct FifoBufferNode
  * Used for reading EventFifo data using the ReadFifo command and for passing
@@ -58,7 +66,41 @@ struct FifoBufferNode
     struct ByteSpan raw_buffer;
 
     /// The list node which is used for list insertion operations.
+    /// @note The SDK free lists and the EventFifo queue hold FifoBufferNode
+    ///       pointers in lock-free rings and do not link this node.
     struct Ex10ListNode list_node;
+
+    /// true if packet_index refers to the current fifo_data contents.
+    /// Cleared when the node is taken from its free list.
+    bool packet_indexed;
+
+    /// The packets of fifo_data, indexed once by
+    /// Ex10EventFifoQueue.get_packet_index() and shared by the fifo data
+    /// handler and the EventFifo queue consumer.
+    /// The index storage is assigned by FifoBufferList.init(), one
+    /// EventPacketIndex per node of the buffer pool.
+    struct EventPacketIndex* packet_index;
+
+    /// The host time, from Ex10TimeHelpers.time_now_ns(), at which the node
+    /// was pushed onto the EventFifo queue.
+    uint64_t queued_time_ns;
+};
+
+/**
+ * @struct FifoBufferListStats
+ * Usage counters for a FifoBufferList, used to size the buffer pool from
+ * observed traffic.
+ */
+struct FifoBufferListStats
+{
+    /// The number of FifoBufferNode elements managed by the list.
+    size_t buffer_count;
+    /// The number of nodes currently taken from the free list.
+    size_t in_use;
+    /// The largest number of nodes taken from the free list at one time.
+    size_t high_water_mark;
+    /// The number of free_list_get() calls which found the free list empty.
+    size_t exhaustion_count;
 };
 
 /**
@@ -76,6 +118,7 @@ struct FifoBufferList
     /**
      * Initialize the FifoBufferNode nodes, free list and queued list.
      * This function should be called at the board layer.
+     * The buffer_count must not exceed FIFO_BUFFER_LIST_CAPACITY.
      *
      * After calling this function:
      * - All FifoBufferNode elements will be in the free list.
@@ -86,15 +129,18 @@ struct FifoBufferList
      * initialize.
      * @param byte_arrays       An array of buffers allocated for ReadFifo
      * events.
-     * @param buffer_count      The number FifoBufferNode and the ByteSpan
-     * elements allocated for ReadFifo events.
+     * @param packet_indexes    An array of packet indexes, one for each
+     * FifoBufferNode element.
+     * @param buffer_count      The number FifoBufferNode, ByteSpan and
+     * EventPacketIndex elements allocated for ReadFifo events.
      *
      * @return struct Ex10Result
      *         Indicates whether the function call passed or failed.
      */
-    struct Ex10Result (*init)(struct FifoBufferNode* fifo_buffer_nodes,
-                              struct ByteSpan const* byte_arrays,
-                              size_t                 buffer_count);
+    struct Ex10Result (*init)(struct FifoBufferNode*   fifo_buffer_nodes,
+                              struct ByteSpan const*   byte_arrays,
+                              struct EventPacketIndex* packet_indexes,
+                              size_t                   buffer_count);
 
     /**
      * Add a FifoBufferNode to the free list. Once all ReadFifo events have been
@@ -107,6 +153,9 @@ struct FifoBufferList
      * @return bool True if the free list was empty prior to performing the
      *              put operation. False if there were nodes in the free list
      *              prior to the put operation.
+     *
+     * @note This function does not block and may be called concurrently
+     *       from the IRQ_N monitor thread and the application thread.
      */
     bool (*free_list_put)(struct FifoBufferNode* event_fifo_buffer_node);
 
@@ -123,6 +172,20 @@ struct FifoBufferList
      * list.
      */
     size_t (*free_list_size)(void);
+
+    /**
+     * Get the usage counters of the list.
+     * The counters are reset by init() and by reset_stats().
+     *
+     * @param [out] stats The usage counters.
+     */
+    void (*get_stats)(struct FifoBufferListStats* stats);
+
+    /**
+     * Reset the exhaustion_count to zero and the high_water_mark to the
+     * number of nodes currently in use.
+     */
+    void (*reset_stats)(void);
 };
 
 struct FifoBufferList const* get_ex10_fifo_buffer_list(void);
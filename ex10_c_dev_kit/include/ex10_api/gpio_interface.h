@@ -20,6 +20,23 @@
 extern "C" {
 #endif
 
+/**
+ * @enum ReadyNWaitMode
+ * Selects how the host waits for the Ex10 READY_N line to assert low.
+ */
+enum ReadyNWaitMode
+{
+    /// Poll the READY_N line level until it asserts low. This gives the
+    /// lowest latency at the cost of a fully loaded CPU core while waiting.
+    ReadyNWaitModeSpin = 0,
+    /// Block on the READY_N falling edge event. The CPU is released while
+    /// the Ex10 processes the command.
+    ReadyNWaitModeEvent = 1,
+    /// Poll the READY_N line level for a limited time, then block on the
+    /// READY_N falling edge event if it has not yet asserted.
+    ReadyNWaitModeHybrid = 2,
+};
+
 /**
  * @struct Ex10GpioInterface
  * This interface is a pass-through to the Ex10GpioDriver interface.
@@ -56,6 +73,9 @@ struct Ex10GpioInterface
 
     int32_t (*busy_wait_ready_n)(uint32_t ready_n_timeout_ms);
     int32_t (*ready_n_pin_get)(void);
+
+    int32_t (*set_ready_n_wait_mode)(enum ReadyNWaitMode mode,
+                                     uint32_t            spin_us);
 };
 
 #ifdef __cplusplus
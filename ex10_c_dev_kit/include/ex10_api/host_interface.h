@@ -16,6 +16,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "byte_span.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -80,6 +82,36 @@ struct HostInterface
      * @retval -1 The host serial interface hardware faulted.
      */
     int32_t (*write)(const void* data, size_t length);
+
+    /**
+     * Receive a byte stream of data from the Ex10 device, scattered across
+     * a list of buffers, within a single host interface transaction.
+     * This is equivalent to a read() of the total segment length, without
+     * the need to copy the byte stream out of an intermediate buffer.
+     *
+     * @param segments      The list of buffers to fill, in order.
+     * @param segment_count The number of segments in the list.
+     *
+     * @return The total number of bytes received from the Ex10 device.
+     * @retval -1 The host serial interface hardware faulted.
+     */
+    int32_t (*read_segments)(struct ByteSpan const* segments,
+                             size_t                 segment_count);
+
+    /**
+     * Send a byte stream of data to the Ex10 device, gathered from a list of
+     * buffers, within a single host interface transaction.
+     * This is equivalent to a write() of the concatenated segments, without
+     * the need to copy the segments into an intermediate buffer.
+     *
+     * @param segments      The list of buffers to send, in order.
+     * @param segment_count The number of segments in the list.
+     *
+     * @return The total number of bytes sent to the Ex10 device.
+     * @retval -1 The host serial interface hardware faulted.
+     */
+    int32_t (*write_segments)(struct ConstByteSpan const* segments,
+                              size_t                      segment_count);
 };
 
 #ifdef __cplusplus
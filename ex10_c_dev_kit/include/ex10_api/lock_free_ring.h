@@ -0,0 +1,235 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct Ex10RingCell
+ * A single storage slot within a struct Ex10LockFreeRing.
+ *
+ * The sequence value encodes the state of the cell with respect to the ring
+ * head and tail positions, which allows producers and the consumer to claim
+ * cells without a lock.
+ */
+struct Ex10RingCell
+{
+    size_t sequence;
+    void*  data;
+};
+
+/**
+ * @struct Ex10LockFreeRing
+ * A bounded, lock-free ring of pointers.
+ *
+ * Any number of threads may call ring_push() and ring_pop() concurrently.
+ * The ring_front() function requires that only a single thread pops from the
+ * ring, which is the case for the EventFifo queue and free lists: the IRQ_N
+ * monitor thread, or the EventFifo pipeline drain thread when started, is
+ * the only thread which takes from the free lists and the application thread
+ * is the only thread which takes from the queue.
+ *
+ * The ring capacity must be a power of 2. The cell storage is provided by
+ * the caller and must remain valid for the lifetime of the ring.
+ *
+ * @note The GCC __atomic builtins are used, rather than <stdatomic.h>,
+ *       so that this header remains usable from C++.
+ */
+struct Ex10LockFreeRing
+{
+    struct Ex10RingCell* cells;
+    size_t               mask;  ///< The ring capacity - 1.
+    size_t               head;  ///< The position of the next cell to pop.
+    size_t               tail;  ///< The position of the next cell to push.
+};
+
+/**
+ * Initialize the ring to its empty state.
+ *
+ * @param ring     The ring to initialize.
+ * @param cells    The storage for the ring cells.
+ * @param capacity The number of cells; this must be a power of 2.
+ *
+ * @return bool true if the ring was initialized, false if the capacity is not
+ *              a non-zero power of 2.
+ */
+static inline bool ring_init(struct Ex10LockFreeRing* ring,
+                             struct Ex10RingCell*     cells,
+                             size_t                   capacity)
+{
+    if ((capacity == 0u) || ((capacity & (capacity - 1u)) != 0u))
+    {
+        return false;
+    }
+
+    for (size_t index = 0u; index < capacity; ++index)
+    {
+        cells[index].sequence = index;
+        cells[index].data     = NULL;
+    }
+
+    ring->cells = cells;
+    ring->mask  = capacity - 1u;
+    __atomic_store_n(&ring->head, 0u, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->tail, 0u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    return true;
+}
+
+/**
+ * Push a pointer onto the back of the ring.
+ *
+ * @param ring The ring to push onto.
+ * @param data The pointer to push; must not be NULL.
+ * @param [out] position If not NULL, the ring position which was claimed
+ *                       for the pushed data.
+ *
+ * @return bool true if the data was pushed, false if the ring was full.
+ */
+static inline bool ring_push(struct Ex10LockFreeRing* ring,
+                             void*                    data,
+                             size_t*                  position)
+{
+    size_t pos = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    while (true)
+    {
+        struct Ex10RingCell* cell = &ring->cells[pos & ring->mask];
+        size_t const seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        if (seq == pos)
+        {
+            // The cell is free; claim it by advancing the tail.
+            if (__atomic_compare_exchange_n(&ring->tail,
+                                            &pos,
+                                            pos + 1u,
+                                            true,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+            {
+                cell->data = data;
+                __atomic_store_n(&cell->sequence, pos + 1u, __ATOMIC_RELEASE);
+                if (position != NULL)
+                {
+                    *position = pos;
+                }
+                return true;
+            }
+            // The compare exchange failure updated pos; retry.
+        }
+        else if ((ptrdiff_t)(seq - pos) < 0)
+        {
+            // The cell still holds data from the previous lap: full.
+            return false;
+        }
+        else
+        {
+            // Another producer claimed this cell; reload the tail.
+            pos = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ * Pop a pointer from the front of the ring.
+ *
+ * @param ring The ring to pop from.
+ *
+ * @return void* The pointer at the front of the ring.
+ * @retval NULL  The ring was empty.
+ */
+static inline void* ring_pop(struct Ex10LockFreeRing* ring)
+{
+    size_t pos = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    while (true)
+    {
+        struct Ex10RingCell* cell = &ring->cells[pos & ring->mask];
+        size_t const seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        ptrdiff_t const diff = (ptrdiff_t)(seq - (pos + 1u));
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&ring->head,
+                                            &pos,
+                                            pos + 1u,
+                                            true,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+            {
+                void* const data = cell->data;
+                // Release the cell to be pushed on the next lap.
+                __atomic_store_n(
+                    &cell->sequence, pos + ring->mask + 1u, __ATOMIC_RELEASE);
+                return data;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The cell at the head has not been published: empty.
+            return NULL;
+        }
+        else
+        {
+            pos = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ * Access the pointer at the front of the ring without removing it.
+ *
+ * @warning Only valid when a single thread pops from the ring, and must be
+ *          called from that thread.
+ *
+ * @return void* The pointer at the front of the ring.
+ * @retval NULL  The ring was empty.
+ */
+static inline void* ring_front(struct Ex10LockFreeRing* ring)
+{
+    size_t const pos = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    struct Ex10RingCell const* cell = &ring->cells[pos & ring->mask];
+    size_t const seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+    return (seq == pos + 1u) ? cell->data : NULL;
+}
+
+/**
+ * @return size_t The position of the next cell to be popped from the ring.
+ */
+static inline size_t ring_head(struct Ex10LockFreeRing const* ring)
+{
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @return size_t The number of pointers contained in the ring. If pushes or
+ *                pops are in progress the value is approximate.
+ */
+static inline size_t ring_size(struct Ex10LockFreeRing const* ring)
+{
+    size_t const head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    size_t const tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    return (tail > head) ? tail - head : 0u;
+}
+
+/** @return bool true if the ring contains no published pointers. */
+static inline bool ring_is_empty(struct Ex10LockFreeRing* ring)
+{
+    return ring_front(ring) == NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
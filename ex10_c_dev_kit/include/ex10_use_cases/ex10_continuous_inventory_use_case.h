@@ -126,6 +126,22 @@ struct Ex10ContinuousInventoryUseCase
      */
     struct Ex10Result (*continuous_inventory)(
         struct Ex10ContinuousInventoryUseCaseParameters* params);
+
+    /**
+     * By default every TagRead packet is sent to the packet subscriber.
+     * When the tag table filter is enabled, each TagRead packet is added to
+     * the tag table (@see get_ex10_tag_table()) with its compensated RSSI,
+     * and only the TagRead packets of tags new to the table are sent to the
+     * subscriber. Reads which the table drops because it is full are still
+     * sent. The tag table is aged at the end of each inventory round.
+     *
+     * @note The tag table must be initialized with Ex10TagTable.init()
+     *       before continuous_inventory() is called.
+     *
+     * @param enable If set to true, duplicate TagRead packets are filtered.
+     *               If set to false, all TagRead packets are sent.
+     */
+    void (*enable_tag_table_filter)(bool enable);
 };
 
 struct Ex10ContinuousInventoryUseCase const*
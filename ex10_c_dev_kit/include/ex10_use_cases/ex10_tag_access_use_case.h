@@ -13,6 +13,7 @@
 #pragma once
 
 #include "ex10_api/event_fifo_packet_types.h"
+#include "ex10_api/gen2_commands.h"
 #include "ex10_api/rf_mode_definitions.h"
 
 #ifdef __cplusplus
@@ -59,6 +60,98 @@ enum HaltedCallbackResult
     NakTagAndContinue,
 };
 
+/// The number of tag access jobs which can be queued at once.
+#define EX10_TAG_ACCESS_MAX_JOBS ((size_t)16u)
+
+/// The largest word_count of a Gen2Read job.
+#define EX10_TAG_ACCESS_JOB_MAX_READ_WORDS ((size_t)32u)
+
+/// The size of the reply buffer of a job result; this holds the read words,
+/// the tag handle and the CRC.
+#define EX10_TAG_ACCESS_JOB_REPLY_WORDS \
+    (EX10_TAG_ACCESS_JOB_MAX_READ_WORDS + (size_t)4u)
+
+/**
+ * @enum TagAccessJobStatus
+ * The outcome of a tag access job, reported to its completion callback.
+ */
+enum TagAccessJobStatus
+{
+    /// The job is queued and has not yet been run on its tag.
+    TagAccessJobPending,
+    /// The commands were sent, and the tag replied that it executed the
+    /// job command.
+    TagAccessJobComplete,
+    /// The tag replied to the job command, or to a Gen2Access command, with
+    /// an error code. The reply error_code holds the tag error code.
+    TagAccessJobTagError,
+    /// The Gen2Transaction replies were not received or could not be decoded.
+    /// The command may or may not have been executed by the tag.
+    TagAccessJobFailed,
+    /// The job was removed by cancel_jobs() before it was run.
+    TagAccessJobCancelled,
+};
+
+struct Ex10TagAccessJobResult;
+
+/**
+ * @struct Ex10TagAccessJob
+ * A Gen2 access command to send to the tag with a matching EPC, the next
+ * time the tag is halted on during run_jobs().
+ */
+struct Ex10TagAccessJob
+{
+    /// The EPC of the tag, not including the PC word.
+    uint8_t epc[EPC_BUFFER_BYTE_LENGTH];
+    size_t  epc_length;
+
+    /// If non-zero, the tag is sent a pair of Gen2Access commands with this
+    /// password before the job command.
+    uint32_t access_password;
+
+    /// One of Gen2Read, Gen2Write, Gen2Lock or Gen2BlockWrite; the
+    /// corresponding member of args holds the command arguments.
+    enum Gen2Command command;
+    union
+    {
+        struct ReadCommandArgs       read;
+        struct WriteCommandArgs      write;
+        struct LockCommandArgs       lock;
+        struct BlockWriteCommandArgs block_write;
+    } args;
+
+    /// Called when the job is finished, from the thread which called
+    /// run_jobs() or cancel_jobs(). The BlockWrite data must remain valid
+    /// until then.
+    void (*completion_callback)(struct Ex10TagAccessJob const*       job,
+                                struct Ex10TagAccessJobResult const* result);
+
+    /// Passed through to the completion callback in the job copy.
+    void* user_data;
+};
+
+/**
+ * @struct Ex10TagAccessJobResult
+ * The result of a tag access job.
+ */
+struct Ex10TagAccessJobResult
+{
+    /// The identifier returned by submit_job().
+    uint32_t job_id;
+
+    enum TagAccessJobStatus status;
+
+    /// The decoded reply to the job command; or, if a Gen2Access command was
+    /// not accepted by the tag, the reply to that command. The reply data
+    /// points into reply_words.
+    struct Gen2Reply reply;
+    uint16_t         reply_words[EX10_TAG_ACCESS_JOB_REPLY_WORDS];
+
+    /// The number of times the tag was halted on before the job finished.
+    /// A job is retried when the tag is lost before its replies are received.
+    uint8_t attempts;
+};
+
 /**
  * @struct Ex10TagAccessUseCase
  */
@@ -133,6 +226,70 @@ struct Ex10TagAccessUseCase
      *         response was not as expected.
      */
     bool (*remove_halted_packet)(void);
+
+    /**
+     * Get the packet at the front of the event fifo queue, waiting for at
+     * most the timeout for one to arrive.
+     *
+     * @param timeout_us The maximum time to wait.
+     *
+     * @return struct EventFifoPacket const* The packet, which remains in the
+     *         queue until remove_fifo_packet() is called, or NULL if no
+     *         packet arrived within the timeout.
+     */
+    struct EventFifoPacket const* (*get_fifo_packet_with_timeout)(
+        uint32_t timeout_us);
+
+    /**
+     * Queue a tag access job. The job is copied; it runs when its tag is
+     * next halted on by run_jobs(). Jobs for the same tag are run in the
+     * order they were submitted, in a single halted state if possible.
+     *
+     * @param job          The job to queue.
+     * @param [out] job_id If not NULL, set to the identifier reported in the
+     *                     job result.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     * @retval Ex10SdkErrorNullPointer    if job is NULL.
+     * @retval Ex10SdkErrorBadParamValue  if the command is not supported or
+     *                                    the read word_count is too large.
+     * @retval Ex10SdkErrorBadParamLength if the EPC length is invalid.
+     * @retval Ex10SdkErrorInvalidState   if the job queue is full.
+     */
+    struct Ex10Result (*submit_job)(struct Ex10TagAccessJob const* job,
+                                    uint32_t*                      job_id);
+
+    /**
+     * @return size_t The number of queued jobs which have not finished.
+     */
+    size_t (*pending_job_count)(void);
+
+    /**
+     * Remove all queued jobs, reporting TagAccessJobCancelled to their
+     * completion callbacks. Must not be called while run_jobs() is running.
+     */
+    void (*cancel_jobs)(void);
+
+    /**
+     * Run inventory rounds, halting on each tag, until all queued jobs have
+     * finished or the timeout expires. As each tag is halted on, its EPC is
+     * matched against the queued jobs; the matching jobs are sent in one
+     * Gen2 halted sequence and the replies are waited for with a timeout,
+     * without polling. Tags without jobs are ACKed and not accessed.
+     *
+     * The registered halted callback is not called while the jobs run.
+     *
+     * @param params     The inventory parameters; select, session and target
+     *                   should allow the tags of the jobs to be singulated.
+     * @param timeout_ms Rounds are started until this time has elapsed.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed. Jobs
+     *         not run before the timeout remain queued.
+     */
+    struct Ex10Result (*run_jobs)(struct Ex10TagAccessUseCaseParameters* params,
+                                  uint32_t timeout_ms);
 };
 
 struct Ex10TagAccessUseCase const* get_ex10_tag_access_use_case(void);
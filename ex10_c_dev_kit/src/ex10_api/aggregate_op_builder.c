@@ -17,12 +17,17 @@
 #include "ex10_api/aggregate_op_builder.h"
 #include "ex10_api/application_registers.h"
 #include "ex10_api/event_packet_parser.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/print_data.h"
 
 
 static const uint8_t instruction_code_size = 1u;
 
+/// Incremented each time the device side aggregate op buffer is written,
+/// one count per context.
+static uint32_t buffer_generations[EX10_MAX_CONTEXTS];
+
 static bool aggregate_buffer_overflow(struct ByteSpan* agg_op_span,
                                       size_t           size_to_add)
 {
@@ -386,6 +391,7 @@ static bool clear_buffer(void)
     ex10_memzero(clear_buffer, sizeof(clear_buffer));
 
     // clear the device side buffer
+    buffer_generations[ex10_context_index()] += 1u;
     struct Ex10Result ex10_result =
         get_ex10_protocol()->write(&aggregate_op_buffer_reg, clear_buffer);
 
@@ -404,6 +410,7 @@ static bool set_buffer(struct ByteSpan* agg_op_span)
         return false;
     }
 
+    buffer_generations[ex10_context_index()] += 1u;
     struct Ex10Result ex10_result =
         get_ex10_protocol()->write_partial(aggregate_op_buffer_reg.address,
                                            (uint16_t)agg_op_span->length,
@@ -412,6 +419,11 @@ static bool set_buffer(struct ByteSpan* agg_op_span)
     return (ex10_result.error == false);
 }
 
+static uint32_t get_buffer_generation(void)
+{
+    return buffer_generations[ex10_context_index()];
+}
+
 static void print_buffer(struct ByteSpan* agg_op_span)
 {
     if (agg_op_span == NULL || agg_op_span->data == NULL)
@@ -1490,6 +1502,7 @@ struct Ex10AggregateOpBuilder const* get_ex10_aggregate_op_builder(void)
         .append_start_ber_test        = append_start_ber_test,
         .append_ramp_transmit_power   = append_ramp_transmit_power,
         .append_droop_compensation    = append_droop_compensation,
+        .get_buffer_generation        = get_buffer_generation,
     };
 
     return &gen2_aggregate_op_builder;
@@ -67,6 +67,7 @@ struct Ex10Result ex10_core_board_setup(enum Ex10RegionId region_id,
     struct Ex10Result ex10_result =
         fifo_buffer_list->init(event_fifo_buffer_pool->fifo_buffer_nodes,
                                event_fifo_buffer_pool->fifo_buffers,
+                               event_fifo_buffer_pool->packet_indexes,
                                event_fifo_buffer_pool->buffer_count);
     if (ex10_result.error)
     {
@@ -84,6 +85,7 @@ struct Ex10Result ex10_core_board_setup(enum Ex10RegionId region_id,
     ex10_result =
         result_buffer_list->init(result_buffer_pool->fifo_buffer_nodes,
                                  result_buffer_pool->fifo_buffers,
+                                 result_buffer_pool->packet_indexes,
                                  result_buffer_pool->buffer_count);
     if (ex10_result.error)
     {
@@ -135,12 +137,12 @@ struct Ex10Result ex10_bootloader_core_board_setup(uint32_t spi_clock_hz)
 {
     struct FifoBufferList const* fifo_buffer_list = get_ex10_fifo_buffer_list();
 
-    fifo_buffer_list->init(NULL, NULL, 0u);
+    fifo_buffer_list->init(NULL, NULL, NULL, 0u);
 
     struct FifoBufferList const* result_buffer_list =
         get_ex10_result_buffer_list();
 
-    result_buffer_list->init(NULL, NULL, 0u);
+    result_buffer_list->init(NULL, NULL, NULL, 0u);
 
     struct Ex10DriverList const* driver_list = get_ex10_board_driver_list();
     struct Ex10Protocol const*   protocol    = get_ex10_protocol();
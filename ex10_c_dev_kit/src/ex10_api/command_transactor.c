@@ -13,13 +13,19 @@
 
 #include "ex10_api/command_transactor.h"
 #include "board/board_spec.h"
+#include "board/ex10_osal.h"
+#include "board/time_helpers.h"
 
 #include "ex10_api/byte_span.h"
+#include "ex10_api/ex10_context.h"
+#include "ex10_api/ex10_perf_counters.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/print_data.h"
 #include "ex10_api/trace.h"
 
-static struct ConstByteSpan last_command = {.data = NULL, .length = 0u};
+// The command sent by the calling thread, used to decode its response.
+static EX10_THREAD_LOCAL struct ConstByteSpan last_command = {.data   = NULL,
+                                                              .length = 0u};
 
 struct CommandTransactor
 {
@@ -27,70 +33,123 @@ struct CommandTransactor
     struct HostInterface const*     host_interface;
 };
 
-static struct CommandTransactor command_transactor = {.gpio_interface = NULL,
-                                                      .host_interface = NULL};
+static struct CommandTransactor command_transactor_contexts[EX10_MAX_CONTEXTS];
+
+static struct CommandTransactor* get_command_transactor_context(void)
+{
+    return &command_transactor_contexts[ex10_context_index()];
+}
 
 static void init(struct Ex10GpioInterface const* gpio_interface,
                  struct HostInterface const*     host_interface)
 {
-    command_transactor.gpio_interface = gpio_interface;
-    command_transactor.host_interface = host_interface;
+    struct CommandTransactor* transactor = get_command_transactor_context();
+
+    transactor->gpio_interface = gpio_interface;
+    transactor->host_interface = host_interface;
 }
 
 static void deinit(void)
 {
-    command_transactor.gpio_interface = NULL;
-    command_transactor.host_interface = NULL;
+    struct CommandTransactor* transactor = get_command_transactor_context();
+
+    transactor->gpio_interface = NULL;
+    transactor->host_interface = NULL;
 }
 
-static struct Ex10Result send_command(const void* command_buffer,
-                                      size_t      command_length,
-                                      uint32_t    ready_n_timeout_ms)
+static struct Ex10Result send_command_segments(
+    struct ConstByteSpan const* segments,
+    size_t                      segment_count,
+    uint32_t                    ready_n_timeout_ms)
 {
-    if ((command_buffer == NULL) ||
-        (command_transactor.gpio_interface == NULL) ||
-        (command_transactor.host_interface == NULL))
+    struct CommandTransactor* transactor = get_command_transactor_context();
+
+    if ((segments == NULL) || (segment_count == 0u) ||
+        (segments[0u].data == NULL) ||
+        (transactor->gpio_interface == NULL) ||
+        (transactor->host_interface == NULL))
     {
         return make_ex10_sdk_error(Ex10ModuleCommandTransactor,
                                    Ex10SdkErrorNullPointer);
     }
 
-    last_command.data   = (uint8_t const*)command_buffer;
-    last_command.length = command_length;
+    // The first segment always contains the command code.
+    last_command = segments[0u];
 
-    tracepoint(pi_ex10sdk, CMD_send, command_buffer, command_length);
+    size_t command_length = 0u;
+    for (size_t iter = 0u; iter < segment_count; ++iter)
+    {
+        command_length += segments[iter].length;
+        tracepoint(pi_ex10sdk,
+                   CMD_send,
+                   segments[iter].data,
+                   segments[iter].length);
+    }
+
+    struct Ex10TimeHelpers const*  time_helpers  = get_ex10_time_helpers();
+    struct Ex10PerfCounters const* perf_counters = get_ex10_perf_counters();
+    uint64_t const                 wait_start_ns = time_helpers->time_now_ns();
 
-    int const ret_val = command_transactor.gpio_interface->busy_wait_ready_n(
+    int const ret_val = transactor->gpio_interface->busy_wait_ready_n(
         ready_n_timeout_ms);
     if (ret_val != 0)
     {
+        perf_counters->record_ready_n_timeout();
         return make_ex10_sdk_error(Ex10ModuleCommandTransactor,
                                    Ex10SdkErrorTimeout);
     }
+    uint64_t const ready_n_wait_ns =
+        time_helpers->time_now_ns() - wait_start_ns;
 
-    int32_t const bytes_sent = command_transactor.host_interface->write(
-        command_buffer, command_length);
+    int32_t const bytes_sent =
+        transactor->host_interface->write_segments(segments, segment_count);
     if ((bytes_sent < 0) || ((uint32_t)bytes_sent != command_length))
     {
         return make_ex10_sdk_error(Ex10ModuleCommandTransactor,
                                    Ex10SdkErrorUnexpectedTxLength);
     }
 
+    perf_counters->record_spi_command(command_length, ready_n_wait_ns);
     return make_ex10_success();
 }
 
-static struct Ex10Result receive_response(void*    response_buffer,
-                                          size_t   response_buffer_length,
-                                          uint32_t ready_n_timeout_ms)
+static struct Ex10Result send_command(const void* command_buffer,
+                                      size_t      command_length,
+                                      uint32_t    ready_n_timeout_ms)
 {
-    if ((response_buffer == NULL) ||
-        (command_transactor.gpio_interface == NULL) ||
-        (command_transactor.host_interface == NULL))
+    struct ConstByteSpan const segment = {
+        .data   = (uint8_t const*)command_buffer,
+        .length = command_length,
+    };
+    return send_command_segments(&segment, 1u, ready_n_timeout_ms);
+}
+
+static struct Ex10Result receive_response_segments(
+    struct ByteSpan const* segments,
+    size_t                 segment_count,
+    uint32_t               ready_n_timeout_ms)
+{
+    struct CommandTransactor* transactor = get_command_transactor_context();
+
+    if ((segments == NULL) || (segment_count == 0u) ||
+        (transactor->gpio_interface == NULL) ||
+        (transactor->host_interface == NULL))
     {
         return make_ex10_sdk_error(Ex10ModuleCommandTransactor,
                                    Ex10SdkErrorNullPointer);
     }
 
+    size_t response_buffer_length = 0u;
+    for (size_t iter = 0u; iter < segment_count; ++iter)
+    {
+        if (segments[iter].data == NULL)
+        {
+            return make_ex10_sdk_error(Ex10ModuleCommandTransactor,
+                                       Ex10SdkErrorNullPointer);
+        }
+        response_buffer_length += segments[iter].length;
+    }
+
     // Note: The Ex10 can put 1 more byte in the response buffer than it
     // can accept in the command buffer.
     if (response_buffer_length > EX10_SPI_BURST_SIZE + 1u)
@@ -106,16 +165,23 @@ static struct Ex10Result receive_response(void*    response_buffer,
                                    Ex10SdkErrorBadParamValue);
     }
 
-    int const ret_val = command_transactor.gpio_interface->busy_wait_ready_n(
+    struct Ex10TimeHelpers const*  time_helpers  = get_ex10_time_helpers();
+    struct Ex10PerfCounters const* perf_counters = get_ex10_perf_counters();
+    uint64_t const                 wait_start_ns = time_helpers->time_now_ns();
+
+    int const ret_val = transactor->gpio_interface->busy_wait_ready_n(
         ready_n_timeout_ms);
     if (ret_val != 0)
     {
+        perf_counters->record_ready_n_timeout();
         return make_ex10_sdk_error(Ex10ModuleCommandTransactor,
                                    Ex10SdkErrorTimeout);
     }
+    uint64_t const ready_n_wait_ns =
+        time_helpers->time_now_ns() - wait_start_ns;
 
-    int32_t const bytes_received = command_transactor.host_interface->read(
-        response_buffer, response_buffer_length);
+    int32_t const bytes_received =
+        transactor->host_interface->read_segments(segments, segment_count);
 
     if (bytes_received < 0)
     {
@@ -123,6 +189,8 @@ static struct Ex10Result receive_response(void*    response_buffer,
                                                Ex10SdkErrorHostInterface,
                                                (uint32_t)bytes_received);
     }
+    perf_counters->record_spi_response((size_t)bytes_received,
+                                       ready_n_wait_ns);
 
     if ((size_t)bytes_received != response_buffer_length)
     {
@@ -136,19 +204,38 @@ static struct Ex10Result receive_response(void*    response_buffer,
             last_command.data, last_command.length, DataPrefixIndex);
 
         ex10_eputs("response:\n");
-        ex10_print_data(
-            response_buffer, (size_t)bytes_received, DataPrefixIndex);
-
+        for (size_t iter = 0u; iter < segment_count; ++iter)
+        {
+            ex10_print_data(
+                segments[iter].data, segments[iter].length, DataPrefixIndex);
+        }
 
         return make_ex10_commands_w_resp_error(
             Success, command_code, HostResultReceivedLengthIncorrect);
     }
 
-    tracepoint(pi_ex10sdk, CMD_recv, response_buffer, response_buffer_length);
+    for (size_t iter = 0u; iter < segment_count; ++iter)
+    {
+        tracepoint(pi_ex10sdk,
+                   CMD_recv,
+                   segments[iter].data,
+                   segments[iter].length);
+    }
 
     return make_ex10_success();
 }
 
+static struct Ex10Result receive_response(void*    response_buffer,
+                                          size_t   response_buffer_length,
+                                          uint32_t ready_n_timeout_ms)
+{
+    struct ByteSpan const segment = {
+        .data   = (uint8_t*)response_buffer,
+        .length = response_buffer_length,
+    };
+    return receive_response_segments(&segment, 1u, ready_n_timeout_ms);
+}
+
 static struct Ex10Result send_and_recv_bytes(const void* command_buffer,
                                              size_t      command_length,
                                              void*       response_buffer,
@@ -167,11 +254,13 @@ static struct Ex10Result send_and_recv_bytes(const void* command_buffer,
 }
 
 static const struct Ex10CommandTransactor ex10_command_transactor = {
-    .init                = init,
-    .deinit              = deinit,
-    .send_command        = send_command,
-    .receive_response    = receive_response,
-    .send_and_recv_bytes = send_and_recv_bytes,
+    .init                      = init,
+    .deinit                    = deinit,
+    .send_command              = send_command,
+    .receive_response          = receive_response,
+    .send_and_recv_bytes       = send_and_recv_bytes,
+    .send_command_segments     = send_command_segments,
+    .receive_response_segments = receive_response_segments,
 };
 
 struct Ex10CommandTransactor const* get_ex10_command_transactor(void)
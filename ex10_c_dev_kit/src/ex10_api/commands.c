@@ -40,10 +40,14 @@
  *       to resources shared across these threads. These resources include:
  *       - Access to the host and gpio interfaces.
  *       - Access to the command_buffer[] and response_buffer[] objects.
+ *
+ * @note The command_buffer[] and response_buffer[] are thread local, since
+ *       the client and IRQ_N monitor threads of different Ex10 contexts
+ *       access their Ex10 devices concurrently.
  */
 
-static uint8_t command_buffer[EX10_SPI_BURST_SIZE];
-static uint8_t response_buffer[EX10_SPI_BURST_SIZE];
+static EX10_THREAD_LOCAL uint8_t command_buffer[EX10_SPI_BURST_SIZE];
+static EX10_THREAD_LOCAL uint8_t response_buffer[EX10_SPI_BURST_SIZE];
 
 static uint16_t const command_code_length  = sizeof(uint8_t);
 static uint16_t const response_code_length = sizeof(uint8_t);
@@ -386,9 +390,7 @@ static struct Ex10Result command_read_fifo(enum FifoSelection fifo_select,
 
     struct Ex10Result ex10_result = make_ex10_success();
 
-    // The byte that follows byte[0] must be 32-bit aligned.
-    // byte[0] will contain the initial response code.
-    // byte[1] will contain the first byte of event packet data.
+    // The event packet data must be 32-bit aligned.
     if ((uintptr_t)bytes->data % sizeof(uint32_t) != 0u)
     {
         /*ex10_eprintf(
@@ -409,7 +411,6 @@ static struct Ex10Result command_read_fifo(enum FifoSelection fifo_select,
         size_t const fifo_len = (fifo_bytes_remaining > EX10_SPI_BURST_SIZE - 1)
                                     ? EX10_SPI_BURST_SIZE - 1
                                     : fifo_bytes_remaining;
-        size_t const resp_len = fifo_len + 1u;
 
         uint8_t const command[1u + sizeof(struct Ex10ReadFifoFormat)] = {
             (uint8_t)CommandReadFifo,
@@ -423,29 +424,31 @@ static struct Ex10Result command_read_fifo(enum FifoSelection fifo_select,
             return ex10_result;
         }
 
-        // The result code from the response will overwrite the last byte of
-        // the last fifo packet read into the buffer.
-        // Record its value so that it can be restored.
-        uint8_t const restore_byte = *(--data_ptr);
-
-        ex10_result = get_ex10_command_transactor()->receive_response(
-            data_ptr, resp_len, NOMINAL_READY_N_TIMEOUT_MS);
+        // The response code and the fifo data are received within the same
+        // host interface transaction: the response code into its own byte
+        // and the fifo data directly into the caller's buffer.
+        uint8_t               response_code = 0u;
+        struct ByteSpan const segments[]    = {
+            {.data = &response_code, .length = response_code_length},
+            {.data = data_ptr, .length = fifo_len},
+        };
+
+        ex10_result = get_ex10_command_transactor()->receive_response_segments(
+            segments,
+            sizeof(segments) / sizeof(segments[0u]),
+            NOMINAL_READY_N_TIMEOUT_MS);
         if (ex10_result.error)
         {
             return ex10_result;
         }
 
-        enum ResponseCode device_response = (enum ResponseCode)(*data_ptr);
+        enum ResponseCode device_response = (enum ResponseCode)response_code;
         if (device_response != Success)
         {
             return make_ex10_commands_w_resp_error(
                 device_response, CommandReadFifo, HostResultSuccess);
         }
 
-        *data_ptr++ = restore_byte;
-
-        // The next data_ptr position will transfer the response code into
-        // the last byte of the last response byte transferred.
         data_ptr += fifo_len;
         fifo_bytes_remaining -= fifo_len;
         bytes->length += fifo_len;
@@ -555,24 +558,18 @@ static struct Ex10Result command_start_upload(
                                    Ex10SdkErrorBadParamLength);
     }
 
-    uint8_t*             command_ptr = command_buffer;
-    uint8_t const* const command_end = &command_buffer[sizeof(command_buffer)];
-    *command_ptr++                   = (uint8_t)CommandStartUpload;
-    *command_ptr++                   = code;
-    int const copy_result            = ex10_memcpy(command_ptr,
-                                        (size_t)(command_end - command_ptr),
-                                        image_data->data,
-                                        image_data->length);
-    if (copy_result != 0)
-    {
-        return make_ex10_sdk_error(Ex10ModuleCommands, Ex10MemcpyFailed);
-    }
+    uint8_t const command_header[] = {(uint8_t)CommandStartUpload, code};
 
-    command_ptr += image_data->length;
+    // The image chunk is sent directly from the caller's buffer, following
+    // the command header, within the same host interface transaction.
+    struct ConstByteSpan const segments[] = {
+        {.data = command_header, .length = sizeof(command_header)},
+        {.data = image_data->data, .length = image_data->length},
+    };
 
-    return get_ex10_command_transactor()->send_command(
-        command_buffer,
-        (size_t)(command_ptr - command_buffer),
+    return get_ex10_command_transactor()->send_command_segments(
+        segments,
+        sizeof(segments) / sizeof(segments[0u]),
         NOMINAL_READY_N_TIMEOUT_MS);
 }
 
@@ -590,22 +587,16 @@ static struct Ex10Result command_continue_upload(
                                    Ex10SdkErrorBadParamLength);
     }
 
-    uint8_t*             command_ptr = command_buffer;
-    uint8_t const* const command_end = &command_buffer[sizeof(command_buffer)];
-    *command_ptr++                   = (uint8_t)CommandContinueUpload;
-    int const copy_result            = ex10_memcpy(command_ptr,
-                                        (size_t)(command_end - command_ptr),
-                                        image_data->data,
-                                        image_data->length);
-    if (copy_result != 0)
-    {
-        return make_ex10_sdk_error(Ex10ModuleCommands, Ex10MemcpyFailed);
-    }
-    command_ptr += image_data->length;
+    uint8_t const command_header[] = {(uint8_t)CommandContinueUpload};
 
-    return get_ex10_command_transactor()->send_command(
-        command_buffer,
-        (size_t)(command_ptr - command_buffer),
+    struct ConstByteSpan const segments[] = {
+        {.data = command_header, .length = sizeof(command_header)},
+        {.data = image_data->data, .length = image_data->length},
+    };
+
+    return get_ex10_command_transactor()->send_command_segments(
+        segments,
+        sizeof(segments) / sizeof(segments[0u]),
         NOMINAL_READY_N_TIMEOUT_MS);
 }
 
@@ -13,6 +13,7 @@
 
 
 #include <stddef.h>
+#include <string.h>
 
 #include "ex10_api/event_fifo_packet_types.h"
 #include "ex10_api/event_packet_parser.h"
@@ -388,6 +389,64 @@ static bool get_packet_type_valid(enum EventPacketType current_type)
 // clang-format on
 // IPJ_autogen }
 
+#define MIN_PACKET_LENGTH(packet_type) \
+    [packet_type] = sizeof(struct PacketHeader) + sizeof(struct packet_type)
+
+/**
+ * The minimum length in bytes of each packet type, including the packet
+ * header, indexed by the PacketHeader packet_type field. Invalid and unknown
+ * packet types are zero. This table must match get_packet_type_valid() and
+ * get_static_payload_length(); it replaces the two switch statements when
+ * validating packet headers.
+ */
+static uint16_t const min_packet_lengths[EVENT_PACKET_TYPE_COUNT] = {
+    MIN_PACKET_LENGTH(TxRampUp),
+    MIN_PACKET_LENGTH(TxRampDown),
+    MIN_PACKET_LENGTH(InventoryRoundSummary),
+    MIN_PACKET_LENGTH(QChanged),
+    MIN_PACKET_LENGTH(TagRead),
+    MIN_PACKET_LENGTH(Gen2Transaction),
+    MIN_PACKET_LENGTH(ContinuousInventorySummary),
+    MIN_PACKET_LENGTH(HelloWorld),
+    MIN_PACKET_LENGTH(Custom),
+    MIN_PACKET_LENGTH(PowerControlLoopSummary),
+    MIN_PACKET_LENGTH(AggregateOpSummary),
+    MIN_PACKET_LENGTH(Halted),
+    MIN_PACKET_LENGTH(FifoOverflowPacket),
+    MIN_PACKET_LENGTH(Ex10ResultPacket),
+    MIN_PACKET_LENGTH(WriteProfileData),
+    MIN_PACKET_LENGTH(SjcMeasurement),
+    MIN_PACKET_LENGTH(Debug),
+};
+
+static struct EventFifoPacket const invalid_event_packet = {
+    .packet_type         = InvalidPacket,
+    .us_counter          = 0,
+    .static_data         = NULL,
+    .static_data_length  = 0u,
+    .dynamic_data        = NULL,
+    .dynamic_data_length = 0u,
+    .is_valid            = false,
+};
+
+/**
+ * @return bool true if the packet header is valid and the packet is
+ *              contained within the remaining_length bytes.
+ */
+static bool packet_header_valid(struct PacketHeader const* packet_header,
+                                size_t                     remaining_length)
+{
+    size_t const min_packet_length =
+        min_packet_lengths[packet_header->packet_type];
+    size_t const packet_length_bytes =
+        packet_header->packet_length * sizeof(uint32_t);
+
+    return (min_packet_length > 0u) &&
+           (packet_header->sha == event_fifo_sha) &&
+           (packet_length_bytes >= min_packet_length) &&
+           (packet_length_bytes <= remaining_length);
+}
+
 static struct EventFifoPacket parse_event_packet(struct ConstByteSpan* bytes)
 {
     struct PacketHeader const* packet_header =
@@ -399,21 +458,19 @@ static struct EventFifoPacket parse_event_packet(struct ConstByteSpan* bytes)
     size_t const packet_length_bytes =
         packet_header->packet_length * sizeof(uint32_t);
 
-    // get_static_payload_length() returns 0 for unknown packets.
-    size_t const static_data_length =
-        get_static_payload_length(packet_header->packet_type);
-
+    // The static data length is 0 for invalid and unknown packets.
     size_t const min_packet_length =
-        sizeof(struct PacketHeader) + static_data_length;
+        min_packet_lengths[packet_header->packet_type];
+    size_t const static_data_length =
+        (min_packet_length > 0u)
+            ? min_packet_length - sizeof(struct PacketHeader)
+            : 0u;
 
     size_t         dynamic_data_length = 0u;
     uint8_t const* dynamic_data        = NULL;
 
-    bool const is_valid = get_packet_type_valid(packet_header->packet_type) &&
-                          (packet_header->sha == event_fifo_sha) &&
-                          (packet_length_bytes >= min_packet_length) &&
-                          (packet_length_bytes <= bytes->length) &&
-                          (bytes->length > 0);
+    bool const is_valid = (bytes->length > 0) &&
+                          packet_header_valid(packet_header, bytes->length);
 
     if (is_valid && (static_data_length > 0u))
     {
@@ -452,17 +509,7 @@ static struct EventFifoPacket parse_event_packet(struct ConstByteSpan* bytes)
         // its packet processing within the current EventFifoBuffer.
         bytes->length = 0u;
 
-        struct EventFifoPacket const invalid_packet = {
-            .packet_type         = InvalidPacket,
-            .us_counter          = 0,
-            .static_data         = NULL,
-            .static_data_length  = 0u,
-            .dynamic_data        = NULL,
-            .dynamic_data_length = 0u,
-            .is_valid            = false,
-        };
-
-        return invalid_packet;
+        return invalid_event_packet;
     }
 
     struct EventFifoPacket const packet = {
@@ -481,6 +528,87 @@ static struct EventFifoPacket parse_event_packet(struct ConstByteSpan* bytes)
     return packet;
 }
 
+static size_t scan_event_packets(struct ConstByteSpan     bytes,
+                                 struct EventPacketIndex* index)
+{
+    memset(index->type_counts, 0, sizeof(index->type_counts));
+    index->invalid_packet = false;
+
+    size_t packet_count = 0u;
+    size_t offset       = 0u;
+
+    // The packet offsets are stored as uint16_t; an EventFifo buffer never
+    // exceeds EX10_EVENT_FIFO_SIZE bytes.
+    while ((offset < bytes.length) &&
+           (packet_count < EVENT_PACKET_INDEX_CAPACITY) &&
+           (offset <= UINT16_MAX))
+    {
+        struct PacketHeader const* packet_header =
+            (struct PacketHeader const*)(bytes.data + offset);
+
+        index->packet_offsets[packet_count] = (uint16_t)offset;
+        if (packet_header_valid(packet_header, bytes.length - offset) ==
+            false)
+        {
+            // Report the failure using the parse_event_packet() diagnostics.
+            struct ConstByteSpan invalid_bytes = {
+                .data   = bytes.data + offset,
+                .length = bytes.length - offset,
+            };
+            parse_event_packet(&invalid_bytes);
+
+            index->packet_types[packet_count] = (uint8_t)InvalidPacket;
+            index->invalid_packet             = true;
+            packet_count += 1u;
+            break;
+        }
+
+        index->packet_types[packet_count] = packet_header->packet_type;
+        index->type_counts[packet_header->packet_type] += 1u;
+        packet_count += 1u;
+
+        offset += packet_header->packet_length * sizeof(uint32_t);
+    }
+
+    index->packet_count   = (uint16_t)packet_count;
+    index->indexed_length = offset;
+
+    return packet_count;
+}
+
+static struct EventFifoPacket get_indexed_packet(
+    uint8_t const*                 data,
+    struct EventPacketIndex const* index,
+    size_t                         position)
+{
+    if (index->packet_types[position] == InvalidPacket)
+    {
+        return invalid_event_packet;
+    }
+
+    uint8_t const* packet_data = data + index->packet_offsets[position];
+    struct PacketHeader const* packet_header =
+        (struct PacketHeader const*)packet_data;
+
+    size_t const min_packet_length =
+        min_packet_lengths[packet_header->packet_type];
+    size_t const packet_length_bytes =
+        packet_header->packet_length * sizeof(uint32_t);
+
+    struct EventFifoPacket const packet = {
+        .packet_type = packet_header->packet_type,
+        .us_counter  = packet_header->us_counter,
+        .static_data = (union PacketData const*)(packet_data +
+                                                 sizeof(struct PacketHeader)),
+        .static_data_length  = min_packet_length - sizeof(struct PacketHeader),
+        .dynamic_data        = packet_data + min_packet_length,
+        .dynamic_data_length = packet_length_bytes - min_packet_length,
+        .is_valid            = true,
+    };
+
+    return packet;
+}
+
 static struct PacketHeader make_packet_header(
     enum EventPacketType event_packet_type)
 {
@@ -505,6 +633,8 @@ static const struct Ex10EventParser ex10_event_parser = {
     .get_packet_type_valid     = get_packet_type_valid,
     .parse_event_packet        = parse_event_packet,
     .make_packet_header        = make_packet_header,
+    .scan_event_packets        = scan_event_packets,
+    .get_indexed_packet        = get_indexed_packet,
 };
 
 struct Ex10EventParser const* get_ex10_event_parser(void)
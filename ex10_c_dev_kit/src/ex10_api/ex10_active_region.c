@@ -22,22 +22,34 @@
 
 #include "ex10_api/application_registers.h"
 #include "ex10_api/ex10_active_region.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_macros.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_protocol.h"
 #include "ex10_api/ex10_result.h"
 #include "ex10_regulatory/ex10_regulatory_region.h"
 
-static struct Ex10Region const* region = NULL;
-// The custom active region is used for test features such as setting a single
-// frequency and remain on.
-static struct Ex10Region custom_active_region;
-static channel_index_t   single_freq_channel[1] = {0};
-static uint32_t          tcxo_frequency_khz     = 0;
-static channel_index_t   channel_hop_table[MAX_CHANNELS];
-static uint32_t          channel_table_khz[MAX_CHANNELS];
-static channel_index_t   active_channel_index  = 0;
-static channel_size_t    len_channel_hop_table = 0;
+/// The active region state of one Impinj Reader Chip context.
+struct ActiveRegionContext
+{
+    struct Ex10Region const* region;
+    // The custom active region is used for test features such as setting a
+    // single frequency and remain on.
+    struct Ex10Region custom_active_region;
+    channel_index_t   single_freq_channel[1];
+    uint32_t          tcxo_frequency_khz;
+    channel_index_t   channel_hop_table[MAX_CHANNELS];
+    uint32_t          channel_table_khz[MAX_CHANNELS];
+    channel_index_t   active_channel_index;
+    channel_size_t    len_channel_hop_table;
+};
+
+static struct ActiveRegionContext active_region_contexts[EX10_MAX_CONTEXTS];
+
+static struct ActiveRegionContext* get_active_region_context(void)
+{
+    return &active_region_contexts[ex10_context_index()];
+}
 
 /**
  * @note These values must match the values enumerated in the documentation
@@ -140,12 +152,14 @@ static struct Ex10Result build_channel_table(
 static struct Ex10Result set_region(enum Ex10RegionId region_id,
                                     uint32_t          tcxo_freq_khz)
 {
-    tcxo_frequency_khz   = tcxo_freq_khz;
-    active_channel_index = 0;
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    active->tcxo_frequency_khz   = tcxo_freq_khz;
+    active->active_channel_index = 0;
 
     /* Find region */
-    region = get_ex10_regulatory()->get_region(region_id);
-    if (region->region_id == REGION_NOT_DEFINED)
+    active->region = get_ex10_regulatory()->get_region(region_id);
+    if (active->region->region_id == REGION_NOT_DEFINED)
     {
         ex10_eprintf("No region defined for ID %d\n", region_id);
         return make_ex10_sdk_error(Ex10ModuleRegion, Ex10SdkErrorBadParamValue);
@@ -153,45 +167,50 @@ static struct Ex10Result set_region(enum Ex10RegionId region_id,
 
     /* Build channel hop table (kHz) */
     struct Ex10Result ex10_result =
-        build_channel_table(&region->regulatory_channels,
-                            channel_hop_table,
-                            &len_channel_hop_table);
+        build_channel_table(&active->region->regulatory_channels,
+                            active->channel_hop_table,
+                            &active->len_channel_hop_table);
     if (ex10_result.error)
     {
         return ex10_result;
     }
-    if (len_channel_hop_table > MAX_CHANNELS)
+    if (active->len_channel_hop_table > MAX_CHANNELS)
     {
         ex10_eprintf("Hop table length %d exceeds max %d\n",
-                     len_channel_hop_table,
+                     active->len_channel_hop_table,
                      MAX_CHANNELS);
         return make_ex10_sdk_error(Ex10ModuleRegion, Ex10SdkErrorBadParamValue);
     }
 
-    for (channel_index_t iter = 0; iter < len_channel_hop_table; iter++)
+    for (channel_index_t iter = 0; iter < active->len_channel_hop_table; iter++)
     {
-        channel_table_khz[iter] = get_ex10_regulatory()->calculate_channel_khz(
-            region->region_id, channel_hop_table[iter]);
+        active->channel_table_khz[iter] =
+            get_ex10_regulatory()->calculate_channel_khz(
+                active->region->region_id, active->channel_hop_table[iter]);
     }
 
-    active_channel_index = 0;
+    active->active_channel_index = 0;
 
     return make_ex10_success();
 }
 
 static enum Ex10RegionId get_region_id(void)
 {
-    if (region == NULL)
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    if (active->region == NULL)
     {
-        region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
+        active->region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
     }
-    return region->region_id;
+    return active->region->region_id;
 }
 
 static channel_index_t get_next_index(void)
 {
-    channel_index_t next_index = active_channel_index + 1;
-    if (next_index == len_channel_hop_table)
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    channel_index_t next_index = active->active_channel_index + 1;
+    if (next_index == active->len_channel_hop_table)
     {
         next_index = 0;
     }
@@ -200,28 +219,38 @@ static channel_index_t get_next_index(void)
 
 static void update_active_channel(void)
 {
-    active_channel_index = get_next_index();
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    active->active_channel_index = get_next_index();
 }
 
 static channel_size_t get_channel_table_size(void)
 {
-    return len_channel_hop_table;
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    return active->len_channel_hop_table;
 }
 
 static uint32_t get_active_channel_khz(void)
 {
-    return channel_table_khz[active_channel_index];
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    return active->channel_table_khz[active->active_channel_index];
 }
 
 static uint32_t get_next_channel_khz(void)
 {
+    struct ActiveRegionContext* active = get_active_region_context();
+
     channel_index_t const next_channel_index = get_next_index();
-    return channel_table_khz[next_channel_index];
+    return active->channel_table_khz[next_channel_index];
 }
 
 static channel_index_t get_active_channel_index(void)
 {
-    return active_channel_index;
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    return active->active_channel_index;
 }
 
 static struct Ex10Result get_adjacent_channel_khz(
@@ -229,31 +258,34 @@ static struct Ex10Result get_adjacent_channel_khz(
     channel_offset_t channel_offset,
     uint32_t*        adjacent_channel_khz)
 {
+    struct ActiveRegionContext* active = get_active_region_context();
+
     if (adjacent_channel_khz == NULL)
     {
         return make_ex10_sdk_error(Ex10ModuleRegion, Ex10SdkErrorNullPointer);
     }
 
     // 0 is the default result if the calculated channel out of range
-    uint32_t              result_khz      = 0;
-    channel_index_t const current_channel = channel_hop_table[channel_index];
+    uint32_t              result_khz = 0;
+    channel_index_t const current_channel =
+        active->channel_hop_table[channel_index];
 
-    if (region == NULL)
+    if (active->region == NULL)
     {
-        region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
+        active->region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
     }
-    if (region->regulatory_channels.usable == NULL)
+    if (active->region->regulatory_channels.usable == NULL)
     {
         // The region's channels are linearly spaced from
         // the start frequency though the number of channels
         channel_offset_t const adjacent_channel =
             (channel_offset_t)(current_channel + channel_offset);
 
-        channel_size_t const count = region->regulatory_channels.count;
+        channel_size_t const count = active->region->regulatory_channels.count;
         if (adjacent_channel <= (channel_offset_t)count && adjacent_channel > 0)
         {
             result_khz = get_ex10_regulatory()->calculate_channel_khz(
-                region->region_id, (channel_index_t)adjacent_channel);
+                active->region->region_id, (channel_index_t)adjacent_channel);
         }
     }
     else
@@ -261,8 +293,10 @@ static struct Ex10Result get_adjacent_channel_khz(
         // The region uses a limited number of channels in the space
 
         // find the current channel in the usable channels
-        uint16_t const* channel_array = region->regulatory_channels.usable;
-        int usable_count = (int)region->regulatory_channels.usable_count;
+        uint16_t const* channel_array =
+            active->region->regulatory_channels.usable;
+        int usable_count =
+            (int)active->region->regulatory_channels.usable_count;
         int iter;
         for (iter = 0; iter < usable_count; iter++)
         {
@@ -283,7 +317,7 @@ static struct Ex10Result get_adjacent_channel_khz(
         if (iter >= 0 && iter < usable_count)
         {
             result_khz = get_ex10_regulatory()->calculate_channel_khz(
-                region->region_id, channel_array[iter]);
+                active->region->region_id, channel_array[iter]);
         }
     }
 
@@ -293,11 +327,13 @@ static struct Ex10Result get_adjacent_channel_khz(
 
 static uint32_t get_channel_spacing(void)
 {
-    if (region == NULL)
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    if (active->region == NULL)
     {
-        region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
+        active->region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
     }
-    return region->regulatory_channels.spacing_khz;
+    return active->region->regulatory_channels.spacing_khz;
 }
 
 static channel_index_t get_next_channel_index(void)
@@ -307,9 +343,11 @@ static channel_index_t get_next_channel_index(void)
 
 static channel_index_t get_channel_index(uint32_t frequency_khz)
 {
-    for (channel_index_t iter = 0; iter < len_channel_hop_table; iter++)
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    for (channel_index_t iter = 0; iter < active->len_channel_hop_table; iter++)
     {
-        if (channel_table_khz[iter] == frequency_khz)
+        if (active->channel_table_khz[iter] == frequency_khz)
         {
             return iter;
         }
@@ -321,42 +359,48 @@ static channel_index_t get_channel_index(uint32_t frequency_khz)
 static struct Ex10Result get_next_channel_regulatory_timers(
     struct Ex10RegulatoryTimers* timers)
 {
+    struct ActiveRegionContext* active = get_active_region_context();
+
     if (timers == NULL)
     {
         return make_ex10_sdk_error(Ex10ModuleRegion, Ex10SdkErrorNullPointer);
     }
 
-    if (region == NULL)
+    if (active->region == NULL)
     {
-        region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
+        active->region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
     }
     struct TimestampFields time_us;
     get_ex10_protocol()->read(&timestamp_reg, &time_us);
 
     uint32_t const time_ms = time_us.current_timestamp_us / 1000;
     get_ex10_regulatory()->get_regulatory_timers(
-        region->region_id, get_next_index(), time_ms, timers);
+        active->region->region_id, get_next_index(), time_ms, timers);
     return make_ex10_success();
 }
 
 static struct Ex10Result get_regulatory_timers(
     struct Ex10RegulatoryTimers* timers)
 {
+    struct ActiveRegionContext* active = get_active_region_context();
+
     if (timers == NULL)
     {
         return make_ex10_sdk_error(Ex10ModuleRegion, Ex10SdkErrorNullPointer);
     }
 
-    if (region == NULL)
+    if (active->region == NULL)
     {
-        region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
+        active->region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
     }
     struct TimestampFields time_us;
     get_ex10_protocol()->read(&timestamp_reg, &time_us);
 
     uint32_t const time_ms = time_us.current_timestamp_us / 1000;
-    get_ex10_regulatory()->get_regulatory_timers(
-        region->region_id, active_channel_index, time_ms, timers);
+    get_ex10_regulatory()->get_regulatory_timers(active->region->region_id,
+                                                 active->active_channel_index,
+                                                 time_ms,
+                                                 timers);
     return make_ex10_success();
 }
 
@@ -367,11 +411,13 @@ static struct Ex10Result get_regulatory_timers(
  */
 static uint32_t get_pll_r_divider(void)
 {
-    if (region == NULL)
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    if (active->region == NULL)
     {
-        region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
+        active->region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
     }
-    return region->pll_divider;
+    return active->region->pll_divider;
 }
 
 /**
@@ -383,8 +429,11 @@ static uint32_t get_pll_r_divider(void)
  */
 static uint16_t calculate_n_divider(uint32_t freq_khz, uint32_t r_divider)
 {
-    return (uint16_t)((4 * freq_khz * r_divider + tcxo_frequency_khz / 2) /
-                      tcxo_frequency_khz);
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    return (uint16_t)((4 * freq_khz * r_divider +
+                       active->tcxo_frequency_khz / 2) /
+                      active->tcxo_frequency_khz);
 }
 
 /**
@@ -433,6 +482,8 @@ static struct Ex10Result get_synthesizer_frequency_khz(uint8_t  r_divider_index,
                                                        uint16_t n_divider,
                                                        uint32_t* frequency_khz)
 {
+    struct ActiveRegionContext* active = get_active_region_context();
+
     if (frequency_khz == NULL)
     {
         return make_ex10_sdk_error(Ex10ModuleRegion, Ex10SdkErrorNullPointer);
@@ -443,8 +494,9 @@ static struct Ex10Result get_synthesizer_frequency_khz(uint8_t  r_divider_index,
         // For F tcxo = 24,000 kHz, F lo = 930,000 kHz, Rdiv = 240
         // The expected max N div < 40E3, F lo 930E3 > UIN32_MAX,
         // Use uint64_t for the numerator.
-        uint32_t const r_divider   = divider_value_to_index[r_divider_index];
-        uint64_t const numerator   = ((uint64_t)tcxo_frequency_khz) * n_divider;
+        uint32_t const r_divider = divider_value_to_index[r_divider_index];
+        uint64_t const numerator =
+            ((uint64_t)active->tcxo_frequency_khz) * n_divider;
         uint32_t const denominator = 4u * r_divider;
         uint64_t const freq_khz    = numerator / denominator;
 
@@ -460,92 +512,114 @@ static struct Ex10Result get_synthesizer_frequency_khz(uint8_t  r_divider_index,
 
 static enum RfFilter get_rf_filter(void)
 {
-    if (region == NULL)
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    if (active->region == NULL)
     {
-        region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
+        active->region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
     }
-    return region->rf_filter;
+    return active->region->rf_filter;
 }
 
 static void set_single_frequency(uint32_t frequency_khz)
 {
-    if (region == NULL)
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    if (active->region == NULL)
     {
-        region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
+        active->region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
     }
 
     // Grab the channel index from the single frequency
-    single_freq_channel[0] = get_ex10_regulatory()->calculate_channel_index(
-        region->region_id, frequency_khz);
+    active->single_freq_channel[0] =
+        get_ex10_regulatory()->calculate_channel_index(
+            active->region->region_id, frequency_khz);
 
     // Update the region for the setter
-    custom_active_region                            = *region;
-    custom_active_region.regulatory_channels.usable = single_freq_channel;
-    custom_active_region.regulatory_channels.usable_count =
-        sizeof(single_freq_channel) / sizeof(single_freq_channel[0u]);
-    custom_active_region.regulatory_channels.count = 1;
+    active->custom_active_region = *active->region;
+    active->custom_active_region.regulatory_channels.usable =
+        active->single_freq_channel;
+    active->custom_active_region.regulatory_channels.usable_count =
+        sizeof(active->single_freq_channel) /
+        sizeof(active->single_freq_channel[0u]);
+    active->custom_active_region.regulatory_channels.count = 1;
 
     // Set the now single frequency region
-    get_ex10_regulatory()->set_region(region->region_id, &custom_active_region);
+    get_ex10_regulatory()->set_region(active->region->region_id,
+                                      &active->custom_active_region);
     // Update the local region to reflect
-    set_region(region->region_id, tcxo_frequency_khz);
+    set_region(active->region->region_id, active->tcxo_frequency_khz);
 }
 
 static void disable_regulatory_timers(void)
 {
-    if (region == NULL)
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    if (active->region == NULL)
     {
-        region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
+        active->region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
     }
 
     // Update the region for the setter
-    custom_active_region                   = *region;
-    custom_active_region.regulatory_timers = regulatory_timers_disabled;
+    active->custom_active_region                   = *active->region;
+    active->custom_active_region.regulatory_timers = regulatory_timers_disabled;
 
     // Set the now no regulatory timer region
-    get_ex10_regulatory()->set_region(region->region_id, &custom_active_region);
+    get_ex10_regulatory()->set_region(active->region->region_id,
+                                      &active->custom_active_region);
     // Update the local region to reflect
-    set_region(region->region_id, tcxo_frequency_khz);
+    set_region(active->region->region_id, active->tcxo_frequency_khz);
 }
 
 static void reenable_regulatory_timers(void)
 {
-    if (region == NULL)
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    if (active->region == NULL)
     {
-        region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
+        active->region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
     }
 
-    custom_active_region = *region;
+    active->custom_active_region = *active->region;
 
     // Set the region to NULL to get the default timers
-    get_ex10_regulatory()->set_region(region->region_id, NULL);
-    custom_active_region.regulatory_timers =
-        get_ex10_regulatory()->get_region(region->region_id)->regulatory_timers;
+    get_ex10_regulatory()->set_region(active->region->region_id, NULL);
+    active->custom_active_region.regulatory_timers =
+        get_ex10_regulatory()
+            ->get_region(active->region->region_id)
+            ->regulatory_timers;
 
     // Set the now no regulatory timer region
-    get_ex10_regulatory()->set_region(region->region_id, &custom_active_region);
+    get_ex10_regulatory()->set_region(active->region->region_id,
+                                      &active->custom_active_region);
     // Update the local region to reflect
-    set_region(region->region_id, tcxo_frequency_khz);
+    set_region(active->region->region_id, active->tcxo_frequency_khz);
 }
 
 static void regulatory_timer_set_start(uint32_t time_ms)
 {
+    struct ActiveRegionContext* active = get_active_region_context();
+
     get_ex10_regulatory()->regulatory_timer_set_start(
-        region->region_id, active_channel_index, time_ms);
+        active->region->region_id, active->active_channel_index, time_ms);
 }
 
 static void regulatory_timer_set_end(uint32_t time_ms)
 {
-    if (region == NULL)
+    struct ActiveRegionContext* active = get_active_region_context();
+
+    if (active->region == NULL)
     {
-        region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
+        active->region = get_ex10_regulatory()->get_region(REGION_NOT_DEFINED);
     }
     get_ex10_regulatory()->regulatory_timer_set_end(
-        region->region_id, active_channel_index, time_ms);
+        active->region->region_id, active->active_channel_index, time_ms);
 }
 
 static struct Ex10Result update_channel_time_tracking(void)
 {
+    struct ActiveRegionContext* active = get_active_region_context();
+
     // To avoid guessing at SDK state, we pull the last ramp up/down times
     // and channels to set here.
     // Note: Both the start and end time are set only if CW is off.
@@ -584,9 +658,9 @@ static struct Ex10Result update_channel_time_tracking(void)
         down_channel != channel_index_invalid)
     {
         get_ex10_regulatory()->regulatory_timer_set_start(
-            region->region_id, up_channel, last_up_ms.time_ms);
+            active->region->region_id, up_channel, last_up_ms.time_ms);
         get_ex10_regulatory()->regulatory_timer_set_end(
-            region->region_id, down_channel, last_down_ms.time_ms);
+            active->region->region_id, down_channel, last_down_ms.time_ms);
     }
     return make_ex10_success();
 }
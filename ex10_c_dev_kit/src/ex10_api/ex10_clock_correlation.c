@@ -0,0 +1,324 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <stdbool.h>
+
+#include "board/ex10_osal.h"
+#include "board/time_helpers.h"
+#include "ex10_api/application_registers.h"
+#include "ex10_api/ex10_clock_correlation.h"
+#include "ex10_api/ex10_context.h"
+#include "ex10_api/ex10_protocol.h"
+
+/// The nominal number of host clock ns per device clock us.
+static double const nominal_ns_per_us = 1000.0;
+
+/// A sample further than this from the estimate, beyond the uncertainty of
+/// the sample, restarts the estimation.
+static int64_t const max_sample_error_ns = 1000 * 1000 * 1000;
+
+/// Samples whose register read took longer than this multiple of the
+/// shortest read in the window are excluded from the fit.
+static uint64_t const round_trip_outlier_factor = 2u;
+
+/// The device time span required before the drift is estimated.
+static int64_t const min_drift_span_us = 100 * 1000;
+
+/**
+ * @struct ClockSample
+ * A device timestamp register read, bracketed by host clock readings.
+ */
+struct ClockSample
+{
+    /// The device time, unwrapped to 64 bits.
+    uint64_t device_time_us;
+    /// The host time midway between the readings before and after the read.
+    uint64_t host_time_ns;
+    /// The host time between the readings before and after the read.
+    uint64_t round_trip_ns;
+};
+
+/**
+ * @struct ClockCorrelationContext
+ * The clock samples and the estimate of an Ex10 context.
+ */
+struct ClockCorrelationContext
+{
+    struct ClockSample samples[EX10_CLOCK_CORRELATION_SAMPLES];
+    size_t             sample_count;
+    size_t             next_sample;
+    uint32_t           sample_interval_ms;
+
+    /// The estimate: host_time_ns = reference_host_ns +
+    ///     ns_per_us * (device_time_us - reference_device_us)
+    /// The estimate is written by the sampling thread and may be read by
+    /// any thread; it is guarded by the lock.
+    ex10_mutex_t lock;
+    size_t       fit_count;
+    uint64_t     reference_device_us;
+    uint64_t     reference_host_ns;
+    double       ns_per_us;
+    uint64_t     min_round_trip_ns;
+};
+
+static struct ClockCorrelationContext clock_contexts[EX10_MAX_CONTEXTS];
+static struct Ex10ContextOnce         clock_contexts_once;
+
+static void init_clock_contexts(void)
+{
+    for (size_t index = 0u; index < EX10_MAX_CONTEXTS; ++index)
+    {
+        ex10_mutex_init(&clock_contexts[index].lock);
+    }
+}
+
+static struct ClockCorrelationContext* get_correlation_context(void)
+{
+    ex10_context_init_once(&clock_contexts_once, init_clock_contexts);
+    return &clock_contexts[ex10_context_index()];
+}
+
+static int64_t round_to_int64(double value)
+{
+    return (int64_t)((value < 0.0) ? (value - 0.5) : (value + 0.5));
+}
+
+/**
+ * Unwrap a 32-bit device time relative to a 64-bit reference device time.
+ * The device time must be within 2^31 us of the reference.
+ */
+static uint64_t unwrap_device_time(uint64_t reference_us, uint32_t time_us)
+{
+    int32_t const delta_us = (int32_t)(time_us - (uint32_t)reference_us);
+    return (uint64_t)((int64_t)reference_us + delta_us);
+}
+
+/**
+ * @return int64_t The host time in ns estimated for the 64-bit device time.
+ *                 Must be called with the lock held and fit_count > 0.
+ */
+static int64_t estimate_host_ns(struct ClockCorrelationContext const* context,
+                                uint64_t device_time_us)
+{
+    int64_t const delta_us =
+        (int64_t)(device_time_us - context->reference_device_us);
+    return (int64_t)context->reference_host_ns +
+           round_to_int64((double)delta_us * context->ns_per_us);
+}
+
+/**
+ * Fit a line through the samples, relative to the most recent sample.
+ * Samples with an outlying round trip are excluded.
+ */
+static void fit_samples(struct ClockCorrelationContext* context)
+{
+    size_t const newest_index =
+        (context->next_sample + EX10_CLOCK_CORRELATION_SAMPLES - 1u) %
+        EX10_CLOCK_CORRELATION_SAMPLES;
+    struct ClockSample const* newest = &context->samples[newest_index];
+
+    uint64_t min_round_trip_ns = UINT64_MAX;
+    for (size_t index = 0u; index < context->sample_count; ++index)
+    {
+        if (context->samples[index].round_trip_ns < min_round_trip_ns)
+        {
+            min_round_trip_ns = context->samples[index].round_trip_ns;
+        }
+    }
+    uint64_t const max_round_trip_ns =
+        min_round_trip_ns * round_trip_outlier_factor + 1u;
+
+    size_t  fit_count = 0u;
+    double  sum_x     = 0.0;
+    double  sum_y     = 0.0;
+    double  sum_xx    = 0.0;
+    double  sum_xy    = 0.0;
+    int64_t min_x     = 0;
+    for (size_t index = 0u; index < context->sample_count; ++index)
+    {
+        struct ClockSample const* sample = &context->samples[index];
+        if (sample->round_trip_ns > max_round_trip_ns)
+        {
+            continue;
+        }
+        int64_t const x_us =
+            (int64_t)(sample->device_time_us - newest->device_time_us);
+        double const x = (double)x_us;
+        double const y =
+            (double)(int64_t)(sample->host_time_ns - newest->host_time_ns);
+        sum_x += x;
+        sum_y += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+        min_x = (x_us < min_x) ? x_us : min_x;
+        fit_count += 1u;
+    }
+
+    double const n         = (double)fit_count;
+    double const variance  = sum_xx - sum_x * sum_x / n;
+    double       ns_per_us = nominal_ns_per_us;
+    if (-min_x >= min_drift_span_us && variance > 0.0)
+    {
+        ns_per_us = (sum_xy - sum_x * sum_y / n) / variance;
+    }
+    double const intercept_ns = (sum_y - ns_per_us * sum_x) / n;
+
+    ex10_mutex_lock(&context->lock);
+    context->fit_count           = fit_count;
+    context->reference_device_us = newest->device_time_us;
+    context->reference_host_ns =
+        (uint64_t)((int64_t)newest->host_time_ns +
+                   round_to_int64(intercept_ns));
+    context->ns_per_us         = ns_per_us;
+    context->min_round_trip_ns = min_round_trip_ns;
+    ex10_mutex_unlock(&context->lock);
+}
+
+static void init(uint32_t sample_interval_ms)
+{
+    struct ClockCorrelationContext* context = get_correlation_context();
+
+    ex10_mutex_lock(&context->lock);
+    context->sample_count       = 0u;
+    context->next_sample        = 0u;
+    context->sample_interval_ms = sample_interval_ms;
+    context->fit_count          = 0u;
+    context->ns_per_us          = nominal_ns_per_us;
+    ex10_mutex_unlock(&context->lock);
+}
+
+static struct Ex10Result sample(void)
+{
+    struct ClockCorrelationContext* context     = get_correlation_context();
+    struct Ex10TimeHelpers const*   host_time   = get_ex10_time_helpers();
+    struct TimestampFields          device_time = {.current_timestamp_us = 0u};
+
+    uint64_t const          before_ns = host_time->time_now_ns();
+    struct Ex10Result const ex10_result =
+        get_ex10_protocol()->read(&timestamp_reg, &device_time);
+    uint64_t const after_ns = host_time->time_now_ns();
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    struct ClockSample new_sample = {
+        .device_time_us = device_time.current_timestamp_us,
+        .host_time_ns   = before_ns + (after_ns - before_ns) / 2u,
+        .round_trip_ns  = after_ns - before_ns,
+    };
+
+    if (context->sample_count > 0u)
+    {
+        ex10_mutex_lock(&context->lock);
+        new_sample.device_time_us = unwrap_device_time(
+            context->reference_device_us, device_time.current_timestamp_us);
+        int64_t const error_ns =
+            estimate_host_ns(context, new_sample.device_time_us) -
+            (int64_t)new_sample.host_time_ns;
+        ex10_mutex_unlock(&context->lock);
+
+        // The error of the host time midpoint is at most half the round trip.
+        int64_t const max_error_ns =
+            max_sample_error_ns + (int64_t)new_sample.round_trip_ns;
+        if (error_ns > max_error_ns || error_ns < -max_error_ns)
+        {
+            // The device was reset, or was not sampled for so long that its
+            // time cannot be unwrapped: restart the estimation.
+            context->sample_count     = 0u;
+            context->next_sample      = 0u;
+            new_sample.device_time_us = device_time.current_timestamp_us;
+        }
+    }
+
+    context->samples[context->next_sample] = new_sample;
+    context->next_sample =
+        (context->next_sample + 1u) % EX10_CLOCK_CORRELATION_SAMPLES;
+    if (context->sample_count < EX10_CLOCK_CORRELATION_SAMPLES)
+    {
+        context->sample_count += 1u;
+    }
+
+    fit_samples(context);
+    return make_ex10_success();
+}
+
+static struct Ex10Result sample_if_due(void)
+{
+    struct ClockCorrelationContext* context = get_correlation_context();
+
+    if (context->sample_count > 0u)
+    {
+        size_t const newest_index =
+            (context->next_sample + EX10_CLOCK_CORRELATION_SAMPLES - 1u) %
+            EX10_CLOCK_CORRELATION_SAMPLES;
+        uint64_t const elapsed_ns = get_ex10_time_helpers()->time_now_ns() -
+                                    context->samples[newest_index].host_time_ns;
+        if (elapsed_ns < (uint64_t)context->sample_interval_ms * 1000000u)
+        {
+            return make_ex10_success();
+        }
+    }
+    return sample();
+}
+
+static uint64_t device_to_host_ns(uint32_t device_time_us)
+{
+    struct ClockCorrelationContext* context = get_correlation_context();
+
+    uint64_t host_time_ns = 0u;
+    ex10_mutex_lock(&context->lock);
+    if (context->fit_count > 0u)
+    {
+        uint64_t const device_time = unwrap_device_time(
+            context->reference_device_us, device_time_us);
+        host_time_ns = (uint64_t)estimate_host_ns(context, device_time);
+    }
+    ex10_mutex_unlock(&context->lock);
+
+    return host_time_ns;
+}
+
+static uint64_t packet_host_time_ns(struct EventFifoPacket const* packet)
+{
+    return device_to_host_ns(packet->us_counter);
+}
+
+static void get_estimate(struct Ex10ClockCorrelationEstimate* estimate)
+{
+    struct ClockCorrelationContext* context = get_correlation_context();
+
+    ex10_mutex_lock(&context->lock);
+    estimate->sample_count   = context->fit_count;
+    estimate->device_time_us = (uint32_t)context->reference_device_us;
+    estimate->host_time_ns   = context->reference_host_ns;
+    estimate->drift_ppb      = (int32_t)round_to_int64(
+        (context->ns_per_us / nominal_ns_per_us - 1.0) * 1.0e9);
+    estimate->min_round_trip_ns =
+        (context->fit_count > 0u) ? (uint32_t)context->min_round_trip_ns : 0u;
+    ex10_mutex_unlock(&context->lock);
+}
+
+static struct Ex10ClockCorrelation const ex10_clock_correlation = {
+    .init                = init,
+    .sample              = sample,
+    .sample_if_due       = sample_if_due,
+    .device_to_host_ns   = device_to_host_ns,
+    .packet_host_time_ns = packet_host_time_ns,
+    .get_estimate        = get_estimate,
+};
+
+struct Ex10ClockCorrelation const* get_ex10_clock_correlation(void)
+{
+    return &ex10_clock_correlation;
+}
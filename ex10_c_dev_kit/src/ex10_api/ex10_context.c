@@ -0,0 +1,78 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+
+#include "ex10_api/ex10_context.h"
+#include "board/ex10_osal.h"
+
+enum ContextOnceState
+{
+    ContextOnceIdle    = 0u,
+    ContextOnceRunning = 1u,
+    ContextOnceDone    = 2u,
+};
+
+static EX10_THREAD_LOCAL size_t context_index = 0u;
+
+// Guards the transitions of every Ex10ContextOnce object; threads waiting
+// for another thread's initialization to complete block on once_done.
+static ex10_mutex_t once_lock = EX10_MUTEX_INITIALIZER;
+static ex10_cond_t  once_done = EX10_COND_INITIALIZER;
+
+struct Ex10Result ex10_context_select(size_t index)
+{
+    if (index >= EX10_MAX_CONTEXTS)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUtils, Ex10SdkErrorBadParamValue);
+    }
+
+    context_index = index;
+    return make_ex10_success();
+}
+
+size_t ex10_context_index(void)
+{
+    return context_index;
+}
+
+void ex10_context_init_once(struct Ex10ContextOnce* once,
+                            void (*init_contexts)(void))
+{
+    if (__atomic_load_n(&once->state, __ATOMIC_ACQUIRE) == ContextOnceDone)
+    {
+        return;
+    }
+
+    ex10_mutex_lock(&once_lock);
+    if (once->state == ContextOnceIdle)
+    {
+        // The lock is not held while the contexts are initialized, so that
+        // init_contexts() can initialize the modules it depends on.
+        once->state = ContextOnceRunning;
+        ex10_mutex_unlock(&once_lock);
+
+        init_contexts();
+
+        ex10_mutex_lock(&once_lock);
+        __atomic_store_n(&once->state, ContextOnceDone, __ATOMIC_RELEASE);
+        ex10_cond_broadcast(&once_done);
+    }
+
+    // Another thread may be initializing the contexts; wait for it without
+    // using the CPU it needs to complete.
+    while (once->state != ContextOnceDone)
+    {
+        ex10_cond_wait(&once_done, &once_lock);
+    }
+    ex10_mutex_unlock(&once_lock);
+}
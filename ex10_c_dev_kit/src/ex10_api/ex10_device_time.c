@@ -21,12 +21,17 @@
 #include "ex10_api/ex10_protocol.h"
 
 
-static uint32_t ex10_time_now(void)
+static uint32_t ex10_time_now_us(void)
 {
     struct TimestampFields time_us;
     get_ex10_protocol()->read(&timestamp_reg, &time_us);
 
-    return (time_us.current_timestamp_us / 1000);
+    return time_us.current_timestamp_us;
+}
+
+static uint32_t ex10_time_now(void)
+{
+    return (ex10_time_now_us() / 1000);
 }
 
 static uint32_t ex10_window_time_elapsed(uint32_t start_time, uint32_t end_time)
@@ -99,6 +104,7 @@ static struct Ex10DeviceTime ex10_device_time = {
     .window_time_elapsed = ex10_window_time_elapsed,
     .time_elapsed        = ex10_time_elapsed,
     .wait_ms             = ex10_wait_ms,
+    .time_now_us         = ex10_time_now_us,
 };
 
 struct Ex10DeviceTime* get_ex10_device_time(void)
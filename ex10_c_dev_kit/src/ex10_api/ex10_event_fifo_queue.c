@@ -16,23 +16,71 @@
 #include <string.h>
 
 #include "board/ex10_osal.h"
+#include "board/time_helpers.h"
 #include "ex10_api/byte_span.h"
 #include "ex10_api/event_fifo_packet_types.h"
 #include "ex10_api/event_packet_parser.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_event_fifo_queue.h"
+#include "ex10_api/ex10_perf_counters.h"
+#include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_protocol.h"
-#include "ex10_api/linked_list.h"
+#include "ex10_api/lock_free_ring.h"
 
-static struct ConstByteSpan event_packets_iterator = {.data   = NULL,
-                                                      .length = 0u};
+/**
+ * The EventFifo queue must be able to hold every FifoBufferNode in both the
+ * event fifo and the result buffer lists.
+ */
+#define EVENT_FIFO_QUEUE_CAPACITY (2u * FIFO_BUFFER_LIST_CAPACITY)
 
-static struct EventFifoPacket        event_packet;
-static struct Ex10LinkedList         event_fifo_list;
 static struct Ex10EventParser const* event_parser = NULL;
-/// Guards access to the fifo_buffer_list within this same structure.
-static ex10_mutex_t list_mutex = EX10_MUTEX_INITIALIZER;
-static ex10_cond_t  list_cond  = EX10_COND_INITIALIZER;
 
+/**
+ * @struct EventFifoQueueContext
+ * The EventFifo queue of an Ex10 context.
+ */
+struct EventFifoQueueContext
+{
+    struct ConstByteSpan   event_packets_iterator;
+    struct EventFifoPacket event_packet;
+
+    /// The FifoBufferNode being parsed, and the position within its
+    /// packet_index of the next packet to parse.
+    struct FifoBufferNode const* fifo_buffer_node;
+    size_t                       packet_position;
+
+    /// The queue of FifoBufferNodes filled by the IRQ_N monitor thread (and
+    /// for error reporting by other threads) and consumed by the application
+    /// thread.
+    struct Ex10RingCell     event_fifo_cells[EVENT_FIFO_QUEUE_CAPACITY];
+    struct Ex10LockFreeRing event_fifo_list;
+
+    /// The wait mutex and condition are only used when the consumer has no
+    /// packets to process and is blocked in packet_wait().
+    /// Producers only acquire the mutex when consumer_waiting is set.
+    ex10_mutex_t list_mutex;
+    ex10_cond_t  list_cond;
+    bool         consumer_waiting;
+};
+
+static struct EventFifoQueueContext queue_contexts[EX10_MAX_CONTEXTS];
+static struct Ex10ContextOnce       queue_contexts_once;
+
+static void init_queue_contexts(void)
+{
+    for (size_t index = 0u; index < EX10_MAX_CONTEXTS; ++index)
+    {
+        ex10_mutex_init(&queue_contexts[index].list_mutex);
+        ex10_cond_init(&queue_contexts[index].list_cond);
+        queue_contexts[index].consumer_waiting = false;
+    }
+}
+
+static struct EventFifoQueueContext* get_queue_context(void)
+{
+    ex10_context_init_once(&queue_contexts_once, init_queue_contexts);
+    return &queue_contexts[ex10_context_index()];
+}
 
 static struct EventFifoPacket const invalid_event_packet = {
     .packet_type         = InvalidPacket,
@@ -46,25 +94,71 @@ static struct EventFifoPacket const invalid_event_packet = {
 
 static void init(void)
 {
-    list_init(&event_fifo_list);
-    event_packets_iterator.data   = NULL;
-    event_packets_iterator.length = 0u;
-    event_packet                  = invalid_event_packet;
-    event_parser                  = get_ex10_event_parser();
+    struct EventFifoQueueContext* queue = get_queue_context();
+
+    ring_init(&queue->event_fifo_list,
+              queue->event_fifo_cells,
+              EVENT_FIFO_QUEUE_CAPACITY);
+    queue->event_packets_iterator.data   = NULL;
+    queue->event_packets_iterator.length = 0u;
+    queue->event_packet                  = invalid_event_packet;
+    queue->fifo_buffer_node              = NULL;
+    queue->packet_position               = 0u;
+    event_parser                         = get_ex10_event_parser();
+}
+
+static struct EventPacketIndex const* get_packet_index(
+    struct FifoBufferNode* fifo_buffer_node)
+{
+    if (fifo_buffer_node->packet_indexed == false)
+    {
+        get_ex10_event_parser()->scan_event_packets(
+            fifo_buffer_node->fifo_data, fifo_buffer_node->packet_index);
+        fifo_buffer_node->packet_indexed = true;
+    }
+    return fifo_buffer_node->packet_index;
+}
+
+static void wake_consumer(void)
+{
+    struct EventFifoQueueContext* queue = get_queue_context();
+
+    // Pairs with the fence in packets_available_or_wait(): either the
+    // consumer observes the pushed node, or this thread observes that the
+    // consumer is waiting and signals it while holding the wait mutex.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&queue->consumer_waiting, __ATOMIC_RELAXED))
+    {
+        ex10_mutex_lock(&queue->list_mutex);
+        ex10_cond_signal(&queue->list_cond);
+        ex10_mutex_unlock(&queue->list_mutex);
+    }
 }
 
 static void list_node_push_back(struct FifoBufferNode* fifo_buffer_node)
 {
-    ex10_mutex_lock(&list_mutex);
-    list_push_back(&event_fifo_list, &fifo_buffer_node->list_node);
-    ex10_mutex_unlock(&list_mutex);
-    ex10_cond_signal(&list_cond);
+    struct EventFifoQueueContext* queue = get_queue_context();
+
+    // Index the packets within the producer thread, if the fifo data handler
+    // has not already done so, so that the consumer does not parse them.
+    get_packet_index(fifo_buffer_node);
+    fifo_buffer_node->queued_time_ns = get_ex10_time_helpers()->time_now_ns();
+
+    if (ring_push(&queue->event_fifo_list, fifo_buffer_node, NULL) == false)
+    {
+        // The queue is sized to hold every FifoBufferNode.
+        ex10_eprintf("EventFifo queue full, node dropped\n");
+        ex10_release_buffer_node(fifo_buffer_node);
+        return;
+    }
+    get_ex10_perf_counters()->record_queue_push(
+        fifo_buffer_node, ring_size(&queue->event_fifo_list));
+    wake_consumer();
 }
 
 /**
  * Pop a FifoBufferNode from the front of the event_fifo_list.
- * The list_mutex is used to maintain exclusive access to the
- * event_fifo_list. If the list is empty, then NULL is returned.
+ * If the list is empty, then NULL is returned.
  *
  * @return struct FifoBufferNode* A pointer to the front FifoBufferNode on the
  *                                list.
@@ -72,31 +166,16 @@ static void list_node_push_back(struct FifoBufferNode* fifo_buffer_node)
  */
 static struct FifoBufferNode* list_node_pop_front(void)
 {
-    struct FifoBufferNode* fifo_buffer_node = NULL;
-
-    ex10_mutex_lock(&list_mutex);
-    struct Ex10ListNode* list_node = list_front(&event_fifo_list);
+    struct EventFifoQueueContext* queue = get_queue_context();
 
-    // Note: if list_node->data ==  NULL, then the list is empty.
-    // i.e. list_node is pointing to the sentinel node.
-    if (list_node->data)
-    {
-        list_pop_front(&event_fifo_list);
-        fifo_buffer_node = (struct FifoBufferNode*)list_node->data;
-    }
-    ex10_mutex_unlock(&list_mutex);
-
-    return fifo_buffer_node;
+    return (struct FifoBufferNode*)ring_pop(&queue->event_fifo_list);
 }
 
 static struct FifoBufferNode const* event_fifo_buffer_peek(void)
 {
-    // If the node is a sentinel node then list_node->data will be NULL
-    // indicating that there are no buffers in the list.
-    ex10_mutex_lock(&list_mutex);
-    struct Ex10ListNode* list_node = list_front(&event_fifo_list);
-    ex10_mutex_unlock(&list_mutex);
-    return (struct FifoBufferNode const*)list_node->data;
+    struct EventFifoQueueContext* queue = get_queue_context();
+
+    return (struct FifoBufferNode const*)ring_front(&queue->event_fifo_list);
 }
 
 static void event_fifo_buffer_pop(void)
@@ -144,13 +223,98 @@ static void event_fifo_buffer_pop(void)
     }
 }
 
+/**
+ * Set the event_packets_iterator to the FifoBufferNode, or clear it if the
+ * node is NULL.
+ */
+static void set_current_fifo_buffer(struct EventFifoQueueContext* queue,
+                                    struct FifoBufferNode const*  fifo_buffer)
+{
+    queue->fifo_buffer_node = fifo_buffer;
+    queue->packet_position  = 0u;
+    if (fifo_buffer != NULL)
+    {
+        queue->event_packets_iterator = fifo_buffer->fifo_data;
+        get_ex10_perf_counters()->record_queue_pop(
+            fifo_buffer, ring_size(&queue->event_fifo_list));
+    }
+    else
+    {
+        queue->event_packets_iterator.data   = NULL;
+        queue->event_packets_iterator.length = 0u;
+    }
+}
+
+/**
+ * @return struct EventPacketIndex const* The packet index of the current
+ *         FifoBufferNode, or NULL if the node has not been indexed.
+ */
+static struct EventPacketIndex const* current_packet_index(
+    struct EventFifoQueueContext const* queue)
+{
+    struct FifoBufferNode const* fifo_buffer = queue->fifo_buffer_node;
+    if ((fifo_buffer == NULL) || (fifo_buffer->packet_indexed == false))
+    {
+        return NULL;
+    }
+    return fifo_buffer->packet_index;
+}
+
+/**
+ * Move the event_packets_iterator to the byte offset within the current
+ * FifoBufferNode.
+ */
+static void seek_event_packets_iterator(struct EventFifoQueueContext* queue,
+                                        size_t                        offset)
+{
+    struct ConstByteSpan const* fifo_data = &queue->fifo_buffer_node->fifo_data;
+
+    queue->event_packets_iterator.data   = fifo_data->data + offset;
+    queue->event_packets_iterator.length = fifo_data->length - offset;
+}
+
+/**
+ * Get the next packet from the packet index of the current FifoBufferNode,
+ * advancing the event_packets_iterator past it.
+ */
+static struct EventFifoPacket next_indexed_packet(
+    struct EventFifoQueueContext*  queue,
+    struct EventPacketIndex const* packet_index)
+{
+    size_t const position = queue->packet_position;
+
+    struct EventFifoPacket const packet = event_parser->get_indexed_packet(
+        queue->fifo_buffer_node->fifo_data.data, packet_index, position);
+
+    queue->packet_position += 1u;
+    if (packet.is_valid == false)
+    {
+        // As with parse_event_packet(), the invalid packet terminates the
+        // packet processing within the current FifoBufferNode.
+        queue->event_packets_iterator.length = 0u;
+    }
+    else if (queue->packet_position < packet_index->packet_count)
+    {
+        seek_event_packets_iterator(
+            queue, packet_index->packet_offsets[queue->packet_position]);
+    }
+    else
+    {
+        seek_event_packets_iterator(queue, packet_index->indexed_length);
+    }
+
+    return packet;
+}
+
 static void parse_next_event_fifo_packet(void)
 {
-    if (event_packets_iterator.length == 0u)
+    struct EventFifoQueueContext* queue = get_queue_context();
+
+    if (queue->event_packets_iterator.length == 0u)
     {
         // The iterator has reached the end of a buffer node or
         // it is not pointing to a node.
-        if (event_packets_iterator.data != NULL)
+        if (queue->event_packets_iterator.data != NULL)
         {
             // The event buffer ConstByteSpan data pointer was pointing
             // to the end of non-null.
@@ -159,47 +323,49 @@ static void parse_next_event_fifo_packet(void)
 
             // Invalidate the ConstByteSpan data pointer to indicate that
             // there no current EventFifo data buffer being parsed.
-            event_packets_iterator.data = NULL;
+            queue->event_packets_iterator.data = NULL;
         }
 
-        struct FifoBufferNode const* fifo_buffer = event_fifo_buffer_peek();
-        if (fifo_buffer != NULL)
-        {
-            event_packets_iterator = fifo_buffer->fifo_data;
-        }
-        else
-        {
-            // There were no FifoBufferNode elements in the list.
-            event_packets_iterator.data   = NULL;
-            event_packets_iterator.length = 0u;
-        }
+        // If there are no FifoBufferNode elements in the list the iterator
+        // is cleared.
+        set_current_fifo_buffer(queue, event_fifo_buffer_peek());
     }
 
-    if (event_packets_iterator.length > 0u)
+    struct EventPacketIndex const* packet_index = current_packet_index(queue);
+    if ((queue->event_packets_iterator.length > 0u) &&
+        (packet_index != NULL) &&
+        (queue->packet_position < packet_index->packet_count))
+    {
+        queue->event_packet = next_indexed_packet(queue, packet_index);
+    }
+    else if (queue->event_packets_iterator.length > 0u)
     {
-        event_packet =
-            event_parser->parse_event_packet(&event_packets_iterator);
+        // The packet index capacity was reached, or the node was not indexed.
+        queue->event_packet =
+            event_parser->parse_event_packet(&queue->event_packets_iterator);
     }
     else
     {
-        event_packet = invalid_event_packet;
+        queue->event_packet = invalid_event_packet;
     }
 }
 
 static struct EventFifoPacket const* packet_peek(void)
 {
+    struct EventFifoQueueContext* queue = get_queue_context();
+
     // If the packet iterator is NULL, attempt to get a fifo buffer from the
     // free list and parse the first packet.
-    if (event_packets_iterator.data == NULL)
+    if (queue->event_packets_iterator.data == NULL)
     {
         parse_next_event_fifo_packet();
     }
 
     // If the packet buffer is not null, then the event_packet must have
     // been parsed (even if the packet was marked .is_value = false).
-    if (event_packets_iterator.data != NULL)
+    if (queue->event_packets_iterator.data != NULL)
     {
-        return &event_packet;
+        return &queue->event_packet;
     }
 
     // No packets have been parsed nor are any available for parsing.
@@ -211,35 +377,208 @@ static void packet_remove(void)
     parse_next_event_fifo_packet();
 }
 
+static size_t packet_batch_get(struct EventFifoPacketBatch* batch)
+{
+    struct EventFifoQueueContext* queue = get_queue_context();
+
+    batch->fifo_buffer_node = NULL;
+    batch->packet_index     = NULL;
+    batch->first_position   = 0u;
+    batch->packet_count     = 0u;
+
+    if (queue->event_packets_iterator.data != NULL)
+    {
+        if (queue->event_packet.is_valid)
+        {
+            // A packet was parsed by packet_peek() or packet_remove();
+            // rewind the iterator so that the batch starts with it.
+            uint8_t const* packet_start =
+                (uint8_t const*)queue->event_packet.static_data -
+                sizeof(struct PacketHeader);
+            queue->event_packets_iterator.length +=
+                (size_t)(queue->event_packets_iterator.data - packet_start);
+            queue->event_packets_iterator.data = packet_start;
+
+            struct EventPacketIndex const* packet_index =
+                current_packet_index(queue);
+            size_t const packet_offset = (size_t)(
+                packet_start - queue->fifo_buffer_node->fifo_data.data);
+            if ((packet_index != NULL) && (queue->packet_position > 0u) &&
+                (packet_index->packet_offsets[queue->packet_position - 1u] ==
+                 packet_offset))
+            {
+                queue->packet_position -= 1u;
+            }
+        }
+        else
+        {
+            // The invalid packet was already reported through packet_peek()
+            // and ended the parsing of the current node.
+            queue->event_packets_iterator.length = 0u;
+            parse_next_event_fifo_packet();
+            return packet_batch_get(batch);
+        }
+    }
+    else
+    {
+        struct FifoBufferNode const* fifo_buffer = event_fifo_buffer_peek();
+        if (fifo_buffer == NULL)
+        {
+            return 0u;
+        }
+        set_current_fifo_buffer(queue, fifo_buffer);
+    }
+
+    struct EventPacketIndex const* packet_index = current_packet_index(queue);
+    if ((packet_index == NULL) ||
+        (queue->packet_position >= packet_index->packet_count))
+    {
+        // Each node is indexed by list_node_push_back(), and the index of a
+        // ReadFifo buffer of at most EX10_EVENT_FIFO_SIZE bytes covers all of
+        // its packets. Bytes beyond the index cannot be batched.
+        ex10_eprintf("EventFifo packets beyond the packet index dropped\n");
+        queue->event_packets_iterator.length = 0u;
+        parse_next_event_fifo_packet();
+        return packet_batch_get(batch);
+    }
+
+    batch->fifo_buffer_node = queue->fifo_buffer_node;
+    batch->packet_index     = packet_index;
+    batch->first_position   = queue->packet_position;
+
+    // The batch holds the remaining packets of the node; advance the
+    // iterator past them.
+    size_t const packet_count = packet_index->packet_count;
+    batch->packet_count       = packet_count - queue->packet_position;
+    queue->packet_position    = packet_count;
+    if (packet_index->invalid_packet)
+    {
+        queue->event_packets_iterator.length = 0u;
+    }
+    else
+    {
+        seek_event_packets_iterator(queue, packet_index->indexed_length);
+    }
+
+    return batch->packet_count;
+}
+
+static void packet_batch_release(struct EventFifoPacketBatch* batch)
+{
+    struct EventFifoQueueContext* queue = get_queue_context();
+
+    if (batch->fifo_buffer_node == NULL)
+    {
+        return;
+    }
+
+    if (queue->event_packets_iterator.length == 0u)
+    {
+        // All packets of the node were in the batch: release the node and
+        // defer parsing of the next node until it is requested.
+        event_fifo_buffer_pop();
+        set_current_fifo_buffer(queue, NULL);
+        queue->event_packet = invalid_event_packet;
+    }
+    else
+    {
+        // The packet index did not cover the node. Parse the next packet to
+        // leave the iterator in the state expected by packet_peek().
+        parse_next_event_fifo_packet();
+    }
+
+    batch->fifo_buffer_node = NULL;
+    batch->packet_index     = NULL;
+    batch->first_position   = 0u;
+    batch->packet_count     = 0u;
+}
+
+static bool packets_available(void)
+{
+    struct EventFifoQueueContext* queue = get_queue_context();
+
+    return (queue->event_packets_iterator.data != NULL) ||
+           (ring_is_empty(&queue->event_fifo_list) == false);
+}
+
+/**
+ * Publish that the consumer is about to wait, then check for packets.
+ * Must be called with the list_mutex held.
+ *
+ * @return bool true if packets are available and the wait is not required.
+ */
+static bool packets_available_or_wait(void)
+{
+    struct EventFifoQueueContext* queue = get_queue_context();
+
+    __atomic_store_n(&queue->consumer_waiting, true, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    return packets_available();
+}
+
 static void packet_wait(void)
 {
-    ex10_mutex_lock(&list_mutex);
-    while ((event_packets_iterator.data == NULL) &&
-           list_is_empty(&event_fifo_list))
+    struct EventFifoQueueContext* queue = get_queue_context();
+
+    if (packets_available())
     {
-        ex10_cond_wait(&list_cond, &list_mutex);
+        return;
     }
-    ex10_mutex_unlock(&list_mutex);
+
+    ex10_mutex_lock(&queue->list_mutex);
+    while (packets_available_or_wait() == false)
+    {
+        ex10_cond_wait(&queue->list_cond, &queue->list_mutex);
+    }
+    __atomic_store_n(&queue->consumer_waiting, false, __ATOMIC_RELAXED);
+    ex10_mutex_unlock(&queue->list_mutex);
 }
 
 static bool packet_wait_with_timeout(uint32_t timeout_us)
 {
+    struct EventFifoQueueContext* queue = get_queue_context();
+
+    if (packets_available())
+    {
+        return false;
+    }
+
+    struct Ex10TimeHelpers const* time_helpers = get_ex10_time_helpers();
+    uint64_t const                start_us     = time_helpers->time_now_us();
+
     bool timeout_expired = false;
-    ex10_mutex_lock(&list_mutex);
-    while ((event_packets_iterator.data == NULL) &&
-           list_is_empty(&event_fifo_list) && (timeout_expired == false))
+    ex10_mutex_lock(&queue->list_mutex);
+    while ((packets_available_or_wait() == false) &&
+           (timeout_expired == false))
     {
-        int const result =
-            ex10_cond_timed_wait_us(&list_cond, &list_mutex, timeout_us);
-        timeout_expired = (result == ETIMEDOUT);
+        // Wakeups without packets, such as from packet_unwait(), are charged
+        // against the timeout so that it is not restarted.
+        uint64_t const elapsed_us = time_helpers->time_now_us() - start_us;
+        if (elapsed_us < timeout_us)
+        {
+            int const result = ex10_cond_timed_wait_us(
+                &queue->list_cond,
+                &queue->list_mutex,
+                timeout_us - (uint32_t)elapsed_us);
+            timeout_expired = (result == ETIMEDOUT);
+        }
+        else
+        {
+            timeout_expired = true;
+        }
     }
-    ex10_mutex_unlock(&list_mutex);
+    __atomic_store_n(&queue->consumer_waiting, false, __ATOMIC_RELAXED);
+    ex10_mutex_unlock(&queue->list_mutex);
     return timeout_expired;
 }
 
 static void packet_unwait(void)
 {
-    ex10_cond_signal(&list_cond);
+    struct EventFifoQueueContext* queue = get_queue_context();
+
+    ex10_mutex_lock(&queue->list_mutex);
+    ex10_cond_signal(&queue->list_cond);
+    ex10_mutex_unlock(&queue->list_mutex);
 }
 
 static const struct Ex10EventFifoQueue event_fifo_queue = {
@@ -250,6 +589,9 @@ static const struct Ex10EventFifoQueue event_fifo_queue = {
     .packet_wait              = packet_wait,
     .packet_wait_with_timeout = packet_wait_with_timeout,
     .packet_unwait            = packet_unwait,
+    .packet_batch_get         = packet_batch_get,
+    .packet_batch_release     = packet_batch_release,
+    .get_packet_index         = get_packet_index,
 };
 
 const struct Ex10EventFifoQueue* get_ex10_event_fifo_queue(void)
@@ -154,6 +154,19 @@ static struct Ex10Result start_inventory(
     ex10_result =
         run_inventory(inventory_config, inventory_config_2, send_selects);
 
+    if (ex10_result.error == false && cw_is_on == false)
+    {
+        // While this channel transmits, stage the CwOn aggregate op of the
+        // next channel. Staging is only an optimization: if it fails, the
+        // next cw_on() builds and writes the aggregate op itself.
+        ex10_rf_power->stage_next_cw_on(antenna,
+                                        rf_mode,
+                                        tx_power_cdbm,
+                                        temperature_adc,
+                                        temp_comp_enabled,
+                                        &droop_comp_fields);
+    }
+
     // There is a race condition where the sdk checks for cw, the device
     // reports it is ramped up, then it ramps down before select is run.
     // If this occurs, ramp up and and rerun. Any errors after this get
@@ -0,0 +1,386 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <stdbool.h>
+
+#include "board/time_helpers.h"
+#include "ex10_api/event_fifo_packet_types.h"
+#include "ex10_api/event_packet_parser.h"
+#include "ex10_api/ex10_context.h"
+#include "ex10_api/ex10_perf_counters.h"
+#include "ex10_api/fifo_buffer_list.h"
+
+/**
+ * @struct PerfCounterContext
+ * The performance counters of an Ex10 context. Every member is a uint64_t,
+ * so that reset() can clear the counters word by word with atomic stores.
+ */
+struct PerfCounterContext
+{
+    uint64_t reset_time_ns;
+
+    uint64_t                 spi_commands;
+    uint64_t                 spi_responses;
+    uint64_t                 spi_bytes_sent;
+    uint64_t                 spi_bytes_received;
+    struct Ex10PerfHistogram ready_n_wait;
+    uint64_t                 ready_n_timeouts;
+
+    uint64_t interrupts;
+    uint64_t read_fifo_count;
+    uint64_t read_fifo_bytes;
+
+    uint64_t                 queue_depth;
+    uint64_t                 queue_max_depth;
+    struct Ex10PerfHistogram queue_lag;
+
+    uint64_t                 cw_on_count;
+    uint64_t                 cw_on_staged_count;
+    struct Ex10PerfHistogram cw_on_time;
+
+    uint64_t                 ramp_up_count;
+    uint64_t                 ramp_down_count;
+    struct Ex10PerfHistogram dead_time;
+
+    uint64_t inventory_rounds;
+    uint64_t tag_reads;
+    uint64_t last_round_tag_reads;
+    uint64_t last_round_duration_us;
+    uint64_t last_round_tags_per_second;
+    uint64_t max_round_tags_per_second;
+
+    /// The packet scan state, updated only by the EventFifo queue producer:
+    /// the TagRead packets since the last InventoryRoundSummary, and the
+    /// us_counter of the last TxRampDown plus one, or zero if CW is on.
+    uint64_t round_tag_reads;
+    uint64_t ramp_down_us_plus_one;
+};
+
+static_assert(sizeof(struct PerfCounterContext) % sizeof(uint64_t) == 0u,
+              "PerfCounterContext must contain only uint64_t members");
+
+static struct PerfCounterContext perf_contexts[EX10_MAX_CONTEXTS];
+
+static struct PerfCounterContext* get_perf_context(void)
+{
+    return &perf_contexts[ex10_context_index()];
+}
+
+static void counter_add(uint64_t* counter, uint64_t value)
+{
+    __atomic_add_fetch(counter, value, __ATOMIC_RELAXED);
+}
+
+static uint64_t counter_load(uint64_t const* counter)
+{
+    return __atomic_load_n(counter, __ATOMIC_RELAXED);
+}
+
+static void counter_store(uint64_t* counter, uint64_t value)
+{
+    __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+}
+
+static void counter_max(uint64_t* counter, uint64_t value)
+{
+    uint64_t current = counter_load(counter);
+    while (value > current)
+    {
+        if (__atomic_compare_exchange_n(counter,
+                                        &current,
+                                        value,
+                                        true,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+}
+
+static size_t histogram_bucket(uint64_t duration_ns)
+{
+    uint64_t duration_us = duration_ns / 1000u;
+    size_t   bucket      = 0u;
+    while ((duration_us > 0u) && (bucket < EX10_PERF_HISTOGRAM_BUCKETS - 1u))
+    {
+        duration_us >>= 1u;
+        bucket += 1u;
+    }
+    return bucket;
+}
+
+static void histogram_add(struct Ex10PerfHistogram* histogram,
+                          uint64_t                  duration_ns)
+{
+    counter_add(&histogram->buckets[histogram_bucket(duration_ns)], 1u);
+    counter_add(&histogram->count, 1u);
+    counter_add(&histogram->total_ns, duration_ns);
+    counter_max(&histogram->max_ns, duration_ns);
+}
+
+static void histogram_load(struct Ex10PerfHistogram*       histogram,
+                           struct Ex10PerfHistogram const* counters)
+{
+    for (size_t index = 0u; index < EX10_PERF_HISTOGRAM_BUCKETS; ++index)
+    {
+        histogram->buckets[index] = counter_load(&counters->buckets[index]);
+    }
+    histogram->count    = counter_load(&counters->count);
+    histogram->total_ns = counter_load(&counters->total_ns);
+    histogram->max_ns   = counter_load(&counters->max_ns);
+}
+
+static void get_snapshot(struct Ex10PerfSnapshot* snapshot)
+{
+    struct PerfCounterContext const* perf = get_perf_context();
+
+    snapshot->snapshot_time_ns = get_ex10_time_helpers()->time_now_ns();
+    snapshot->reset_time_ns    = counter_load(&perf->reset_time_ns);
+
+    snapshot->spi_commands       = counter_load(&perf->spi_commands);
+    snapshot->spi_responses      = counter_load(&perf->spi_responses);
+    snapshot->spi_bytes_sent     = counter_load(&perf->spi_bytes_sent);
+    snapshot->spi_bytes_received = counter_load(&perf->spi_bytes_received);
+    histogram_load(&snapshot->ready_n_wait, &perf->ready_n_wait);
+    snapshot->ready_n_timeouts = counter_load(&perf->ready_n_timeouts);
+
+    snapshot->interrupts      = counter_load(&perf->interrupts);
+    snapshot->read_fifo_count = counter_load(&perf->read_fifo_count);
+    snapshot->read_fifo_bytes = counter_load(&perf->read_fifo_bytes);
+
+    get_ex10_fifo_buffer_list()->get_stats(&snapshot->event_fifo_buffers);
+
+    snapshot->queue_depth     = counter_load(&perf->queue_depth);
+    snapshot->queue_max_depth = counter_load(&perf->queue_max_depth);
+    histogram_load(&snapshot->queue_lag, &perf->queue_lag);
+
+    snapshot->cw_on_count        = counter_load(&perf->cw_on_count);
+    snapshot->cw_on_staged_count = counter_load(&perf->cw_on_staged_count);
+    histogram_load(&snapshot->cw_on_time, &perf->cw_on_time);
+
+    snapshot->ramp_up_count   = counter_load(&perf->ramp_up_count);
+    snapshot->ramp_down_count = counter_load(&perf->ramp_down_count);
+    histogram_load(&snapshot->dead_time, &perf->dead_time);
+
+    snapshot->inventory_rounds = counter_load(&perf->inventory_rounds);
+    snapshot->tag_reads        = counter_load(&perf->tag_reads);
+    snapshot->last_round_tag_reads =
+        counter_load(&perf->last_round_tag_reads);
+    snapshot->last_round_duration_us =
+        counter_load(&perf->last_round_duration_us);
+    snapshot->last_round_tags_per_second =
+        counter_load(&perf->last_round_tags_per_second);
+    snapshot->max_round_tags_per_second =
+        counter_load(&perf->max_round_tags_per_second);
+}
+
+static void reset(void)
+{
+    struct PerfCounterContext* perf = get_perf_context();
+
+    uint64_t*    words      = (uint64_t*)perf;
+    size_t const word_count = sizeof(*perf) / sizeof(uint64_t);
+    for (size_t index = 0u; index < word_count; ++index)
+    {
+        counter_store(&words[index], 0u);
+    }
+    counter_store(&perf->reset_time_ns, get_ex10_time_helpers()->time_now_ns());
+
+    get_ex10_fifo_buffer_list()->reset_stats();
+}
+
+static void record_spi_command(size_t byte_count, uint64_t ready_n_wait_ns)
+{
+    struct PerfCounterContext* perf = get_perf_context();
+
+    counter_add(&perf->spi_commands, 1u);
+    counter_add(&perf->spi_bytes_sent, byte_count);
+    histogram_add(&perf->ready_n_wait, ready_n_wait_ns);
+}
+
+static void record_spi_response(size_t byte_count, uint64_t ready_n_wait_ns)
+{
+    struct PerfCounterContext* perf = get_perf_context();
+
+    counter_add(&perf->spi_responses, 1u);
+    counter_add(&perf->spi_bytes_received, byte_count);
+    histogram_add(&perf->ready_n_wait, ready_n_wait_ns);
+}
+
+static void record_ready_n_timeout(void)
+{
+    counter_add(&get_perf_context()->ready_n_timeouts, 1u);
+}
+
+static void record_interrupt(void)
+{
+    counter_add(&get_perf_context()->interrupts, 1u);
+}
+
+static void record_read_fifo(size_t byte_count)
+{
+    struct PerfCounterContext* perf = get_perf_context();
+
+    counter_add(&perf->read_fifo_count, 1u);
+    counter_add(&perf->read_fifo_bytes, byte_count);
+}
+
+static void record_round_summary(struct PerfCounterContext*    perf,
+                                 struct EventFifoPacket const* packet)
+{
+    uint64_t const round_tag_reads = counter_load(&perf->round_tag_reads);
+    uint64_t const duration_us =
+        packet->static_data->inventory_round_summary.duration_us;
+
+    counter_add(&perf->inventory_rounds, 1u);
+    counter_store(&perf->round_tag_reads, 0u);
+    counter_store(&perf->last_round_tag_reads, round_tag_reads);
+    counter_store(&perf->last_round_duration_us, duration_us);
+    if (duration_us > 0u)
+    {
+        uint64_t const tags_per_second =
+            (round_tag_reads * 1000000u) / duration_us;
+        counter_store(&perf->last_round_tags_per_second, tags_per_second);
+        counter_max(&perf->max_round_tags_per_second, tags_per_second);
+    }
+}
+
+/**
+ * Scan the indexed packets of a FifoBufferNode in order, so that tag reads
+ * are attributed to the inventory round which they precede the summary of,
+ * and ramp downs are matched with the following ramp up.
+ */
+static void scan_packets(struct PerfCounterContext*   perf,
+                         struct FifoBufferNode const* fifo_buffer)
+{
+    struct EventPacketIndex const* index  = fifo_buffer->packet_index;
+    struct Ex10EventParser const*  parser = get_ex10_event_parser();
+
+    for (size_t position = 0u; position < index->packet_count; ++position)
+    {
+        switch (index->packet_types[position])
+        {
+            case TagRead:
+                counter_add(&perf->round_tag_reads, 1u);
+                break;
+            case InventoryRoundSummary:
+            {
+                struct EventFifoPacket const packet =
+                    parser->get_indexed_packet(
+                        fifo_buffer->fifo_data.data, index, position);
+                record_round_summary(perf, &packet);
+                break;
+            }
+            case TxRampDown:
+            {
+                struct EventFifoPacket const packet =
+                    parser->get_indexed_packet(
+                        fifo_buffer->fifo_data.data, index, position);
+                counter_add(&perf->ramp_down_count, 1u);
+                counter_store(&perf->ramp_down_us_plus_one,
+                              (uint64_t)packet.us_counter + 1u);
+                break;
+            }
+            case TxRampUp:
+            {
+                struct EventFifoPacket const packet =
+                    parser->get_indexed_packet(
+                        fifo_buffer->fifo_data.data, index, position);
+                uint64_t const ramp_down_us_plus_one =
+                    counter_load(&perf->ramp_down_us_plus_one);
+                counter_add(&perf->ramp_up_count, 1u);
+                if (ramp_down_us_plus_one > 0u)
+                {
+                    uint32_t const dead_time_us =
+                        packet.us_counter -
+                        (uint32_t)(ramp_down_us_plus_one - 1u);
+                    histogram_add(&perf->dead_time,
+                                  (uint64_t)dead_time_us * 1000u);
+                    counter_store(&perf->ramp_down_us_plus_one, 0u);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+static void record_queue_push(struct FifoBufferNode const* fifo_buffer,
+                              size_t                       depth)
+{
+    struct PerfCounterContext* perf = get_perf_context();
+
+    counter_store(&perf->queue_depth, depth);
+    counter_max(&perf->queue_max_depth, depth);
+
+    if (fifo_buffer->packet_indexed == false)
+    {
+        return;
+    }
+
+    struct EventPacketIndex const* index = fifo_buffer->packet_index;
+    counter_add(&perf->tag_reads, index->type_counts[TagRead]);
+
+    // Most buffers hold only tag reads, which need not be scanned in order.
+    if ((index->type_counts[InventoryRoundSummary] == 0u) &&
+        (index->type_counts[TxRampUp] == 0u) &&
+        (index->type_counts[TxRampDown] == 0u))
+    {
+        counter_add(&perf->round_tag_reads, index->type_counts[TagRead]);
+        return;
+    }
+    scan_packets(perf, fifo_buffer);
+}
+
+static void record_queue_pop(struct FifoBufferNode const* fifo_buffer,
+                             size_t                       depth)
+{
+    struct PerfCounterContext* perf = get_perf_context();
+
+    counter_store(&perf->queue_depth, depth);
+    histogram_add(
+        &perf->queue_lag,
+        get_ex10_time_helpers()->time_now_ns() - fifo_buffer->queued_time_ns);
+}
+
+static void record_cw_on(uint64_t duration_ns, bool staged)
+{
+    struct PerfCounterContext* perf = get_perf_context();
+
+    counter_add(&perf->cw_on_count, 1u);
+    if (staged)
+    {
+        counter_add(&perf->cw_on_staged_count, 1u);
+    }
+    histogram_add(&perf->cw_on_time, duration_ns);
+}
+
+static struct Ex10PerfCounters const ex10_perf_counters = {
+    .get_snapshot           = get_snapshot,
+    .reset                  = reset,
+    .record_spi_command     = record_spi_command,
+    .record_spi_response    = record_spi_response,
+    .record_ready_n_timeout = record_ready_n_timeout,
+    .record_interrupt       = record_interrupt,
+    .record_read_fifo       = record_read_fifo,
+    .record_queue_push      = record_queue_push,
+    .record_queue_pop       = record_queue_pop,
+    .record_cw_on           = record_cw_on,
+};
+
+struct Ex10PerfCounters const* get_ex10_perf_counters(void)
+{
+    return &ex10_perf_counters;
+}
@@ -16,6 +16,7 @@
 #include "board/board_spec.h"
 #include "board/ex10_gpio.h"
 #include "board/time_helpers.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_helpers.h"
 #include "ex10_api/ex10_reader.h"
 #include "ex10_api/ex10_rf_power.h"
@@ -38,7 +39,7 @@ struct Ex10PowerModesPrivate
     enum PowerMode                    power_mode;
 };
 
-static struct Ex10PowerModesPrivate power_modes = {
+static struct Ex10PowerModesPrivate const power_modes_defaults = {
     .reader           = NULL,
     .ops              = NULL,
     .protocol         = NULL,
@@ -47,28 +48,50 @@ static struct Ex10PowerModesPrivate power_modes = {
     .power_mode       = PowerModeReady,
 };
 
+static struct Ex10PowerModesPrivate power_modes_contexts[EX10_MAX_CONTEXTS];
+static struct Ex10ContextOnce       power_modes_contexts_once;
+
+static void init_power_modes_contexts(void)
+{
+    for (size_t index = 0u; index < EX10_MAX_CONTEXTS; ++index)
+    {
+        power_modes_contexts[index] = power_modes_defaults;
+    }
+}
+
+static struct Ex10PowerModesPrivate* get_power_modes_context(void)
+{
+    ex10_context_init_once(&power_modes_contexts_once,
+                           init_power_modes_contexts);
+    return &power_modes_contexts[ex10_context_index()];
+}
+
 static void init(void)
 {
-    power_modes.reader           = get_ex10_reader();
-    power_modes.ops              = get_ex10_ops();
-    power_modes.protocol         = get_ex10_protocol();
-    power_modes.power_transactor = get_ex10_power_transactor();
-    power_modes.rf_power         = get_ex10_rf_power();
-    power_modes.power_mode       = PowerModeReady;
+    struct Ex10PowerModesPrivate* power_modes = get_power_modes_context();
+
+    power_modes->reader           = get_ex10_reader();
+    power_modes->ops              = get_ex10_ops();
+    power_modes->protocol         = get_ex10_protocol();
+    power_modes->power_transactor = get_ex10_power_transactor();
+    power_modes->rf_power         = get_ex10_rf_power();
+    power_modes->power_mode       = PowerModeReady;
 }
 
 static void deinit(void) {}
 
 static struct Ex10Result stop_transmitter_and_wait(void)
 {
-    struct Ex10Result ex10_result = power_modes.reader->stop_transmitting();
+    struct Ex10PowerModesPrivate* power_modes = get_power_modes_context();
+
+    struct Ex10Result ex10_result = power_modes->reader->stop_transmitting();
     if (ex10_result.error)
     {
         return ex10_result;
     }
 
     enum InventoryState inventory_state =
-        power_modes.reader->get_continuous_inventory_state()->state;
+        power_modes->reader->get_continuous_inventory_state()->state;
 
     uint32_t const start_time_ms = get_ex10_time_helpers()->time_now();
     while ((inventory_state != InvIdle) &&
@@ -76,7 +99,7 @@ static struct Ex10Result stop_transmitter_and_wait(void)
             stop_transmitter_timeout_ms))
     {
         inventory_state =
-            power_modes.reader->get_continuous_inventory_state()->state;
+            power_modes->reader->get_continuous_inventory_state()->state;
     }
 
     if (inventory_state != InvIdle)
@@ -90,6 +113,8 @@ static struct Ex10Result stop_transmitter_and_wait(void)
 
 static struct Ex10Result set_gpio_pins(bool pa_bias_enable, bool rf_ps_enable)
 {
+    struct Ex10PowerModesPrivate* power_modes = get_power_modes_context();
+
     struct Ex10GpioHelpers const* gpio_helpers   = get_ex10_gpio_helpers();
     struct GpioPinsSetClear       gpio_set_clear = {0u, 0u, 0u, 0u};
 
@@ -107,19 +132,21 @@ static struct Ex10Result set_gpio_pins(bool pa_bias_enable, bool rf_ps_enable)
         return ex10_result;
     }
 
-    ex10_result = power_modes.ops->set_clear_gpio_pins(&gpio_set_clear);
+    ex10_result = power_modes->ops->set_clear_gpio_pins(&gpio_set_clear);
     if (ex10_result.error)
     {
         return ex10_result;
     }
 
-    return power_modes.ops->wait_op_completion();
+    return power_modes->ops->wait_op_completion();
 }
 
 static struct Ex10Result powerup_and_init_ex10(void)
 {
+    struct Ex10PowerModesPrivate* power_modes = get_power_modes_context();
+
     int const powerup_status =
-        power_modes.power_transactor->power_up_to_application();
+        power_modes->power_transactor->power_up_to_application();
     if (powerup_status != Application)
     {
         return make_ex10_sdk_error(Ex10ModulePowerModes,
@@ -128,13 +155,13 @@ static struct Ex10Result powerup_and_init_ex10(void)
 
     // Hook up the Ex10Protocol interrupt handler callback with the
     // GpioInterface once powered up into the application.
-    power_modes.protocol->enable_interrupt_handlers(true);
+    power_modes->protocol->enable_interrupt_handlers(true);
 
-    struct Ex10Result ex10_result = power_modes.rf_power->init_ex10();
+    struct Ex10Result ex10_result = power_modes->rf_power->init_ex10();
 
     if (ex10_result.error == false)
     {
-        ex10_result = power_modes.reader->init_ex10();
+        ex10_result = power_modes->reader->init_ex10();
     }
 
     return ex10_result;
@@ -142,6 +169,8 @@ static struct Ex10Result powerup_and_init_ex10(void)
 
 static struct Ex10Result set_power_mode_cold(bool radio_power_enable)
 {
+    struct Ex10PowerModesPrivate* power_modes = get_power_modes_context();
+
     struct Ex10Result ex10_result = stop_transmitter_and_wait();
 
     if (ex10_result.error == false)
@@ -153,12 +182,12 @@ static struct Ex10Result set_power_mode_cold(bool radio_power_enable)
 
     if (ex10_result.error == false)
     {
-        ex10_result = power_modes.ops->radio_power_control(radio_power_enable);
+        ex10_result = power_modes->ops->radio_power_control(radio_power_enable);
     }
 
     if (ex10_result.error == false)
     {
-        ex10_result = power_modes.ops->wait_op_completion();
+        ex10_result = power_modes->ops->wait_op_completion();
     }
 
     return ex10_result;
@@ -166,16 +195,18 @@ static struct Ex10Result set_power_mode_cold(bool radio_power_enable)
 
 static struct Ex10Result set_power_mode_off(void)
 {
+    struct Ex10PowerModesPrivate* power_modes = get_power_modes_context();
+
     struct Ex10Result const ex10_result = stop_transmitter_and_wait();
 
     // Before powering down the Impinj Reader Chip, disable interrupt
     // processing, thereby ignoring the IRQ_N falling edge associated with
     // removing power.
-    power_modes.protocol->enable_interrupt_handlers(false);
+    power_modes->protocol->enable_interrupt_handlers(false);
     // deinit reader
-    power_modes.reader->deinit();
+    power_modes->reader->deinit();
 
-    power_modes.power_transactor->power_down();
+    power_modes->power_transactor->power_down();
 
     // Flush all packets contained within the SDK FifoBufferNode nodes.
     // Note: flush_packets must be false since the Ex10 is powered down.
@@ -185,41 +216,47 @@ static struct Ex10Result set_power_mode_off(void)
     get_ex10_helpers()->discard_packets(
         print_packets, flush_packets, debug_aggregate_op);
 
-    power_modes.power_mode =
-        ex10_result.error ? power_modes.power_mode : PowerModeOff;
+    power_modes->power_mode =
+        ex10_result.error ? power_modes->power_mode : PowerModeOff;
 
     return ex10_result;
 }
 
 static struct Ex10Result set_power_mode_standby(void)
 {
+    struct Ex10PowerModesPrivate* power_modes = get_power_modes_context();
+
     bool const        ex10_radio_power_enable = false;
     struct Ex10Result ex10_result =
         set_power_mode_cold(ex10_radio_power_enable);
-    power_modes.power_mode =
-        ex10_result.error ? power_modes.power_mode : PowerModeStandby;
+    power_modes->power_mode =
+        ex10_result.error ? power_modes->power_mode : PowerModeStandby;
     return ex10_result;
 }
 
 static struct Ex10Result set_power_mode_ready_cold(void)
 {
+    struct Ex10PowerModesPrivate* power_modes = get_power_modes_context();
+
     bool const        ex10_radio_power_enable = true;
     struct Ex10Result ex10_result =
         set_power_mode_cold(ex10_radio_power_enable);
-    power_modes.power_mode =
-        ex10_result.error ? power_modes.power_mode : PowerModeReadyCold;
+    power_modes->power_mode =
+        ex10_result.error ? power_modes->power_mode : PowerModeReadyCold;
     return ex10_result;
 }
 
 static struct Ex10Result set_power_mode_ready(void)
 {
+    struct Ex10PowerModesPrivate* power_modes = get_power_modes_context();
+
     bool const        ex10_radio_power_enable = true;
     struct Ex10Result ex10_result =
-        power_modes.ops->radio_power_control(ex10_radio_power_enable);
+        power_modes->ops->radio_power_control(ex10_radio_power_enable);
 
     if (ex10_result.error == false)
     {
-        ex10_result = power_modes.ops->wait_op_completion();
+        ex10_result = power_modes->ops->wait_op_completion();
     }
 
     if (ex10_result.error == false)
@@ -233,16 +270,22 @@ static struct Ex10Result set_power_mode_ready(void)
         get_ex10_board_spec()->get_pa_bias_power_on_delay_ms();
     get_ex10_time_helpers()->busy_wait_ms(delay_time_ms);
 
-    power_modes.power_mode =
-        ex10_result.error ? power_modes.power_mode : PowerModeReady;
+    power_modes->power_mode =
+        ex10_result.error ? power_modes->power_mode : PowerModeReady;
     return ex10_result;
 }
 
 static struct Ex10Result set_power_mode(enum PowerMode power_mode)
 {
-    if (power_modes.power_mode != power_mode)
+    struct Ex10PowerModesPrivate* power_modes = get_power_modes_context();
+
+    if (power_modes->power_mode != power_mode)
     {
-        if (power_modes.power_mode == PowerModeOff)
+        // The device may lose or reinitialize register values across
+        // power mode transitions.
+        power_modes->protocol->invalidate_register_shadow();
+
+        if (power_modes->power_mode == PowerModeOff)
         {
             struct Ex10Result const ex10_result = powerup_and_init_ex10();
             if (ex10_result.error)
@@ -279,7 +322,9 @@ static struct Ex10Result set_power_mode(enum PowerMode power_mode)
 
 static enum PowerMode get_power_mode(void)
 {
-    return power_modes.power_mode;
+    struct Ex10PowerModesPrivate* power_modes = get_power_modes_context();
+
+    return power_modes->power_mode;
 }
 
 struct Ex10PowerModes const* get_ex10_power_modes(void)
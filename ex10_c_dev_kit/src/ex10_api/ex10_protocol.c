@@ -18,20 +18,25 @@
 #include <unistd.h>
 
 #include "board/board_spec.h"
+#include "board/ex10_cal_cache.h"
 #include "board/ex10_osal.h"
 #include "board/time_helpers.h"
+#include "ex10_api/aggregate_op_builder.h"
 #include "ex10_api/application_registers.h"
 #include "ex10_api/board_init.h"
 #include "ex10_api/bootloader_registers.h"
 #include "ex10_api/command_transactor.h"
 #include "ex10_api/commands.h"
 #include "ex10_api/crc16.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/event_fifo_packet_types.h"
 #include "ex10_api/ex10_macros.h"
+#include "ex10_api/ex10_perf_counters.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_protocol.h"
 #include "ex10_api/fifo_buffer_list.h"
 #include "ex10_api/gpio_interface.h"
+#include "ex10_api/lock_free_ring.h"
 #include "ex10_api/trace.h"
 
 
@@ -46,8 +51,255 @@ static struct InterruptMaskFields const irq_mask_clear = {
     .aggregate_op_done       = false,
 };
 
-static void (*fifo_data_callback)(struct FifoBufferNode*)       = NULL;
-static bool (*interrupt_callback)(struct InterruptStatusFields) = NULL;
+/**
+ * The drain thread hands every FifoBufferNode in both the event fifo and the
+ * result buffer lists to the parse thread.
+ */
+#define FIFO_PIPELINE_CAPACITY (2u * FIFO_BUFFER_LIST_CAPACITY)
+
+/**
+ * @struct FifoPipeline
+ * The threads and hand off state of the EventFifo pipeline.
+ * @see Ex10Protocol.start_fifo_pipeline()
+ */
+struct FifoPipeline
+{
+    struct Ex10FifoPipelineConfig config;
+
+    ex10_thread_t drain_thread;
+    ex10_thread_t parse_thread;
+
+    /// Guards the fields below; the drain_cond and parse_cond wake the drain
+    /// and parse threads respectively.
+    ex10_mutex_t lock;
+    ex10_cond_t  drain_cond;
+    ex10_cond_t  parse_cond;
+    bool         drain_running;
+    bool         parse_running;
+    bool         irq_pending;
+    bool         irq_attributes_pending;
+
+    /// Serializes interrupt servicing between the IRQ_N monitor thread and
+    /// the drain thread, and guards service_enabled.
+    ex10_mutex_t service_lock;
+    bool         service_enabled;
+
+    /// The FifoBufferNodes read by the drain thread, in EventFifo order.
+    struct Ex10RingCell     parse_cells[FIFO_PIPELINE_CAPACITY];
+    struct Ex10LockFreeRing parse_ring;
+};
+
+/**
+ * @struct FifoThresholdController
+ * The adaptive EventFifo threshold controller and the interrupt traffic
+ * counters it is driven by. Guarded by the FifoPipeline service_lock.
+ */
+struct FifoThresholdController
+{
+    struct Ex10EventFifoThresholdConfig config;
+    struct Ex10EventFifoThresholdStats  stats;
+
+    uint32_t window_start_ms;
+    uint32_t last_interrupt_ms;
+    size_t   window_interrupts;
+    size_t   window_reads;
+    size_t   window_bytes;
+
+    /// The relax thread lowers a raised threshold once the interrupts stop;
+    /// the relax_cond wakes it when the threshold or controller changes.
+    ex10_thread_t relax_thread;
+    ex10_cond_t   relax_cond;
+    bool          relax_running;
+};
+
+/**
+ * @struct OpCompletion
+ * Signals op completion interrupts to threads blocked in
+ * wait_op_completion_with_timeout().
+ */
+struct OpCompletion
+{
+    ex10_mutex_t lock;
+    ex10_cond_t  cond;
+
+    /// The number of op_done or aggregate_op_done interrupts serviced.
+    size_t done_count;
+};
+
+/**
+ * The registers held in the register shadow. These are ReadWrite
+ * configuration registers which the host writes and the device only reads;
+ * registers which ops update (e.g. TxFineGain, SjcCdacI/Q, OpsControl) are
+ * not shadowed. The exception is the GPIO output registers, which are
+ * invalidated whenever a GPIO op runs; see register_shadow_op_mask().
+ * Each register must fit within REGISTER_SHADOW_MAX_LENGTH.
+ */
+static struct RegisterInfo const* const shadowed_registers[] = {
+    &gpio_output_enable_reg,
+    &gpio_output_level_reg,
+    &event_fifo_int_level_reg,
+    &power_control_loop_aux_adc_control_reg,
+    &power_control_loop_gain_divisor_reg,
+    &power_control_loop_max_iterations_reg,
+    &power_control_loop_adc_target_reg,
+    &power_control_loop_adc_thresholds_reg,
+    &rx_gain_control_reg,
+    &rf_mode_reg,
+    &etsi_burst_off_time_reg,
+    &measure_rssi_count_reg,
+    &lbt_offset_reg,
+    &lbt_control_reg,
+    &rf_synthesizer_control_reg,
+    &sjc_control_reg,
+    &sjc_gain_control_reg,
+    &sjc_initial_settling_time_reg,
+    &sjc_residue_settling_time_reg,
+    &sjc_residue_threshold_reg,
+    &power_droop_compensation_reg,
+    &rssi_threshold_rn16_reg,
+    &rssi_threshold_epc_reg,
+    &nominal_stop_time_reg,
+    &extended_stop_time_reg,
+    &regulatory_stop_time_reg,
+    &gen2_select_enable_reg,
+    &gen2_access_enable_reg,
+    &gen2_auto_access_enable_reg,
+    &gen2_offsets_reg,
+    &gen2_lengths_reg,
+    &gen2_transaction_ids_reg,
+    &gen2_txn_controls_reg,
+    &drop_query_control_reg,
+    &tag_features_control_reg,
+};
+
+#define REGISTER_SHADOW_COUNT ARRAY_SIZE(shadowed_registers)
+
+static_assert(REGISTER_SHADOW_COUNT <= 64u,
+              "The register shadow entries are tracked in a uint64_t mask");
+
+/// The bit mask of all register shadow entries.
+#define REGISTER_SHADOW_ALL_ENTRIES \
+    (UINT64_MAX >> (64u - REGISTER_SHADOW_COUNT))
+
+/// The largest register held in the register shadow, in bytes.
+#define REGISTER_SHADOW_MAX_LENGTH ((size_t)40u)
+
+/// The most registers in a write_multiple() call which are checked against
+/// the register shadow; longer lists are written through in full.
+#define REGISTER_SHADOW_MAX_BATCH ((size_t)16u)
+
+/**
+ * @struct RegisterShadowAlias
+ * A WriteOnly register whose writes modify a shadowed register.
+ */
+struct RegisterShadowAlias
+{
+    struct RegisterInfo const* alias;
+    struct RegisterInfo const* reg_info;
+};
+
+static struct RegisterShadowAlias const register_shadow_aliases[] = {
+    {&gpio_output_level_set_reg, &gpio_output_level_reg},
+    {&gpio_output_level_clear_reg, &gpio_output_level_reg},
+    {&gpio_output_enable_set_reg, &gpio_output_enable_reg},
+    {&gpio_output_enable_clear_reg, &gpio_output_enable_reg},
+};
+
+/**
+ * @struct RegisterShadowEntry
+ * The value of a shadowed register, as last read from or written to the
+ * device.
+ */
+struct RegisterShadowEntry
+{
+    bool    valid;
+    uint8_t data[REGISTER_SHADOW_MAX_LENGTH];
+};
+
+/**
+ * @struct RegisterShadow
+ * The write-through register shadow. Accessed with the host interface
+ * locked; i.e. within _gpio_if->irq_enable(false) and irq_enable(true).
+ */
+struct RegisterShadow
+{
+    bool                       enabled;
+    struct RegisterShadowEntry entries[REGISTER_SHADOW_COUNT];
+
+    /// The entries which the AggregateOp buffer loaded by the host may
+    /// modify when it runs.
+    uint64_t aggregate_op_mask;
+
+    struct Ex10RegisterShadowStats stats;
+};
+
+/**
+ * @struct ProtocolContext
+ * The Ex10Protocol state kept for each Ex10 context.
+ */
+struct ProtocolContext
+{
+    void (*fifo_data_callback)(struct FifoBufferNode*);
+    bool (*interrupt_callback)(struct InterruptStatusFields);
+    size_t upload_remaining_length;
+    size_t upload_image_length;
+
+    /// The interrupt mask set by register_interrupt_callback().
+    struct InterruptMaskFields interrupt_mask;
+    struct OpCompletion        op_completion;
+
+    struct FifoPipeline            pipeline;
+    struct FifoThresholdController threshold_controller;
+    struct RegisterShadow          register_shadow;
+};
+
+static struct ProtocolContext protocol_contexts[EX10_MAX_CONTEXTS];
+static struct Ex10ContextOnce protocol_contexts_once;
+
+static void init_protocol_contexts(void)
+{
+    for (size_t index = 0u; index < EX10_MAX_CONTEXTS; ++index)
+    {
+        struct ProtocolContext* context = &protocol_contexts[index];
+
+        ex10_mutex_init(&context->op_completion.lock);
+        ex10_cond_init(&context->op_completion.cond);
+
+        ex10_mutex_init(&context->pipeline.lock);
+        ex10_cond_init(&context->pipeline.drain_cond);
+        ex10_cond_init(&context->pipeline.parse_cond);
+        ex10_mutex_init(&context->pipeline.service_lock);
+        context->pipeline.service_enabled = true;
+
+        ex10_cond_init(&context->threshold_controller.relax_cond);
+    }
+}
+
+static struct ProtocolContext* get_protocol_context(void)
+{
+    ex10_context_init_once(&protocol_contexts_once, init_protocol_contexts);
+    return &protocol_contexts[ex10_context_index()];
+}
+
+static struct Ex10EventFifoThresholdConfig const
+    default_event_fifo_threshold_config = {
+        .min_threshold            = 0u,
+        .max_threshold            = (EX10_EVENT_FIFO_SIZE * 3u) / 4u,
+        .target_interrupt_rate_hz = 250u,
+        .window_ms                = 100u,
+};
+
+/// When raising the threshold from zero, raise it to about one TagRead.
+static size_t const event_fifo_threshold_step = 64u;
+
+/// While blocked waiting for an op completion interrupt, poll the OpsStatus
+/// register at this interval in case the interrupt was missed.
+static uint32_t const op_done_poll_interval_us = 10u * 1000u;
+
+/// Set in the threads which service interrupts: the IRQ_N monitor thread and
+/// the EventFifo pipeline drain thread. These threads cannot block waiting
+/// for an interrupt which they would service themselves.
+static EX10_THREAD_LOCAL bool is_interrupt_thread = false;
 
 static struct Ex10GpioInterface const*     _gpio_if                 = NULL;
 static struct HostInterface const*         _host_if                 = NULL;
@@ -71,23 +323,27 @@ static enum Status                get_running_location(void);
 static struct Ex10Result          wait_op_completion(void);
 static struct Ex10Result          wait_op_completion_with_timeout(uint32_t);
 static struct ImageValidityFields get_image_validity(void);
-
-static size_t upload_remaining_length = 0;
-static size_t upload_image_length     = 0;
+static struct ImageValidityFields revalidate_image(void);
 
 static void upload_reset(void)
 {
-    upload_remaining_length = 0;
-    upload_image_length     = 0;
+    struct ProtocolContext* proto = get_protocol_context();
+
+    proto->upload_remaining_length = 0;
+    proto->upload_image_length     = 0;
 }
 
 static void unregister_fifo_data_callback(void)
 {
-    fifo_data_callback = NULL;
+    struct ProtocolContext* proto = get_protocol_context();
+
+    proto->fifo_data_callback = NULL;
 }
 
 static struct Ex10Result unregister_interrupt_callback(void)
 {
+    struct ProtocolContext* proto = get_protocol_context();
+
     _gpio_if->irq_enable(false);
     bool const ex10_is_powered = _gpio_if->get_board_power();
     _gpio_if->irq_enable(true);
@@ -104,7 +360,8 @@ static struct Ex10Result unregister_interrupt_callback(void)
     }
 
     // Clear callback
-    interrupt_callback = NULL;
+    proto->interrupt_callback = NULL;
+    proto->interrupt_mask     = irq_mask_clear;
 
     return make_ex10_success();
 }
@@ -112,15 +369,17 @@ static struct Ex10Result unregister_interrupt_callback(void)
 static struct Ex10Result register_fifo_data_callback(
     void (*fifo_cb)(struct FifoBufferNode*))
 {
-    if (fifo_data_callback != NULL)
+    struct ProtocolContext* proto = get_protocol_context();
+
+    if (proto->fifo_data_callback != NULL)
     {
         ex10_eprintf("fifo_data_callback = %p, expected NULL\n",
-                     fifo_data_callback);
+                     proto->fifo_data_callback);
         return make_ex10_sdk_error(Ex10ModuleProtocol,
                                    Ex10SdkErrorInvalidState);
     }
 
-    fifo_data_callback = fifo_cb;
+    proto->fifo_data_callback = fifo_cb;
 
     return make_ex10_success();
 }
@@ -129,15 +388,18 @@ static struct Ex10Result register_interrupt_callback(
     struct InterruptMaskFields enable_mask,
     bool (*interrupt_cb)(struct InterruptStatusFields))
 {
-    if (interrupt_callback != NULL)
+    struct ProtocolContext* proto = get_protocol_context();
+
+    if (proto->interrupt_callback != NULL)
     {
         ex10_eprintf("interrupt_callback = %p, expected NULL\n",
-                     interrupt_callback);
+                     proto->interrupt_callback);
         return make_ex10_sdk_error(Ex10ModuleProtocol,
                                    Ex10SdkErrorInvalidState);
     }
 
-    interrupt_callback = interrupt_cb;
+    proto->interrupt_callback = interrupt_cb;
+    proto->interrupt_mask     = enable_mask;
 
     // Overwrite the interrupt mask register
     return proto_write(&interrupt_mask_reg, &enable_mask);
@@ -184,8 +446,8 @@ static struct FifoBufferNode* read_event_fifo(size_t fifo_num_bytes)
         return make_ex10_result_fifo_packet(ex10_result, us_counter);
     }
 
-    // The response code will be placed in the byte prior to the
-    // first packet which is 32-bit aligned.
+    // The response code is received separately; the first packet is
+    // placed at the start of the 32-bit aligned raw buffer.
     struct ByteSpan bytes = {
         .data   = fifo_buffer->raw_buffer.data,
         .length = fifo_num_bytes,
@@ -213,8 +475,161 @@ static struct FifoBufferNode* read_event_fifo(size_t fifo_num_bytes)
     return fifo_buffer;
 }
 
-static void interrupt_handler(void)
+/**
+ * Pass a FifoBufferNode to the fifo_data_callback, or release it if there
+ * is no consumer of the data.
+ */
+static void deliver_fifo_buffer(struct FifoBufferNode* fifo_buffer)
+{
+    struct ProtocolContext* proto = get_protocol_context();
+
+    if (proto->fifo_data_callback != NULL)
+    {
+        proto->fifo_data_callback(fifo_buffer);
+    }
+    else
+    {
+        // There are no consumers of the data; free the buffer.
+        ex10_release_buffer_node(fifo_buffer);
+    }
+}
+
+/**
+ * Pass a FifoBufferNode to the fifo_data_callback, either directly or, when
+ * called from the drain thread, by handing it off to the parse thread.
+ */
+static void dispatch_fifo_buffer(struct FifoBufferNode* fifo_buffer,
+                                 bool                   pipelined)
+{
+    if (pipelined == false)
+    {
+        deliver_fifo_buffer(fifo_buffer);
+        return;
+    }
+
+    struct FifoPipeline* pipeline = &get_protocol_context()->pipeline;
+    if (ring_push(&pipeline->parse_ring, fifo_buffer, NULL) == false)
+    {
+        // The ring is sized to hold every FifoBufferNode.
+        ex10_eprintf("EventFifo pipeline full, node dropped\n");
+        ex10_release_buffer_node(fifo_buffer);
+        return;
+    }
+
+    ex10_mutex_lock(&pipeline->lock);
+    ex10_cond_signal(&pipeline->parse_cond);
+    ex10_mutex_unlock(&pipeline->lock);
+}
+
+/**
+ * At the end of each controller window, record the window statistics and,
+ * if the controller is enabled, raise or lower the EventFifo threshold.
+ * @see struct Ex10EventFifoThresholdConfig
+ *
+ * @note The caller must hold the pipeline service_lock.
+ */
+static void update_event_fifo_threshold(void)
+{
+    struct FifoThresholdController* controller =
+        &get_protocol_context()->threshold_controller;
+    struct Ex10EventFifoThresholdStats* stats = &controller->stats;
+
+    uint32_t const elapsed_ms =
+        get_ex10_time_helpers()->time_elapsed(controller->window_start_ms);
+    if (elapsed_ms < controller->config.window_ms || elapsed_ms == 0u)
+    {
+        return;
+    }
+
+    struct FifoBufferListStats list_stats;
+    _fifo_buffer_list->get_stats(&list_stats);
+
+    stats->interrupt_rate_hz =
+        (uint32_t)((controller->window_interrupts * 1000u) / elapsed_ms);
+    stats->bytes_per_read = (controller->window_reads > 0u)
+                                ? controller->window_bytes /
+                                      controller->window_reads
+                                : 0u;
+    stats->queue_depth = list_stats.in_use;
+
+    controller->window_start_ms   = get_ex10_time_helpers()->time_now();
+    controller->window_interrupts = 0u;
+    controller->window_reads      = 0u;
+    controller->window_bytes      = 0u;
+
+    if (stats->enabled == false)
+    {
+        return;
+    }
+
+    uint32_t const target_rate_hz = controller->config.target_interrupt_rate_hz;
+    bool const     consumer_behind =
+        (list_stats.in_use * 2u) > list_stats.buffer_count;
+
+    size_t threshold = stats->threshold;
+    if (stats->interrupt_rate_hz > target_rate_hz || consumer_behind)
+    {
+        threshold = (threshold < event_fifo_threshold_step)
+                        ? event_fifo_threshold_step
+                        : threshold * 2u;
+        threshold = (threshold < controller->config.max_threshold)
+                        ? threshold
+                        : controller->config.max_threshold;
+    }
+    else if (stats->interrupt_rate_hz * 2u < target_rate_hz)
+    {
+        threshold = threshold / 2u;
+        threshold = (threshold > controller->config.min_threshold)
+                        ? threshold
+                        : controller->config.min_threshold;
+    }
+
+    if (threshold == stats->threshold)
+    {
+        return;
+    }
+
+    struct EventFifoIntLevelFields const level_data = {
+        .threshold = (uint16_t)threshold, .rfu = 0u};
+    struct Ex10Result const ex10_result =
+        proto_write(&event_fifo_int_level_reg, &level_data);
+    if (ex10_result.error)
+    {
+        ex10_eprintf("EventFifo threshold update failed:\n");
+        print_ex10_result(ex10_result);
+        return;
+    }
+
+    if (threshold > stats->threshold)
+    {
+        stats->increase_count += 1u;
+        ex10_cond_signal(&controller->relax_cond);
+    }
+    else
+    {
+        stats->decrease_count += 1u;
+    }
+    stats->threshold = threshold;
+}
+
+/**
+ * Read the interrupt status and, if requested by the interrupt_callback,
+ * the EventFifo contents.
+ *
+ * @note The caller must hold the pipeline service_lock.
+ *
+ * @param pipelined true if called from the drain thread; the EventFifo
+ *                  data is then handed off to the parse thread.
+ */
+static void service_interrupt(bool pipelined)
 {
+    struct ProtocolContext* proto = get_protocol_context();
+
+    if (proto->pipeline.service_enabled == false)
+    {
+        return;
+    }
+
     struct RegisterInfo const* const reg_list[] = {
         &status_reg, &interrupt_status_reg, &event_fifo_num_bytes_reg};
 
@@ -230,14 +645,14 @@ static void interrupt_handler(void)
         ex10_eprintf("read_multiple() failed:\n");
         print_ex10_result(ex10_result);
 
-        if (fifo_data_callback != NULL)
+        if (proto->fifo_data_callback != NULL)
         {
             const uint32_t         us_counter = 0;
             struct FifoBufferNode* fifo_buffer =
                 make_ex10_result_fifo_packet(ex10_result, us_counter);
             if (fifo_buffer)
             {
-                fifo_data_callback(fifo_buffer);
+                dispatch_fifo_buffer(fifo_buffer, pipelined);
             }
         }
 
@@ -246,6 +661,20 @@ static void interrupt_handler(void)
 
     tracepoint(pi_ex10sdk, PROTOCOL_interrupt, irq_status);
 
+    if (irq_status.op_done || irq_status.aggregate_op_done)
+    {
+        ex10_mutex_lock(&proto->op_completion.lock);
+        proto->op_completion.done_count += 1u;
+        ex10_cond_signal(&proto->op_completion.cond);
+        ex10_mutex_unlock(&proto->op_completion.lock);
+    }
+
+    struct FifoThresholdController* controller = &proto->threshold_controller;
+    controller->stats.interrupt_count += 1u;
+    controller->window_interrupts += 1u;
+    controller->last_interrupt_ms = get_ex10_time_helpers()->time_now();
+    get_ex10_perf_counters()->record_interrupt();
+
     if (status.status != Application)
     {
         // Don't perform interrupt actions if we are not in the application.
@@ -256,10 +685,10 @@ static void interrupt_handler(void)
     bool trigger_fifo_read = false;
     // If the interrupt fires, the interrupt registration set it, so we perform
     // the interrupt callback for any interrupt.
-    if (interrupt_callback != NULL)
+    if (proto->interrupt_callback != NULL)
     {
         // The non fifo interrupt can trigger a fifo callback
-        trigger_fifo_read = interrupt_callback(irq_status);
+        trigger_fifo_read = proto->interrupt_callback(irq_status);
     }
 
     if (trigger_fifo_read)
@@ -275,105 +704,997 @@ static void interrupt_handler(void)
                 read_event_fifo(fifo_num_bytes.num_bytes);
             if (fifo_buffer != NULL)
             {
-                if (fifo_data_callback != NULL)
-                {
-                    fifo_data_callback(fifo_buffer);
-                }
-                else
-                {
-                    // There are no consumers of the data; free the buffer.
-                    ex10_release_buffer_node(fifo_buffer);
-                }
+                dispatch_fifo_buffer(fifo_buffer, pipelined);
             }
+
+            controller->stats.read_fifo_count += 1u;
+            controller->stats.read_fifo_bytes += fifo_num_bytes.num_bytes;
+            controller->window_reads += 1u;
+            controller->window_bytes += fifo_num_bytes.num_bytes;
+            get_ex10_perf_counters()->record_read_fifo(
+                fifo_num_bytes.num_bytes);
         }
     }
+
+    update_event_fifo_threshold();
 }
 
-static void enable_interrupt_handlers(bool enable)
+static void interrupt_handler(void)
 {
-    // Note: The IRQ_N monitor thread remains running, even when we disable
-    // its callback function int the Ex10GpioInterface.
-    _gpio_if->irq_monitor_callback_enable(enable);
+    struct FifoPipeline* pipeline = &get_protocol_context()->pipeline;
+    is_interrupt_thread           = true;
+
+    ex10_mutex_lock(&pipeline->lock);
+    bool const pipelined = pipeline->drain_running;
+    if (pipelined)
+    {
+        if (pipeline->irq_attributes_pending)
+        {
+            pipeline->irq_attributes_pending = false;
+            int const result                 = ex10_thread_set_attributes(
+                ex10_thread_self(), &pipeline->config.irq_thread);
+            if (result != 0)
+            {
+                ex10_eprintf("IRQ_N monitor thread attributes failed: %d\n",
+                             result);
+            }
+        }
+        pipeline->irq_pending = true;
+        ex10_cond_signal(&pipeline->drain_cond);
+    }
+    ex10_mutex_unlock(&pipeline->lock);
+
+    if (pipelined == false)
+    {
+        ex10_mutex_lock(&pipeline->service_lock);
+        service_interrupt(false);
+        ex10_mutex_unlock(&pipeline->service_lock);
+    }
 }
 
-static void init(struct Ex10DriverList const* driver_list)
+/**
+ * The EventFifo pipeline drain thread: services the interrupts posted by
+ * the IRQ_N monitor thread.
+ *
+ * @param thread_arg The index of the Ex10 context which started the pipeline.
+ *
+ * @return void*     The return pointer will be the same as the pointer
+ *                   passed in.
+ */
+static void* fifo_drain_thread(void* thread_arg)
 {
-    interrupt_callback = NULL;
-    fifo_data_callback = NULL;
+    ex10_context_select((size_t)(uintptr_t)thread_arg);
+    struct FifoPipeline* pipeline = &get_protocol_context()->pipeline;
+    is_interrupt_thread           = true;
 
-    _gpio_if       = &driver_list->gpio_if;
-    _host_if       = &driver_list->host_if;
-    _ex10_commands = get_ex10_commands();
+    ex10_mutex_lock(&pipeline->lock);
+    while (pipeline->drain_running)
+    {
+        if (pipeline->irq_pending == false)
+        {
+            ex10_cond_wait(&pipeline->drain_cond, &pipeline->lock);
+            continue;
+        }
 
-    _ex10_command_transactor = get_ex10_command_transactor();
-    _ex10_command_transactor->init(&driver_list->gpio_if,
-                                   &driver_list->host_if);
+        // Interrupts posted while servicing are handled by the next pass;
+        // the interrupt status register accumulates until it is read.
+        pipeline->irq_pending = false;
+        ex10_mutex_unlock(&pipeline->lock);
 
-    _fifo_buffer_list = get_ex10_fifo_buffer_list();
+        ex10_mutex_lock(&pipeline->service_lock);
+        service_interrupt(true);
+        ex10_mutex_unlock(&pipeline->service_lock);
+
+        ex10_mutex_lock(&pipeline->lock);
+    }
+    ex10_mutex_unlock(&pipeline->lock);
+
+    return thread_arg;
 }
 
-static struct Ex10Result init_ex10(void)
+/**
+ * The EventFifo pipeline parse thread: passes the FifoBufferNodes read by
+ * the drain thread to the fifo_data_callback.
+ *
+ * @param thread_arg The index of the Ex10 context which started the pipeline.
+ *
+ * @return void*     The return pointer will be the same as the pointer
+ *                   passed in.
+ */
+static void* fifo_parse_thread(void* thread_arg)
 {
-    // Disable all interrupts
-    struct Ex10Result ex10_result =
-        proto_write(&interrupt_mask_reg, &irq_mask_clear);
-    if (ex10_result.error)
+    ex10_context_select((size_t)(uintptr_t)thread_arg);
+    struct FifoPipeline* pipeline = &get_protocol_context()->pipeline;
+
+    for (;;)
+    {
+        struct FifoBufferNode* fifo_buffer =
+            (struct FifoBufferNode*)ring_pop(&pipeline->parse_ring);
+        if (fifo_buffer != NULL)
+        {
+            deliver_fifo_buffer(fifo_buffer);
+            continue;
+        }
+
+        // The drain thread pushes before acquiring the lock to signal, so
+        // checking the ring while holding the lock cannot miss a wakeup.
+        ex10_mutex_lock(&pipeline->lock);
+        bool const running = pipeline->parse_running;
+        if (running && ring_front(&pipeline->parse_ring) == NULL)
+        {
+            ex10_cond_wait(&pipeline->parse_cond, &pipeline->lock);
+        }
+        ex10_mutex_unlock(&pipeline->lock);
+
+        if (running == false && ring_front(&pipeline->parse_ring) == NULL)
+        {
+            break;
+        }
+    }
+
+    return thread_arg;
+}
+
+/**
+ * Stop and join the pipeline threads which were started.
+ * The drain thread is stopped first so that every FifoBufferNode it read
+ * is delivered by the parse thread before it exits.
+ */
+static void join_fifo_pipeline_threads(bool drain_started, bool parse_started)
+{
+    struct FifoPipeline* pipeline = &get_protocol_context()->pipeline;
+
+    ex10_mutex_lock(&pipeline->lock);
+    pipeline->drain_running = false;
+    pipeline->irq_pending   = false;
+    ex10_cond_signal(&pipeline->drain_cond);
+    ex10_mutex_unlock(&pipeline->lock);
+    if (drain_started)
+    {
+        ex10_thread_join(pipeline->drain_thread);
+    }
+
+    ex10_mutex_lock(&pipeline->lock);
+    pipeline->parse_running = false;
+    ex10_cond_signal(&pipeline->parse_cond);
+    ex10_mutex_unlock(&pipeline->lock);
+    if (parse_started)
+    {
+        ex10_thread_join(pipeline->parse_thread);
+    }
+}
+
+static struct Ex10Result start_fifo_pipeline(
+    struct Ex10FifoPipelineConfig const* config)
+{
+    if (config == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol,
+                                   Ex10SdkErrorNullPointer);
+    }
+
+    struct FifoPipeline* pipeline   = &get_protocol_context()->pipeline;
+    void* const          thread_arg = (void*)(uintptr_t)ex10_context_index();
+
+    ex10_mutex_lock(&pipeline->lock);
+    bool const running = pipeline->drain_running || pipeline->parse_running;
+    ex10_mutex_unlock(&pipeline->lock);
+    if (running)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol,
+                                   Ex10SdkErrorInvalidState);
+    }
+
+    pipeline->config = *config;
+    ring_init(&pipeline->parse_ring,
+              pipeline->parse_cells,
+              FIFO_PIPELINE_CAPACITY);
+
+    // The parse thread must be running before the drain thread hands off
+    // FifoBufferNodes, and the drain thread before the IRQ_N monitor thread
+    // posts wakeups.
+    pipeline->parse_running = true;
+    int result              = ex10_thread_create(
+        &pipeline->parse_thread, fifo_parse_thread, thread_arg);
+    if (result != 0)
+    {
+        join_fifo_pipeline_threads(false, false);
+        return make_ex10_sdk_error_with_status(
+            Ex10ModuleProtocol, Ex10SdkErrorGpioInterface, (uint32_t)result);
+    }
+
+    result = ex10_thread_set_attributes(pipeline->parse_thread,
+                                        &pipeline->config.parse_thread);
+    if (result != 0)
+    {
+        join_fifo_pipeline_threads(false, true);
+        return make_ex10_sdk_error_with_status(
+            Ex10ModuleProtocol, Ex10SdkErrorGpioInterface, (uint32_t)result);
+    }
+
+    ex10_mutex_lock(&pipeline->lock);
+    pipeline->drain_running          = true;
+    pipeline->irq_pending            = false;
+    pipeline->irq_attributes_pending = true;
+    ex10_mutex_unlock(&pipeline->lock);
+
+    result = ex10_thread_create(
+        &pipeline->drain_thread, fifo_drain_thread, thread_arg);
+    if (result == 0)
+    {
+        result = ex10_thread_set_attributes(pipeline->drain_thread,
+                                            &pipeline->config.drain_thread);
+        if (result != 0)
+        {
+            join_fifo_pipeline_threads(true, true);
+        }
+    }
+    else
+    {
+        join_fifo_pipeline_threads(false, true);
+    }
+
+    if (result != 0)
+    {
+        return make_ex10_sdk_error_with_status(
+            Ex10ModuleProtocol, Ex10SdkErrorGpioInterface, (uint32_t)result);
+    }
+
+    return make_ex10_success();
+}
+
+static struct Ex10Result stop_fifo_pipeline(void)
+{
+    struct FifoPipeline* pipeline = &get_protocol_context()->pipeline;
+
+    ex10_mutex_lock(&pipeline->lock);
+    bool const running = pipeline->drain_running;
+    ex10_mutex_unlock(&pipeline->lock);
+    if (running == false)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol,
+                                   Ex10SdkErrorInvalidState);
+    }
+
+    join_fifo_pipeline_threads(true, true);
+    return make_ex10_success();
+}
+
+/**
+ * Record the EventFifo threshold written to the Impinj Reader Chip.
+ */
+static void set_cached_event_fifo_threshold(size_t threshold)
+{
+    struct ProtocolContext* proto = get_protocol_context();
+
+    ex10_mutex_lock(&proto->pipeline.service_lock);
+    proto->threshold_controller.stats.threshold = threshold;
+    ex10_mutex_unlock(&proto->pipeline.service_lock);
+}
+
+/**
+ * Lower a raised EventFifo threshold to the controller minimum. The EventFifo
+ * bytes held below the raised threshold are not read here: the Impinj Reader
+ * Chip raises the EventFifoAboveThresh interrupt for them, which the IRQ_N
+ * monitor (or pipeline drain) thread services.
+ *
+ * @note The caller must hold the pipeline service_lock.
+ */
+static void relax_fifo_threshold(void)
+{
+    struct ProtocolContext*         proto      = get_protocol_context();
+    struct FifoThresholdController* controller = &proto->threshold_controller;
+
+    if (proto->pipeline.service_enabled == false)
+    {
+        return;
+    }
+
+    struct EventFifoIntLevelFields const level_data = {
+        .threshold = (uint16_t)controller->config.min_threshold, .rfu = 0u};
+    struct Ex10Result const ex10_result =
+        proto_write(&event_fifo_int_level_reg, &level_data);
+    if (ex10_result.error)
+    {
+        ex10_eprintf("EventFifo threshold update failed:\n");
+        print_ex10_result(ex10_result);
+        return;
+    }
+
+    controller->stats.threshold = controller->config.min_threshold;
+    controller->stats.decrease_count += 1u;
+    controller->stats.idle_decrease_count += 1u;
+}
+
+/**
+ * The adaptive threshold controller relax thread: lowers a raised EventFifo
+ * threshold once no interrupt has been serviced for a controller window.
+ * The controller is otherwise only evaluated as interrupts are serviced.
+ *
+ * @param thread_arg The index of the Ex10 context which enabled the
+ *                   controller.
+ *
+ * @return void*     The return pointer will be the same as the pointer
+ *                   passed in.
+ */
+static void* fifo_threshold_relax_thread(void* thread_arg)
+{
+    ex10_context_select((size_t)(uintptr_t)thread_arg);
+    struct ProtocolContext*         proto      = get_protocol_context();
+    struct FifoPipeline*            pipeline   = &proto->pipeline;
+    struct FifoThresholdController* controller = &proto->threshold_controller;
+
+    ex10_mutex_lock(&pipeline->service_lock);
+    while (controller->relax_running)
+    {
+        // Only time out while there is a raised threshold to lower.
+        if ((controller->stats.enabled == false) ||
+            (controller->stats.threshold <= controller->config.min_threshold))
+        {
+            ex10_cond_wait(&controller->relax_cond, &pipeline->service_lock);
+            continue;
+        }
+
+        uint32_t const window_ms = controller->config.window_ms;
+        uint32_t       idle_ms   = get_ex10_time_helpers()->time_elapsed(
+            controller->last_interrupt_ms);
+        if (idle_ms >= window_ms)
+        {
+            // If the write fails, try again after another window.
+            relax_fifo_threshold();
+            idle_ms = 0u;
+        }
+
+        uint64_t const wait_us = (uint64_t)(window_ms - idle_ms) * 1000u;
+        ex10_cond_timed_wait_us(
+            &controller->relax_cond,
+            &pipeline->service_lock,
+            (wait_us < UINT32_MAX) ? (uint32_t)wait_us : UINT32_MAX);
+    }
+    ex10_mutex_unlock(&pipeline->service_lock);
+
+    return thread_arg;
+}
+
+/**
+ * Stop and join the threshold controller relax thread, if it was started.
+ */
+static void join_fifo_threshold_relax_thread(void)
+{
+    struct ProtocolContext*         proto      = get_protocol_context();
+    struct FifoThresholdController* controller = &proto->threshold_controller;
+
+    ex10_mutex_lock(&proto->pipeline.service_lock);
+    bool const running        = controller->relax_running;
+    controller->relax_running = false;
+    ex10_cond_signal(&controller->relax_cond);
+    ex10_mutex_unlock(&proto->pipeline.service_lock);
+
+    if (running)
+    {
+        ex10_thread_join(controller->relax_thread);
+    }
+}
+
+static struct Ex10Result enable_fifo_threshold_control(
+    struct Ex10EventFifoThresholdConfig const* config)
+{
+    if (config == NULL)
+    {
+        config = &default_event_fifo_threshold_config;
+    }
+
+    if ((config->min_threshold > config->max_threshold) ||
+        (config->max_threshold > EX10_EVENT_FIFO_SIZE) ||
+        (config->target_interrupt_rate_hz == 0u) || (config->window_ms == 0u))
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol,
+                                   Ex10SdkErrorBadParamValue);
+    }
+
+    struct ProtocolContext*         proto      = get_protocol_context();
+    struct FifoThresholdController* controller = &proto->threshold_controller;
+
+    ex10_mutex_lock(&proto->pipeline.service_lock);
+
+    // The relax thread is started by the first enable and runs until deinit.
+    if (controller->relax_running == false)
+    {
+        void* const thread_arg = (void*)(uintptr_t)ex10_context_index();
+        int const   result     = ex10_thread_create(
+            &controller->relax_thread, fifo_threshold_relax_thread, thread_arg);
+        if (result != 0)
+        {
+            ex10_mutex_unlock(&proto->pipeline.service_lock);
+            return make_ex10_sdk_error_with_status(Ex10ModuleProtocol,
+                                                   Ex10SdkErrorGpioInterface,
+                                                   (uint32_t)result);
+        }
+        controller->relax_running = true;
+    }
+
+    size_t threshold = controller->stats.threshold;
+    if (threshold < config->min_threshold)
+    {
+        threshold = config->min_threshold;
+    }
+    if (threshold > config->max_threshold)
+    {
+        threshold = config->max_threshold;
+    }
+
+    struct EventFifoIntLevelFields const level_data = {
+        .threshold = (uint16_t)threshold, .rfu = 0u};
+    struct Ex10Result const ex10_result =
+        proto_write(&event_fifo_int_level_reg, &level_data);
+    if (ex10_result.error == false)
+    {
+        controller->config              = *config;
+        controller->stats.enabled       = true;
+        controller->stats.threshold     = threshold;
+        controller->stats.min_threshold = config->min_threshold;
+        controller->stats.max_threshold = config->max_threshold;
+
+        controller->window_start_ms   = get_ex10_time_helpers()->time_now();
+        controller->last_interrupt_ms = controller->window_start_ms;
+        controller->window_interrupts = 0u;
+        controller->window_reads      = 0u;
+        controller->window_bytes      = 0u;
+        ex10_cond_signal(&controller->relax_cond);
+    }
+
+    ex10_mutex_unlock(&proto->pipeline.service_lock);
+    return ex10_result;
+}
+
+static void disable_fifo_threshold_control(void)
+{
+    struct ProtocolContext* proto = get_protocol_context();
+
+    ex10_mutex_lock(&proto->pipeline.service_lock);
+    proto->threshold_controller.stats.enabled = false;
+    ex10_cond_signal(&proto->threshold_controller.relax_cond);
+    ex10_mutex_unlock(&proto->pipeline.service_lock);
+}
+
+static void get_fifo_threshold_stats(
+    struct Ex10EventFifoThresholdStats* stats)
+{
+    struct ProtocolContext* proto = get_protocol_context();
+
+    ex10_mutex_lock(&proto->pipeline.service_lock);
+    *stats = proto->threshold_controller.stats;
+    ex10_mutex_unlock(&proto->pipeline.service_lock);
+}
+
+static void enable_interrupt_handlers(bool enable)
+{
+    struct FifoPipeline* pipeline = &get_protocol_context()->pipeline;
+
+    // Note: The IRQ_N monitor thread remains running, even when we disable
+    // its callback function int the Ex10GpioInterface.
+    _gpio_if->irq_monitor_callback_enable(enable);
+
+    // Wait for the drain thread to finish servicing an interrupt which was
+    // posted before the IRQ_N monitor callback was disabled.
+    ex10_mutex_lock(&pipeline->service_lock);
+    pipeline->service_enabled = enable;
+    ex10_mutex_unlock(&pipeline->service_lock);
+}
+
+static void init(struct Ex10DriverList const* driver_list)
+{
+    struct ProtocolContext* proto = get_protocol_context();
+
+    proto->interrupt_callback       = NULL;
+    proto->fifo_data_callback       = NULL;
+    proto->pipeline.service_enabled = true;
+
+    // The relax thread, if started by an earlier enable, keeps running.
+    struct FifoThresholdController* controller = &proto->threshold_controller;
+    ex10_mutex_lock(&proto->pipeline.service_lock);
+    ex10_memzero(&controller->stats, sizeof(controller->stats));
+    controller->config              = default_event_fifo_threshold_config;
+    controller->stats.threshold     = DEFAULT_EVENT_FIFO_THRESHOLD;
+    controller->stats.min_threshold = controller->config.min_threshold;
+    controller->stats.max_threshold = controller->config.max_threshold;
+    controller->window_start_ms     = 0u;
+    controller->last_interrupt_ms   = 0u;
+    controller->window_interrupts   = 0u;
+    controller->window_reads        = 0u;
+    controller->window_bytes        = 0u;
+    ex10_mutex_unlock(&proto->pipeline.service_lock);
+
+    ex10_memzero(&proto->register_shadow, sizeof(proto->register_shadow));
+
+    _gpio_if       = &driver_list->gpio_if;
+    _host_if       = &driver_list->host_if;
+    _ex10_commands = get_ex10_commands();
+
+    _ex10_command_transactor = get_ex10_command_transactor();
+    _ex10_command_transactor->init(&driver_list->gpio_if,
+                                   &driver_list->host_if);
+
+    _fifo_buffer_list = get_ex10_fifo_buffer_list();
+}
+
+static struct Ex10Result init_ex10(void)
+{
+    // Disable all interrupts
+    struct Ex10Result ex10_result =
+        proto_write(&interrupt_mask_reg, &irq_mask_clear);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    // Configure EventFifo interrupt threshold
+    struct EventFifoIntLevelFields const level_data = {
+        .threshold = DEFAULT_EVENT_FIFO_THRESHOLD};
+    ex10_result = proto_write(&event_fifo_int_level_reg, &level_data);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+    set_cached_event_fifo_threshold(level_data.threshold);
+
+    // Clear pending interrupts
+    struct InterruptStatusFields irq_status;
+    ex10_result = proto_read(&interrupt_status_reg, &irq_status);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    // Unregister interrupt based callbacks that may have already been
+    // registered.
+    unregister_fifo_data_callback();
+
+    ex10_result = unregister_interrupt_callback();
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    // Note: Ex10Protocol interrupt processing should not be enabled until
+    // Ex10 is powered into the application.
+    int result = _gpio_if->register_irq_callback(interrupt_handler);
+    if (result != 0)
+    {
+        return make_ex10_sdk_error_with_status(
+            Ex10ModuleProtocol, Ex10SdkErrorGpioInterface, (uint32_t)result);
+    }
+
+    return make_ex10_success();
+}
+
+static struct Ex10Result deinit(void)
+{
+    struct FifoPipeline* pipeline = &get_protocol_context()->pipeline;
+
+    ex10_mutex_lock(&pipeline->lock);
+    bool const pipeline_running = pipeline->drain_running;
+    ex10_mutex_unlock(&pipeline->lock);
+    if (pipeline_running)
+    {
+        join_fifo_pipeline_threads(true, true);
+    }
+    join_fifo_threshold_relax_thread();
+
+    unregister_fifo_data_callback();
+    struct Ex10Result ex10_result = unregister_interrupt_callback();
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    _gpio_if->deregister_irq_callback();
+    _ex10_command_transactor->deinit();
+
+    return make_ex10_success();
+}
+
+static size_t register_length(struct RegisterInfo const* reg_info)
+{
+    return (size_t)reg_info->length * reg_info->num_entries;
+}
+
+/**
+ * Find the shadow entry of a register. The RegisterInfo objects are defined
+ * per translation unit, so registers are matched by address and length.
+ *
+ * @return struct RegisterShadowEntry* The entry, or NULL if the register
+ *         is not shadowed.
+ */
+static struct RegisterShadowEntry* find_register_shadow_entry(
+    struct RegisterShadow*     shadow,
+    struct RegisterInfo const* reg_info)
+{
+    for (size_t iter = 0u; iter < REGISTER_SHADOW_COUNT; ++iter)
+    {
+        struct RegisterInfo const* shadowed = shadowed_registers[iter];
+        if (shadowed->address == reg_info->address &&
+            register_length(shadowed) == register_length(reg_info))
+        {
+            return &shadow->entries[iter];
+        }
+    }
+    return NULL;
+}
+
+static void invalidate_register_shadow_entries(struct RegisterShadow* shadow)
+{
+    for (size_t iter = 0u; iter < REGISTER_SHADOW_COUNT; ++iter)
+    {
+        shadow->entries[iter].valid = false;
+    }
+    shadow->aggregate_op_mask = REGISTER_SHADOW_ALL_ENTRIES;
+    shadow->stats.invalidations += 1u;
+}
+
+static void invalidate_register_shadow_mask(struct RegisterShadow* shadow,
+                                            uint64_t               mask)
+{
+    for (size_t iter = 0u; iter < REGISTER_SHADOW_COUNT; ++iter)
+    {
+        if (mask & (UINT64_C(1) << iter))
+        {
+            shadow->entries[iter].valid = false;
+        }
+    }
+}
+
+/**
+ * @return uint64_t The bit mask of the shadow entries which overlap a
+ *                  register address range.
+ */
+static uint64_t register_shadow_overlap_mask(size_t address, size_t length)
+{
+    uint64_t mask = 0u;
+    for (size_t iter = 0u; iter < REGISTER_SHADOW_COUNT; ++iter)
+    {
+        struct RegisterInfo const* shadowed = shadowed_registers[iter];
+        if (shadowed->address < address + length &&
+            address < shadowed->address + register_length(shadowed))
+        {
+            mask |= UINT64_C(1) << iter;
+        }
+    }
+    return mask;
+}
+
+/**
+ * @return uint64_t The bit mask of the shadow entries which a write to a
+ *                  register address range modifies: the entries it
+ *                  overlaps, and the entries of the WriteOnly aliases it
+ *                  overlaps.
+ */
+static uint64_t register_shadow_write_mask(size_t address, size_t length)
+{
+    uint64_t mask = register_shadow_overlap_mask(address, length);
+    for (size_t iter = 0u; iter < ARRAY_SIZE(register_shadow_aliases); ++iter)
+    {
+        struct RegisterInfo const* alias = register_shadow_aliases[iter].alias;
+        struct RegisterInfo const* reg_info =
+            register_shadow_aliases[iter].reg_info;
+        if (alias->address < address + length &&
+            address < alias->address + register_length(alias))
+        {
+            mask |= register_shadow_overlap_mask(reg_info->address,
+                                                 register_length(reg_info));
+        }
+    }
+    return mask;
+}
+
+/**
+ * @return uint64_t The bit mask of the shadow entries which running an op
+ *                  modifies. The GPIO ops drive the GPIO output registers
+ *                  from their WriteOnly set and clear aliases.
+ */
+static uint64_t register_shadow_op_mask(uint8_t op_id)
+{
+    if (op_id == SetGpioOp || op_id == SetClearGpioPinsOp)
+    {
+        return register_shadow_overlap_mask(
+                   gpio_output_enable_reg.address,
+                   register_length(&gpio_output_enable_reg)) |
+               register_shadow_overlap_mask(
+                   gpio_output_level_reg.address,
+                   register_length(&gpio_output_level_reg));
+    }
+    return 0u;
+}
+
+/**
+ * Find the shadowed registers which an AggregateOp buffer writes, or which
+ * the ops it runs modify.
+ *
+ * @param data   The AggregateOp buffer, from its first instruction.
+ * @param length The number of bytes written to the buffer.
+ *
+ * @return uint64_t The bit mask of the shadow entries which running the
+ *         buffer may modify. All entries are included if the buffer resets
+ *         the device, cannot be parsed, or does not reach an exit
+ *         instruction within the bytes written.
+ */
+static uint64_t aggregate_op_shadow_mask(uint8_t const* data, size_t length)
+{
+    uint64_t mask = 0u;
+    size_t   idx  = 0u;
+    while (idx < length)
+    {
+        uint8_t const* args      = &data[idx + 1u];
+        size_t const   remaining = length - idx - 1u;
+        size_t         args_size = 0u;
+        switch (data[idx])
+        {
+            case InstructionTypeWrite:
+            {
+                // The address and length are each 16 bits, little endian.
+                size_t const write_header_size = 4u;
+                if (remaining < write_header_size)
+                {
+                    return REGISTER_SHADOW_ALL_ENTRIES;
+                }
+                size_t const address      = args[0] | ((size_t)args[1] << 8u);
+                size_t const write_length = args[2] | ((size_t)args[3] << 8u);
+                mask |= register_shadow_write_mask(address, write_length);
+                args_size = write_header_size + write_length;
+                break;
+            }
+            case InstructionTypeInsertFifoEvent:
+                // The trigger_irq byte, then the packet; the first byte of
+                // the packet is its length in 32-bit words.
+                if (remaining < 2u)
+                {
+                    return REGISTER_SHADOW_ALL_ENTRIES;
+                }
+                args_size = 1u + args[1] * sizeof(uint32_t);
+                break;
+            case InstructionTypeRunOp:
+                if (remaining < 1u)
+                {
+                    return REGISTER_SHADOW_ALL_ENTRIES;
+                }
+                mask |= register_shadow_op_mask(args[0]);
+                args_size = sizeof(struct AggregateRunOpFormat);
+                break;
+            case InstructionTypeGoToIndex:
+            {
+                args_size = sizeof(struct AggregateGoToIndexFormat);
+                size_t const jump_index =
+                    (remaining < 2u) ? length
+                                     : (args[0] | ((size_t)args[1] << 8u));
+                if (jump_index >= length)
+                {
+                    return REGISTER_SHADOW_ALL_ENTRIES;
+                }
+                break;
+            }
+            case InstructionTypeIdentifier:
+                args_size = sizeof(struct AggregateIdentifierFormat);
+                break;
+            case InstructionTypeExitInstruction:
+                return mask;
+            case InstructionTypeReset:
+            case InstructionTypeReserved:
+            default:
+                return REGISTER_SHADOW_ALL_ENTRIES;
+        }
+        idx += 1u + args_size;
+    }
+    return REGISTER_SHADOW_ALL_ENTRIES;
+}
+
+/**
+ * Invalidate the shadow entries affected by a register write that does not
+ * match a shadowed register: a partial or indexed write, a write to a
+ * WriteOnly alias, or the start of an op.
+ */
+static void invalidate_register_shadow_overlap(
+    struct RegisterShadow*     shadow,
+    struct RegisterInfo const* reg_info,
+    void const*                buffer)
+{
+    size_t const address = reg_info->address;
+    size_t const length  = register_length(reg_info);
+
+    if (address == ops_control_reg.address)
+    {
+        struct OpsControlFields const* ops_control = buffer;
+        if (ops_control->op_id == AggregateOp)
+        {
+            invalidate_register_shadow_mask(shadow, shadow->aggregate_op_mask);
+        }
+        else
+        {
+            invalidate_register_shadow_mask(
+                shadow, register_shadow_op_mask(ops_control->op_id));
+        }
+        return;
+    }
+
+    if (address == aggregate_op_buffer_reg.address)
+    {
+        shadow->aggregate_op_mask = aggregate_op_shadow_mask(buffer, length);
+        return;
+    }
+
+    if (address < aggregate_op_buffer_reg.address +
+                      register_length(&aggregate_op_buffer_reg) &&
+        aggregate_op_buffer_reg.address < address + length)
+    {
+        shadow->aggregate_op_mask = REGISTER_SHADOW_ALL_ENTRIES;
+        return;
+    }
+
+    invalidate_register_shadow_mask(
+        shadow, register_shadow_write_mask(address, length));
+}
+
+/**
+ * Serve a register read from the shadow.
+ *
+ * @return bool true if every register was shadowed and valid, and has been
+ *              copied into its buffer; false if the device must be read.
+ */
+static bool read_register_shadow(struct RegisterShadow*           shadow,
+                                 struct RegisterInfo const* const reg_list[],
+                                 void*                            buffers[],
+                                 size_t                           num_regs)
+{
+    for (size_t iter = 0u; iter < num_regs; ++iter)
+    {
+        struct RegisterShadowEntry const* entry =
+            find_register_shadow_entry(shadow, reg_list[iter]);
+        if (entry == NULL || entry->valid == false)
+        {
+            return false;
+        }
+    }
+
+    for (size_t iter = 0u; iter < num_regs; ++iter)
+    {
+        struct RegisterShadowEntry const* entry =
+            find_register_shadow_entry(shadow, reg_list[iter]);
+        memcpy(buffers[iter], entry->data, register_length(reg_list[iter]));
+        shadow->stats.read_hits += 1u;
+    }
+    return true;
+}
+
+/**
+ * Update the shadow with the registers read from or written to the device.
+ */
+static void update_register_shadow(struct RegisterShadow*           shadow,
+                                   struct RegisterInfo const* const reg_list[],
+                                   void const* const                buffers[],
+                                   size_t                           num_regs,
+                                   bool                             is_read)
+{
+    for (size_t iter = 0u; iter < num_regs; ++iter)
+    {
+        struct RegisterShadowEntry* entry =
+            find_register_shadow_entry(shadow, reg_list[iter]);
+        if (entry != NULL)
+        {
+            memcpy(entry->data, buffers[iter], register_length(reg_list[iter]));
+            entry->valid = true;
+            if (is_read)
+            {
+                shadow->stats.read_misses += 1u;
+            }
+            else
+            {
+                shadow->stats.write_misses += 1u;
+            }
+        }
+        else if (is_read == false)
+        {
+            invalidate_register_shadow_overlap(
+                shadow, reg_list[iter], buffers[iter]);
+        }
+    }
+}
+
+static struct Ex10Result write_multiple_shadowed(
+    struct RegisterShadow*           shadow,
+    struct RegisterInfo const* const reg_list[],
+    void const*                      buffers[],
+    size_t                           num_regs)
+{
+    struct Ex10Result ex10_result;
+    if (num_regs > REGISTER_SHADOW_MAX_BATCH)
     {
+        ex10_result = _ex10_commands->write(
+            reg_list, buffers, num_regs, NOMINAL_READY_N_TIMEOUT_MS);
+        if (ex10_result.error)
+        {
+            invalidate_register_shadow_entries(shadow);
+        }
+        else
+        {
+            update_register_shadow(shadow, reg_list, buffers, num_regs, false);
+        }
         return ex10_result;
     }
 
-    // Configure EventFifo interrupt threshold
-    struct EventFifoIntLevelFields const level_data = {
-        .threshold = DEFAULT_EVENT_FIFO_THRESHOLD};
-    ex10_result = proto_write(&event_fifo_int_level_reg, &level_data);
-    if (ex10_result.error)
+    // Drop the registers which already hold the value being written.
+    struct RegisterInfo const* write_regs[REGISTER_SHADOW_MAX_BATCH];
+    void const*                write_buffers[REGISTER_SHADOW_MAX_BATCH];
+    size_t                     write_count = 0u;
+    for (size_t iter = 0u; iter < num_regs; ++iter)
     {
-        return ex10_result;
+        struct RegisterShadowEntry const* entry =
+            find_register_shadow_entry(shadow, reg_list[iter]);
+        if (entry != NULL && entry->valid &&
+            memcmp(entry->data,
+                   buffers[iter],
+                   register_length(reg_list[iter])) == 0)
+        {
+            shadow->stats.write_hits += 1u;
+        }
+        else
+        {
+            write_regs[write_count]    = reg_list[iter];
+            write_buffers[write_count] = buffers[iter];
+            write_count += 1u;
+        }
     }
 
-    // Clear pending interrupts
-    struct InterruptStatusFields irq_status;
-    ex10_result = proto_read(&interrupt_status_reg, &irq_status);
-    if (ex10_result.error)
+    if (write_count == 0u)
     {
-        return ex10_result;
+        return make_ex10_success();
     }
 
-    // Unregister interrupt based callbacks that may have already been
-    // registered.
-    unregister_fifo_data_callback();
-
-    ex10_result = unregister_interrupt_callback();
+    ex10_result = _ex10_commands->write(
+        write_regs, write_buffers, write_count, NOMINAL_READY_N_TIMEOUT_MS);
     if (ex10_result.error)
     {
-        return ex10_result;
+        // The device may have accepted some of the writes.
+        invalidate_register_shadow_entries(shadow);
     }
-
-    // Note: Ex10Protocol interrupt processing should not be enabled until
-    // Ex10 is powered into the application.
-    int result = _gpio_if->register_irq_callback(interrupt_handler);
-    if (result != 0)
+    else
     {
-        return make_ex10_sdk_error_with_status(
-            Ex10ModuleProtocol, Ex10SdkErrorGpioInterface, (uint32_t)result);
+        update_register_shadow(
+            shadow, write_regs, write_buffers, write_count, false);
     }
+    return ex10_result;
+}
 
-    return make_ex10_success();
+static void enable_register_shadow(bool enable)
+{
+    struct RegisterShadow* shadow = &get_protocol_context()->register_shadow;
+
+    _gpio_if->irq_enable(false);
+    invalidate_register_shadow_entries(shadow);
+    shadow->enabled = enable;
+    _gpio_if->irq_enable(true);
 }
 
-static struct Ex10Result deinit(void)
+static void invalidate_register_shadow(void)
 {
-    unregister_fifo_data_callback();
-    struct Ex10Result ex10_result = unregister_interrupt_callback();
-    if (ex10_result.error)
+    struct RegisterShadow* shadow = &get_protocol_context()->register_shadow;
+
+    _gpio_if->irq_enable(false);
+    invalidate_register_shadow_entries(shadow);
+    _gpio_if->irq_enable(true);
+}
+
+static void get_register_shadow_stats(struct Ex10RegisterShadowStats* stats)
+{
+    if (stats == NULL)
     {
-        return ex10_result;
+        return;
     }
 
-    _gpio_if->deregister_irq_callback();
-    _ex10_command_transactor->deinit();
+    struct RegisterShadow* shadow = &get_protocol_context()->register_shadow;
 
-    return make_ex10_success();
+    _gpio_if->irq_enable(false);
+    *stats         = shadow->stats;
+    stats->enabled = shadow->enabled;
+    _gpio_if->irq_enable(true);
 }
 
 static struct Ex10Result read_partial(uint16_t address,
@@ -445,9 +1766,23 @@ static struct Ex10Result read_multiple(
     void*                            buffers[],
     size_t                           num_regs)
 {
+    struct RegisterShadow* shadow = &get_protocol_context()->register_shadow;
+
     _gpio_if->irq_enable(false);
+    if (shadow->enabled &&
+        read_register_shadow(shadow, reg_list, buffers, num_regs))
+    {
+        _gpio_if->irq_enable(true);
+        return make_ex10_success();
+    }
+
     const struct Ex10Result ex10_result = _ex10_commands->read(
         reg_list, buffers, num_regs, NOMINAL_READY_N_TIMEOUT_MS);
+    if (shadow->enabled && ex10_result.error == false)
+    {
+        update_register_shadow(
+            shadow, reg_list, (void const* const*)buffers, num_regs, true);
+    }
     _gpio_if->irq_enable(true);
 
     return ex10_result;
@@ -630,9 +1965,20 @@ static struct Ex10Result write_multiple(
     void const*                      buffers[],
     size_t                           num_regs)
 {
+    struct RegisterShadow* shadow = &get_protocol_context()->register_shadow;
+
     _gpio_if->irq_enable(false);
-    const struct Ex10Result ex10_result = _ex10_commands->write(
-        reg_list, buffers, num_regs, NOMINAL_READY_N_TIMEOUT_MS);
+    struct Ex10Result ex10_result;
+    if (shadow->enabled)
+    {
+        ex10_result =
+            write_multiple_shadowed(shadow, reg_list, buffers, num_regs);
+    }
+    else
+    {
+        ex10_result = _ex10_commands->write(
+            reg_list, buffers, num_regs, NOMINAL_READY_N_TIMEOUT_MS);
+    }
     _gpio_if->irq_enable(true);
 
     return ex10_result;
@@ -727,6 +2073,8 @@ static struct Ex10Result reset(enum Status destination)
 
     // Reset the Ex10, then read the Status register to get running location.
     _gpio_if->irq_enable(false);
+    invalidate_register_shadow_entries(
+        &get_protocol_context()->register_shadow);
     struct Ex10Result ex10_result = _ex10_commands->reset(destination);
     _gpio_if->irq_enable(true);
     if (ex10_result.error)
@@ -765,7 +2113,13 @@ static struct Ex10Result set_event_fifo_threshold(size_t threshold)
 
     struct EventFifoIntLevelFields const event_fifo_thresh = {
         .threshold = (uint16_t)threshold, .rfu = 0u};
-    return proto_write(&event_fifo_int_level_reg, &event_fifo_thresh);
+    struct Ex10Result const ex10_result =
+        proto_write(&event_fifo_int_level_reg, &event_fifo_thresh);
+    if (ex10_result.error == false)
+    {
+        set_cached_event_fifo_threshold(threshold);
+    }
+    return ex10_result;
 }
 
 static struct Ex10Result insert_fifo_event(
@@ -835,20 +2189,109 @@ static struct Ex10Result read_ops_status_reg(struct OpsStatusFields* ops_status)
     return ex10_result;
 }
 
-static struct Ex10Result wait_op_completion_with_timeout(uint32_t timeout_ms)
+/**
+ * Block until the op completion interrupt is serviced, or until the poll
+ * interval expires, and read the OpsStatus register; until the op is done or
+ * the timeout expires.
+ *
+ * @param start_time     The time_now() at which the wait began.
+ * @param timeout_ms     The time allowed for the op to complete.
+ * @param [out] ops_status The last OpsStatus register value read.
+ *
+ * @return struct Ex10Result
+ *         Indicates whether the function call passed or failed.
+ */
+static struct Ex10Result wait_op_completion_interrupt(
+    uint32_t                start_time,
+    uint32_t                timeout_ms,
+    struct OpsStatusFields* ops_status)
 {
-    uint32_t const         start_time = get_ex10_time_helpers()->time_now();
-    struct OpsStatusFields ops_status;
-    struct Ex10Result      ex10_result = read_ops_status_reg(&ops_status);
-    while (ops_status.busy && ex10_result.error == false)
+    struct ProtocolContext* proto      = get_protocol_context();
+    struct OpCompletion*    completion = &proto->op_completion;
+
+    // Arm the op_done interrupt unless the registered interrupt mask
+    // already includes it.
+    struct InterruptMaskFields const op_done_mask = {.op_done = true};
+    bool const arm_op_done = (proto->interrupt_mask.op_done == false);
+    if (arm_op_done)
+    {
+        struct Ex10Result const ex10_result =
+            proto_write(&interrupt_mask_set_reg, &op_done_mask);
+        if (ex10_result.error)
+        {
+            return ex10_result;
+        }
+    }
+
+    // The done_count is sampled before reading the OpsStatus register, so
+    // that an interrupt serviced after the read ends the wait.
+    ex10_mutex_lock(&completion->lock);
+    size_t done_count = completion->done_count;
+    ex10_mutex_unlock(&completion->lock);
+
+    struct Ex10Result ex10_result = read_ops_status_reg(ops_status);
+    while (ops_status->busy && ex10_result.error == false)
     {
         if (get_ex10_time_helpers()->time_elapsed(start_time) >= timeout_ms)
         {
-            ex10_result = make_ex10_ops_timeout_error(ops_status);
+            ex10_result = make_ex10_ops_timeout_error(*ops_status);
+            break;
+        }
+
+        ex10_mutex_lock(&completion->lock);
+        if (completion->done_count == done_count)
+        {
+            ex10_cond_timed_wait_us(&completion->cond,
+                                    &completion->lock,
+                                    op_done_poll_interval_us);
         }
-        else
+        done_count = completion->done_count;
+        ex10_mutex_unlock(&completion->lock);
+
+        ex10_result = read_ops_status_reg(ops_status);
+    }
+
+    if (arm_op_done)
+    {
+        struct Ex10Result const clear_result =
+            proto_write(&interrupt_mask_clear_reg, &op_done_mask);
+        if (ex10_result.error == false)
+        {
+            ex10_result = clear_result;
+        }
+    }
+
+    return ex10_result;
+}
+
+static struct Ex10Result wait_op_completion_with_timeout(uint32_t timeout_ms)
+{
+    uint32_t const         start_time = get_ex10_time_helpers()->time_now();
+    struct OpsStatusFields ops_status;
+    struct Ex10Result      ex10_result;
+
+    // Note: irq_monitor_callback_is_enabled() must not be called from the
+    // IRQ_N monitor thread while it is dispatching the callback.
+    if ((is_interrupt_thread == false) &&
+        _gpio_if->irq_monitor_callback_is_enabled())
+    {
+        ex10_result =
+            wait_op_completion_interrupt(start_time, timeout_ms, &ops_status);
+    }
+    else
+    {
+        ex10_result = read_ops_status_reg(&ops_status);
+        while (ops_status.busy && ex10_result.error == false)
         {
-            ex10_result = read_ops_status_reg(&ops_status);
+            if (get_ex10_time_helpers()->time_elapsed(start_time) >=
+                timeout_ms)
+            {
+                ex10_result = make_ex10_ops_timeout_error(ops_status);
+            }
+            else
+            {
+                ex10_result = read_ops_status_reg(&ops_status);
+            }
         }
     }
 
@@ -914,6 +2357,12 @@ static struct Ex10Result write_info_page(enum PageIds page_id,
         return ex10_result;
     }
 
+    if (page_id == CalPageId)
+    {
+        // The cached calibration info region no longer matches the device.
+        get_ex10_cal_cache_storage()->erase();
+    }
+
     uint16_t crc16 = 0;
     if (write_length)
     {
@@ -1062,6 +2511,8 @@ static struct Ex10Result upload_start(uint8_t                    destination,
                                       size_t                     image_length,
                                       const struct ConstByteSpan image_chunk)
 {
+    struct ProtocolContext* proto = get_protocol_context();
+
     if (get_running_location() != Bootloader)
     {
         return make_ex10_sdk_error(Ex10ModuleProtocol, Ex10SdkErrorRunLocation);
@@ -1077,8 +2528,8 @@ static struct Ex10Result upload_start(uint8_t                    destination,
         return ex10_result;
     }
 
-    upload_remaining_length = image_length;
-    upload_image_length     = image_length;
+    proto->upload_remaining_length = image_length;
+    proto->upload_image_length     = image_length;
 
     _gpio_if->irq_enable(false);
     ex10_result = _ex10_commands->start_upload(destination, &image_chunk);
@@ -1089,6 +2540,8 @@ static struct Ex10Result upload_start(uint8_t                    destination,
 
 static struct Ex10Result upload_continue(const struct ConstByteSpan image_chunk)
 {
+    struct ProtocolContext* proto = get_protocol_context();
+
     if (get_running_location() != Bootloader)
     {
         upload_reset();
@@ -1107,7 +2560,7 @@ static struct Ex10Result upload_continue(const struct ConstByteSpan image_chunk)
                                    Ex10SdkErrorBadParamValue);
     }
 
-    if (image_chunk.length > upload_remaining_length)
+    if (image_chunk.length > proto->upload_remaining_length)
     {
         upload_reset();
         return make_ex10_sdk_error(Ex10ModuleProtocol,
@@ -1125,7 +2578,7 @@ static struct Ex10Result upload_continue(const struct ConstByteSpan image_chunk)
         return ex10_result;
     }
 
-    upload_remaining_length -= image_chunk.length;
+    proto->upload_remaining_length -= image_chunk.length;
 
     // Check upload status
     struct CommandResultFields cmd_result;
@@ -1176,6 +2629,194 @@ static struct Ex10Result upload_complete(void)
     return make_ex10_success();
 }
 
+/**
+ * Read the CommandResult register and report the first failure of the
+ * commands sent since it was last read.
+ */
+static struct Ex10Result check_upload_status(void)
+{
+    struct CommandResultFields cmd_result;
+    struct Ex10Result const    ex10_result =
+        proto_read(&command_result_reg, &cmd_result);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+    if (cmd_result.failed_result_code != Success)
+    {
+        return make_ex10_commands_no_resp_error(cmd_result);
+    }
+    return make_ex10_success();
+}
+
+/**
+ * Send the image chunks of a pipelined upload.
+ *
+ * The chunks between status checks are sent with the interrupt disabled
+ * once, rather than around each chunk; the status check itself disables
+ * the interrupt for the register read.
+ */
+static struct Ex10Result send_upload_chunks(
+    uint8_t                         destination,
+    struct ConstByteSpan            image,
+    struct Ex10UploadOptions const* options)
+{
+    // The chunks are sent from the image buffer, following the command
+    // header, so they are not limited by the size of the command buffer.
+    // Leave room for the command code and the destination.
+    size_t const upload_chunk_size = EX10_MAX_IMAGE_CHUNK_SIZE - 2u;
+
+    struct ConstByteSpan chunk = {
+        .data   = image.data,
+        .length = 0u,
+    };
+    size_t chunk_count = 0u;
+
+    struct Ex10Result ex10_result = make_ex10_success();
+    _gpio_if->irq_enable(false);
+    while (chunk.data < image.data + image.length)
+    {
+        size_t const uploaded_length  = (size_t)(chunk.data - image.data);
+        size_t const remaining_length = image.length - uploaded_length;
+        chunk.length = (remaining_length < upload_chunk_size)
+                           ? remaining_length
+                           : upload_chunk_size;
+
+        ex10_result = (uploaded_length == 0u)
+                          ? _ex10_commands->start_upload(destination, &chunk)
+                          : _ex10_commands->continue_upload(&chunk);
+        if (ex10_result.error)
+        {
+            break;
+        }
+        chunk.data += chunk.length;
+        chunk_count += 1u;
+
+        if (options->status_check_interval != 0u &&
+            chunk_count % options->status_check_interval == 0u)
+        {
+            _gpio_if->irq_enable(true);
+            ex10_result = check_upload_status();
+            if (ex10_result.error)
+            {
+                return ex10_result;
+            }
+            if (options->progress_callback != NULL)
+            {
+                options->progress_callback(
+                    (size_t)(chunk.data - image.data), image.length);
+            }
+            _gpio_if->irq_enable(false);
+        }
+    }
+    _gpio_if->irq_enable(true);
+
+    return ex10_result;
+}
+
+static struct Ex10Result upload_image_pipelined(
+    uint8_t                         destination,
+    struct ConstByteSpan            image,
+    struct Ex10UploadOptions const* options)
+{
+    struct Ex10UploadOptions const default_options = {
+        .status_check_interval = 16u,
+        .check_image_crc16     = false,
+        .image_crc16           = 0u,
+        .progress_callback     = NULL,
+    };
+    if (options == NULL)
+    {
+        options = &default_options;
+    }
+
+    if (get_running_location() != Bootloader)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol, Ex10SdkErrorRunLocation);
+    }
+    if (image.data == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol, Ex10SdkErrorNullPointer);
+    }
+    if (image.length == 0u || image.length > EX10_MAX_IMAGE_BYTES)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol,
+                                   Ex10SdkErrorBadParamLength);
+    }
+    if (options->check_image_crc16 &&
+        ex10_compute_crc16(image.data, image.length) != options->image_crc16)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol,
+                                   Ex10SdkErrorBadParamValue);
+    }
+
+    // Set flash frequency to allow flash programming
+    struct FrefFreqBootloaderFields const fref_freq = {
+        .fref_freq_khz = TCXO_FREQ_KHZ,
+    };
+    struct Ex10Result ex10_result = proto_write(&fref_freq_reg, &fref_freq);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    // The CommandResult register holds the first failure until it is read;
+    // clear a failure left by an earlier command so that the status checks
+    // only report the failures of this upload.
+    struct CommandResultFields cmd_result;
+    ex10_result = proto_read(&command_result_reg, &cmd_result);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    ex10_result = send_upload_chunks(destination, image, options);
+    if (ex10_result.error == false)
+    {
+        // Check the chunks sent since the last status check before the
+        // image is flashed.
+        ex10_result = check_upload_status();
+    }
+    if (ex10_result.error)
+    {
+        upload_reset();
+        return ex10_result;
+    }
+
+    _gpio_if->irq_enable(false);
+    ex10_result = _ex10_commands->complete_upload();
+    _gpio_if->irq_enable(true);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    ex10_result = check_upload_status();
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    if (destination == UploadFlash)
+    {
+        // The host buffer CRC only covers what was sent; have the bootloader
+        // check the image written to flash.
+        struct ImageValidityFields const image_validity = revalidate_image();
+        if ((image_validity.image_valid_marker == false) ||
+            image_validity.image_non_valid_marker)
+        {
+            return make_ex10_sdk_error(Ex10ModuleProtocol,
+                                       Ex10SdkErrorInvalidState);
+        }
+    }
+
+    if (options->progress_callback != NULL)
+    {
+        options->progress_callback(image.length, image.length);
+    }
+    return make_ex10_success();
+}
+
 static struct ImageValidityFields revalidate_image(void)
 {
     // Read the command result register to insure an prior state is cleared.
@@ -1219,6 +2860,8 @@ static struct Ex10Result proto_test_transfer(struct ConstByteSpan const* send,
                                              bool                        verify)
 {
     _gpio_if->irq_enable(false);
+    invalidate_register_shadow_entries(
+        &get_protocol_context()->register_shadow);
     const struct Ex10Result ex10_result =
         _ex10_commands->test_transfer(send, recv, verify);
     _gpio_if->irq_enable(true);
@@ -1494,6 +3137,15 @@ static const struct Ex10Protocol ex10_protocol = {
     .get_image_validity                 = get_image_validity,
     .get_remain_reason                  = get_remain_reason,
     .get_sku                            = get_sku,
+    .start_fifo_pipeline                = start_fifo_pipeline,
+    .stop_fifo_pipeline                 = stop_fifo_pipeline,
+    .enable_fifo_threshold_control      = enable_fifo_threshold_control,
+    .disable_fifo_threshold_control     = disable_fifo_threshold_control,
+    .get_fifo_threshold_stats           = get_fifo_threshold_stats,
+    .enable_register_shadow             = enable_register_shadow,
+    .invalidate_register_shadow         = invalidate_register_shadow,
+    .get_register_shadow_stats          = get_register_shadow_stats,
+    .upload_image_pipelined             = upload_image_pipelined,
 };
 
 struct Ex10Protocol const* get_ex10_protocol(void)
@@ -11,6 +11,7 @@
  *                                                                           *
  *****************************************************************************/
 
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_reader.h"
 #include "board/board_spec.h"
 #include "board/ex10_gpio.h"
@@ -70,7 +71,7 @@ struct Ex10ReaderPrivate
     struct ContinuousInventoryState inventory_state;
 };
 
-static struct Ex10ReaderPrivate reader = {
+static struct Ex10ReaderPrivate const reader_defaults = {
     .stored_analog_rx_fields = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
     .inventory_params =
         {
@@ -103,6 +104,23 @@ static struct Ex10ReaderPrivate reader = {
         },
 };
 
+static struct Ex10ReaderPrivate reader_contexts[EX10_MAX_CONTEXTS];
+static struct Ex10ContextOnce   reader_contexts_once;
+
+static void init_reader_contexts(void)
+{
+    for (size_t index = 0u; index < EX10_MAX_CONTEXTS; ++index)
+    {
+        reader_contexts[index] = reader_defaults;
+    }
+}
+
+static struct Ex10ReaderPrivate* get_reader_context(void)
+{
+    ex10_context_init_once(&reader_contexts_once, init_reader_contexts);
+    return &reader_contexts[ex10_context_index()];
+}
+
 /* Forward declarations */
 static void fifo_data_handler(struct FifoBufferNode* fifo_buffer);
 static bool interrupt_handler(struct InterruptStatusFields irq_status);
@@ -121,13 +139,15 @@ static struct Ex10Result start_inventory(
 
 static void init(enum Ex10RegionId region_id)
 {
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
     // the region is initialized in the core setup now
     (void)region_id;
 
     get_ex10_event_fifo_queue()->init();
 
-    ex10_memzero(&reader.inventory_state, sizeof(reader.inventory_state));
-    reader.inventory_state.state = InvIdle;
+    ex10_memzero(&reader->inventory_state, sizeof(reader->inventory_state));
+    reader->inventory_state.state = InvIdle;
 }
 
 /**
@@ -229,15 +249,17 @@ static void push_continuous_inventory_summary_packet(
     struct EventFifoPacket const* event_packet,
     struct Ex10Result             ex10_result)
 {
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
     uint32_t const duration_us =
-        event_packet->us_counter - reader.inventory_params.start_time_us;
+        event_packet->us_counter - reader->inventory_params.start_time_us;
 
-    uint8_t const stop_reason = (uint8_t)reader.inventory_state.stop_reason;
+    uint8_t const stop_reason = (uint8_t)reader->inventory_state.stop_reason;
 
     struct ContinuousInventorySummary summary = {
         .duration_us                = duration_us,
-        .number_of_inventory_rounds = reader.inventory_state.round_count,
-        .number_of_tags             = reader.inventory_state.tag_count,
+        .number_of_inventory_rounds = reader->inventory_state.round_count,
+        .number_of_tags             = reader->inventory_state.tag_count,
         .reason                     = stop_reason,
         .last_op_id                 = 0u,
         .last_op_error              = ErrorNone,
@@ -311,52 +333,54 @@ static void push_continuous_inventory_summary_packet(
 
 static bool check_stop_conditions(uint32_t timestamp_us)
 {
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
     // if the reason is already set, we return so as to retain the original stop
     // reason
-    if (reader.inventory_state.stop_reason != SRNone)
+    if (reader->inventory_state.stop_reason != SRNone)
     {
         return true;
     }
 
-    if (reader.inventory_params.stop_conditions.max_number_of_rounds > 0u)
+    if (reader->inventory_params.stop_conditions.max_number_of_rounds > 0u)
     {
-        if (reader.inventory_state.round_count >=
-            reader.inventory_params.stop_conditions.max_number_of_rounds)
+        if (reader->inventory_state.round_count >=
+            reader->inventory_params.stop_conditions.max_number_of_rounds)
         {
-            reader.inventory_state.stop_reason = SRMaxNumberOfRounds;
+            reader->inventory_state.stop_reason = SRMaxNumberOfRounds;
             return true;
         }
     }
-    if (reader.inventory_params.stop_conditions.max_number_of_tags > 0u)
+    if (reader->inventory_params.stop_conditions.max_number_of_tags > 0u)
     {
-        if (reader.inventory_state.tag_count >=
-            reader.inventory_params.stop_conditions.max_number_of_tags)
+        if (reader->inventory_state.tag_count >=
+            reader->inventory_params.stop_conditions.max_number_of_tags)
         {
-            reader.inventory_state.stop_reason = SRMaxNumberOfTags;
+            reader->inventory_state.stop_reason = SRMaxNumberOfTags;
             return true;
         }
     }
-    if (reader.inventory_params.stop_conditions.max_duration_us > 0u)
+    if (reader->inventory_params.stop_conditions.max_duration_us > 0u)
     {
         // packet before start checks for packets which occurred before the
         // continuous inventory round was started.
         bool const packet_before_start =
-            (reader.inventory_params.start_time_us > timestamp_us);
+            (reader->inventory_params.start_time_us > timestamp_us);
         uint32_t const elapsed_us =
             (packet_before_start)
-                ? ((UINT32_MAX - reader.inventory_params.start_time_us) +
+                ? ((UINT32_MAX - reader->inventory_params.start_time_us) +
                    timestamp_us + 1)
-                : (timestamp_us - reader.inventory_params.start_time_us);
+                : (timestamp_us - reader->inventory_params.start_time_us);
         if (elapsed_us >=
-            reader.inventory_params.stop_conditions.max_duration_us)
+            reader->inventory_params.stop_conditions.max_duration_us)
         {
-            reader.inventory_state.stop_reason = SRMaxDuration;
+            reader->inventory_state.stop_reason = SRMaxDuration;
             return true;
         }
     }
-    if (reader.inventory_state.state == InvStopRequested)
+    if (reader->inventory_state.state == InvStopRequested)
     {
-        reader.inventory_state.stop_reason = SRHost;
+        reader->inventory_state.stop_reason = SRHost;
         return true;
     }
     return false;
@@ -372,6 +396,8 @@ static bool check_stop_conditions(uint32_t timestamp_us)
  */
 static struct Ex10Result continue_continuous_inventory(void)
 {
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
     /* Behavior for stop reasons:
     InventorySummaryDone          // Flip target (dual target), reset Q
     InventorySummaryHost          // Don't care
@@ -383,38 +409,38 @@ static struct Ex10Result continue_continuous_inventory(void)
     */
 
     bool reset_q = false;
-    if (reader.inventory_params.dual_target)
+    if (reader->inventory_params.dual_target)
     {
         // Flip target if round is done, not for regulatory or error.
-        if (reader.inventory_state.done_reason == InventorySummaryDone)
+        if (reader->inventory_state.done_reason == InventorySummaryDone)
         {
-            reader.inventory_state.target ^= 1u;
+            reader->inventory_state.target ^= 1u;
             reset_q = true;
         }
 
         // If CW is not on and our session is zero (no persistence after power),
         // we need to switch the target to A.
         if ((get_ex10_rf_power()->get_cw_is_on() == false) &&
-            (reader.inventory_params.inventory_config.session == 0))
+            (reader->inventory_params.inventory_config.session == 0))
         {
-            reset_q                       = true;
-            reader.inventory_state.target = target_A;
+            reset_q                        = true;
+            reader->inventory_state.target = target_A;
         }
     }
     else
     {
-        if (reader.inventory_state.done_reason == InventorySummaryDone)
+        if (reader->inventory_state.done_reason == InventorySummaryDone)
         {
             reset_q = true;
         }
     }
 
     struct InventoryRoundControlFields inventory_config =
-        reader.inventory_params.inventory_config;
-    inventory_config.target = reader.inventory_state.target;
+        reader->inventory_params.inventory_config;
+    inventory_config.target = reader->inventory_state.target;
 
     struct InventoryRoundControl_2Fields inventory_config_2 =
-        reader.inventory_params.inventory_config_2;
+        reader->inventory_params.inventory_config_2;
 
     // Preserve Q  and internal LMAC counters across rounds or reset for
     // new target.
@@ -422,27 +448,27 @@ static struct Ex10Result continue_continuous_inventory(void)
     {
         // Reset Q for target flip (done above) or for normal end of round.
         inventory_config.initial_q =
-            reader.inventory_state.initial_inventory_config.initial_q;
+            reader->inventory_state.initial_inventory_config.initial_q;
         inventory_config_2.starting_min_q_count                       = 0;
         inventory_config_2.starting_max_queries_since_valid_epc_count = 0;
     }
-    else if (reader.inventory_state.done_reason == InventorySummaryRegulatory)
+    else if (reader->inventory_state.done_reason == InventorySummaryRegulatory)
     {
         // Preserve Q across rounds
-        inventory_config.initial_q = reader.inventory_state.previous_q;
+        inventory_config.initial_q = reader->inventory_state.previous_q;
         inventory_config_2.starting_min_q_count =
-            reader.inventory_state.min_q_count;
+            reader->inventory_state.min_q_count;
         inventory_config_2.starting_max_queries_since_valid_epc_count =
-            reader.inventory_state.queries_since_valid_epc_count;
+            reader->inventory_state.queries_since_valid_epc_count;
     }
 
-    return start_inventory(reader.inventory_params.antenna,
-                           reader.inventory_params.rf_mode,
-                           reader.inventory_params.tx_power_cdbm,
+    return start_inventory(reader->inventory_params.antenna,
+                           reader->inventory_params.rf_mode,
+                           reader->inventory_params.tx_power_cdbm,
                            &inventory_config,
                            &inventory_config_2,
-                           reader.inventory_params.send_selects,
-                           reader.inventory_params.remain_on);
+                           reader->inventory_params.send_selects,
+                           reader->inventory_params.remain_on);
 }
 
 // Called by the interrupt handler thread when there is a non-fifo related
@@ -458,6 +484,8 @@ static void handle_continuous_inventory_error(
     struct Ex10Result             ex10_result,
     struct EventFifoPacket const* packet)
 {
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
     struct FifoBufferNode* result_buffer_node =
         make_ex10_result_fifo_packet(ex10_result, packet->us_counter);
 
@@ -475,10 +503,10 @@ static void handle_continuous_inventory_error(
         get_ex10_event_fifo_queue()->list_node_push_back(result_buffer_node);
     }
 
-    reader.inventory_state.state = InvIdle;
+    reader->inventory_state.state = InvIdle;
 
     // The error from ex10 result needs to become the new stop reason
-    reader.inventory_state.stop_reason =
+    reader->inventory_state.stop_reason =
         get_ex10_inventory()->ex10_result_to_continuous_inventory_error(
             ex10_result);
     push_continuous_inventory_summary_packet(packet, ex10_result);
@@ -488,40 +516,51 @@ static void handle_continuous_inventory_error(
 // interrupt.
 static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
 {
-    struct ConstByteSpan bytes = fifo_buffer_node->fifo_data;
-    while (bytes.length > 0u)
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
+    // The packets are indexed once here; the index is kept in the node and
+    // reused by the EventFifo queue consumer.
+    struct Ex10EventParser const*  event_parser = get_ex10_event_parser();
+    struct EventPacketIndex const* packet_index =
+        get_ex10_event_fifo_queue()->get_packet_index(fifo_buffer_node);
+
+    for (size_t position = 0u; position < packet_index->packet_count;
+         ++position)
     {
-        struct Ex10EventParser const* event_parser = get_ex10_event_parser();
-        struct EventFifoPacket const  packet =
-            event_parser->parse_event_packet(&bytes);
-        if (event_parser->get_packet_type_valid(packet.packet_type) == false)
+        uint8_t const packet_type = packet_index->packet_types[position];
+        if (packet_type == InvalidPacket)
         {
             // Invalid packets cannot be processed and will only confuse the
             // continuous inventory state machine. Discontinue processing.
             ex10_eprintf(
                 "Invalid packet encountered during continuous inventory "
-                "packet parsing, packet end pos: %zu\n",
-                bytes.length);
+                "packet parsing, packet offset: %u\n",
+                packet_index->packet_offsets[position]);
             break;
         }
-        if (reader.inventory_state.state != InvIdle)
+        if (reader->inventory_state.state != InvIdle)
         {
-            if (packet.packet_type == TagRead)
+            if (packet_type == TagRead)
             {
-                reader.inventory_state.tag_count += 1;
+                reader->inventory_state.tag_count += 1;
             }
-            else if (packet.packet_type == InventoryRoundSummary)
+            else if (packet_type == InventoryRoundSummary)
             {
+                struct EventFifoPacket const packet =
+                    event_parser->get_indexed_packet(
+                        fifo_buffer_node->fifo_data.data,
+                        packet_index,
+                        position);
                 struct Ex10Result ex10_result = make_ex10_success();
                 const uint8_t     reason =
                     packet.static_data->inventory_round_summary.reason;
 
-                reader.inventory_state.min_q_count =
+                reader->inventory_state.min_q_count =
                     packet.static_data->inventory_round_summary.min_q_count;
-                reader.inventory_state.queries_since_valid_epc_count =
+                reader->inventory_state.queries_since_valid_epc_count =
                     packet.static_data->inventory_round_summary
                         .queries_since_valid_epc_count;
-                reader.inventory_state.done_reason = reason;
+                reader->inventory_state.done_reason = reason;
 
                 switch (reason)
                 {
@@ -531,10 +570,10 @@ static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
                         // done or the host told it to stop.  Any other reason
                         // for stopping is not a complete round, but possibly a
                         // reason to continue the inventory round.
-                        reader.inventory_state.round_count += 1;
+                        reader->inventory_state.round_count += 1;
                         break;
                     case InventorySummaryRegulatory:
-                        reader.inventory_state.previous_q =
+                        reader->inventory_state.previous_q =
                             packet.static_data->inventory_round_summary.final_q;
                         break;
                     case InventorySummaryUnsupported:
@@ -571,7 +610,7 @@ static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
                 {
                     // Otherwise check if continuous inventory stopped frmo one
                     // of the expected stop conditions
-                    reader.inventory_state.state = InvIdle;
+                    reader->inventory_state.state = InvIdle;
                     push_continuous_inventory_summary_packet(&packet,
                                                              ex10_result);
                 }
@@ -679,6 +718,8 @@ static struct Ex10Result continuous_inventory(
     bool                                        dual_target,
     bool                                        remain_on)
 {
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
     // Ensure the proper configs were passed in.
     if ((stop_conditions == NULL) || (inventory_config == NULL) ||
         (inventory_config_2 == NULL))
@@ -688,31 +729,31 @@ static struct Ex10Result continuous_inventory(
 
     // Marking that we are in continuous inventory mode and reset all
     // config parameters.
-    reader.inventory_state.state       = InvOngoing;
-    reader.inventory_state.stop_reason = SRNone;
-    reader.inventory_state.round_count = 0u;
+    reader->inventory_state.state       = InvOngoing;
+    reader->inventory_state.stop_reason = SRNone;
+    reader->inventory_state.round_count = 0u;
 
     // Save initial inventory_state values to reset Q on target flip.
     // Note: InventorySummaryReason enum value zero is not enumerated, and
-    reader.inventory_state.initial_inventory_config      = *inventory_config;
-    reader.inventory_state.previous_q                    = 0u;
-    reader.inventory_state.min_q_count                   = 0u;
-    reader.inventory_state.queries_since_valid_epc_count = 0u;
-    reader.inventory_state.done_reason                   = InventorySummaryNone;
-    reader.inventory_state.tag_count                     = 0u;
-    reader.inventory_state.target = inventory_config->target;
+    reader->inventory_state.initial_inventory_config      = *inventory_config;
+    reader->inventory_state.previous_q                    = 0u;
+    reader->inventory_state.min_q_count                   = 0u;
+    reader->inventory_state.queries_since_valid_epc_count = 0u;
+    reader->inventory_state.done_reason = InventorySummaryNone;
+    reader->inventory_state.tag_count   = 0u;
+    reader->inventory_state.target      = inventory_config->target;
 
     // Store passed in params
-    reader.inventory_params.antenna            = antenna;
-    reader.inventory_params.rf_mode            = rf_mode;
-    reader.inventory_params.tx_power_cdbm      = tx_power_cdbm;
-    reader.inventory_params.inventory_config   = *inventory_config;
-    reader.inventory_params.inventory_config_2 = *inventory_config_2;
-    reader.inventory_params.send_selects       = send_selects;
-    reader.inventory_params.stop_conditions    = *stop_conditions;
-    reader.inventory_params.dual_target        = dual_target;
-    reader.inventory_params.remain_on          = remain_on;
-    reader.inventory_params.start_time_us = get_ex10_ops()->get_device_time();
+    reader->inventory_params.antenna            = antenna;
+    reader->inventory_params.rf_mode            = rf_mode;
+    reader->inventory_params.tx_power_cdbm      = tx_power_cdbm;
+    reader->inventory_params.inventory_config   = *inventory_config;
+    reader->inventory_params.inventory_config_2 = *inventory_config_2;
+    reader->inventory_params.send_selects       = send_selects;
+    reader->inventory_params.stop_conditions    = *stop_conditions;
+    reader->inventory_params.dual_target        = dual_target;
+    reader->inventory_params.remain_on          = remain_on;
+    reader->inventory_params.start_time_us = get_ex10_ops()->get_device_time();
 
     // Begin inventory
     struct Ex10Result const ex10_result = start_inventory(antenna,
@@ -724,7 +765,7 @@ static struct Ex10Result continuous_inventory(
                                                           remain_on);
     if (ex10_result.error)
     {
-        reader.inventory_state.state = InvIdle;
+        reader->inventory_state.state = InvIdle;
     }
     return ex10_result;
 }
@@ -736,6 +777,8 @@ static struct Ex10Result reader_ramp_for_inventory(
     bool                                 remain_on,
     struct PowerDroopCompensationFields* droop_comp_fields)
 {
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
     struct Ex10RfPower const* rf_power = get_ex10_rf_power();
     struct Ex10Ops const*     ops      = get_ex10_ops();
 
@@ -787,7 +830,7 @@ static struct Ex10Result reader_ramp_for_inventory(
     // Read back the analog rx settings since we ran sjc in cw_on.
     // Store the results in the local variable stored_analog_rx_fields.
     return get_ex10_protocol()->read(&rx_gain_control_reg,
-                                     &reader.stored_analog_rx_fields);
+                                     &reader->stored_analog_rx_fields);
 }
 
 static struct Ex10Result start_inventory(
@@ -799,6 +842,8 @@ static struct Ex10Result start_inventory(
     bool                                        send_selects,
     bool                                        remain_on)
 {
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
     struct Ex10Protocol const* protocol = get_ex10_protocol();
 
     // Check to make sure that an op isn't running (say if inventory is
@@ -810,7 +855,7 @@ static struct Ex10Result start_inventory(
 
     // continue_continuous_inventory() uses reader.inventory_state.target to
     // set the future values of inventory_config->target. Store it here.
-    reader.inventory_state.target = inventory_config->target;
+    reader->inventory_state.target = inventory_config->target;
 
     // Cache the antenna and mode members of reader.inventory_params
     // for calculating RSSI compensation.
@@ -819,8 +864,8 @@ static struct Ex10Result start_inventory(
     // inventory once the inventory completes. When setting inventory_params
     // members, be sure that the values are consistent with the continuous
     // inventory operation.
-    reader.inventory_params.antenna = antenna;
-    reader.inventory_params.rf_mode = rf_mode;
+    reader->inventory_params.antenna = antenna;
+    reader->inventory_params.rf_mode = rf_mode;
 
     struct Ex10RfPower const*           rf_power = get_ex10_rf_power();
     struct PowerDroopCompensationFields droop_comp_fields =
@@ -832,7 +877,8 @@ static struct Ex10Result start_inventory(
         return ex10_result;
     }
 
-    if (get_ex10_rf_power()->get_cw_is_on() == false)
+    bool const cw_was_on = rf_power->get_cw_is_on();
+    if (cw_was_on == false)
     {
         ex10_result = reader_ramp_for_inventory(
             antenna, rf_mode, tx_power_cdbm, remain_on, &droop_comp_fields);
@@ -844,6 +890,24 @@ static struct Ex10Result start_inventory(
     ex10_result = get_ex10_inventory()->run_inventory(
         inventory_config, inventory_config_2, send_selects);
 
+    if (ex10_result.error == false && cw_was_on == false && remain_on == false)
+    {
+        // While this channel transmits, stage the CwOn aggregate op of the
+        // next channel. Staging is only an optimization: if it fails, the
+        // next cw_on() builds and writes the aggregate op itself.
+        uint16_t const temperature_adc =
+            get_ex10_ramp_module_manager()->retrieve_adc_temperature();
+        bool const temp_comp_enabled =
+            get_ex10_board_spec()->temperature_compensation_enabled(
+                temperature_adc);
+        rf_power->stage_next_cw_on(antenna,
+                                   rf_mode,
+                                   tx_power_cdbm,
+                                   temperature_adc,
+                                   temp_comp_enabled,
+                                   &droop_comp_fields);
+    }
+
     // There is a race condition where the sdk checks for cw, the device
     // reports it is ramped up, then it ramps down before select is run.
     // If this occurs, ramp up and and rerun. Any errors after this get
@@ -888,6 +952,8 @@ static struct Ex10Result cw_test(uint8_t      antenna,
                                  uint32_t     frequency_khz,
                                  bool         remain_on)
 {
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
     struct Ex10RampModuleManager const* ramp_module_manager =
         get_ex10_ramp_module_manager();
     uint16_t temperature_adc = ramp_module_manager->retrieve_adc_temperature();
@@ -947,7 +1013,7 @@ static struct Ex10Result cw_test(uint8_t      antenna,
         // Read back the analog rx settings since we ran sjc in cw_on.
         // Store the results in the local variable stored_analog_rx_fields.
         ex10_result = get_ex10_protocol()->read(
-            &rx_gain_control_reg, &reader.stored_analog_rx_fields);
+            &rx_gain_control_reg, &reader->stored_analog_rx_fields);
     }
     return ex10_result;
 }
@@ -1090,9 +1156,11 @@ static struct Ex10Result enable_sdd_logs(const struct LogEnablesFields enables,
 
 static struct Ex10Result stop_transmitting(void)
 {
-    if (reader.inventory_state.state != InvIdle)
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
+    if (reader->inventory_state.state != InvIdle)
     {
-        reader.inventory_state.state = InvStopRequested;
+        reader->inventory_state.state = InvStopRequested;
     }
 
     return get_ex10_rf_power()->stop_op_and_ramp_down();
@@ -1100,22 +1168,26 @@ static struct Ex10Result stop_transmitting(void)
 
 static int16_t get_current_compensated_rssi(uint16_t rssi_raw)
 {
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
     return get_ex10_calibration()->get_compensated_rssi(
         rssi_raw,
-        reader.inventory_params.rf_mode,
-        &reader.stored_analog_rx_fields,
-        reader.inventory_params.antenna,
+        reader->inventory_params.rf_mode,
+        &reader->stored_analog_rx_fields,
+        reader->inventory_params.antenna,
         get_ex10_active_region()->get_rf_filter(),
         get_ex10_ramp_module_manager()->retrieve_adc_temperature());
 }
 
 static uint16_t get_current_rssi_log2(int16_t rssi_cdbm)
 {
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
     return get_ex10_calibration()->get_rssi_log2(
         rssi_cdbm,
-        reader.inventory_params.rf_mode,
-        &reader.stored_analog_rx_fields,
-        reader.inventory_params.antenna,
+        reader->inventory_params.rf_mode,
+        &reader->stored_analog_rx_fields,
+        reader->inventory_params.antenna,
         get_ex10_active_region()->get_rf_filter(),
         get_ex10_ramp_module_manager()->retrieve_adc_temperature());
 }
@@ -1128,12 +1200,14 @@ static struct Ex10Result listen_before_talk_multi(
     int32_t*                lbt_offsets,
     int16_t*                rssi_measurements)
 {
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
     const struct Ex10ListenBeforeTalk* lbt = get_ex10_listen_before_talk();
 
     // this logic is not needed because the LBT module will ignore
     // the lbt_rx_gains itself if the override is not set.
     struct RxGainControlFields const lbt_rx_gains =
-        (lbt_settings.override) ? reader.stored_analog_rx_fields
+        (lbt_settings.override) ? reader->stored_analog_rx_fields
                                 : lbt->get_default_lbt_rx_analog_configs();
     return lbt->listen_before_talk_multi(antenna,
                                          rssi_count,
@@ -1150,10 +1224,12 @@ static int16_t get_listen_before_talk_rssi(uint8_t  antenna,
                                            uint8_t  rssi_count,
                                            bool     override_used)
 {
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
     const struct Ex10ListenBeforeTalk* lbt = get_ex10_listen_before_talk();
 
     struct RxGainControlFields const lbt_rx_gains =
-        (override_used) ? reader.stored_analog_rx_fields
+        (override_used) ? reader->stored_analog_rx_fields
                         : lbt->get_default_lbt_rx_analog_configs();
     int16_t           lbt_rssi = 0;
     struct Ex10Result ex10_result =
@@ -1173,13 +1249,33 @@ static int16_t get_listen_before_talk_rssi(uint8_t  antenna,
 
 static struct RxGainControlFields const* get_current_analog_rx_fields(void)
 {
-    return &reader.stored_analog_rx_fields;
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
+    return &reader->stored_analog_rx_fields;
 }
 
 static struct ContinuousInventoryState volatile const*
     get_continuous_inventory_state(void)
 {
-    return &(reader.inventory_state);
+    struct Ex10ReaderPrivate* reader = get_reader_context();
+
+    return &(reader->inventory_state);
+}
+
+static struct Ex10Result enable_fifo_threshold_control(
+    struct Ex10EventFifoThresholdConfig const* config)
+{
+    return get_ex10_protocol()->enable_fifo_threshold_control(config);
+}
+
+static void disable_fifo_threshold_control(void)
+{
+    get_ex10_protocol()->disable_fifo_threshold_control();
+}
+
+static void get_fifo_threshold_stats(struct Ex10EventFifoThresholdStats* stats)
+{
+    get_ex10_protocol()->get_fifo_threshold_stats(stats);
 }
 
 struct Ex10Reader const* get_ex10_reader(void)
@@ -1211,6 +1307,9 @@ struct Ex10Reader const* get_ex10_reader(void)
         .get_listen_before_talk_rssi    = get_listen_before_talk_rssi,
         .get_current_analog_rx_fields   = get_current_analog_rx_fields,
         .get_continuous_inventory_state = get_continuous_inventory_state,
+        .enable_fifo_threshold_control  = enable_fifo_threshold_control,
+        .disable_fifo_threshold_control = disable_fifo_threshold_control,
+        .get_fifo_threshold_stats       = get_fifo_threshold_stats,
     };
 
     return &reader_instance;
@@ -18,6 +18,7 @@
 #include "ex10_api/event_fifo_packet_types.h"
 #include "ex10_api/event_packet_parser.h"
 #include "ex10_api/ex10_api_strings.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_result.h"
 #include "ex10_api/fifo_buffer_list.h"
@@ -32,30 +33,31 @@ static_assert(
     sizeof(struct Ex10CommandsHostResult) == 4,
     "Incorrect size of struct Ex10CommandsHostResult, not packed properly");
 
-// Stored error initialized to "Success" value
-static struct Ex10Result ex10_error_list = {.error       = false,
-                                            .customer    = false,
-                                            .rfu         = 0,
-                                            .module      = Ex10ModuleUndefined,
-                                            .result_code = {.raw = 0},
-                                            .device_status = {.raw = 0}};
+// Stored error per context, zero initialized to the "Success" value
+static struct Ex10Result ex10_error_lists[EX10_MAX_CONTEXTS];
 
 static void ex10_error_list_push(struct Ex10Result ex10_result)
 {
+    struct Ex10Result* ex10_error_list =
+        &ex10_error_lists[ex10_context_index()];
+
     // If an error is already logged, it will not be overwritten
-    if (ex10_error_list.error)
+    if (ex10_error_list->error)
     {
         return;
     }
 
-    ex10_error_list = ex10_result;
+    *ex10_error_list = ex10_result;
 }
 
 struct Ex10Result ex10_error_list_pull(void)
 {
-    struct Ex10Result ex10_result = ex10_error_list;
+    struct Ex10Result* ex10_error_list =
+        &ex10_error_lists[ex10_context_index()];
+
+    struct Ex10Result ex10_result = *ex10_error_list;
 
-    ex10_error_list = make_ex10_success();
+    *ex10_error_list = make_ex10_success();
 
     return ex10_result;
 }
@@ -13,13 +13,18 @@
 
 #include "ex10_api/ex10_rf_power.h"
 
+#include <string.h>
+
 #include "board/board_spec.h"
 #include "board/ex10_osal.h"
 #include "board/ex10_rx_baseband_filter.h"
+#include "board/time_helpers.h"
 #include "calibration.h"
 #include "ex10_api/aggregate_op_builder.h"
 #include "ex10_api/application_registers.h"
 #include "ex10_api/ex10_active_region.h"
+#include "ex10_api/ex10_context.h"
+#include "ex10_api/ex10_perf_counters.h"
 #include "ex10_api/trace.h"
 #include "ex10_api/version_info.h"
 #include "ex10_modules/ex10_ramp_module_manager.h"
@@ -31,6 +36,210 @@ static struct PowerDroopCompensationFields droop_comp_defaults = {
     .fine_gain_step_cd_b      = 10,
 };
 
+/// The number of ramp plans held by the ramp plan cache.
+#define RAMP_PLAN_CACHE_CAPACITY ((size_t)64u)
+
+/// The number of slots searched for a plan, starting from its hash slot.
+#define RAMP_PLAN_CACHE_PROBES ((size_t)4u)
+
+/// The largest CwOn aggregate op buffer held by a ramp plan, in bytes.
+#define RAMP_PLAN_AGG_OP_MAX_LENGTH ((size_t)256u)
+
+/**
+ * @struct RampPlanKey
+ * The build_cw_configs() inputs which select a ramp plan.
+ * Keys are zeroed before being filled, so that they compare with memcmp().
+ */
+struct RampPlanKey
+{
+    uint32_t      frequency_khz;
+    enum RfModes  rf_mode;
+    enum RfFilter rf_filter;
+    int16_t       tx_power_cdbm;
+    uint16_t      temperature_bucket;
+    uint8_t       antenna;
+    bool          temp_comp_enabled;
+};
+
+/**
+ * @struct RampPlan
+ * A cached CW ramp: the configuration computed by build_cw_configs(), and
+ * the CwOn aggregate op buffer built from it by cw_on().
+ */
+struct RampPlan
+{
+    bool               valid;
+    struct RampPlanKey key;
+
+    /// The cw_config computed for the key. The timer member is not used;
+    /// regulatory timers are read from the active region on each ramp.
+    struct CwConfig cw_config;
+
+    /// The timers and droop compensation which the aggregate op buffer was
+    /// built with.
+    struct Ex10RegulatoryTimers         timer;
+    struct PowerDroopCompensationFields droop_comp;
+
+    /// The CwOn aggregate op buffer; valid when agg_op_length is not zero.
+    size_t  agg_op_length;
+    uint8_t agg_op_data[RAMP_PLAN_AGG_OP_MAX_LENGTH];
+};
+
+struct RampPlanCache
+{
+    bool            enabled;
+    uint16_t        temperature_bucket_adc;
+    size_t          next_victim;
+    struct RampPlan plans[RAMP_PLAN_CACHE_CAPACITY];
+
+    /// The plan returned by the last build_cw_configs() call, which cw_on()
+    /// is expected to be called with.
+    struct RampPlan* last_plan;
+
+    struct Ex10RampPlanCacheStats stats;
+};
+
+static struct RampPlanCache ramp_plan_cache_contexts[EX10_MAX_CONTEXTS];
+
+static struct RampPlanCache* get_ramp_plan_cache_context(void)
+{
+    return &ramp_plan_cache_contexts[ex10_context_index()];
+}
+
+/**
+ * @struct StagedCwOn
+ * A CwOn aggregate op written to the device aggregate op buffer ahead of
+ * the ramp which will run it, and the configuration it was built from.
+ */
+struct StagedCwOn
+{
+    bool                                valid;
+    uint32_t                            buffer_generation;
+    struct CwConfig                     cw_config;
+    struct PowerDroopCompensationFields droop_comp;
+};
+
+struct PipelinedRamp
+{
+    bool                          enabled;
+    struct StagedCwOn             staged;
+    struct Ex10PipelinedRampStats stats;
+};
+
+static struct PipelinedRamp pipelined_ramp_contexts[EX10_MAX_CONTEXTS];
+
+static struct PipelinedRamp* get_pipelined_ramp_context(void)
+{
+    return &pipelined_ramp_contexts[ex10_context_index()];
+}
+
+static size_t ramp_plan_hash(struct RampPlanKey const* key)
+{
+    // FNV-1a
+    uint8_t const* bytes = (uint8_t const*)key;
+    uint32_t       hash  = 2166136261u;
+    for (size_t iter = 0u; iter < sizeof(*key); ++iter)
+    {
+        hash ^= bytes[iter];
+        hash *= 16777619u;
+    }
+    return hash % RAMP_PLAN_CACHE_CAPACITY;
+}
+
+/**
+ * Find the cached plan for a key, or the slot in which to cache it.
+ *
+ * @param key      The plan key.
+ * @param [out] hit Set true if the returned plan matches the key.
+ *
+ * @return struct RampPlan* The matching plan, an empty slot, or the slot of
+ *         the plan to replace.
+ */
+static struct RampPlan* find_ramp_plan(struct RampPlanKey const* key,
+                                       bool*                     hit)
+{
+    struct RampPlanCache* ramp_plan_cache = get_ramp_plan_cache_context();
+
+    size_t const     slot  = ramp_plan_hash(key);
+    struct RampPlan* empty = NULL;
+    for (size_t probe = 0u; probe < RAMP_PLAN_CACHE_PROBES; ++probe)
+    {
+        struct RampPlan* plan =
+            &ramp_plan_cache->plans[(slot + probe) % RAMP_PLAN_CACHE_CAPACITY];
+        if (plan->valid == false)
+        {
+            empty = (empty == NULL) ? plan : empty;
+        }
+        else if (memcmp(&plan->key, key, sizeof(*key)) == 0)
+        {
+            *hit = true;
+            return plan;
+        }
+    }
+
+    *hit = false;
+    if (empty != NULL)
+    {
+        return empty;
+    }
+
+    // Replace the probed plans in turn.
+    size_t const victim          = ramp_plan_cache->next_victim;
+    ramp_plan_cache->next_victim = (victim + 1u) % RAMP_PLAN_CACHE_PROBES;
+    ramp_plan_cache->stats.evictions += 1u;
+
+    size_t const victim_slot = (slot + victim) % RAMP_PLAN_CACHE_CAPACITY;
+    return &ramp_plan_cache->plans[victim_slot];
+}
+
+static void invalidate_ramp_plan_cache(void)
+{
+    struct RampPlanCache* ramp_plan_cache = get_ramp_plan_cache_context();
+
+    for (size_t iter = 0u; iter < RAMP_PLAN_CACHE_CAPACITY; ++iter)
+    {
+        ramp_plan_cache->plans[iter].valid = false;
+    }
+    ramp_plan_cache->last_plan = NULL;
+}
+
+static struct Ex10Result enable_ramp_plan_cache(
+    uint16_t temperature_bucket_adc)
+{
+    struct RampPlanCache* ramp_plan_cache = get_ramp_plan_cache_context();
+
+    if (temperature_bucket_adc == 0u)
+    {
+        return make_ex10_sdk_error(Ex10ModuleRfPower,
+                                   Ex10SdkErrorBadParamValue);
+    }
+
+    invalidate_ramp_plan_cache();
+    ramp_plan_cache->temperature_bucket_adc = temperature_bucket_adc;
+    ramp_plan_cache->enabled                = true;
+    return make_ex10_success();
+}
+
+static void disable_ramp_plan_cache(void)
+{
+    struct RampPlanCache* ramp_plan_cache = get_ramp_plan_cache_context();
+
+    invalidate_ramp_plan_cache();
+    ramp_plan_cache->enabled = false;
+}
+
+static void get_ramp_plan_cache_stats(struct Ex10RampPlanCacheStats* stats)
+{
+    struct RampPlanCache* ramp_plan_cache = get_ramp_plan_cache_context();
+
+    if (stats != NULL)
+    {
+        *stats                        = ramp_plan_cache->stats;
+        stats->enabled                = ramp_plan_cache->enabled;
+        stats->temperature_bucket_adc = ramp_plan_cache->temperature_bucket_adc;
+    }
+}
+
 static struct Ex10Result set_analog_rx_config(
     struct RxGainControlFields const* analog_rx_fields)
 {
@@ -45,8 +254,13 @@ static struct Ex10Result set_analog_rx_config(
 
 static struct Ex10Result init_ex10(void)
 {
+    struct PipelinedRamp* pipelined_ramp = get_pipelined_ramp_context();
+
     struct Ex10Ops const* ops = get_ex10_ops();
 
+    // The device aggregate op buffer does not survive a power cycle.
+    pipelined_ramp->staged.valid = false;
+
     // Enable the Ex10 analog power supplies by running the RadioPowerControlOp.
     struct Ex10Result ex10_result = ops->radio_power_control(true);
     if (ex10_result.error)
@@ -270,12 +484,54 @@ static struct Ex10Result build_cw_configs(uint8_t          antenna,
                                           bool             temp_comp_enabled,
                                           struct CwConfig* cw_config)
 {
+    struct RampPlanCache* ramp_plan_cache = get_ramp_plan_cache_context();
+
     struct SynthesizerParams synth_params;
     ex10_memzero(&synth_params, sizeof(synth_params));
 
     const struct Ex10ActiveRegion* region = get_ex10_active_region();
 
     uint32_t frequency_khz = region->get_next_channel_khz();
+
+    struct RampPlan* plan = NULL;
+    if (ramp_plan_cache->enabled)
+    {
+        // Calibrate each plan at the center of its temperature bucket.
+        uint16_t const bucket_adc = ramp_plan_cache->temperature_bucket_adc;
+        uint16_t const temperature_bucket = temperature_adc / bucket_adc;
+        temperature_adc =
+            (uint16_t)(temperature_bucket * bucket_adc + bucket_adc / 2u);
+
+        struct RampPlanKey key;
+        ex10_memzero(&key, sizeof(key));
+        key.frequency_khz      = frequency_khz;
+        key.rf_mode            = rf_mode;
+        key.rf_filter          = region->get_rf_filter();
+        key.tx_power_cdbm      = tx_power_cdbm;
+        key.temperature_bucket = temperature_bucket;
+        key.antenna            = antenna;
+        key.temp_comp_enabled  = temp_comp_enabled;
+
+        bool hit                   = false;
+        plan                       = find_ramp_plan(&key, &hit);
+        ramp_plan_cache->last_plan = plan;
+        if (hit)
+        {
+            ramp_plan_cache->stats.plan_hits += 1u;
+            cw_config->gpio    = plan->cw_config.gpio;
+            cw_config->rf_mode = plan->cw_config.rf_mode;
+            cw_config->power   = plan->cw_config.power;
+            cw_config->synth   = plan->cw_config.synth;
+            return region->get_next_channel_regulatory_timers(
+                &cw_config->timer);
+        }
+
+        ramp_plan_cache->stats.plan_misses += 1u;
+        plan->valid         = false;
+        plan->key           = key;
+        plan->agg_op_length = 0u;
+    }
+
     region->get_synthesizer_params(frequency_khz, &synth_params);
 
     cw_config->synth.r_divider = synth_params.r_divider_index;
@@ -316,44 +572,38 @@ static struct Ex10Result build_cw_configs(uint8_t          antenna,
         temp_comp_enabled,
         region->get_rf_filter());
 
+    if (plan != NULL)
+    {
+        plan->cw_config = *cw_config;
+        plan->valid     = true;
+    }
+
     return make_ex10_success();
 }
 
-static struct Ex10Result cw_on(
+/**
+ * Append the CwOn instructions, and the exit instruction, to an aggregate
+ * op buffer. @see Ex10RfPower.cw_on() for the parameters.
+ */
+static struct Ex10Result append_cw_on_instructions(
     struct GpioPinsSetClear const*             gpio_controls,
-    struct PowerConfigs*                       power_config,
+    struct PowerConfigs const*                 power_config,
     struct RfSynthesizerControlFields const*   synth_control,
     struct Ex10RegulatoryTimers const*         timer_config,
-    struct PowerDroopCompensationFields const* droop_comp)
+    struct PowerDroopCompensationFields const* droop_comp,
+    struct ByteSpan*                           agg_buffer)
 {
-    // Prevent redundant CW on
-    if (get_cw_is_on())
-    {
-        // CW is already on, early return
-        return make_ex10_success();
-    }
-
-    uint8_t agg_data[AGGREGATE_OP_BUFFER_REG_LENGTH];
-    ex10_memzero(agg_data, sizeof(agg_data));
-    struct ByteSpan agg_buffer = {.data = agg_data, .length = 0};
     struct Ex10AggregateOpBuilder const* agg_builder =
         get_ex10_aggregate_op_builder();
 
-    tracepoint(pi_ex10sdk,
-               OPS_cw_on,
-               gpio_controls,
-               power_config,
-               synth_control,
-               timer_config);
-
-    if (!agg_builder->append_set_clear_gpio_pins(gpio_controls, &agg_buffer))
+    if (!agg_builder->append_set_clear_gpio_pins(gpio_controls, agg_buffer))
     {
         return make_ex10_sdk_error(Ex10ModuleRfPower,
                                    Ex10SdkErrorAggBufferOverflow);
     }
 
     if (!agg_builder->append_lock_synthesizer(
-            synth_control->r_divider, synth_control->n_divider, &agg_buffer))
+            synth_control->r_divider, synth_control->n_divider, agg_buffer))
     {
         return make_ex10_sdk_error(Ex10ModuleRfPower,
                                    Ex10SdkErrorAggBufferOverflow);
@@ -361,26 +611,26 @@ static struct Ex10Result cw_on(
 
     // If the coarse gain has changes, store the new val and run the op
     if (!agg_builder->append_set_tx_coarse_gain(power_config->tx_atten,
-                                                &agg_buffer))
+                                                agg_buffer))
     {
         return make_ex10_sdk_error(Ex10ModuleRfPower,
                                    Ex10SdkErrorAggBufferOverflow);
     }
 
     if (!agg_builder->append_set_tx_fine_gain(power_config->tx_scalar,
-                                              &agg_buffer))
+                                              agg_buffer))
     {
         return make_ex10_sdk_error(Ex10ModuleRfPower,
                                    Ex10SdkErrorAggBufferOverflow);
     }
 
-    if (!agg_builder->append_set_regulatory_timers(timer_config, &agg_buffer))
+    if (!agg_builder->append_set_regulatory_timers(timer_config, agg_buffer))
     {
         return make_ex10_sdk_error(Ex10ModuleRfPower,
                                    Ex10SdkErrorAggBufferOverflow);
     }
 
-    if (!agg_builder->append_droop_compensation(droop_comp, &agg_buffer))
+    if (!agg_builder->append_droop_compensation(droop_comp, agg_buffer))
     {
         return make_ex10_sdk_error(Ex10ModuleRfPower,
                                    Ex10SdkErrorAggBufferOverflow);
@@ -393,22 +643,196 @@ static struct Ex10Result cw_on(
     if (timer_config->off_same_channel_ms)
     {
         if (!agg_builder->append_start_timer_op(
-                timer_config->off_same_channel_ms * 1000, &agg_buffer) ||
-            !agg_builder->append_wait_timer_op(&agg_buffer))
+                timer_config->off_same_channel_ms * 1000, agg_buffer) ||
+            !agg_builder->append_wait_timer_op(agg_buffer))
         {
             return make_ex10_sdk_error(Ex10ModuleRfPower,
                                        Ex10SdkErrorAggBufferOverflow);
         }
     }
 
-    if (!agg_builder->append_tx_ramp_up(power_config->dc_offset, &agg_buffer) ||
-        !agg_builder->append_power_control(power_config, &agg_buffer) ||
-        !agg_builder->append_run_sjc(&agg_buffer))
+    if (!agg_builder->append_tx_ramp_up(power_config->dc_offset, agg_buffer) ||
+        !agg_builder->append_power_control(power_config, agg_buffer) ||
+        !agg_builder->append_run_sjc(agg_buffer) ||
+        !agg_builder->append_exit_instruction(agg_buffer))
     {
         return make_ex10_sdk_error(Ex10ModuleRfPower,
                                    Ex10SdkErrorAggBufferOverflow);
     }
 
+    return make_ex10_success();
+}
+
+/**
+ * @return struct RampPlan* The plan from the last build_cw_configs() call,
+ *         if it was built with the same configuration as this cw_on() call.
+ */
+static struct RampPlan* match_ramp_plan(
+    struct GpioPinsSetClear const*           gpio_controls,
+    struct PowerConfigs const*               power_config,
+    struct RfSynthesizerControlFields const* synth_control)
+{
+    struct RampPlanCache* ramp_plan_cache = get_ramp_plan_cache_context();
+
+    struct RampPlan* plan = ramp_plan_cache->last_plan;
+    if (ramp_plan_cache->enabled == false || plan == NULL ||
+        plan->valid == false)
+    {
+        return NULL;
+    }
+
+    if (memcmp(&plan->cw_config.gpio, gpio_controls, sizeof(*gpio_controls)) ||
+        memcmp(&plan->cw_config.power, power_config, sizeof(*power_config)) ||
+        memcmp(&plan->cw_config.synth, synth_control, sizeof(*synth_control)))
+    {
+        return NULL;
+    }
+
+    return plan;
+}
+
+/**
+ * Build the CwOn aggregate op buffer, reusing the buffer of the matching
+ * ramp plan when there is one. @see Ex10RfPower.cw_on() for the parameters.
+ */
+static struct Ex10Result build_cw_on_agg_op(
+    struct GpioPinsSetClear const*             gpio_controls,
+    struct PowerConfigs const*                 power_config,
+    struct RfSynthesizerControlFields const*   synth_control,
+    struct Ex10RegulatoryTimers const*         timer_config,
+    struct PowerDroopCompensationFields const* droop_comp,
+    struct ByteSpan*                           agg_buffer)
+{
+    struct RampPlanCache* ramp_plan_cache = get_ramp_plan_cache_context();
+
+    struct RampPlan* plan =
+        match_ramp_plan(gpio_controls, power_config, synth_control);
+    if (plan != NULL && plan->agg_op_length != 0u &&
+        memcmp(&plan->timer, timer_config, sizeof(*timer_config)) == 0 &&
+        memcmp(&plan->droop_comp, droop_comp, sizeof(*droop_comp)) == 0)
+    {
+        ramp_plan_cache->stats.agg_op_hits += 1u;
+        memcpy(agg_buffer->data, plan->agg_op_data, plan->agg_op_length);
+        agg_buffer->length = plan->agg_op_length;
+        return make_ex10_success();
+    }
+
+    struct Ex10Result const ex10_result =
+        append_cw_on_instructions(gpio_controls,
+                                  power_config,
+                                  synth_control,
+                                  timer_config,
+                                  droop_comp,
+                                  agg_buffer);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    if (plan != NULL && agg_buffer->length <= RAMP_PLAN_AGG_OP_MAX_LENGTH)
+    {
+        ramp_plan_cache->stats.agg_op_misses += 1u;
+        plan->timer      = *timer_config;
+        plan->droop_comp = *droop_comp;
+        memcpy(plan->agg_op_data, agg_buffer->data, agg_buffer->length);
+        plan->agg_op_length = agg_buffer->length;
+    }
+
+    return make_ex10_success();
+}
+
+/**
+ * Consume the staged CwOn aggregate op.
+ *
+ * @return bool true if the staged aggregate op was built from the same
+ *         configuration as this cw_on() call, and is still in the device
+ *         aggregate op buffer.
+ */
+static bool take_staged_cw_on(
+    struct GpioPinsSetClear const*             gpio_controls,
+    struct PowerConfigs const*                 power_config,
+    struct RfSynthesizerControlFields const*   synth_control,
+    struct Ex10RegulatoryTimers const*         timer_config,
+    struct PowerDroopCompensationFields const* droop_comp)
+{
+    struct PipelinedRamp* pipelined_ramp = get_pipelined_ramp_context();
+
+    struct StagedCwOn* staged = &pipelined_ramp->staged;
+    if (pipelined_ramp->enabled == false || staged->valid == false)
+    {
+        return false;
+    }
+    staged->valid = false;
+
+    struct CwConfig const* cw_config = &staged->cw_config;
+    bool const             match =
+        (staged->buffer_generation ==
+         get_ex10_aggregate_op_builder()->get_buffer_generation()) &&
+        memcmp(&cw_config->gpio, gpio_controls, sizeof(*gpio_controls)) == 0 &&
+        memcmp(&cw_config->power, power_config, sizeof(*power_config)) == 0 &&
+        memcmp(&cw_config->synth, synth_control, sizeof(*synth_control)) == 0 &&
+        memcmp(&cw_config->timer, timer_config, sizeof(*timer_config)) == 0 &&
+        memcmp(&staged->droop_comp, droop_comp, sizeof(*droop_comp)) == 0;
+
+    if (match)
+    {
+        pipelined_ramp->stats.staged_hits += 1u;
+    }
+    else
+    {
+        pipelined_ramp->stats.staged_misses += 1u;
+    }
+    return match;
+}
+
+static struct Ex10Result cw_on(
+    struct GpioPinsSetClear const*             gpio_controls,
+    struct PowerConfigs*                       power_config,
+    struct RfSynthesizerControlFields const*   synth_control,
+    struct Ex10RegulatoryTimers const*         timer_config,
+    struct PowerDroopCompensationFields const* droop_comp)
+{
+    // Prevent redundant CW on
+    if (get_cw_is_on())
+    {
+        // CW is already on, early return
+        return make_ex10_success();
+    }
+
+    uint64_t const start_ns = get_ex10_time_helpers()->time_now_ns();
+
+    uint8_t agg_data[AGGREGATE_OP_BUFFER_REG_LENGTH];
+    struct ByteSpan agg_buffer = {.data = agg_data, .length = 0};
+    struct Ex10AggregateOpBuilder const* agg_builder =
+        get_ex10_aggregate_op_builder();
+
+    tracepoint(pi_ex10sdk,
+               OPS_cw_on,
+               gpio_controls,
+               power_config,
+               synth_control,
+               timer_config);
+
+    // When the aggregate op was staged during the previous dwell, only the
+    // AggregateOp needs to be started.
+    bool const staged = take_staged_cw_on(
+        gpio_controls, power_config, synth_control, timer_config, droop_comp);
+    if (staged == false)
+    {
+        ex10_memzero(agg_data, sizeof(agg_data));
+        struct Ex10Result const ex10_result =
+            build_cw_on_agg_op(gpio_controls,
+                               power_config,
+                               synth_control,
+                               timer_config,
+                               droop_comp,
+                               &agg_buffer);
+        if (ex10_result.error)
+        {
+            return ex10_result;
+        }
+    }
+
     struct Ex10RampModuleManager const* ramp_module_manager =
         get_ex10_ramp_module_manager();
 
@@ -423,9 +847,10 @@ static struct Ex10Result cw_on(
         return ex10_result;
     }
 
-    // Add the exit instruction and set the buffer
-    agg_builder->append_exit_instruction(&agg_buffer);
-    agg_builder->set_buffer(&agg_buffer);
+    if (staged == false)
+    {
+        agg_builder->set_buffer(&agg_buffer);
+    }
 
     // Run the aggregate op and wait for completion
     struct Ex10Ops const* ops = get_ex10_ops();
@@ -440,6 +865,8 @@ static struct Ex10Result cw_on(
     {
         return ex10_result;
     }
+    get_ex10_perf_counters()->record_cw_on(
+        get_ex10_time_helpers()->time_now_ns() - start_ns, staged);
 
     // Updating to the next channel for the next CwOn
     get_ex10_active_region()->update_active_channel();
@@ -457,6 +884,84 @@ static struct Ex10Result cw_on(
     return make_ex10_success();
 }
 
+static struct Ex10Result stage_next_cw_on(
+    uint8_t                                    antenna,
+    enum RfModes                               rf_mode,
+    int16_t                                    tx_power_cdbm,
+    uint16_t                                   temperature_adc,
+    bool                                       temp_comp_enabled,
+    struct PowerDroopCompensationFields const* droop_comp)
+{
+    struct PipelinedRamp* pipelined_ramp = get_pipelined_ramp_context();
+
+    struct StagedCwOn* staged = &pipelined_ramp->staged;
+    staged->valid             = false;
+    if (pipelined_ramp->enabled == false)
+    {
+        return make_ex10_success();
+    }
+
+    struct Ex10Result ex10_result = build_cw_configs(antenna,
+                                                     rf_mode,
+                                                     tx_power_cdbm,
+                                                     temperature_adc,
+                                                     temp_comp_enabled,
+                                                     &staged->cw_config);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    uint8_t agg_data[AGGREGATE_OP_BUFFER_REG_LENGTH];
+    ex10_memzero(agg_data, sizeof(agg_data));
+    struct ByteSpan agg_buffer = {.data = agg_data, .length = 0};
+
+    ex10_result = build_cw_on_agg_op(&staged->cw_config.gpio,
+                                     &staged->cw_config.power,
+                                     &staged->cw_config.synth,
+                                     &staged->cw_config.timer,
+                                     droop_comp,
+                                     &agg_buffer);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    struct Ex10AggregateOpBuilder const* agg_builder =
+        get_ex10_aggregate_op_builder();
+    if (agg_builder->set_buffer(&agg_buffer) == false)
+    {
+        return make_ex10_sdk_error(Ex10ModuleRfPower,
+                                   Ex10SdkErrorAggBufferOverflow);
+    }
+
+    staged->droop_comp        = *droop_comp;
+    staged->buffer_generation = agg_builder->get_buffer_generation();
+    staged->valid             = true;
+    pipelined_ramp->stats.staged_count += 1u;
+
+    return make_ex10_success();
+}
+
+static void enable_pipelined_ramp(bool enable)
+{
+    struct PipelinedRamp* pipelined_ramp = get_pipelined_ramp_context();
+
+    pipelined_ramp->enabled      = enable;
+    pipelined_ramp->staged.valid = false;
+}
+
+static void get_pipelined_ramp_stats(struct Ex10PipelinedRampStats* stats)
+{
+    struct PipelinedRamp* pipelined_ramp = get_pipelined_ramp_context();
+
+    if (stats != NULL)
+    {
+        *stats         = pipelined_ramp->stats;
+        stats->enabled = pipelined_ramp->enabled;
+    }
+}
+
 static struct PowerDroopCompensationFields get_droop_compensation_defaults(void)
 {
     return droop_comp_defaults;
@@ -531,6 +1036,13 @@ static const struct Ex10RfPower ex10_rf_power = {
     .set_analog_rx_config             = set_analog_rx_config,
     .enable_droop_compensation        = enable_droop_compensation,
     .disable_droop_compensation       = disable_droop_compensation,
+    .enable_ramp_plan_cache           = enable_ramp_plan_cache,
+    .disable_ramp_plan_cache          = disable_ramp_plan_cache,
+    .invalidate_ramp_plan_cache       = invalidate_ramp_plan_cache,
+    .get_ramp_plan_cache_stats        = get_ramp_plan_cache_stats,
+    .enable_pipelined_ramp            = enable_pipelined_ramp,
+    .stage_next_cw_on                 = stage_next_cw_on,
+    .get_pipelined_ramp_stats         = get_pipelined_ramp_stats,
 };
 
 const struct Ex10RfPower* get_ex10_rf_power(void)
@@ -0,0 +1,274 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include "calibration.h"
+#include "ex10_api/event_fifo_packet_types.h"
+#include "ex10_api/event_packet_parser.h"
+#include "ex10_api/ex10_clock_correlation.h"
+#include "ex10_api/ex10_event_fifo_queue.h"
+#include "ex10_api/ex10_tag_read_export.h"
+#include "ex10_api/ex10_utils.h"
+
+/**
+ * @struct RssiRun
+ * Consecutive exported tag reads received with the same RxGainControl
+ * settings, whose RSSI is compensated with one plan.
+ */
+struct RssiRun
+{
+    struct Ex10RssiCompensationPlan plan;
+    bool                            plan_built;
+    uint16_t                        rx_gain_settings;
+    size_t                          first_row;
+};
+
+static bool packet_stops_export(struct EventFifoPacket const*         packet,
+                                struct Ex10TagReadExportConfig const* config)
+{
+    if (packet->is_valid == false)
+    {
+        return true;
+    }
+    switch (packet->packet_type)
+    {
+        case TagRead:
+            return false;
+        case ContinuousInventorySummary:
+        case Halted:
+        case Ex10ResultPacket:
+            return true;
+        default:
+            return config->stop_at_other_packets;
+    }
+}
+
+/**
+ * Copy a variable length field into a zero padded row.
+ *
+ * @return uint8_t The number of bytes copied.
+ */
+static uint8_t copy_row(uint8_t*       row,
+                        size_t         stride,
+                        uint8_t const* field,
+                        size_t         field_length)
+{
+    size_t length = 0u;
+    if (field != NULL)
+    {
+        length = (field_length < stride) ? field_length : stride;
+        memcpy(row, field, length);
+    }
+    memset(&row[length], 0, stride - length);
+    return (uint8_t)length;
+}
+
+/**
+ * Compensate the raw RSSI values of the rows of the current run.
+ */
+static void compensate_run(struct RssiRun const*           run,
+                           struct Ex10TagReadArrays const* arrays,
+                           size_t                          end_row)
+{
+    if (run->plan_built && (arrays->rssi_cdbm != NULL) &&
+        (end_row > run->first_row))
+    {
+        get_ex10_calibration()->compensate_rssi_batch(
+            &run->plan,
+            &arrays->rssi_raw[run->first_row],
+            &arrays->rssi_cdbm[run->first_row],
+            end_row - run->first_row);
+    }
+}
+
+/**
+ * Start a new RSSI run if the RxGainControl settings of the tag read differ
+ * from those of the current run.
+ */
+static void update_run(struct RssiRun*                       run,
+                       struct Ex10TagReadExportConfig const* config,
+                       struct Ex10TagReadArrays const*       arrays,
+                       struct TagRead const*                 tag_read,
+                       size_t                                row)
+{
+    if (run->plan_built && run->rx_gain_settings == tag_read->rx_gain_settings)
+    {
+        return;
+    }
+
+    compensate_run(run, arrays, row);
+    get_ex10_calibration()->build_rssi_compensation_plan(
+        config->rf_mode,
+        (const struct RxGainControlFields*)&tag_read->rx_gain_settings,
+        config->antenna,
+        config->rf_filter,
+        config->temp_adc,
+        &run->plan);
+    run->plan_built       = true;
+    run->rx_gain_settings = tag_read->rx_gain_settings;
+    run->first_row        = row;
+}
+
+static void export_row(struct EventFifoPacket const*         packet,
+                       struct TagReadFields const*           fields,
+                       struct Ex10TagReadExportConfig const* config,
+                       struct Ex10TagReadArrays const*       arrays,
+                       size_t                                row)
+{
+    struct TagRead const* tag_read = &packet->static_data->tag_read;
+
+    if (arrays->pc != NULL)
+    {
+        arrays->pc[row] = ex10_bytes_to_uint16(fields->pc);
+    }
+    if (arrays->epc != NULL)
+    {
+        uint8_t const length = copy_row(&arrays->epc[row * arrays->epc_stride],
+                                        arrays->epc_stride,
+                                        fields->epc,
+                                        fields->epc_length);
+        if (arrays->epc_length != NULL)
+        {
+            arrays->epc_length[row] = length;
+        }
+    }
+    if (arrays->tid != NULL)
+    {
+        uint8_t const length = copy_row(&arrays->tid[row * arrays->tid_stride],
+                                        arrays->tid_stride,
+                                        fields->tid,
+                                        fields->tid_length);
+        if (arrays->tid_length != NULL)
+        {
+            arrays->tid_length[row] = length;
+        }
+    }
+    if (arrays->rssi_raw != NULL)
+    {
+        arrays->rssi_raw[row] = tag_read->rssi;
+    }
+    if (arrays->phase_begin != NULL)
+    {
+        arrays->phase_begin[row] = tag_read->rf_phase_begin;
+    }
+    if (arrays->phase_end != NULL)
+    {
+        arrays->phase_end[row] = tag_read->rf_phase_end;
+    }
+    if (arrays->antenna != NULL)
+    {
+        arrays->antenna[row] = config->antenna;
+    }
+    if (arrays->timestamp_us != NULL)
+    {
+        arrays->timestamp_us[row] = packet->us_counter;
+    }
+    if (arrays->host_time_ns != NULL)
+    {
+        arrays->host_time_ns[row] =
+            get_ex10_clock_correlation()->packet_host_time_ns(packet);
+    }
+}
+
+static struct Ex10Result export_tag_reads(
+    struct Ex10TagReadExportConfig const* config,
+    struct Ex10TagReadArrays const*       arrays,
+    struct Ex10TagReadExportCounts*       counts)
+{
+    if (config == NULL || arrays == NULL || counts == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUtils, Ex10SdkErrorNullPointer);
+    }
+    // The compensated RSSI is computed from the raw RSSI array, and the
+    // variable length fields require a row size.
+    if ((arrays->rssi_cdbm != NULL && arrays->rssi_raw == NULL) ||
+        (arrays->epc != NULL && arrays->epc_stride == 0u) ||
+        (arrays->tid != NULL && arrays->tid_stride == 0u) ||
+        (arrays->epc_length != NULL && arrays->epc == NULL) ||
+        (arrays->tid_length != NULL && arrays->tid == NULL))
+    {
+        return make_ex10_sdk_error(Ex10ModuleUtils, Ex10SdkErrorBadParamValue);
+    }
+
+    counts->tag_read_count       = 0u;
+    counts->skipped_packet_count = 0u;
+
+    struct Ex10EventFifoQueue const* queue  = get_ex10_event_fifo_queue();
+    struct Ex10EventParser const*    parser = get_ex10_event_parser();
+
+    struct EventFifoPacket const* packet = queue->packet_peek();
+    if (packet == NULL && config->wait_timeout_us > 0u)
+    {
+        bool const timed_out =
+            queue->packet_wait_with_timeout(config->wait_timeout_us);
+        if (timed_out == false)
+        {
+            packet = queue->packet_peek();
+        }
+    }
+
+    struct RssiRun run = {.plan_built = false, .first_row = 0u};
+
+    size_t row = 0u;
+    while (packet != NULL && row < arrays->capacity)
+    {
+        if (packet_stops_export(packet, config))
+        {
+            break;
+        }
+        if (packet->packet_type != TagRead)
+        {
+            counts->skipped_packet_count += 1u;
+            queue->packet_remove();
+            packet = queue->packet_peek();
+            continue;
+        }
+
+        struct TagRead const*      tag_read = &packet->static_data->tag_read;
+        struct TagReadFields const fields =
+            parser->get_tag_read_fields(packet->dynamic_data,
+                                        packet->dynamic_data_length,
+                                        (enum TagReadType)tag_read->type,
+                                        tag_read->tid_offset);
+        if (fields.epc == NULL)
+        {
+            counts->skipped_packet_count += 1u;
+        }
+        else
+        {
+            if (arrays->rssi_cdbm != NULL)
+            {
+                update_run(&run, config, arrays, tag_read, row);
+            }
+            export_row(packet, &fields, config, arrays, row);
+            row += 1u;
+        }
+
+        queue->packet_remove();
+        packet = queue->packet_peek();
+    }
+
+    compensate_run(&run, arrays, row);
+    counts->tag_read_count = row;
+    return make_ex10_success();
+}
+
+static struct Ex10TagReadExport const ex10_tag_read_export = {
+    .export_tag_reads = export_tag_reads,
+};
+
+struct Ex10TagReadExport const* get_ex10_tag_read_export(void)
+{
+    return &ex10_tag_read_export;
+}
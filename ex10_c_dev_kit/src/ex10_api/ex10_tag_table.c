@@ -0,0 +1,362 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2023 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include "board/ex10_osal.h"
+#include "ex10_api/event_packet_parser.h"
+#include "ex10_api/ex10_context.h"
+#include "ex10_api/ex10_tag_table.h"
+
+/**
+ * @struct TagTable
+ * The tag table state. The entries are an open addressing hash table with
+ * linear probing; removed entries are back filled so that no tombstones are
+ * needed and a lookup ends at the first unused entry.
+ */
+struct TagTable
+{
+    struct Ex10TagTableEntry* entries;
+    size_t                    capacity;
+    uint32_t                  aging_timeout_us;
+    struct Ex10TagTableStats  stats;
+
+    void (*event_callback)(enum Ex10TagTableEvent          event,
+                           struct Ex10TagTableEntry const* entry);
+};
+
+static struct TagTable tag_table_contexts[EX10_MAX_CONTEXTS];
+
+static struct TagTable* get_tag_table_context(void)
+{
+    return &tag_table_contexts[ex10_context_index()];
+}
+
+/// FNV-1a, continuing from the hash of the preceding bytes.
+static uint32_t hash_bytes(uint32_t hash, uint8_t const* bytes, size_t length)
+{
+    for (size_t index = 0u; index < length; ++index)
+    {
+        hash ^= bytes[index];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t hash_tag(uint8_t const* epc,
+                         size_t         epc_length,
+                         uint8_t const* tid,
+                         size_t         tid_length)
+{
+    uint32_t hash = hash_bytes(2166136261u, epc, epc_length);
+    return hash_bytes(hash, tid, tid_length);
+}
+
+static bool entry_matches(struct Ex10TagTableEntry const* entry,
+                          uint32_t                        hash,
+                          uint8_t const*                  epc,
+                          size_t                          epc_length,
+                          uint8_t const*                  tid,
+                          size_t                          tid_length)
+{
+    return entry->hash == hash && entry->epc_length == epc_length &&
+           entry->tid_length == tid_length &&
+           memcmp(entry->epc, epc, epc_length) == 0 &&
+           (tid_length == 0u || memcmp(entry->tid, tid, tid_length) == 0);
+}
+
+/**
+ * Find the index of the entry of a tag, or of the unused entry where it
+ * would be inserted.
+ *
+ * @return size_t The index of the matching or unused entry, or the table
+ *                capacity if the tag is not in a full table.
+ */
+static size_t probe(uint32_t       hash,
+                    uint8_t const* epc,
+                    size_t         epc_length,
+                    uint8_t const* tid,
+                    size_t         tid_length)
+{
+    struct TagTable* tag_table = get_tag_table_context();
+
+    size_t index = hash % tag_table->capacity;
+    for (size_t count = 0u; count < tag_table->capacity; ++count)
+    {
+        struct Ex10TagTableEntry const* entry = &tag_table->entries[index];
+        if (entry->in_use == false ||
+            entry_matches(entry, hash, epc, epc_length, tid, tid_length))
+        {
+            return index;
+        }
+        index = (index + 1u == tag_table->capacity) ? 0u : index + 1u;
+    }
+    return tag_table->capacity;
+}
+
+/**
+ * Remove the entry at the index, moving the entries which follow it back
+ * towards their home index so that their probe sequences remain unbroken.
+ */
+static void remove_entry(size_t index)
+{
+    struct TagTable* tag_table = get_tag_table_context();
+
+    size_t hole = index;
+    size_t next = index;
+    for (size_t count = 1u; count < tag_table->capacity; ++count)
+    {
+        next = (next + 1u == tag_table->capacity) ? 0u : next + 1u;
+        struct Ex10TagTableEntry const* entry = &tag_table->entries[next];
+        if (entry->in_use == false)
+        {
+            break;
+        }
+
+        // The entry may move into the hole unless its home index lies
+        // cyclically within (hole, next], where the hole would break the
+        // probe sequence from home to the entry.
+        size_t const home = entry->hash % tag_table->capacity;
+        bool const   home_after_hole =
+            (hole <= next) ? (home > hole && home <= next)
+                           : (home > hole || home <= next);
+        if (home_after_hole == false)
+        {
+            tag_table->entries[hole] = *entry;
+            hole                     = next;
+        }
+    }
+    tag_table->entries[hole].in_use = false;
+    tag_table->stats.tag_count -= 1u;
+}
+
+static struct Ex10Result init(struct Ex10TagTableEntry* entries,
+                              size_t                    capacity,
+                              uint32_t                  aging_timeout_us)
+{
+    struct TagTable* tag_table = get_tag_table_context();
+
+    if (entries == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUtils, Ex10SdkErrorNullPointer);
+    }
+    if (capacity < 2u)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUtils, Ex10SdkErrorBadParamValue);
+    }
+
+    ex10_memzero(entries, capacity * sizeof(*entries));
+    ex10_memzero(&tag_table->stats, sizeof(tag_table->stats));
+    tag_table->entries          = entries;
+    tag_table->capacity         = capacity;
+    tag_table->aging_timeout_us = aging_timeout_us;
+    tag_table->stats.capacity   = capacity;
+
+    return make_ex10_success();
+}
+
+static void register_event_callback(
+    void (*callback)(enum Ex10TagTableEvent          event,
+                     struct Ex10TagTableEntry const* entry))
+{
+    struct TagTable* tag_table = get_tag_table_context();
+
+    tag_table->event_callback = callback;
+}
+
+static enum Ex10TagTableUpdate update(
+    struct EventFifoPacket const*    packet,
+    uint8_t                          antenna,
+    int16_t                          rssi_cdbm,
+    struct Ex10TagTableEntry const** entry)
+{
+    struct TagTable* tag_table = get_tag_table_context();
+
+    if (entry != NULL)
+    {
+        *entry = NULL;
+    }
+    if (tag_table->entries == NULL || packet == NULL ||
+        packet->packet_type != TagRead)
+    {
+        return TagTableUpdateInvalid;
+    }
+
+    struct TagRead const*      tag_read = &packet->static_data->tag_read;
+    struct TagReadFields const fields =
+        get_ex10_event_parser()->get_tag_read_fields(
+            packet->dynamic_data,
+            packet->dynamic_data_length,
+            (enum TagReadType)tag_read->type,
+            tag_read->tid_offset);
+    if (fields.epc == NULL || fields.epc_length > EPC_BUFFER_BYTE_LENGTH ||
+        fields.tid_length > TID_LENGTH_BYTES)
+    {
+        return TagTableUpdateInvalid;
+    }
+
+    uint32_t const hash = hash_tag(
+        fields.epc, fields.epc_length, fields.tid, fields.tid_length);
+    size_t const index = probe(
+        hash, fields.epc, fields.epc_length, fields.tid, fields.tid_length);
+
+    // Leave one entry unused so that lookups of absent tags terminate.
+    if (index == tag_table->capacity ||
+        (tag_table->entries[index].in_use == false &&
+         tag_table->stats.tag_count + 1u >= tag_table->capacity))
+    {
+        tag_table->stats.dropped_reads += 1u;
+        return TagTableUpdateDropped;
+    }
+
+    struct Ex10TagTableEntry* tag_entry = &tag_table->entries[index];
+    enum Ex10TagTableUpdate   result    = TagTableUpdateDuplicate;
+    if (tag_entry->in_use == false)
+    {
+        tag_entry->in_use     = true;
+        tag_entry->hash       = hash;
+        tag_entry->epc_length = fields.epc_length;
+        tag_entry->tid_length = fields.tid_length;
+        memcpy(tag_entry->epc, fields.epc, fields.epc_length);
+        if (fields.tid_length > 0u)
+        {
+            memcpy(tag_entry->tid, fields.tid, fields.tid_length);
+        }
+        tag_entry->first_seen_us  = packet->us_counter;
+        tag_entry->read_count     = 0u;
+        tag_entry->peak_rssi_cdbm = rssi_cdbm;
+        tag_entry->rssi_cdbm_sum  = 0;
+
+        tag_table->stats.tag_count += 1u;
+        tag_table->stats.new_tags += 1u;
+        result = TagTableUpdateNewTag;
+    }
+    else
+    {
+        tag_table->stats.duplicate_reads += 1u;
+    }
+
+    tag_entry->last_seen_us = packet->us_counter;
+    tag_entry->read_count += 1u;
+    tag_entry->rssi_cdbm_sum += rssi_cdbm;
+    if (rssi_cdbm > tag_entry->peak_rssi_cdbm)
+    {
+        tag_entry->peak_rssi_cdbm = rssi_cdbm;
+    }
+    tag_entry->antenna        = antenna;
+    tag_entry->rf_phase_begin = tag_read->rf_phase_begin;
+    tag_entry->rf_phase_end   = tag_read->rf_phase_end;
+
+    if (result == TagTableUpdateNewTag && tag_table->event_callback != NULL)
+    {
+        tag_table->event_callback(TagTableEventNewTag, tag_entry);
+    }
+    if (entry != NULL)
+    {
+        *entry = tag_entry;
+    }
+    return result;
+}
+
+static size_t age(uint32_t now_us)
+{
+    struct TagTable* tag_table = get_tag_table_context();
+
+    if (tag_table->entries == NULL || tag_table->aging_timeout_us == 0u)
+    {
+        return 0u;
+    }
+
+    size_t lost_count = 0u;
+    size_t index      = 0u;
+    while (index < tag_table->capacity)
+    {
+        struct Ex10TagTableEntry const* entry = &tag_table->entries[index];
+        // The unsigned subtraction handles the us_counter wrapping.
+        if (entry->in_use &&
+            now_us - entry->last_seen_us > tag_table->aging_timeout_us)
+        {
+            if (tag_table->event_callback != NULL)
+            {
+                tag_table->event_callback(TagTableEventTagLost, entry);
+            }
+            // An entry following this one may be moved into this index;
+            // it is checked before moving on.
+            remove_entry(index);
+            tag_table->stats.lost_tags += 1u;
+            lost_count += 1u;
+        }
+        else
+        {
+            index += 1u;
+        }
+    }
+    return lost_count;
+}
+
+static struct Ex10TagTableEntry const* find(uint8_t const* epc,
+                                            size_t         epc_length,
+                                            uint8_t const* tid,
+                                            size_t         tid_length)
+{
+    struct TagTable* tag_table = get_tag_table_context();
+
+    if (tag_table->entries == NULL || epc == NULL ||
+        (tid == NULL && tid_length > 0u))
+    {
+        return NULL;
+    }
+
+    uint32_t const hash  = hash_tag(epc, epc_length, tid, tid_length);
+    size_t const   index = probe(hash, epc, epc_length, tid, tid_length);
+    if (index == tag_table->capacity ||
+        tag_table->entries[index].in_use == false)
+    {
+        return NULL;
+    }
+    return &tag_table->entries[index];
+}
+
+static void clear(void)
+{
+    struct TagTable* tag_table = get_tag_table_context();
+
+    if (tag_table->entries != NULL)
+    {
+        ex10_memzero(tag_table->entries,
+                     tag_table->capacity * sizeof(*tag_table->entries));
+    }
+    tag_table->stats.tag_count = 0u;
+}
+
+static void get_stats(struct Ex10TagTableStats* stats)
+{
+    struct TagTable* tag_table = get_tag_table_context();
+
+    *stats = tag_table->stats;
+}
+
+static struct Ex10TagTable const ex10_tag_table = {
+    .init                    = init,
+    .register_event_callback = register_event_callback,
+    .update                  = update,
+    .age                     = age,
+    .find                    = find,
+    .clear                   = clear,
+    .get_stats               = get_stats,
+};
+
+struct Ex10TagTable const* get_ex10_tag_table(void)
+{
+    return &ex10_tag_table;
+}
@@ -11,51 +11,204 @@
  *                                                                           *
  *****************************************************************************/
 
-#include "board/ex10_osal.h"
+
 #include "board/fifo_buffer_pool.h"
 
 #include "ex10_api/event_fifo_packet_types.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/fifo_buffer_list.h"
-#include "ex10_api/linked_list.h"
-
-// The list of FifoBufferNodes for use in reading the Ex10 Event Fifo
-// using the ReadFifo command.
-static struct Ex10LinkedList event_fifo_free_list;
-
-// The list of FifoBufferNodes for use for error reporting in interrupt
-static struct Ex10LinkedList result_free_list;
+#include "ex10_api/lock_free_ring.h"
+
+/**
+ * @struct FreeList
+ * A free list of FifoBufferNodes and its usage counters.
+ * Nodes are taken by the IRQ_N monitor thread and released by the
+ * application thread; the lock-free ring keeps either side from blocking
+ * on the other.
+ */
+struct FreeList
+{
+    struct Ex10RingCell     cells[FIFO_BUFFER_LIST_CAPACITY];
+    struct Ex10LockFreeRing ring;
+    size_t                  buffer_count;
+    size_t                  in_use;
+    size_t                  high_water_mark;
+    size_t                  exhaustion_count;
+};
 
+// The free lists of FifoBufferNodes for use in reading the Ex10 Event Fifo
+// using the ReadFifo command; one per Ex10 context.
+static struct FreeList event_fifo_free_lists[EX10_MAX_CONTEXTS];
 
-static ex10_mutex_t list_mutex = EX10_MUTEX_INITIALIZER;
+// The lists of FifoBufferNodes for use for error reporting in interrupt
+static struct FreeList result_free_lists[EX10_MAX_CONTEXTS];
 
+static struct FreeList* get_event_fifo_free_list(void)
+{
+    return &event_fifo_free_lists[ex10_context_index()];
+}
 
-static bool event_fifo_free_list_put(
-    struct FifoBufferNode* event_fifo_buffer_node)
+static struct FreeList* get_result_free_list(void)
 {
-    ex10_mutex_lock(&list_mutex);
-    bool const is_empty = list_is_empty(&event_fifo_free_list);
+    return &result_free_lists[ex10_context_index()];
+}
 
+/**
+ * Push a FifoBufferNode onto a free list ring.
+ *
+ * @return bool true if the node is at the front of the free list after the
+ *              push; i.e. the free list was empty, or was emptied by the
+ *              consumer while the push was in progress. In both cases the
+ *              consumer may have found the free list empty.
+ */
+static bool free_list_push(struct FreeList*       free_list,
+                           struct FifoBufferNode* fifo_buffer_node)
+{
     // It is not necessary that fifo_data.length be set to zero,
     // but it provides a sanity check w.r.t the state of the buffer.
-    event_fifo_buffer_node->fifo_data.length = 0u;
-    list_push_back(&event_fifo_free_list, &event_fifo_buffer_node->list_node);
+    fifo_buffer_node->fifo_data.length = 0u;
+    fifo_buffer_node->packet_indexed   = false;
 
-    ex10_mutex_unlock(&list_mutex);
-    return is_empty;
+    size_t position = 0u;
+    if (ring_push(&free_list->ring, fifo_buffer_node, &position) == false)
+    {
+        // The ring is sized to hold every node; this is not expected.
+        return false;
+    }
+    return ring_head(&free_list->ring) == position;
 }
 
-static struct Ex10Result event_fifo_free_list_init(
-    struct FifoBufferNode* fifo_buffer_nodes,
-    struct ByteSpan const* byte_spans,
-    size_t                 buffer_count)
+static bool free_list_put(struct FreeList*       free_list,
+                          struct FifoBufferNode* fifo_buffer_node)
+{
+    __atomic_sub_fetch(&free_list->in_use, 1u, __ATOMIC_RELAXED);
+    return free_list_push(free_list, fifo_buffer_node);
+}
+
+static struct FifoBufferNode* free_list_get(struct FreeList* free_list)
+{
+    struct FifoBufferNode* fifo_buffer_node =
+        (struct FifoBufferNode*)ring_pop(&free_list->ring);
+    if (fifo_buffer_node == NULL)
+    {
+        __atomic_add_fetch(&free_list->exhaustion_count, 1u, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    size_t const in_use =
+        __atomic_add_fetch(&free_list->in_use, 1u, __ATOMIC_RELAXED);
+    size_t high_water_mark =
+        __atomic_load_n(&free_list->high_water_mark, __ATOMIC_RELAXED);
+    while ((in_use > high_water_mark) &&
+           (__atomic_compare_exchange_n(&free_list->high_water_mark,
+                                        &high_water_mark,
+                                        in_use,
+                                        true,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED) == false))
+    {
+        // high_water_mark was updated by the failed exchange; retry.
+    }
+    return fifo_buffer_node;
+}
+
+/**
+ * Initialize the free list ring and counters, validating the buffer_count.
+ */
+static struct Ex10Result free_list_init(
+    struct FreeList*         free_list,
+    struct FifoBufferNode*   fifo_buffer_nodes,
+    struct ByteSpan const*   byte_spans,
+    struct EventPacketIndex* packet_indexes,
+    size_t                   buffer_count)
 {
-    if ((byte_spans == NULL) || (fifo_buffer_nodes == NULL))
+    if ((byte_spans == NULL) || (fifo_buffer_nodes == NULL) ||
+        (packet_indexes == NULL))
     {
         return make_ex10_sdk_error(Ex10ModuleFifoBufferList,
                                    Ex10SdkErrorNullPointer);
     }
 
-    list_init(&event_fifo_free_list);
+    if ((buffer_count > FIFO_BUFFER_LIST_CAPACITY) ||
+        (ring_init(&free_list->ring,
+                   free_list->cells,
+                   FIFO_BUFFER_LIST_CAPACITY) == false))
+    {
+        return make_ex10_sdk_error(Ex10ModuleFifoBufferList,
+                                   Ex10SdkErrorBadParamLength);
+    }
+
+    free_list->buffer_count = 0u;
+    __atomic_store_n(&free_list->in_use, 0u, __ATOMIC_RELAXED);
+    __atomic_store_n(&free_list->high_water_mark, 0u, __ATOMIC_RELAXED);
+    __atomic_store_n(&free_list->exhaustion_count, 0u, __ATOMIC_RELAXED);
+
+    return make_ex10_success();
+}
+
+static void free_list_add_node(struct FreeList*         free_list,
+                               struct FifoBufferNode*   fifo_buffer_node,
+                               uint8_t*                 data,
+                               size_t                   length,
+                               struct EventPacketIndex* packet_index)
+{
+    fifo_buffer_node->raw_buffer.data   = data;
+    fifo_buffer_node->raw_buffer.length = length;
+
+    fifo_buffer_node->fifo_data.data   = data;
+    fifo_buffer_node->fifo_data.length = 0u;
+
+    fifo_buffer_node->packet_index = packet_index;
+
+    get_ex10_list_node_helper()->init(&fifo_buffer_node->list_node);
+    fifo_buffer_node->list_node.data = fifo_buffer_node;
+
+    free_list->buffer_count += 1u;
+    free_list_push(free_list, fifo_buffer_node);
+}
+
+static void free_list_get_stats(struct FreeList const*     free_list,
+                                struct FifoBufferListStats* stats)
+{
+    stats->buffer_count = free_list->buffer_count;
+    stats->in_use = __atomic_load_n(&free_list->in_use, __ATOMIC_RELAXED);
+    stats->high_water_mark =
+        __atomic_load_n(&free_list->high_water_mark, __ATOMIC_RELAXED);
+    stats->exhaustion_count =
+        __atomic_load_n(&free_list->exhaustion_count, __ATOMIC_RELAXED);
+}
+
+static void free_list_reset_stats(struct FreeList* free_list)
+{
+    size_t const in_use =
+        __atomic_load_n(&free_list->in_use, __ATOMIC_RELAXED);
+    __atomic_store_n(&free_list->high_water_mark, in_use, __ATOMIC_RELAXED);
+    __atomic_store_n(&free_list->exhaustion_count, 0u, __ATOMIC_RELAXED);
+}
+
+static bool event_fifo_free_list_put(
+    struct FifoBufferNode* event_fifo_buffer_node)
+{
+    return free_list_put(get_event_fifo_free_list(), event_fifo_buffer_node);
+}
+
+static struct Ex10Result event_fifo_free_list_init(
+    struct FifoBufferNode*   fifo_buffer_nodes,
+    struct ByteSpan const*   byte_spans,
+    struct EventPacketIndex* packet_indexes,
+    size_t                   buffer_count)
+{
+    struct FreeList* free_list = get_event_fifo_free_list();
+
+    struct Ex10Result const ex10_result = free_list_init(free_list,
+                                                         fifo_buffer_nodes,
+                                                         byte_spans,
+                                                         packet_indexes,
+                                                         buffer_count);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
 
     for (size_t index = 0u; index < buffer_count; ++index)
     {
@@ -66,14 +219,14 @@ static struct Ex10Result event_fifo_free_list_init(
         }
 
         // The location into the buffer to start reading data. This will keep
-        // the fifo packets 32-bit aligned with respect to the start point and
-        // allow space for the response code byte to be prepended to the stream
-        // of fifo packets.
+        // the fifo packets 32-bit aligned with respect to the start point.
+        // The ReadFifo response code is received separately, so no space is
+        // reserved in front of the fifo packets.
         uintptr_t const data_address = (uintptr_t)byte_spans[index].data;
         size_t const    data_length  = byte_spans[index].length;
 
         size_t const align  = sizeof(uint32_t);
-        size_t const offset = align - data_address % align;
+        size_t const offset = (align - data_address % align) % align;
         size_t const length = ((data_length - offset) / align) * align;
         uint8_t*     data   = &byte_spans[index].data[offset];
 
@@ -83,15 +236,11 @@ static struct Ex10Result event_fifo_free_list_init(
                                        Ex10SdkErrorBadParamLength);
         }
 
-        fifo_buffer_nodes[index].raw_buffer.data   = data;
-        fifo_buffer_nodes[index].raw_buffer.length = length;
-
-        fifo_buffer_nodes[index].fifo_data.data   = data;
-        fifo_buffer_nodes[index].fifo_data.length = 0u;
-
-        get_ex10_list_node_helper()->init(&fifo_buffer_nodes[index].list_node);
-        fifo_buffer_nodes[index].list_node.data = &fifo_buffer_nodes[index];
-        event_fifo_free_list_put(&fifo_buffer_nodes[index]);
+        free_list_add_node(free_list,
+                           &fifo_buffer_nodes[index],
+                           data,
+                           length,
+                           &packet_indexes[index]);
     }
 
     return make_ex10_success();
@@ -99,26 +248,22 @@ static struct Ex10Result event_fifo_free_list_init(
 
 static struct FifoBufferNode* event_fifo_free_list_get(void)
 {
-    ex10_mutex_lock(&list_mutex);
+    return free_list_get(get_event_fifo_free_list());
+}
 
-    struct FifoBufferNode* fifo_buffer = NULL;
-    struct Ex10ListNode*   list_node   = list_front(&event_fifo_free_list);
-    if (list_node->data)
-    {
-        list_pop_front(&event_fifo_free_list);
-        fifo_buffer = (struct FifoBufferNode*)list_node->data;
-    }
+static size_t event_fifo_free_list_size(void)
+{
+    return ring_size(&get_event_fifo_free_list()->ring);
+}
 
-    ex10_mutex_unlock(&list_mutex);
-    return fifo_buffer;
+static void event_fifo_free_list_get_stats(struct FifoBufferListStats* stats)
+{
+    free_list_get_stats(get_event_fifo_free_list(), stats);
 }
 
-static size_t event_fifo_free_list_size(void)
+static void event_fifo_free_list_reset_stats(void)
 {
-    ex10_mutex_lock(&list_mutex);
-    size_t const count = list_size(&event_fifo_free_list);
-    ex10_mutex_unlock(&list_mutex);
-    return count;
+    free_list_reset_stats(get_event_fifo_free_list());
 }
 
 static struct FifoBufferList const ex10_fifo_buffer_list = {
@@ -126,6 +271,8 @@ static struct FifoBufferList const ex10_fifo_buffer_list = {
     .free_list_put  = event_fifo_free_list_put,
     .free_list_get  = event_fifo_free_list_get,
     .free_list_size = event_fifo_free_list_size,
+    .get_stats      = event_fifo_free_list_get_stats,
+    .reset_stats    = event_fifo_free_list_reset_stats,
 };
 
 struct FifoBufferList const* get_ex10_fifo_buffer_list(void)
@@ -135,32 +282,25 @@ struct FifoBufferList const* get_ex10_fifo_buffer_list(void)
 
 static bool result_free_list_put(struct FifoBufferNode* fifo_buffer_node)
 {
-    ex10_mutex_lock(&list_mutex);
-
-    // It is not necessary that fifo_data.length be set to zero,
-    // but it provides a sanity check w.r.t the state of the buffer.
-    fifo_buffer_node->fifo_data.length = 0u;
-
-    bool const is_empty = list_is_empty(&result_free_list);
-    list_push_back(&result_free_list, &fifo_buffer_node->list_node);
-
-    ex10_mutex_unlock(&list_mutex);
-    return is_empty;
+    return free_list_put(get_result_free_list(), fifo_buffer_node);
 }
 
 static struct Ex10Result result_free_list_init(
-    struct FifoBufferNode* fifo_buffer_nodes,
-    struct ByteSpan const* byte_spans,
-    size_t                 buffer_count)
+    struct FifoBufferNode*   fifo_buffer_nodes,
+    struct ByteSpan const*   byte_spans,
+    struct EventPacketIndex* packet_indexes,
+    size_t                   buffer_count)
 {
-    if ((byte_spans == NULL) || (fifo_buffer_nodes == NULL))
+    struct Ex10Result const ex10_result = free_list_init(get_result_free_list(),
+                                                         fifo_buffer_nodes,
+                                                         byte_spans,
+                                                         packet_indexes,
+                                                         buffer_count);
+    if (ex10_result.error)
     {
-        return make_ex10_sdk_error(Ex10ModuleFifoBufferList,
-                                   Ex10SdkErrorNullPointer);
+        return ex10_result;
     }
 
-    list_init(&result_free_list);
-
     for (size_t index = 0u; index < buffer_count; ++index)
     {
         if (byte_spans[index].data == NULL)
@@ -175,15 +315,11 @@ static struct Ex10Result result_free_list_init(
                                        Ex10SdkErrorBadParamLength);
         }
 
-        fifo_buffer_nodes[index].raw_buffer.data   = byte_spans[index].data;
-        fifo_buffer_nodes[index].raw_buffer.length = byte_spans[index].length;
-
-        fifo_buffer_nodes[index].fifo_data.data   = byte_spans[index].data;
-        fifo_buffer_nodes[index].fifo_data.length = 0u;
-
-        get_ex10_list_node_helper()->init(&fifo_buffer_nodes[index].list_node);
-        fifo_buffer_nodes[index].list_node.data = &fifo_buffer_nodes[index];
-        result_free_list_put(&fifo_buffer_nodes[index]);
+        free_list_add_node(get_result_free_list(),
+                           &fifo_buffer_nodes[index],
+                           byte_spans[index].data,
+                           byte_spans[index].length,
+                           &packet_indexes[index]);
     }
 
     return make_ex10_success();
@@ -191,26 +327,22 @@ static struct Ex10Result result_free_list_init(
 
 static struct FifoBufferNode* result_free_list_get(void)
 {
-    ex10_mutex_lock(&list_mutex);
+    return free_list_get(get_result_free_list());
+}
 
-    struct FifoBufferNode* fifo_buffer = NULL;
-    struct Ex10ListNode*   list_node   = list_front(&result_free_list);
-    if (list_node->data)
-    {
-        list_pop_front(&result_free_list);
-        fifo_buffer = (struct FifoBufferNode*)list_node->data;
-    }
+static size_t result_free_list_size(void)
+{
+    return ring_size(&get_result_free_list()->ring);
+}
 
-    ex10_mutex_unlock(&list_mutex);
-    return fifo_buffer;
+static void result_free_list_get_stats(struct FifoBufferListStats* stats)
+{
+    free_list_get_stats(get_result_free_list(), stats);
 }
 
-static size_t result_free_list_size(void)
+static void result_free_list_reset_stats(void)
 {
-    ex10_mutex_lock(&list_mutex);
-    size_t const count = list_size(&result_free_list);
-    ex10_mutex_unlock(&list_mutex);
-    return count;
+    free_list_reset_stats(get_result_free_list());
 }
 
 static struct FifoBufferList const ex10_result_buffer_list = {
@@ -218,6 +350,8 @@ static struct FifoBufferList const ex10_result_buffer_list = {
     .free_list_put  = result_free_list_put,
     .free_list_get  = result_free_list_get,
     .free_list_size = result_free_list_size,
+    .get_stats      = result_free_list_get_stats,
+    .reset_stats    = result_free_list_reset_stats,
 };
 
 struct FifoBufferList const* get_ex10_result_buffer_list(void)
@@ -16,6 +16,7 @@
 #include "board/ex10_osal.h"
 #include "ex10_api/application_registers.h"
 #include "ex10_api/byte_span.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_macros.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_protocol.h"
@@ -26,20 +27,29 @@ struct Gen2BufferBuilderVariables
 {
     struct TxCommandInfo commands_list[10];
 };
-static struct Gen2BufferBuilderVariables builder;
+static struct Gen2BufferBuilderVariables builder_contexts[EX10_MAX_CONTEXTS];
+
+static struct Gen2BufferBuilderVariables* get_builder_context(void)
+{
+    return &builder_contexts[ex10_context_index()];
+}
 
 
 static void clear_local_sequence(void)
 {
+    struct Gen2BufferBuilderVariables* builder = get_builder_context();
+
     for (uint8_t idx = 0u; idx < MaxTxCommandCount; idx++)
     {
-        builder.commands_list[idx].valid = false;
+        builder->commands_list[idx].valid = false;
     }
 }
 
 static struct Ex10Result clear_command_in_local_sequence(uint8_t clear_idx,
                                                          size_t* cmd_index)
 {
+    struct Gen2BufferBuilderVariables* builder = get_builder_context();
+
     if (!cmd_index)
     {
         return make_ex10_sdk_error(Ex10ModuleGen2Commands,
@@ -52,7 +62,7 @@ static struct Ex10Result clear_command_in_local_sequence(uint8_t clear_idx,
         return make_ex10_sdk_error(Ex10ModuleGen2Commands,
                                    Ex10ErrorGen2NumCommands);
     }
-    builder.commands_list[clear_idx].valid = false;
+    builder->commands_list[clear_idx].valid = false;
 
     *cmd_index = clear_idx;
     return make_ex10_success();
@@ -86,18 +96,22 @@ static void clear_sequence(void)
 
 static void buffer_builder_init(void)
 {
+    struct Gen2BufferBuilderVariables* builder = get_builder_context();
+
     for (uint8_t idx = 0u; idx < MaxTxCommandCount; idx++)
     {
-        builder.commands_list[idx].encoded_command.data =
-            builder.commands_list[idx].encoded_buffer;
-        builder.commands_list[idx].decoded_command.args =
-            builder.commands_list[idx].decoded_buffer;
+        builder->commands_list[idx].encoded_command.data =
+            builder->commands_list[idx].encoded_buffer;
+        builder->commands_list[idx].decoded_command.args =
+            builder->commands_list[idx].decoded_buffer;
     }
     clear_local_sequence();
 }
 
 static struct Ex10Result write_sequence(void)
 {
+    struct Gen2BufferBuilderVariables* builder = get_builder_context();
+
     uint8_t tx_buffer[GEN2_TX_BUFFER_REG_LENGTH];
     ex10_memzero(&tx_buffer, sizeof(tx_buffer));
     uint8_t ids_list[MaxTxCommandCount];
@@ -112,16 +126,16 @@ static struct Ex10Result write_sequence(void)
     uint16_t buffer_offset = 0;
     for (uint8_t idx = 0u; idx < MaxTxCommandCount; idx++)
     {
-        if (builder.commands_list[idx].valid)
+        if (builder->commands_list[idx].valid)
         {
             // Update the register write for offset, length, and id.
             // We know that buffer_offset < sizeof(tx_buffer) - check below -
             // so the cast to uint8_t is valid.
             offset_reg_list[idx] = (uint8_t)buffer_offset;
-            ids_list[idx]        = builder.commands_list[idx].transaction_id;
+            ids_list[idx]        = builder->commands_list[idx].transaction_id;
             // Note this is bit length
             length_reg_list[idx] =
-                (uint16_t)builder.commands_list[idx].encoded_command.length;
+                (uint16_t)builder->commands_list[idx].encoded_command.length;
             // find the byte length as well
             uint16_t byte_size =
                 (length_reg_list[idx] - (length_reg_list[idx] % 8)) / 8;
@@ -138,7 +152,7 @@ static struct Ex10Result write_sequence(void)
             int const copy_result =
                 ex10_memcpy(&tx_buffer[buffer_offset],
                             sizeof(tx_buffer) - buffer_offset,
-                            builder.commands_list[idx].encoded_command.data,
+                            builder->commands_list[idx].encoded_command.data,
                             byte_size);
             if (copy_result != 0)
             {
@@ -152,7 +166,7 @@ static struct Ex10Result write_sequence(void)
             // Update reg write for tx device controls
             struct Ex10Result ex10_result =
                 get_ex10_gen2_commands()->get_gen2_tx_control_config(
-                    &builder.commands_list[idx].decoded_command,
+                    &builder->commands_list[idx].decoded_command,
                     &txn_control_list[idx]);
             if (ex10_result.error)
             {
@@ -191,6 +205,8 @@ static struct Ex10Result write_select_enables(bool const* select_enables,
                                               uint8_t     size,
                                               size_t*     cmd_index)
 {
+    struct Gen2BufferBuilderVariables* builder = get_builder_context();
+
     if (!select_enables || !cmd_index)
     {
         return make_ex10_sdk_error(Ex10ModuleGen2Commands,
@@ -212,12 +228,12 @@ static struct Ex10Result write_select_enables(bool const* select_enables,
         // if there is an interest in enabling this index
         if (select_enables[idx])
         {
-            if (builder.commands_list[idx].valid)
+            if (builder->commands_list[idx].valid)
             {
                 // check if the command being enabled matches this register
                 // If not, we will still enable it, but warn the user
                 if (!get_is_select(
-                        builder.commands_list[idx].decoded_command.command))
+                        builder->commands_list[idx].decoded_command.command))
                 {
                     ex10_eprintf(
                         "NOTE: Enabling a non-select command at index %zd for "
@@ -250,6 +266,8 @@ static struct Ex10Result write_halted_enables(bool const* access_enables,
                                               uint8_t     size,
                                               size_t*     cmd_index)
 {
+    struct Gen2BufferBuilderVariables* builder = get_builder_context();
+
     if (access_enables == NULL || cmd_index == NULL)
     {
         return make_ex10_sdk_error(Ex10ModuleGen2Commands,
@@ -271,12 +289,12 @@ static struct Ex10Result write_halted_enables(bool const* access_enables,
         // if there is an interest in enabling this index
         if (access_enables[idx])
         {
-            if (builder.commands_list[idx].valid)
+            if (builder->commands_list[idx].valid)
             {
                 // check if the command being enabled matches this register
                 // If not, we will still enable it, but warn the user
                 if (get_is_select(
-                        builder.commands_list[idx].decoded_command.command))
+                        builder->commands_list[idx].decoded_command.command))
                 {
                     ex10_eprintf(
                         "NOTE: Enabling a select command at index %zd for "
@@ -310,6 +328,8 @@ static struct Ex10Result write_auto_access_enables(
     uint8_t     size,
     size_t*     cmd_index)
 {
+    struct Gen2BufferBuilderVariables* builder = get_builder_context();
+
     if (auto_access_enables == NULL || cmd_index == NULL)
     {
         return make_ex10_sdk_error(Ex10ModuleGen2Commands,
@@ -331,12 +351,12 @@ static struct Ex10Result write_auto_access_enables(
         // if there is an interest in enabling this index
         if (auto_access_enables[idx])
         {
-            if (builder.commands_list[idx].valid)
+            if (builder->commands_list[idx].valid)
             {
                 // check if the command being enabled matches this register
                 // If not, we will still enable it, but warn the user
                 if (get_is_select(
-                        builder.commands_list[idx].decoded_command.command))
+                        builder->commands_list[idx].decoded_command.command))
                 {
                     ex10_eprintf(
                         "NOTE: Enabling a select command at index %zd for auto "
@@ -371,6 +391,8 @@ static struct Ex10Result append_encoded_command(const struct BitSpan* tx_buffer,
                                                 uint8_t transaction_id,
                                                 size_t* cmd_index)
 {
+    struct Gen2BufferBuilderVariables* builder = get_builder_context();
+
     if (tx_buffer == NULL || cmd_index == NULL)
     {
         return make_ex10_sdk_error(Ex10ModuleGen2Commands,
@@ -381,7 +403,7 @@ static struct Ex10Result append_encoded_command(const struct BitSpan* tx_buffer,
 
     // Find the next available slot
     uint8_t index = 0;
-    while (builder.commands_list[index].valid)
+    while (builder->commands_list[index].valid)
     {
         index++;
         // No room, return an error
@@ -395,7 +417,7 @@ static struct Ex10Result append_encoded_command(const struct BitSpan* tx_buffer,
     // Also store the decoded command for debug and tx configuration registers
     struct Ex10Result ex10_result =
         get_ex10_gen2_commands()->decode_gen2_command(
-            &builder.commands_list[index].decoded_command, tx_buffer);
+            &builder->commands_list[index].decoded_command, tx_buffer);
     if (ex10_result.error)
     {
         ex10_eprintf("Command decode failed (transaction id = %d)\n",
@@ -404,10 +426,10 @@ static struct Ex10Result append_encoded_command(const struct BitSpan* tx_buffer,
     }
 
     // Store the encoded data
-    builder.commands_list[index].encoded_command.length = tx_buffer->length;
+    builder->commands_list[index].encoded_command.length = tx_buffer->length;
     int const copy_result =
-        ex10_memcpy(builder.commands_list[index].encoded_command.data,
-                    sizeof(builder.commands_list[index].encoded_buffer),
+        ex10_memcpy(builder->commands_list[index].encoded_command.data,
+                    sizeof(builder->commands_list[index].encoded_buffer),
                     tx_buffer->data,
                     tx_buffer->length);
     if (copy_result != 0)
@@ -415,8 +437,8 @@ static struct Ex10Result append_encoded_command(const struct BitSpan* tx_buffer,
         return make_ex10_sdk_error(Ex10ModuleGen2Commands, Ex10MemcpyFailed);
     }
 
-    builder.commands_list[index].valid          = true;
-    builder.commands_list[index].transaction_id = transaction_id;
+    builder->commands_list[index].valid          = true;
+    builder->commands_list[index].transaction_id = transaction_id;
 
     *cmd_index = index;
     return make_ex10_success();
@@ -427,6 +449,8 @@ static struct Ex10Result encode_and_append_command(
     uint8_t                 transaction_id,
     size_t*                 cmd_index)
 {
+    struct Gen2BufferBuilderVariables* builder = get_builder_context();
+
     if (cmd_spec == NULL || cmd_index == NULL)
     {
         return make_ex10_sdk_error(Ex10ModuleGen2Commands,
@@ -437,7 +461,7 @@ static struct Ex10Result encode_and_append_command(
 
     // Find the next available slot
     uint8_t index = 0;
-    while (builder.commands_list[index].valid)
+    while (builder->commands_list[index].valid)
     {
         index++;
         // No room, return an error
@@ -451,7 +475,7 @@ static struct Ex10Result encode_and_append_command(
     // Attempt to store the encoded info
     struct Ex10Result const ex10_result =
         get_ex10_gen2_commands()->encode_gen2_command(
-            cmd_spec, &builder.commands_list[index].encoded_command);
+            cmd_spec, &builder->commands_list[index].encoded_command);
     if (ex10_result.error)
     {
         ex10_eprintf("Command encode failed (transaction id = %d)\n",
@@ -461,19 +485,19 @@ static struct Ex10Result encode_and_append_command(
     }
 
     // Store the decoded info
-    builder.commands_list[index].decoded_command.command = cmd_spec->command;
+    builder->commands_list[index].decoded_command.command = cmd_spec->command;
     int const copy_result =
-        ex10_memcpy(builder.commands_list[index].decoded_command.args,
-                    sizeof(builder.commands_list[index].decoded_buffer),
+        ex10_memcpy(builder->commands_list[index].decoded_command.args,
+                    sizeof(builder->commands_list[index].decoded_buffer),
                     cmd_spec->args,
-                    sizeof(builder.commands_list[index].decoded_buffer));
+                    sizeof(builder->commands_list[index].decoded_buffer));
     if (copy_result != 0)
     {
         return make_ex10_sdk_error(Ex10ModuleGen2Commands, Ex10MemcpyFailed);
     }
 
-    builder.commands_list[index].valid          = true;
-    builder.commands_list[index].transaction_id = transaction_id;
+    builder->commands_list[index].valid          = true;
+    builder->commands_list[index].transaction_id = transaction_id;
 
     *cmd_index = index;
     return make_ex10_success();
@@ -481,6 +505,8 @@ static struct Ex10Result encode_and_append_command(
 
 static struct Ex10Result read_device_to_local_sequence(void)
 {
+    struct Gen2BufferBuilderVariables* builder = get_builder_context();
+
     struct Ex10Protocol const* protocol = get_ex10_protocol();
 
     struct Gen2OffsetsFields gen2_offsets[MaxTxCommandCount];
@@ -498,9 +524,9 @@ static struct Ex10Result read_device_to_local_sequence(void)
         if (gen2_lengths[idx].length != 0)
         {
             // Mark the command as valid
-            builder.commands_list[idx].valid = true;
+            builder->commands_list[idx].valid = true;
             // Copy the encoded command and length into the encoded storage
-            builder.commands_list[idx].encoded_command.length =
+            builder->commands_list[idx].encoded_command.length =
                 gen2_lengths[idx].length;
             // grab the byte size for copying over the data
             uint16_t byte_size =
@@ -508,8 +534,8 @@ static struct Ex10Result read_device_to_local_sequence(void)
             byte_size += (gen2_lengths[idx].length % 8) ? 1 : 0;
 
             int const copy_result =
-                ex10_memcpy(builder.commands_list[idx].encoded_command.data,
-                            sizeof(builder.commands_list[idx].encoded_buffer),
+                ex10_memcpy(builder->commands_list[idx].encoded_command.data,
+                            sizeof(builder->commands_list[idx].encoded_buffer),
                             &tx_buffer[gen2_offsets[idx].offset],
                             byte_size);
             if (copy_result != 0)
@@ -521,8 +547,8 @@ static struct Ex10Result read_device_to_local_sequence(void)
             // Decode the command from the buffer into the decoded storage
             struct Ex10Result const ex10_result =
                 get_ex10_gen2_commands()->decode_gen2_command(
-                    &builder.commands_list[idx].decoded_command,
-                    &builder.commands_list[idx].encoded_command);
+                    &builder->commands_list[idx].decoded_command,
+                    &builder->commands_list[idx].encoded_command);
 
             if (ex10_result.error)
             {
@@ -538,7 +564,7 @@ static struct Ex10Result read_device_to_local_sequence(void)
         }
         else
         {
-            builder.commands_list[idx].valid = false;
+            builder->commands_list[idx].valid = false;
         }
     }
 
@@ -547,26 +573,28 @@ static struct Ex10Result read_device_to_local_sequence(void)
 
 static void print_local_sequence(void)
 {
+    struct Gen2BufferBuilderVariables* builder = get_builder_context();
+
     for (uint8_t idx = 0u; idx < MaxTxCommandCount; idx++)
     {
         // 0 length means the command is not valid
-        if (builder.commands_list[idx].valid)
+        if (builder->commands_list[idx].valid)
         {
             ex10_printf("Command of length %zd\n",
-                        builder.commands_list[idx].encoded_command.length);
+                        builder->commands_list[idx].encoded_command.length);
             ex10_printf("Raw data: ");
             for (size_t buff_idx = 0;
-                 buff_idx < builder.commands_list[idx].encoded_command.length;
+                 buff_idx < builder->commands_list[idx].encoded_command.length;
                  buff_idx++)
             {
                 ex10_printf(
                     "%d, ",
-                    builder.commands_list[idx].encoded_command.data[buff_idx]);
+                    builder->commands_list[idx].encoded_command.data[buff_idx]);
             }
             ex10_printf("\n");
             // Add your own further debug based on need
             ex10_printf("Command type is: %d\n",
-                        builder.commands_list[idx].decoded_command.command);
+                        builder->commands_list[idx].decoded_command.command);
         }
     }
 }
@@ -622,7 +650,9 @@ static void dump_control_registers(void)
 
 static struct TxCommandInfo* get_local_sequence(void)
 {
-    return builder.commands_list;
+    struct Gen2BufferBuilderVariables* builder = get_builder_context();
+
+    return builder->commands_list;
 }
 
 struct Ex10Gen2TxCommandManager const* get_ex10_gen2_tx_command_manager(void)
@@ -16,6 +16,7 @@
 #include "board/board_spec.h"
 #include "calibration.h"
 #include "ex10_api/ex10_active_region.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_result.h"
 #include "ex10_api/ex10_rf_power.h"
@@ -34,13 +35,30 @@ struct ReversePowerParams
 /* Default parameters for reverse power threshold as used by the reader
  * callbacks. */
 
-static struct ReversePowerParams rev_power_params = {
+static struct ReversePowerParams const rev_power_params_defaults = {
     .return_loss_cdb  = 1000,
     .max_margin_cdb   = -400,
     .last_threshold   = 0,
     .last_measurement = 0,
 };
 
+static struct ReversePowerParams rev_power_contexts[EX10_MAX_CONTEXTS];
+static struct Ex10ContextOnce    rev_power_contexts_once;
+
+static void init_rev_power_contexts(void)
+{
+    for (size_t index = 0u; index < EX10_MAX_CONTEXTS; ++index)
+    {
+        rev_power_contexts[index] = rev_power_params_defaults;
+    }
+}
+
+static struct ReversePowerParams* get_rev_power_context(void)
+{
+    ex10_context_init_once(&rev_power_contexts_once, init_rev_power_contexts);
+    return &rev_power_contexts[ex10_context_index()];
+}
+
 static void antenna_disconnect_post_ramp_callback(
     struct Ex10Result* ex10_result);
 
@@ -59,12 +77,16 @@ static struct Ex10Result deinit(void)
 
 static void set_return_loss_cdb(uint16_t return_loss_cdb)
 {
-    rev_power_params.return_loss_cdb = return_loss_cdb;
+    struct ReversePowerParams* rev_power_params = get_rev_power_context();
+
+    rev_power_params->return_loss_cdb = return_loss_cdb;
 }
 
 static void set_max_margin_cdb(int16_t max_margin_cdb)
 {
-    rev_power_params.max_margin_cdb = max_margin_cdb;
+    struct ReversePowerParams* rev_power_params = get_rev_power_context();
+
+    rev_power_params->max_margin_cdb = max_margin_cdb;
 }
 
 /**
@@ -81,6 +103,8 @@ static void set_max_margin_cdb(int16_t max_margin_cdb)
  */
 static bool get_return_loss_threshold_exceeded(void)
 {
+    struct ReversePowerParams* rev_power_params = get_rev_power_context();
+
     struct Ex10Calibration const*       cal = get_ex10_calibration();
     struct Ex10RampModuleManager const* ramp_module_manager =
         get_ex10_ramp_module_manager();
@@ -104,9 +128,9 @@ static bool get_return_loss_threshold_exceeded(void)
      */
     int16_t const thresh =
         ramp_module_manager->retrieve_post_ramp_tx_power_cdbm() -
-        (int16_t)rev_power_params.return_loss_cdb -
+        (int16_t)rev_power_params->return_loss_cdb -
         ((int16_t)BOARD_INSERTION_LOSS_RX - (int16_t)BOARD_INSERTION_LOSS_LO) -
-        rev_power_params.max_margin_cdb;
+        rev_power_params->max_margin_cdb;
 
     /* Use the expected threshold found above to find...
      * 1. the reverse power detector to use
@@ -166,8 +190,8 @@ static bool get_return_loss_threshold_exceeded(void)
     }
     // Stash the theshold and last measurement away
     // in case they are needed later
-    rev_power_params.last_threshold   = reverse_power_adc_threshold;
-    rev_power_params.last_measurement = reverse_power_adc;
+    rev_power_params->last_threshold   = reverse_power_adc_threshold;
+    rev_power_params->last_measurement = reverse_power_adc;
 
     if (reverse_power_adc >= reverse_power_adc_threshold)
     {
@@ -179,12 +203,16 @@ static bool get_return_loss_threshold_exceeded(void)
 
 static uint16_t get_last_reverse_power_adc_threshold(void)
 {
-    return rev_power_params.last_threshold;
+    struct ReversePowerParams* rev_power_params = get_rev_power_context();
+
+    return rev_power_params->last_threshold;
 }
 
 static uint16_t get_last_reverse_power_adc(void)
 {
-    return rev_power_params.last_measurement;
+    struct ReversePowerParams* rev_power_params = get_rev_power_context();
+
+    return rev_power_params->last_measurement;
 }
 
 static void antenna_disconnect_post_ramp_callback(
@@ -17,6 +17,7 @@
 #include "calibration.h"
 #include "ex10_api/application_registers.h"
 #include "ex10_api/ex10_active_region.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_result.h"
 #include "ex10_api/ex10_rf_power.h"
@@ -64,7 +65,7 @@ struct Ex10LbtParams
  * These variables can be modified using the provided setter
  * functions
  */
-static struct Ex10LbtParams lbt_params = {
+static struct Ex10LbtParams const lbt_params_defaults = {
     .lbt_offset_khz              = -200,
     .rssi_count_exp              = 11,
     .passes_required             = 5,
@@ -76,6 +77,23 @@ static struct Ex10LbtParams lbt_params = {
     .total_num_rssi_measurements = 0,
 };
 
+static struct Ex10LbtParams   lbt_params_contexts[EX10_MAX_CONTEXTS];
+static struct Ex10ContextOnce lbt_params_contexts_once;
+
+static void init_lbt_params_contexts(void)
+{
+    for (size_t index = 0u; index < EX10_MAX_CONTEXTS; ++index)
+    {
+        lbt_params_contexts[index] = lbt_params_defaults;
+    }
+}
+
+static struct Ex10LbtParams* get_lbt_params_context(void)
+{
+    ex10_context_init_once(&lbt_params_contexts_once, init_lbt_params_contexts);
+    return &lbt_params_contexts[ex10_context_index()];
+}
+
 // forward declaration
 static void lbt_pre_ramp_callback(struct Ex10Result* ex10_result);
 
@@ -94,42 +112,58 @@ static struct Ex10Result deinit(void)
 
 static void set_rssi_count(uint8_t rssi_count_exp)
 {
-    lbt_params.rssi_count_exp = rssi_count_exp;
+    struct Ex10LbtParams* lbt_params = get_lbt_params_context();
+
+    lbt_params->rssi_count_exp = rssi_count_exp;
 }
 
 static void set_passes_required(uint8_t passes_required)
 {
-    lbt_params.passes_required = passes_required;
+    struct Ex10LbtParams* lbt_params = get_lbt_params_context();
+
+    lbt_params->passes_required = passes_required;
 }
 
 static void set_lbt_pass_threshold_cdbm(int32_t lbt_pass_threshold_cdbm)
 {
-    lbt_params.lbt_pass_threshold_cdbm = lbt_pass_threshold_cdbm;
+    struct Ex10LbtParams* lbt_params = get_lbt_params_context();
+
+    lbt_params->lbt_pass_threshold_cdbm = lbt_pass_threshold_cdbm;
 }
 
 static void set_max_rssi_measurements(uint32_t max_rssi_measurements)
 {
-    lbt_params.max_rssi_measurements = max_rssi_measurements;
+    struct Ex10LbtParams* lbt_params = get_lbt_params_context();
+
+    lbt_params->max_rssi_measurements = max_rssi_measurements;
 }
 
 static void set_measurement_delay_us(uint16_t measurement_delay_us)
 {
-    lbt_params.measurement_delay_us = measurement_delay_us;
+    struct Ex10LbtParams* lbt_params = get_lbt_params_context();
+
+    lbt_params->measurement_delay_us = measurement_delay_us;
 }
 
 static int16_t get_last_rssi_measurement(void)
 {
-    return lbt_params.last_rssi;
+    struct Ex10LbtParams* lbt_params = get_lbt_params_context();
+
+    return lbt_params->last_rssi;
 }
 
 static uint32_t get_last_frequency_khz(void)
 {
-    return lbt_params.last_frequency_khz;
+    struct Ex10LbtParams* lbt_params = get_lbt_params_context();
+
+    return lbt_params->last_frequency_khz;
 }
 
 static uint32_t get_total_num_rssi_measurements(void)
 {
-    return lbt_params.total_num_rssi_measurements;
+    struct Ex10LbtParams* lbt_params = get_lbt_params_context();
+
+    return lbt_params->total_num_rssi_measurements;
 }
 
 static struct RxGainControlFields get_default_lbt_rx_analog_configs(void)
@@ -315,13 +349,15 @@ struct MultiLbtRssiInfo
 static void count_under_rssi_limit(int16_t*                 rssi_measurements,
                                    struct MultiLbtRssiInfo* lbt_rssi_info)
 {
+    struct Ex10LbtParams* lbt_params = get_lbt_params_context();
+
     for (size_t idx = 0; idx < lbt_rssi_info->num_measurements; idx++)
     {
         const int16_t curr_rssi_cdbm = rssi_measurements[idx];
 
         // stash away the current measurement in case anyone asks
         // later
-        lbt_params.last_rssi = curr_rssi_cdbm;
+        lbt_params->last_rssi = curr_rssi_cdbm;
 
         if (curr_rssi_cdbm < lbt_rssi_info->pass_threshold)
         {
@@ -347,19 +383,21 @@ static void count_under_rssi_limit(int16_t*                 rssi_measurements,
 
 static int16_t multi_listen_before_talk_rssi(uint8_t antenna)
 {
-    lbt_params.total_num_rssi_measurements = 0;
-    lbt_params.last_frequency_khz =
+    struct Ex10LbtParams* lbt_params = get_lbt_params_context();
+
+    lbt_params->total_num_rssi_measurements = 0;
+    lbt_params->last_frequency_khz =
         get_ex10_active_region()->get_next_channel_khz();
 
     // We want to use the same frequency and offset for each measurement
     uint32_t freq_array[RF_SYNTHESIZER_CONTROL_REG_ENTRIES];
     ex10_fill_u32(freq_array,
-                  lbt_params.last_frequency_khz,
+                  lbt_params->last_frequency_khz,
                   rf_synthesizer_control_reg.num_entries);
 
     int32_t offset_array[LBT_OFFSET_REG_ENTRIES];
     ex10_fill_u32((uint32_t*)offset_array,
-                  (uint32_t)lbt_params.lbt_offset_khz,
+                  (uint32_t)lbt_params->lbt_offset_khz,
                   lbt_offset_reg.num_entries);
 
     // Create an array for the output values
@@ -371,16 +409,16 @@ static int16_t multi_listen_before_talk_rssi(uint8_t antenna)
     // sequence. Aka if 3 RSSIs are under limit, then one is above limit, this
     // successive value is reset to the minimum.
     struct MultiLbtRssiInfo lbt_rssi_info = {
-        .pass_threshold          = lbt_params.lbt_pass_threshold_cdbm,
-        .passes_required         = lbt_params.passes_required,
+        .pass_threshold          = lbt_params->lbt_pass_threshold_cdbm,
+        .passes_required         = lbt_params->passes_required,
         .num_measurements        = 0,
         .under_limit_count       = 0,
         .highest_successive_rssi = INT16_MIN,
         .highest_rssi            = INT16_MIN,
     };
 
-    while (lbt_params.total_num_rssi_measurements <
-           lbt_params.max_rssi_measurements)
+    while (lbt_params->total_num_rssi_measurements <
+           lbt_params->max_rssi_measurements)
     {
         if (lbt_rssi_info.passes_required >
             rf_synthesizer_control_reg.num_entries)
@@ -396,7 +434,7 @@ static int16_t multi_listen_before_talk_rssi(uint8_t antenna)
             .override              = false,
             .narrow_bandwidth_mode = false,
             .num_rssi_measurements = lbt_rssi_info.num_measurements,
-            .measurement_delay_us  = lbt_params.measurement_delay_us,
+            .measurement_delay_us  = lbt_params->measurement_delay_us,
         };
 
         struct RxGainControlFields dummy_rx_fields;
@@ -404,7 +442,7 @@ static int16_t multi_listen_before_talk_rssi(uint8_t antenna)
         // Run the op and return the number of rssi measurements specified
         struct Ex10Result const ex10_result =
             listen_before_talk_multi(antenna,
-                                     lbt_params.rssi_count_exp,
+                                     lbt_params->rssi_count_exp,
                                      lbt_settings,
                                      freq_array,
                                      offset_array,
@@ -415,7 +453,7 @@ static int16_t multi_listen_before_talk_rssi(uint8_t antenna)
             return lbt_rssi_info.highest_rssi;
         }
 
-        lbt_params.total_num_rssi_measurements +=
+        lbt_params->total_num_rssi_measurements +=
             lbt_rssi_info.num_measurements;
 
         // Run through each measurement, checks if under the allowed limit, and
@@ -432,13 +470,15 @@ static int16_t multi_listen_before_talk_rssi(uint8_t antenna)
 
 static void lbt_pre_ramp_callback(struct Ex10Result* ex10_result)
 {
+    struct Ex10LbtParams* lbt_params = get_lbt_params_context();
+
     // Check lbt on the next channel
     int16_t lbt_rssi_cdbm = multi_listen_before_talk_rssi(
         get_ex10_ramp_module_manager()->retrieve_pre_ramp_antenna());
 
     *ex10_result = make_ex10_success();
     // If LBT exceeded the noise expectations, return false
-    if (lbt_rssi_cdbm >= lbt_params.lbt_pass_threshold_cdbm)
+    if (lbt_rssi_cdbm >= lbt_params->lbt_pass_threshold_cdbm)
     {
         *ex10_result =
             make_ex10_sdk_error(Ex10ListenBeforeTalk, Ex10AboveThreshold);
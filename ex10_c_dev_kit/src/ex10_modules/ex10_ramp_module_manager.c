@@ -14,6 +14,8 @@
 
 #include "ex10_modules/ex10_ramp_module_manager.h"
 
+#include "ex10_api/ex10_context.h"
+
 /**
  * @struct PrivateRampModuleVariables
  * Used at the top level by use cases and examples. This manager offers a
@@ -47,61 +49,102 @@ struct PrivatePostRampVariables
     uint32_t frequency_khz;
 };
 
-static struct PrivateModuleVariables module_variables = {
-    .pre_ramp_callback  = NULL,
-    .post_ramp_callback = NULL,
-    .adc_temperature    = INT16_MAX,
+/// The ramp module manager state of one Impinj Reader Chip context.
+struct RampModuleContext
+{
+    struct PrivateModuleVariables   module_variables;
+    struct PrivatePreRampVariables  pre_ramp_variables;
+    struct PrivatePostRampVariables post_ramp_variables;
+};
+
+static struct RampModuleContext const ramp_module_defaults = {
+    .module_variables =
+        {
+            .pre_ramp_callback  = NULL,
+            .post_ramp_callback = NULL,
+            .adc_temperature    = INT16_MAX,
+        },
+    .pre_ramp_variables  = {.antenna = 0},
+    .post_ramp_variables = {.tx_power_cdbm = 0, .frequency_khz = 0},
 };
 
-static struct PrivatePreRampVariables pre_ramp_variables = {.antenna = 0};
+static struct RampModuleContext ramp_module_contexts[EX10_MAX_CONTEXTS];
+static struct Ex10ContextOnce   ramp_module_contexts_once;
 
-static struct PrivatePostRampVariables post_ramp_variables = {
-    .tx_power_cdbm = 0,
-    .frequency_khz = 0};
+static void init_ramp_module_contexts(void)
+{
+    for (size_t index = 0u; index < EX10_MAX_CONTEXTS; ++index)
+    {
+        ramp_module_contexts[index] = ramp_module_defaults;
+    }
+}
+
+static struct RampModuleContext* get_ramp_module_context(void)
+{
+    ex10_context_init_once(&ramp_module_contexts_once,
+                           init_ramp_module_contexts);
+    return &ramp_module_contexts[ex10_context_index()];
+}
 
 
 static void store_adc_temperature(uint16_t adc_temperature)
 {
-    module_variables.adc_temperature = adc_temperature;
+    struct RampModuleContext* ramp_module = get_ramp_module_context();
+
+    ramp_module->module_variables.adc_temperature = adc_temperature;
 }
 
 static void store_pre_ramp_variables(uint8_t antenna)
 {
-    pre_ramp_variables.antenna = antenna;
+    struct RampModuleContext* ramp_module = get_ramp_module_context();
+
+    ramp_module->pre_ramp_variables.antenna = antenna;
 }
 
 static void store_post_ramp_variables(int16_t  tx_power_cdbm,
                                       uint32_t frequency_khz)
 {
-    post_ramp_variables.tx_power_cdbm = tx_power_cdbm;
-    post_ramp_variables.frequency_khz = frequency_khz;
+    struct RampModuleContext* ramp_module = get_ramp_module_context();
+
+    ramp_module->post_ramp_variables.tx_power_cdbm = tx_power_cdbm;
+    ramp_module->post_ramp_variables.frequency_khz = frequency_khz;
 }
 
 static uint16_t retrieve_adc_temperature(void)
 {
-    return module_variables.adc_temperature;
+    struct RampModuleContext* ramp_module = get_ramp_module_context();
+
+    return ramp_module->module_variables.adc_temperature;
 }
 static uint32_t retrieve_post_ramp_frequency_khz(void)
 {
-    return post_ramp_variables.frequency_khz;
+    struct RampModuleContext* ramp_module = get_ramp_module_context();
+
+    return ramp_module->post_ramp_variables.frequency_khz;
 }
 
 static int16_t retrieve_post_ramp_tx_power_cdbm(void)
 {
-    return post_ramp_variables.tx_power_cdbm;
+    struct RampModuleContext* ramp_module = get_ramp_module_context();
+
+    return ramp_module->post_ramp_variables.tx_power_cdbm;
 }
 
 static uint8_t retrieve_pre_ramp_antenna(void)
 {
-    return pre_ramp_variables.antenna;
+    struct RampModuleContext* ramp_module = get_ramp_module_context();
+
+    return ramp_module->pre_ramp_variables.antenna;
 }
 
 static struct Ex10Result call_pre_ramp_callback(void)
 {
-    if (module_variables.pre_ramp_callback != NULL)
+    struct RampModuleContext* ramp_module = get_ramp_module_context();
+
+    if (ramp_module->module_variables.pre_ramp_callback != NULL)
     {
         struct Ex10Result ex10_result;
-        module_variables.pre_ramp_callback(&ex10_result);
+        ramp_module->module_variables.pre_ramp_callback(&ex10_result);
         return ex10_result;
     }
 
@@ -110,10 +153,12 @@ static struct Ex10Result call_pre_ramp_callback(void)
 
 static struct Ex10Result call_post_ramp_callback(void)
 {
-    if (module_variables.post_ramp_callback != NULL)
+    struct RampModuleContext* ramp_module = get_ramp_module_context();
+
+    if (ramp_module->module_variables.post_ramp_callback != NULL)
     {
         struct Ex10Result ex10_result;
-        module_variables.post_ramp_callback(&ex10_result);
+        ramp_module->module_variables.post_ramp_callback(&ex10_result);
         return ex10_result;
     }
     return make_ex10_success();
@@ -123,22 +168,26 @@ static struct Ex10Result register_ramp_callbacks(
     void (*pre_cb)(struct Ex10Result*),
     void (*post_cb)(struct Ex10Result*))
 {
+    struct RampModuleContext* ramp_module = get_ramp_module_context();
+
     // Both pre and post callbacks must be empty
-    if (module_variables.pre_ramp_callback != NULL ||
-        module_variables.post_ramp_callback != NULL)
+    if (ramp_module->module_variables.pre_ramp_callback != NULL ||
+        ramp_module->module_variables.post_ramp_callback != NULL)
     {
         return make_ex10_sdk_error(Ex10ModuleModuleManager,
                                    Ex10SdkErrorInvalidState);
     }
-    module_variables.pre_ramp_callback  = pre_cb;
-    module_variables.post_ramp_callback = post_cb;
+    ramp_module->module_variables.pre_ramp_callback  = pre_cb;
+    ramp_module->module_variables.post_ramp_callback = post_cb;
     return make_ex10_success();
 }
 
 static void unregister_ramp_callbacks(void)
 {
-    module_variables.pre_ramp_callback  = NULL;
-    module_variables.post_ramp_callback = NULL;
+    struct RampModuleContext* ramp_module = get_ramp_module_context();
+
+    ramp_module->module_variables.pre_ramp_callback  = NULL;
+    ramp_module->module_variables.post_ramp_callback = NULL;
 }
 
 static struct Ex10RampModuleManager const ex10_module_manager = {
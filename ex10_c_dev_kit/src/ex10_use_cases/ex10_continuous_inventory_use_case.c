@@ -13,6 +13,7 @@
 
 #include "board/board_spec.h"
 #include "board/ex10_osal.h"
+#include "calibration.h"
 
 #include "ex10_api/application_registers.h"
 #include "ex10_api/byte_span.h"
@@ -20,11 +21,13 @@
 #include "ex10_api/event_fifo_printer.h"
 #include "ex10_api/event_packet_parser.h"
 #include "ex10_api/ex10_active_region.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_event_fifo_queue.h"
 #include "ex10_api/ex10_inventory.h"
 #include "ex10_api/ex10_ops.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_rf_power.h"
+#include "ex10_api/ex10_tag_table.h"
 #include "ex10_api/fifo_buffer_list.h"
 #include "ex10_api/gen2_tx_command_manager.h"
 
@@ -97,66 +100,86 @@ struct ContinuousInventoryState
     /// If false, all access commands enabled will be sent
     bool abort_on_fail;
 
+    /// If true, only TagRead packets of tags new to the tag table are
+    /// published. If false, all TagRead packets are published.
+    bool tag_table_filter;
+
     /// The callback to notify the subscriber of a new packet.
     void (*packet_subscriber_callback)(struct EventFifoPacket const*,
                                        struct Ex10Result*);
 };
 
 /**
- * Ex10ContinuousInventory private state variables.
+ * Ex10ContinuousInventory private state variables, one set per Impinj
+ * Reader Chip context.
  * These are initialized in the init() so that if
  * it is called multiple times, it will return to the
  * same starting condition.
  */
-static struct InventoryParams          inventory_params;
-static bool                            inventory_dual_target;
-static struct ContinuousInventoryState inventory_state;
-static struct StopConditions           stop_conditions;
-static uint32_t                        start_time_us;
+struct ContinuousInventoryContext
+{
+    struct InventoryParams          params;
+    bool                            dual_target;
+    struct ContinuousInventoryState state;
+    struct StopConditions           stop_conditions;
+    uint32_t                        start_time_us;
+};
+
+static struct ContinuousInventoryContext inventory_contexts[EX10_MAX_CONTEXTS];
+
+static struct ContinuousInventoryContext* get_inventory_context(void)
+{
+    return &inventory_contexts[ex10_context_index()];
+}
 
 static bool check_stop_conditions(uint32_t timestamp_us)
 {
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
     // If the reason is already set, we return so as to retain the original stop
     // reason
-    if (inventory_state.stop_reason != SRNone)
+    if (inventory->state.stop_reason != SRNone)
     {
         return true;
     }
 
-    if (stop_conditions.max_number_of_rounds > 0u)
+    if (inventory->stop_conditions.max_number_of_rounds > 0u)
     {
-        if (inventory_state.round_count >= stop_conditions.max_number_of_rounds)
+        if (inventory->state.round_count >=
+            inventory->stop_conditions.max_number_of_rounds)
         {
-            inventory_state.stop_reason = SRMaxNumberOfRounds;
+            inventory->state.stop_reason = SRMaxNumberOfRounds;
             return true;
         }
     }
-    if (stop_conditions.max_number_of_tags > 0u)
+    if (inventory->stop_conditions.max_number_of_tags > 0u)
     {
-        if (inventory_state.tag_count >= stop_conditions.max_number_of_tags)
+        if (inventory->state.tag_count >=
+            inventory->stop_conditions.max_number_of_tags)
         {
-            inventory_state.stop_reason = SRMaxNumberOfTags;
+            inventory->state.stop_reason = SRMaxNumberOfTags;
             return true;
         }
     }
-    if (stop_conditions.max_duration_us > 0u)
+    if (inventory->stop_conditions.max_duration_us > 0u)
     {
         // Packet before start checks for packets which occurred before the
         // continuous inventory round was started.
-        bool const     packet_before_start = (start_time_us > timestamp_us);
+        bool const     packet_before_start =
+            (inventory->start_time_us > timestamp_us);
         uint32_t const elapsed_us =
             (packet_before_start)
-                ? ((UINT32_MAX - start_time_us) + timestamp_us + 1)
-                : (timestamp_us - start_time_us);
-        if (elapsed_us >= stop_conditions.max_duration_us)
+                ? ((UINT32_MAX - inventory->start_time_us) + timestamp_us + 1)
+                : (timestamp_us - inventory->start_time_us);
+        if (elapsed_us >= inventory->stop_conditions.max_duration_us)
         {
-            inventory_state.stop_reason = SRMaxDuration;
+            inventory->state.stop_reason = SRMaxDuration;
             return true;
         }
     }
-    if (inventory_state.state == InvStopRequested)
+    if (inventory->state.state == InvStopRequested)
     {
-        inventory_state.stop_reason = SRHost;
+        inventory->state.stop_reason = SRHost;
         return true;
     }
     return false;
@@ -166,13 +189,16 @@ static struct Ex10Result push_continuous_inventory_summary_packet(
     struct EventFifoPacket const* event_packet,
     struct Ex10Result             ex10_result)
 {
-    uint32_t const duration_us = event_packet->us_counter - start_time_us;
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
+    uint32_t const duration_us =
+        event_packet->us_counter - inventory->start_time_us;
 
     struct ContinuousInventorySummary summary = {
         .duration_us                = duration_us,
-        .number_of_inventory_rounds = inventory_state.round_count,
-        .number_of_tags             = inventory_state.tag_count,
-        .reason                     = (uint8_t)inventory_state.stop_reason,
+        .number_of_inventory_rounds = inventory->state.round_count,
+        .number_of_tags             = inventory->state.tag_count,
+        .reason                     = (uint8_t)inventory->state.stop_reason,
         .last_op_id                 = 0u,
         .last_op_error              = ErrorNone,
         .packet_rfu_1               = 0u,
@@ -254,6 +280,8 @@ static void push_ex10_result_packet(struct Ex10Result ex10_result,
  */
 static struct Ex10Result continue_continuous_inventory(void)
 {
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
     /* Behavior for stop reasons:
     InventorySummaryDone          // Flip target (dual target), reset Q
     InventorySummaryHost          // Don't care
@@ -265,70 +293,71 @@ static struct Ex10Result continue_continuous_inventory(void)
     */
 
     bool reset_q = false;
-    if (inventory_dual_target)
+    if (inventory->dual_target)
     {
         // Flip target if round is done, not for regulatory or error.
-        if (inventory_state.done_reason == InventorySummaryDone)
+        if (inventory->state.done_reason == InventorySummaryDone)
         {
-            inventory_state.target ^= 1u;
+            inventory->state.target ^= 1u;
             reset_q = true;
         }
 
         // If CW is not on and our session is zero (no persistence after power),
         // we need to switch the target to A.
-        if ((inventory_params.inventory_config.session == 0) &&
+        if ((inventory->params.inventory_config.session == 0) &&
             (get_ex10_rf_power()->get_cw_is_on() == false))
         {
-            inventory_state.target = target_A;
-            reset_q                = true;
+            inventory->state.target = target_A;
+            reset_q                 = true;
         }
     }
-    else if (inventory_state.done_reason == InventorySummaryDone)
+    else if (inventory->state.done_reason == InventorySummaryDone)
     {
         reset_q = true;
     }
 
-    inventory_params.inventory_config.target = inventory_state.target;
+    inventory->params.inventory_config.target = inventory->state.target;
 
     struct InventoryRoundControlFields inventory_config =
-        inventory_params.inventory_config;
+        inventory->params.inventory_config;
 
     struct InventoryRoundControl_2Fields inventory_config_2 =
-        inventory_params.inventory_config_2;
+        inventory->params.inventory_config_2;
 
     // Preserve Q and internal LMAC counters across rounds or
     // reset for new target.
     if (reset_q)
     {
         // Reset Q for target flip (done above) or for normal end of round.
-        inventory_config.initial_q = inventory_state.initial_q;
+        inventory_config.initial_q = inventory->state.initial_q;
 
         inventory_config_2.starting_min_q_count                       = 0;
         inventory_config_2.starting_max_queries_since_valid_epc_count = 0;
     }
     else
     {
-        if (inventory_state.done_reason == InventorySummaryRegulatory)
+        if (inventory->state.done_reason == InventorySummaryRegulatory)
         {
             // Preserve Q across regulatory Inventory Ops.
-            inventory_config.initial_q = inventory_state.previous_q;
+            inventory_config.initial_q = inventory->state.previous_q;
 
             inventory_config_2.starting_min_q_count =
-                inventory_state.min_q_count;
+                inventory->state.min_q_count;
             inventory_config_2.starting_max_queries_since_valid_epc_count =
-                inventory_state.queries_since_valid_epc_count;
+                inventory->state.queries_since_valid_epc_count;
         }
         // Else inventory stopped because the Q algorithm was done
         // so we use the inventory config values as they were
         // provided.
     }
 
-    return get_ex10_inventory()->start_inventory(inventory_params.antenna,
-                                                 inventory_params.rf_mode,
-                                                 inventory_params.tx_power_cdbm,
-                                                 &inventory_config,
-                                                 &inventory_config_2,
-                                                 inventory_params.send_selects);
+    return get_ex10_inventory()->start_inventory(
+        inventory->params.antenna,
+        inventory->params.rf_mode,
+        inventory->params.tx_power_cdbm,
+        &inventory_config,
+        &inventory_config_2,
+        inventory->params.send_selects);
 }
 
 /**
@@ -349,9 +378,11 @@ static void handle_continuous_inventory_error(
     struct Ex10Result             ex10_result,
     struct EventFifoPacket const* packet)
 {
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
     push_ex10_result_packet(ex10_result, packet->us_counter);
 
-    inventory_state.state = InvIdle;
+    inventory->state.state = InvIdle;
     ex10_result = push_continuous_inventory_summary_packet(packet, ex10_result);
     if (ex10_result.error)
     {
@@ -365,107 +396,138 @@ static void handle_continuous_inventory_error(
     }
 }
 
-// Called by the interrupt handler thread when there is a fifo related
-// interrupt.
-static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
+/**
+ * Update the continuous inventory state from an InventoryRoundSummary packet
+ * and continue or stop continuous inventory accordingly.
+ */
+static void handle_inventory_round_summary(struct EventFifoPacket const* packet)
 {
-    struct ConstByteSpan bytes = fifo_buffer_node->fifo_data;
-    while (bytes.length > 0u)
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
+    struct Ex10Result ex10_result = make_ex10_success();
+    const uint8_t     reason =
+        packet->static_data->inventory_round_summary.reason;
+
+    inventory->state.min_q_count =
+        packet->static_data->inventory_round_summary.min_q_count;
+    inventory->state.queries_since_valid_epc_count =
+        packet->static_data->inventory_round_summary
+            .queries_since_valid_epc_count;
+    inventory->state.done_reason = reason;
+
+    switch (reason)
     {
-        struct Ex10EventParser const* event_parser = get_ex10_event_parser();
-        struct EventFifoPacket const  packet =
-            event_parser->parse_event_packet(&bytes);
-        if (event_parser->get_packet_type_valid(packet.packet_type) == false)
-        {
-            // Invalid packets cannot be processed and will only confuse the
-            // continuous inventory state machine. Discontinue processing.
-            ex10_eprintf(
-                "Invalid packet encountered during continuous inventory "
-                "packet parsing, packet end pos: %zu\n",
-                bytes.length);
+        case InventorySummaryDone:
+        case InventorySummaryHost:
+            // Only count the round as done if the LMAC said it was done
+            // or the host told it to stop.  Any other reason for
+            // stopping is not a complete round, but possibly a reason
+            // to continue the inventory round.
+            inventory->state.round_count += 1;
             break;
-        }
-        if (packet.packet_type == TagRead)
+        case InventorySummaryRegulatory:
+            // Save Q to use for next round's initial Q.
+            inventory->state.previous_q =
+                packet->static_data->inventory_round_summary.final_q;
+            break;
+        case InventorySummaryUnsupported:
+        case InventorySummaryTxNotRampedUp:
+            // No special action. Continue continuous inventory.
+            break;
+        case InventorySummaryEventFifoFull:
+            ex10_result = make_ex10_sdk_error(Ex10ModuleUseCase,
+                                              Ex10SdkEventFifoFull);
+            break;
+        case InventorySummaryInvalidParam:
+            ex10_result = make_ex10_sdk_error(
+                Ex10ModuleUseCase, Ex10InventoryInvalidParam);
+            break;
+        case InventorySummaryLmacOverload:
+            ex10_result = make_ex10_sdk_error(Ex10ModuleUseCase,
+                                              Ex10SdkLmacOverload);
+            break;
+        case InventorySummaryNone:
+        default:
+            ex10_result = make_ex10_sdk_error(
+                Ex10ModuleUseCase, Ex10InventorySummaryReasonInvalid);
+            break;
+    }
+
+    // If the error is set, continuous inventory will be stopped and a
+    // summary sent.
+    if (ex10_result.error)
+    {
+        handle_continuous_inventory_error(ex10_result, packet);
+    }
+    else if (check_stop_conditions(packet->us_counter))
+    {
+        // Otherwise check if continuous inventory stopped frmo one of
+        // the expected stop conditions
+        inventory->state.state = InvIdle;
+        ex10_result = push_continuous_inventory_summary_packet(
+            packet, make_ex10_success());
+        if (ex10_result.error)
         {
-            inventory_state.tag_count += 1;
+            push_ex10_result_packet(ex10_result, packet->us_counter);
         }
-        else if (packet.packet_type == InventoryRoundSummary)
+    }
+    else
+    {
+        // otherwise continue on with continuous inventory
+        ex10_result = continue_continuous_inventory();
+        if (ex10_result.error)
         {
-            struct Ex10Result ex10_result = make_ex10_success();
-            const uint8_t     reason =
-                packet.static_data->inventory_round_summary.reason;
-
-            inventory_state.min_q_count =
-                packet.static_data->inventory_round_summary.min_q_count;
-            inventory_state.queries_since_valid_epc_count =
-                packet.static_data->inventory_round_summary
-                    .queries_since_valid_epc_count;
-            inventory_state.done_reason = reason;
-
-            switch (reason)
-            {
-                case InventorySummaryDone:
-                case InventorySummaryHost:
-                    // Only count the round as done if the LMAC said it was done
-                    // or the host told it to stop.  Any other reason for
-                    // stopping is not a complete round, but possibly a reason
-                    // to continue the inventory round.
-                    inventory_state.round_count += 1;
-                    break;
-                case InventorySummaryRegulatory:
-                    // Save Q to use for next round's initial Q.
-                    inventory_state.previous_q =
-                        packet.static_data->inventory_round_summary.final_q;
-                    break;
-                case InventorySummaryUnsupported:
-                case InventorySummaryTxNotRampedUp:
-                    // No special action. Continue continuous inventory.
-                    break;
-                case InventorySummaryEventFifoFull:
-                    ex10_result = make_ex10_sdk_error(Ex10ModuleUseCase,
-                                                      Ex10SdkEventFifoFull);
-                    break;
-                case InventorySummaryInvalidParam:
-                    ex10_result = make_ex10_sdk_error(
-                        Ex10ModuleUseCase, Ex10InventoryInvalidParam);
-                    break;
-                case InventorySummaryLmacOverload:
-                    ex10_result = make_ex10_sdk_error(Ex10ModuleUseCase,
-                                                      Ex10SdkLmacOverload);
-                    break;
-                case InventorySummaryNone:
-                default:
-                    ex10_result = make_ex10_sdk_error(
-                        Ex10ModuleUseCase, Ex10InventorySummaryReasonInvalid);
-                    break;
-            }
+            handle_continuous_inventory_error(ex10_result, packet);
+        }
+    }
+}
+
+// Called by the interrupt handler thread when there is a fifo related
+// interrupt.
+static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
+{
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
+    // The packets are indexed once here; the index is kept in the node and
+    // reused by the EventFifo queue consumer.
+    struct EventPacketIndex const* packet_index =
+        get_ex10_event_fifo_queue()->get_packet_index(fifo_buffer_node);
 
-            // If the error is set, continuous inventory will be stopped and a
-            // summary sent.
-            if (ex10_result.error)
+    if ((packet_index->type_counts[InventoryRoundSummary] == 0u) &&
+        (packet_index->invalid_packet == false))
+    {
+        // Only TagRead packets affect the continuous inventory state.
+        inventory->state.tag_count += packet_index->type_counts[TagRead];
+    }
+    else
+    {
+        for (size_t position = 0u; position < packet_index->packet_count;
+             ++position)
+        {
+            uint8_t const packet_type = packet_index->packet_types[position];
+            if (packet_type == InvalidPacket)
             {
-                handle_continuous_inventory_error(ex10_result, &packet);
+                // Invalid packets cannot be processed and will only confuse
+                // the continuous inventory state machine. Discontinue
+                // processing.
+                ex10_eprintf(
+                    "Invalid packet encountered during continuous inventory "
+                    "packet parsing, packet offset: %u\n",
+                    packet_index->packet_offsets[position]);
+                break;
             }
-            else if (check_stop_conditions(packet.us_counter))
+            if (packet_type == TagRead)
             {
-                // Otherwise check if continuous inventory stopped frmo one of
-                // the expected stop conditions
-                inventory_state.state = InvIdle;
-                ex10_result = push_continuous_inventory_summary_packet(
-                    &packet, make_ex10_success());
-                if (ex10_result.error)
-                {
-                    push_ex10_result_packet(ex10_result, packet.us_counter);
-                }
+                inventory->state.tag_count += 1;
             }
-            else
+            else if (packet_type == InventoryRoundSummary)
             {
-                // otherwise continue on with continuous inventory
-                ex10_result = continue_continuous_inventory();
-                if (ex10_result.error)
-                {
-                    handle_continuous_inventory_error(ex10_result, &packet);
-                }
+                struct EventFifoPacket const packet =
+                    get_ex10_event_parser()->get_indexed_packet(
+                        fifo_buffer_node->fifo_data.data,
+                        packet_index,
+                        position);
+                handle_inventory_round_summary(&packet);
             }
         }
     }
@@ -478,11 +540,14 @@ static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
 
 static struct Ex10Result init(void)
 {
-    ex10_memzero(&inventory_params, sizeof(inventory_params));
-    ex10_memzero(&inventory_state, sizeof(inventory_state));
-    ex10_memzero(&stop_conditions, sizeof(stop_conditions));
-    inventory_state.state = InvIdle;
-    start_time_us         = 0u;
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
+    ex10_memzero(&inventory->params, sizeof(inventory->params));
+    ex10_memzero(&inventory->state, sizeof(inventory->state));
+    ex10_memzero(&inventory->stop_conditions,
+                 sizeof(inventory->stop_conditions));
+    inventory->state.state   = InvIdle;
+    inventory->start_time_us = 0u;
 
     get_ex10_event_fifo_queue()->init();
     get_ex10_gen2_tx_command_manager()->init();
@@ -526,31 +591,85 @@ static struct Ex10Result deinit(void)
 static void register_packet_subscriber_callback(
     void (*callback)(struct EventFifoPacket const*, struct Ex10Result*))
 {
-    inventory_state.packet_subscriber_callback = callback;
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
+    inventory->state.packet_subscriber_callback = callback;
 }
 
 static void enable_packet_filter(bool enable_filter)
 {
-    inventory_state.publish_all_packets = (enable_filter == false);
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
+    inventory->state.publish_all_packets = (enable_filter == false);
 }
 
 static void enable_auto_access(bool enable)
 {
-    inventory_state.enable_auto_access = enable;
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
+    inventory->state.enable_auto_access = enable;
 }
 
 static void enable_abort_on_fail(bool enable)
 {
-    inventory_state.abort_on_fail = enable;
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
+    inventory->state.abort_on_fail = enable;
+}
+
+static void enable_tag_table_filter(bool enable)
+{
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
+    inventory->state.tag_table_filter = enable;
 }
 
 static enum StopReason get_continuous_inventory_stop_reason(void)
 {
-    return inventory_state.stop_reason;
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
+    return inventory->state.stop_reason;
+}
+
+/**
+ * Add a packet to the tag table.
+ *
+ * @return bool true if the packet is a TagRead of a tag already in the tag
+ *              table, which is not published.
+ */
+static bool tag_table_filter_packet(struct EventFifoPacket const* packet)
+{
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
+    struct Ex10TagTable const* tag_table = get_ex10_tag_table();
+    if (packet->packet_type == InventoryRoundSummary)
+    {
+        tag_table->age(packet->us_counter);
+        return false;
+    }
+    if (packet->packet_type != TagRead)
+    {
+        return false;
+    }
+
+    int16_t const rssi_cdbm = get_ex10_calibration()->get_compensated_rssi(
+        packet->static_data->tag_read.rssi,
+        inventory->params.rf_mode,
+        (const struct RxGainControlFields*)&packet->static_data->tag_read
+            .rx_gain_settings,
+        inventory->params.antenna,
+        get_ex10_active_region()->get_rf_filter(),
+        get_ex10_ramp_module_manager()->retrieve_adc_temperature());
+
+    enum Ex10TagTableUpdate const update = tag_table->update(
+        packet, inventory->params.antenna, rssi_cdbm, NULL);
+    return update == TagTableUpdateDuplicate;
 }
 
 static struct Ex10Result publish_packets(void)
 {
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
     bool inventory_done = false;
 
     struct Ex10EventFifoQueue const* event_fifo_queue =
@@ -585,21 +704,25 @@ static struct Ex10Result publish_packets(void)
                 inventory_done = true;
             }
 
-            if (inventory_state.packet_subscriber_callback != NULL)
+            bool const is_duplicate = inventory->state.tag_table_filter &&
+                                      tag_table_filter_packet(packet);
+
+            if (inventory->state.packet_subscriber_callback != NULL &&
+                is_duplicate == false)
             {
-                if (inventory_state.publish_all_packets ||
+                if (inventory->state.publish_all_packets ||
                     packet->packet_type == TagRead ||
                     packet->packet_type == ContinuousInventorySummary ||
                     packet->packet_type == Gen2Transaction)
                 {
-                    inventory_state.packet_subscriber_callback(packet,
-                                                               &ex10_result);
+                    inventory->state.packet_subscriber_callback(packet,
+                                                                &ex10_result);
                     // The inventory may be stopped by the client application,
                     // without creating an error condition.
                     if ((ex10_result.customer == true) ||
                         (ex10_result.result_code.raw != 0u))
                     {
-                        inventory_state.state = InvStopRequested;
+                        inventory->state.state = InvStopRequested;
                     }
                 }
             }
@@ -614,64 +737,66 @@ static struct Ex10Result publish_packets(void)
 static struct Ex10Result continuous_inventory(
     struct Ex10ContinuousInventoryUseCaseParameters* params)
 {
+    struct ContinuousInventoryContext* inventory = get_inventory_context();
+
     if (params == NULL || params->stop_conditions == NULL)
     {
         return make_ex10_sdk_error(Ex10ModuleUseCase, Ex10SdkErrorNullPointer);
     }
 
-    inventory_params.inventory_config.initial_q            = params->initial_q;
-    inventory_params.inventory_config.max_q                = 15;
-    inventory_params.inventory_config.min_q                = 0;
-    inventory_params.inventory_config.num_min_q_cycles     = 1;
-    inventory_params.inventory_config.fixed_q_mode         = false;
-    inventory_params.inventory_config.q_increase_use_query = false;
-    inventory_params.inventory_config.q_decrease_use_query = false;
-    inventory_params.inventory_config.session              = params->session;
-    inventory_params.inventory_config.select               = params->select;
-    inventory_params.inventory_config.target               = params->target;
-    inventory_params.inventory_config.halt_on_all_tags     = false;
-    inventory_params.inventory_config.tag_focus_enable     = false;
-    inventory_params.inventory_config.fast_id_enable       = false;
-    inventory_params.inventory_config.abort_on_fail =
-        inventory_state.abort_on_fail;
-    inventory_params.inventory_config.always_ack = false;
-    inventory_params.inventory_config.auto_access =
-        inventory_state.enable_auto_access;
-    inventory_params.inventory_config.halt_on_fail = false;
-    inventory_params.inventory_config.rfu          = 0;
-
-    inventory_params.inventory_config_2.max_queries_since_valid_epc = 16;
-    inventory_params.inventory_config_2
-        .starting_max_queries_since_valid_epc_count          = 0;
-    inventory_params.inventory_config_2.starting_min_q_count = 0;
-    inventory_params.inventory_config_2.Reserved0            = 0;
+    inventory->params.inventory_config.initial_q            = params->initial_q;
+    inventory->params.inventory_config.max_q                = 15;
+    inventory->params.inventory_config.min_q                = 0;
+    inventory->params.inventory_config.num_min_q_cycles     = 1;
+    inventory->params.inventory_config.fixed_q_mode         = false;
+    inventory->params.inventory_config.q_increase_use_query = false;
+    inventory->params.inventory_config.q_decrease_use_query = false;
+    inventory->params.inventory_config.session              = params->session;
+    inventory->params.inventory_config.select               = params->select;
+    inventory->params.inventory_config.target               = params->target;
+    inventory->params.inventory_config.halt_on_all_tags     = false;
+    inventory->params.inventory_config.tag_focus_enable     = false;
+    inventory->params.inventory_config.fast_id_enable       = false;
+    inventory->params.inventory_config.abort_on_fail =
+        inventory->state.abort_on_fail;
+    inventory->params.inventory_config.always_ack = false;
+    inventory->params.inventory_config.auto_access =
+        inventory->state.enable_auto_access;
+    inventory->params.inventory_config.halt_on_fail = false;
+    inventory->params.inventory_config.rfu          = 0;
+
+    inventory->params.inventory_config_2.max_queries_since_valid_epc = 16;
+    inventory->params.inventory_config_2
+        .starting_max_queries_since_valid_epc_count           = 0;
+    inventory->params.inventory_config_2.starting_min_q_count = 0;
+    inventory->params.inventory_config_2.Reserved0            = 0;
 
     // Marking that we are in continuous inventory mode and reset all
     // config parameters.
-    inventory_state.state       = InvOngoing;
-    inventory_state.stop_reason = SRNone;
-    inventory_state.round_count = 0u;
+    inventory->state.state       = InvOngoing;
+    inventory->state.stop_reason = SRNone;
+    inventory->state.round_count = 0u;
 
     // Save initial inventory_state values to reset Q on target flip.
-    inventory_state.initial_q                     = params->initial_q;
-    inventory_state.previous_q                    = 0u;
-    inventory_state.min_q_count                   = 0u;
-    inventory_state.queries_since_valid_epc_count = 0u;
-    inventory_state.done_reason                   = InventorySummaryNone;
-    inventory_state.tag_count                     = 0u;
-    inventory_state.target                        = params->target;
+    inventory->state.initial_q                     = params->initial_q;
+    inventory->state.previous_q                    = 0u;
+    inventory->state.min_q_count                   = 0u;
+    inventory->state.queries_since_valid_epc_count = 0u;
+    inventory->state.done_reason                   = InventorySummaryNone;
+    inventory->state.tag_count                     = 0u;
+    inventory->state.target                        = params->target;
 
     // Store passed in params
-    inventory_params.antenna       = params->antenna;
-    inventory_params.rf_mode       = params->rf_mode;
-    inventory_params.tx_power_cdbm = params->tx_power_cdbm;
-    inventory_params.send_selects  = params->send_selects;
-    inventory_dual_target          = params->dual_target;
+    inventory->params.antenna       = params->antenna;
+    inventory->params.rf_mode       = params->rf_mode;
+    inventory->params.tx_power_cdbm = params->tx_power_cdbm;
+    inventory->params.send_selects  = params->send_selects;
+    inventory->dual_target          = params->dual_target;
 
-    stop_conditions = *params->stop_conditions;
-    start_time_us   = get_ex10_ops()->get_device_time();
+    inventory->stop_conditions = *params->stop_conditions;
+    inventory->start_time_us   = get_ex10_ops()->get_device_time();
 
-    if (inventory_params.inventory_config.tag_focus_enable)
+    if (inventory->params.inventory_config.tag_focus_enable)
     {
         if (params->dual_target == true)
         {
@@ -684,15 +809,15 @@ static struct Ex10Result continuous_inventory(
 
     // Begin inventory
     struct Ex10Result const ex10_result = get_ex10_inventory()->start_inventory(
-        inventory_params.antenna,
-        inventory_params.rf_mode,
-        inventory_params.tx_power_cdbm,
-        &inventory_params.inventory_config,
-        &inventory_params.inventory_config_2,
-        inventory_params.send_selects);
+        inventory->params.antenna,
+        inventory->params.rf_mode,
+        inventory->params.tx_power_cdbm,
+        &inventory->params.inventory_config,
+        &inventory->params.inventory_config_2,
+        inventory->params.send_selects);
     if (ex10_result.error)
     {
-        inventory_state.state = InvIdle;
+        inventory->state.state = InvIdle;
         return ex10_result;
     }
 
@@ -709,6 +834,7 @@ static struct Ex10ContinuousInventoryUseCase ex10_continuous_inventory_use_case
     .enable_abort_on_fail                 = enable_abort_on_fail,
     .continuous_inventory                 = continuous_inventory,
     .get_continuous_inventory_stop_reason = get_continuous_inventory_stop_reason,
+    .enable_tag_table_filter              = enable_tag_table_filter,
 };
 // clang-format on
 
@@ -19,6 +19,7 @@
 #include "ex10_api/event_fifo_printer.h"
 #include "ex10_api/event_packet_parser.h"
 #include "ex10_api/ex10_active_region.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_event_fifo_queue.h"
 #include "ex10_api/ex10_inventory.h"
 #include "ex10_api/ex10_ops.h"
@@ -70,7 +71,12 @@ struct InventorySequenceState
                                        struct Ex10Result*);
 };
 
-static struct InventorySequenceState inventory_state;
+static struct InventorySequenceState sequence_contexts[EX10_MAX_CONTEXTS];
+
+static struct InventorySequenceState* get_sequence_context(void)
+{
+    return &sequence_contexts[ex10_context_index()];
+}
 
 /**
  * Do the ugly work of bounds and type checking and casting to convert the
@@ -86,20 +92,22 @@ static struct InventorySequenceState inventory_state;
 static struct InventoryRoundConfigBasic const* get_basic_inventory_round_config(
     size_t iteration)
 {
-    if (inventory_state.inventory_sequence->type_id !=
+    struct InventorySequenceState* inventory_state = get_sequence_context();
+
+    if (inventory_state->inventory_sequence->type_id !=
         INVENTORY_ROUND_CONFIG_BASIC)
     {
         return NULL;
     }
 
-    if (iteration >= inventory_state.inventory_sequence->count)
+    if (iteration >= inventory_state->inventory_sequence->count)
     {
         return NULL;
     }
 
     struct InventoryRoundConfigBasic const* inventory_basic_configs =
         (struct InventoryRoundConfigBasic const*)
-            inventory_state.inventory_sequence->configs;
+            inventory_state->inventory_sequence->configs;
 
     return &inventory_basic_configs[iteration];
 }
@@ -107,8 +115,10 @@ static struct InventoryRoundConfigBasic const* get_basic_inventory_round_config(
 static struct Ex10Result continue_inventory_sequence(
     struct InventoryRoundSummary const* round_summary)
 {
+    struct InventorySequenceState* inventory_state = get_sequence_context();
+
     struct InventoryRoundConfigBasic const* inventory_round =
-        get_basic_inventory_round_config(inventory_state.inventory_round_iter);
+        get_basic_inventory_round_config(inventory_state->inventory_round_iter);
 
     enum InventorySummaryReason const summary_reason =
         (enum InventorySummaryReason)round_summary->reason;
@@ -139,10 +149,10 @@ static struct Ex10Result continue_inventory_sequence(
     else if (summary_reason == InventorySummaryDone ||
              summary_reason == InventorySummaryHost)
     {
-        inventory_state.inventory_round_iter += 1u;
+        inventory_state->inventory_round_iter += 1u;
         struct InventoryRoundConfigBasic const* inventory_round_next =
             get_basic_inventory_round_config(
-                inventory_state.inventory_round_iter);
+                inventory_state->inventory_round_iter);
 
         if (inventory_round_next)
         {
@@ -227,14 +237,20 @@ static bool interrupt_handler(struct InterruptStatusFields irq_status)
 // interrupt.
 static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
 {
-    struct Ex10EventParser const* event_parser = get_ex10_event_parser();
-    struct ConstByteSpan          bytes        = fifo_buffer_node->fifo_data;
-    while (bytes.length > 0u)
+    // The packets are indexed once here; the index is kept in the node and
+    // reused by the EventFifo queue consumer.
+    struct Ex10EventParser const*  event_parser = get_ex10_event_parser();
+    struct EventPacketIndex const* packet_index =
+        get_ex10_event_fifo_queue()->get_packet_index(fifo_buffer_node);
+
+    for (size_t position = 0u; position < packet_index->packet_count;
+         ++position)
     {
-        struct EventFifoPacket const packet =
-            event_parser->parse_event_packet(&bytes);
-        if (packet.packet_type == InventoryRoundSummary)
+        if (packet_index->packet_types[position] == InventoryRoundSummary)
         {
+            struct EventFifoPacket const packet =
+                event_parser->get_indexed_packet(
+                    fifo_buffer_node->fifo_data.data, packet_index, position);
             struct InventoryRoundSummary const* round_summary =
                 &packet.static_data->inventory_round_summary;
 
@@ -273,7 +289,9 @@ static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
 
 static struct Ex10Result init(void)
 {
-    ex10_memzero(&inventory_state, sizeof(inventory_state));
+    struct InventorySequenceState* inventory_state = get_sequence_context();
+
+    ex10_memzero(inventory_state, sizeof(*inventory_state));
 
     get_ex10_event_fifo_queue()->init();
     get_ex10_gen2_tx_command_manager()->init();
@@ -319,27 +337,37 @@ static void register_packet_subscriber_callback(
     void (*packet_subscriber_callback)(struct EventFifoPacket const*,
                                        struct Ex10Result*))
 {
-    inventory_state.packet_subscriber_callback = packet_subscriber_callback;
+    struct InventorySequenceState* inventory_state = get_sequence_context();
+
+    inventory_state->packet_subscriber_callback = packet_subscriber_callback;
 }
 
 static void enable_packet_filter(bool enable_filter)
 {
-    inventory_state.publish_all_packets = (enable_filter == false);
+    struct InventorySequenceState* inventory_state = get_sequence_context();
+
+    inventory_state->publish_all_packets = (enable_filter == false);
 }
 
 static struct InventoryRoundSequence const* get_inventory_sequence(void)
 {
-    return inventory_state.inventory_sequence;
+    struct InventorySequenceState* inventory_state = get_sequence_context();
+
+    return inventory_state->inventory_sequence;
 }
 
 static struct InventoryRoundConfigBasic const* get_inventory_round(void)
 {
+    struct InventorySequenceState* inventory_state = get_sequence_context();
+
     return get_basic_inventory_round_config(
-        inventory_state.inventory_round_packet_publisher);
+        inventory_state->inventory_round_packet_publisher);
 }
 
 static struct Ex10Result publish_packets(void)
 {
+    struct InventorySequenceState* inventory_state = get_sequence_context();
+
     bool              inventory_done = false;
     struct Ex10Result ex10_result    = make_ex10_success();
 
@@ -362,14 +390,14 @@ static struct Ex10Result publish_packets(void)
                 get_ex10_event_fifo_printer()->print_packets(packet);
             }
 
-            if (inventory_state.packet_subscriber_callback != NULL)
+            if (inventory_state->packet_subscriber_callback != NULL)
             {
-                if (inventory_state.publish_all_packets ||
+                if (inventory_state->publish_all_packets ||
                     packet->packet_type == TagRead ||
                     packet->packet_type == InventoryRoundSummary)
                 {
-                    inventory_state.packet_subscriber_callback(packet,
-                                                               &ex10_result);
+                    inventory_state->packet_subscriber_callback(packet,
+                                                                &ex10_result);
                     // The inventory may be stopped by the client application,
                     // without creating an error condition.
                     if ((ex10_result.customer == true) ||
@@ -392,9 +420,9 @@ static struct Ex10Result publish_packets(void)
                 if (reason == InventorySummaryDone ||
                     reason == InventorySummaryHost)
                 {
-                    inventory_state.inventory_round_packet_publisher += 1u;
-                    if (inventory_state.inventory_round_packet_publisher >=
-                        inventory_state.inventory_sequence->count)
+                    inventory_state->inventory_round_packet_publisher += 1u;
+                    if (inventory_state->inventory_round_packet_publisher >=
+                        inventory_state->inventory_sequence->count)
                     {
                         inventory_done = true;
                     }
@@ -410,6 +438,8 @@ static struct Ex10Result publish_packets(void)
 static struct Ex10Result run_inventory_sequence(
     struct InventoryRoundSequence const* inventory_sequence)
 {
+    struct InventorySequenceState* inventory_state = get_sequence_context();
+
     if (inventory_sequence == NULL || inventory_sequence->configs == NULL)
     {
         return make_ex10_sdk_error(Ex10ModuleUseCase, Ex10SdkErrorNullPointer);
@@ -423,12 +453,12 @@ static struct Ex10Result run_inventory_sequence(
 
     struct Ex10Protocol const* ex10_protocol = get_ex10_protocol();
 
-    inventory_state.inventory_sequence               = inventory_sequence;
-    inventory_state.inventory_round_iter             = 0u;
-    inventory_state.inventory_round_packet_publisher = 0u;
+    inventory_state->inventory_sequence               = inventory_sequence;
+    inventory_state->inventory_round_iter             = 0u;
+    inventory_state->inventory_round_packet_publisher = 0u;
 
     struct InventoryRoundConfigBasic const* inventory_round =
-        get_basic_inventory_round_config(inventory_state.inventory_round_iter);
+        get_basic_inventory_round_config(inventory_state->inventory_round_iter);
 
     if (inventory_round == NULL)
     {
@@ -11,7 +11,10 @@
  *                                                                           *
  *****************************************************************************/
 
+#include <string.h>
+
 #include "board/ex10_osal.h"
+#include "board/time_helpers.h"
 
 #include "ex10_api/application_registers.h"
 #include "ex10_api/byte_span.h"
@@ -19,12 +22,14 @@
 #include "ex10_api/event_fifo_printer.h"
 #include "ex10_api/event_packet_parser.h"
 #include "ex10_api/ex10_active_region.h"
+#include "ex10_api/ex10_context.h"
 #include "ex10_api/ex10_event_fifo_queue.h"
 #include "ex10_api/ex10_inventory.h"
 #include "ex10_api/ex10_ops.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_rf_power.h"
 #include "ex10_api/fifo_buffer_list.h"
+#include "ex10_api/gen2_commands.h"
 #include "ex10_api/gen2_tx_command_manager.h"
 
 #include "ex10_modules/ex10_ramp_module_manager.h"
@@ -75,13 +80,62 @@ struct TagAccessState
 };
 
 /**
- * Ex10TagAccessUseCase private state variables.
+ * Ex10TagAccessUseCase private state variables, one set per Impinj Reader
+ * Chip context.
  * These are initialized in the init() so that if
  * it is called multiple times, it will return to the
  * same starting condition.
  */
-static struct InventoryParams inventory_params;
-static struct TagAccessState  tag_access_state;
+struct TagAccessContext
+{
+    struct InventoryParams params;
+    struct TagAccessState  state;
+};
+
+static struct TagAccessContext tag_access_contexts[EX10_MAX_CONTEXTS];
+
+static struct TagAccessContext* get_tag_access_context(void)
+{
+    return &tag_access_contexts[ex10_context_index()];
+}
+
+/// A job which has not received its replies after this many halts on its
+/// tag is finished with TagAccessJobFailed.
+static uint8_t const max_job_attempts = 3u;
+
+/// The time to wait for each EventFifo packet while halted on a tag.
+static uint32_t const halted_packet_timeout_us = 100u * 1000u;
+
+/**
+ * @struct TagAccessJobSlot
+ * A queued tag access job and its result.
+ */
+struct TagAccessJobSlot
+{
+    struct Ex10TagAccessJob       job;
+    struct Ex10TagAccessJobResult result;
+};
+
+/**
+ * @struct TagAccessJobQueue
+ * The queued jobs, in the order they were submitted. Finished jobs remain
+ * in the queue until their completion callbacks are called, so that the
+ * callbacks are not run while the LMAC is halted on a tag.
+ */
+struct TagAccessJobQueue
+{
+    struct TagAccessJobSlot slots[EX10_TAG_ACCESS_MAX_JOBS];
+    size_t                  job_count;
+    size_t                  pending_count;
+    uint32_t                next_job_id;
+};
+
+static struct TagAccessJobQueue job_queue_contexts[EX10_MAX_CONTEXTS];
+
+static struct TagAccessJobQueue* get_job_queue_context(void)
+{
+    return &job_queue_contexts[ex10_context_index()];
+}
 
 /**
  * In this use case no interrupts are handled apart from processing EventFifo
@@ -105,22 +159,35 @@ static bool interrupt_handler(struct InterruptStatusFields irq_status)
 // though the event fifo queue.
 static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
 {
-    struct ConstByteSpan bytes = fifo_buffer_node->fifo_data;
-    while (bytes.length > 0u)
+    struct TagAccessContext* tag_access = get_tag_access_context();
+
+    // The packets are indexed once here; the index is kept in the node and
+    // reused by the EventFifo queue consumer.
+    struct Ex10EventParser const*  event_parser = get_ex10_event_parser();
+    struct EventPacketIndex const* packet_index =
+        get_ex10_event_fifo_queue()->get_packet_index(fifo_buffer_node);
+
+    for (size_t position = 0u; position < packet_index->packet_count;
+         ++position)
     {
-        struct Ex10EventParser const* event_parser = get_ex10_event_parser();
-        struct EventFifoPacket const  packet =
-            event_parser->parse_event_packet(&bytes);
-        if (event_parser->get_packet_type_valid(packet.packet_type) == false)
+        uint8_t const packet_type = packet_index->packet_types[position];
+        if (packet_type == InvalidPacket)
         {
             // Invalid packets cannot be processed and will only confuse the
             // tag access state machine. Discontinue processing.
             ex10_eprintf(
                 "Invalid packet encountered during the tag access use case "
-                "packet parsing, packet end pos: %zu\n",
-                bytes.length);
+                "packet parsing, packet offset: %u\n",
+                packet_index->packet_offsets[position]);
             break;
         }
+        if ((packet_type != InventoryRoundSummary) && (packet_type != TagRead))
+        {
+            continue;
+        }
+
+        struct EventFifoPacket const packet = event_parser->get_indexed_packet(
+            fifo_buffer_node->fifo_data.data, packet_index, position);
         if (packet.packet_type == InventoryRoundSummary)
         {
             const uint8_t reason =
@@ -132,21 +199,21 @@ static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
                     &(packet.static_data->inventory_round_summary);
 
                 struct InventoryRoundControlFields config =
-                    inventory_params.inventory_config;
+                    tag_access->params.inventory_config;
                 struct InventoryRoundControl_2Fields config_2 =
-                    inventory_params.inventory_config_2;
+                    tag_access->params.inventory_config_2;
                 config.initial_q              = round_summary->final_q;
                 config_2.starting_min_q_count = round_summary->min_q_count;
                 config_2.starting_max_queries_since_valid_epc_count =
                     round_summary->queries_since_valid_epc_count;
                 struct Ex10Result ex10_result =
                     get_ex10_inventory()->start_inventory(
-                        inventory_params.antenna,
-                        inventory_params.rf_mode,
-                        inventory_params.tx_power_cdbm,
+                        tag_access->params.antenna,
+                        tag_access->params.rf_mode,
+                        tag_access->params.tx_power_cdbm,
                         &config,
                         &config_2,
-                        inventory_params.send_selects);
+                        tag_access->params.send_selects);
                 if (ex10_result.error)
                 {
                     struct FifoBufferNode* result_buffer_node =
@@ -168,23 +235,23 @@ static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
                             result_buffer_node);
                     }
 
-                    tag_access_state.state = InventoryIdle;
+                    tag_access->state.state = InventoryIdle;
                 }
             }
 
-            if (tag_access_state.state == InventoryHalted)
+            if (tag_access->state.state == InventoryHalted)
             {
                 // if we were halted on a tag we must have lost the
                 // tag should only happen when we ramp down for regulatory
                 // but just in case we get a summary
-                tag_access_state.state = InventoryTagLostRegulatory;
+                tag_access->state.state = InventoryTagLostRegulatory;
             }
         }
         else if (packet.packet_type == TagRead &&
                  packet.static_data->tag_read.halted_on_tag)
         {
             // got a TagRead with a successful halt
-            tag_access_state.state = InventoryHalted;
+            tag_access->state.state = InventoryHalted;
         }
     }
 
@@ -196,9 +263,13 @@ static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
 
 static struct Ex10Result init(void)
 {
-    ex10_memzero(&tag_access_state, sizeof(tag_access_state));
-    ex10_memzero(&inventory_params, sizeof(inventory_params));
-    tag_access_state.state = InventoryIdle;
+    struct TagAccessContext*  tag_access = get_tag_access_context();
+    struct TagAccessJobQueue* job_queue  = get_job_queue_context();
+
+    ex10_memzero(&tag_access->state, sizeof(tag_access->state));
+    ex10_memzero(&tag_access->params, sizeof(tag_access->params));
+    ex10_memzero(job_queue, sizeof(*job_queue));
+    tag_access->state.state = InventoryIdle;
 
     get_ex10_event_fifo_queue()->init();
     get_ex10_gen2_tx_command_manager()->init();
@@ -244,7 +315,9 @@ static void register_halted_callback(
                                 enum HaltedCallbackResult*,
                                 struct Ex10Result*))
 {
-    tag_access_state.tag_halted_callback = tag_halted_callback;
+    struct TagAccessContext* tag_access = get_tag_access_context();
+
+    tag_access->state.tag_halted_callback = tag_halted_callback;
 }
 
 // This publish packets function is the function on the main thread that
@@ -253,6 +326,8 @@ static void register_halted_callback(
 // the other relevant packets to determine when the inventory round is complete
 static struct Ex10Result publish_packets(void)
 {
+    struct TagAccessContext* tag_access = get_tag_access_context();
+
     bool inventory_done = false;
 
     struct Ex10EventFifoQueue const* event_fifo_queue =
@@ -299,14 +374,14 @@ static struct Ex10Result publish_packets(void)
             if (packet->packet_type == TagRead)
             {
                 // Its a tag read, we need to call the callback
-                if (tag_access_state.tag_halted_callback != NULL)
+                if (tag_access->state.tag_halted_callback != NULL)
                 {
                     // grab the halted on tag state because the callback will
                     // discard the packet so that it can read the next packets
                     const bool halted_on_tag =
                         packet->static_data->tag_read.halted_on_tag;
                     enum HaltedCallbackResult cb_result;
-                    tag_access_state.tag_halted_callback(
+                    tag_access->state.tag_halted_callback(
                         packet, &cb_result, &ex10_result);
                     if (ex10_result.error)
                     {
@@ -315,7 +390,7 @@ static struct Ex10Result publish_packets(void)
                     const bool nak_tag = (cb_result == NakTagAndContinue);
 
                     if (halted_on_tag &&
-                        tag_access_state.state != InventoryTagLostRegulatory)
+                        tag_access->state.state != InventoryTagLostRegulatory)
                     {
                         // looks like we are still halted on the tag so we
                         // continue the inventory round
@@ -349,51 +424,53 @@ static struct Ex10Result publish_packets(void)
 static struct Ex10Result run_inventory(
     struct Ex10TagAccessUseCaseParameters* params)
 {
-    inventory_params.inventory_config.initial_q            = params->initial_q;
-    inventory_params.inventory_config.max_q                = 15;
-    inventory_params.inventory_config.min_q                = 0;
-    inventory_params.inventory_config.num_min_q_cycles     = 1;
-    inventory_params.inventory_config.fixed_q_mode         = false;
-    inventory_params.inventory_config.q_increase_use_query = false;
-    inventory_params.inventory_config.q_decrease_use_query = false;
-    inventory_params.inventory_config.session              = params->session;
-    inventory_params.inventory_config.select               = params->select;
-    inventory_params.inventory_config.target               = params->target;
-    inventory_params.inventory_config.halt_on_all_tags     = true;
-    inventory_params.inventory_config.tag_focus_enable     = false;
-    inventory_params.inventory_config.fast_id_enable       = false;
-    inventory_params.inventory_config.abort_on_fail        = false;
-    inventory_params.inventory_config.always_ack           = false;
-    inventory_params.inventory_config.auto_access          = false;
-    inventory_params.inventory_config.halt_on_fail         = false;
-    inventory_params.inventory_config.rfu                  = 0;
-
-    inventory_params.inventory_config_2.max_queries_since_valid_epc = 16;
-    inventory_params.inventory_config_2
-        .starting_max_queries_since_valid_epc_count          = 0;
-    inventory_params.inventory_config_2.starting_min_q_count = 0;
-    inventory_params.inventory_config_2.Reserved0            = 0;
+    struct TagAccessContext* tag_access = get_tag_access_context();
+
+    tag_access->params.inventory_config.initial_q        = params->initial_q;
+    tag_access->params.inventory_config.max_q            = 15;
+    tag_access->params.inventory_config.min_q            = 0;
+    tag_access->params.inventory_config.num_min_q_cycles = 1;
+    tag_access->params.inventory_config.fixed_q_mode     = false;
+    tag_access->params.inventory_config.q_increase_use_query = false;
+    tag_access->params.inventory_config.q_decrease_use_query = false;
+    tag_access->params.inventory_config.session              = params->session;
+    tag_access->params.inventory_config.select               = params->select;
+    tag_access->params.inventory_config.target               = params->target;
+    tag_access->params.inventory_config.halt_on_all_tags     = true;
+    tag_access->params.inventory_config.tag_focus_enable     = false;
+    tag_access->params.inventory_config.fast_id_enable       = false;
+    tag_access->params.inventory_config.abort_on_fail        = false;
+    tag_access->params.inventory_config.always_ack           = false;
+    tag_access->params.inventory_config.auto_access          = false;
+    tag_access->params.inventory_config.halt_on_fail         = false;
+    tag_access->params.inventory_config.rfu                  = 0;
+
+    tag_access->params.inventory_config_2.max_queries_since_valid_epc = 16;
+    tag_access->params.inventory_config_2
+        .starting_max_queries_since_valid_epc_count            = 0;
+    tag_access->params.inventory_config_2.starting_min_q_count = 0;
+    tag_access->params.inventory_config_2.Reserved0            = 0;
 
     // Marking that we are in tag access inventory mode and reset all
     // config parameters.
-    tag_access_state.state = InventoryOngoing;
+    tag_access->state.state = InventoryOngoing;
 
     // Save initial tag_access_state values to reset Q on target flip.
     // Note: InventorySummaryReason enum value zero is not enumerated, and
     // is used to initialize done_reason = 0; i.e. "not done".
-    tag_access_state.initial_q                     = params->initial_q;
-    tag_access_state.previous_q                    = 0u;
-    tag_access_state.min_q_count                   = 0u;
-    tag_access_state.queries_since_valid_epc_count = 0u;
+    tag_access->state.initial_q                     = params->initial_q;
+    tag_access->state.previous_q                    = 0u;
+    tag_access->state.min_q_count                   = 0u;
+    tag_access->state.queries_since_valid_epc_count = 0u;
 
     // Store passed in params
-    inventory_params.antenna       = params->antenna;
-    inventory_params.rf_mode       = params->rf_mode;
-    inventory_params.tx_power_cdbm = params->tx_power_cdbm;
-    inventory_params.send_selects  = params->send_selects;
+    tag_access->params.antenna       = params->antenna;
+    tag_access->params.rf_mode       = params->rf_mode;
+    tag_access->params.tx_power_cdbm = params->tx_power_cdbm;
+    tag_access->params.send_selects  = params->send_selects;
 
     struct Ex10Result ex10_result =
-        get_ex10_rf_power()->set_rf_mode(inventory_params.rf_mode);
+        get_ex10_rf_power()->set_rf_mode(tag_access->params.rf_mode);
     if (ex10_result.error)
     {
         return ex10_result;
@@ -401,15 +478,15 @@ static struct Ex10Result run_inventory(
 
     // Begin inventory
     ex10_result = get_ex10_inventory()->start_inventory(
-        inventory_params.antenna,
-        inventory_params.rf_mode,
-        inventory_params.tx_power_cdbm,
-        &inventory_params.inventory_config,
-        &inventory_params.inventory_config_2,
-        inventory_params.send_selects);
+        tag_access->params.antenna,
+        tag_access->params.rf_mode,
+        tag_access->params.tx_power_cdbm,
+        &tag_access->params.inventory_config,
+        &tag_access->params.inventory_config_2,
+        tag_access->params.send_selects);
     if (ex10_result.error)
     {
-        tag_access_state.state = InventoryIdle;
+        tag_access->state.state = InventoryIdle;
         return ex10_result;
     }
 
@@ -418,8 +495,10 @@ static struct Ex10Result run_inventory(
 
 static enum TagAccessResult execute_access_commands(void)
 {
+    struct TagAccessContext* tag_access = get_tag_access_context();
+
     enum TagAccessResult result = TagAccessSuccess;
-    if (tag_access_state.state == InventoryHalted)
+    if (tag_access->state.state == InventoryHalted)
     {
         /* Trigger stored Gen2 sequence */
         struct Ex10Result ex10_result =
@@ -444,10 +523,39 @@ static enum TagAccessResult execute_access_commands(void)
 
 static struct EventFifoPacket const* get_fifo_packet(void)
 {
-    struct EventFifoPacket const* packet = NULL;
+    struct Ex10EventFifoQueue const* event_fifo_queue =
+        get_ex10_event_fifo_queue();
+
+    struct EventFifoPacket const* packet = event_fifo_queue->packet_peek();
     while (packet == NULL)
     {
-        packet = get_ex10_event_fifo_queue()->packet_peek();
+        // Block until the IRQ_N monitor thread queues packets; the wait may
+        // also be ended by packet_unwait() with the queue still empty.
+        event_fifo_queue->packet_wait();
+        packet = event_fifo_queue->packet_peek();
+    }
+    return packet;
+}
+
+static struct EventFifoPacket const* get_fifo_packet_with_timeout(
+    uint32_t timeout_us)
+{
+    struct Ex10EventFifoQueue const* event_fifo_queue =
+        get_ex10_event_fifo_queue();
+    struct Ex10TimeHelpers const*    time_helpers = get_ex10_time_helpers();
+
+    uint64_t const                start_us = time_helpers->time_now_us();
+    struct EventFifoPacket const* packet   = event_fifo_queue->packet_peek();
+    while (packet == NULL)
+    {
+        uint64_t const elapsed_us = time_helpers->time_now_us() - start_us;
+        if (elapsed_us >= timeout_us)
+        {
+            return NULL;
+        }
+        event_fifo_queue->packet_wait_with_timeout(
+            timeout_us - (uint32_t)elapsed_us);
+        packet = event_fifo_queue->packet_peek();
     }
     return packet;
 }
@@ -472,15 +580,462 @@ static bool remove_halted_packet(void)
     return is_halted_packet;
 }
 
+/**
+ * Remove the Halted packet at the front of the queue.
+ *
+ * @return bool true if a Halted packet was removed. Any other packet is left
+ *              in the queue for publish_packets().
+ */
+static bool remove_halted_packet_with_timeout(void)
+{
+    struct EventFifoPacket const* packet =
+        get_fifo_packet_with_timeout(halted_packet_timeout_us);
+    if (packet == NULL || packet->packet_type != Halted)
+    {
+        return false;
+    }
+    remove_fifo_packet();
+    return true;
+}
+
+static struct Ex10Result submit_job(struct Ex10TagAccessJob const* job,
+                                    uint32_t*                      job_id)
+{
+    struct TagAccessJobQueue* job_queue = get_job_queue_context();
+
+    if (job == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUseCase, Ex10SdkErrorNullPointer);
+    }
+    if (job->epc_length == 0u || job->epc_length > EPC_BUFFER_BYTE_LENGTH)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUseCase,
+                                   Ex10SdkErrorBadParamLength);
+    }
+
+    switch (job->command)
+    {
+        case Gen2Read:
+            if (job->args.read.word_count == 0u ||
+                job->args.read.word_count > EX10_TAG_ACCESS_JOB_MAX_READ_WORDS)
+            {
+                return make_ex10_sdk_error(Ex10ModuleUseCase,
+                                           Ex10SdkErrorBadParamValue);
+            }
+            break;
+        case Gen2Write:
+        case Gen2Lock:
+            break;
+        case Gen2BlockWrite:
+            if (job->args.block_write.data == NULL)
+            {
+                return make_ex10_sdk_error(Ex10ModuleUseCase,
+                                           Ex10SdkErrorNullPointer);
+            }
+            break;
+        default:
+            return make_ex10_sdk_error(Ex10ModuleUseCase,
+                                       Ex10SdkErrorBadParamValue);
+    }
+
+    if (job_queue->job_count == EX10_TAG_ACCESS_MAX_JOBS)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUseCase,
+                                   Ex10SdkErrorInvalidState);
+    }
+
+    struct TagAccessJobSlot* slot = &job_queue->slots[job_queue->job_count];
+    ex10_memzero(slot, sizeof(*slot));
+    slot->job           = *job;
+    slot->result.job_id = job_queue->next_job_id;
+    slot->result.status = TagAccessJobPending;
+
+    if (job_id != NULL)
+    {
+        *job_id = job_queue->next_job_id;
+    }
+    job_queue->next_job_id += 1u;
+    job_queue->job_count += 1u;
+    job_queue->pending_count += 1u;
+
+    return make_ex10_success();
+}
+
+static size_t pending_job_count(void)
+{
+    struct TagAccessJobQueue* job_queue = get_job_queue_context();
+
+    return job_queue->pending_count;
+}
+
+/**
+ * Remove the finished jobs from the queue and call their completion
+ * callbacks. The callbacks may submit further jobs.
+ */
+static void report_finished_jobs(void)
+{
+    struct TagAccessJobQueue* job_queue = get_job_queue_context();
+
+    size_t index = 0u;
+    while (index < job_queue->job_count)
+    {
+        if (job_queue->slots[index].result.status == TagAccessJobPending)
+        {
+            index += 1u;
+            continue;
+        }
+
+        struct TagAccessJobSlot finished = job_queue->slots[index];
+        job_queue->job_count -= 1u;
+        memmove(&job_queue->slots[index],
+                &job_queue->slots[index + 1u],
+                (job_queue->job_count - index) * sizeof(job_queue->slots[0]));
+
+        finished.result.reply.data = finished.result.reply_words;
+        if (finished.job.completion_callback != NULL)
+        {
+            finished.job.completion_callback(&finished.job, &finished.result);
+        }
+    }
+}
+
+static void cancel_jobs(void)
+{
+    struct TagAccessJobQueue* job_queue = get_job_queue_context();
+
+    for (size_t index = 0u; index < job_queue->job_count; ++index)
+    {
+        struct Ex10TagAccessJobResult* result = &job_queue->slots[index].result;
+        if (result->status == TagAccessJobPending)
+        {
+            result->status = TagAccessJobCancelled;
+        }
+    }
+    job_queue->pending_count = 0u;
+    report_finished_jobs();
+}
+
+static void finish_job(struct TagAccessJobSlot*      slot,
+                       enum TagAccessJobStatus const status)
+{
+    struct TagAccessJobQueue* job_queue = get_job_queue_context();
+
+    slot->result.status = status;
+    job_queue->pending_count -= 1u;
+}
+
+/**
+ * Find the pending jobs whose EPC matches that of a TagRead packet.
+ *
+ * @param packet             The TagRead packet.
+ * @param [out] slot_indices The indices of the matching job slots, in
+ *                           submission order.
+ *
+ * @return size_t The number of matching jobs.
+ */
+static size_t match_jobs(struct EventFifoPacket const* packet,
+                         size_t*                       slot_indices)
+{
+    struct TagAccessJobQueue* job_queue = get_job_queue_context();
+
+    struct TagRead const*      tag_read = &packet->static_data->tag_read;
+    struct TagReadFields const fields =
+        get_ex10_event_parser()->get_tag_read_fields(
+            packet->dynamic_data,
+            packet->dynamic_data_length,
+            (enum TagReadType)tag_read->type,
+            tag_read->tid_offset);
+    if (fields.epc == NULL)
+    {
+        return 0u;
+    }
+
+    size_t match_count = 0u;
+    for (size_t index = 0u; index < job_queue->job_count; ++index)
+    {
+        struct TagAccessJobSlot const* slot = &job_queue->slots[index];
+        if (slot->result.status == TagAccessJobPending &&
+            slot->job.epc_length == fields.epc_length &&
+            memcmp(slot->job.epc, fields.epc, fields.epc_length) == 0)
+        {
+            slot_indices[match_count] = index;
+            match_count += 1u;
+        }
+    }
+    return match_count;
+}
+
+/**
+ * @struct HaltedCommand
+ * A command of the Gen2 halted sequence and the job it belongs to.
+ */
+struct HaltedCommand
+{
+    size_t           slot_index;
+    enum Gen2Command command;
+};
+
+/**
+ * Append the commands of a job to the local Gen2 sequence.
+ *
+ * @return bool false if the sequence is too full to hold the job commands,
+ *              or a command could not be encoded; ex10_result is set in the
+ *              latter case.
+ */
+static bool append_job_commands(size_t                slot_index,
+                                struct HaltedCommand* commands,
+                                size_t*               command_count,
+                                bool*                 halted_enables,
+                                struct Ex10Result*    ex10_result)
+{
+    struct TagAccessJobQueue* job_queue = get_job_queue_context();
+
+    struct TagAccessJobSlot* slot = &job_queue->slots[slot_index];
+    size_t const job_command_count =
+        (slot->job.access_password != 0u) ? 3u : 1u;
+    if (*command_count + job_command_count > MaxTxCommandCount)
+    {
+        return false;
+    }
+
+    // The password is sent most significant word first.
+    struct AccessCommandArgs access_args[2u] = {
+        {.password = (uint16_t)(slot->job.access_password >> 16u)},
+        {.password = (uint16_t)(slot->job.access_password & 0xFFFFu)},
+    };
+    struct Gen2CommandSpec command_specs[3u] = {
+        {.command = Gen2Access, .args = &access_args[0u]},
+        {.command = Gen2Access, .args = &access_args[1u]},
+        {.command = slot->job.command, .args = &slot->job.args},
+    };
+
+    struct Ex10Gen2TxCommandManager const* g2tcm =
+        get_ex10_gen2_tx_command_manager();
+    for (size_t spec = 3u - job_command_count; spec < 3u; ++spec)
+    {
+        size_t cmd_index = 0u;
+        *ex10_result     = g2tcm->encode_and_append_command(
+            &command_specs[spec], (uint8_t)slot->result.job_id, &cmd_index);
+        if (ex10_result->error)
+        {
+            return false;
+        }
+        halted_enables[cmd_index]           = true;
+        commands[*command_count].slot_index = slot_index;
+        commands[*command_count].command    = command_specs[spec].command;
+        *command_count += 1u;
+    }
+    return true;
+}
+
+/**
+ * Decode a Gen2Transaction reply of a job command into the job result.
+ *
+ * @return bool true if this is the last reply of the job to be considered:
+ *              the reply to the job command, a Gen2Access reply reporting
+ *              an error, or a reply too long to decode.
+ */
+static bool decode_job_reply(struct TagAccessJobSlot*      slot,
+                             enum Gen2Command              command,
+                             struct EventFifoPacket const* packet)
+{
+    uint16_t const num_bits = packet->static_data->gen2_transaction.num_bits;
+    if ((num_bits + 15u) / 16u > EX10_TAG_ACCESS_JOB_REPLY_WORDS)
+    {
+        finish_job(slot, TagAccessJobFailed);
+        return true;
+    }
+
+    slot->result.reply.data = slot->result.reply_words;
+    bool const decoded = get_ex10_gen2_commands()->decode_reply(
+        command, packet, &slot->result.reply);
+    if (decoded)
+    {
+        if (command == Gen2Access)
+        {
+            return false;
+        }
+        finish_job(slot, TagAccessJobComplete);
+    }
+    else if (slot->result.reply.transaction_status ==
+                 Gen2TransactionStatusOk &&
+             slot->result.reply.error_code != NoError)
+    {
+        finish_job(slot, TagAccessJobTagError);
+    }
+    else
+    {
+        finish_job(slot, TagAccessJobFailed);
+    }
+    return true;
+}
+
+/**
+ * The halted callback used by run_jobs(). The jobs queued for the tag are
+ * sent as one Gen2 halted sequence; the tag is NAKed if any of its jobs
+ * remain pending so that it may be singulated again.
+ */
+static void run_halted_jobs(struct EventFifoPacket const* packet,
+                            enum HaltedCallbackResult*    cb_result,
+                            struct Ex10Result*            ex10_result)
+{
+    struct TagAccessJobQueue* job_queue = get_job_queue_context();
+
+    *ex10_result = make_ex10_success();
+    *cb_result   = AckTagAndContinue;
+
+    size_t       slot_indices[EX10_TAG_ACCESS_MAX_JOBS];
+    size_t const match_count   = match_jobs(packet, slot_indices);
+    bool const   halted_on_tag = packet->static_data->tag_read.halted_on_tag;
+    remove_fifo_packet();
+
+    // When the LMAC did not halt, it has already continued the round.
+    if (halted_on_tag == false || remove_halted_packet_with_timeout() == false)
+    {
+        return;
+    }
+    if (match_count == 0u)
+    {
+        return;
+    }
+
+    struct Ex10Gen2TxCommandManager const* g2tcm =
+        get_ex10_gen2_tx_command_manager();
+    g2tcm->clear_local_sequence();
+
+    struct HaltedCommand commands[MaxTxCommandCount];
+    size_t               command_count                     = 0u;
+    bool                 halted_enables[MaxTxCommandCount] = {false};
+    for (size_t match = 0u; match < match_count; ++match)
+    {
+        if (append_job_commands(slot_indices[match],
+                                commands,
+                                &command_count,
+                                halted_enables,
+                                ex10_result) == false)
+        {
+            if (ex10_result->error)
+            {
+                *cb_result = NakTagAndContinue;
+                return;
+            }
+            // The remaining jobs run the next time the tag is halted on.
+            *cb_result = NakTagAndContinue;
+            break;
+        }
+        job_queue->slots[slot_indices[match]].result.attempts += 1u;
+    }
+
+    *ex10_result = g2tcm->write_sequence();
+    if (ex10_result->error == false)
+    {
+        size_t cmd_index = 0u;
+        *ex10_result     = g2tcm->write_halted_enables(
+            halted_enables, MaxTxCommandCount, &cmd_index);
+    }
+    if (ex10_result->error)
+    {
+        *cb_result = NakTagAndContinue;
+        return;
+    }
+
+    size_t reply_count = 0u;
+    if (execute_access_commands() == TagAccessSuccess)
+    {
+        // Consider replies until the first reply which ends each job.
+        size_t finished_slot = EX10_TAG_ACCESS_MAX_JOBS;
+        for (; reply_count < command_count; ++reply_count)
+        {
+            struct EventFifoPacket const* reply_packet =
+                get_fifo_packet_with_timeout(halted_packet_timeout_us);
+            if (reply_packet == NULL ||
+                reply_packet->packet_type != Gen2Transaction)
+            {
+                // The tag was lost; the packet is left for publish_packets().
+                break;
+            }
+
+            struct HaltedCommand const* command = &commands[reply_count];
+            if (command->slot_index != finished_slot &&
+                decode_job_reply(&job_queue->slots[command->slot_index],
+                                 command->command,
+                                 reply_packet))
+            {
+                finished_slot = command->slot_index;
+            }
+            remove_fifo_packet();
+        }
+    }
+
+    // Jobs whose replies were not all received are retried.
+    for (size_t match = 0u; match < match_count; ++match)
+    {
+        struct TagAccessJobSlot* slot = &job_queue->slots[slot_indices[match]];
+        if (slot->result.status == TagAccessJobPending)
+        {
+            *cb_result = NakTagAndContinue;
+            if (slot->result.attempts >= max_job_attempts)
+            {
+                finish_job(slot, TagAccessJobFailed);
+            }
+        }
+    }
+
+    // The LMAC returns to the halted state when the sequence is done.
+    if (reply_count == command_count &&
+        remove_halted_packet_with_timeout() == false)
+    {
+        *cb_result = NakTagAndContinue;
+    }
+}
+
+static struct Ex10Result run_jobs(struct Ex10TagAccessUseCaseParameters* params,
+                                  uint32_t timeout_ms)
+{
+    struct TagAccessContext*  tag_access = get_tag_access_context();
+    struct TagAccessJobQueue* job_queue  = get_job_queue_context();
+
+    struct Ex10TimeHelpers const* time_helpers = get_ex10_time_helpers();
+    uint32_t const                start_time   = time_helpers->time_now();
+
+    void (*const tag_halted_callback)(struct EventFifoPacket const*,
+                                      enum HaltedCallbackResult*,
+                                      struct Ex10Result*) =
+        tag_access->state.tag_halted_callback;
+    tag_access->state.tag_halted_callback = run_halted_jobs;
+
+    struct Ex10Result ex10_result = make_ex10_success();
+    while (job_queue->pending_count > 0u && ex10_result.error == false &&
+           time_helpers->time_elapsed(start_time) < timeout_ms)
+    {
+        ex10_result = run_inventory(params);
+
+        struct Ex10Result const ex10_ramp_down =
+            get_ex10_rf_power()->stop_op_and_ramp_down();
+        ex10_result = ex10_result.error ? ex10_result : ex10_ramp_down;
+
+        // The completion callbacks run between rounds, not while halted.
+        report_finished_jobs();
+    }
+
+    tag_access->state.tag_halted_callback = tag_halted_callback;
+    return ex10_result;
+}
+
 static struct Ex10TagAccessUseCase ex10_tag_access_use_case = {
-    .init                     = init,
-    .deinit                   = deinit,
-    .register_halted_callback = register_halted_callback,
-    .run_inventory            = run_inventory,
-    .execute_access_commands  = execute_access_commands,
-    .get_fifo_packet          = get_fifo_packet,
-    .remove_fifo_packet       = remove_fifo_packet,
-    .remove_halted_packet     = remove_halted_packet,
+    .init                         = init,
+    .deinit                       = deinit,
+    .register_halted_callback     = register_halted_callback,
+    .run_inventory                = run_inventory,
+    .execute_access_commands      = execute_access_commands,
+    .get_fifo_packet              = get_fifo_packet,
+    .remove_fifo_packet           = remove_fifo_packet,
+    .remove_halted_packet         = remove_halted_packet,
+    .get_fifo_packet_with_timeout = get_fifo_packet_with_timeout,
+    .submit_job                   = submit_job,
+    .pending_job_count            = pending_job_count,
+    .cancel_jobs                  = cancel_jobs,
+    .run_jobs                     = run_jobs,
 };
 
 struct Ex10TagAccessUseCase const* get_ex10_tag_access_use_case(void)
@@ -264,24 +264,28 @@ void ex10_eprint_command_line_values(
     for (size_t index = 0u; index < arguments_size; ++index)
     {
         struct Ex10CommandLineArgument const* node    = &arguments[index];
-        int                                   n_write = 0;
+        size_t                                n_write = 0u;
         for (size_t spec_index = 0u; spec_index < node->specifiers_size;
              ++spec_index)
         {
             char const* specifier = node->specifiers[spec_index];
             if (specifier && *specifier)
             {
+                // The print functions return 0 when logging asynchronously,
+                // so the written length is counted here.
                 if (spec_index > 0u)
                 {
-                    n_write += ex10_ex_eputs(", ");
+                    ex10_ex_eputs(", ");
+                    n_write += 2u;
                 }
-                n_write += ex10_ex_eputs("%s", specifier);
+                ex10_ex_eputs("%s", specifier);
+                n_write += strlen(specifier);
             }
         }
 
-        while (n_write < (int)MAX_SPECIFIER_LENGTH)
+        for (; n_write < MAX_SPECIFIER_LENGTH; ++n_write)
         {
-            n_write += ex10_ex_eputs(" ");
+            ex10_ex_eputs(" ");
         }
         ex10_ex_eputs(": ");
 
@@ -322,6 +322,41 @@ class Ex10CalibrationExample(object):
         pwr_diff = pwr_p - pwr_n
         return pwr_diff, pwr_p, pwr_n
 
+    def sweep_fwd_power(self, freqs_mhz, coarse_atts, check_pwr_limit=False):
+        """
+        Sweeps the coarse attenuations at each frequency on the device, which
+        measures the lo power detectors and temperature, and reads the power
+        meter at each step's sync point.
+        :param freqs_mhz: Channel frequencies in MHz
+        :param coarse_atts: Coarse attenuations at each frequency
+        :param check_pwr_limit: Stop the sweep above FWD_PWR_LIMIT_DBM
+        :return: List of power_sweep steps, with the 'FWD_PWR' power meter
+                 reading in dBm added to each
+        """
+        fwd_pwrs = []
+        meter_freq_mhz = [None]
+
+        def read_fwd_power(step, freq_mhz, coarse_att):
+            if freq_mhz != meter_freq_mhz[0]:
+                self.power_meter.set_frequency(freq_mhz=freq_mhz)
+                meter_freq_mhz[0] = freq_mhz
+                # The device settled before the sync point; let the meter
+                # settle at its new frequency too.
+                time.sleep(self.CAL_CFG['PM_SLEEP_TIME'])
+            fwd_pwrs.append(self.power_meter.read_power())
+            # Stop transmitting above specified limit to protect board
+            if check_pwr_limit and fwd_pwrs[-1] > self.CAL_CFG['FWD_PWR_LIMIT_DBM']:
+                print("Over FWD_PWR_LIMIT_DBM!")
+                return False
+            return True
+
+        steps = self.ex10_reader.power_sweep(
+            freqs_mhz, coarse_atts, settle_s=self.CAL_CFG['PM_SLEEP_TIME'],
+            on_sync=read_fwd_power)
+        for step, fwd_pwr in zip(steps, fwd_pwrs):
+            step['FWD_PWR'] = fwd_pwr
+        return steps
+
     def set_freq_mhz(self, freq_mhz):
         self.ex10_reader.lock_synthesizer(freq_mhz=freq_mhz)
         self.power_meter.set_frequency(freq_mhz=freq_mhz)
@@ -381,11 +416,25 @@ class Ex10CalibrationExample(object):
         self._print('{:>3}  {:>5}  {:>20}  {:>3}  {:>7}'.format(
             'att', 'pwr', 'lo_pdet', 'temp', 'dc_ofs'))
 
-        for coarse_idx, coarse_val in enumerate(self.CAL_CFG['COARSE_ATTS']):
-            # Skip every odd coarse attenuation up to the specified limit
-            # to reduce total calibration runtime.
-            if (coarse_val > self.CAL_OPTIMIZATIONS['PRECISE_COARSE_ATT_THRESH']) and (coarse_idx % 2):
-                continue
+        # Skip every odd coarse attenuation up to the specified limit
+        # to reduce total calibration runtime.
+        coarse_atts = [coarse_val for coarse_idx, coarse_val in enumerate(self.CAL_CFG['COARSE_ATTS'])
+                       if not ((coarse_val > self.CAL_OPTIMIZATIONS['PRECISE_COARSE_ATT_THRESH'])
+                               and (coarse_idx % 2))]
+        if not cal_dc_offset:
+            # Without DC offset estimation, each step only needs the power
+            # meter, so the whole coarse sweep runs on the device.
+            for step in self.sweep_fwd_power([freq_mhz], coarse_atts,
+                                             check_pwr_limit=True):
+                coarse_val = step['COARSE_ATT']
+                data['COARSE']['FWD_PWR'][coarse_val] = step['FWD_PWR']
+                data['COARSE']['LO_PDET'][coarse_val] = step['LO_PDET']
+                data['COARSE']['TEMP'][coarse_val] = step['TEMP']
+                self._print((round(step['FWD_PWR'], 1), step['LO_PDET'],
+                             step['TEMP'], data['DC_OFS'][coarse_val]))
+            coarse_atts = []
+
+        for coarse_val in coarse_atts:
             self.ex10_reader.set_coarse_gain(coarse_val)
             # Measure values
             (data['COARSE']['FWD_PWR'][coarse_val],
@@ -417,17 +466,15 @@ class Ex10CalibrationExample(object):
         else:
             self._print('Measuring across frequency.')
             self._print('freq         fwd_pwrs                pdet_adcs')
+            coarse_atts = self.CAL_CFG['COARSE_ATTS_FREQ']
+            steps = self.sweep_fwd_power(freqs, coarse_atts)
+            for step_idx, step in enumerate(steps):
+                freq_idx = step['FREQ_IDX']
+                coarse_idx = step_idx % len(coarse_atts)
+                data['FREQ']['FWD_PWR'][freq_idx][coarse_idx] = step['FWD_PWR']
+                data['FREQ']['LO_PDET'][freq_idx][coarse_idx] = step['LO_PDET']
+                data['FREQ']['TEMP'][freq_idx][coarse_idx] = step['TEMP']
             for freq_idx, freq_val in enumerate(freqs):
-                self.set_freq_mhz(freq_mhz=freq_val)
-                for coarse_idx, coarse_val in enumerate(self.CAL_CFG['COARSE_ATTS_FREQ']):
-                    self.ex10_reader.set_coarse_gain(coarse_val)
-
-                    (pwr, pdet_adc) = self.measure_fwd_power()
-                    temp_adc = self.ex10_reader.measure_adc('temp')
-
-                    data['FREQ']['FWD_PWR'][freq_idx][coarse_idx] = pwr
-                    data['FREQ']['LO_PDET'][freq_idx][coarse_idx] = pdet_adc
-                    data['FREQ']['TEMP'][freq_idx][coarse_idx] = temp_adc
                 to_print = (
                     freq_val,
                     [round(x, 1) for x in data['FREQ']['FWD_PWR'][freq_idx]],
@@ -478,39 +525,27 @@ class Ex10CalibrationExample(object):
             data['MODES'][m] = self.ex10_reader.read_rssi()
         self.set_mode_antenna()
 
-        self._print('----Sweeping PGA1 gain')
-        for g, pga1 in enumerate(self.RSSI_CFG['PGA1_GAINS']):
-            # Set RX Gains
-            self.set_rssi_gains(pga1_gain=pga1)
-            data['PGA1'][g] = self.ex10_reader.read_rssi()
-
-        self._print('----Sweeping PGA2 gain')
-        for g, pga2 in enumerate(self.RSSI_CFG['PGA2_GAINS']):
-            # Set RX Gains
-            self.set_rssi_gains(pga2_gain=pga2)
-            data['PGA2'][g] = self.ex10_reader.read_rssi()
-
-        self._print('----Sweeping PGA3 gain')
-        for g, pga3 in enumerate(self.RSSI_CFG['PGA3_GAINS']):
-            # Set RX Gains
-            self.set_rssi_gains(pga3_gain=pga3)
-            data['PGA3'][g] = self.ex10_reader.read_rssi()
-
-        self._print('----Sweeping TIA gain')
-        for g, tia in enumerate(self.RSSI_CFG['MIXER_GAINS']):
-            # Set RX Gains
-            self.set_rssi_gains(mixer_gain=tia)
-            data['MIXER'][g] = self.ex10_reader.read_rssi()
-
-        self._print('----Sweeping RX ATT gain')
-        for a, rx_atten in enumerate(self.RSSI_CFG['RX_ATTS']):
-            # Set RX Gains
-            self.set_rssi_gains(rx_att=rx_atten)
-            data['RX_ATT'][a] = self.ex10_reader.read_rssi()
+        # The RX gain sweeps only change device settings, so they run on the
+        # device as one sweep, followed by the default gains.
+        self._print('----Sweeping PGA1, PGA2, PGA3, TIA and RX ATT gains')
+        gain_sweeps = [('PGA1', 'pga1_gain', self.RSSI_CFG['PGA1_GAINS']),
+                       ('PGA2', 'pga2_gain', self.RSSI_CFG['PGA2_GAINS']),
+                       ('PGA3', 'pga3_gain', self.RSSI_CFG['PGA3_GAINS']),
+                       ('MIXER', 'mixer_gain', self.RSSI_CFG['MIXER_GAINS']),
+                       ('RX_ATT', 'rx_att', self.RSSI_CFG['RX_ATTS'])]
+        rx_configs = []
+        for _, gain_param, gains in gain_sweeps:
+            rx_configs += [self.rssi_gains_config(**{gain_param: gain})
+                           for gain in gains]
+        rx_configs.append(self.rssi_gains_config())
+
+        rssis = self.ex10_reader.rssi_sweep(rx_configs)
+        for key, _, gains in gain_sweeps:
+            data[key] = rssis[:len(gains)]
+            rssis = rssis[len(gains):]
+        data['DEFAULT'] = rssis[0]
         self.set_rssi_gains()
 
-        data['DEFAULT'] = self.ex10_reader.read_rssi()
-
         self._print('----Sweeping FREQS')
         self.ex10_reader.set_region(self.RSSI_DEFAULT_CFG['LOWER_FREQ_REGION'])
         self.ex10_reader.lock_synthesizer(
@@ -540,7 +575,22 @@ class Ex10CalibrationExample(object):
                        pga3_gain=None,
                        mixer_gain=None,
                        ):
-
+        self.ex10_reader.set_analog_rx_config(self.rssi_gains_config(
+            rx_att=rx_att, pga1_gain=pga1_gain, pga2_gain=pga2_gain,
+            pga3_gain=pga3_gain, mixer_gain=mixer_gain))
+
+    def rssi_gains_config(self,
+                          rx_att=None,
+                          pga1_gain=None,
+                          pga2_gain=None,
+                          pga3_gain=None,
+                          mixer_gain=None,
+                          ):
+        """
+        Build the receiver gain settings, using the RSSI default for each gain
+        which is not specified
+        :return: Receiver block gain settings for set_analog_rx_config()
+        """
         analog_rx = aar.APPLICATION_ADDRESS_RANGE['RxGainControl']['fields']
         rx_atten_enums = analog_rx['RxAtten']['enums']
         pga1_enums = analog_rx['Pga1Gain']['enums']
@@ -567,7 +617,7 @@ class Ex10CalibrationExample(object):
             'MixerBandwidth': True,
             'Pga1RinSelect': False
         }
-        self.ex10_reader.set_analog_rx_config(rx_config)
+        return rx_config
 
     def set_mode_antenna(self,
                          antenna=None,
@@ -172,6 +172,47 @@ class UartHelper():
                 # Check for hexdump
                 self._parse_hexdump_line(response)
 
+    def send_and_sync(self, uart_command, on_sync, timeout_s=5):
+        """
+        Send a sweep command to Ex10 via UART, terminated with newline. While
+        the sweep runs, each 'Sync: ' line is passed to on_sync, and the sweep
+        is continued with 'c' if on_sync returns True, or stopped with 'x'.
+        Response is complete when 'OK' or 'ERROR' is received.
+        :param uart_command: the string to be sent
+        :param on_sync: callable taking the list of sync fields, returning
+                        True to continue the sweep
+        :param timeout_s: seconds without a received line before the device
+                          is considered unresponsive
+        :returns: success status, 'Result: ' message string
+        """
+        self.uart_if.write(uart_command.encode('ascii'))
+        self.uart_if.write(b'\n')
+        if (self.debug_dump):
+            print("TX: {}".format(uart_command))
+
+        count = 0
+        result_value = ""
+        while True:
+            response = self.uart_if.readline()
+            message = str(response.decode('ascii')).strip()
+            if(self.debug_dump):
+                print("RX:", message)
+            if response == b'':
+                count += 1
+                if count > timeout_s:
+                    raise Exception('Device is not responding. Is ex10_wrapper running?')
+                continue
+            count = 0
+            if message == 'OK':
+                return True, result_value
+            if message == 'ERROR':
+                return False, result_value
+            if message.startswith('Sync: '):
+                reply = 'c' if on_sync(message[6:].split()) else 'x'
+                self.uart_if.write(reply.encode('ascii') + b'\n')
+            elif message.startswith('Result: '):
+                result_value = message[8:]
+
     def set_verbose(self, verbose):
         """
         Set verbose mode.
@@ -17,6 +17,7 @@ protocol
 
 import binascii
 import pathlib
+import struct
 from enum import Enum
 import ex10_api.mnemonics as mne
 
@@ -28,6 +29,8 @@ class UartCommand(Enum):
     UPG_START = '^ s'
     UPG_CONTINUE = '^ c'
     UPG_COMPLETE = '^ e'
+    POWERSWEEP = '@'
+    RSSISWEEP = '%'
     RXCONFIG = 'a'
     TXATTEN = 'c'
     TXRAMPDOWN = 'd'
@@ -183,6 +186,52 @@ class UartReader():
 
         return responses[0]
 
+    def power_sweep(self, freqs_mhz, coarse_atts, settle_s=0, on_sync=None):
+        """
+        Sweep coarse attenuations at each frequency on the device. For each
+        step, the device sets the coarse gain, waits settle_s, and measures
+        the lo power detector and temperature ADCs. All steps are returned in
+        one result block.
+        :param freqs_mhz: Channel frequencies in MHz
+        :param coarse_atts: Attenuations to use [0-30] at each frequency
+        :param settle_s: Settle time in seconds before each measurement
+        :param on_sync: If given, called at each step with the step index,
+                        frequency in MHz and coarse attenuation, while the
+                        step's settings are applied, to read external
+                        instruments. Returning False stops the sweep.
+        :return: List of steps, each a dict with 'FREQ_IDX', 'FREQ_MHZ',
+                 'COARSE_ATT', 'LO_PDET' (list of ADC codes) and 'TEMP'
+        """
+        sweep_cmd = (UartCommand.POWERSWEEP.value + ' ' +
+                     str(int(round(settle_s * 1000))) + ' ' +
+                     ('1' if on_sync else '0') + ' ' +
+                     ','.join(str(int(round(freq * 1000))) for freq in freqs_mhz) +
+                     ' ' + ','.join(str(att) for att in coarse_atts))
+
+        def sync(fields):
+            step, freq_khz, coarse_att = (int(field) for field in fields)
+            return on_sync(step, freq_khz / 1000, coarse_att)
+
+        value_received, block_hex = self.uart_helper.send_and_sync(sweep_cmd, sync)
+        if value_received is False or block_hex == '':
+            raise Exception('Power sweep failed')
+
+        block = bytes.fromhex(block_hex)
+        (crc16,) = struct.unpack_from('<H', block, len(block) - 2)
+        if binascii.crc_hqx(block[:-2], 0xFFFF) != crc16:
+            raise Exception('Power sweep result CRC mismatch')
+        _version, _flags, step_count = struct.unpack_from('<BBH', block, 0)
+
+        steps = []
+        for freq_idx, coarse_att, *lo_pdet, temp_adc in struct.iter_unpack(
+                '<BB4HH', block[4:4 + 12 * step_count]):
+            steps.append({'FREQ_IDX': freq_idx,
+                          'FREQ_MHZ': freqs_mhz[freq_idx],
+                          'COARSE_ATT': coarse_att,
+                          'LO_PDET': lo_pdet,
+                          'TEMP': temp_adc})
+        return steps
+
     def radio_power_control(self, enable):
         """
         Enable or disable radio power control.
@@ -242,9 +291,10 @@ class UartReader():
             lbt_rssi_value = -1
         return lbt_rssi_value
 
-    def set_analog_rx_config(self, analog_rx_dict):
+    @staticmethod
+    def analog_rx_config_value(analog_rx_dict):
         """
-        Set gain for the individual blocks of the receiver.
+        Encode receiver block gains as an RxGainControl register value.
         """
         register = 'RxGainControl'
         config = mne.get_template(register)
@@ -252,11 +302,48 @@ class UartReader():
             config[register][field] = setting
 
         config = mne.mnemonic_to_bytes(config, 0)[4:6]
-        val = int.from_bytes(config, byteorder='little', signed=False)
+        return int.from_bytes(config, byteorder='little', signed=False)
+
+    def set_analog_rx_config(self, analog_rx_dict):
+        """
+        Set gain for the individual blocks of the receiver.
+        """
+        val = self.analog_rx_config_value(analog_rx_dict)
         reg_val_hex = str(hex(val))[2:]
         set_rx_config_cmd = UartCommand.RXCONFIG.value + ' ' + str(reg_val_hex)
         self.uart_helper.send_and_receive(set_rx_config_cmd)
 
+    def rssi_sweep(self, analog_rx_dicts, settle_s=0):
+        """
+        Measure the RSSI at each receiver gain setting on the device. For each
+        setting, the device sets the receiver gains, waits settle_s, and runs
+        the MeasureRssiOp. All readings are returned in one result block.
+        :param analog_rx_dicts: List of receiver block gain settings, as
+                                passed to set_analog_rx_config()
+        :param settle_s: Settle time in seconds before each measurement
+        :return: List of raw RSSI readings, one per gain setting
+        """
+        sweep_cmd = (UartCommand.RSSISWEEP.value + ' ' +
+                     str(int(round(settle_s * 1000))) + ' ' +
+                     ','.join(str(self.analog_rx_config_value(rx_dict))
+                              for rx_dict in analog_rx_dicts))
+
+        value_received, block_hex = self.uart_helper.send_and_receive(sweep_cmd)
+        if value_received is False or block_hex == '':
+            raise Exception('RSSI sweep failed')
+
+        block = bytes.fromhex(block_hex)
+        (crc16,) = struct.unpack_from('<H', block, len(block) - 2)
+        if binascii.crc_hqx(block[:-2], 0xFFFF) != crc16:
+            raise Exception('RSSI sweep result CRC mismatch')
+        _version, _flags, step_count = struct.unpack_from('<BBH', block, 0)
+        if step_count != len(analog_rx_dicts):
+            raise Exception('RSSI sweep returned {} of {} readings'.format(
+                step_count, len(analog_rx_dicts)))
+
+        return [rssi for (rssi,) in struct.iter_unpack(
+            '<H', block[4:4 + 2 * step_count])]
+
     def set_coarse_gain(self, tx_atten):
         """
         Set tx coarse gain (tx_atten) value
@@ -17,6 +17,7 @@ import resource as resource
 import ctypes
 from ctypes import *
 from enum import IntEnum
+import numpy as np
 from py2c_interface.py2c_python_auto_enums import *
 from py2c_interface.py2c_python_auto_fifo import *
 from py2c_interface.py2c_python_auto_regs import *
@@ -100,6 +101,11 @@ class Ex10Py2CWrapper(object):
         py2c_so.get_ex10_listen_before_talk.restype = ctypes.POINTER(Ex10ListenBeforeTalk)
         py2c_so.get_ex10_antenna_disconnect.restype = ctypes.POINTER(Ex10AntennaDisconnect)
         py2c_so.get_ex10_test.restype = ctypes.POINTER(Ex10Test)
+        py2c_so.get_ex10_tag_table.restype = ctypes.POINTER(Ex10TagTable)
+        py2c_so.get_ex10_clock_correlation.restype = ctypes.POINTER(Ex10ClockCorrelation)
+        py2c_so.get_ex10_async_log.restype = ctypes.POINTER(Ex10AsyncLog)
+        py2c_so.get_ex10_perf_counters.restype = ctypes.POINTER(Ex10PerfCounters)
+        py2c_so.get_ex10_tag_read_export.restype = ctypes.POINTER(Ex10TagReadExport)
 
         py2c_so.get_ex10_calibration.restype = POINTER(Ex10Calibration)
         py2c_so.get_ex10_cal_v5.restype = POINTER(Ex10CalibrationV5)
@@ -198,6 +204,16 @@ class Ex10Py2CWrapper(object):
                 ret_val = GetGenericIntercept(ret_val)
             elif name == 'get_ex10_test':
                 ret_val = GetGenericIntercept(ret_val)
+            elif name == 'get_ex10_tag_table':
+                ret_val = GetGenericIntercept(ret_val)
+            elif name == 'get_ex10_clock_correlation':
+                ret_val = GetGenericIntercept(ret_val)
+            elif name == 'get_ex10_async_log':
+                ret_val = GetGenericIntercept(ret_val)
+            elif name == 'get_ex10_perf_counters':
+                ret_val = GetGenericIntercept(ret_val)
+            elif name == 'get_ex10_tag_read_export':
+                ret_val = GetGenericIntercept(ret_val)
             return ret_val
         except:
             assert(sys.exc_info()[0])
@@ -586,6 +602,12 @@ class DrmStatus(IntEnum):
     DrmStatusOff = 2
 
 
+class ReadyNWaitMode(IntEnum):
+    ReadyNWaitModeSpin = 0
+    ReadyNWaitModeEvent = 1
+    ReadyNWaitModeHybrid = 2
+
+
 class AutosetModeId(IntEnum):
     AutosetMode_Invalid = 0
     AutosetMode_1120 = 1120
@@ -806,11 +828,29 @@ class Ex10LinkedList(Structure):
     ]
 
 
+EVENT_PACKET_INDEX_CAPACITY = 4096 // 8
+EVENT_PACKET_TYPE_COUNT = 256
+
+
+class EventPacketIndex(Structure):
+    _fields_ = [
+        ('packet_count', c_uint16),
+        ('indexed_length', c_size_t),
+        ('invalid_packet', c_bool),
+        ('packet_offsets', c_uint16 * EVENT_PACKET_INDEX_CAPACITY),
+        ('packet_types', c_uint8 * EVENT_PACKET_INDEX_CAPACITY),
+        ('type_counts', c_uint16 * EVENT_PACKET_TYPE_COUNT),
+    ]
+
+
 class FifoBufferNode(Structure):
     _fields_ = [
         ('fifo_data', ConstByteSpan),
         ('raw_buffer', ByteSpan),
         ('list_node', Ex10ListNode),
+        ('packet_indexed', c_bool),
+        ('packet_index', POINTER(EventPacketIndex)),
+        ('queued_time_ns', c_uint64),
     ]
 
 
@@ -818,16 +858,30 @@ class FifoBufferPool(Structure):
     _fields_ = [
         ('fifo_buffer_nodes', POINTER(FifoBufferNode)),
         ('fifo_buffers', POINTER(ByteSpan)),
+        ('packet_indexes', POINTER(EventPacketIndex)),
+        ('buffer_count', c_size_t),
+        ('buffer_size', c_size_t),
+        ('huge_page_backed', c_bool),
+    ]
+
+
+class FifoBufferListStats(Structure):
+    _fields_ = [
         ('buffer_count', c_size_t),
+        ('in_use', c_size_t),
+        ('high_water_mark', c_size_t),
+        ('exhaustion_count', c_size_t),
     ]
 
 
 class FifoBufferList(Structure):
     _fields_ = [
-        ('init', CFUNCTYPE(Ex10Result, POINTER(FifoBufferNode), POINTER(ByteSpan), c_size_t)),
+        ('init', CFUNCTYPE(Ex10Result, POINTER(FifoBufferNode), POINTER(ByteSpan), POINTER(EventPacketIndex), c_size_t)),
         ('free_list_put', CFUNCTYPE(c_bool, POINTER(FifoBufferNode))),
         ('free_list_get', CFUNCTYPE(POINTER(FifoBufferNode))),
         ('free_list_size', CFUNCTYPE(c_size_t)),
+        ('get_stats', CFUNCTYPE(None, POINTER(FifoBufferListStats))),
+        ('reset_stats', CFUNCTYPE(None)),
     ]
 
 
@@ -1019,6 +1073,7 @@ class Ex10GpioInterface(Structure):
         ('release_ready_n', CFUNCTYPE(c_int32)),
         ('busy_wait_ready_n', CFUNCTYPE(c_int32, c_uint32)),
         ('ready_n_pin_get', CFUNCTYPE(c_int32)),
+        ('set_ready_n_wait_mode', CFUNCTYPE(c_int32, c_uint32, c_uint32)),
     ]
 
 
@@ -1028,6 +1083,8 @@ class HostInterface(Structure):
         ('close', CFUNCTYPE(None)),
         ('read', CFUNCTYPE(c_int32, c_void_p, c_size_t)),
         ('write', CFUNCTYPE(c_int32, c_void_p, c_size_t)),
+        ('read_segments', CFUNCTYPE(c_int32, POINTER(ByteSpan), c_size_t)),
+        ('write_segments', CFUNCTYPE(c_int32, POINTER(ConstByteSpan), c_size_t)),
     ]
 
 
@@ -1106,6 +1163,15 @@ class Ex10Protocol(Structure):
         ('get_image_validity', CFUNCTYPE(ImageValidityFields)),
         ('get_remain_reason', CFUNCTYPE(Ex10Result, POINTER(RemainReasonFields))),
         ('get_sku', CFUNCTYPE(c_uint32)),
+        ('start_fifo_pipeline', CFUNCTYPE(Ex10Result, c_void_p)),
+        ('stop_fifo_pipeline', CFUNCTYPE(Ex10Result)),
+        ('enable_fifo_threshold_control', CFUNCTYPE(Ex10Result, c_void_p)),
+        ('disable_fifo_threshold_control', CFUNCTYPE(None)),
+        ('get_fifo_threshold_stats', CFUNCTYPE(None, c_void_p)),
+        ('enable_register_shadow', CFUNCTYPE(None, c_bool)),
+        ('invalidate_register_shadow', CFUNCTYPE(None)),
+        ('get_register_shadow_stats', CFUNCTYPE(None, c_void_p)),
+        ('upload_image_pipelined', CFUNCTYPE(Ex10Result, c_uint8, ConstByteSpan, c_void_p)),
     ]
 
 
@@ -1286,6 +1352,7 @@ class Ex10AggregateOpBuilder(Structure):
         ('append_start_ber_test', CFUNCTYPE(c_bool, c_uint16, c_uint16, c_bool, POINTER(ByteSpan))),
         ('append_ramp_transmit_power', CFUNCTYPE(c_bool, POINTER(PowerConfigs), POINTER(Ex10RegulatoryTimers), POINTER(ByteSpan))),
         ('append_droop_compensation', CFUNCTYPE(c_bool, POINTER(PowerDroopCompensationFields), POINTER(ByteSpan))),
+        ('get_buffer_generation', CFUNCTYPE(c_uint32)),
     ]
 
 
@@ -1389,6 +1456,9 @@ class Ex10Reader(Structure):
         ('listen_before_talk_multi', CFUNCTYPE(Ex10Result, c_uint8, c_uint8, LbtControlFields, POINTER(c_uint32), POINTER(c_int32), POINTER(c_int16))),
         ('get_current_analog_rx_fields', CFUNCTYPE(POINTER(RxGainControlFields))),
         ('get_continuous_inventory_state', CFUNCTYPE(POINTER(ContinuousInventoryState))),
+        ('enable_fifo_threshold_control', CFUNCTYPE(Ex10Result, c_void_p)),
+        ('disable_fifo_threshold_control', CFUNCTYPE(None)),
+        ('get_fifo_threshold_stats', CFUNCTYPE(None, c_void_p)),
     ]
 
 
@@ -1443,6 +1513,8 @@ class Ex10TimeHelpers(Structure):
         ('time_elapsed', CFUNCTYPE(c_uint32, c_uint32)),
         ('busy_wait_ms', CFUNCTYPE(None, c_uint32)),
         ('wait_ms', CFUNCTYPE(None, c_uint32)),
+        ('time_now_us', CFUNCTYPE(c_uint64)),
+        ('time_now_ns', CFUNCTYPE(c_uint64)),
     ]
 
 
@@ -1480,6 +1552,8 @@ class Ex10EventParser(Structure):
         ('get_packet_type_valid', CFUNCTYPE(c_bool, c_uint32)),
         ('parse_event_packet', CFUNCTYPE(EventFifoPacket, POINTER(ConstByteSpan))),
         ('make_packet_header', CFUNCTYPE(PacketHeader, c_uint32)),
+        ('scan_event_packets', CFUNCTYPE(c_size_t, ConstByteSpan, POINTER(EventPacketIndex))),
+        ('get_indexed_packet', CFUNCTYPE(EventFifoPacket, POINTER(c_uint8), POINTER(EventPacketIndex), c_size_t)),
     ]
 
 
@@ -1591,6 +1665,13 @@ class Ex10RfPower(Structure):
         ('set_analog_rx_config', CFUNCTYPE(Ex10Result, POINTER(RxGainControlFields))),
         ('enable_droop_compensation', CFUNCTYPE(Ex10Result, POINTER(PowerDroopCompensationFields))),
         ('disable_droop_compensation', CFUNCTYPE(None)),
+        ('enable_ramp_plan_cache', CFUNCTYPE(Ex10Result, c_uint16)),
+        ('disable_ramp_plan_cache', CFUNCTYPE(None)),
+        ('invalidate_ramp_plan_cache', CFUNCTYPE(None)),
+        ('get_ramp_plan_cache_stats', CFUNCTYPE(None, c_void_p)),
+        ('enable_pipelined_ramp', CFUNCTYPE(None, c_bool)),
+        ('stage_next_cw_on', CFUNCTYPE(Ex10Result, c_uint8, c_uint32, c_int16, c_uint16, c_bool, POINTER(PowerDroopCompensationFields))),
+        ('get_pipelined_ramp_stats', CFUNCTYPE(None, c_void_p)),
     ]
 
 
@@ -1654,6 +1735,9 @@ class Ex10GpioHelpers(Structure):
 class Ex10CalibrationV5(Structure):
     _fields_ = [
         ('init', CFUNCTYPE(None, POINTER(Ex10Protocol))),
+        ('get_page_length', CFUNCTYPE(c_size_t)),
+        ('get_page_offset', CFUNCTYPE(c_size_t, c_size_t)),
+        ('init_from_page', CFUNCTYPE(None, POINTER(c_uint8), c_size_t)),
         ('get_params', CFUNCTYPE(POINTER(Ex10CalibrationParamsV5))),
     ]
 
@@ -1670,6 +1754,9 @@ class Ex10Calibration(Structure):
         ('get_compensated_lbt_rssi', CFUNCTYPE(c_int16, c_uint16, POINTER(RxGainControlFields), c_uint8, c_uint32, c_uint16)),
         ('get_cal_version', CFUNCTYPE(c_uint8)),
         ('get_customer_cal_version', CFUNCTYPE(c_uint8)),
+        ('build_rssi_compensation_plan', CFUNCTYPE(None, c_uint32, POINTER(RxGainControlFields), c_uint8, c_uint32, c_uint16, c_void_p)),
+        ('compensate_rssi_batch', CFUNCTYPE(None, c_void_p, POINTER(c_uint16), POINTER(c_int16), c_size_t)),
+        ('set_cache_path', CFUNCTYPE(c_bool, c_char_p)),
     ]
 
 
@@ -1698,9 +1785,243 @@ class Ex10ContinuousInventoryUseCase(Structure):
         ('enable_abort_on_fail', CFUNCTYPE(None, c_bool)),
         ('get_continuous_inventory_stop_reason', CFUNCTYPE(c_uint32)),
         ('continuous_inventory', CFUNCTYPE(Ex10Result, POINTER(Ex10ContinuousInventoryUseCaseParameters))),
+        ('enable_tag_table_filter', CFUNCTYPE(None, c_bool)),
+    ]
+
+
+class Ex10TagTable(Structure):
+    _fields_ = [
+        ('init', CFUNCTYPE(Ex10Result, c_void_p, c_size_t, c_uint32)),
+        ('register_event_callback', CFUNCTYPE(None, CFUNCTYPE(None, c_uint32, c_void_p))),
+        ('update', CFUNCTYPE(c_uint32, POINTER(EventFifoPacket), c_uint8, c_int16, POINTER(c_void_p))),
+        ('age', CFUNCTYPE(c_size_t, c_uint32)),
+        ('find', CFUNCTYPE(c_void_p, POINTER(c_uint8), c_size_t, POINTER(c_uint8), c_size_t)),
+        ('clear', CFUNCTYPE(None)),
+        ('get_stats', CFUNCTYPE(None, c_void_p)),
+    ]
+
+
+class Ex10ClockCorrelationEstimate(Structure):
+    _fields_ = [
+        ('sample_count', c_size_t),
+        ('device_time_us', c_uint32),
+        ('host_time_ns', c_uint64),
+        ('drift_ppb', c_int32),
+        ('min_round_trip_ns', c_uint32),
+    ]
+
+
+class Ex10ClockCorrelation(Structure):
+    _fields_ = [
+        ('init', CFUNCTYPE(None, c_uint32)),
+        ('sample', CFUNCTYPE(Ex10Result)),
+        ('sample_if_due', CFUNCTYPE(Ex10Result)),
+        ('device_to_host_ns', CFUNCTYPE(c_uint64, c_uint32)),
+        ('packet_host_time_ns', CFUNCTYPE(c_uint64, POINTER(EventFifoPacket))),
+        ('get_estimate', CFUNCTYPE(None, POINTER(Ex10ClockCorrelationEstimate))),
+    ]
+
+
+class Ex10AsyncLogConfig(Structure):
+    _fields_ = [
+        ('rate_limit_count', c_uint32),
+        ('rate_limit_interval_ms', c_uint32),
+        ('poll_interval_ms', c_uint32),
+        ('print_timestamps', c_bool),
+    ]
+
+
+class Ex10AsyncLogStats(Structure):
+    _fields_ = [
+        ('records_logged', c_size_t),
+        ('records_dropped', c_size_t),
+        ('records_suppressed', c_size_t),
+        ('records_synchronous', c_size_t),
+    ]
+
+
+class Ex10AsyncLog(Structure):
+    _fields_ = [
+        ('start', CFUNCTYPE(Ex10Result, POINTER(Ex10AsyncLogConfig))),
+        ('stop', CFUNCTYPE(None)),
+        ('flush', CFUNCTYPE(None)),
+        ('is_started', CFUNCTYPE(c_bool)),
+        ('get_stats', CFUNCTYPE(None, POINTER(Ex10AsyncLogStats))),
+    ]
+
+
+EX10_PERF_HISTOGRAM_BUCKETS = 20
+
+
+class Ex10PerfHistogram(Structure):
+    _fields_ = [
+        ('buckets', c_uint64 * EX10_PERF_HISTOGRAM_BUCKETS),
+        ('count', c_uint64),
+        ('total_ns', c_uint64),
+        ('max_ns', c_uint64),
+    ]
+
+
+class Ex10PerfSnapshot(Structure):
+    _fields_ = [
+        ('snapshot_time_ns', c_uint64),
+        ('reset_time_ns', c_uint64),
+        ('spi_commands', c_uint64),
+        ('spi_responses', c_uint64),
+        ('spi_bytes_sent', c_uint64),
+        ('spi_bytes_received', c_uint64),
+        ('ready_n_wait', Ex10PerfHistogram),
+        ('ready_n_timeouts', c_uint64),
+        ('interrupts', c_uint64),
+        ('read_fifo_count', c_uint64),
+        ('read_fifo_bytes', c_uint64),
+        ('event_fifo_buffers', FifoBufferListStats),
+        ('queue_depth', c_uint64),
+        ('queue_max_depth', c_uint64),
+        ('queue_lag', Ex10PerfHistogram),
+        ('cw_on_count', c_uint64),
+        ('cw_on_staged_count', c_uint64),
+        ('cw_on_time', Ex10PerfHistogram),
+        ('ramp_up_count', c_uint64),
+        ('ramp_down_count', c_uint64),
+        ('dead_time', Ex10PerfHistogram),
+        ('inventory_rounds', c_uint64),
+        ('tag_reads', c_uint64),
+        ('last_round_tag_reads', c_uint64),
+        ('last_round_duration_us', c_uint64),
+        ('last_round_tags_per_second', c_uint64),
+        ('max_round_tags_per_second', c_uint64),
+    ]
+
+
+class Ex10PerfCounters(Structure):
+    _fields_ = [
+        ('get_snapshot', CFUNCTYPE(None, POINTER(Ex10PerfSnapshot))),
+        ('reset', CFUNCTYPE(None)),
+        ('record_spi_command', CFUNCTYPE(None, c_size_t, c_uint64)),
+        ('record_spi_response', CFUNCTYPE(None, c_size_t, c_uint64)),
+        ('record_ready_n_timeout', CFUNCTYPE(None)),
+        ('record_interrupt', CFUNCTYPE(None)),
+        ('record_read_fifo', CFUNCTYPE(None, c_size_t)),
+        ('record_queue_push', CFUNCTYPE(None, POINTER(FifoBufferNode), c_size_t)),
+        ('record_queue_pop', CFUNCTYPE(None, POINTER(FifoBufferNode), c_size_t)),
+        ('record_cw_on', CFUNCTYPE(None, c_uint64, c_bool)),
+    ]
+
+
+class Ex10TagReadExportConfig(Structure):
+    _fields_ = [
+        ('rf_mode', c_uint32),
+        ('antenna', c_uint8),
+        ('rf_filter', c_uint32),
+        ('temp_adc', c_uint16),
+        ('wait_timeout_us', c_uint32),
+        ('stop_at_other_packets', c_bool),
+    ]
+
+
+class Ex10TagReadArrays(Structure):
+    _fields_ = [
+        ('capacity', c_size_t),
+        ('epc_stride', c_size_t),
+        ('tid_stride', c_size_t),
+        ('pc', POINTER(c_uint16)),
+        ('epc', POINTER(c_uint8)),
+        ('epc_length', POINTER(c_uint8)),
+        ('tid', POINTER(c_uint8)),
+        ('tid_length', POINTER(c_uint8)),
+        ('rssi_raw', POINTER(c_uint16)),
+        ('rssi_cdbm', POINTER(c_int16)),
+        ('phase_begin', POINTER(c_uint16)),
+        ('phase_end', POINTER(c_uint16)),
+        ('antenna', POINTER(c_uint8)),
+        ('timestamp_us', POINTER(c_uint32)),
+        ('host_time_ns', POINTER(c_uint64)),
+    ]
+
+
+class Ex10TagReadExportCounts(Structure):
+    _fields_ = [
+        ('tag_read_count', c_size_t),
+        ('skipped_packet_count', c_size_t),
     ]
 
 
+class Ex10TagReadExport(Structure):
+    _fields_ = [
+        ('export_tag_reads', CFUNCTYPE(Ex10Result,
+                                       POINTER(Ex10TagReadExportConfig),
+                                       POINTER(Ex10TagReadArrays),
+                                       POINTER(Ex10TagReadExportCounts))),
+    ]
+
+
+class TagReadExportBuffers(object):
+    """
+    numpy arrays into which Ex10TagReadExport.export_tag_reads() exports
+    tag reads, so that one call moves many tag reads into Python.
+    The arrays are reused by each export; copy the rows which must be kept.
+    """
+
+    # The numpy dtype and ctypes element type of each one-dimensional array.
+    _columns = [
+        ('pc', np.uint16, c_uint16),
+        ('epc_length', np.uint8, c_uint8),
+        ('tid_length', np.uint8, c_uint8),
+        ('rssi_raw', np.uint16, c_uint16),
+        ('rssi_cdbm', np.int16, c_int16),
+        ('phase_begin', np.uint16, c_uint16),
+        ('phase_end', np.uint16, c_uint16),
+        ('antenna', np.uint8, c_uint8),
+        ('timestamp_us', np.uint32, c_uint32),
+        ('host_time_ns', np.uint64, c_uint64),
+    ]
+
+    def __init__(self, capacity, epc_stride=EPC_BUFFER_BYTE_LENGTH,
+                 tid_stride=TID_LENGTH_BYTES):
+        """
+        Allocate arrays of capacity rows. EPCs and TIDs are stored in rows of
+        epc_stride and tid_stride bytes.
+        """
+        self.capacity = capacity
+        self.epc = np.zeros((capacity, epc_stride), dtype=np.uint8)
+        self.tid = np.zeros((capacity, tid_stride), dtype=np.uint8)
+
+        self.arrays = Ex10TagReadArrays()
+        self.arrays.capacity = capacity
+        self.arrays.epc_stride = epc_stride
+        self.arrays.tid_stride = tid_stride
+        self.arrays.epc = self.epc.ctypes.data_as(POINTER(c_uint8))
+        self.arrays.tid = self.tid.ctypes.data_as(POINTER(c_uint8))
+        for name, dtype, c_type in self._columns:
+            array = np.zeros(capacity, dtype=dtype)
+            setattr(self, name, array)
+            setattr(self.arrays, name, array.ctypes.data_as(POINTER(c_type)))
+
+    def export(self, tag_read_export, config):
+        """
+        Export tag reads from the EventFifo queue into the arrays.
+
+        :param tag_read_export: The Ex10TagReadExport from
+                                get_ex10_tag_read_export().
+        :param config: The Ex10TagReadExportConfig.
+        :return: The Ex10Result and the Ex10TagReadExportCounts.
+        """
+        counts = Ex10TagReadExportCounts()
+        result = tag_read_export.export_tag_reads(
+            byref(config), byref(self.arrays), byref(counts))
+        return result, counts
+
+    def tag_reads(self, count):
+        """
+        :return: A dict of views of the first count rows of each array.
+        """
+        views = {'epc': self.epc[:count], 'tid': self.tid[:count]}
+        for name, _, _ in self._columns:
+            views[name] = getattr(self, name)[:count]
+        return views
+
+
 class Ex10TagAccessUseCaseParameters(Structure):
     _fields_ = [
         ('antenna', c_uint8),
@@ -1724,6 +2045,11 @@ class Ex10TagAccessUseCase(Structure):
         ('get_fifo_packet', CFUNCTYPE(POINTER(EventFifoPacket))),
         ('remove_fifo_packet', CFUNCTYPE(None)),
         ('remove_halted_packet', CFUNCTYPE(c_bool)),
+        ('get_fifo_packet_with_timeout', CFUNCTYPE(POINTER(EventFifoPacket), c_uint32)),
+        ('submit_job', CFUNCTYPE(Ex10Result, c_void_p, POINTER(c_uint32))),
+        ('pending_job_count', CFUNCTYPE(c_size_t)),
+        ('cancel_jobs', CFUNCTYPE(None)),
+        ('run_jobs', CFUNCTYPE(Ex10Result, POINTER(Ex10TagAccessUseCaseParameters), c_uint32)),
     ]
 
 
@@ -1736,6 +2062,9 @@ class Ex10EventFifoQueue(Structure):
         ('packet_wait', CFUNCTYPE(None)),
         ('packet_wait_with_timeout', CFUNCTYPE(c_bool, c_uint32)),
         ('packet_unwait', CFUNCTYPE(None)),
+        ('packet_batch_get', CFUNCTYPE(c_size_t, c_void_p)),
+        ('packet_batch_release', CFUNCTYPE(None, c_void_p)),
+        ('get_packet_index', CFUNCTYPE(POINTER(EventPacketIndex), POINTER(FifoBufferNode))),
     ]
 
 